@@ -0,0 +1,299 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBrickedImage_h
+#define itkBrickedImage_h
+
+#include "itkImageBase.h"
+#include "itkImageRegion.h"
+#include "itkMath.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace itk
+{
+/** \class BrickedImage
+ * \brief Image that stores its pixels in cubic bricks, which are allocated
+ * lazily.
+ *
+ * BrickedImage has the geometry of an Image (it is an ImageBase), but its
+ * buffered region is divided into bricks of VBrickSize pixels along every
+ * dimension, starting at the index of the buffered region. The pixels of a
+ * brick are contiguous in memory, so that the neighbors of a pixel along any
+ * dimension are close to it, unlike in the row-major buffer of an Image,
+ * where the neighbors along the last dimension are a slice apart.
+ *
+ * A brick is only allocated when a pixel of the brick is set to a value that
+ * differs from the background value. All the bricks that are not allocated
+ * share a single constant brick filled with the background value. The memory
+ * used by a sparse image, like a mask, a label map or a narrow band, is
+ * therefore proportional to the part of the image that is not background.
+ * ReleaseBackgroundBricks() releases the bricks that have returned to the
+ * background value.
+ *
+ * Allocate() allocates no brick, and FillBuffer() releases all the bricks and
+ * sets the background value. The pixels are accessed with GetPixel() and
+ * SetPixel(), or walked with BrickedImageRegionConstIterator,
+ * BrickedImageRegionIterator and BrickedImageRegionRange. GetPixel() is
+ * sufficient for ImageFunction, so that BrickedImage can be interpolated, for
+ * example as the input of ResampleImageFilter.
+ *
+ * \warning BrickedImage has no contiguous pixel buffer: it cannot be used with
+ * the iterators of Image, nor with the filters that require an Image.
+ *
+ * \warning Setting pixels allocates bricks. Threads may set the pixels of
+ * different bricks concurrently; to set the pixels of the same brick from
+ * several threads, allocate the bricks first, with AllocateBricks().
+ *
+ * \sa Image
+ * \sa BrickedImageRegionIterator
+ * \sa BrickedImageRegionRange
+ *
+ * \ingroup ImageObjects
+ * \ingroup ITKCommon
+ */
+template <typename TPixel, unsigned int VImageDimension = 3, unsigned int VBrickSize = 16>
+class ITK_TEMPLATE_EXPORT BrickedImage : public ImageBase<VImageDimension>
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(BrickedImage);
+
+  /** Standard class type aliases */
+  using Self = BrickedImage;
+  using Superclass = ImageBase<VImageDimension>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+  using ConstWeakPointer = WeakPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(BrickedImage, ImageBase);
+
+  /** Pixel type alias support. */
+  using PixelType = TPixel;
+  using ValueType = TPixel;
+  using InternalPixelType = TPixel;
+  using IOPixelType = PixelType;
+
+  /** Types inherited from the superclass. */
+  using ImageDimensionType = typename Superclass::ImageDimensionType;
+  using IndexType = typename Superclass::IndexType;
+  using IndexValueType = typename Superclass::IndexValueType;
+  using OffsetType = typename Superclass::OffsetType;
+  using OffsetValueType = typename Superclass::OffsetValueType;
+  using SizeType = typename Superclass::SizeType;
+  using SizeValueType = typename Superclass::SizeValueType;
+  using RegionType = typename Superclass::RegionType;
+  using DirectionType = typename Superclass::DirectionType;
+  using SpacingType = typename Superclass::SpacingType;
+  using SpacingValueType = typename Superclass::SpacingValueType;
+  using PointType = typename Superclass::PointType;
+
+  static constexpr unsigned int ImageDimension = VImageDimension;
+
+  /** The number of pixels of a brick along every dimension, and in total. */
+  static constexpr unsigned int BrickSize = VBrickSize;
+  static constexpr SizeValueType NumberOfPixelsPerBrick =
+    Math::UnsignedPower<SizeValueType>(VBrickSize, VImageDimension);
+
+  static_assert(VBrickSize > 1 && (VBrickSize & (VBrickSize - 1)) == 0, "The brick size must be a power of two.");
+
+  template <typename UPixelType, unsigned int VUImageDimension = VImageDimension>
+  using RebindImageType = BrickedImage<UPixelType, VUImageDimension, VBrickSize>;
+
+  /** Prepares the bricks of the buffered region, which must already be set,
+   * e.g. by SetRegions(). No brick is allocated: all the pixels have the
+   * background value, which is the zero of the pixel type. */
+  void
+  Allocate(bool initializePixels = false) override;
+
+  /** Restores the data object to its initial state, releasing the bricks. */
+  void
+  Initialize() override;
+
+  /** Releases all the bricks, and makes the value the background value. */
+  void
+  FillBuffer(const TPixel & value);
+
+  /** Returns the value of the pixels of the bricks that are not allocated. */
+  const TPixel &
+  GetBackgroundValue() const
+  {
+    return m_Bricks->BackgroundValue;
+  }
+
+  /** Sets a pixel value. The brick of the pixel is allocated, unless the value
+   * is the background value. */
+  void
+  SetPixel(const IndexType & index, const TPixel & value)
+  {
+    SizeValueType brickNumber;
+    SizeValueType pixelOffset;
+    this->ComputeBrickNumberAndPixelOffset(index, brickNumber, pixelOffset);
+    if (m_Bricks->Table[brickNumber] != m_Bricks->EmptyBrick.get() ||
+        Math::NotExactlyEquals(value, m_Bricks->BackgroundValue))
+    {
+      this->GetWritableBrick(brickNumber)[pixelOffset] = value;
+    }
+  }
+
+  /** Returns a pixel value. */
+  const TPixel &
+  GetPixel(const IndexType & index) const
+  {
+    SizeValueType brickNumber;
+    SizeValueType pixelOffset;
+    this->ComputeBrickNumberAndPixelOffset(index, brickNumber, pixelOffset);
+    return m_Bricks->Table[brickNumber][pixelOffset];
+  }
+
+  /** Access a pixel. This version can only be an rvalue: there is no
+   * reference to a pixel for editing, because it would allocate the brick of
+   * every pixel that is read. */
+  const TPixel & operator[](const IndexType & index) const { return this->GetPixel(index); }
+
+  /** Returns the number of bricks along every dimension. */
+  const SizeType &
+  GetBrickGridSize() const
+  {
+    return m_BrickGridSize;
+  }
+
+  /** Returns the number of bricks of the buffered region. */
+  SizeValueType
+  GetNumberOfBricks() const
+  {
+    return static_cast<SizeValueType>(m_Bricks->Table.size());
+  }
+
+  /** Returns the number of bricks that are allocated. */
+  SizeValueType
+  GetNumberOfAllocatedBricks() const
+  {
+    return m_Bricks->NumberOfAllocatedBricks.load();
+  }
+
+  /** Allocates the bricks that overlap the region, which must be inside the
+   * buffered region. */
+  void
+  AllocateBricks(const RegionType & region);
+
+  /** Releases the allocated bricks whose pixels all have the background
+   * value, and returns their number. */
+  SizeValueType
+  ReleaseBackgroundBricks();
+
+  /** Computes the number of the brick of a pixel in the buffered region, and
+   * the offset of the pixel in its brick. The index must be inside the
+   * buffered region. */
+  void
+  ComputeBrickNumberAndPixelOffset(const IndexType & index,
+                                   SizeValueType &   brickNumber,
+                                   SizeValueType &   pixelOffset) const
+  {
+    const IndexType & bufferedIndex = this->GetBufferedRegion().GetIndex();
+    brickNumber = 0;
+    pixelOffset = 0;
+    for (unsigned int d = 0; d < VImageDimension; ++d)
+    {
+      const auto relativeIndex = static_cast<SizeValueType>(index[d] - bufferedIndex[d]);
+      brickNumber += (relativeIndex >> BrickSizeLog2) * m_BrickOffsetTable[d];
+      pixelOffset += (relativeIndex & (VBrickSize - 1)) << (BrickSizeLog2 * d);
+    }
+  }
+
+  /** Returns the pixels of a brick, which are read-only, and shared with the
+   * other bricks, if the brick is not allocated. */
+  const TPixel *
+  GetBrick(const SizeValueType brickNumber) const
+  {
+    return m_Bricks->Table[brickNumber];
+  }
+
+  /** Returns whether a brick is allocated. */
+  bool
+  IsBrickAllocated(const SizeValueType brickNumber) const
+  {
+    return m_Bricks->Table[brickNumber] != m_Bricks->EmptyBrick.get();
+  }
+
+  /** Returns the pixels of a brick, allocating the brick if necessary. */
+  TPixel *
+  GetWritableBrick(const SizeValueType brickNumber)
+  {
+    TPixel * const brick = m_Bricks->Table[brickNumber];
+    return (brick != m_Bricks->EmptyBrick.get()) ? brick : this->AllocateBrick(brickNumber);
+  }
+
+  unsigned int
+  GetNumberOfComponentsPerPixel() const override;
+
+  /** Graft the data and information from one image to another. The images
+   * share their bricks. */
+  virtual void
+  Graft(const Self * data);
+
+protected:
+  BrickedImage();
+  ~BrickedImage() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  Graft(const DataObject * data) override;
+
+  using Superclass::Graft;
+
+private:
+  static constexpr unsigned int
+  Log2(const unsigned int value)
+  {
+    return (value <= 1) ? 0 : 1 + Log2(value / 2);
+  }
+
+  static constexpr unsigned int BrickSizeLog2 = Log2(VBrickSize);
+
+  // The bricks of an image, shared by grafted images. Table holds a pointer to
+  // every brick: to the allocated one, or to EmptyBrick.
+  struct BrickStorage
+  {
+    std::vector<TPixel *>                  Table;
+    std::vector<std::unique_ptr<TPixel[]>> AllocatedBricks;
+    std::unique_ptr<TPixel[]>              EmptyBrick;
+    std::atomic<SizeValueType>             NumberOfAllocatedBricks{ 0 };
+    TPixel                                 BackgroundValue;
+  };
+
+  TPixel *
+  AllocateBrick(const SizeValueType brickNumber);
+
+  std::shared_ptr<BrickStorage> m_Bricks;
+  SizeType                      m_BrickGridSize;
+  OffsetValueType               m_BrickOffsetTable[VImageDimension];
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkBrickedImage.hxx"
+#endif
+
+#endif
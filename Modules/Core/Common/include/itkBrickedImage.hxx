@@ -0,0 +1,260 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBrickedImage_hxx
+#define itkBrickedImage_hxx
+
+#include "itkBrickedImage.h"
+#include <algorithm>
+
+namespace itk
+{
+
+template <typename TPixel, unsigned int VImageDimension, unsigned int VBrickSize>
+BrickedImage<TPixel, VImageDimension, VBrickSize>::BrickedImage()
+  : m_Bricks(std::make_shared<BrickStorage>())
+{
+  m_BrickGridSize.Fill(0);
+  std::fill_n(m_BrickOffsetTable, VImageDimension, 0);
+  m_Bricks->BackgroundValue = NumericTraits<TPixel>::ZeroValue();
+}
+
+
+template <typename TPixel, unsigned int VImageDimension, unsigned int VBrickSize>
+void
+BrickedImage<TPixel, VImageDimension, VBrickSize>::Allocate(bool itkNotUsed(initializePixels))
+{
+  this->ComputeOffsetTable();
+
+  const SizeType & bufferedSize = this->GetBufferedRegion().GetSize();
+  SizeValueType    numberOfBricks = 1;
+  for (unsigned int d = 0; d < VImageDimension; ++d)
+  {
+    m_BrickGridSize[d] = (bufferedSize[d] + VBrickSize - 1) / VBrickSize;
+    m_BrickOffsetTable[d] = static_cast<OffsetValueType>(numberOfBricks);
+    numberOfBricks *= m_BrickGridSize[d];
+  }
+
+  // Replace the bricks rather than clearing them, because grafted images may
+  // share them.
+  m_Bricks = std::make_shared<BrickStorage>();
+  m_Bricks->BackgroundValue = NumericTraits<TPixel>::ZeroValue();
+  m_Bricks->EmptyBrick.reset(new TPixel[NumberOfPixelsPerBrick]);
+  std::fill_n(m_Bricks->EmptyBrick.get(), NumberOfPixelsPerBrick, m_Bricks->BackgroundValue);
+  m_Bricks->Table.assign(numberOfBricks, m_Bricks->EmptyBrick.get());
+  m_Bricks->AllocatedBricks.resize(numberOfBricks);
+}
+
+
+template <typename TPixel, unsigned int VImageDimension, unsigned int VBrickSize>
+void
+BrickedImage<TPixel, VImageDimension, VBrickSize>::Initialize()
+{
+  //
+  // We don't modify ourselves because the "ReleaseData" methods depend upon
+  // no modification when initialized.
+  //
+
+  // Call the superclass which should initialize the BufferedRegion ivar.
+  Superclass::Initialize();
+
+  const TPixel backgroundValue = m_Bricks->BackgroundValue;
+  m_Bricks = std::make_shared<BrickStorage>();
+  m_Bricks->BackgroundValue = backgroundValue;
+  m_BrickGridSize.Fill(0);
+  std::fill_n(m_BrickOffsetTable, VImageDimension, 0);
+}
+
+
+template <typename TPixel, unsigned int VImageDimension, unsigned int VBrickSize>
+void
+BrickedImage<TPixel, VImageDimension, VBrickSize>::FillBuffer(const TPixel & value)
+{
+  BrickStorage & bricks = *m_Bricks;
+  bricks.BackgroundValue = value;
+  if (bricks.EmptyBrick)
+  {
+    std::fill_n(bricks.EmptyBrick.get(), NumberOfPixelsPerBrick, value);
+  }
+  std::fill(bricks.Table.begin(), bricks.Table.end(), bricks.EmptyBrick.get());
+  for (auto & brick : bricks.AllocatedBricks)
+  {
+    brick.reset();
+  }
+  bricks.NumberOfAllocatedBricks = 0;
+}
+
+
+template <typename TPixel, unsigned int VImageDimension, unsigned int VBrickSize>
+TPixel *
+BrickedImage<TPixel, VImageDimension, VBrickSize>::AllocateBrick(const SizeValueType brickNumber)
+{
+  BrickStorage & bricks = *m_Bricks;
+  std::unique_ptr<TPixel[]> & brick = bricks.AllocatedBricks[brickNumber];
+  brick.reset(new TPixel[NumberOfPixelsPerBrick]);
+  std::copy_n(bricks.EmptyBrick.get(), NumberOfPixelsPerBrick, brick.get());
+  bricks.Table[brickNumber] = brick.get();
+  ++bricks.NumberOfAllocatedBricks;
+  return brick.get();
+}
+
+
+template <typename TPixel, unsigned int VImageDimension, unsigned int VBrickSize>
+void
+BrickedImage<TPixel, VImageDimension, VBrickSize>::AllocateBricks(const RegionType & region)
+{
+  if (!this->GetBufferedRegion().IsInside(region))
+  {
+    itkExceptionMacro(<< "The region " << region << " is not inside the buffered region "
+                      << this->GetBufferedRegion());
+  }
+
+  // The bricks that overlap the region form a box in the brick grid.
+  const IndexType & bufferedIndex = this->GetBufferedRegion().GetIndex();
+  IndexType         firstBrick;
+  SizeType          numberOfBricks;
+  for (unsigned int d = 0; d < VImageDimension; ++d)
+  {
+    const auto begin = static_cast<SizeValueType>(region.GetIndex(d) - bufferedIndex[d]);
+    const auto end = begin + region.GetSize(d);
+    firstBrick[d] = static_cast<IndexValueType>(begin / VBrickSize);
+    numberOfBricks[d] = (end + VBrickSize - 1) / VBrickSize - begin / VBrickSize;
+  }
+
+  const ImageRegion<VImageDimension> brickRegion(firstBrick, numberOfBricks);
+  const SizeValueType                numberOfBricksInRegion = brickRegion.GetNumberOfPixels();
+  IndexType                          brickIndex = firstBrick;
+  for (SizeValueType i = 0; i < numberOfBricksInRegion; ++i)
+  {
+    SizeValueType brickNumber = 0;
+    for (unsigned int d = 0; d < VImageDimension; ++d)
+    {
+      brickNumber += static_cast<SizeValueType>(brickIndex[d]) * m_BrickOffsetTable[d];
+    }
+    this->GetWritableBrick(brickNumber);
+
+    for (unsigned int d = 0; d < VImageDimension; ++d)
+    {
+      if (++brickIndex[d] < firstBrick[d] + static_cast<IndexValueType>(numberOfBricks[d]))
+      {
+        break;
+      }
+      brickIndex[d] = firstBrick[d];
+    }
+  }
+}
+
+
+template <typename TPixel, unsigned int VImageDimension, unsigned int VBrickSize>
+auto
+BrickedImage<TPixel, VImageDimension, VBrickSize>::ReleaseBackgroundBricks() -> SizeValueType
+{
+  BrickStorage &      bricks = *m_Bricks;
+  const TPixel &      backgroundValue = bricks.BackgroundValue;
+  SizeValueType       numberOfReleasedBricks = 0;
+  const SizeValueType numberOfBricks = bricks.AllocatedBricks.size();
+  for (SizeValueType brickNumber = 0; brickNumber < numberOfBricks; ++brickNumber)
+  {
+    std::unique_ptr<TPixel[]> & brick = bricks.AllocatedBricks[brickNumber];
+    if (brick && std::all_of(brick.get(), brick.get() + NumberOfPixelsPerBrick, [&backgroundValue](const TPixel & p) {
+          return Math::ExactlyEquals(p, backgroundValue);
+        }))
+    {
+      brick.reset();
+      bricks.Table[brickNumber] = bricks.EmptyBrick.get();
+      ++numberOfReleasedBricks;
+    }
+  }
+  bricks.NumberOfAllocatedBricks -= numberOfReleasedBricks;
+  return numberOfReleasedBricks;
+}
+
+
+template <typename TPixel, unsigned int VImageDimension, unsigned int VBrickSize>
+unsigned int
+BrickedImage<TPixel, VImageDimension, VBrickSize>::GetNumberOfComponentsPerPixel() const
+{
+  return NumericTraits<PixelType>::GetLength(m_Bricks->BackgroundValue);
+}
+
+
+template <typename TPixel, unsigned int VImageDimension, unsigned int VBrickSize>
+void
+BrickedImage<TPixel, VImageDimension, VBrickSize>::Graft(const Self * image)
+{
+  // call the superclass' implementation
+  Superclass::Graft(image);
+
+  if (image)
+  {
+    // Now copy anything remaining that is needed
+    m_Bricks = image->m_Bricks;
+    m_BrickGridSize = image->m_BrickGridSize;
+    std::copy_n(image->m_BrickOffsetTable, VImageDimension, m_BrickOffsetTable);
+  }
+}
+
+
+template <typename TPixel, unsigned int VImageDimension, unsigned int VBrickSize>
+void
+BrickedImage<TPixel, VImageDimension, VBrickSize>::Graft(const DataObject * data)
+{
+  if (data)
+  {
+    // Attempt to cast data to a BrickedImage
+    const auto * const imgData = dynamic_cast<const Self *>(data);
+
+    if (imgData != nullptr)
+    {
+      this->Graft(imgData);
+    }
+    else
+    {
+      // pointer could not be cast back down
+      itkExceptionMacro(<< "itk::BrickedImage::Graft() cannot cast " << typeid(data).name() << " to "
+                        << typeid(const Self *).name());
+    }
+  }
+}
+
+
+template <typename TPixel, unsigned int VImageDimension, unsigned int VBrickSize>
+void
+BrickedImage<TPixel, VImageDimension, VBrickSize>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "BrickSize: " << VBrickSize << std::endl;
+  os << indent << "BrickGridSize: " << m_BrickGridSize << std::endl;
+  os << indent << "NumberOfAllocatedBricks: " << m_Bricks->NumberOfAllocatedBricks.load() << std::endl;
+  os << indent << "BackgroundValue: "
+     << static_cast<typename NumericTraits<TPixel>::PrintType>(m_Bricks->BackgroundValue) << std::endl;
+}
+
+// static constexpr definitions explicitly needed in C++11
+template <typename TPixel, unsigned int VImageDimension, unsigned int VBrickSize>
+constexpr unsigned int BrickedImage<TPixel, VImageDimension, VBrickSize>::ImageDimension;
+template <typename TPixel, unsigned int VImageDimension, unsigned int VBrickSize>
+constexpr unsigned int BrickedImage<TPixel, VImageDimension, VBrickSize>::BrickSize;
+template <typename TPixel, unsigned int VImageDimension, unsigned int VBrickSize>
+constexpr typename BrickedImage<TPixel, VImageDimension, VBrickSize>::SizeValueType
+  BrickedImage<TPixel, VImageDimension, VBrickSize>::NumberOfPixelsPerBrick;
+template <typename TPixel, unsigned int VImageDimension, unsigned int VBrickSize>
+constexpr unsigned int BrickedImage<TPixel, VImageDimension, VBrickSize>::BrickSizeLog2;
+} // end namespace itk
+
+#endif
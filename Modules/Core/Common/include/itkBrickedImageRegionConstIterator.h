@@ -0,0 +1,196 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBrickedImageRegionConstIterator_h
+#define itkBrickedImageRegionConstIterator_h
+
+#include "itkBrickedImage.h"
+
+#include <algorithm>
+
+namespace itk
+{
+/** \class BrickedImageRegionConstIterator
+ * \brief Const iterator over the pixels of a region of a BrickedImage.
+ *
+ * The iterator visits the pixels in the same order as
+ * ImageRegionConstIterator: the index increases fastest along the first
+ * dimension. A line of the region is cut into segments by the bricks it
+ * crosses; the pixels of a segment are contiguous, so that moving to the next
+ * pixel of a segment only increments a pointer.
+ *
+ * \code
+ * BrickedImageRegionConstIterator<ImageType> it(image, region);
+ * for (; !it.IsAtEnd(); ++it)
+ * {
+ *   sum += it.Get();
+ * }
+ * \endcode
+ *
+ * \sa BrickedImage
+ * \sa BrickedImageRegionIterator
+ *
+ * \ingroup ImageIterators
+ * \ingroup ITKCommon
+ */
+template <typename TImage>
+class ITK_TEMPLATE_EXPORT BrickedImageRegionConstIterator
+{
+public:
+  /** Standard class type aliases. */
+  using Self = BrickedImageRegionConstIterator;
+
+  using ImageType = TImage;
+  using PixelType = typename TImage::PixelType;
+  using IndexType = typename TImage::IndexType;
+  using IndexValueType = typename TImage::IndexValueType;
+  using SizeValueType = typename TImage::SizeValueType;
+  using RegionType = typename TImage::RegionType;
+
+  static constexpr unsigned int ImageDimension = TImage::ImageDimension;
+
+  /** Constructs an iterator that is at its end, and has no image. */
+  BrickedImageRegionConstIterator() = default;
+
+  /** Constructs an iterator over the specified region, which must be inside
+   * the buffered region of the image, positioned at its first pixel. */
+  BrickedImageRegionConstIterator(const ImageType * image, const RegionType & region)
+    : m_Image(image)
+    , m_Region(region)
+  {
+    itkAssertInDebugAndIgnoreInReleaseMacro(region.GetNumberOfPixels() == 0 ||
+                                            image->GetBufferedRegion().IsInside(region));
+    this->GoToBegin();
+  }
+
+  /** Moves the iterator to the first pixel of the region. */
+  void
+  GoToBegin()
+  {
+    m_SegmentIndex = m_Region.GetIndex();
+    m_IsAtEnd = (m_Image == nullptr || m_Region.GetNumberOfPixels() == 0);
+    if (!m_IsAtEnd)
+    {
+      this->SetSegment();
+    }
+  }
+
+  /** Returns true when the iterator has moved past the last pixel of the
+   * region. */
+  bool
+  IsAtEnd() const
+  {
+    return m_IsAtEnd;
+  }
+
+  /** Moves the iterator to the next pixel of the region. */
+  Self &
+  operator++()
+  {
+    ++m_Pixel;
+    if (m_Pixel == m_SegmentEnd)
+    {
+      this->NextSegment();
+    }
+    return *this;
+  }
+
+  /** Returns the index of the pixel. */
+  IndexType
+  GetIndex() const
+  {
+    IndexType index = m_SegmentIndex;
+    index[0] += m_Pixel - m_SegmentBegin;
+    return index;
+  }
+
+  /** Returns the value of the pixel. */
+  const PixelType &
+  Get() const
+  {
+    return *m_Pixel;
+  }
+
+  /** Returns the region walked by the iterator. */
+  const RegionType &
+  GetRegion() const
+  {
+    return m_Region;
+  }
+
+protected:
+  // Positions the iterator at m_SegmentIndex, at the start of the segment of
+  // its line that lies in a single brick.
+  void
+  SetSegment()
+  {
+    SizeValueType pixelOffset;
+    m_Image->ComputeBrickNumberAndPixelOffset(m_SegmentIndex, m_BrickNumber, pixelOffset);
+    m_Brick = m_Image->GetBrick(m_BrickNumber);
+    m_IsBrickAllocated = m_Image->IsBrickAllocated(m_BrickNumber);
+
+    const IndexValueType lineEnd = m_Region.GetIndex(0) + static_cast<IndexValueType>(m_Region.GetSize(0));
+    const auto           lineLength = static_cast<SizeValueType>(lineEnd - m_SegmentIndex[0]);
+    const SizeValueType  length = std::min(ImageType::BrickSize - pixelOffset % ImageType::BrickSize, lineLength);
+    m_SegmentBegin = m_Brick + pixelOffset;
+    m_SegmentEnd = m_SegmentBegin + length;
+    m_Pixel = m_SegmentBegin;
+  }
+
+  // Moves to the start of the next segment, or to the end of the region.
+  void
+  NextSegment()
+  {
+    m_SegmentIndex[0] += m_SegmentEnd - m_SegmentBegin;
+    if (m_SegmentIndex[0] < m_Region.GetIndex(0) + static_cast<IndexValueType>(m_Region.GetSize(0)))
+    {
+      this->SetSegment();
+      return;
+    }
+    m_SegmentIndex[0] = m_Region.GetIndex(0);
+    for (unsigned int d = 1; d < ImageDimension; ++d)
+    {
+      ++m_SegmentIndex[d];
+      if (m_SegmentIndex[d] < m_Region.GetIndex(d) + static_cast<IndexValueType>(m_Region.GetSize(d)))
+      {
+        this->SetSegment();
+        return;
+      }
+      m_SegmentIndex[d] = m_Region.GetIndex(d);
+    }
+    m_Pixel = m_SegmentBegin;
+    m_IsAtEnd = true;
+  }
+
+  const ImageType * m_Image{ nullptr };
+  RegionType        m_Region;
+  IndexType         m_SegmentIndex{ { 0 } };
+  SizeValueType     m_BrickNumber{ 0 };
+  const PixelType * m_Brick{ nullptr };
+  const PixelType * m_SegmentBegin{ nullptr };
+  const PixelType * m_SegmentEnd{ nullptr };
+  const PixelType * m_Pixel{ nullptr };
+  bool              m_IsBrickAllocated{ false };
+  bool              m_IsAtEnd{ true };
+};
+
+// static constexpr definitions explicitly needed in C++11
+template <typename TImage>
+constexpr unsigned int BrickedImageRegionConstIterator<TImage>::ImageDimension;
+} // end namespace itk
+
+#endif
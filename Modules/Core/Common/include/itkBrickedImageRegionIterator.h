@@ -0,0 +1,104 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBrickedImageRegionIterator_h
+#define itkBrickedImageRegionIterator_h
+
+#include "itkBrickedImageRegionConstIterator.h"
+
+namespace itk
+{
+/** \class BrickedImageRegionIterator
+ * \brief Iterator over the pixels of a region of a BrickedImage, which can set
+ * the pixels.
+ *
+ * Set() allocates the brick of the pixel, unless the brick is allocated
+ * already or the value is the background value of the image. Setting the
+ * pixels of a dense image to the pixels of a sparse one therefore only
+ * allocates the bricks that are not background.
+ *
+ * \warning An iterator keeps reading the background value in a brick that was
+ * allocated by another iterator, or by BrickedImage::SetPixel(), after it had
+ * moved into the brick.
+ *
+ * \sa BrickedImage
+ * \sa BrickedImageRegionConstIterator
+ *
+ * \ingroup ImageIterators
+ * \ingroup ITKCommon
+ */
+template <typename TImage>
+class ITK_TEMPLATE_EXPORT BrickedImageRegionIterator : public BrickedImageRegionConstIterator<TImage>
+{
+public:
+  /** Standard class type aliases. */
+  using Self = BrickedImageRegionIterator;
+  using Superclass = BrickedImageRegionConstIterator<TImage>;
+
+  using ImageType = typename Superclass::ImageType;
+  using PixelType = typename Superclass::PixelType;
+  using RegionType = typename Superclass::RegionType;
+
+  /** Constructs an iterator that is at its end, and has no image. */
+  BrickedImageRegionIterator() = default;
+
+  /** Constructs an iterator over the specified region, which must be inside
+   * the buffered region of the image, positioned at its first pixel. */
+  BrickedImageRegionIterator(ImageType * image, const RegionType & region)
+    : Superclass(image, region)
+  {}
+
+  /** Sets the value of the pixel. */
+  void
+  Set(const PixelType & value)
+  {
+    if (!this->m_IsBrickAllocated)
+    {
+      if (Math::ExactlyEquals(value, this->m_Image->GetBackgroundValue()))
+      {
+        return;
+      }
+      this->RebaseOnAllocatedBrick();
+    }
+    *const_cast<PixelType *>(this->m_Pixel) = value;
+  }
+
+  /** Moves the iterator to the next pixel of the region. */
+  Self &
+  operator++()
+  {
+    Superclass::operator++();
+    return *this;
+  }
+
+private:
+  // Allocates the brick of the pixel, and moves the pointers of the iterator
+  // from the shared empty brick to the allocated one.
+  void
+  RebaseOnAllocatedBrick()
+  {
+    const PixelType * brick = const_cast<ImageType *>(this->m_Image)->GetWritableBrick(this->m_BrickNumber);
+    this->m_SegmentBegin = brick + (this->m_SegmentBegin - this->m_Brick);
+    this->m_SegmentEnd = brick + (this->m_SegmentEnd - this->m_Brick);
+    this->m_Pixel = brick + (this->m_Pixel - this->m_Brick);
+    this->m_Brick = brick;
+    this->m_IsBrickAllocated = true;
+  }
+};
+} // end namespace itk
+
+#endif
@@ -0,0 +1,238 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBrickedImageRegionRange_h
+#define itkBrickedImageRegionRange_h
+
+#include <cstddef>     // For ptrdiff_t.
+#include <iterator>    // For forward_iterator_tag.
+#include <type_traits> // For conditional and is_const.
+
+#include "itkBrickedImageRegionIterator.h"
+
+namespace itk
+{
+
+/**
+ * \class BrickedImageRegionRange
+ * C++11 range to iterate over the pixels of a region of a BrickedImage, the
+ * counterpart of ImageRegionRange. It can be used in a range-based for loop,
+ * and passed to the Standard C++ algorithms that take forward iterators.
+ *
+ * The following example adds 42 to each pixel, using a range-based for loop:
+   \code
+   BrickedImageRegionRange<ImageType> range{ *image, imageRegion };
+
+   for (auto&& pixel : range)
+   {
+     pixel = pixel + 42;
+   }
+   \endcode
+ *
+ * The pixels of a range over a non-const image are accessed through a proxy,
+ * which sets the pixel like BrickedImageRegionIterator::Set(). The proxy refers
+ * to the iterator that returned it, and must not outlive it.
+ *
+ * \see BrickedImage
+ * \see ImageRegionRange
+ * \ingroup ImageIterators
+ * \ingroup ITKCommon
+ */
+template <typename TImage>
+class BrickedImageRegionRange final
+{
+private:
+  using ImageType = typename std::remove_const<TImage>::type;
+  using PixelType = typename TImage::PixelType;
+  using RegionType = typename TImage::RegionType;
+
+  static constexpr bool IsImageTypeConst = std::is_const<TImage>::value;
+
+  using RegionIteratorType = typename std::conditional<IsImageTypeConst,
+                                                       BrickedImageRegionConstIterator<ImageType>,
+                                                       BrickedImageRegionIterator<ImageType>>::type;
+
+  // Reference to a pixel of a non-const image.
+  class PixelProxy final
+  {
+  public:
+    explicit PixelProxy(RegionIteratorType & regionIterator) ITK_NOEXCEPT : m_RegionIterator(regionIterator) {}
+
+    /** Returns the value of the pixel. */
+    operator PixelType() const ITK_NOEXCEPT { return m_RegionIterator.Get(); }
+
+    /** Sets the value of the pixel. */
+    PixelProxy &
+    operator=(const PixelType & pixelValue)
+    {
+      m_RegionIterator.Set(pixelValue);
+      return *this;
+    }
+
+    /** Sets the value of the pixel to the value of the pixel of another proxy. */
+    PixelProxy &
+    operator=(const PixelProxy & pixelProxy)
+    {
+      m_RegionIterator.Set(static_cast<PixelType>(pixelProxy));
+      return *this;
+    }
+
+    PixelProxy(const PixelProxy &) ITK_NOEXCEPT = default;
+
+  private:
+    RegionIteratorType & m_RegionIterator;
+  };
+
+  class Iterator final
+  {
+  private:
+    friend class BrickedImageRegionRange;
+
+    // The region iterator is mutable, because a PixelProxy refers to it.
+    mutable RegionIteratorType m_RegionIterator;
+
+    // The number of pixels before the current one, used to compare iterators.
+    SizeValueType m_Position{ 0 };
+
+    Iterator(const RegionIteratorType & regionIterator, const SizeValueType position)
+      : m_RegionIterator(regionIterator)
+      , m_Position(position)
+    {}
+
+  public:
+    // Types conforming the iterator requirements of the C++ standard library:
+    using difference_type = std::ptrdiff_t;
+    using value_type = PixelType;
+    using reference = typename std::conditional<IsImageTypeConst, const PixelType &, PixelProxy>::type;
+    using pointer = typename std::conditional<IsImageTypeConst, const PixelType *, void>::type;
+    using iterator_category = std::forward_iterator_tag;
+
+    Iterator() = default;
+
+    /** Returns a reference to the current pixel. */
+    reference operator*() const ITK_NOEXCEPT { return Dereference(std::integral_constant<bool, IsImageTypeConst>{}); }
+
+    /** Prefix increment ('++it'). */
+    Iterator &
+    operator++() ITK_NOEXCEPT
+    {
+      ++m_RegionIterator;
+      ++m_Position;
+      return *this;
+    }
+
+    /** Postfix increment ('it++').
+     * \note Usually prefix increment ('++it') is preferable. */
+    Iterator
+    operator++(int) ITK_NOEXCEPT
+    {
+      auto result = *this;
+      ++(*this);
+      return result;
+    }
+
+    /** Returns (it1 == it2) for iterators it1 and it2, which should be from the
+     * same range. */
+    friend bool
+    operator==(const Iterator & lhs, const Iterator & rhs) ITK_NOEXCEPT
+    {
+      return lhs.m_Position == rhs.m_Position;
+    }
+
+    /** Returns (it1 != it2) for iterators it1 and it2. */
+    friend bool
+    operator!=(const Iterator & lhs, const Iterator & rhs) ITK_NOEXCEPT
+    {
+      return !(lhs == rhs);
+    }
+
+  private:
+    const PixelType &
+    Dereference(std::true_type) const ITK_NOEXCEPT
+    {
+      return m_RegionIterator.Get();
+    }
+
+    PixelProxy
+    Dereference(std::false_type) const ITK_NOEXCEPT
+    {
+      return PixelProxy(m_RegionIterator);
+    }
+  };
+
+  TImage *   m_Image{ nullptr };
+  RegionType m_IterationRegion;
+
+public:
+  using iterator = Iterator;
+
+  /** Constructs an empty range. */
+  BrickedImageRegionRange() ITK_NOEXCEPT = default;
+
+  /** Constructs an object, representing the range of pixels of the specified
+   * region, within the specified image. */
+  explicit BrickedImageRegionRange(TImage & image, const RegionType & iterationRegion)
+    : m_Image(&image)
+    , m_IterationRegion(iterationRegion)
+  {
+    if (iterationRegion.GetNumberOfPixels() > 0)
+    {
+      const auto & bufferedRegion = image.GetBufferedRegion();
+
+      itkAssertOrThrowMacro((bufferedRegion.IsInside(iterationRegion)),
+                            "Iteration region " << iterationRegion << " is outside of buffered region "
+                                                << bufferedRegion);
+    }
+  }
+
+  /** Constructs a range of the pixels of the requested region of an image. */
+  explicit BrickedImageRegionRange(TImage & image)
+    : BrickedImageRegionRange(image, image.GetRequestedRegion())
+  {}
+
+  /** Returns an iterator to the first pixel. */
+  iterator
+  begin() const
+  {
+    return (m_Image == nullptr) ? iterator{} : iterator{ RegionIteratorType(m_Image, m_IterationRegion), 0 };
+  }
+
+  /** Returns an 'end iterator' for this range. */
+  iterator
+  end() const ITK_NOEXCEPT
+  {
+    return iterator{ RegionIteratorType(), this->size() };
+  }
+
+  /** Returns the size of the range, that is the number of pixels in the region. */
+  SizeValueType
+  size() const ITK_NOEXCEPT
+  {
+    return m_IterationRegion.GetNumberOfPixels();
+  }
+
+  /** Tells whether the range is empty. */
+  bool
+  empty() const ITK_NOEXCEPT
+  {
+    return this->size() == 0;
+  }
+};
+
+} // namespace itk
+
+#endif
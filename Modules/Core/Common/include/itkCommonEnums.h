@@ -88,7 +88,8 @@ public:
     ULONGLONG,
     FLOAT,
     DOUBLE,
-    LDOUBLE
+    LDOUBLE,
+    FLOAT16
   };
 
   /**
@@ -18,6 +18,7 @@
 #ifndef itkDefaultConvertPixelTraits_h
 #define itkDefaultConvertPixelTraits_h
 
+#include "itkFloat16.h"
 #include "itkOffset.h"
 #include "itkVector.h"
 #include "itkMatrix.h"
@@ -127,6 +128,7 @@ ITK_DEFAULTCONVERTTRAITS_NATIVE_SPECIAL(unsigned long)
 ITK_DEFAULTCONVERTTRAITS_NATIVE_SPECIAL(long long)
 ITK_DEFAULTCONVERTTRAITS_NATIVE_SPECIAL(unsigned long long)
 ITK_DEFAULTCONVERTTRAITS_NATIVE_SPECIAL(bool)
+ITK_DEFAULTCONVERTTRAITS_NATIVE_SPECIAL(Float16)
 
 #undef ITK_DEFAULTCONVERTTRAITS_NATIVE_SPECIAL
 
@@ -21,6 +21,8 @@
 #include "itkObject.h"
 #include "itkMultiThreaderBase.h"
 
+#include <atomic>
+
 namespace itk
 {
 
@@ -53,6 +55,16 @@ namespace itk
  *  \c DetermineNumberOfWorkUnitsToUse, \c BeforeThreadedExecution, \c ThreadedExecution,
  *  and \c AfterThreadedExecution virtual methods.
  *
+ *  By default, the domain is split into one subdomain per work unit. When the
+ *  time needed to process the subdomains varies, for example because only
+ *  the pixels of a mask are processed, the slowest work unit sets the total
+ *  time. Setting a GrainSize splits the domain into many smaller subdomains
+ *  instead, of about GrainSize elements each, which the work units process
+ *  one after the other, each taking the next subdomain that is not processed
+ *  yet. \c ThreadedExecution is then called several times with the same
+ *  threadId, so it must accumulate its per thread results rather than assign
+ *  them.
+ *
  *  \tparam TDomainPartitioner A class that inherits from
  *  ThreadedDomainPartitioner.
  *  \tparam TAssociate  The associated class that uses a derived version of
@@ -98,6 +110,19 @@ public:
    * ThreadedExecution. */
   itkGetConstMacro(NumberOfWorkUnitsUsed, ThreadIdType);
 
+  /** Set/Get the grain size: the approximate number of elements of the
+   * domain (pixels, indices, ...) in a subdomain. The default value, zero,
+   * splits the domain into one subdomain per work unit. A non-zero grain size
+   * splits the domain into more subdomains than work units, when it is large
+   * enough, and has no effect if the DomainPartitioner cannot compute the
+   * size of the domain. */
+  itkSetMacro(GrainSize, SizeValueType);
+  itkGetConstMacro(GrainSize, SizeValueType);
+
+  /** Accessor for the number of subdomains that were processed in the last
+   * ThreadedExecution. */
+  itkGetConstMacro(NumberOfSubdomainsUsed, ThreadIdType);
+
   /** Return the multithreader used by this class. */
   MultiThreaderBase *
   GetMultiThreader() const;
@@ -140,7 +165,8 @@ protected:
   /** Do the threaded operation, somewhat like \c ThreadedGenerateData in an
    * ImageSource.
    * \param subdomain The subdomain to operate on.
-   * \param threadId  The identifier for the current thread.
+   * \param threadId  The identifier for the current thread. The method is
+   * called once per threadId, or several times when a GrainSize is set.
    * Data to perform the operation on can be accessed by dereferencing
    * this->m_Associate, which has direct access to private and protected
    * members the enclosing class.
@@ -181,6 +207,14 @@ private:
    * This value is determined at the beginning of \c Execute(). */
   ThreadIdType                            m_NumberOfWorkUnitsUsed{ 0 };
   ThreadIdType                            m_NumberOfWorkUnits;
+  SizeValueType                           m_GrainSize{ 0 };
+
+  /** The number of subdomains, and the total that was requested from the
+   * DomainPartitioner to get them. When there are more subdomains than work
+   * units, m_NextSubdomain is the next subdomain to process. */
+  ThreadIdType                            m_NumberOfSubdomainsUsed{ 0 };
+  ThreadIdType                            m_RequestedNumberOfSubdomains{ 0 };
+  std::atomic<ThreadIdType>               m_NextSubdomain{ 0 };
   typename DomainPartitionerType::Pointer m_DomainPartitioner;
   DomainType                              m_CompleteDomain;
   MultiThreaderBase::Pointer              m_MultiThreader;
@@ -20,6 +20,8 @@
 
 #include "itkDomainThreader.h"
 
+#include <algorithm>
+
 namespace itk
 {
 
@@ -74,18 +76,32 @@ DomainThreader<TDomainPartitioner, TAssociate>::DetermineNumberOfWorkUnitsUsed()
 {
   ThreadIdType numberOfWorkUnits = this->GetNumberOfWorkUnits();
 
+  // With a grain size, request one subdomain per grain, and at least one
+  // subdomain per work unit.
+  ThreadIdType        requestedNumberOfSubdomains = numberOfWorkUnits;
+  const SizeValueType domainSize = this->m_DomainPartitioner->GetDomainSize(this->m_CompleteDomain);
+  if (this->m_GrainSize > 0 && domainSize > 0)
+  {
+    const SizeValueType numberOfGrains = (domainSize - 1) / this->m_GrainSize + 1;
+    requestedNumberOfSubdomains = static_cast<ThreadIdType>(std::max<SizeValueType>(
+      numberOfWorkUnits, std::min<SizeValueType>(numberOfGrains, NumericTraits<ThreadIdType>::max())));
+  }
+
   // Attempt a single dummy partition, just to get the number of subdomains actually created
   DomainType subdomain;
-  this->m_NumberOfWorkUnitsUsed =
-    this->m_DomainPartitioner->PartitionDomain(0, numberOfWorkUnits, this->m_CompleteDomain, subdomain);
+  this->m_NumberOfSubdomainsUsed = this->m_DomainPartitioner->PartitionDomain(
+    0, requestedNumberOfSubdomains, this->m_CompleteDomain, subdomain);
+  this->m_RequestedNumberOfSubdomains = requestedNumberOfSubdomains;
+  this->m_NextSubdomain = 0;
 
-  this->GetMultiThreader()->SetNumberOfWorkUnits(this->m_NumberOfWorkUnitsUsed);
-
-  if (this->m_NumberOfWorkUnitsUsed > numberOfWorkUnits)
+  if (this->m_NumberOfSubdomainsUsed > requestedNumberOfSubdomains)
   {
     itkExceptionMacro("A subclass of ThreadedDomainPartitioner::PartitionDomain"
                       << "returned more subdomains than were requested");
   }
+
+  this->m_NumberOfWorkUnitsUsed = std::min(numberOfWorkUnits, this->m_NumberOfSubdomainsUsed);
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->m_NumberOfWorkUnitsUsed);
 }
 
 template <typename TDomainPartitioner, typename TAssociate>
@@ -112,9 +128,24 @@ DomainThreader<TDomainPartitioner, TAssociate>::ThreaderCallback(void * arg)
   DomainThreader *   thisDomainThreader = str->domainThreader;
   const ThreadIdType threadId = info->WorkUnitID;
   const ThreadIdType threadCount = info->NumberOfWorkUnits;
+  DomainType         subdomain;
+
+  if (thisDomainThreader->m_NumberOfSubdomainsUsed > threadCount)
+  {
+    // There are more subdomains than work units: process the subdomains that
+    // are not taken yet by the other work units, until there is none left.
+    const ThreadIdType numberOfSubdomains = thisDomainThreader->m_NumberOfSubdomainsUsed;
+    for (ThreadIdType subdomainId = thisDomainThreader->m_NextSubdomain++; subdomainId < numberOfSubdomains;
+         subdomainId = thisDomainThreader->m_NextSubdomain++)
+    {
+      thisDomainThreader->GetDomainPartitioner()->PartitionDomain(
+        subdomainId, thisDomainThreader->m_RequestedNumberOfSubdomains, thisDomainThreader->m_CompleteDomain, subdomain);
+      thisDomainThreader->ThreadedExecution(subdomain, threadId);
+    }
+    return ITK_THREAD_RETURN_DEFAULT_VALUE;
+  }
 
   // Get the sub-domain to process for this thread.
-  DomainType         subdomain;
   const ThreadIdType total = thisDomainThreader->GetDomainPartitioner()->PartitionDomain(
     threadId, threadCount, thisDomainThreader->m_CompleteDomain, subdomain);
 
@@ -0,0 +1,170 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFixedNeighborhoodAllocator_h
+#define itkFixedNeighborhoodAllocator_h
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include "itkMacro.h"
+
+namespace itk
+{
+/** \class FixedNeighborhoodAllocator
+ *  \brief A memory allocator for Neighborhood that stores its elements in a
+ *         fixed-capacity array, instead of on the heap.
+ *
+ * FixedNeighborhoodAllocator has the same API as NeighborhoodAllocator, so
+ * that it can be used as the TAllocator template argument of Neighborhood and
+ * NeighborhoodOperator. The elements are stored inside the allocator object
+ * itself, so that a small operator declared as a local variable does not need
+ * any heap allocation. The number of elements may be anything up to
+ * VCapacity; requesting more raises an exception.
+ *
+ * For example, the operator of a first order derivative along one direction
+ * has three coefficients:
+ * \code
+ * DerivativeOperator<double, 3, FixedNeighborhoodAllocator<double, 3>> op;
+ * \endcode
+ *
+ * \sa NeighborhoodAllocator
+ * \sa FixedRadiusConstNeighborhoodIterator
+ *
+ * \ingroup Operators
+ * \ingroup ITKCommon
+ */
+template <typename TPixel, unsigned int VCapacity>
+class FixedNeighborhoodAllocator
+{
+public:
+  /** Standard class type aliases. */
+  using Self = FixedNeighborhoodAllocator;
+
+  /** Iterator support, with the same lower case names as in
+   * NeighborhoodAllocator. */
+  using iterator = TPixel *;
+  using const_iterator = const TPixel *;
+
+  /** The maximum number of elements. */
+  static constexpr unsigned int Capacity = VCapacity;
+
+  /** Default constructor */
+  FixedNeighborhoodAllocator() = default;
+
+  /** Sets the number of elements. The memory is part of the object, so
+   * nothing is allocated. */
+  void
+  Allocate(unsigned int n)
+  {
+    if (n > VCapacity)
+    {
+      itkGenericExceptionMacro(<< "FixedNeighborhoodAllocator: cannot hold " << n << " elements, the capacity is "
+                               << VCapacity);
+    }
+    m_ElementCount = n;
+  }
+
+  /** Sets the number of elements to zero. */
+  void
+  Deallocate()
+  {
+    m_ElementCount = 0;
+  }
+
+  /** STL-style iterator support for the memory buffer. */
+  iterator
+  begin()
+  {
+    return m_Data.data();
+  }
+  const_iterator
+  begin() const
+  {
+    return m_Data.data();
+  }
+  iterator
+  end()
+  {
+    return m_Data.data() + m_ElementCount;
+  }
+  const_iterator
+  end() const
+  {
+    return m_Data.data() + m_ElementCount;
+  }
+  unsigned int
+  size() const
+  {
+    return m_ElementCount;
+  }
+
+  /** Data access methods */
+  const TPixel & operator[](unsigned int i) const { return m_Data[i]; }
+  TPixel &       operator[](unsigned int i) { return m_Data[i]; }
+
+  /** Sets the number of elements to n. */
+  void
+  set_size(unsigned int n)
+  {
+    this->Allocate(n);
+  }
+
+  TPixel *
+  data() ITK_NOEXCEPT
+  {
+    return m_Data.data();
+  }
+
+  const TPixel *
+  data() const ITK_NOEXCEPT
+  {
+    return m_Data.data();
+  }
+
+private:
+  unsigned int                  m_ElementCount{ 0 };
+  std::array<TPixel, VCapacity> m_Data{ {} };
+};
+
+template <typename TPixel, unsigned int VCapacity>
+inline std::ostream &
+operator<<(std::ostream & o, const FixedNeighborhoodAllocator<TPixel, VCapacity> & a)
+{
+  o << "FixedNeighborhoodAllocator { this = " << &a << ", capacity = " << VCapacity << ", size=" << a.size() << " }";
+  return o;
+}
+
+
+// Equality operator.
+template <typename TPixel, unsigned int VCapacity>
+inline bool
+operator==(const FixedNeighborhoodAllocator<TPixel, VCapacity> & lhs,
+           const FixedNeighborhoodAllocator<TPixel, VCapacity> & rhs)
+{
+  return (lhs.size() == rhs.size()) && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+// Inequality operator.
+template <typename TPixel, unsigned int VCapacity>
+inline bool
+operator!=(const FixedNeighborhoodAllocator<TPixel, VCapacity> & lhs,
+           const FixedNeighborhoodAllocator<TPixel, VCapacity> & rhs)
+{
+  return !(lhs == rhs);
+}
+} // end namespace itk
+#endif
@@ -0,0 +1,276 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFixedRadiusConstNeighborhoodIterator_h
+#define itkFixedRadiusConstNeighborhoodIterator_h
+
+#include "itkImageRegion.h"
+#include "itkMath.h"
+
+#include <array>
+
+namespace itk
+{
+/** \class FixedRadiusConstNeighborhoodIterator
+ * \brief Const iterator over the hyperrectangular neighborhoods of a fixed,
+ * compile-time radius, for regions away from the buffer boundary.
+ *
+ * FixedRadiusConstNeighborhoodIterator walks a region of an image, like
+ * ConstNeighborhoodIterator, but the radius of its neighborhood is the
+ * template argument VRadius, the same in every dimension. The number of
+ * neighbors, the strides and the neighbor offsets are compile-time constants,
+ * and the buffer offsets of the neighbors are stored in an std::array inside
+ * the iterator. Moving to the next pixel only increments a pointer. Loops
+ * over the neighbors of a small stencil can therefore be fully unrolled by the
+ * compiler.
+ *
+ * The neighbors are numbered like the ones of Neighborhood: the neighbor index
+ * increases fastest along the first dimension, and the center has index
+ * CenterNeighborIndex.
+ *
+ * \warning The iterator has no boundary condition: the neighborhood of every
+ * pixel of the region must be inside the buffered region of the image. Use it
+ * for the non-boundary region computed by
+ * NeighborhoodAlgorithm::ImageBoundaryFacesCalculator, and handle the boundary
+ * faces with ConstNeighborhoodIterator.
+ *
+ * \code
+ * FixedRadiusConstNeighborhoodIterator<ImageType> it(image, nonBoundaryRegion);
+ * for (; !it.IsAtEnd(); ++it)
+ * {
+ *   double sum = 0.0;
+ *   for (unsigned int n = 0; n < it.NumberOfNeighbors; ++n)
+ *   {
+ *     sum += it.GetPixel(n);
+ *   }
+ * }
+ * \endcode
+ *
+ * \sa ConstNeighborhoodIterator
+ * \sa FixedNeighborhoodAllocator
+ *
+ * \ingroup ImageIterators
+ * \ingroup ITKCommon
+ */
+template <typename TImage, unsigned int VRadius = 1>
+class ITK_TEMPLATE_EXPORT FixedRadiusConstNeighborhoodIterator
+{
+public:
+  /** Standard class type aliases. */
+  using Self = FixedRadiusConstNeighborhoodIterator;
+
+  using ImageType = TImage;
+  using ImageDimensionType = typename TImage::ImageDimensionType;
+  static constexpr ImageDimensionType ImageDimension = TImage::ImageDimension;
+
+  /** The radius, the diameter and the number of pixels of the neighborhood. */
+  static constexpr unsigned int Radius = VRadius;
+  static constexpr unsigned int Diameter = 2 * VRadius + 1;
+  static constexpr unsigned int NumberOfNeighbors = Math::UnsignedPower<unsigned int>(Diameter, ImageDimension);
+
+  /** The neighbor index of the center pixel. */
+  static constexpr unsigned int CenterNeighborIndex = NumberOfNeighbors / 2;
+
+  using PixelType = typename TImage::PixelType;
+  using InternalPixelType = typename TImage::InternalPixelType;
+  using NeighborhoodAccessorFunctorType = typename TImage::NeighborhoodAccessorFunctorType;
+  using RegionType = typename TImage::RegionType;
+  using IndexType = typename TImage::IndexType;
+  using OffsetType = typename TImage::OffsetType;
+  using BufferOffsetsType = std::array<OffsetValueType, NumberOfNeighbors>;
+
+  /** Returns the difference between the indices of two neighbors that are
+   * adjacent along the specified dimension. */
+  static constexpr unsigned int
+  GetNeighborStride(const unsigned int dimension)
+  {
+    return Math::UnsignedPower<unsigned int>(Diameter, dimension);
+  }
+
+  /** Returns the component, along the specified dimension, of the offset of a
+   * neighbor from the center. */
+  static constexpr OffsetValueType
+  GetNeighborOffset(const unsigned int neighborIndex, const unsigned int dimension)
+  {
+    return static_cast<OffsetValueType>((neighborIndex / GetNeighborStride(dimension)) % Diameter) -
+           static_cast<OffsetValueType>(VRadius);
+  }
+
+  /** Returns the offset of a neighbor from the center. */
+  static OffsetType
+  GetOffset(const unsigned int neighborIndex)
+  {
+    OffsetType offset;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      offset[d] = GetNeighborOffset(neighborIndex, d);
+    }
+    return offset;
+  }
+
+  /** Constructs an iterator over the specified region, positioned at its
+   * first pixel. The neighborhood of every pixel of the region must be inside
+   * the buffered region of the image. */
+  FixedRadiusConstNeighborhoodIterator(const ImageType * image, const RegionType & region)
+    : m_Image(image)
+    , m_Region(region)
+    , m_NeighborhoodAccessor(image->GetNeighborhoodAccessor())
+  {
+    RegionType paddedRegion = region;
+    paddedRegion.PadByRadius(VRadius);
+    itkAssertInDebugAndIgnoreInReleaseMacro(region.GetNumberOfPixels() == 0 ||
+                                            image->GetBufferedRegion().IsInside(paddedRegion));
+    (void)paddedRegion;
+
+    m_BufferPointer = image->GetBufferPointer();
+    m_NeighborhoodAccessor.SetBegin(m_BufferPointer);
+
+    const OffsetValueType * offsetTable = image->GetOffsetTable();
+    for (unsigned int n = 0; n < NumberOfNeighbors; ++n)
+    {
+      OffsetValueType bufferOffset = 0;
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        bufferOffset += GetNeighborOffset(n, d) * offsetTable[d];
+      }
+      m_BufferOffsets[n] = bufferOffset;
+    }
+    this->GoToBegin();
+  }
+
+  /** Moves the iterator to the first pixel of the region. */
+  void
+  GoToBegin()
+  {
+    m_LineIndex = m_Region.GetIndex();
+    m_IsAtEnd = (m_Region.GetNumberOfPixels() == 0);
+    if (!m_IsAtEnd)
+    {
+      this->SetLine();
+    }
+  }
+
+  /** Returns true when the iterator has moved past the last pixel of the
+   * region. */
+  bool
+  IsAtEnd() const
+  {
+    return m_IsAtEnd;
+  }
+
+  /** Moves the iterator to the next pixel of the region. */
+  Self &
+  operator++()
+  {
+    ++m_Center;
+    if (m_Center == m_LineEnd)
+    {
+      this->NextLine();
+    }
+    return *this;
+  }
+
+  /** Returns the index of the center pixel. */
+  IndexType
+  GetIndex() const
+  {
+    IndexType index = m_LineIndex;
+    index[0] += m_Center - m_LineBegin;
+    return index;
+  }
+
+  /** Returns the value of the neighbor with the specified index. */
+  PixelType
+  GetPixel(const unsigned int neighborIndex) const
+  {
+    return m_NeighborhoodAccessor.Get(m_Center + m_BufferOffsets[neighborIndex]);
+  }
+
+  /** Returns the value of the center pixel. */
+  PixelType
+  GetCenterPixel() const
+  {
+    return m_NeighborhoodAccessor.Get(m_Center);
+  }
+
+  /** Returns the offsets of the neighbors in the image buffer, relative to
+   * the center pixel. */
+  const BufferOffsetsType &
+  GetBufferOffsets() const
+  {
+    return m_BufferOffsets;
+  }
+
+  /** Returns the region walked by the iterator. */
+  const RegionType &
+  GetRegion() const
+  {
+    return m_Region;
+  }
+
+private:
+  // Positions the pointers at the start of the line of m_LineIndex.
+  void
+  SetLine()
+  {
+    m_LineBegin = m_BufferPointer + m_Image->ComputeOffset(m_LineIndex);
+    m_Center = m_LineBegin;
+    m_LineEnd = m_LineBegin + m_Region.GetSize(0);
+  }
+
+  // Moves to the start of the next line, or to the end of the region.
+  void
+  NextLine()
+  {
+    for (unsigned int d = 1; d < ImageDimension; ++d)
+    {
+      ++m_LineIndex[d];
+      if (m_LineIndex[d] < m_Region.GetIndex(d) + static_cast<IndexValueType>(m_Region.GetSize(d)))
+      {
+        this->SetLine();
+        return;
+      }
+      m_LineIndex[d] = m_Region.GetIndex(d);
+    }
+    m_Center = m_LineBegin;
+    m_IsAtEnd = true;
+  }
+
+  const ImageType *               m_Image;
+  RegionType                      m_Region;
+  NeighborhoodAccessorFunctorType m_NeighborhoodAccessor;
+  const InternalPixelType *       m_BufferPointer{ nullptr };
+  BufferOffsetsType               m_BufferOffsets;
+  IndexType                       m_LineIndex;
+  const InternalPixelType *       m_LineBegin{ nullptr };
+  const InternalPixelType *       m_LineEnd{ nullptr };
+  const InternalPixelType *       m_Center{ nullptr };
+  bool                            m_IsAtEnd{ true };
+};
+
+// static constexpr definitions explicitly needed in C++11
+template <typename TImage, unsigned int VRadius>
+constexpr unsigned int FixedRadiusConstNeighborhoodIterator<TImage, VRadius>::Radius;
+template <typename TImage, unsigned int VRadius>
+constexpr unsigned int FixedRadiusConstNeighborhoodIterator<TImage, VRadius>::Diameter;
+template <typename TImage, unsigned int VRadius>
+constexpr unsigned int FixedRadiusConstNeighborhoodIterator<TImage, VRadius>::NumberOfNeighbors;
+template <typename TImage, unsigned int VRadius>
+constexpr unsigned int FixedRadiusConstNeighborhoodIterator<TImage, VRadius>::CenterNeighborIndex;
+} // end namespace itk
+
+#endif
@@ -0,0 +1,426 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFloat16_h
+#define itkFloat16_h
+
+#include "itkNumericTraits.h"
+
+#include <cstdint>
+#include <cstring> // For memcpy.
+#include <iostream>
+#include <limits>
+
+#if defined(__F16C__) && defined(__AVX__)
+#  include <immintrin.h>
+#endif
+
+namespace itk
+{
+/** \class Float16
+ * \brief Half precision (IEEE 754 binary16) floating point number.
+ *
+ * Float16 stores a floating point number in 16 bits: 1 sign bit, 5 exponent
+ * bits and 10 mantissa bits. It is a storage type: it halves the memory
+ * footprint of a float image, but it has no arithmetic of its own. A Float16
+ * converts implicitly to float, so that all computations are done in single
+ * precision, and a float converts to the nearest Float16, with ties rounded
+ * to even. Values larger than 65504 in magnitude become infinite.
+ *
+ * ConvertToFloat and ConvertFromFloat convert whole buffers. They use the F16C
+ * instructions when the compiler targets them (for example with -mf16c or
+ * -march=native).
+ *
+ * \ingroup DataRepresentation
+ * \ingroup ITKCommon
+ */
+class Float16
+{
+public:
+  /** The type of the bit representation. */
+  using BitsType = uint16_t;
+
+  /** The value is zero after default construction. */
+  constexpr Float16() = default;
+
+  /** Rounds the float to the nearest Float16. */
+  Float16(const float value)
+    : m_Bits(FloatToBits(value))
+  {}
+
+  /** Returns the Float16 that has the specified bit representation. */
+  static constexpr Float16
+  FromBits(const BitsType bits)
+  {
+    return Float16(bits, BitsTag{});
+  }
+
+  /** Returns the bit representation. */
+  constexpr BitsType
+  GetBits() const
+  {
+    return m_Bits;
+  }
+
+  /** Returns the value as a float. The conversion is exact. */
+  operator float() const { return BitsToFloat(m_Bits); }
+
+  /** Compound assignment operators, computed in single precision. */
+  Float16 &
+  operator+=(const float value)
+  {
+    return *this = Float16(static_cast<float>(*this) + value);
+  }
+  Float16 &
+  operator-=(const float value)
+  {
+    return *this = Float16(static_cast<float>(*this) - value);
+  }
+  Float16 &
+  operator*=(const float value)
+  {
+    return *this = Float16(static_cast<float>(*this) * value);
+  }
+  Float16 &
+  operator/=(const float value)
+  {
+    return *this = Float16(static_cast<float>(*this) / value);
+  }
+
+  /** Converts a buffer of Float16 to float. */
+  static void
+  ConvertToFloat(const Float16 * input, float * output, const size_t numberOfValues)
+  {
+    size_t i = 0;
+#if defined(__F16C__) && defined(__AVX__)
+    for (; i + 8 <= numberOfValues; i += 8)
+    {
+      const __m128i halfs = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + i));
+      _mm256_storeu_ps(output + i, _mm256_cvtph_ps(halfs));
+    }
+#endif
+    for (; i < numberOfValues; ++i)
+    {
+      output[i] = BitsToFloat(input[i].m_Bits);
+    }
+  }
+
+  /** Converts a buffer of float to Float16, rounding to nearest even. */
+  static void
+  ConvertFromFloat(const float * input, Float16 * output, const size_t numberOfValues)
+  {
+    size_t i = 0;
+#if defined(__F16C__) && defined(__AVX__)
+    for (; i + 8 <= numberOfValues; i += 8)
+    {
+      const __m128i halfs = _mm256_cvtps_ph(_mm256_loadu_ps(input + i), _MM_FROUND_TO_NEAREST_INT);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(output + i), halfs);
+    }
+#endif
+    for (; i < numberOfValues; ++i)
+    {
+      output[i].m_Bits = FloatToBits(input[i]);
+    }
+  }
+
+private:
+  struct BitsTag
+  {};
+
+  constexpr Float16(const BitsType bits, BitsTag)
+    : m_Bits(bits)
+  {}
+
+  static float
+  BitsToFloat(const BitsType bits)
+  {
+    // Shifts the exponent and the mantissa into place and rebiases the
+    // exponent. Infinities and NaNs get the maximum float exponent, and
+    // subnormal numbers are normalized by a float subtraction.
+    constexpr uint32_t shiftedExponent = 0x7c00u << 13;
+    uint32_t           result = (bits & 0x7fffu) << 13;
+    const uint32_t     exponent = result & shiftedExponent;
+    result += (127u - 15u) << 23;
+    if (exponent == shiftedExponent)
+    {
+      result += (128u - 16u) << 23;
+    }
+    else if (exponent == 0)
+    {
+      constexpr uint32_t magicBits = 113u << 23;
+      float              magic;
+      std::memcpy(&magic, &magicBits, sizeof(magic));
+      result += 1u << 23;
+      float value;
+      std::memcpy(&value, &result, sizeof(value));
+      value -= magic;
+      std::memcpy(&result, &value, sizeof(value));
+    }
+    result |= static_cast<uint32_t>(bits & 0x8000u) << 16;
+    float value;
+    std::memcpy(&value, &result, sizeof(value));
+    return value;
+  }
+
+  static BitsType
+  FloatToBits(const float value)
+  {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint32_t sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    uint32_t result;
+    if (bits >= ((127u + 16u) << 23))
+    {
+      // Overflow to infinity, or NaN (made quiet).
+      result = (bits > 0x7f800000u) ? 0x7e00u : 0x7c00u;
+    }
+    else if (bits < (113u << 23))
+    {
+      // Subnormal Float16, or zero: a float addition aligns the mantissa and
+      // rounds it to nearest even.
+      constexpr uint32_t denormalMagicBits = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+      float              denormalMagic;
+      std::memcpy(&denormalMagic, &denormalMagicBits, sizeof(denormalMagic));
+      float magnitude;
+      std::memcpy(&magnitude, &bits, sizeof(magnitude));
+      magnitude += denormalMagic;
+      std::memcpy(&result, &magnitude, sizeof(result));
+      result -= denormalMagicBits;
+    }
+    else
+    {
+      // Normal Float16: rebias the exponent and round the mantissa to nearest
+      // even. A carry out of the mantissa correctly increments the exponent.
+      const uint32_t mantissaOdd = (bits >> 13) & 1u;
+      bits += ((15u - 127u) << 23) + 0xfffu + mantissaOdd;
+      result = bits >> 13;
+    }
+    return static_cast<BitsType>(result | (sign >> 16));
+  }
+
+  BitsType m_Bits{ 0 };
+};
+
+inline std::ostream &
+operator<<(std::ostream & os, const Float16 value)
+{
+  return os << static_cast<float>(value);
+}
+
+inline std::istream &
+operator>>(std::istream & is, Float16 & value)
+{
+  float temp;
+  if (is >> temp)
+  {
+    value = Float16(temp);
+  }
+  return is;
+}
+} // end namespace itk
+
+namespace std
+{
+/** std::numeric_limits of itk::Float16, as specified by IEEE 754 binary16. */
+template <>
+class numeric_limits<itk::Float16>
+{
+public:
+  static constexpr bool               is_specialized = true;
+  static constexpr bool               is_signed = true;
+  static constexpr bool               is_integer = false;
+  static constexpr bool               is_exact = false;
+  static constexpr bool               has_infinity = true;
+  static constexpr bool               has_quiet_NaN = true;
+  static constexpr bool               has_signaling_NaN = true;
+  static constexpr float_denorm_style has_denorm = denorm_present;
+  static constexpr bool               has_denorm_loss = false;
+  static constexpr float_round_style  round_style = round_to_nearest;
+  static constexpr bool               is_iec559 = true;
+  static constexpr bool               is_bounded = true;
+  static constexpr bool               is_modulo = false;
+  static constexpr int                digits = 11;
+  static constexpr int                digits10 = 3;
+  static constexpr int                max_digits10 = 5;
+  static constexpr int                radix = 2;
+  static constexpr int                min_exponent = -13;
+  static constexpr int                min_exponent10 = -4;
+  static constexpr int                max_exponent = 16;
+  static constexpr int                max_exponent10 = 4;
+  static constexpr bool               traps = false;
+  static constexpr bool               tinyness_before = false;
+
+  static constexpr itk::Float16
+  min() noexcept
+  {
+    return itk::Float16::FromBits(0x0400);
+  }
+  static constexpr itk::Float16
+  lowest() noexcept
+  {
+    return itk::Float16::FromBits(0xfbff);
+  }
+  static constexpr itk::Float16
+  max() noexcept
+  {
+    return itk::Float16::FromBits(0x7bff);
+  }
+  static constexpr itk::Float16
+  epsilon() noexcept
+  {
+    return itk::Float16::FromBits(0x1400);
+  }
+  static constexpr itk::Float16
+  round_error() noexcept
+  {
+    return itk::Float16::FromBits(0x3800);
+  }
+  static constexpr itk::Float16
+  infinity() noexcept
+  {
+    return itk::Float16::FromBits(0x7c00);
+  }
+  static constexpr itk::Float16
+  quiet_NaN() noexcept
+  {
+    return itk::Float16::FromBits(0x7e00);
+  }
+  static constexpr itk::Float16
+  signaling_NaN() noexcept
+  {
+    return itk::Float16::FromBits(0x7d00);
+  }
+  static constexpr itk::Float16
+  denorm_min() noexcept
+  {
+    return itk::Float16::FromBits(0x0001);
+  }
+};
+} // end namespace std
+
+namespace itk
+{
+/** \class NumericTraits<Float16>
+ * \brief Define traits for type Float16.
+ *
+ * Float16 is a storage type: its accumulate, float and real types are float.
+ *
+ * \ingroup DataRepresentation
+ * \ingroup ITKCommon
+ */
+template <>
+class NumericTraits<Float16> : public std::numeric_limits<Float16>
+{
+public:
+  using ValueType = Float16;
+  using PrintType = float;
+  using AbsType = Float16;
+  using AccumulateType = float;
+  using RealType = float;
+  using ScalarRealType = RealType;
+  using FloatType = float;
+  using MeasurementVectorType = FixedArray<ValueType, 1>;
+
+  static constexpr Float16 ITKCommon_EXPORT Zero = Float16::FromBits(0x0000);
+  static constexpr Float16 ITKCommon_EXPORT One = Float16::FromBits(0x3c00);
+
+  itkNUMERIC_TRAITS_MIN_MAX_MACRO();
+  static constexpr Float16
+  NonpositiveMin()
+  {
+    return std::numeric_limits<ValueType>::lowest();
+  }
+  static bool
+  IsPositive(Float16 val)
+  {
+    return val > 0.0f;
+  }
+  static bool
+  IsNonpositive(Float16 val)
+  {
+    return val <= 0.0f;
+  }
+  static bool
+  IsNegative(Float16 val)
+  {
+    return val < 0.0f;
+  }
+  static bool
+  IsNonnegative(Float16 val)
+  {
+    return val >= 0.0f;
+  }
+  static constexpr bool IsSigned = true;
+  static constexpr bool IsInteger = false;
+  static constexpr bool IsComplex = false;
+  static constexpr Float16
+  ZeroValue()
+  {
+    return Zero;
+  }
+  static constexpr Float16
+  OneValue()
+  {
+    return One;
+  }
+  static constexpr unsigned int
+  GetLength(const ValueType &)
+  {
+    return 1;
+  }
+  static constexpr unsigned int
+  GetLength()
+  {
+    return 1;
+  }
+  static constexpr ValueType
+  NonpositiveMin(const ValueType &)
+  {
+    return NonpositiveMin();
+  }
+  static constexpr ValueType
+  ZeroValue(const ValueType &)
+  {
+    return ZeroValue();
+  }
+  static constexpr ValueType
+  OneValue(const ValueType &)
+  {
+    return OneValue();
+  }
+
+  template <typename TArray>
+  static void
+  AssignToArray(const ValueType & v, TArray & mv)
+  {
+    mv[0] = v;
+  }
+  static void
+  SetLength(ValueType & m, const unsigned int s)
+  {
+    if (s != 1)
+    {
+      itkGenericExceptionMacro(<< "Cannot set the size of a scalar to " << s);
+    }
+    m = NumericTraits<ValueType>::ZeroValue();
+  }
+};
+} // end namespace itk
+
+#endif // itkFloat16_h
@@ -18,6 +18,7 @@
 #ifndef itkImageAlgorithm_h
 #define itkImageAlgorithm_h
 
+#include "itkFloat16.h"
 #include "itkImageRegionIterator.h"
 
 #include <type_traits>
@@ -212,6 +213,22 @@ private:
   {
     return std::transform(first, last, result, StaticCast<TInputType, TOutputType>());
   }
+
+  /** Conversions between Float16 and float, with the buffer conversions of
+   * Float16, which may use vector instructions. */
+  static float *
+  CopyHelper(const Float16 * first, const Float16 * last, float * result)
+  {
+    Float16::ConvertToFloat(first, result, static_cast<size_t>(last - first));
+    return result + (last - first);
+  }
+
+  static Float16 *
+  CopyHelper(const float * first, const float * last, Float16 * result)
+  {
+    Float16::ConvertFromFloat(first, result, static_cast<size_t>(last - first));
+    return result + (last - first);
+  }
   /// \endcond
 };
 } // end namespace itk
@@ -20,6 +20,7 @@
 
 #include "itkImageConstIteratorWithIndex.h"
 #include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkPhiloxRandomVariateGenerator.h"
 
 namespace itk
 {
@@ -74,7 +75,14 @@ namespace itk
     \endcode
  *
  * \warning Incrementing the iterator (++it) followed by a decrement (--it)
- * or vice versa does not in general return the iterator to the same position.
+ * or vice versa does not in general return the iterator to the same position,
+ * unless UseCounterBasedGenerator is on.
+ *
+ * By default, the positions are drawn in sequence from a Mersenne Twister
+ * generator. With UseCounterBasedGenerator on, the position of the n-th sample
+ * is drawn from a counter-based generator, and only depends on the seed and on
+ * n. The samples can then be split into ranges that are processed
+ * independently, e.g. by several threads, and still be reproduced exactly.
  *
  * \par MORE INFORMATION
  * For a complete description of the ITK Image Iterators and their API, please
@@ -158,16 +166,16 @@ public:
   void
   GoToBegin()
   {
-    this->RandomJump();
     m_NumberOfSamplesDone = 0L;
+    this->RandomJump();
   }
 
   /** Move an iterator to one position past the End of the region. */
   void
   GoToEnd()
   {
-    this->RandomJump();
     m_NumberOfSamplesDone = m_NumberOfSamplesRequested;
+    this->RandomJump();
   }
 
   /** Is the iterator at the beginning of the region? */
@@ -189,8 +197,8 @@ public:
   Self &
   operator++()
   {
-    this->RandomJump();
     m_NumberOfSamplesDone++;
+    this->RandomJump();
     return *this;
   }
 
@@ -199,8 +207,8 @@ public:
   Self &
   operator--()
   {
-    this->RandomJump();
     m_NumberOfSamplesDone--;
+    this->RandomJump();
     return *this;
   }
 
@@ -218,6 +226,20 @@ public:
   void
   ReinitializeSeed(int);
 
+  /** Set/Get whether the position of each sample is drawn from a counter-based
+   * generator, keyed by the seed and the sample number. Off by default. */
+  void
+  SetUseCounterBasedGenerator(bool useCounterBasedGenerator)
+  {
+    m_UseCounterBasedGenerator = useCounterBasedGenerator;
+  }
+
+  bool
+  GetUseCounterBasedGenerator() const
+  {
+    return m_UseCounterBasedGenerator;
+  }
+
 private:
   void
   RandomJump();
@@ -227,6 +249,8 @@ private:
   SizeValueType    m_NumberOfSamplesRequested;
   SizeValueType    m_NumberOfSamplesDone;
   SizeValueType    m_NumberOfPixelsInRegion;
+  uint32_t         m_CounterBasedSeed{ 0 };
+  bool             m_UseCounterBasedGenerator{ false };
 };
 } // end namespace itk
 
@@ -68,6 +68,7 @@ void
 ImageRandomConstIteratorWithIndex<TImage>::ReinitializeSeed()
 {
   m_Generator->SetSeed();
+  m_CounterBasedSeed = m_Generator->GetIntegerVariate();
 }
 
 template <typename TImage>
@@ -75,6 +76,7 @@ void
 ImageRandomConstIteratorWithIndex<TImage>::ReinitializeSeed(int seed)
 {
   m_Generator->SetSeed(seed);
+  m_CounterBasedSeed = static_cast<uint32_t>(seed);
   // vnl_sample_reseed(seed);
 }
 
@@ -85,8 +87,12 @@ ImageRandomConstIteratorWithIndex<TImage>::RandomJump()
 {
   using PositionValueType = IndexValueType;
 
+  const double            positionRange = static_cast<double>(m_NumberOfPixelsInRegion) - 0.5;
   const PositionValueType randomPosition = static_cast<PositionValueType>(
-    m_Generator->GetVariateWithOpenRange(static_cast<double>(m_NumberOfPixelsInRegion) - 0.5));
+    m_UseCounterBasedGenerator
+      ? positionRange * Statistics::PhiloxRandomVariateGenerator(m_CounterBasedSeed, m_NumberOfSamplesDone)
+                          .GetVariateWithOpenRange()
+      : m_Generator->GetVariateWithOpenRange(positionRange));
   /*
       vnl_sample_uniform(0.0f,
       static_cast<double>(m_NumberOfPixelsInRegion)-0.5) );
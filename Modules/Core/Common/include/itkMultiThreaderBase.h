@@ -35,8 +35,16 @@
 #include "itkImageRegion.h"
 #include "itkImageIORegion.h"
 #include "itkSingletonMacro.h"
+#include "itkBufferedImageNeighborhoodPixelAccessPolicy.h"
+#include "itkDefaultPixelAccessor.h"
+#include "itkImageNeighborhoodOffsets.h"
+#include "itkIndexRange.h"
+#include "itkShapedImageNeighborhoodRange.h"
+#include <algorithm>
 #include <functional>
 #include <thread>
+#include <type_traits>
+#include <vector>
 #include "itkProgressReporter.h"
 
 
@@ -409,6 +417,220 @@ ITK_GCC_PRAGMA_DIAG_POP()
     }
   }
 
+  /** Break up the requested region of an image into smaller chunks, and
+   * process the neighborhoods of their pixels in parallel. Each chunk is
+   * split by ProcessNeighborhoodFaces() into its interior, where the
+   * neighborhood of every pixel lies inside the buffered region of the image,
+   * and its boundary faces, so that the interior is processed without any
+   * bounds checking.
+   *
+   * The functor must have a call operator templated over the type of the
+   * ShapedImageNeighborhoodRange it receives, which differs between the
+   * interior and the faces:
+   *
+   * \code
+   * struct Kernel
+   * {
+   *   template <typename TNeighborhoodRange>
+   *   void
+   *   operator()(const ImageRegion<3> & subregion, TNeighborhoodRange & neighborhoodRange) const;
+   * };
+   * \endcode
+   *
+   * The call operator is called concurrently, once per subregion, with a
+   * range located at the first pixel of the subregion; it typically moves the
+   * range over the subregion with SetLocation(). The neighborhood is the
+   * rectangular neighborhood of the specified radius. If filter argument is
+   * not nullptr, this function will update its progress as each work unit is
+   * completed. */
+  template <template <typename> class TBoundaryPixelAccessPolicy = ZeroFluxNeumannImageNeighborhoodPixelAccessPolicy,
+            typename TImage,
+            typename TFunctor>
+  ITK_TEMPLATE_EXPORT void
+  ParallelizeNeighborhood(TImage &                                    image,
+                          const ImageRegion<TImage::ImageDimension> & requestedRegion,
+                          const Size<TImage::ImageDimension> &        radius,
+                          const TFunctor &                            functor,
+                          ProcessObject *                             filter)
+  {
+    const std::vector<Offset<TImage::ImageDimension>> neighborhoodOffsets =
+      GenerateRectangularImageNeighborhoodOffsets(radius);
+    this->ParallelizeNeighborhood<TBoundaryPixelAccessPolicy>(
+      image, requestedRegion, neighborhoodOffsets, functor, filter);
+  }
+
+  /** Similar to ParallelizeNeighborhood, with a neighborhood of arbitrary
+   * shape, specified by the offsets of its pixels. */
+  template <template <typename> class TBoundaryPixelAccessPolicy = ZeroFluxNeumannImageNeighborhoodPixelAccessPolicy,
+            typename TImage,
+            typename TFunctor>
+  ITK_TEMPLATE_EXPORT void
+  ParallelizeNeighborhood(TImage &                                            image,
+                          const ImageRegion<TImage::ImageDimension> &         requestedRegion,
+                          const std::vector<Offset<TImage::ImageDimension>> & neighborhoodOffsets,
+                          const TFunctor &                                    functor,
+                          ProcessObject *                                     filter)
+  {
+    constexpr unsigned int Dimension = TImage::ImageDimension;
+    this->ParallelizeImageRegion<Dimension>(
+      requestedRegion,
+      [&image, &neighborhoodOffsets, &functor](const ImageRegion<Dimension> & region) {
+        ProcessNeighborhoodFaces<TBoundaryPixelAccessPolicy>(image, region, neighborhoodOffsets, functor);
+      },
+      filter);
+  }
+
+  /** Split a region of an image into its interior, where the neighborhood of
+   * every pixel lies inside the buffered region of the image, and its
+   * boundary faces, and call the functor for each of them in the calling
+   * thread, as done by ParallelizeNeighborhood for each chunk. The range
+   * passed to the functor uses the BufferedImageNeighborhoodPixelAccessPolicy
+   * in the interior, and TBoundaryPixelAccessPolicy on the faces. Meant to be
+   * called by the threaded methods of the filters which are already split
+   * into chunks by their superclass. */
+  template <template <typename> class TBoundaryPixelAccessPolicy = ZeroFluxNeumannImageNeighborhoodPixelAccessPolicy,
+            typename TImage,
+            typename TFunctor>
+  static void
+  ProcessNeighborhoodFaces(TImage &                                            image,
+                           const ImageRegion<TImage::ImageDimension> &         region,
+                           const std::vector<Offset<TImage::ImageDimension>> & neighborhoodOffsets,
+                           const TFunctor &                                    functor)
+  {
+    constexpr unsigned int Dimension = TImage::ImageDimension;
+    using RegionType = ImageRegion<Dimension>;
+    using PolicyImageType = typename std::remove_const<TImage>::type;
+    using InteriorRangeType =
+      ShapedImageNeighborhoodRange<TImage, BufferedImageNeighborhoodPixelAccessPolicy<PolicyImageType>>;
+    using BoundaryRangeType = ShapedImageNeighborhoodRange<TImage, TBoundaryPixelAccessPolicy<PolicyImageType>>;
+
+    const RegionType & bufferedRegion = image.GetBufferedRegion();
+
+    // The interior shrinks as the faces are peeled off, one dimension at a
+    // time, so that the faces do not overlap.
+    RegionType interior = region;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      OffsetValueType lowerRadius = 0;
+      OffsetValueType upperRadius = 0;
+      for (const auto & offset : neighborhoodOffsets)
+      {
+        lowerRadius = std::max(lowerRadius, -offset[d]);
+        upperRadius = std::max(upperRadius, offset[d]);
+      }
+
+      const IndexValueType begin = interior.GetIndex(d);
+      const IndexValueType end = begin + static_cast<IndexValueType>(interior.GetSize(d));
+      const IndexValueType bufferedBegin = bufferedRegion.GetIndex(d);
+      const IndexValueType bufferedEnd = bufferedBegin + static_cast<IndexValueType>(bufferedRegion.GetSize(d));
+      const IndexValueType interiorBegin = std::min(end, std::max(begin, bufferedBegin + lowerRadius));
+      const IndexValueType interiorEnd = std::max(interiorBegin, std::min(end, bufferedEnd - upperRadius));
+
+      RegionType lowerFace = interior;
+      lowerFace.SetSize(d, static_cast<SizeValueType>(interiorBegin - begin));
+      RegionType upperFace = interior;
+      upperFace.SetIndex(d, interiorEnd);
+      upperFace.SetSize(d, static_cast<SizeValueType>(end - interiorEnd));
+      for (const RegionType & face : { lowerFace, upperFace })
+      {
+        if (face.GetNumberOfPixels() > 0)
+        {
+          BoundaryRangeType neighborhoodRange(image, face.GetIndex(), neighborhoodOffsets);
+          functor(face, neighborhoodRange);
+        }
+      }
+
+      interior.SetIndex(d, interiorBegin);
+      interior.SetSize(d, static_cast<SizeValueType>(interiorEnd - interiorBegin));
+    }
+
+    if (interior.GetNumberOfPixels() > 0)
+    {
+      InteriorRangeType neighborhoodRange(image, interior.GetIndex(), neighborhoodOffsets);
+      functor(interior, neighborhoodRange);
+    }
+  }
+
+  /** Break up the requested region into smaller chunks, and call the functor
+   * for each scanline of the chunks, with raw pointers to the first pixel of
+   * the scanline in each of the specified images:
+   *
+   * \code
+   * multiThreader->ParallelizeImageScanlines(
+   *   region,
+   *   [](SizeValueType numberOfPixels, float * output, const float * input) {
+   *     for (SizeValueType i = 0; i < numberOfPixels; ++i)
+   *     {
+   *       output[i] = 2.0f * input[i];
+   *     }
+   *   },
+   *   filter,
+   *   *outputImage,
+   *   *inputImage);
+   * \endcode
+   *
+   * The pixels of a scanline are contiguous in memory, so that the inner loop
+   * of the functor can be vectorized by the compiler. The pointers are the
+   * ones of the buffers of the images, of type InternalPixelType: the images
+   * must store their pixels without pixel accessor, like Image and
+   * VectorImage, not like ImageAdaptor. For a VectorImage, the pointer is the
+   * one of the first component of the first pixel, and the scanline holds
+   * numberOfPixels * GetNumberOfComponentsPerPixel() contiguous components.
+   * The pointers of const images are const pointers. Every image must buffer
+   * the requested region. */
+  template <typename TFunctor, typename TImage, typename... TImages>
+  void
+  ParallelizeImageScanlines(const ImageRegion<TImage::ImageDimension> & requestedRegion,
+                            const TFunctor &                            functor,
+                            ProcessObject *                             filter,
+                            TImage &                                    image,
+                            TImages &... images)
+  {
+    constexpr unsigned int Dimension = TImage::ImageDimension;
+    this->ParallelizeImageRegion<Dimension>(
+      requestedRegion,
+      [&](const ImageRegion<Dimension> & region) { ProcessImageScanlines(region, functor, image, images...); },
+      filter);
+  }
+
+  /** Call the functor for each scanline of the region, in the calling
+   * thread, as done by ParallelizeImageScanlines for each chunk. Meant to be
+   * called by the threaded methods of the filters which are already split
+   * into chunks by their superclass. */
+  template <typename TFunctor, typename TImage, typename... TImages>
+  static void
+  ProcessImageScanlines(const ImageRegion<TImage::ImageDimension> & region,
+                        const TFunctor &                            functor,
+                        TImage &                                    image,
+                        TImages &... images)
+  {
+    constexpr unsigned int Dimension = TImage::ImageDimension;
+    if (region.GetNumberOfPixels() == 0)
+    {
+      return;
+    }
+
+    const SizeValueType    numberOfPixels = region.GetSize(0);
+    ImageRegion<Dimension> lineStarts = region;
+    lineStarts.SetSize(0, 1);
+    for (const Index<Dimension> & lineStart : ImageRegionIndexRange<Dimension>(lineStarts))
+    {
+      functor(numberOfPixels, GetScanlinePointer(image, lineStart), GetScanlinePointer(images, lineStart)...);
+    }
+  }
+
+  /** Tells whether the pointers passed by ParallelizeImageScanlines point to
+   * values of the pixel type of the image, which is the case for Image, but
+   * not for VectorImage and image adaptors. */
+  template <typename TImage>
+  static constexpr bool
+  HasPixelScanlines()
+  {
+    using ImageType = typename std::remove_const<TImage>::type;
+    return std::is_same<typename ImageType::PixelType, typename ImageType::InternalPixelType>::value &&
+           std::is_same<typename ImageType::AccessorType, DefaultPixelAccessor<typename ImageType::PixelType>>::value;
+  }
+
   /** Break up region into smaller chunks, and call the function with chunks as parameters.
    *  This overload does the actual work and should be implemented by derived classes. */
   virtual void
@@ -424,6 +646,21 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Returns the pointer to the first component of the pixel at the specified
+   * index in the buffer of the image. */
+  template <typename TImage>
+  static auto
+  GetScanlinePointer(TImage & image, const Index<TImage::ImageDimension> & index) -> decltype(image.GetBufferPointer())
+  {
+    using ImageType = typename std::remove_const<TImage>::type;
+    const OffsetValueType offset = image.ComputeOffset(index);
+    if (std::is_same<typename ImageType::PixelType, typename ImageType::InternalPixelType>::value)
+    {
+      return image.GetBufferPointer() + offset;
+    }
+    return image.GetBufferPointer() + offset * static_cast<OffsetValueType>(image.GetNumberOfComponentsPerPixel());
+  }
+
   struct ArrayCallback
   {
     ArrayThreadingFunctorType functor;
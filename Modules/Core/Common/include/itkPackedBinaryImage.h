@@ -0,0 +1,244 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPackedBinaryImage_h
+#define itkPackedBinaryImage_h
+
+#include "itkImageBase.h"
+#include "itkImportImageContainer.h"
+
+#include <cstdint>
+
+namespace itk
+{
+/** \class PackedBinaryImage
+ *  \brief N-dimensional binary image storing one bit per pixel.
+ *
+ * PackedBinaryImage has the same geometry as an Image (it derives from
+ * ImageBase), but its pixels are booleans packed into 64 bit words, which
+ * divides the memory footprint and the memory bandwidth of binary masks by
+ * eight, compared to an Image<unsigned char>.
+ *
+ * The buffer is organized in rows along the first dimension: every row of
+ * the buffered region starts on a new word, and occupies GetWordsPerRow()
+ * words. The pixel with index[0] == start[0] + i is stored in bit (i % 64) of
+ * word (i / 64) of its row. Rows are stored in the same order as the pixels
+ * of an Image, i.e., the second dimension varies the fastest. The bits past
+ * the end of a row (padding bits) are always zero, so that whole words can be
+ * processed without masking.
+ *
+ * Because a pixel is not addressable, PackedBinaryImage can not be used with
+ * the image iterators. Pixels are accessed with GetPixel()/SetPixel(), and
+ * whole rows with GetRowBuffer(). PackedBinaryImageAlgorithm provides the
+ * conversions from and to an Image, as well as word-parallel logical
+ * operations, row morphology, foreground counting and connected component
+ * labeling.
+ *
+ * \sa PackedBinaryImageAlgorithm
+ *
+ * \ingroup ImageObjects
+ * \ingroup ITKCommon
+ */
+template <unsigned int VImageDimension = 2>
+class ITK_TEMPLATE_EXPORT PackedBinaryImage : public ImageBase<VImageDimension>
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(PackedBinaryImage);
+
+  /** Standard class type aliases */
+  using Self = PackedBinaryImage;
+  using Superclass = ImageBase<VImageDimension>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(PackedBinaryImage, ImageBase);
+
+  /** Dimension of the image. */
+  static constexpr unsigned int ImageDimension = VImageDimension;
+
+  /** Types inherited from the superclass */
+  using IndexType = typename Superclass::IndexType;
+  using IndexValueType = typename Superclass::IndexValueType;
+  using OffsetType = typename Superclass::OffsetType;
+  using SizeType = typename Superclass::SizeType;
+  using SizeValueType = typename Superclass::SizeValueType;
+  using RegionType = typename Superclass::RegionType;
+  using SpacingType = typename Superclass::SpacingType;
+  using PointType = typename Superclass::PointType;
+  using DirectionType = typename Superclass::DirectionType;
+
+  /** Pixel type alias support. */
+  using PixelType = bool;
+  using ValueType = bool;
+
+  /** Type of the words in which the pixels are packed. */
+  using WordType = std::uint64_t;
+
+  /** Number of pixels packed in a word. */
+  static constexpr unsigned int BitsPerWord = 64;
+
+  /** Container used to store the words of the image. */
+  using WordContainer = ImportImageContainer<SizeValueType, WordType>;
+  using WordContainerPointer = typename WordContainer::Pointer;
+  using WordContainerConstPointer = typename WordContainer::ConstPointer;
+
+  /** Allocate the image memory. The size of the image must already be set,
+   * e.g. by calling SetRegions(). If initializePixels is true, all the pixels
+   * are set to false. */
+  void
+  Allocate(bool initializePixels = false) override;
+
+  /** Restore the data object to its initial state. This means releasing
+   * memory. */
+  void
+  Initialize() override;
+
+  /** Set all the pixels of the buffered region to the specified value. */
+  void
+  FillBuffer(bool value);
+
+  /** Get the value of the pixel at the specified index. No bounds checking
+   * is performed. */
+  bool
+  GetPixel(const IndexType & index) const
+  {
+    const SizeValueType bit = static_cast<SizeValueType>(index[0] - this->GetBufferedRegion().GetIndex(0));
+    return (this->GetRowBuffer(this->ComputeRow(index))[bit / BitsPerWord] >> (bit % BitsPerWord)) & 1u;
+  }
+
+  /** Set the value of the pixel at the specified index. No bounds checking
+   * is performed. */
+  void
+  SetPixel(const IndexType & index, bool value)
+  {
+    const SizeValueType bit = static_cast<SizeValueType>(index[0] - this->GetBufferedRegion().GetIndex(0));
+    WordType &          word = this->GetRowBuffer(this->ComputeRow(index))[bit / BitsPerWord];
+    const WordType      mask = WordType{ 1 } << (bit % BitsPerWord);
+    word = value ? (word | mask) : (word & ~mask);
+  }
+
+  /** Number of pixels of a row, i.e., the size of the buffered region along
+   * the first dimension. */
+  SizeValueType
+  GetRowLength() const
+  {
+    return this->GetBufferedRegion().GetSize(0);
+  }
+
+  /** Number of words used to store a row, padding bits included. */
+  SizeValueType
+  GetWordsPerRow() const
+  {
+    return (this->GetRowLength() + BitsPerWord - 1) / BitsPerWord;
+  }
+
+  /** Number of rows of the buffered region. */
+  SizeValueType
+  GetNumberOfRows() const;
+
+  /** Mask of the valid bits of the last word of a row. */
+  WordType
+  GetLastWordMask() const
+  {
+    const SizeValueType remainder = this->GetRowLength() % BitsPerWord;
+    return remainder == 0 ? ~WordType{ 0 } : ((WordType{ 1 } << remainder) - 1);
+  }
+
+  /** Compute the number of the row containing the specified index. */
+  SizeValueType
+  ComputeRow(const IndexType & index) const;
+
+  /** Compute the index of the first pixel of the specified row. */
+  IndexType
+  ComputeRowStartIndex(SizeValueType row) const;
+
+  /** Return a pointer to the first word of the specified row. */
+  WordType *
+  GetRowBuffer(SizeValueType row)
+  {
+    return m_Buffer->GetBufferPointer() + row * this->GetWordsPerRow();
+  }
+  const WordType *
+  GetRowBuffer(SizeValueType row) const
+  {
+    return m_Buffer->GetBufferPointer() + row * this->GetWordsPerRow();
+  }
+
+  /** Return a pointer to the beginning of the word buffer. */
+  WordType *
+  GetBufferPointer()
+  {
+    return m_Buffer ? m_Buffer->GetBufferPointer() : nullptr;
+  }
+  const WordType *
+  GetBufferPointer() const
+  {
+    return m_Buffer ? m_Buffer->GetBufferPointer() : nullptr;
+  }
+
+  /** Return a pointer to the container of the words. */
+  WordContainer *
+  GetWordContainer()
+  {
+    return m_Buffer.GetPointer();
+  }
+  const WordContainer *
+  GetWordContainer() const
+  {
+    return m_Buffer.GetPointer();
+  }
+
+  /** Set the container used to store the words. The container must hold
+   * GetNumberOfRows() * GetWordsPerRow() words. */
+  void
+  SetWordContainer(WordContainer * container);
+
+  /** Graft the data and information from one image to another. */
+  virtual void
+  Graft(const Self * image);
+
+  unsigned int
+  GetNumberOfComponentsPerPixel() const override
+  {
+    return 1;
+  }
+
+protected:
+  PackedBinaryImage();
+  ~PackedBinaryImage() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  Graft(const DataObject * data) override;
+  using Superclass::Graft;
+
+private:
+  WordContainerPointer m_Buffer;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkPackedBinaryImage.hxx"
+#endif
+
+#endif
@@ -0,0 +1,196 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPackedBinaryImage_hxx
+#define itkPackedBinaryImage_hxx
+
+#include "itkPackedBinaryImage.h"
+
+#include <algorithm>
+
+namespace itk
+{
+
+template <unsigned int VImageDimension>
+PackedBinaryImage<VImageDimension>::PackedBinaryImage()
+{
+  m_Buffer = WordContainer::New();
+}
+
+
+template <unsigned int VImageDimension>
+void
+PackedBinaryImage<VImageDimension>::Allocate(bool itkNotUsed(initializePixels))
+{
+  this->ComputeOffsetTable();
+
+  // The padding bits must be zero, so the words are always initialized,
+  // including when an existing container is reused.
+  const SizeValueType numberOfWords = this->GetNumberOfRows() * this->GetWordsPerRow();
+  m_Buffer->Reserve(numberOfWords, false);
+  std::fill_n(m_Buffer->GetBufferPointer(), numberOfWords, WordType{ 0 });
+}
+
+
+template <unsigned int VImageDimension>
+void
+PackedBinaryImage<VImageDimension>::Initialize()
+{
+  //
+  // We don't modify ourselves because the "ReleaseData" methods depend upon
+  // no modification when initialized.
+  //
+
+  // Call the superclass which should initialize the BufferedRegion ivar.
+  Superclass::Initialize();
+
+  // Replace the handle to the buffer. This is the safest thing to do,
+  // since the same container can be shared by multiple images (e.g.
+  // Grafted outputs and in place filters).
+  m_Buffer = WordContainer::New();
+}
+
+
+template <unsigned int VImageDimension>
+void
+PackedBinaryImage<VImageDimension>::FillBuffer(bool value)
+{
+  const SizeValueType numberOfRows = this->GetNumberOfRows();
+  const SizeValueType wordsPerRow = this->GetWordsPerRow();
+  if (wordsPerRow == 0)
+  {
+    return;
+  }
+  const WordType fill = value ? ~WordType{ 0 } : WordType{ 0 };
+  const WordType lastWordMask = this->GetLastWordMask();
+  for (SizeValueType row = 0; row < numberOfRows; ++row)
+  {
+    WordType * const words = this->GetRowBuffer(row);
+    std::fill_n(words, wordsPerRow, fill);
+    words[wordsPerRow - 1] &= lastWordMask;
+  }
+}
+
+
+template <unsigned int VImageDimension>
+auto
+PackedBinaryImage<VImageDimension>::GetNumberOfRows() const -> SizeValueType
+{
+  SizeValueType numberOfRows = 1;
+  for (unsigned int d = 1; d < VImageDimension; ++d)
+  {
+    numberOfRows *= this->GetBufferedRegion().GetSize(d);
+  }
+  return this->GetRowLength() == 0 ? 0 : numberOfRows;
+}
+
+
+template <unsigned int VImageDimension>
+auto
+PackedBinaryImage<VImageDimension>::ComputeRow(const IndexType & index) const -> SizeValueType
+{
+  const RegionType & region = this->GetBufferedRegion();
+
+  SizeValueType row = 0;
+  for (unsigned int d = VImageDimension - 1; d > 0; --d)
+  {
+    row = row * region.GetSize(d) + static_cast<SizeValueType>(index[d] - region.GetIndex(d));
+  }
+  return row;
+}
+
+
+template <unsigned int VImageDimension>
+auto
+PackedBinaryImage<VImageDimension>::ComputeRowStartIndex(SizeValueType row) const -> IndexType
+{
+  const RegionType & region = this->GetBufferedRegion();
+
+  IndexType index = region.GetIndex();
+  for (unsigned int d = 1; d < VImageDimension; ++d)
+  {
+    index[d] += static_cast<IndexValueType>(row % region.GetSize(d));
+    row /= region.GetSize(d);
+  }
+  return index;
+}
+
+
+template <unsigned int VImageDimension>
+void
+PackedBinaryImage<VImageDimension>::SetWordContainer(WordContainer * container)
+{
+  if (m_Buffer != container)
+  {
+    m_Buffer = container;
+    this->Modified();
+  }
+}
+
+
+template <unsigned int VImageDimension>
+void
+PackedBinaryImage<VImageDimension>::Graft(const Self * image)
+{
+  // call the superclass' implementation
+  Superclass::Graft(image);
+
+  if (image)
+  {
+    // Now copy anything remaining that is needed
+    this->SetWordContainer(const_cast<WordContainer *>(image->GetWordContainer()));
+  }
+}
+
+
+template <unsigned int VImageDimension>
+void
+PackedBinaryImage<VImageDimension>::Graft(const DataObject * data)
+{
+  if (data)
+  {
+    // Attempt to cast data to a PackedBinaryImage
+    const auto * const imgData = dynamic_cast<const Self *>(data);
+
+    if (imgData != nullptr)
+    {
+      this->Graft(imgData);
+    }
+    else
+    {
+      // pointer could not be cast back down
+      itkExceptionMacro(<< "itk::PackedBinaryImage::Graft() cannot cast " << typeid(data).name() << " to "
+                        << typeid(const Self *).name());
+    }
+  }
+}
+
+
+template <unsigned int VImageDimension>
+void
+PackedBinaryImage<VImageDimension>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "WordsPerRow: " << this->GetWordsPerRow() << std::endl;
+  os << indent << "WordContainer: " << std::endl;
+  m_Buffer->Print(os, indent.GetNextIndent());
+}
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,697 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPackedBinaryImageAlgorithm_h
+#define itkPackedBinaryImageAlgorithm_h
+
+#include "itkPackedBinaryImage.h"
+#include "itkMultiThreaderBase.h"
+#include "itkNumericTraits.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace itk
+{
+
+/** \class PackedBinaryImageAlgorithm
+ * \brief A container of static functions operating on PackedBinaryImage.
+ *
+ * All the functions process whole 64 bit words at once. They are
+ * multithreaded over the rows of the images with the multithreader given as
+ * their last argument, typically the one of the calling filter
+ * (ProcessObject::GetMultiThreader()), and run in the calling thread when it
+ * is omitted:
+ *
+ *   - ConvertFromImage() and ConvertToImage() convert between an Image and a
+ *     PackedBinaryImage, so that the packed images can be used with the
+ *     existing filters.
+ *   - And(), Or(), Xor(), AndNot() and Not() compute pixel-wise logical
+ *     operations. The output may be one of the inputs.
+ *   - CountForeground() counts the foreground pixels (popcount).
+ *   - DilateRows() and ErodeRows() compute the dilation and the erosion by a
+ *     line segment along the first dimension, which are the building blocks
+ *     of the box structuring elements. The pixels outside of the image are
+ *     considered as background by the dilation, and as foreground by the
+ *     erosion.
+ *   - LabelConnectedComponents() labels the connected components from the
+ *     runs of foreground pixels of the rows, without visiting the pixels
+ *     individually.
+ *
+ * \sa PackedBinaryImage
+ *
+ * \ingroup ITKCommon
+ */
+struct PackedBinaryImageAlgorithm
+{
+  using WordType = std::uint64_t;
+
+  static constexpr unsigned int BitsPerWord = 64;
+
+  /** Number of bits set in the word. */
+  static unsigned int
+  PopCount(WordType word)
+  {
+#if defined(__GNUC__)
+    return static_cast<unsigned int>(__builtin_popcountll(word));
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ull);
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return static_cast<unsigned int>((word * 0x0101010101010101ull) >> 56);
+#endif
+  }
+
+  /** Number of trailing zero bits of the word, which must not be zero. */
+  static unsigned int
+  CountTrailingZeros(WordType word)
+  {
+#if defined(__GNUC__)
+    return static_cast<unsigned int>(__builtin_ctzll(word));
+#else
+    return PopCount((word & (~word + 1)) - 1);
+#endif
+  }
+
+  /** Converts an Image into a PackedBinaryImage having the same buffered
+   * region and the same geometry. The pixels equal to foregroundValue are set,
+   * the other ones are cleared. */
+  template <typename TImage>
+  static void
+  ConvertFromImage(const TImage *                              image,
+                   const typename TImage::PixelType &          foregroundValue,
+                   PackedBinaryImage<TImage::ImageDimension> * output,
+                   MultiThreaderBase *                         multiThreader = nullptr)
+  {
+    using PixelType = typename TImage::PixelType;
+
+    output->CopyInformation(image);
+    output->SetRequestedRegion(image->GetBufferedRegion());
+    output->SetBufferedRegion(image->GetBufferedRegion());
+    output->Allocate();
+
+    const SizeValueType     rowLength = output->GetRowLength();
+    const SizeValueType     wordsPerRow = output->GetWordsPerRow();
+    const PixelType * const buffer = image->GetBufferPointer();
+
+    ParallelizeRows(multiThreader, output->GetNumberOfRows(), [&](SizeValueType beginRow, SizeValueType endRow) {
+      for (SizeValueType row = beginRow; row < endRow; ++row)
+      {
+        const PixelType * pixel = buffer + row * rowLength;
+        WordType * const  words = output->GetRowBuffer(row);
+        for (SizeValueType w = 0; w < wordsPerRow; ++w)
+        {
+          const unsigned int numberOfBits =
+            static_cast<unsigned int>(std::min<SizeValueType>(BitsPerWord, rowLength - w * BitsPerWord));
+          WordType word = 0;
+          for (unsigned int b = 0; b < numberOfBits; ++b, ++pixel)
+          {
+            word |= static_cast<WordType>(*pixel == foregroundValue) << b;
+          }
+          words[w] = word;
+        }
+      }
+    });
+  }
+
+  /** Converts a PackedBinaryImage into an Image having the same buffered
+   * region and the same geometry. */
+  template <typename TImage>
+  static void
+  ConvertToImage(const PackedBinaryImage<TImage::ImageDimension> * packedImage,
+                 TImage *                                          output,
+                 const typename TImage::PixelType &                foregroundValue,
+                 const typename TImage::PixelType &                backgroundValue,
+                 MultiThreaderBase *                               multiThreader = nullptr)
+  {
+    using PixelType = typename TImage::PixelType;
+
+    output->CopyInformation(packedImage);
+    output->SetRequestedRegion(packedImage->GetBufferedRegion());
+    output->SetBufferedRegion(packedImage->GetBufferedRegion());
+    output->Allocate();
+
+    const SizeValueType rowLength = packedImage->GetRowLength();
+    const SizeValueType wordsPerRow = packedImage->GetWordsPerRow();
+    PixelType * const   buffer = output->GetBufferPointer();
+
+    ParallelizeRows(multiThreader, packedImage->GetNumberOfRows(), [&](SizeValueType beginRow, SizeValueType endRow) {
+      for (SizeValueType row = beginRow; row < endRow; ++row)
+      {
+        PixelType *            pixel = buffer + row * rowLength;
+        const WordType * const words = packedImage->GetRowBuffer(row);
+        for (SizeValueType w = 0; w < wordsPerRow; ++w)
+        {
+          const unsigned int numberOfBits =
+            static_cast<unsigned int>(std::min<SizeValueType>(BitsPerWord, rowLength - w * BitsPerWord));
+          const WordType word = words[w];
+          if (word == 0)
+          {
+            pixel = std::fill_n(pixel, numberOfBits, backgroundValue);
+            continue;
+          }
+          for (unsigned int b = 0; b < numberOfBits; ++b, ++pixel)
+          {
+            *pixel = ((word >> b) & 1u) ? foregroundValue : backgroundValue;
+          }
+        }
+      }
+    });
+  }
+
+  /** output = input1 AND input2 */
+  template <unsigned int VDimension>
+  static void
+  And(const PackedBinaryImage<VDimension> * input1,
+      const PackedBinaryImage<VDimension> * input2,
+      PackedBinaryImage<VDimension> *       output,
+      MultiThreaderBase *                   multiThreader = nullptr)
+  {
+    ApplyWordOperation(input1, input2, output, [](WordType a, WordType b) { return a & b; }, multiThreader);
+  }
+
+  /** output = input1 OR input2 */
+  template <unsigned int VDimension>
+  static void
+  Or(const PackedBinaryImage<VDimension> * input1,
+     const PackedBinaryImage<VDimension> * input2,
+     PackedBinaryImage<VDimension> *       output,
+     MultiThreaderBase *                   multiThreader = nullptr)
+  {
+    ApplyWordOperation(input1, input2, output, [](WordType a, WordType b) { return a | b; }, multiThreader);
+  }
+
+  /** output = input1 XOR input2 */
+  template <unsigned int VDimension>
+  static void
+  Xor(const PackedBinaryImage<VDimension> * input1,
+      const PackedBinaryImage<VDimension> * input2,
+      PackedBinaryImage<VDimension> *       output,
+      MultiThreaderBase *                   multiThreader = nullptr)
+  {
+    ApplyWordOperation(input1, input2, output, [](WordType a, WordType b) { return a ^ b; }, multiThreader);
+  }
+
+  /** output = input1 AND NOT input2, i.e., input1 masked by input2. */
+  template <unsigned int VDimension>
+  static void
+  AndNot(const PackedBinaryImage<VDimension> * input1,
+         const PackedBinaryImage<VDimension> * input2,
+         PackedBinaryImage<VDimension> *       output,
+         MultiThreaderBase *                   multiThreader = nullptr)
+  {
+    ApplyWordOperation(input1, input2, output, [](WordType a, WordType b) { return a & ~b; }, multiThreader);
+  }
+
+  /** output = NOT input */
+  template <unsigned int VDimension>
+  static void
+  Not(const PackedBinaryImage<VDimension> * input,
+      PackedBinaryImage<VDimension> *       output,
+      MultiThreaderBase *                   multiThreader = nullptr)
+  {
+    InitializeOutput(input, output);
+
+    const SizeValueType wordsPerRow = input->GetWordsPerRow();
+    const WordType      lastWordMask = input->GetLastWordMask();
+    ParallelizeRows(multiThreader, input->GetNumberOfRows(), [&](SizeValueType beginRow, SizeValueType endRow) {
+      for (SizeValueType row = beginRow; row < endRow; ++row)
+      {
+        const WordType * const in = input->GetRowBuffer(row);
+        WordType * const       out = output->GetRowBuffer(row);
+        for (SizeValueType w = 0; w < wordsPerRow; ++w)
+        {
+          out[w] = ~in[w];
+        }
+        out[wordsPerRow - 1] &= lastWordMask;
+      }
+    });
+  }
+
+  /** Returns the number of foreground pixels of the buffered region. */
+  template <unsigned int VDimension>
+  static SizeValueType
+  CountForeground(const PackedBinaryImage<VDimension> * input, MultiThreaderBase * multiThreader = nullptr)
+  {
+    const SizeValueType numberOfRows = input->GetNumberOfRows();
+    const SizeValueType wordsPerRow = input->GetWordsPerRow();
+
+    std::vector<SizeValueType> counts(numberOfRows, 0);
+    ParallelizeRows(multiThreader, numberOfRows, [&](SizeValueType beginRow, SizeValueType endRow) {
+      for (SizeValueType row = beginRow; row < endRow; ++row)
+      {
+        const WordType * const words = input->GetRowBuffer(row);
+        SizeValueType          count = 0;
+        for (SizeValueType w = 0; w < wordsPerRow; ++w)
+        {
+          count += PopCount(words[w]);
+        }
+        counts[row] = count;
+      }
+    });
+
+    SizeValueType total = 0;
+    for (const SizeValueType count : counts)
+    {
+      total += count;
+    }
+    return total;
+  }
+
+  /** Dilates the rows of the input by a segment of 2 * radius + 1 pixels
+   * centered on each pixel. The output may be the input. */
+  template <unsigned int VDimension>
+  static void
+  DilateRows(const PackedBinaryImage<VDimension> * input,
+             SizeValueType                         radius,
+             PackedBinaryImage<VDimension> *       output,
+             MultiThreaderBase *                   multiThreader = nullptr)
+  {
+    ProcessRows(input, radius, false, output, multiThreader);
+  }
+
+  /** Erodes the rows of the input by a segment of 2 * radius + 1 pixels
+   * centered on each pixel. The output may be the input. */
+  template <unsigned int VDimension>
+  static void
+  ErodeRows(const PackedBinaryImage<VDimension> * input,
+            SizeValueType                         radius,
+            PackedBinaryImage<VDimension> *       output,
+            MultiThreaderBase *                   multiThreader = nullptr)
+  {
+    ProcessRows(input, radius, true, output, multiThreader);
+  }
+
+  /** Labels the connected components of the foreground of the input. The
+   * background is labeled 0, and the objects are labeled consecutively from
+   * 1, in the raster order of their first pixel. If fullyConnected is false,
+   * only the pixels sharing a face are connected. The output is allocated
+   * with the buffered region of the input, and the number of objects is
+   * returned. */
+  template <typename TLabelImage>
+  static SizeValueType
+  LabelConnectedComponents(const PackedBinaryImage<TLabelImage::ImageDimension> * input,
+                           bool                                                 fullyConnected,
+                           TLabelImage *                                        output,
+                           MultiThreaderBase *                                  multiThreader = nullptr)
+  {
+    using LabelType = typename TLabelImage::PixelType;
+    using RunType = std::pair<SizeValueType, SizeValueType>;
+    constexpr unsigned int Dimension = TLabelImage::ImageDimension;
+
+    const SizeValueType rowLength = input->GetRowLength();
+    const SizeValueType wordsPerRow = input->GetWordsPerRow();
+    const SizeValueType numberOfRows = input->GetNumberOfRows();
+
+    // Extract the runs [begin, end) of foreground pixels of each row.
+    std::vector<std::vector<RunType>> rowRuns(numberOfRows);
+    ParallelizeRows(multiThreader, numberOfRows, [&](SizeValueType beginRow, SizeValueType endRow) {
+      for (SizeValueType row = beginRow; row < endRow; ++row)
+      {
+        const WordType * const words = input->GetRowBuffer(row);
+        bool                   inRun = false;
+        SizeValueType          runBegin = 0;
+        for (SizeValueType w = 0; w < wordsPerRow; ++w)
+        {
+          const WordType word = words[w];
+          unsigned int   bit = 0;
+          while (bit < BitsPerWord)
+          {
+            const WordType remaining = (inRun ? ~word : word) >> bit;
+            if (remaining == 0)
+            {
+              break;
+            }
+            bit += CountTrailingZeros(remaining);
+            if (inRun)
+            {
+              rowRuns[row].emplace_back(runBegin, w * BitsPerWord + bit);
+            }
+            else
+            {
+              runBegin = w * BitsPerWord + bit;
+            }
+            inRun = !inRun;
+          }
+        }
+        if (inRun)
+        {
+          rowRuns[row].emplace_back(runBegin, rowLength);
+        }
+      }
+    });
+
+    std::vector<SizeValueType> firstRun(numberOfRows + 1, 0);
+    for (SizeValueType row = 0; row < numberOfRows; ++row)
+    {
+      firstRun[row + 1] = firstRun[row] + rowRuns[row].size();
+    }
+    const SizeValueType        numberOfRuns = firstRun[numberOfRows];
+    std::vector<SizeValueType> parent(numberOfRuns);
+    for (SizeValueType run = 0; run < numberOfRuns; ++run)
+    {
+      parent[run] = run;
+    }
+    const auto findRoot = [&parent](SizeValueType run) {
+      while (parent[run] != run)
+      {
+        parent[run] = parent[parent[run]];
+        run = parent[run];
+      }
+      return run;
+    };
+
+    // The offsets to the neighbor rows which precede a row.
+    const typename PackedBinaryImage<Dimension>::SizeType & size = input->GetBufferedRegion().GetSize();
+    std::vector<std::vector<int>>                            rowOffsets;
+    std::vector<int>                                         rowOffset(Dimension, -1);
+    for (bool done = (Dimension < 2); !done;)
+    {
+      unsigned int numberOfNonZero = 0;
+      int          last = 0;
+      for (unsigned int d = 1; d < Dimension; ++d)
+      {
+        if (rowOffset[d] != 0)
+        {
+          ++numberOfNonZero;
+          last = rowOffset[d];
+        }
+      }
+      if (last < 0 && (fullyConnected || numberOfNonZero == 1))
+      {
+        rowOffsets.push_back(rowOffset);
+      }
+      done = true;
+      for (unsigned int d = 1; d < Dimension; ++d)
+      {
+        if (rowOffset[d] < 1)
+        {
+          ++rowOffset[d];
+          done = false;
+          break;
+        }
+        rowOffset[d] = -1;
+      }
+    }
+
+    // Merge the overlapping runs of neighbor rows.
+    const SizeValueType tolerance = fullyConnected ? 1 : 0;
+    for (SizeValueType row = 0; row < numberOfRows; ++row)
+    {
+      if (rowRuns[row].empty())
+      {
+        continue;
+      }
+      for (const std::vector<int> & offset : rowOffsets)
+      {
+        SizeValueType remainder = row;
+        SizeValueType neighbor = 0;
+        SizeValueType stride = 1;
+        bool          inside = true;
+        for (unsigned int d = 1; d < Dimension; ++d)
+        {
+          const auto position = static_cast<OffsetValueType>(remainder % size[d]) + offset[d];
+          remainder /= size[d];
+          if (position < 0 || position >= static_cast<OffsetValueType>(size[d]))
+          {
+            inside = false;
+            break;
+          }
+          neighbor += static_cast<SizeValueType>(position) * stride;
+          stride *= size[d];
+        }
+        if (!inside)
+        {
+          continue;
+        }
+        const std::vector<RunType> & runs = rowRuns[row];
+        const std::vector<RunType> & neighborRuns = rowRuns[neighbor];
+        for (SizeValueType i = 0, j = 0; i < runs.size() && j < neighborRuns.size();)
+        {
+          if (runs[i].first < neighborRuns[j].second + tolerance && neighborRuns[j].first < runs[i].second + tolerance)
+          {
+            const SizeValueType root1 = findRoot(firstRun[row] + i);
+            const SizeValueType root2 = findRoot(firstRun[neighbor] + j);
+            parent[std::max(root1, root2)] = std::min(root1, root2);
+          }
+          if (runs[i].second < neighborRuns[j].second)
+          {
+            ++i;
+          }
+          else
+          {
+            ++j;
+          }
+        }
+      }
+    }
+
+    // Number the components in the raster order of their first run.
+    std::vector<LabelType> runLabels(numberOfRuns, NumericTraits<LabelType>::ZeroValue());
+    SizeValueType          numberOfObjects = 0;
+    for (SizeValueType run = 0; run < numberOfRuns; ++run)
+    {
+      const SizeValueType root = findRoot(run);
+      if (root == run)
+      {
+        if (numberOfObjects >= static_cast<SizeValueType>(NumericTraits<LabelType>::max()))
+        {
+          itkGenericExceptionMacro(<< "Number of objects greater than maximum label value");
+        }
+        runLabels[run] = static_cast<LabelType>(++numberOfObjects);
+      }
+      else
+      {
+        runLabels[run] = runLabels[root];
+      }
+    }
+
+    output->CopyInformation(input);
+    output->SetRequestedRegion(input->GetBufferedRegion());
+    output->SetBufferedRegion(input->GetBufferedRegion());
+    output->Allocate();
+
+    LabelType * const buffer = output->GetBufferPointer();
+    ParallelizeRows(multiThreader, numberOfRows, [&](SizeValueType beginRow, SizeValueType endRow) {
+      for (SizeValueType row = beginRow; row < endRow; ++row)
+      {
+        LabelType * const rowBuffer = buffer + row * rowLength;
+        std::fill_n(rowBuffer, rowLength, NumericTraits<LabelType>::ZeroValue());
+        for (SizeValueType i = 0; i < rowRuns[row].size(); ++i)
+        {
+          const RunType & run = rowRuns[row][i];
+          std::fill(rowBuffer + run.first, rowBuffer + run.second, runLabels[firstRun[row] + i]);
+        }
+      }
+    });
+
+    return numberOfObjects;
+  }
+
+private:
+  /** Calls function(beginRow, endRow) on blocks of rows, concurrently with
+   * the multithreader, or at once in the calling thread without one. */
+  template <typename TFunction>
+  static void
+  ParallelizeRows(MultiThreaderBase * multiThreader, SizeValueType numberOfRows, const TFunction & function)
+  {
+    if (numberOfRows == 0)
+    {
+      return;
+    }
+    if (multiThreader == nullptr)
+    {
+      function(0, numberOfRows);
+      return;
+    }
+    const SizeValueType numberOfBlocks =
+      std::min<SizeValueType>(numberOfRows, 4 * static_cast<SizeValueType>(multiThreader->GetNumberOfWorkUnits()));
+    const SizeValueType rowsPerBlock = (numberOfRows + numberOfBlocks - 1) / numberOfBlocks;
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfBlocks,
+      [&](SizeValueType block) {
+        const SizeValueType beginRow = block * rowsPerBlock;
+        function(beginRow, std::min(beginRow + rowsPerBlock, numberOfRows));
+      },
+      nullptr);
+  }
+
+  /** Gives the output the buffered region and the geometry of the input,
+   * unless the output is the input. */
+  template <unsigned int VDimension>
+  static void
+  InitializeOutput(const PackedBinaryImage<VDimension> * input, PackedBinaryImage<VDimension> * output)
+  {
+    if (output == input)
+    {
+      return;
+    }
+    output->CopyInformation(input);
+    output->SetRequestedRegion(input->GetBufferedRegion());
+    output->SetBufferedRegion(input->GetBufferedRegion());
+    output->Allocate();
+  }
+
+  template <unsigned int VDimension, typename TOperation>
+  static void
+  ApplyWordOperation(const PackedBinaryImage<VDimension> * input1,
+                     const PackedBinaryImage<VDimension> * input2,
+                     PackedBinaryImage<VDimension> *       output,
+                     const TOperation &                    operation,
+                     MultiThreaderBase *                   multiThreader)
+  {
+    if (input1->GetBufferedRegion() != input2->GetBufferedRegion())
+    {
+      itkGenericExceptionMacro(<< "The buffered regions of the inputs differ: " << input1->GetBufferedRegion()
+                               << " and " << input2->GetBufferedRegion());
+    }
+    if (output != input2)
+    {
+      InitializeOutput(input1, output);
+    }
+
+    // The rows are contiguous: the whole buffer is processed at once. The
+    // operations preserve the zero padding bits.
+    const SizeValueType numberOfWords = input1->GetNumberOfRows() * input1->GetWordsPerRow();
+    const SizeValueType wordsPerBlock = 4096;
+    const WordType *    in1 = input1->GetBufferPointer();
+    const WordType *    in2 = input2->GetBufferPointer();
+    WordType *          out = output->GetBufferPointer();
+    ParallelizeRows(multiThreader,
+                    (numberOfWords + wordsPerBlock - 1) / wordsPerBlock,
+                    [&](SizeValueType beginBlock, SizeValueType endBlock) {
+                      const SizeValueType end = std::min(endBlock * wordsPerBlock, numberOfWords);
+                      for (SizeValueType w = beginBlock * wordsPerBlock; w < end; ++w)
+                      {
+                        out[w] = operation(in1[w], in2[w]);
+                      }
+                    });
+  }
+
+  /** out[i] = in[i + shift], shifting in zeros. */
+  static void
+  ShiftTowardLower(const WordType * in, WordType * out, SizeValueType numberOfWords, SizeValueType shift)
+  {
+    const SizeValueType wordShift = shift / BitsPerWord;
+    const unsigned int  bitShift = static_cast<unsigned int>(shift % BitsPerWord);
+    for (SizeValueType w = 0; w < numberOfWords; ++w)
+    {
+      const WordType low = (w + wordShift < numberOfWords) ? in[w + wordShift] : 0;
+      const WordType high = (w + wordShift + 1 < numberOfWords) ? in[w + wordShift + 1] : 0;
+      out[w] = bitShift ? ((low >> bitShift) | (high << (BitsPerWord - bitShift))) : low;
+    }
+  }
+
+  /** out[i] = in[i - shift], shifting in zeros. */
+  static void
+  ShiftTowardHigher(const WordType * in, WordType * out, SizeValueType numberOfWords, SizeValueType shift)
+  {
+    const SizeValueType wordShift = shift / BitsPerWord;
+    const unsigned int  bitShift = static_cast<unsigned int>(shift % BitsPerWord);
+    for (SizeValueType w = 0; w < numberOfWords; ++w)
+    {
+      const WordType high = (w >= wordShift) ? in[w - wordShift] : 0;
+      const WordType low = (w >= wordShift + 1) ? in[w - wordShift - 1] : 0;
+      out[w] = bitShift ? ((high << bitShift) | (low >> (BitsPerWord - bitShift))) : high;
+    }
+  }
+
+  /** OR-accumulates the row over a window of `length` pixels, starting at
+   * each pixel and extending toward higher (or lower) indices, using
+   * log2(length) shifts. */
+  static void
+  AccumulateWindow(std::vector<WordType> & row,
+                   std::vector<WordType> & shifted,
+                   SizeValueType           length,
+                   bool                    towardHigherIndices)
+  {
+    const SizeValueType numberOfWords = row.size();
+    const auto          shiftAndOr = [&](SizeValueType shift) {
+      if (towardHigherIndices)
+      {
+        ShiftTowardLower(row.data(), shifted.data(), numberOfWords, shift);
+      }
+      else
+      {
+        ShiftTowardHigher(row.data(), shifted.data(), numberOfWords, shift);
+      }
+      for (SizeValueType w = 0; w < numberOfWords; ++w)
+      {
+        row[w] |= shifted[w];
+      }
+    };
+    SizeValueType covered = 1;
+    while (2 * covered <= length)
+    {
+      shiftAndOr(covered);
+      covered *= 2;
+    }
+    if (covered < length)
+    {
+      shiftAndOr(length - covered);
+    }
+  }
+
+  template <unsigned int VDimension>
+  static void
+  ProcessRows(const PackedBinaryImage<VDimension> * input,
+              SizeValueType                         radius,
+              bool                                  erode,
+              PackedBinaryImage<VDimension> *       output,
+              MultiThreaderBase *                   multiThreader)
+  {
+    InitializeOutput(input, output);
+
+    const SizeValueType wordsPerRow = input->GetWordsPerRow();
+    const WordType      lastWordMask = input->GetLastWordMask();
+
+    // The erosion is the complement of the dilation of the complement, the
+    // pixels outside of the image being background for the dilation.
+    const WordType complement = erode ? ~WordType{ 0 } : WordType{ 0 };
+
+    ParallelizeRows(multiThreader, input->GetNumberOfRows(), [&](SizeValueType beginRow, SizeValueType endRow) {
+      std::vector<WordType> forward(wordsPerRow);
+      std::vector<WordType> backward(wordsPerRow);
+      std::vector<WordType> shifted(wordsPerRow);
+      for (SizeValueType row = beginRow; row < endRow; ++row)
+      {
+        const WordType * const in = input->GetRowBuffer(row);
+        for (SizeValueType w = 0; w < wordsPerRow; ++w)
+        {
+          forward[w] = in[w] ^ complement;
+        }
+        forward[wordsPerRow - 1] &= lastWordMask;
+        backward = forward;
+
+        AccumulateWindow(forward, shifted, radius + 1, true);
+        AccumulateWindow(backward, shifted, radius + 1, false);
+
+        WordType * const out = output->GetRowBuffer(row);
+        for (SizeValueType w = 0; w < wordsPerRow; ++w)
+        {
+          out[w] = (forward[w] | backward[w]) ^ complement;
+        }
+        out[wordsPerRow - 1] &= lastWordMask;
+      }
+    });
+  }
+};
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,188 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPhiloxRandomVariateGenerator_h
+#define itkPhiloxRandomVariateGenerator_h
+
+#include "itkIntTypes.h"
+#include "itkMacro.h"
+#include "itkMath.h"
+
+#include <array>
+#include <cmath>
+
+namespace itk
+{
+namespace Statistics
+{
+/** \class PhiloxRandomVariateGenerator
+ * \brief Counter-based random variate generator, using the Philox4x32-10
+ * bijection.
+ *
+ * A counter-based generator computes its random numbers by encrypting a
+ * counter with a key, instead of by updating a large state. The variates of a
+ * generator only depend on its seed and on its stream number, which together
+ * form the key and the upper part of the counter. A filter can therefore use
+ * the linear position of a pixel as the stream number, and obtain the same
+ * variates for the pixel whatever the number of threads and the way the image
+ * is split, streamed or processed in parallel.
+ *
+ * Unlike MersenneTwisterRandomVariateGenerator, this class is a small value
+ * type, not an itk::Object: constructing or initializing it only stores the
+ * seed and the stream number, so that a generator can cheaply be created for
+ * each pixel or each sample.
+ *
+ * \code
+ * for (SizeValueType pixelNumber = begin; pixelNumber < end; ++pixelNumber)
+ * {
+ *   Statistics::PhiloxRandomVariateGenerator generator(seed, pixelNumber);
+ *   out[pixelNumber] = in[pixelNumber] + sigma * generator.GetNormalVariate();
+ * }
+ * \endcode
+ *
+ * Reference
+ * J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw, "Parallel Random
+ * Numbers: As Easy as 1, 2, 3", Proceedings of the International Conference
+ * for High Performance Computing, Networking, Storage and Analysis, 2011.
+ *
+ * \sa MersenneTwisterRandomVariateGenerator
+ * \ingroup ITKCommon
+ */
+class PhiloxRandomVariateGenerator
+{
+public:
+  /** Standard class type aliases. */
+  using Self = PhiloxRandomVariateGenerator;
+
+  using IntegerType = uint32_t;
+  using CounterType = std::array<uint32_t, 4>;
+  using KeyType = std::array<uint32_t, 2>;
+
+  /** Constructs a generator of stream zero, seeded with zero. */
+  PhiloxRandomVariateGenerator() = default;
+
+  /** Constructs a generator of the specified stream, seeded with the specified
+   * seed. */
+  PhiloxRandomVariateGenerator(const IntegerType seed, const uint64_t stream) { this->Initialize(seed, stream); }
+
+  /** Restarts the generator at the first variate of the specified stream. */
+  void
+  Initialize(const IntegerType seed, const uint64_t stream)
+  {
+    m_Key = KeyType{ { seed, KeyConstant } };
+    m_Counter = CounterType{ { static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32), 0, 0 } };
+    m_NumberOfBufferedIntegers = 0;
+    m_HasBufferedNormalVariate = false;
+  }
+
+  /** Returns the next 32 bit random integer of the stream. */
+  IntegerType
+  GetIntegerVariate()
+  {
+    if (m_NumberOfBufferedIntegers == 0)
+    {
+      m_Buffer = Philox4x32(m_Counter, m_Key);
+      ++m_Counter[2];
+      m_NumberOfBufferedIntegers = 4;
+    }
+    return m_Buffer[--m_NumberOfBufferedIntegers];
+  }
+
+  /** Returns a uniform variate in [0, 1], with 53 random bits. */
+  double
+  GetVariate()
+  {
+    return static_cast<double>(this->GetInteger53()) * (1.0 / 9007199254740991.0);
+  }
+
+  /** Returns a uniform variate in [0, 1), with 53 random bits. */
+  double
+  GetVariateWithOpenUpperRange()
+  {
+    return static_cast<double>(this->GetInteger53()) * (1.0 / 9007199254740992.0);
+  }
+
+  /** Returns a uniform variate in (0, 1), with 53 random bits. */
+  double
+  GetVariateWithOpenRange()
+  {
+    return (static_cast<double>(this->GetInteger53()) + 0.5) * (1.0 / 9007199254740992.0);
+  }
+
+  /** Returns a variate of the standard normal distribution. The variates are
+   * generated in pairs, by the Box-Muller transform. */
+  double
+  GetNormalVariate()
+  {
+    if (m_HasBufferedNormalVariate)
+    {
+      m_HasBufferedNormalVariate = false;
+      return m_BufferedNormalVariate;
+    }
+    const double radius = std::sqrt(-2.0 * std::log(this->GetVariateWithOpenRange()));
+    const double angle = 2.0 * itk::Math::pi * this->GetVariateWithOpenUpperRange();
+    m_BufferedNormalVariate = radius * std::sin(angle);
+    m_HasBufferedNormalVariate = true;
+    return radius * std::cos(angle);
+  }
+
+  /** Returns the encryption of a counter with a key, by ten rounds of the
+   * Philox 4x32 bijection. */
+  static CounterType
+  Philox4x32(CounterType counter, KeyType key)
+  {
+    for (unsigned int round = 0; round < 10; ++round)
+    {
+      if (round > 0)
+      {
+        key[0] += 0x9E3779B9u;
+        key[1] += 0xBB67AE85u;
+      }
+      const uint64_t product0 = uint64_t{ 0xD2511F53u } * counter[0];
+      const uint64_t product1 = uint64_t{ 0xCD9E8D57u } * counter[2];
+      counter = CounterType{ { static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+                               static_cast<uint32_t>(product1),
+                               static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+                               static_cast<uint32_t>(product0) } };
+    }
+    return counter;
+  }
+
+private:
+  // Second word of the key, so that seed zero does not give a zero key.
+  static constexpr uint32_t KeyConstant = 0xCA01F9DDu;
+
+  // Returns a random integer in [0, 2^53).
+  uint64_t
+  GetInteger53()
+  {
+    const uint64_t upper = this->GetIntegerVariate() >> 5;
+    const uint64_t lower = this->GetIntegerVariate() >> 6;
+    return (upper << 26) | lower;
+  }
+
+  KeyType      m_Key{ { 0, KeyConstant } };
+  CounterType  m_Counter{ { 0, 0, 0, 0 } };
+  CounterType  m_Buffer{ { 0, 0, 0, 0 } };
+  unsigned int m_NumberOfBufferedIntegers{ 0 };
+  double       m_BufferedNormalVariate{ 0.0 };
+  bool         m_HasBufferedNormalVariate{ false };
+};
+} // end namespace Statistics
+} // end namespace itk
+
+#endif
@@ -0,0 +1,218 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPlanarImage_h
+#define itkPlanarImage_h
+
+#include "itkImage.h"
+#include "itkVariableLengthVector.h"
+
+#include <vector>
+
+namespace itk
+{
+/** \class PlanarImage
+ * \brief Multi-component image that stores each component in its own plane.
+ *
+ * VectorImage and Image<Vector<...>> interleave the components of a pixel:
+ *   ... Pi0 Pi1 Pi2 P(i+1)0 P(i+1)1 P(i+1)2 ...
+ * PlanarImage stores the components as separate channels instead: channel k
+ * holds component k of every pixel, contiguous in memory, in the same order
+ * as the pixels of an Image:
+ *   ... P(i)k P(i+1)k P(i+2)k ...
+ * An operation on one component therefore walks contiguous memory.
+ *
+ * GetChannel() returns a channel as an Image that shares the pixels of the
+ * channel: it is a view, made without copying any pixel, and setting its
+ * pixels sets the pixels of the PlanarImage. The view keeps the pixels alive,
+ * even after the PlanarImage is initialized or destroyed. SetChannel() makes
+ * an Image a channel, again without copying. Any filter that takes an Image
+ * can thereby process a channel; ImageFilterToPlanarImageFilterWrapper runs
+ * such a filter on every channel.
+ *
+ * The pixel type is VariableLengthVector<TPixel>, like for VectorImage;
+ * GetPixel() and SetPixel() gather and scatter the components of a pixel.
+ * The components of an interleaved image are converted with
+ * VectorImageToPlanarImageFilter and PlanarImageToVectorImageFilter.
+ *
+ * \warning PlanarImage has no single pixel buffer: it cannot be used with the
+ * iterators of Image, nor with the filters that require an Image.
+ *
+ * \sa VectorImage
+ * \sa Image
+ *
+ * \ingroup ImageObjects
+ * \ingroup ITKCommon
+ */
+template <typename TPixel, unsigned int VImageDimension = 3>
+class ITK_TEMPLATE_EXPORT PlanarImage : public ImageBase<VImageDimension>
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(PlanarImage);
+
+  /** Standard class type aliases */
+  using Self = PlanarImage;
+  using Superclass = ImageBase<VImageDimension>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+  using ConstWeakPointer = WeakPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(PlanarImage, ImageBase);
+
+  /** Pixel type alias support. Like for VectorImage, a pixel is presented as a
+   * VariableLengthVector of its components, while the channels store TPixel. */
+  using PixelType = VariableLengthVector<TPixel>;
+  using ValueType = PixelType;
+  using InternalPixelType = TPixel;
+  using IOPixelType = InternalPixelType;
+
+  /** Types inherited from the superclass. */
+  using ImageDimensionType = typename Superclass::ImageDimensionType;
+  using IndexType = typename Superclass::IndexType;
+  using IndexValueType = typename Superclass::IndexValueType;
+  using OffsetType = typename Superclass::OffsetType;
+  using OffsetValueType = typename Superclass::OffsetValueType;
+  using SizeType = typename Superclass::SizeType;
+  using SizeValueType = typename Superclass::SizeValueType;
+  using RegionType = typename Superclass::RegionType;
+  using DirectionType = typename Superclass::DirectionType;
+  using SpacingType = typename Superclass::SpacingType;
+  using SpacingValueType = typename Superclass::SpacingValueType;
+  using PointType = typename Superclass::PointType;
+
+  /** The type of the image of a channel, and of the container of its pixels. */
+  using ChannelImageType = Image<TPixel, VImageDimension>;
+  using PixelContainer = typename ChannelImageType::PixelContainer;
+  using PixelContainerPointer = typename PixelContainer::Pointer;
+
+  static constexpr unsigned int ImageDimension = VImageDimension;
+
+  template <typename UPixelType, unsigned int VUImageDimension = VImageDimension>
+  using RebindImageType = PlanarImage<UPixelType, VUImageDimension>;
+
+  /** Allocates the channels of the buffered region, which must already be
+   * set, e.g. by SetRegions(), as well as the number of components. */
+  void
+  Allocate(bool initializePixels = false) override;
+
+  /** Restores the data object to its initial state, releasing the channels. */
+  void
+  Initialize() override;
+
+  /** Fills every channel with the value. */
+  void
+  FillBuffer(const TPixel & value);
+
+  /** Sets the components of a pixel. */
+  void
+  SetPixel(const IndexType & index, const PixelType & value)
+  {
+    const OffsetValueType offset = this->FastComputeOffset(index);
+    for (unsigned int k = 0; k < m_NumberOfComponentsPerPixel; ++k)
+    {
+      m_Channels[k]->GetBufferPointer()[offset] = value[k];
+    }
+  }
+
+  /** Returns the components of a pixel. */
+  PixelType
+  GetPixel(const IndexType & index) const
+  {
+    const OffsetValueType offset = this->FastComputeOffset(index);
+    PixelType             pixel(m_NumberOfComponentsPerPixel);
+    for (unsigned int k = 0; k < m_NumberOfComponentsPerPixel; ++k)
+    {
+      pixel[k] = m_Channels[k]->GetBufferPointer()[offset];
+    }
+    return pixel;
+  }
+
+  /** Returns the components of a pixel. */
+  PixelType operator[](const IndexType & index) const { return this->GetPixel(index); }
+
+  /** Returns a view of a channel: an Image that shares the pixels of the
+   * channel, and has the geometry and regions of this image. */
+  typename ChannelImageType::Pointer
+  GetChannel(unsigned int channel);
+  typename ChannelImageType::ConstPointer
+  GetChannel(unsigned int channel) const;
+
+  /** Makes the pixels of an image the pixels of a channel, without copying
+   * them. The buffered region of the image must be the buffered region of this
+   * image. */
+  void
+  SetChannel(unsigned int channel, ChannelImageType * image);
+
+  /** Returns the pixels of a channel, which are in the order of the pixels of
+   * the buffered region. */
+  TPixel *
+  GetChannelBufferPointer(const unsigned int channel)
+  {
+    return m_Channels[channel]->GetBufferPointer();
+  }
+  const TPixel *
+  GetChannelBufferPointer(const unsigned int channel) const
+  {
+    return m_Channels[channel]->GetBufferPointer();
+  }
+
+  /** Get/Set the number of components of a pixel, which is the number of
+   * channels. */
+  unsigned int
+  GetNumberOfComponentsPerPixel() const override
+  {
+    return m_NumberOfComponentsPerPixel;
+  }
+  void
+  SetNumberOfComponentsPerPixel(unsigned int n) override;
+
+  /** Graft the data and information from one image to another. The images
+   * share their channels. */
+  virtual void
+  Graft(const Self * data);
+
+protected:
+  PlanarImage() = default;
+  ~PlanarImage() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  Graft(const DataObject * data) override;
+
+  using Superclass::Graft;
+
+private:
+  // Throws an exception when the channel is not allocated.
+  void
+  VerifyChannel(unsigned int channel) const;
+
+  unsigned int                       m_NumberOfComponentsPerPixel{ 0 };
+  std::vector<PixelContainerPointer> m_Channels;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkPlanarImage.hxx"
+#endif
+
+#endif
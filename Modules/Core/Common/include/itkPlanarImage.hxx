@@ -0,0 +1,218 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPlanarImage_hxx
+#define itkPlanarImage_hxx
+
+#include "itkPlanarImage.h"
+#include <algorithm>
+
+namespace itk
+{
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+PlanarImage<TPixel, VImageDimension>::Allocate(bool initializePixels)
+{
+  if (m_NumberOfComponentsPerPixel == 0)
+  {
+    itkExceptionMacro(<< "Cannot allocate PlanarImage with a number of components per pixel of zero");
+  }
+
+  this->ComputeOffsetTable();
+  const SizeValueType numberOfPixels = this->GetOffsetTable()[VImageDimension];
+
+  // Like Image::Allocate, reuse the containers of the channels, which may be
+  // shared with grafted images.
+  m_Channels.resize(m_NumberOfComponentsPerPixel);
+  for (auto & channel : m_Channels)
+  {
+    if (channel.IsNull())
+    {
+      channel = PixelContainer::New();
+    }
+    channel->Reserve(numberOfPixels, initializePixels);
+  }
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+PlanarImage<TPixel, VImageDimension>::Initialize()
+{
+  //
+  // We don't modify ourselves because the "ReleaseData" methods depend upon
+  // no modification when initialized.
+  //
+
+  // Call the superclass which should initialize the BufferedRegion ivar.
+  Superclass::Initialize();
+
+  // Replace the containers rather than releasing their memory, because the
+  // views of the channels and grafted images may share them.
+  m_Channels.clear();
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+PlanarImage<TPixel, VImageDimension>::FillBuffer(const TPixel & value)
+{
+  const SizeValueType numberOfPixels = this->GetBufferedRegion().GetNumberOfPixels();
+  for (const auto & channel : m_Channels)
+  {
+    std::fill_n(channel->GetBufferPointer(), numberOfPixels, value);
+  }
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+PlanarImage<TPixel, VImageDimension>::SetNumberOfComponentsPerPixel(unsigned int n)
+{
+  if (n != m_NumberOfComponentsPerPixel)
+  {
+    m_NumberOfComponentsPerPixel = n;
+    this->Modified();
+  }
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+PlanarImage<TPixel, VImageDimension>::VerifyChannel(unsigned int channel) const
+{
+  if (channel >= m_Channels.size() || m_Channels[channel].IsNull())
+  {
+    itkExceptionMacro(<< "Channel " << channel << " is not allocated; the image has " << m_NumberOfComponentsPerPixel
+                      << " components per pixel, and " << m_Channels.size() << " channels");
+  }
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+auto
+PlanarImage<TPixel, VImageDimension>::GetChannel(unsigned int channel) -> typename ChannelImageType::Pointer
+{
+  this->VerifyChannel(channel);
+
+  const auto view = ChannelImageType::New();
+  view->CopyInformation(this);
+  view->SetBufferedRegion(this->GetBufferedRegion());
+  view->SetRequestedRegion(this->GetRequestedRegion());
+  view->SetPixelContainer(m_Channels[channel]);
+  return view;
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+auto
+PlanarImage<TPixel, VImageDimension>::GetChannel(unsigned int channel) const ->
+  typename ChannelImageType::ConstPointer
+{
+  return const_cast<Self *>(this)->GetChannel(channel).GetPointer();
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+PlanarImage<TPixel, VImageDimension>::SetChannel(unsigned int channel, ChannelImageType * image)
+{
+  if (channel >= m_NumberOfComponentsPerPixel)
+  {
+    itkExceptionMacro(<< "Cannot set channel " << channel << " of an image with " << m_NumberOfComponentsPerPixel
+                      << " components per pixel");
+  }
+  if (image == nullptr || image->GetBufferedRegion() != this->GetBufferedRegion())
+  {
+    itkExceptionMacro(<< "The buffered region of the image of channel " << channel
+                      << " must be the buffered region of the PlanarImage " << this->GetBufferedRegion());
+  }
+
+  this->ComputeOffsetTable();
+  m_Channels.resize(m_NumberOfComponentsPerPixel);
+  m_Channels[channel] = image->GetPixelContainer();
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+PlanarImage<TPixel, VImageDimension>::Graft(const Self * image)
+{
+  // call the superclass' implementation
+  Superclass::Graft(image);
+
+  if (image)
+  {
+    // Now copy anything remaining that is needed
+    m_NumberOfComponentsPerPixel = image->m_NumberOfComponentsPerPixel;
+    m_Channels = image->m_Channels;
+  }
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+PlanarImage<TPixel, VImageDimension>::Graft(const DataObject * data)
+{
+  if (data)
+  {
+    // Attempt to cast data to a PlanarImage
+    const auto * const imgData = dynamic_cast<const Self *>(data);
+
+    if (imgData != nullptr)
+    {
+      this->Graft(imgData);
+    }
+    else
+    {
+      // pointer could not be cast back down
+      itkExceptionMacro(<< "itk::PlanarImage::Graft() cannot cast " << typeid(data).name() << " to "
+                        << typeid(const Self *).name());
+    }
+  }
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+PlanarImage<TPixel, VImageDimension>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfComponentsPerPixel: " << m_NumberOfComponentsPerPixel << std::endl;
+  for (unsigned int k = 0; k < m_Channels.size(); ++k)
+  {
+    os << indent << "Channel " << k << ": ";
+    if (m_Channels[k])
+    {
+      os << std::endl;
+      m_Channels[k]->Print(os, indent.GetNextIndent());
+    }
+    else
+    {
+      os << "(null)" << std::endl;
+    }
+  }
+}
+
+// static constexpr definitions explicitly needed in C++11
+template <typename TPixel, unsigned int VImageDimension>
+constexpr unsigned int PlanarImage<TPixel, VImageDimension>::ImageDimension;
+} // end namespace itk
+
+#endif
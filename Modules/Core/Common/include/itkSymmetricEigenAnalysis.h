@@ -19,9 +19,13 @@
 #define itkSymmetricEigenAnalysis_h
 
 #include "itkMacro.h"
+#include "itkMath.h"
 #include "itk_eigen.h"
 #include ITK_EIGEN(Eigenvalues)
+#include <algorithm>
+#include <cmath>
 #include <numeric>
+#include <type_traits>
 #include <vector>
 // For GetPointerToMatrixData
 #include "vnl/vnl_matrix.h"
@@ -109,6 +113,94 @@ permuteColumnsWithSortIndices(QMatrix & eigenVectors, const std::vector<int> & i
   // Apply it
   eigenVectors = eigenVectors * perm;
 }
+
+/** Computes the eigenvalues of the real symmetric 2x2 matrix
+ * [a00 a01; a01 a11] in closed form, in ascending order. */
+inline void
+ComputeSymmetricEigenValues2x2(const double a00, const double a01, const double a11, double eigenValues[2])
+{
+  const double halfTrace = 0.5 * (a00 + a11);
+  const double radius = Math::hypot(0.5 * (a00 - a11), a01);
+  eigenValues[0] = halfTrace - radius;
+  eigenValues[1] = halfTrace + radius;
+}
+
+/** Computes the eigenvalues of the real symmetric 3x3 matrix
+ * [a00 a01 a02; a01 a11 a12; a02 a12 a22] in closed form, in ascending
+ * order, with the trigonometric solution of the characteristic polynomial
+ * of the shifted and scaled matrix (O. K. Smith, "Eigenvalues of a symmetric
+ * 3x3 matrix", Communications of the ACM 4(4), 1961).
+ *
+ * The solution loses accuracy when two eigenvalues are nearly equal, but not
+ * exactly equal. In that case, and for non-finite elements, the function
+ * returns false without computing the eigenvalues, and an iterative method
+ * should be used instead. */
+inline bool
+ComputeSymmetricEigenValues3x3(const double a00,
+                               const double a01,
+                               const double a02,
+                               const double a11,
+                               const double a12,
+                               const double a22,
+                               double       eigenValues[3])
+{
+  const double offDiagonalNorm2 = a01 * a01 + a02 * a02 + a12 * a12;
+  if (offDiagonalNorm2 == 0.0)
+  {
+    eigenValues[0] = a00;
+    eigenValues[1] = a11;
+    eigenValues[2] = a22;
+    std::sort(eigenValues, eigenValues + 3);
+    return true;
+  }
+
+  // B = (A - q I) / p has a zero trace and a unit Frobenius norm divided by
+  // sqrt(6), so that its eigenvalues are 2 cos(phi + 2 k pi / 3).
+  const double q = (a00 + a11 + a22) / 3.0;
+  const double b00 = a00 - q;
+  const double b11 = a11 - q;
+  const double b22 = a22 - q;
+  const double p = std::sqrt((b00 * b00 + b11 * b11 + b22 * b22 + 2.0 * offDiagonalNorm2) / 6.0);
+  const double inverseP = 1.0 / p;
+  const double c00 = b00 * inverseP;
+  const double c01 = a01 * inverseP;
+  const double c02 = a02 * inverseP;
+  const double c11 = b11 * inverseP;
+  const double c12 = a12 * inverseP;
+  const double c22 = b22 * inverseP;
+  const double halfDeterminant =
+    0.5 * (c00 * (c11 * c22 - c12 * c12) - c01 * (c01 * c22 - c12 * c02) + c02 * (c01 * c12 - c11 * c02));
+
+  // Near +/-1, acos amplifies the rounding errors of the determinant.
+  constexpr double degeneracyTolerance = 1e-9;
+  if (!(std::abs(halfDeterminant) < 1.0 - degeneracyTolerance))
+  {
+    return false;
+  }
+
+  const double phi = std::acos(halfDeterminant) / 3.0;
+  eigenValues[2] = q + 2.0 * p * std::cos(phi);
+  eigenValues[0] = q + 2.0 * p * std::cos(phi + 2.0 * Math::pi / 3.0);
+  eigenValues[1] = 3.0 * q - eigenValues[0] - eigenValues[2];
+  return true;
+}
+
+/** Reorders eigenvalues sorted in ascending order by ascending magnitude,
+ * keeping the order of the values of equal magnitude. */
+inline void
+sortAscendingEigenValuesByMagnitude(double * eigenValues, const unsigned int numberOfElements)
+{
+  for (unsigned int i = 1; i < numberOfElements; ++i)
+  {
+    const double value = eigenValues[i];
+    unsigned int j = i;
+    for (; j > 0 && std::abs(eigenValues[j - 1]) > std::abs(value); --j)
+    {
+      eigenValues[j] = eigenValues[j - 1];
+    }
+    eigenValues[j] = value;
+  }
+}
 } // end namespace detail
 
 /**\class SymmetricEigenAnalysisEnums
@@ -162,6 +254,45 @@ static constexpr EigenValueOrderEnum OrderByMagnitude = EigenValueOrderEnum::Ord
 static constexpr EigenValueOrderEnum DoNotOrder = EigenValueOrderEnum::DoNotOrder;
 #endif
 
+namespace detail
+{
+/** Computes the eigenvalues of a real symmetric 2x2 or 3x3 matrix in closed
+ * form, in ascending order, or by ascending magnitude for OrderByMagnitude.
+ * Only the upper triangle of the matrix is accessed, with the () operator.
+ *
+ * Returns false, leaving the eigenvalues unchanged, when the closed-form
+ * solution does not apply: for other dimensions, and for the matrices
+ * rejected by ComputeSymmetricEigenValues3x3. */
+template <typename TMatrix, typename TVector>
+bool
+ComputeSymmetricEigenValuesInClosedForm(const TMatrix &           A,
+                                        const unsigned int        dimension,
+                                        const EigenValueOrderEnum order,
+                                        TVector &                 eigenValues)
+{
+  double values[3];
+  if (dimension == 2)
+  {
+    ComputeSymmetricEigenValues2x2(A(0, 0), A(0, 1), A(1, 1), values);
+  }
+  else if (dimension != 3 ||
+           !ComputeSymmetricEigenValues3x3(A(0, 0), A(0, 1), A(0, 2), A(1, 1), A(1, 2), A(2, 2), values))
+  {
+    return false;
+  }
+
+  if (order == EigenValueOrderEnum::OrderByMagnitude)
+  {
+    sortAscendingEigenValuesByMagnitude(values, dimension);
+  }
+  for (unsigned int i = 0; i < dimension; ++i)
+  {
+    eigenValues[i] = values[i];
+  }
+  return true;
+}
+} // end namespace detail
+
 /** \class SymmetricEigenAnalysis
  * \brief Find Eigen values of a real 2D symmetric matrix. It
  * serves as a thread-safe alternative to the class:
@@ -232,6 +363,10 @@ public:
    * No size checking is performed. A is expected to be a square matrix of size
    * m_Dimension.  'EigenValues' is expected to be of length m_Dimension.
    * The matrix is not checked to see if it is symmetric.
+   *
+   * Ordered eigen values of 2x2 and 3x3 matrices are computed in closed form,
+   * unless the Eigen library is used, or two eigen values are too close for
+   * the closed-form solution to be accurate.
    */
   unsigned int
   ComputeEigenValues(const TMatrix & A, TVector & EigenValues) const;
@@ -787,10 +922,18 @@ public:
    * No size checking is performed. A is expected to be a square matrix of size
    * VDimension.  'EigenValues' is expected to be of length VDimension.
    * The matrix is not checked to see if it is symmetric.
+   *
+   * The eigen values of 2x2 and 3x3 matrices are computed in closed form,
+   * unless two eigen values are too close for the closed-form solution to be
+   * accurate.
    */
   unsigned int
   ComputeEigenValues(const TMatrix & A, TVector & EigenValues) const
   {
+    if (detail::ComputeSymmetricEigenValuesInClosedForm(A, VDimension, m_OrderEigenValues, EigenValues))
+    {
+      return 1;
+    }
     return ComputeEigenValuesWithEigenLibraryImpl(A, EigenValues, true);
   }
 
@@ -33,6 +33,13 @@ SymmetricEigenAnalysis<TMatrix, TVector, TEigenMatrix>::ComputeEigenValues(const
   }
   else
   {
+    // The closed-form solution for 2x2 and 3x3 matrices does not iterate, and
+    // does not allocate work areas.
+    if (m_OrderEigenValues != EigenValueOrderEnum::DoNotOrder && m_Order == m_Dimension &&
+        detail::ComputeSymmetricEigenValuesInClosedForm(A, m_Dimension, m_OrderEigenValues, D))
+    {
+      return 0;
+    }
     return ComputeEigenValuesLegacy(A, D);
   }
 }
@@ -78,6 +78,16 @@ public:
                   const DomainType & completeDomain,
                   DomainType &       subDomain) const = 0;
 
+  /** Returns the number of elements of the domain (pixels, indices, ...),
+   * which DomainThreader uses to split it into subdomains of a given grain
+   * size. The default implementation returns zero, meaning that the size is
+   * unknown. */
+  virtual SizeValueType
+  GetDomainSize(const DomainType & itkNotUsed(domain)) const
+  {
+    return 0;
+  }
+
 protected:
   ThreadedDomainPartitioner() = default;
   ~ThreadedDomainPartitioner() override = default;
@@ -86,6 +86,13 @@ public:
                   const DomainType & completeRegion,
                   DomainType &       subRegion) const override;
 
+  /** Returns the number of pixels of the region. */
+  SizeValueType
+  GetDomainSize(const DomainType & region) const override
+  {
+    return region.GetNumberOfPixels();
+  }
+
 protected:
   ThreadedImageRegionPartitioner();
   ~ThreadedImageRegionPartitioner() override = default;
@@ -84,6 +84,13 @@ public:
                   const DomainType & completeIndexRange,
                   DomainType &       subIndexRange) const override;
 
+  /** Returns the number of indices of the inclusive index range. */
+  SizeValueType
+  GetDomainSize(const DomainType & indexRange) const override
+  {
+    return static_cast<SizeValueType>(indexRange[1] - indexRange[0] + 1);
+  }
+
 protected:
   ThreadedIndexedContainerPartitioner();
   ~ThreadedIndexedContainerPartitioner() override;
@@ -21,6 +21,8 @@
 #include "itkThreadedDomainPartitioner.h"
 #include "itkObjectFactory.h"
 
+#include <iterator>
+
 namespace itk
 {
 
@@ -150,6 +152,13 @@ public:
                   const DomainType & completeDomain,
                   DomainType &       subDomain) const override;
 
+  /** Returns the number of elements of the iterator range. */
+  SizeValueType
+  GetDomainSize(const DomainType & domain) const override
+  {
+    return static_cast<SizeValueType>(std::distance(domain.Begin(), domain.End()));
+  }
+
 protected:
   ThreadedIteratorRangePartitioner() = default;
   ~ThreadedIteratorRangePartitioner() override = default;
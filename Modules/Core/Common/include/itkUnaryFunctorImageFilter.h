@@ -22,6 +22,8 @@
 #include "itkInPlaceImageFilter.h"
 #include "itkImageRegionIteratorWithIndex.h"
 
+#include <type_traits> // For integral_constant.
+
 namespace itk
 {
 /** \class UnaryFunctorImageFilter
@@ -137,6 +139,23 @@ protected:
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
 private:
+  /** Tells whether the input and output pixels can be accessed through raw
+   * pointers to the scanlines of the image buffers. */
+  using HasPixelScanlinesType =
+    std::integral_constant<bool,
+                           MultiThreaderBase::HasPixelScanlines<TInputImage>() &&
+                             MultiThreaderBase::HasPixelScanlines<TOutputImage>() &&
+                             TInputImage::ImageDimension == TOutputImage::ImageDimension>;
+
+  /** Applies the functor to the pixels of the region, either through raw
+   * pointers to the contiguous pixels of each scanline (std::true_type), so
+   * that the loop may be vectorized by the compiler, or through scanline
+   * iterators (std::false_type). */
+  void
+  ThreadedApplyFunctor(const OutputImageRegionType & outputRegionForThread, std::true_type);
+  void
+  ThreadedApplyFunctor(const OutputImageRegionType & outputRegionForThread, std::false_type);
+
   FunctorType m_Functor;
 };
 } // end namespace itk
@@ -73,6 +73,52 @@ template <typename TInputImage, typename TOutputImage, typename TFunction>
 void
 UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
+{
+  this->ThreadedApplyFunctor(outputRegionForThread, HasPixelScanlinesType());
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TFunction>
+void
+UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::ThreadedApplyFunctor(
+  const OutputImageRegionType & outputRegionForThread,
+  std::true_type)
+{
+  const TInputImage * inputPtr = this->GetInput();
+  TOutputImage *      outputPtr = this->GetOutput(0);
+
+  InputImageRegionType inputRegionForThread;
+  this->CallCopyOutputRegionToInputRegion(inputRegionForThread, outputRegionForThread);
+  if (inputRegionForThread != outputRegionForThread)
+  {
+    // The scanlines of the input and output regions do not match.
+    this->ThreadedApplyFunctor(outputRegionForThread, std::false_type());
+    return;
+  }
+
+  TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
+
+  const FunctorType & functor = m_Functor;
+  MultiThreaderBase::ProcessImageScanlines(
+    outputRegionForThread,
+    [&functor, &progress](
+      SizeValueType numberOfPixels, OutputImagePixelType * output, const InputImagePixelType * input) {
+      for (SizeValueType i = 0; i < numberOfPixels; ++i)
+      {
+        output[i] = functor(input[i]);
+      }
+      progress.Completed(numberOfPixels);
+    },
+    *outputPtr,
+    *inputPtr);
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TFunction>
+void
+UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::ThreadedApplyFunctor(
+  const OutputImageRegionType & outputRegionForThread,
+  std::false_type)
 {
   const TInputImage * inputPtr = this->GetInput();
   TOutputImage *      outputPtr = this->GetOutput(0);
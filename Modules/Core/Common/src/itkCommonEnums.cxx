@@ -99,6 +99,8 @@ operator<<(std::ostream & out, const CommonEnums::IOComponent value)
         return "itk::CommonEnums::IOComponent::DOUBLE";
       case CommonEnums::IOComponent::LDOUBLE:
         return "itk::CommonEnums::IOComponent::LDOUBLE";
+      case CommonEnums::IOComponent::FLOAT16:
+        return "itk::CommonEnums::IOComponent::FLOAT16";
       default:
         return "INVALID VALUE FOR itk::CommonEnums::IOComponent";
     }
@@ -15,6 +15,7 @@
  *  limitations under the License.
  *
  *=========================================================================*/
+#include "itkFloat16.h"
 #include "itkNumericTraits.h"
 
 namespace itk
@@ -68,6 +69,9 @@ constexpr float NumericTraits<float>::One;
 constexpr double NumericTraits<double>::Zero;
 constexpr double NumericTraits<double>::One;
 
+constexpr Float16 NumericTraits<Float16>::Zero;
+constexpr Float16 NumericTraits<Float16>::One;
+
 constexpr long double NumericTraits<long double>::Zero;
 constexpr long double NumericTraits<long double>::One;
 
@@ -0,0 +1,243 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkBrickedImage.h"
+
+#include "itkBrickedImageRegionRange.h"
+#include "itkImage.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionRange.h"
+#include "itkIndexRange.h"
+#include "itkMultiThreaderBase.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using BrickedImageType = itk::BrickedImage<short, Dimension, 8>;
+using DenseImageType = itk::Image<short, Dimension>;
+using RegionType = BrickedImageType::RegionType;
+
+const RegionType bufferedRegion({ { -5, 2, 3 } }, { { 21, 17, 9 } });
+
+
+// Sets the pixels of a slice and of a small blob, in both images.
+void
+SetSparsePixels(BrickedImageType & brickedImage, DenseImageType & denseImage)
+{
+  int value = 0;
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(bufferedRegion))
+  {
+    const bool isInBlob = index[0] >= 6 && index[0] < 10 && index[1] >= 12 && index[1] < 17;
+    if (index[2] != 5 && !isInBlob)
+    {
+      continue;
+    }
+    const auto pixel = static_cast<short>((value++ * 37) % 101 - 50);
+    brickedImage.SetPixel(index, pixel);
+    denseImage.SetPixel(index, pixel);
+  }
+}
+
+
+template <typename TImage>
+typename TImage::Pointer
+CreateImage()
+{
+  const auto image = TImage::New();
+  image->SetRegions(bufferedRegion);
+  image->Allocate(true);
+  return image;
+}
+} // namespace
+
+
+TEST(BrickedImage, AllocatesBricksLazily)
+{
+  const auto image = CreateImage<BrickedImageType>();
+  EXPECT_EQ(image->GetBrickGridSize(), BrickedImageType::SizeType({ { 3, 3, 2 } }));
+  EXPECT_EQ(image->GetNumberOfBricks(), 18u);
+  EXPECT_EQ(image->GetNumberOfAllocatedBricks(), 0u);
+  EXPECT_EQ(image->GetPixel(bufferedRegion.GetIndex()), 0);
+
+  // Setting the background value allocates no brick.
+  const BrickedImageType::IndexType index{ { 4, 12, 11 } };
+  image->SetPixel(index, 0);
+  EXPECT_EQ(image->GetNumberOfAllocatedBricks(), 0u);
+
+  image->SetPixel(index, 42);
+  EXPECT_EQ(image->GetNumberOfAllocatedBricks(), 1u);
+  EXPECT_EQ(image->GetPixel(index), 42);
+  const BrickedImageType::OffsetType xOffset{ { 1, 0, 0 } };
+  EXPECT_EQ((*image)[index - xOffset], 0);
+
+  // FillBuffer releases the bricks.
+  image->FillBuffer(7);
+  EXPECT_EQ(image->GetNumberOfAllocatedBricks(), 0u);
+  EXPECT_EQ(image->GetBackgroundValue(), 7);
+  EXPECT_EQ(image->GetPixel(index), 7);
+  image->SetPixel(index, 8);
+  EXPECT_EQ(image->GetPixel(index - xOffset), 7);
+
+  // Bricks that have returned to the background value can be released.
+  image->AllocateBricks(RegionType({ { 2, 8, 3 } }, { { 4, 6, 1 } }));
+  EXPECT_EQ(image->GetNumberOfAllocatedBricks(), 5u);
+  image->SetPixel(index, 7);
+  EXPECT_EQ(image->ReleaseBackgroundBricks(), 5u);
+  EXPECT_EQ(image->GetNumberOfAllocatedBricks(), 0u);
+}
+
+
+TEST(BrickedImage, HasThePixelsOfAnImage)
+{
+  const auto brickedImage = CreateImage<BrickedImageType>();
+  const auto denseImage = CreateImage<DenseImageType>();
+  SetSparsePixels(*brickedImage, *denseImage);
+  EXPECT_EQ(brickedImage->GetNumberOfAllocatedBricks(), 10u);
+
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(bufferedRegion))
+  {
+    ASSERT_EQ(brickedImage->GetPixel(index), denseImage->GetPixel(index)) << index;
+  }
+}
+
+
+TEST(BrickedImage, IteratorsVisitThePixelsLikeImageRegionIterators)
+{
+  const auto brickedImage = CreateImage<BrickedImageType>();
+  const auto denseImage = CreateImage<DenseImageType>();
+  SetSparsePixels(*brickedImage, *denseImage);
+
+  const RegionType                                       region({ { -4, 5, 4 } }, { { 18, 10, 6 } });
+  const auto                                             copy = CreateImage<BrickedImageType>();
+  itk::BrickedImageRegionConstIterator<BrickedImageType> brickedIt(brickedImage, region);
+  itk::BrickedImageRegionIterator<BrickedImageType>      copyIt(copy, region);
+  itk::ImageRegionConstIteratorWithIndex<DenseImageType> denseIt(denseImage, region);
+  itk::SizeValueType                                     numberOfPixels = 0;
+
+  for (; !denseIt.IsAtEnd(); ++denseIt, ++brickedIt, ++copyIt)
+  {
+    ASSERT_FALSE(brickedIt.IsAtEnd());
+    ASSERT_EQ(brickedIt.GetIndex(), denseIt.GetIndex());
+    ASSERT_EQ(copyIt.GetIndex(), denseIt.GetIndex());
+    EXPECT_EQ(brickedIt.Get(), denseIt.Get());
+    copyIt.Set(brickedIt.Get());
+    EXPECT_EQ(copyIt.Get(), denseIt.Get());
+    ++numberOfPixels;
+  }
+  EXPECT_TRUE(brickedIt.IsAtEnd());
+  EXPECT_TRUE(copyIt.IsAtEnd());
+  EXPECT_EQ(numberOfPixels, region.GetNumberOfPixels());
+
+  // The copy only allocated the bricks that are not background.
+  EXPECT_EQ(copy->ReleaseBackgroundBricks(), 0u);
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(bufferedRegion))
+  {
+    ASSERT_EQ(copy->GetPixel(index), region.IsInside(index) ? denseImage->GetPixel(index) : 0) << index;
+  }
+
+  // An empty region has no pixel.
+  const RegionType                                       emptyRegion({ { 0, 3, 4 } }, { { 5, 0, 2 } });
+  itk::BrickedImageRegionConstIterator<BrickedImageType> emptyIt(brickedImage, emptyRegion);
+  EXPECT_TRUE(emptyIt.IsAtEnd());
+}
+
+
+TEST(BrickedImage, SupportsRangeBasedForLoops)
+{
+  const auto brickedImage = CreateImage<BrickedImageType>();
+  const auto denseImage = CreateImage<DenseImageType>();
+  SetSparsePixels(*brickedImage, *denseImage);
+
+  const RegionType                                     region({ { 0, 4, 3 } }, { { 13, 11, 5 } });
+  const itk::BrickedImageRegionRange<BrickedImageType> range(*brickedImage, region);
+  EXPECT_EQ(range.size(), region.GetNumberOfPixels());
+  EXPECT_EQ(std::distance(range.begin(), range.end()), static_cast<std::ptrdiff_t>(range.size()));
+
+  auto denseIt = itk::ImageRegionConstIteratorWithIndex<DenseImageType>(denseImage, region);
+  for (const short pixel : itk::BrickedImageRegionRange<const BrickedImageType>(*brickedImage, region))
+  {
+    EXPECT_EQ(pixel, denseIt.Get()) << denseIt.GetIndex();
+    ++denseIt;
+  }
+
+  for (auto && pixel : range)
+  {
+    pixel = static_cast<short>(pixel + 1);
+  }
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(bufferedRegion))
+  {
+    const int increment = region.IsInside(index) ? 1 : 0;
+    ASSERT_EQ(brickedImage->GetPixel(index), denseImage->GetPixel(index) + increment) << index;
+  }
+
+  // The range can be passed to the Standard C++ algorithms.
+  auto denseRange = itk::ImageRegionRange<DenseImageType>(*denseImage, region);
+  EXPECT_EQ(std::count(range.begin(), range.end(), short{ 1 }), std::count(denseRange.begin(), denseRange.end(), 0));
+  EXPECT_TRUE(itk::BrickedImageRegionRange<BrickedImageType>().empty());
+}
+
+
+TEST(BrickedImage, SharesTheBricksOfAGraftedImage)
+{
+  const auto image = CreateImage<BrickedImageType>();
+  image->SetPixel({ { 1, 2, 3 } }, 5);
+
+  const auto grafted = BrickedImageType::New();
+  grafted->Graft(image);
+  EXPECT_EQ(grafted->GetBufferedRegion(), bufferedRegion);
+  EXPECT_EQ(grafted->GetPixel({ { 1, 2, 3 } }), 5);
+  grafted->SetPixel({ { 2, 2, 3 } }, 6);
+  EXPECT_EQ(image->GetPixel({ { 2, 2, 3 } }), 6);
+  EXPECT_EQ(image->GetNumberOfAllocatedBricks(), 1u);
+
+  // Initialize releases the bricks of the image, not the ones of the grafted image.
+  grafted->Initialize();
+  EXPECT_EQ(grafted->GetNumberOfBricks(), 0u);
+  EXPECT_EQ(image->GetPixel({ { 2, 2, 3 } }), 6);
+}
+
+
+TEST(BrickedImage, CountsTheBricksAllocatedConcurrently)
+{
+  const auto image = CreateImage<BrickedImageType>();
+
+  // Sets one pixel of every brick, each brick in its own work unit.
+  const auto                         multiThreader = itk::MultiThreaderBase::New();
+  const itk::SizeValueType           numberOfBricks = image->GetNumberOfBricks();
+  const BrickedImageType::SizeType & gridSize = image->GetBrickGridSize();
+  multiThreader->SetNumberOfWorkUnits(static_cast<itk::ThreadIdType>(numberOfBricks));
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfBricks,
+    [&image, &gridSize](itk::SizeValueType brickNumber) {
+      BrickedImageType::IndexType index = bufferedRegion.GetIndex();
+      for (unsigned int d = 0; d < Dimension; ++d)
+      {
+        index[d] += static_cast<itk::IndexValueType>(8 * (brickNumber % gridSize[d]));
+        brickNumber /= gridSize[d];
+      }
+      image->SetPixel(index, 1);
+    },
+    nullptr);
+  EXPECT_EQ(image->GetNumberOfAllocatedBricks(), numberOfBricks);
+}
@@ -0,0 +1,165 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkDomainThreader.h"
+
+#include "itkImage.h"
+#include "itkIndexRange.h"
+#include "itkThreadedImageRegionPartitioner.h"
+#include "itkThreadedIndexedContainerPartitioner.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+
+namespace
+{
+// Counts how often each element of the domain is processed, and sums the
+// elements per work unit, the way a metric accumulates per thread.
+template <typename TDomainPartitioner>
+class CountingDomainThreader : public itk::DomainThreader<TDomainPartitioner, void>
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(CountingDomainThreader);
+
+  using Self = CountingDomainThreader;
+  using Superclass = itk::DomainThreader<TDomainPartitioner, void>;
+  using Pointer = itk::SmartPointer<Self>;
+  using DomainType = typename Superclass::DomainType;
+
+  itkNewMacro(Self);
+
+  std::vector<std::atomic<int>> m_Counts;
+  std::vector<double>           m_SumPerWorkUnit;
+  std::atomic<int>              m_NumberOfCalls{ 0 };
+  std::atomic<bool>             m_IsThreadIdValid{ true };
+
+protected:
+  CountingDomainThreader() = default;
+
+private:
+  void
+  BeforeThreadedExecution() override
+  {
+    m_SumPerWorkUnit.assign(this->GetNumberOfWorkUnitsUsed(), 0.0);
+    m_NumberOfCalls = 0;
+  }
+
+  void
+  ThreadedExecution(const DomainType & subdomain, const itk::ThreadIdType threadId) override
+  {
+    ++m_NumberOfCalls;
+    if (threadId >= this->GetNumberOfWorkUnitsUsed())
+    {
+      m_IsThreadIdValid = false;
+      return;
+    }
+    this->ProcessSubdomain(subdomain, threadId);
+  }
+
+  void
+  ProcessSubdomain(const itk::ImageRegion<2> & region, const itk::ThreadIdType threadId)
+  {
+    for (const auto & index : itk::ImageRegionIndexRange<2>(region))
+    {
+      const auto element = static_cast<std::size_t>(index[1] * 100 + index[0]);
+      ++m_Counts[element];
+      m_SumPerWorkUnit[threadId] += static_cast<double>(element);
+    }
+  }
+
+  void
+  ProcessSubdomain(const itk::Index<2> & indexRange, const itk::ThreadIdType threadId)
+  {
+    for (itk::IndexValueType element = indexRange[0]; element <= indexRange[1]; ++element)
+    {
+      ++m_Counts[static_cast<std::size_t>(element)];
+      m_SumPerWorkUnit[threadId] += static_cast<double>(element);
+    }
+  }
+};
+
+
+template <typename TThreader>
+void
+ExpectEachElementProcessedOnce(TThreader & threader, const std::size_t numberOfElements)
+{
+  const double expectedSum = 0.5 * static_cast<double>(numberOfElements) * static_cast<double>(numberOfElements - 1);
+  EXPECT_TRUE(threader.m_IsThreadIdValid);
+  EXPECT_EQ(std::accumulate(threader.m_SumPerWorkUnit.cbegin(), threader.m_SumPerWorkUnit.cend(), 0.0), expectedSum);
+  for (std::size_t element = 0; element < numberOfElements; ++element)
+  {
+    ASSERT_EQ(threader.m_Counts[element], 1) << element;
+    threader.m_Counts[element] = 0;
+  }
+}
+} // namespace
+
+
+TEST(DomainThreader, ProcessesIndexedContainerInGrains)
+{
+  using ThreaderType = CountingDomainThreader<itk::ThreadedIndexedContainerPartitioner>;
+  constexpr std::size_t numberOfElements = 10000;
+
+  const auto threader = ThreaderType::New();
+  threader->m_Counts = std::vector<std::atomic<int>>(numberOfElements);
+  threader->SetMaximumNumberOfThreads(4);
+  threader->SetNumberOfWorkUnits(4);
+  EXPECT_EQ(threader->GetGrainSize(), 0u);
+
+  const ThreaderType::DomainType domain{ { 0, numberOfElements - 1 } };
+  threader->Execute(nullptr, domain);
+  EXPECT_EQ(threader->GetNumberOfSubdomainsUsed(), threader->GetNumberOfWorkUnitsUsed());
+  EXPECT_EQ(threader->m_NumberOfCalls, static_cast<int>(threader->GetNumberOfWorkUnitsUsed()));
+  ExpectEachElementProcessedOnce(*threader, numberOfElements);
+
+  threader->SetGrainSize(64);
+  threader->Execute(nullptr, domain);
+  EXPECT_EQ(threader->GetNumberOfSubdomainsUsed(), (numberOfElements + 63) / 64);
+  EXPECT_LE(threader->GetNumberOfWorkUnitsUsed(), 4u);
+  EXPECT_EQ(threader->m_NumberOfCalls, static_cast<int>(threader->GetNumberOfSubdomainsUsed()));
+  ExpectEachElementProcessedOnce(*threader, numberOfElements);
+
+  // A grain larger than the domain still gives each work unit a subdomain.
+  threader->SetGrainSize(numberOfElements * 2);
+  threader->Execute(nullptr, domain);
+  EXPECT_EQ(threader->GetNumberOfSubdomainsUsed(), threader->GetNumberOfWorkUnitsUsed());
+  ExpectEachElementProcessedOnce(*threader, numberOfElements);
+}
+
+
+TEST(DomainThreader, ProcessesImageRegionInGrains)
+{
+  using ThreaderType = CountingDomainThreader<itk::ThreadedImageRegionPartitioner<2>>;
+  constexpr std::size_t numberOfElements = 100 * 80;
+
+  const auto threader = ThreaderType::New();
+  threader->m_Counts = std::vector<std::atomic<int>>(numberOfElements);
+  threader->SetMaximumNumberOfThreads(3);
+  threader->SetNumberOfWorkUnits(3);
+  threader->SetGrainSize(500);
+
+  const ThreaderType::DomainType domain({ { 0, 0 } }, { { 100, 80 } });
+  threader->Execute(nullptr, domain);
+  EXPECT_GT(threader->GetNumberOfSubdomainsUsed(), threader->GetNumberOfWorkUnitsUsed());
+  EXPECT_EQ(threader->m_NumberOfCalls, static_cast<int>(threader->GetNumberOfSubdomainsUsed()));
+  ExpectEachElementProcessedOnce(*threader, numberOfElements);
+}
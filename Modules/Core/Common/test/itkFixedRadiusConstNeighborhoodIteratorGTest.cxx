@@ -0,0 +1,184 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkFixedRadiusConstNeighborhoodIterator.h"
+
+#include "itkConstNeighborhoodIterator.h"
+#include "itkDerivativeOperator.h"
+#include "itkFixedNeighborhoodAllocator.h"
+#include "itkImage.h"
+#include "itkIndexRange.h"
+#include "itkLaplacianOperator.h"
+#include "itkVectorImage.h"
+
+#include <gtest/gtest.h>
+
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using ImageType = itk::Image<int, Dimension>;
+using RegionType = ImageType::RegionType;
+
+ImageType::Pointer
+CreateImage(const RegionType & region)
+{
+  const auto image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  int value = 0;
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(region))
+  {
+    image->SetPixel(index, (value++ * 37) % 101 - 50);
+  }
+  return image;
+}
+
+
+// Checks that the iterator visits the pixels of the region in the same order
+// as ConstNeighborhoodIterator, with the same neighbors.
+template <unsigned int VRadius>
+void
+CheckSameNeighborsAsConstNeighborhoodIterator(const ImageType & image, const RegionType & region)
+{
+  using FixedIteratorType = itk::FixedRadiusConstNeighborhoodIterator<ImageType, VRadius>;
+  FixedIteratorType                         fixedIt(&image, region);
+  itk::ConstNeighborhoodIterator<ImageType> it(ImageType::SizeType::Filled(VRadius), &image, region);
+  itk::SizeValueType                        numberOfPixels = 0;
+  EXPECT_EQ(fixedIt.GetRegion(), region);
+
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it, ++fixedIt)
+  {
+    ASSERT_FALSE(fixedIt.IsAtEnd());
+    ASSERT_EQ(fixedIt.GetIndex(), it.GetIndex());
+    ASSERT_EQ(FixedIteratorType::NumberOfNeighbors, it.Size());
+    EXPECT_EQ(fixedIt.GetCenterPixel(), it.GetCenterPixel());
+    for (unsigned int n = 0; n < FixedIteratorType::NumberOfNeighbors; ++n)
+    {
+      EXPECT_EQ(fixedIt.GetPixel(n), it.GetPixel(n)) << "at " << it.GetIndex() << ", neighbor " << n;
+    }
+    ++numberOfPixels;
+  }
+  EXPECT_TRUE(fixedIt.IsAtEnd());
+  EXPECT_EQ(numberOfPixels, region.GetNumberOfPixels());
+}
+} // namespace
+
+
+TEST(FixedRadiusConstNeighborhoodIterator, HasCompileTimeNeighborhoodProperties)
+{
+  using IteratorType = itk::FixedRadiusConstNeighborhoodIterator<ImageType, 2>;
+  static_assert(IteratorType::Diameter == 5, "The diameter is 2 * radius + 1.");
+  static_assert(IteratorType::NumberOfNeighbors == 125, "The neighborhood holds diameter^dimension pixels.");
+  static_assert(IteratorType::CenterNeighborIndex == 62, "The center is in the middle of the neighborhood.");
+  static_assert(IteratorType::GetNeighborStride(2) == 25, "The neighbor stride is a power of the diameter.");
+  static_assert(IteratorType::GetNeighborOffset(0, 1) == -2, "The first neighbor is at minus the radius.");
+  static_assert(IteratorType::GetNeighborOffset(62, 0) == 0, "The center is at offset zero.");
+
+  itk::Neighborhood<int, Dimension> neighborhood;
+  neighborhood.SetRadius(ImageType::SizeType::Filled(2));
+  for (unsigned int n = 0; n < IteratorType::NumberOfNeighbors; ++n)
+  {
+    EXPECT_EQ(IteratorType::GetOffset(n), neighborhood.GetOffset(n));
+  }
+}
+
+
+TEST(FixedRadiusConstNeighborhoodIterator, VisitsTheSameNeighborsAsConstNeighborhoodIterator)
+{
+  const RegionType bufferedRegion({ { 3, -2, 5 } }, { { 17, 13, 9 } });
+  const auto       image = CreateImage(bufferedRegion);
+
+  CheckSameNeighborsAsConstNeighborhoodIterator<1>(*image, RegionType({ { 4, -1, 6 } }, { { 15, 11, 7 } }));
+  CheckSameNeighborsAsConstNeighborhoodIterator<2>(*image, RegionType({ { 6, 1, 7 } }, { { 3, 4, 2 } }));
+}
+
+
+TEST(FixedRadiusConstNeighborhoodIterator, SupportsEmptyRegions)
+{
+  const RegionType bufferedRegion({ { 0, 0, 0 } }, { { 5, 5, 5 } });
+  const auto       image = CreateImage(bufferedRegion);
+
+  itk::FixedRadiusConstNeighborhoodIterator<ImageType> it(image, RegionType({ { 1, 1, 1 } }, { { 3, 0, 3 } }));
+  EXPECT_TRUE(it.IsAtEnd());
+  it.GoToBegin();
+  EXPECT_TRUE(it.IsAtEnd());
+}
+
+
+TEST(FixedRadiusConstNeighborhoodIterator, SupportsVectorImages)
+{
+  using VectorImageType = itk::VectorImage<float, 2>;
+  const auto image = VectorImageType::New();
+  image->SetRegions(VectorImageType::SizeType{ { 6, 5 } });
+  image->SetNumberOfComponentsPerPixel(2);
+  image->Allocate();
+  for (const auto & index : itk::ImageRegionIndexRange<2>(image->GetBufferedRegion()))
+  {
+    VectorImageType::PixelType pixel(2);
+    pixel[0] = static_cast<float>(index[0]);
+    pixel[1] = static_cast<float>(index[1]);
+    image->SetPixel(index, pixel);
+  }
+
+  const VectorImageType::RegionType                          region({ { 1, 1 } }, { { 4, 3 } });
+  itk::FixedRadiusConstNeighborhoodIterator<VectorImageType> it(image, region);
+  for (; !it.IsAtEnd(); ++it)
+  {
+    for (unsigned int n = 0; n < it.NumberOfNeighbors; ++n)
+    {
+      const auto pixel = it.GetPixel(n);
+      EXPECT_EQ(pixel[0], static_cast<float>(it.GetIndex()[0] + it.GetOffset(n)[0]));
+      EXPECT_EQ(pixel[1], static_cast<float>(it.GetIndex()[1] + it.GetOffset(n)[1]));
+    }
+  }
+}
+
+
+TEST(FixedNeighborhoodAllocator, HoldsTheSameOperatorsAsNeighborhoodAllocator)
+{
+  using AllocatorType = itk::FixedNeighborhoodAllocator<double, 27>;
+
+  itk::DerivativeOperator<double, Dimension>                derivative;
+  itk::DerivativeOperator<double, Dimension, AllocatorType> fixedDerivative;
+  itk::LaplacianOperator<double, Dimension>                 laplacian;
+  itk::LaplacianOperator<double, Dimension, AllocatorType>  fixedLaplacian;
+  const double                                              scalings[Dimension] = { 0.5, 2.0, 1.0 };
+  derivative.SetDirection(1);
+  fixedDerivative.SetDirection(1);
+  derivative.CreateDirectional();
+  fixedDerivative.CreateDirectional();
+  laplacian.SetDerivativeScalings(scalings);
+  fixedLaplacian.SetDerivativeScalings(scalings);
+  laplacian.CreateOperator();
+  fixedLaplacian.CreateOperator();
+
+  ASSERT_EQ(fixedDerivative.Size(), derivative.Size());
+  ASSERT_EQ(fixedLaplacian.Size(), laplacian.Size());
+  EXPECT_TRUE(std::equal(derivative.Begin(), derivative.End(), fixedDerivative.Begin()));
+  EXPECT_TRUE(std::equal(laplacian.Begin(), laplacian.End(), fixedLaplacian.Begin()));
+
+  // Copies are equal to the original.
+  const auto copy = fixedLaplacian;
+  EXPECT_EQ(copy, fixedLaplacian);
+
+  // A neighborhood cannot be larger than the capacity of the allocator.
+  itk::Neighborhood<double, Dimension, AllocatorType> neighborhood;
+  EXPECT_THROW(neighborhood.SetRadius(2), itk::ExceptionObject);
+}
@@ -0,0 +1,182 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkFloat16.h"
+
+#include "itkImage.h"
+#include "itkImageAlgorithm.h"
+#include "itkIndexRange.h"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+
+namespace
+{
+bool
+IsNaN(const itk::Float16 value)
+{
+  return (value.GetBits() & 0x7c00u) == 0x7c00u && (value.GetBits() & 0x03ffu) != 0;
+}
+} // namespace
+
+
+TEST(Float16, ConvertsEveryValueToFloatAndBack)
+{
+  for (unsigned int bits = 0; bits <= 0xffffu; ++bits)
+  {
+    const auto  value = itk::Float16::FromBits(static_cast<itk::Float16::BitsType>(bits));
+    const float asFloat = value;
+    if (IsNaN(value))
+    {
+      EXPECT_TRUE(std::isnan(asFloat)) << bits;
+      EXPECT_TRUE(IsNaN(itk::Float16(asFloat))) << bits;
+    }
+    else
+    {
+      EXPECT_EQ(itk::Float16(asFloat).GetBits(), bits) << asFloat;
+    }
+  }
+}
+
+
+TEST(Float16, HasTheValuesOfBinary16)
+{
+  EXPECT_EQ(static_cast<float>(itk::Float16::FromBits(0x3c00)), 1.0f);
+  EXPECT_EQ(static_cast<float>(itk::Float16::FromBits(0xc000)), -2.0f);
+  EXPECT_EQ(static_cast<float>(itk::Float16::FromBits(0x3555)), 0.333251953125f);
+  EXPECT_EQ(static_cast<float>(itk::Float16::FromBits(0x0001)), std::ldexp(1.0f, -24));
+  EXPECT_EQ(static_cast<float>(itk::Float16::FromBits(0x03ff)), std::ldexp(1023.0f, -24));
+  EXPECT_EQ(static_cast<float>(itk::Float16::FromBits(0x8000)), 0.0f);
+  EXPECT_TRUE(std::signbit(static_cast<float>(itk::Float16::FromBits(0x8000))));
+
+  using LimitsType = std::numeric_limits<itk::Float16>;
+  EXPECT_EQ(static_cast<float>(LimitsType::max()), 65504.0f);
+  EXPECT_EQ(static_cast<float>(LimitsType::lowest()), -65504.0f);
+  EXPECT_EQ(static_cast<float>(LimitsType::min()), std::ldexp(1.0f, -14));
+  EXPECT_EQ(static_cast<float>(LimitsType::epsilon()), std::ldexp(1.0f, -10));
+  EXPECT_EQ(static_cast<float>(LimitsType::infinity()), std::numeric_limits<float>::infinity());
+  EXPECT_TRUE(std::isnan(static_cast<float>(LimitsType::quiet_NaN())));
+
+  EXPECT_EQ(static_cast<float>(itk::NumericTraits<itk::Float16>::ZeroValue()), 0.0f);
+  EXPECT_EQ(static_cast<float>(itk::NumericTraits<itk::Float16>::OneValue()), 1.0f);
+  EXPECT_EQ(static_cast<float>(itk::NumericTraits<itk::Float16>::max()), 65504.0f);
+  EXPECT_EQ(static_cast<float>(itk::NumericTraits<itk::Float16>::NonpositiveMin()), -65504.0f);
+  EXPECT_TRUE(itk::NumericTraits<itk::Float16>::IsNegative(itk::Float16(-0.5f)));
+}
+
+
+TEST(Float16, RoundsToNearestEven)
+{
+  // Checks the rounding at, and just around, the midpoint between every pair
+  // of consecutive finite Float16 values.
+  for (unsigned int bits = 0; bits < 0x7bffu; ++bits)
+  {
+    const float lower = itk::Float16::FromBits(static_cast<itk::Float16::BitsType>(bits));
+    const float upper = itk::Float16::FromBits(static_cast<itk::Float16::BitsType>(bits + 1));
+    const float midpoint = (lower + upper) / 2.0f;
+    const auto  even = static_cast<itk::Float16::BitsType>((bits % 2 == 0) ? bits : bits + 1);
+
+    ASSERT_EQ(itk::Float16(midpoint).GetBits(), even) << midpoint;
+    ASSERT_EQ(itk::Float16(-midpoint).GetBits(), even | 0x8000u) << -midpoint;
+    ASSERT_EQ(itk::Float16(std::nextafter(midpoint, 0.0f)).GetBits(), bits) << midpoint;
+    ASSERT_EQ(itk::Float16(std::nextafter(midpoint, upper)).GetBits(), bits + 1) << midpoint;
+  }
+
+  // Beyond the largest value, the values round to infinity.
+  EXPECT_EQ(itk::Float16(65519.0f).GetBits(), 0x7bffu);
+  EXPECT_EQ(itk::Float16(65520.0f).GetBits(), 0x7c00u);
+  EXPECT_EQ(itk::Float16(-1e10f).GetBits(), 0xfc00u);
+  EXPECT_EQ(itk::Float16(std::numeric_limits<float>::infinity()).GetBits(), 0x7c00u);
+
+  // Values smaller than half the smallest subnormal round to zero.
+  EXPECT_EQ(itk::Float16(std::ldexp(1.0f, -25)).GetBits(), 0x0000u);
+  EXPECT_EQ(itk::Float16(std::ldexp(1.5f, -25)).GetBits(), 0x0001u);
+  EXPECT_EQ(itk::Float16(-1e-30f).GetBits(), 0x8000u);
+}
+
+
+TEST(Float16, ConvertsBuffers)
+{
+  std::vector<float> values;
+  for (int i = 0; i < 1003; ++i)
+  {
+    values.push_back(std::ldexp(static_cast<float>(i * 7919 % 2003) - 1001.37f, i % 41 - 25));
+  }
+  values.push_back(std::numeric_limits<float>::infinity());
+  values.push_back(1e6f);
+
+  std::vector<itk::Float16> halfs(values.size());
+  itk::Float16::ConvertFromFloat(values.data(), halfs.data(), values.size());
+  std::vector<float> roundTrip(values.size());
+  itk::Float16::ConvertToFloat(halfs.data(), roundTrip.data(), halfs.size());
+
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    EXPECT_EQ(halfs[i].GetBits(), itk::Float16(values[i]).GetBits()) << values[i];
+    EXPECT_EQ(roundTrip[i], static_cast<float>(halfs[i])) << values[i];
+  }
+}
+
+
+TEST(Float16, IsComputedInSinglePrecision)
+{
+  itk::Float16 value(1.5f);
+  value += 2.0f;
+  value *= 2.0f;
+  EXPECT_EQ(static_cast<float>(value), 7.0f);
+  EXPECT_EQ(value * value + 1.0f, 50.0f);
+  EXPECT_TRUE(value > 6.5f);
+  EXPECT_EQ(itk::Float16(1.0f) + itk::Float16(std::ldexp(1.0f, -11)), 1.0f + std::ldexp(1.0f, -11));
+}
+
+
+TEST(Float16, IsCopiedToAndFromFloatImages)
+{
+  using HalfImageType = itk::Image<itk::Float16, 2>;
+  using FloatImageType = itk::Image<float, 2>;
+
+  const HalfImageType::RegionType region({ { 0, 0 } }, { { 37, 5 } });
+  const auto                      floatImage = FloatImageType::New();
+  floatImage->SetRegions(region);
+  floatImage->Allocate();
+  for (const auto & index : itk::ImageRegionIndexRange<2>(region))
+  {
+    floatImage->SetPixel(index, 0.1f * static_cast<float>(index[0] - 3 * index[1]));
+  }
+
+  const auto halfImage = HalfImageType::New();
+  halfImage->SetRegions(region);
+  halfImage->Allocate(true);
+  const auto copiedImage = FloatImageType::New();
+  copiedImage->SetRegions(region);
+  copiedImage->Allocate(true);
+
+  const HalfImageType::RegionType copiedRegion({ { 2, 1 } }, { { 30, 3 } });
+  itk::ImageAlgorithm::Copy(floatImage.GetPointer(), halfImage.GetPointer(), copiedRegion, copiedRegion);
+  itk::ImageAlgorithm::Copy(halfImage.GetPointer(), copiedImage.GetPointer(), region, region);
+
+  for (const auto & index : itk::ImageRegionIndexRange<2>(region))
+  {
+    const float expected =
+      copiedRegion.IsInside(index) ? static_cast<float>(itk::Float16(floatImage->GetPixel(index))) : 0.0f;
+    EXPECT_EQ(copiedImage->GetPixel(index), expected) << index;
+  }
+}
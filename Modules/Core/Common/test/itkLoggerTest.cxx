@@ -163,7 +163,8 @@ itkLoggerTest(int argc, char * argv[])
                                                            itk::IOComponentEnum::ULONGLONG,
                                                            itk::IOComponentEnum::FLOAT,
                                                            itk::IOComponentEnum::DOUBLE,
-                                                           itk::IOComponentEnum::LDOUBLE };
+                                                           itk::IOComponentEnum::LDOUBLE,
+                                                           itk::IOComponentEnum::FLOAT16 };
   for (const auto & ee : allIOComponentEnum)
   {
     std::cout << "STREAMED ENUM VALUE IOComponentEnum: " << ee << std::endl;
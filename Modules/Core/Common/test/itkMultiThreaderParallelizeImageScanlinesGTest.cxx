@@ -0,0 +1,209 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkMultiThreaderBase.h"
+
+#include "itkImage.h"
+#include "itkImageAdaptor.h"
+#include "itkIndexRange.h"
+#include "itkUnaryFunctorImageFilter.h"
+#include "itkVectorImage.h"
+
+#include <gtest/gtest.h>
+#include <type_traits> // For std::is_same.
+
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using ImageType = itk::Image<short, Dimension>;
+using FloatImageType = itk::Image<float, Dimension>;
+using VectorImageType = itk::VectorImage<float, Dimension>;
+using RegionType = ImageType::RegionType;
+
+template <typename TImage>
+typename TImage::Pointer
+CreateImage(const RegionType & region)
+{
+  const auto image = TImage::New();
+  image->SetRegions(region);
+  image->Allocate(true);
+  return image;
+}
+
+
+ImageType::Pointer
+CreateRampImage(const RegionType & region)
+{
+  const auto image = CreateImage<ImageType>(region);
+  short      value = 0;
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(region))
+  {
+    image->SetPixel(index, static_cast<short>((value++ * 37) % 101 - 50));
+  }
+  return image;
+}
+
+
+// Pixel accessor that negates the pixels, so that image adaptors do not have
+// pixel scanlines.
+class NegateAccessor
+{
+public:
+  using InternalType = short;
+  using ExternalType = short;
+
+  static ExternalType
+  Get(const InternalType & input)
+  {
+    return static_cast<ExternalType>(-input);
+  }
+};
+
+
+// Functor that doubles the pixels.
+class DoubleFunctor
+{
+public:
+  float
+  operator()(const short pixel) const
+  {
+    return 2.0f * pixel;
+  }
+
+  bool
+  operator!=(const DoubleFunctor &) const
+  {
+    return false;
+  }
+};
+} // namespace
+
+
+TEST(MultiThreaderParallelizeImageScanlines, TellsWhichImagesHavePixelScanlines)
+{
+  static_assert(itk::MultiThreaderBase::HasPixelScanlines<ImageType>(), "Image has pixel scanlines.");
+  static_assert(itk::MultiThreaderBase::HasPixelScanlines<const ImageType>(), "Const images are supported.");
+  static_assert(!itk::MultiThreaderBase::HasPixelScanlines<VectorImageType>(),
+                "VectorImage only has scanlines of components.");
+  static_assert(!itk::MultiThreaderBase::HasPixelScanlines<itk::ImageAdaptor<ImageType, NegateAccessor>>(),
+                "The pixels of an image adaptor go through its accessor.");
+}
+
+
+TEST(MultiThreaderParallelizeImageScanlines, ProcessesEachPixelOnce)
+{
+  const RegionType bufferedRegion({ { 3, -2, 5 } }, { { 17, 13, 9 } });
+  const auto       input = CreateRampImage(bufferedRegion);
+  const auto       output = CreateImage<FloatImageType>(bufferedRegion);
+  const auto       visits = CreateImage<ImageType>(bufferedRegion);
+
+  for (const RegionType & requestedRegion :
+       { bufferedRegion, RegionType({ { 4, 2, 5 } }, { { 12, 9, 4 } }), RegionType({ { 4, 2, 5 } }, { { 1, 9, 0 } }) })
+  {
+    output->FillBuffer(0.0f);
+    visits->FillBuffer(0);
+
+    const auto        multiThreader = itk::MultiThreaderBase::New();
+    const ImageType & constInput = *input;
+    multiThreader->SetNumberOfWorkUnits(4);
+    multiThreader->ParallelizeImageScanlines(
+      requestedRegion,
+      [](itk::SizeValueType numberOfPixels, float * outputPixels, const short * inputPixels, short * visitCounts) {
+        for (itk::SizeValueType i = 0; i < numberOfPixels; ++i)
+        {
+          outputPixels[i] = 0.5f * inputPixels[i];
+          ++visitCounts[i];
+        }
+      },
+      nullptr,
+      *output,
+      constInput,
+      *visits);
+
+    for (const auto & index : itk::ImageRegionIndexRange<Dimension>(bufferedRegion))
+    {
+      const bool isRequested = requestedRegion.IsInside(index);
+      EXPECT_EQ(visits->GetPixel(index), isRequested ? 1 : 0) << "at " << index;
+      EXPECT_EQ(output->GetPixel(index), isRequested ? 0.5f * input->GetPixel(index) : 0.0f) << "at " << index;
+    }
+  }
+}
+
+
+TEST(MultiThreaderParallelizeImageScanlines, PassesScanlinesOfComponentsForVectorImages)
+{
+  constexpr unsigned int numberOfComponents = 3;
+  const RegionType       bufferedRegion({ { 0, 0, 0 } }, { { 7, 6, 5 } });
+  const RegionType       requestedRegion({ { 2, 1, 1 } }, { { 4, 3, 2 } });
+  const auto             image = VectorImageType::New();
+  image->SetRegions(bufferedRegion);
+  image->SetNumberOfComponentsPerPixel(numberOfComponents);
+  image->Allocate(true);
+  const auto input = CreateRampImage(bufferedRegion);
+
+  itk::MultiThreaderBase::ProcessImageScanlines(
+    requestedRegion,
+    [](itk::SizeValueType numberOfPixels, float * components, const short * inputPixels) {
+      for (itk::SizeValueType i = 0; i < numberOfPixels; ++i)
+      {
+        for (unsigned int c = 0; c < numberOfComponents; ++c)
+        {
+          components[i * numberOfComponents + c] = static_cast<float>(inputPixels[i] + c);
+        }
+      }
+    },
+    *image,
+    *input);
+
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(bufferedRegion))
+  {
+    const VectorImageType::PixelType pixel = image->GetPixel(index);
+    for (unsigned int c = 0; c < numberOfComponents; ++c)
+    {
+      EXPECT_EQ(pixel[c], requestedRegion.IsInside(index) ? static_cast<float>(input->GetPixel(index) + c) : 0.0f)
+        << "at " << index;
+    }
+  }
+}
+
+
+TEST(MultiThreaderParallelizeImageScanlines, UnaryFunctorImageFilterGivesTheSameResultWithAndWithoutScanlines)
+{
+  const RegionType bufferedRegion({ { 1, 2, 3 } }, { { 31, 7, 5 } });
+  const auto       input = CreateRampImage(bufferedRegion);
+
+  using AdaptorType = itk::ImageAdaptor<ImageType, NegateAccessor>;
+  const auto adaptor = AdaptorType::New();
+  adaptor->SetImage(input);
+
+  const auto filter = itk::UnaryFunctorImageFilter<ImageType, FloatImageType, DoubleFunctor>::New();
+  filter->SetInput(input);
+  filter->Update();
+
+  const auto adaptorFilter = itk::UnaryFunctorImageFilter<AdaptorType, FloatImageType, DoubleFunctor>::New();
+  adaptorFilter->SetInput(adaptor);
+  adaptorFilter->Update();
+
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(bufferedRegion))
+  {
+    EXPECT_EQ(filter->GetOutput()->GetPixel(index), 2.0f * input->GetPixel(index)) << "at " << index;
+    EXPECT_EQ(adaptorFilter->GetOutput()->GetPixel(index), -2.0f * input->GetPixel(index)) << "at " << index;
+  }
+}
@@ -0,0 +1,233 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkMultiThreaderBase.h"
+
+#include "itkConstantBoundaryImageNeighborhoodPixelAccessPolicy.h"
+#include "itkImage.h"
+#include "itkImageNeighborhoodOffsets.h"
+#include "itkIndexRange.h"
+
+#include <gtest/gtest.h>
+#include <type_traits> // For std::is_same.
+#include <vector>
+
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using ImageType = itk::Image<int, Dimension>;
+using RegionType = ImageType::RegionType;
+using OffsetsType = std::vector<itk::Offset<Dimension>>;
+
+// Sums the pixels of the neighborhoods, and counts the visits of the pixels
+// by the interior range (1) and by the boundary ranges (1000).
+class SumKernel
+{
+public:
+  SumKernel(ImageType & sums, ImageType & visits)
+    : m_Sums(sums)
+    , m_Visits(visits)
+  {}
+
+  template <typename TNeighborhoodRange>
+  void
+  operator()(const RegionType & region, TNeighborhoodRange & neighborhoodRange) const
+  {
+    using InteriorRangeType =
+      itk::ShapedImageNeighborhoodRange<const ImageType, itk::BufferedImageNeighborhoodPixelAccessPolicy<ImageType>>;
+    const int visit = std::is_same<TNeighborhoodRange, InteriorRangeType>::value ? 1 : 1000;
+
+    for (const auto & index : itk::ImageRegionIndexRange<Dimension>(region))
+    {
+      neighborhoodRange.SetLocation(index);
+      int sum = 0;
+      for (const int pixel : neighborhoodRange)
+      {
+        sum += pixel;
+      }
+      m_Sums.SetPixel(index, sum);
+      m_Visits.SetPixel(index, m_Visits.GetPixel(index) + visit);
+    }
+  }
+
+private:
+  ImageType & m_Sums;
+  ImageType & m_Visits;
+};
+
+
+ImageType::Pointer
+CreateImage(const RegionType & region)
+{
+  const auto image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate(true);
+  int value = 0;
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(region))
+  {
+    image->SetPixel(index, (value++ * 37) % 101 - 50);
+  }
+  return image;
+}
+
+
+// Sums the pixels of the neighborhoods with the specified policy over the
+// whole region, in the calling thread.
+template <typename TPixelAccessPolicy>
+ImageType::Pointer
+ComputeExpectedSums(const ImageType & image, const RegionType & region, const OffsetsType & offsets)
+{
+  const auto sums = CreateImage(image.GetBufferedRegion());
+  auto neighborhoodRange =
+    itk::ShapedImageNeighborhoodRange<const ImageType, TPixelAccessPolicy>(image, region.GetIndex(), offsets);
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(region))
+  {
+    neighborhoodRange.SetLocation(index);
+    int sum = 0;
+    for (const int pixel : neighborhoodRange)
+    {
+      sum += pixel;
+    }
+    sums->SetPixel(index, sum);
+  }
+  return sums;
+}
+
+
+// Tells whether the neighborhood of the pixel lies inside the buffered region.
+bool
+IsInterior(const ImageType & image, const ImageType::IndexType & index, const OffsetsType & offsets)
+{
+  for (const auto & offset : offsets)
+  {
+    if (!image.GetBufferedRegion().IsInside(index + offset))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+template <template <typename> class TBoundaryPixelAccessPolicy = itk::ZeroFluxNeumannImageNeighborhoodPixelAccessPolicy>
+void
+CheckParallelizeNeighborhood(const RegionType &  bufferedRegion,
+                             const RegionType &  requestedRegion,
+                             const OffsetsType & offsets)
+{
+  const ImageType::Pointer image = CreateImage(bufferedRegion);
+  const ImageType::Pointer expectedSums =
+    ComputeExpectedSums<TBoundaryPixelAccessPolicy<ImageType>>(*image, requestedRegion, offsets);
+  const ImageType::Pointer sums = CreateImage(bufferedRegion);
+  const ImageType::Pointer visits = ImageType::New();
+  visits->SetRegions(bufferedRegion);
+  visits->Allocate(true);
+
+  const auto multiThreader = itk::MultiThreaderBase::New();
+  multiThreader->SetNumberOfWorkUnits(4);
+  const ImageType & constImage = *image;
+  multiThreader->ParallelizeNeighborhood<TBoundaryPixelAccessPolicy>(
+    constImage, requestedRegion, offsets, SumKernel(*sums, *visits), nullptr);
+
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(bufferedRegion))
+  {
+    if (requestedRegion.IsInside(index))
+    {
+      EXPECT_EQ(sums->GetPixel(index), expectedSums->GetPixel(index)) << "at " << index;
+      EXPECT_EQ(visits->GetPixel(index), IsInterior(*image, index, offsets) ? 1 : 1000) << "at " << index;
+    }
+    else
+    {
+      EXPECT_EQ(visits->GetPixel(index), 0) << "at " << index;
+    }
+  }
+}
+} // namespace
+
+
+TEST(MultiThreaderParallelizeNeighborhood, ProcessesEachPixelOnceWithTheRightPolicy)
+{
+  const RegionType     bufferedRegion({ { 3, -2, 5 } }, { { 17, 13, 9 } });
+  itk::Size<Dimension> radius;
+  radius[0] = 2;
+  radius[1] = 1;
+  radius[2] = 3;
+  const OffsetsType offsets = itk::GenerateRectangularImageNeighborhoodOffsets(radius);
+
+  CheckParallelizeNeighborhood(bufferedRegion, bufferedRegion, offsets);
+
+  const RegionType requestedRegion({ { 4, 2, 5 } }, { { 12, 9, 4 } });
+  CheckParallelizeNeighborhood(bufferedRegion, requestedRegion, offsets);
+}
+
+
+TEST(MultiThreaderParallelizeNeighborhood, SupportsNeighborhoodsLargerThanTheImage)
+{
+  const RegionType     bufferedRegion({ { 0, 0, 0 } }, { { 4, 3, 6 } });
+  itk::Size<Dimension> radius;
+  radius[0] = 3;
+  radius[1] = 2;
+  radius[2] = 1;
+
+  CheckParallelizeNeighborhood(bufferedRegion, bufferedRegion, itk::GenerateRectangularImageNeighborhoodOffsets(radius));
+}
+
+
+TEST(MultiThreaderParallelizeNeighborhood, SupportsAsymmetricShapes)
+{
+  const RegionType  bufferedRegion({ { 1, 1, 1 } }, { { 11, 10, 7 } });
+  const OffsetsType offsets = { { { 0, 0, 0 } }, { { 2, 0, 0 } }, { { 0, -1, 0 } }, { { 0, -1, 3 } } };
+
+  CheckParallelizeNeighborhood(bufferedRegion, bufferedRegion, offsets);
+}
+
+
+TEST(MultiThreaderParallelizeNeighborhood, SupportsOtherBoundaryPolicies)
+{
+  const RegionType     bufferedRegion({ { 0, 0, 0 } }, { { 9, 8, 7 } });
+  itk::Size<Dimension> radius;
+  radius.Fill(1);
+
+  CheckParallelizeNeighborhood<itk::ConstantBoundaryImageNeighborhoodPixelAccessPolicy>(
+    bufferedRegion, bufferedRegion, itk::GenerateRectangularImageNeighborhoodOffsets(radius));
+}
+
+
+TEST(MultiThreaderParallelizeNeighborhood, SupportsRadiusOverload)
+{
+  const RegionType     bufferedRegion({ { 0, 0, 0 } }, { { 10, 9, 8 } });
+  const auto           image = CreateImage(bufferedRegion);
+  const auto           sums = CreateImage(bufferedRegion);
+  const auto           visits = CreateImage(bufferedRegion);
+  itk::Size<Dimension> radius;
+  radius.Fill(1);
+  visits->FillBuffer(0);
+
+  const auto multiThreader = itk::MultiThreaderBase::New();
+  multiThreader->ParallelizeNeighborhood(*image, bufferedRegion, radius, SumKernel(*sums, *visits), nullptr);
+
+  using PolicyType = itk::ZeroFluxNeumannImageNeighborhoodPixelAccessPolicy<ImageType>;
+  const OffsetsType offsets = itk::GenerateRectangularImageNeighborhoodOffsets(radius);
+  const auto        expectedSums = ComputeExpectedSums<PolicyType>(*image, bufferedRegion, offsets);
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(bufferedRegion))
+  {
+    EXPECT_EQ(sums->GetPixel(index), expectedSums->GetPixel(index)) << "at " << index;
+  }
+}
@@ -0,0 +1,326 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header files to be tested:
+#include "itkPackedBinaryImage.h"
+#include "itkPackedBinaryImageAlgorithm.h"
+
+#include "itkImage.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
+
+#include <gtest/gtest.h>
+#include <deque>
+
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using PackedImageType = itk::PackedBinaryImage<Dimension>;
+using ImageType = itk::Image<unsigned char, Dimension>;
+using LabelImageType = itk::Image<unsigned int, Dimension>;
+using Algorithm = itk::PackedBinaryImageAlgorithm;
+
+
+// Multithreader shared by the calls, as a filter shares its own. The calls
+// without it run in the calling thread.
+itk::MultiThreaderBase *
+GetMultiThreader()
+{
+  static const itk::MultiThreaderBase::Pointer multiThreader = itk::MultiThreaderBase::New();
+  return multiThreader.GetPointer();
+}
+
+
+// Creates a random binary image whose rows do not end on a word boundary.
+ImageType::Pointer
+CreateRandomImage(unsigned int seed, unsigned int percentage)
+{
+  const auto                  image = ImageType::New();
+  const ImageType::IndexType  start = { { -3, 2, 1 } };
+  const ImageType::SizeType   size = { { 131, 9, 7 } };
+  const ImageType::RegionType region(start, size);
+  image->SetRegions(region);
+  image->Allocate();
+
+  for (itk::ImageRegionIterator<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    seed = seed * 1103515245u + 12345u;
+    it.Set(((seed >> 8) % 100 < percentage) ? 255 : 0);
+  }
+  return image;
+}
+
+
+PackedImageType::Pointer
+Pack(const ImageType * image)
+{
+  const auto packedImage = PackedImageType::New();
+  Algorithm::ConvertFromImage(image, 255, packedImage.GetPointer(), GetMultiThreader());
+  return packedImage;
+}
+
+
+ImageType::Pointer
+Unpack(const PackedImageType * packedImage)
+{
+  const auto image = ImageType::New();
+  Algorithm::ConvertToImage(packedImage, image.GetPointer(), 255, 0, GetMultiThreader());
+  return image;
+}
+
+
+template <typename TFunction>
+void
+ExpectEqualPixels(const ImageType * image, const PackedImageType * packedImage, const TFunction & expected)
+{
+  ASSERT_EQ(image->GetBufferedRegion(), packedImage->GetBufferedRegion());
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    ASSERT_EQ(packedImage->GetPixel(it.GetIndex()), expected(it.GetIndex())) << "at " << it.GetIndex();
+  }
+}
+
+
+// Reference labeling: flood fill from each unlabeled foreground pixel, in
+// raster order.
+unsigned int
+LabelNaively(const ImageType * image, bool fullyConnected, LabelImageType * output)
+{
+  const ImageType::RegionType & region = image->GetBufferedRegion();
+  output->SetRegions(region);
+  output->Allocate(true);
+
+  unsigned int numberOfObjects = 0;
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() == 0 || output->GetPixel(it.GetIndex()) != 0)
+    {
+      continue;
+    }
+    ++numberOfObjects;
+    std::deque<ImageType::IndexType> queue(1, it.GetIndex());
+    output->SetPixel(it.GetIndex(), numberOfObjects);
+    while (!queue.empty())
+    {
+      const ImageType::IndexType index = queue.front();
+      queue.pop_front();
+      for (int dz = -1; dz <= 1; ++dz)
+      {
+        for (int dy = -1; dy <= 1; ++dy)
+        {
+          for (int dx = -1; dx <= 1; ++dx)
+          {
+            const int numberOfNonZero = (dx != 0) + (dy != 0) + (dz != 0);
+            if (numberOfNonZero == 0 || (!fullyConnected && numberOfNonZero > 1))
+            {
+              continue;
+            }
+            const ImageType::IndexType neighbor = { { index[0] + dx, index[1] + dy, index[2] + dz } };
+            if (region.IsInside(neighbor) && image->GetPixel(neighbor) != 0 && output->GetPixel(neighbor) == 0)
+            {
+              output->SetPixel(neighbor, numberOfObjects);
+              queue.push_back(neighbor);
+            }
+          }
+        }
+      }
+    }
+  }
+  return numberOfObjects;
+}
+} // namespace
+
+
+TEST(PackedBinaryImage, Allocate)
+{
+  const auto                      packedImage = PackedImageType::New();
+  const PackedImageType::SizeType size = { { 65, 3, 2 } };
+  packedImage->SetRegions(size);
+  packedImage->Allocate();
+
+  EXPECT_EQ(packedImage->GetRowLength(), 65u);
+  EXPECT_EQ(packedImage->GetWordsPerRow(), 2u);
+  EXPECT_EQ(packedImage->GetNumberOfRows(), 6u);
+  EXPECT_EQ(Algorithm::CountForeground(packedImage.GetPointer()), 0u);
+
+  packedImage->FillBuffer(true);
+  EXPECT_EQ(Algorithm::CountForeground(packedImage.GetPointer()), 65u * 6u);
+
+  const PackedImageType::IndexType index = { { 64, 1, 1 } };
+  EXPECT_EQ(packedImage->ComputeRow(index), 4u);
+  EXPECT_EQ(packedImage->ComputeRowStartIndex(4)[1], 1);
+  EXPECT_EQ(packedImage->ComputeRowStartIndex(4)[2], 1);
+  packedImage->SetPixel(index, false);
+  EXPECT_FALSE(packedImage->GetPixel(index));
+  EXPECT_EQ(Algorithm::CountForeground(packedImage.GetPointer()), 65u * 6u - 1u);
+}
+
+
+TEST(PackedBinaryImage, ConvertsFromAndToImage)
+{
+  const ImageType::Pointer       image = CreateRandomImage(1, 40);
+  const PackedImageType::Pointer packedImage = Pack(image);
+
+  ExpectEqualPixels(image, packedImage, [&image](const ImageType::IndexType & index) {
+    return image->GetPixel(index) == 255;
+  });
+
+  const ImageType::Pointer unpackedImage = Unpack(packedImage);
+  EXPECT_EQ(unpackedImage->GetBufferedRegion(), image->GetBufferedRegion());
+  itk::SizeValueType numberOfForegroundPixels = 0;
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    ASSERT_EQ(unpackedImage->GetPixel(it.GetIndex()), it.Get());
+    numberOfForegroundPixels += (it.Get() == 255);
+  }
+  EXPECT_EQ(Algorithm::CountForeground(packedImage.GetPointer()), numberOfForegroundPixels);
+  EXPECT_EQ(Algorithm::CountForeground(packedImage.GetPointer(), GetMultiThreader()), numberOfForegroundPixels);
+}
+
+
+TEST(PackedBinaryImage, Graft)
+{
+  const ImageType::Pointer       image = CreateRandomImage(1, 40);
+  const PackedImageType::Pointer packedImage = Pack(image);
+
+  const auto grafted = PackedImageType::New();
+  grafted->Graft(packedImage);
+  EXPECT_EQ(grafted->GetBufferedRegion(), packedImage->GetBufferedRegion());
+  EXPECT_EQ(grafted->GetBufferPointer(), packedImage->GetBufferPointer());
+
+  // Through the DataObject interface.
+  const auto                    graftedData = PackedImageType::New();
+  const itk::DataObject * const data = packedImage.GetPointer();
+  static_cast<itk::DataObject *>(graftedData.GetPointer())->Graft(data);
+  EXPECT_EQ(graftedData->GetBufferPointer(), packedImage->GetBufferPointer());
+}
+
+
+TEST(PackedBinaryImage, ComputesLogicalOperations)
+{
+  const ImageType::Pointer       image1 = CreateRandomImage(1, 40);
+  const ImageType::Pointer       image2 = CreateRandomImage(2, 60);
+  const PackedImageType::Pointer packedImage1 = Pack(image1);
+  const PackedImageType::Pointer packedImage2 = Pack(image2);
+  const auto                     output = PackedImageType::New();
+
+  const auto value1 = [&image1](const ImageType::IndexType & index) { return image1->GetPixel(index) != 0; };
+  const auto value2 = [&image2](const ImageType::IndexType & index) { return image2->GetPixel(index) != 0; };
+
+  Algorithm::And(packedImage1.GetPointer(), packedImage2.GetPointer(), output.GetPointer(), GetMultiThreader());
+  ExpectEqualPixels(image1, output, [&](const ImageType::IndexType & index) { return value1(index) && value2(index); });
+
+  Algorithm::Or(packedImage1.GetPointer(), packedImage2.GetPointer(), output.GetPointer(), GetMultiThreader());
+  ExpectEqualPixels(image1, output, [&](const ImageType::IndexType & index) { return value1(index) || value2(index); });
+
+  Algorithm::Xor(packedImage1.GetPointer(), packedImage2.GetPointer(), output.GetPointer(), GetMultiThreader());
+  ExpectEqualPixels(image1, output, [&](const ImageType::IndexType & index) { return value1(index) != value2(index); });
+
+  Algorithm::AndNot(packedImage1.GetPointer(), packedImage2.GetPointer(), output.GetPointer(), GetMultiThreader());
+  ExpectEqualPixels(image1, output, [&](const ImageType::IndexType & index) { return value1(index) && !value2(index); });
+
+  // The padding bits of the complement must remain cleared.
+  Algorithm::Not(packedImage1.GetPointer(), output.GetPointer(), GetMultiThreader());
+  ExpectEqualPixels(image1, output, [&](const ImageType::IndexType & index) { return !value1(index); });
+  EXPECT_EQ(Algorithm::CountForeground(output.GetPointer()),
+            image1->GetBufferedRegion().GetNumberOfPixels() - Algorithm::CountForeground(packedImage1.GetPointer()));
+
+  // In place.
+  Algorithm::Not(packedImage1.GetPointer(), packedImage1.GetPointer());
+  ExpectEqualPixels(image1, packedImage1, [&](const ImageType::IndexType & index) { return !value1(index); });
+}
+
+
+TEST(PackedBinaryImage, DilatesAndErodesRows)
+{
+  const ImageType::Pointer       image = CreateRandomImage(3, 5);
+  const PackedImageType::Pointer packedImage = Pack(image);
+  const auto                     output = PackedImageType::New();
+
+  const itk::IndexValueType begin = image->GetBufferedRegion().GetIndex(0);
+  const itk::IndexValueType end = begin + static_cast<itk::IndexValueType>(image->GetBufferedRegion().GetSize(0));
+
+  for (const itk::SizeValueType radius : { 0, 1, 5, 31, 64, 70, 200 })
+  {
+    const auto expectedValue = [&](const ImageType::IndexType & index, bool erode) {
+      const auto radiusValue = static_cast<itk::IndexValueType>(radius);
+      for (itk::IndexValueType x = index[0] - radiusValue; x <= index[0] + radiusValue; ++x)
+      {
+        ImageType::IndexType neighbor = index;
+        neighbor[0] = x;
+        const bool value = (x >= begin && x < end) ? image->GetPixel(neighbor) != 0 : erode;
+        if (value != erode)
+        {
+          return !erode;
+        }
+      }
+      return erode;
+    };
+
+    Algorithm::DilateRows(packedImage.GetPointer(), radius, output.GetPointer(), GetMultiThreader());
+    ExpectEqualPixels(image, output, [&](const ImageType::IndexType & index) { return expectedValue(index, false); });
+
+    const PackedImageType::Pointer dilated = Pack(Unpack(output));
+    Algorithm::ErodeRows(dilated.GetPointer(), radius, output.GetPointer(), GetMultiThreader());
+    const ImageType::Pointer dilatedImage = Unpack(dilated);
+    ExpectEqualPixels(dilatedImage, output, [&](const ImageType::IndexType & index) {
+      const auto radiusValue = static_cast<itk::IndexValueType>(radius);
+      for (itk::IndexValueType x = index[0] - radiusValue; x <= index[0] + radiusValue; ++x)
+      {
+        ImageType::IndexType neighbor = index;
+        neighbor[0] = x;
+        if (x >= begin && x < end && dilatedImage->GetPixel(neighbor) == 0)
+        {
+          return false;
+        }
+      }
+      return true;
+    });
+  }
+}
+
+
+TEST(PackedBinaryImage, LabelsConnectedComponents)
+{
+  for (const unsigned int percentage : { 20, 45, 70 })
+  {
+    const ImageType::Pointer       image = CreateRandomImage(percentage, percentage);
+    const PackedImageType::Pointer packedImage = Pack(image);
+
+    for (const bool fullyConnected : { false, true })
+    {
+      const auto         expected = LabelImageType::New();
+      const unsigned int expectedNumberOfObjects = LabelNaively(image, fullyConnected, expected);
+
+      const auto labels = LabelImageType::New();
+      EXPECT_EQ(Algorithm::LabelConnectedComponents(
+                  packedImage.GetPointer(), fullyConnected, labels.GetPointer(), GetMultiThreader()),
+                expectedNumberOfObjects);
+      ASSERT_EQ(labels->GetBufferedRegion(), image->GetBufferedRegion());
+
+      for (itk::ImageRegionConstIteratorWithIndex<LabelImageType> it(expected, expected->GetBufferedRegion());
+           !it.IsAtEnd();
+           ++it)
+      {
+        ASSERT_EQ(labels->GetPixel(it.GetIndex()), it.Get())
+          << "at " << it.GetIndex() << " with fullyConnected " << fullyConnected;
+      }
+    }
+  }
+}
@@ -0,0 +1,157 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkPhiloxRandomVariateGenerator.h"
+
+#include "itkImage.h"
+#include "itkImageRandomConstIteratorWithIndex.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+
+namespace
+{
+using GeneratorType = itk::Statistics::PhiloxRandomVariateGenerator;
+} // namespace
+
+
+// Checks the known answers of Philox4x32-10, from the Random123 library.
+TEST(PhiloxRandomVariateGenerator, EncryptsLikeTheReferenceImplementation)
+{
+  using CounterType = GeneratorType::CounterType;
+  using KeyType = GeneratorType::KeyType;
+
+  EXPECT_EQ(GeneratorType::Philox4x32(CounterType{ { 0, 0, 0, 0 } }, KeyType{ { 0, 0 } }),
+            (CounterType{ { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 } }));
+  EXPECT_EQ(GeneratorType::Philox4x32(CounterType{ { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff } },
+                                      KeyType{ { 0xffffffff, 0xffffffff } }),
+            (CounterType{ { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd } }));
+  EXPECT_EQ(GeneratorType::Philox4x32(CounterType{ { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 } },
+                                      KeyType{ { 0xa4093822, 0x299f31d0 } }),
+            (CounterType{ { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 } }));
+}
+
+
+TEST(PhiloxRandomVariateGenerator, VariatesOnlyDependOnSeedAndStream)
+{
+  GeneratorType generator(42, 7);
+  GeneratorType sameGenerator;
+  sameGenerator.Initialize(42, 7);
+  GeneratorType otherStream(42, 8);
+  GeneratorType otherSeed(43, 7);
+
+  unsigned int numberOfEqualVariates = 0;
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    const auto variate = generator.GetIntegerVariate();
+    EXPECT_EQ(variate, sameGenerator.GetIntegerVariate());
+    numberOfEqualVariates += (variate == otherStream.GetIntegerVariate());
+    numberOfEqualVariates += (variate == otherSeed.GetIntegerVariate());
+  }
+  EXPECT_LE(numberOfEqualVariates, 1u);
+
+  // Initialize restarts the stream.
+  generator.Initialize(42, 7);
+  GeneratorType restartedGenerator(42, 7);
+  EXPECT_EQ(generator.GetNormalVariate(), restartedGenerator.GetNormalVariate());
+}
+
+
+TEST(PhiloxRandomVariateGenerator, HasUniformAndNormalDistributions)
+{
+  constexpr unsigned int numberOfStreams = 20000;
+
+  double uniformSum = 0.0;
+  double normalSum = 0.0;
+  double normalSquaredSum = 0.0;
+  for (unsigned int stream = 0; stream < numberOfStreams; ++stream)
+  {
+    GeneratorType generator(12345, stream);
+
+    const double openRangeVariate = generator.GetVariateWithOpenRange();
+    EXPECT_GT(openRangeVariate, 0.0);
+    EXPECT_LT(openRangeVariate, 1.0);
+    const double openUpperRangeVariate = generator.GetVariateWithOpenUpperRange();
+    EXPECT_GE(openUpperRangeVariate, 0.0);
+    EXPECT_LT(openUpperRangeVariate, 1.0);
+    const double variate = generator.GetVariate();
+    EXPECT_GE(variate, 0.0);
+    EXPECT_LE(variate, 1.0);
+    uniformSum += openRangeVariate + openUpperRangeVariate + variate;
+
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+      const double normalVariate = generator.GetNormalVariate();
+      normalSum += normalVariate;
+      normalSquaredSum += normalVariate * normalVariate;
+    }
+  }
+  EXPECT_NEAR(uniformSum / (3 * numberOfStreams), 0.5, 0.01);
+  EXPECT_NEAR(normalSum / (2 * numberOfStreams), 0.0, 0.02);
+  EXPECT_NEAR(normalSquaredSum / (2 * numberOfStreams), 1.0, 0.02);
+}
+
+
+TEST(PhiloxRandomVariateGenerator, DrawsReproducibleSamplesOfImageRandomIterator)
+{
+  using ImageType = itk::Image<short, 3>;
+  using IteratorType = itk::ImageRandomConstIteratorWithIndex<ImageType>;
+
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 20, 30, 10 } });
+  image->Allocate(true);
+
+  IteratorType it(image, image->GetBufferedRegion());
+  EXPECT_FALSE(it.GetUseCounterBasedGenerator());
+  it.SetUseCounterBasedGenerator(true);
+  it.SetNumberOfSamples(100);
+  it.ReinitializeSeed(121212);
+
+  std::vector<ImageType::IndexType> indices;
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    indices.push_back(it.GetIndex());
+  }
+  ASSERT_EQ(indices.size(), 100u);
+
+  // The samples can be drawn again, in any order.
+  IteratorType otherIt(image, image->GetBufferedRegion());
+  otherIt.SetUseCounterBasedGenerator(true);
+  otherIt.SetNumberOfSamples(100);
+  otherIt.ReinitializeSeed(121212);
+  otherIt.GoToEnd();
+  for (auto index = indices.crbegin(); index != indices.crend(); ++index)
+  {
+    --otherIt;
+    EXPECT_EQ(otherIt.GetIndex(), *index);
+  }
+  EXPECT_TRUE(otherIt.IsAtBegin());
+
+  // Another seed draws other samples.
+  otherIt.ReinitializeSeed(343434);
+  otherIt.GoToBegin();
+  unsigned int numberOfEqualIndices = 0;
+  for (const auto & index : indices)
+  {
+    numberOfEqualIndices += (otherIt.GetIndex() == index);
+    ++otherIt;
+  }
+  EXPECT_LT(numberOfEqualIndices, 5u);
+}
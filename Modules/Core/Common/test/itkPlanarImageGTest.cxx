@@ -0,0 +1,143 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkPlanarImage.h"
+
+#include "itkIndexRange.h"
+
+#include <gtest/gtest.h>
+
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using PlanarImageType = itk::PlanarImage<short, Dimension>;
+using RegionType = PlanarImageType::RegionType;
+using IndexType = PlanarImageType::IndexType;
+
+const RegionType bufferedRegion({ { 2, -1 } }, { { 7, 5 } });
+
+
+PlanarImageType::Pointer
+CreateImage(const unsigned int numberOfComponents)
+{
+  const auto image = PlanarImageType::New();
+  image->SetRegions(bufferedRegion);
+  image->SetNumberOfComponentsPerPixel(numberOfComponents);
+  image->Allocate(true);
+  return image;
+}
+
+
+PlanarImageType::PixelType
+MakeFilledPixel(const unsigned int numberOfComponents, const short value)
+{
+  PlanarImageType::PixelType pixel(numberOfComponents);
+  pixel.Fill(value);
+  return pixel;
+}
+} // namespace
+
+
+TEST(PlanarImage, StoresEachComponentInAChannel)
+{
+  const auto image = CreateImage(3);
+  EXPECT_EQ(image->GetNumberOfComponentsPerPixel(), 3u);
+
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(bufferedRegion))
+  {
+    PlanarImageType::PixelType pixel(3);
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      pixel[k] = static_cast<short>(index[0] * 10 + index[1] + 100 * k);
+    }
+    image->SetPixel(index, pixel);
+  }
+
+  // The pixels of a channel are contiguous, in the order of the pixels of an Image.
+  const short * const channel = image->GetChannelBufferPointer(2);
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(bufferedRegion))
+  {
+    const auto pixel = image->GetPixel(index);
+    ASSERT_EQ(pixel.GetSize(), 3u);
+    EXPECT_EQ(pixel[1], index[0] * 10 + index[1] + 100) << index;
+    EXPECT_EQ(channel[image->ComputeOffset(index)], pixel[2]) << index;
+    EXPECT_EQ((*image)[index], pixel);
+  }
+
+  image->FillBuffer(7);
+  EXPECT_EQ(image->GetPixel(bufferedRegion.GetIndex()), MakeFilledPixel(3, 7));
+
+  // A PlanarImage without components cannot be allocated.
+  const auto emptyImage = PlanarImageType::New();
+  emptyImage->SetRegions(bufferedRegion);
+  EXPECT_THROW(emptyImage->Allocate(), itk::ExceptionObject);
+}
+
+
+TEST(PlanarImage, SharesThePixelsOfAChannelWithItsView)
+{
+  const auto image = CreateImage(2);
+  PlanarImageType::SpacingType spacing;
+  spacing[0] = 0.5;
+  spacing[1] = 2.0;
+  image->SetSpacing(spacing);
+
+  const auto view = image->GetChannel(1);
+  EXPECT_EQ(view->GetBufferedRegion(), bufferedRegion);
+  EXPECT_EQ(view->GetSpacing(), image->GetSpacing());
+  EXPECT_EQ(view->GetBufferPointer(), image->GetChannelBufferPointer(1));
+
+  const IndexType index{ { 4, 2 } };
+  view->SetPixel(index, 42);
+  EXPECT_EQ(image->GetPixel(index)[1], 42);
+  EXPECT_EQ(image->GetPixel(index)[0], 0);
+  const PlanarImageType & constImage = *image;
+  EXPECT_EQ(constImage.GetChannel(1)->GetPixel(index), 42);
+  EXPECT_THROW(image->GetChannel(2), itk::ExceptionObject);
+
+  // The view keeps the pixels alive after the image is initialized.
+  image->Initialize();
+  EXPECT_EQ(view->GetPixel(index), 42);
+
+  // An image becomes a channel without copying its pixels.
+  const auto other = CreateImage(2);
+  other->SetChannel(0, view);
+  EXPECT_EQ(other->GetChannelBufferPointer(0), view->GetBufferPointer());
+  EXPECT_EQ(other->GetPixel(index)[0], 42);
+
+  const auto smallImage = PlanarImageType::ChannelImageType::New();
+  smallImage->SetRegions(PlanarImageType::SizeType{ { 2, 2 } });
+  smallImage->Allocate();
+  EXPECT_THROW(other->SetChannel(1, smallImage), itk::ExceptionObject);
+  EXPECT_THROW(other->SetChannel(2, view), itk::ExceptionObject);
+}
+
+
+TEST(PlanarImage, SharesTheChannelsOfAGraftedImage)
+{
+  const auto image = CreateImage(2);
+  const auto grafted = PlanarImageType::New();
+  grafted->Graft(image);
+  EXPECT_EQ(grafted->GetBufferedRegion(), bufferedRegion);
+  EXPECT_EQ(grafted->GetNumberOfComponentsPerPixel(), 2u);
+
+  grafted->SetPixel({ { 3, 0 } }, MakeFilledPixel(2, 9));
+  EXPECT_EQ(image->GetPixel({ { 3, 0 } }), MakeFilledPixel(2, 9));
+}
@@ -0,0 +1,241 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkSymmetricEigenAnalysis.h"
+
+#include "itkSymmetricSecondRankTensor.h"
+
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+
+
+namespace
+{
+template <unsigned int VDimension>
+using MatrixType = itk::Matrix<double, VDimension, VDimension>;
+
+template <unsigned int VDimension>
+using EigenValuesType = itk::FixedArray<double, VDimension>;
+
+
+// Returns Q D Q^T, with Q a rotation.
+MatrixType<3>
+CreateMatrixWithEigenValues(const double lambda0, const double lambda1, const double lambda2)
+{
+  const double  c = std::cos(0.7);
+  const double  s = std::sin(0.7);
+  MatrixType<3> rotationZ;
+  rotationZ.SetIdentity();
+  rotationZ(0, 0) = c;
+  rotationZ(0, 1) = -s;
+  rotationZ(1, 0) = s;
+  rotationZ(1, 1) = c;
+  MatrixType<3> rotationX;
+  rotationX.SetIdentity();
+  rotationX(1, 1) = c;
+  rotationX(1, 2) = -s;
+  rotationX(2, 1) = s;
+  rotationX(2, 2) = c;
+  const MatrixType<3> rotation = rotationZ * rotationX;
+
+  MatrixType<3> diagonal;
+  diagonal.Fill(0.0);
+  diagonal(0, 0) = lambda0;
+  diagonal(1, 1) = lambda1;
+  diagonal(2, 2) = lambda2;
+  MatrixType<3> matrix = rotation * diagonal * rotation.GetTranspose();
+
+  // Make the matrix exactly symmetric.
+  for (unsigned int row = 0; row < 3; ++row)
+  {
+    for (unsigned int col = 0; col < row; ++col)
+    {
+      matrix(row, col) = matrix(col, row);
+    }
+  }
+  return matrix;
+}
+
+
+// Compares the eigenvalues computed by SymmetricEigenAnalysis with the ones of
+// the Eigen library.
+template <unsigned int VDimension>
+void
+CheckSameEigenValuesAsEigenLibrary(const MatrixType<VDimension> & matrix, const itk::EigenValueOrderEnum order)
+{
+  using CalculatorType = itk::SymmetricEigenAnalysis<MatrixType<VDimension>, EigenValuesType<VDimension>>;
+  CalculatorType calculator(VDimension);
+  CalculatorType eigenLibraryCalculator(VDimension);
+  eigenLibraryCalculator.SetUseEigenLibraryOn();
+  using FixedDimensionCalculatorType =
+    itk::SymmetricEigenAnalysisFixedDimension<VDimension, MatrixType<VDimension>, EigenValuesType<VDimension>>;
+  FixedDimensionCalculatorType fixedDimensionCalculator;
+  if (order == itk::EigenValueOrderEnum::OrderByMagnitude)
+  {
+    calculator.SetOrderEigenMagnitudes(true);
+    eigenLibraryCalculator.SetOrderEigenMagnitudes(true);
+    fixedDimensionCalculator.SetOrderEigenMagnitudes(true);
+  }
+
+  EigenValuesType<VDimension> eigenValues;
+  EigenValuesType<VDimension> fixedDimensionEigenValues;
+  EigenValuesType<VDimension> expectedEigenValues;
+  EXPECT_EQ(calculator.ComputeEigenValues(matrix, eigenValues), 0u);
+  fixedDimensionCalculator.ComputeEigenValues(matrix, fixedDimensionEigenValues);
+  eigenLibraryCalculator.ComputeEigenValues(matrix, expectedEigenValues);
+
+  const double tolerance = 1e-12 * (1.0 + matrix.GetVnlMatrix().frobenius_norm());
+  for (unsigned int i = 0; i < VDimension; ++i)
+  {
+    EXPECT_NEAR(eigenValues[i], expectedEigenValues[i], tolerance) << "for eigenvalue " << i << " of\n" << matrix;
+    EXPECT_NEAR(fixedDimensionEigenValues[i], expectedEigenValues[i], tolerance)
+      << "for eigenvalue " << i << " of\n"
+      << matrix;
+  }
+}
+} // namespace
+
+
+TEST(SymmetricEigenAnalysis, ComputesTheEigenValuesOfRandom2x2And3x3MatricesInClosedForm)
+{
+  std::mt19937                           randomNumberEngine(42);
+  std::uniform_real_distribution<double> distribution(-100.0, 100.0);
+
+  for (unsigned int n = 0; n < 1000; ++n)
+  {
+    MatrixType<2> matrix2;
+    MatrixType<3> matrix3;
+    for (unsigned int row = 0; row < 3; ++row)
+    {
+      for (unsigned int col = row; col < 3; ++col)
+      {
+        matrix3(row, col) = distribution(randomNumberEngine);
+        matrix3(col, row) = matrix3(row, col);
+        if (col < 2)
+        {
+          matrix2(row, col) = matrix3(row, col);
+          matrix2(col, row) = matrix3(row, col);
+        }
+      }
+    }
+    for (const auto order : { itk::EigenValueOrderEnum::OrderByValue, itk::EigenValueOrderEnum::OrderByMagnitude })
+    {
+      CheckSameEigenValuesAsEigenLibrary<2>(matrix2, order);
+      CheckSameEigenValuesAsEigenLibrary<3>(matrix3, order);
+    }
+  }
+}
+
+
+TEST(SymmetricEigenAnalysis, SupportsDegenerate3x3Matrices)
+{
+  MatrixType<3> zero;
+  zero.Fill(0.0);
+  MatrixType<3> diagonal;
+  diagonal.Fill(0.0);
+  diagonal(0, 0) = 2.0;
+  diagonal(1, 1) = -7.0;
+  diagonal(2, 2) = 2.0;
+
+  for (const auto & matrix : { zero,
+                               diagonal,
+                               CreateMatrixWithEigenValues(3.0, 3.0, 3.0),
+                               CreateMatrixWithEigenValues(2.0, 5.0, 2.0),
+                               CreateMatrixWithEigenValues(-4.0, 1.0, 1.0 + 1e-9),
+                               CreateMatrixWithEigenValues(1e-300, 2e-300, 0.0),
+                               CreateMatrixWithEigenValues(1e150, -2e150, 1.0) })
+  {
+    for (const auto order : { itk::EigenValueOrderEnum::OrderByValue, itk::EigenValueOrderEnum::OrderByMagnitude })
+    {
+      CheckSameEigenValuesAsEigenLibrary<3>(matrix, order);
+    }
+  }
+}
+
+
+TEST(SymmetricEigenAnalysis, OrdersEigenValuesByMagnitude)
+{
+  const MatrixType<3> matrix = CreateMatrixWithEigenValues(2.0, -3.0, 1.0);
+  EigenValuesType<3>  eigenValues;
+
+  itk::SymmetricEigenAnalysis<MatrixType<3>, EigenValuesType<3>> calculator(3);
+  calculator.ComputeEigenValues(matrix, eigenValues);
+  EXPECT_NEAR(eigenValues[0], -3.0, 1e-12);
+  EXPECT_NEAR(eigenValues[1], 1.0, 1e-12);
+  EXPECT_NEAR(eigenValues[2], 2.0, 1e-12);
+
+  calculator.SetOrderEigenMagnitudes(true);
+  calculator.ComputeEigenValues(matrix, eigenValues);
+  EXPECT_NEAR(eigenValues[0], 1.0, 1e-12);
+  EXPECT_NEAR(eigenValues[1], 2.0, 1e-12);
+  EXPECT_NEAR(eigenValues[2], -3.0, 1e-12);
+}
+
+
+TEST(SymmetricEigenAnalysis, RejectsNearlyDegenerateAndNonFiniteMatricesInClosedForm)
+{
+  double eigenValues[3] = { 0.0, 0.0, 0.0 };
+
+  const MatrixType<3> separated = CreateMatrixWithEigenValues(1.0, 2.0, 4.0);
+  EXPECT_TRUE(itk::detail::ComputeSymmetricEigenValues3x3(
+    separated(0, 0), separated(0, 1), separated(0, 2), separated(1, 1), separated(1, 2), separated(2, 2), eigenValues));
+  EXPECT_NEAR(eigenValues[0], 1.0, 1e-13);
+  EXPECT_NEAR(eigenValues[1], 2.0, 1e-13);
+  EXPECT_NEAR(eigenValues[2], 4.0, 1e-13);
+
+  const MatrixType<3> nearlyDegenerate = CreateMatrixWithEigenValues(1.0, 1.0 + 1e-10, 4.0);
+  EXPECT_FALSE(itk::detail::ComputeSymmetricEigenValues3x3(nearlyDegenerate(0, 0),
+                                                           nearlyDegenerate(0, 1),
+                                                           nearlyDegenerate(0, 2),
+                                                           nearlyDegenerate(1, 1),
+                                                           nearlyDegenerate(1, 2),
+                                                           nearlyDegenerate(2, 2),
+                                                           eigenValues));
+
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_FALSE(itk::detail::ComputeSymmetricEigenValues3x3(1.0, nan, 0.0, 1.0, 0.0, 1.0, eigenValues));
+}
+
+
+TEST(SymmetricEigenAnalysis, ComputesTheEigenValuesOfTensorsInClosedForm)
+{
+  using TensorType = itk::SymmetricSecondRankTensor<double, 3>;
+  TensorType tensor;
+  tensor(0, 0) = 4.0;
+  tensor(0, 1) = 1.0;
+  tensor(0, 2) = -2.0;
+  tensor(1, 1) = 3.0;
+  tensor(1, 2) = 0.5;
+  tensor(2, 2) = -1.0;
+
+  EigenValuesType<3> eigenValues;
+  EigenValuesType<3> expectedEigenValues;
+
+  const itk::SymmetricEigenAnalysisFixedDimension<3, TensorType, EigenValuesType<3>> calculator;
+  calculator.ComputeEigenValues(tensor, eigenValues);
+
+  itk::SymmetricEigenAnalysis<TensorType, EigenValuesType<3>> eigenLibraryCalculator(3);
+  eigenLibraryCalculator.SetUseEigenLibraryOn();
+  eigenLibraryCalculator.ComputeEigenValues(tensor, expectedEigenValues);
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    EXPECT_NEAR(eigenValues[i], expectedEigenValues[i], 1e-12);
+  }
+}
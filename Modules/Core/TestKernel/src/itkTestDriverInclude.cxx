@@ -752,6 +752,7 @@ RegressionTestImage(const char *         testImageFilename,
                                                verifyInputInformation,
                                                coordinateTolerance,
                                                directionTolerance);
+      case itk::IOComponentEnum::FLOAT16:
       case itk::IOComponentEnum::FLOAT:
       case itk::IOComponentEnum::DOUBLE:
         return RegressionTestHelper<double>(testImageFilename,
@@ -858,6 +859,7 @@ HashTestImage(const char * testImageFilename, const std::vector<std::string> & b
     case itk::IOComponentEnum::ULONGLONG:
       testMD5 = ComputeHash<itk::VectorImage<unsigned long long, ITK_TEST_DIMENSION_MAX>>(testImageFilename);
       break;
+    case itk::IOComponentEnum::FLOAT16:
     case itk::IOComponentEnum::FLOAT:
     case itk::IOComponentEnum::DOUBLE:
       std::cerr << "Hashing is not supporting for float and double images." << std::endl;
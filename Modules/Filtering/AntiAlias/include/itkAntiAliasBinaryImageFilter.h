@@ -56,6 +56,11 @@ namespace itk
  * introduce some differences in how fast and how accurately (in terms of RMS
  * error) the solution converges.
  *
+ * \par
+ * The updates of the active layer are computed by several work units (see
+ * SparseFieldLevelSetImageFilter::SetComputeUpdatesInParallel()). To smooth
+ * all the labels of a label image at once, use AntiAliasLabelImageFilter.
+ *
  * \par REFERENCES
  * Whitaker, Ross.  "Reducing Aliasing Artifacts In Iso-Surfaces of Binary
  * Volumes"  IEEE Volume Visualization and Graphics Symposium, October 2000,
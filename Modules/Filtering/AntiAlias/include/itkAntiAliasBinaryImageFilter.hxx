@@ -53,6 +53,10 @@ AntiAliasBinaryImageFilter<TInputImage, TOutputImage>::AntiAliasBinaryImageFilte
   this->SetMaximumRMSError(0.07);
   this->SetNumberOfIterations(1000);
   this->SetUseImageSpacing(false);
+
+  // The curvature flow function is thread safe: the updates of the active
+  // layer are computed in parallel.
+  this->ComputeUpdatesInParallelOn();
 }
 
 template <typename TInputImage, typename TOutputImage>
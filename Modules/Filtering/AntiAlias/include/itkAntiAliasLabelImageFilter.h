@@ -0,0 +1,150 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkAntiAliasLabelImageFilter_h
+#define itkAntiAliasLabelImageFilter_h
+
+#include "itkImageToImageFilter.h"
+
+#include <map>
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class AntiAliasLabelImageFilter
+ * \brief Applies the AntiAliasBinaryImageFilter to every label of a label image.
+ *
+ * \par
+ * Each label different from the background value is processed
+ * independently by an AntiAliasBinaryImageFilter, restricted to the bounding
+ * box of the label padded by the number of layers of the sparse field. The
+ * labels are found in a single pass over the input, then processed one
+ * after the other, each of them with all the work units of the filter.
+ *
+ * \par OUTPUTS
+ * The level set of each label can be retrieved with GetLevelSet(). Its
+ * buffered region is the padded bounding box of the label, and it is
+ * positive inside the label, like the output of AntiAliasBinaryImageFilter.
+ * The output of the filter is the maximum of the level sets of all the
+ * labels: its zero level set separates the labeled objects from the
+ * background.
+ *
+ * \par PARAMETERS
+ * The MaximumRMSError, NumberOfIterations and NumberOfLayers parameters are
+ * passed to the AntiAliasBinaryImageFilter of each label.
+ *
+ * \sa AntiAliasBinaryImageFilter
+ *
+ * \ingroup ITKAntiAlias
+ */
+template <typename TInputImage, typename TOutputImage>
+class ITK_TEMPLATE_EXPORT AntiAliasLabelImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(AntiAliasLabelImageFilter);
+
+  /** Standard class type aliases */
+  using Self = AntiAliasLabelImageFilter;
+  using Superclass = ImageToImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(AntiAliasLabelImageFilter, ImageToImageFilter);
+
+  static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using LabelType = typename TInputImage::PixelType;
+  using OutputPixelType = typename TOutputImage::PixelType;
+  using RegionType = typename TInputImage::RegionType;
+  using IndexType = typename TInputImage::IndexType;
+  using LabelVectorType = std::vector<LabelType>;
+
+  /** Set/Get the value of the background, which is not processed. */
+  itkSetMacro(BackgroundValue, LabelType);
+  itkGetConstMacro(BackgroundValue, LabelType);
+
+  /** Set/Get the maximum RMS error of the solver of each label. */
+  itkSetMacro(MaximumRMSError, double);
+  itkGetConstMacro(MaximumRMSError, double);
+
+  /** Set/Get the maximum number of iterations of the solver of each label. */
+  itkSetMacro(NumberOfIterations, unsigned int);
+  itkGetConstMacro(NumberOfIterations, unsigned int);
+
+  /** Set/Get the number of layers of the sparse field of each label. */
+  itkSetMacro(NumberOfLayers, unsigned int);
+  itkGetConstMacro(NumberOfLayers, unsigned int);
+
+  /** Get the labels found in the input, in increasing order. */
+  const LabelVectorType &
+  GetLabels() const
+  {
+    return m_Labels;
+  }
+
+  /** Get the level set computed for the specified label. */
+  const OutputImageType *
+  GetLevelSet(const LabelType & label) const;
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  // Begin concept checking
+  itkConceptMacro(DoubleConvertibleToOutputCheck, (Concept::Convertible<double, OutputPixelType>));
+  itkConceptMacro(InputOStreamWritableCheck, (Concept::OStreamWritable<LabelType>));
+  // End concept checking
+#endif
+
+protected:
+  AntiAliasLabelImageFilter();
+  ~AntiAliasLabelImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** The filter needs the entire input. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  /** The filter produces the entire output. */
+  void
+  EnlargeOutputRequestedRegion(DataObject * output) override;
+
+  void
+  GenerateData() override;
+
+private:
+  LabelType    m_BackgroundValue{ NumericTraits<LabelType>::ZeroValue() };
+  double       m_MaximumRMSError{ 0.07 };
+  unsigned int m_NumberOfIterations{ 1000 };
+  unsigned int m_NumberOfLayers{ ImageDimension < 2 ? 2 : ImageDimension };
+
+  LabelVectorType                                        m_Labels;
+  std::map<LabelType, typename OutputImageType::Pointer> m_LevelSets;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkAntiAliasLabelImageFilter.hxx"
+#endif
+
+#endif
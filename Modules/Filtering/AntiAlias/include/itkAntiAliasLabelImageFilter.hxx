@@ -0,0 +1,216 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkAntiAliasLabelImageFilter_hxx
+#define itkAntiAliasLabelImageFilter_hxx
+
+#include "itkAntiAliasLabelImageFilter.h"
+#include "itkAntiAliasBinaryImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
+#include "itkProgressReporter.h"
+
+#include <mutex>
+
+namespace itk
+{
+
+template <typename TInputImage, typename TOutputImage>
+AntiAliasLabelImageFilter<TInputImage, TOutputImage>::AntiAliasLabelImageFilter() = default;
+
+template <typename TInputImage, typename TOutputImage>
+auto
+AntiAliasLabelImageFilter<TInputImage, TOutputImage>::GetLevelSet(const LabelType & label) const
+  -> const OutputImageType *
+{
+  const auto it = m_LevelSets.find(label);
+  if (it == m_LevelSets.end())
+  {
+    itkExceptionMacro(<< "No level set for label " << static_cast<typename NumericTraits<LabelType>::PrintType>(label));
+  }
+  return it->second;
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+AntiAliasLabelImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  if (this->GetInput())
+  {
+    auto * input = const_cast<InputImageType *>(this->GetInput());
+    input->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+AntiAliasLabelImageFilter<TInputImage, TOutputImage>::EnlargeOutputRequestedRegion(DataObject * output)
+{
+  Superclass::EnlargeOutputRequestedRegion(output);
+  output->SetRequestedRegionToLargestPossibleRegion();
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+AntiAliasLabelImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  const InputImageType * input = this->GetInput();
+  OutputImageType *      output = this->GetOutput();
+  const RegionType       region = input->GetBufferedRegion();
+
+  m_Labels.clear();
+  m_LevelSets.clear();
+
+  // Compute the bounding box of every label.
+  using BoundingBoxType = std::pair<IndexType, IndexType>;
+  using BoundingBoxMapType = std::map<LabelType, BoundingBoxType>;
+  BoundingBoxMapType boundingBoxes;
+  std::mutex         mutex;
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    region,
+    [&](const RegionType & subregion) {
+      BoundingBoxMapType localBoundingBoxes;
+      for (ImageRegionConstIteratorWithIndex<InputImageType> it(input, subregion); !it.IsAtEnd(); ++it)
+      {
+        const LabelType label = it.Get();
+        if (Math::ExactlyEquals(label, m_BackgroundValue))
+        {
+          continue;
+        }
+        const IndexType index = it.GetIndex();
+        const auto      inserted = localBoundingBoxes.insert(std::make_pair(label, BoundingBoxType(index, index)));
+        if (!inserted.second)
+        {
+          BoundingBoxType & box = inserted.first->second;
+          for (unsigned int d = 0; d < ImageDimension; ++d)
+          {
+            box.first[d] = std::min(box.first[d], index[d]);
+            box.second[d] = std::max(box.second[d], index[d]);
+          }
+        }
+      }
+
+      const std::lock_guard<std::mutex> lock(mutex);
+      for (const auto & localBox : localBoundingBoxes)
+      {
+        const auto inserted = boundingBoxes.insert(localBox);
+        if (!inserted.second)
+        {
+          BoundingBoxType & box = inserted.first->second;
+          for (unsigned int d = 0; d < ImageDimension; ++d)
+          {
+            box.first[d] = std::min(box.first[d], localBox.second.first[d]);
+            box.second[d] = std::max(box.second[d], localBox.second.second[d]);
+          }
+        }
+      }
+    },
+    nullptr);
+
+  // The padded bounding boxes, in increasing label order.
+  std::vector<RegionType> labelRegions;
+  for (const auto & labelBox : boundingBoxes)
+  {
+    RegionType labelRegion;
+    labelRegion.SetIndex(labelBox.second.first);
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      labelRegion.SetSize(d, static_cast<SizeValueType>(labelBox.second.second[d] - labelBox.second.first[d] + 1));
+    }
+    labelRegion.PadByRadius(m_NumberOfLayers + 2);
+    labelRegion.Crop(region);
+    m_Labels.push_back(labelBox.first);
+    labelRegions.push_back(labelRegion);
+  }
+
+  // Process the labels one after the other. The pipeline of each label
+  // (shift, zero crossing and level set iterations) is multithreaded on its
+  // own, so the labels are not processed concurrently on the same threads.
+  using BinaryImageType = Image<unsigned char, ImageDimension>;
+  using AntiAliasFilterType = AntiAliasBinaryImageFilter<BinaryImageType, OutputImageType>;
+
+  const SizeValueType                            numberOfLabels = m_Labels.size();
+  std::vector<typename OutputImageType::Pointer> levelSets(numberOfLabels);
+  ProgressReporter                               progress(this, 0, numberOfLabels);
+  for (SizeValueType i = 0; i < numberOfLabels; ++i)
+  {
+    const auto binaryImage = BinaryImageType::New();
+    binaryImage->CopyInformation(input);
+    binaryImage->SetRegions(labelRegions[i]);
+    binaryImage->Allocate();
+
+    ImageRegionConstIterator<InputImageType> inputIt(input, labelRegions[i]);
+    ImageRegionIterator<BinaryImageType>     binaryIt(binaryImage, labelRegions[i]);
+    for (; !inputIt.IsAtEnd(); ++inputIt, ++binaryIt)
+    {
+      binaryIt.Set(Math::ExactlyEquals(inputIt.Get(), m_Labels[i]) ? 1 : 0);
+    }
+
+    const auto antiAliasFilter = AntiAliasFilterType::New();
+    antiAliasFilter->SetInput(binaryImage);
+    antiAliasFilter->SetMaximumRMSError(m_MaximumRMSError);
+    antiAliasFilter->SetNumberOfIterations(m_NumberOfIterations);
+    antiAliasFilter->SetNumberOfLayers(m_NumberOfLayers);
+    antiAliasFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    antiAliasFilter->Update();
+
+    levelSets[i] = antiAliasFilter->GetOutput();
+    levelSets[i]->DisconnectPipeline();
+    progress.CompletedPixel();
+  }
+
+  // Combine the level sets; the pixels far from every label get the value
+  // of the background of the sparse field.
+  this->AllocateOutputs();
+  output->FillBuffer(-static_cast<OutputPixelType>(m_NumberOfLayers + 1));
+  for (SizeValueType i = 0; i < numberOfLabels; ++i)
+  {
+    m_LevelSets[m_Labels[i]] = levelSets[i];
+    const OutputImageType * levelSet = levelSets[i];
+    this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+      labelRegions[i],
+      [output, levelSet](const RegionType & subregion) {
+        ImageRegionConstIterator<OutputImageType> levelSetIt(levelSet, subregion);
+        ImageRegionIterator<OutputImageType>      outputIt(output, subregion);
+        for (; !outputIt.IsAtEnd(); ++outputIt, ++levelSetIt)
+        {
+          outputIt.Set(std::max(outputIt.Get(), levelSetIt.Get()));
+        }
+      },
+      nullptr);
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+AntiAliasLabelImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "BackgroundValue: " << static_cast<typename NumericTraits<LabelType>::PrintType>(m_BackgroundValue)
+     << std::endl;
+  os << indent << "MaximumRMSError: " << m_MaximumRMSError << std::endl;
+  os << indent << "NumberOfIterations: " << m_NumberOfIterations << std::endl;
+  os << indent << "NumberOfLayers: " << m_NumberOfLayers << std::endl;
+  os << indent << "Labels: " << m_Labels.size() << std::endl;
+}
+} // end namespace itk
+
+#endif
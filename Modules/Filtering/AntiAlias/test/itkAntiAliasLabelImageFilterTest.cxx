@@ -0,0 +1,225 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAntiAliasLabelImageFilter.h"
+#include "itkAntiAliasBinaryImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+//
+// Smooths a label image holding three balls, and checks that the level set
+// of each label matches the output of AntiAliasBinaryImageFilter applied to
+// the binary image of that label. Also checks that the parallel computation
+// of the updates of AntiAliasBinaryImageFilter does not change its output,
+// and that an image with more labels than the threads of the pool is
+// processed.
+//
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using LabelImageType = itk::Image<unsigned short, Dimension>;
+using BinaryImageType = itk::Image<unsigned char, Dimension>;
+using OutputImageType = itk::Image<float, Dimension>;
+
+LabelImageType::Pointer
+CreateLabelImage()
+{
+  const auto                     image = LabelImageType::New();
+  const LabelImageType::SizeType size = { { 48, 40, 36 } };
+  image->SetRegions(size);
+  image->Allocate(true);
+
+  const double         centers[3][3] = { { 14, 14, 14 }, { 32, 24, 20 }, { 16, 28, 24 } };
+  const double         radii[3] = { 8, 9, 6 };
+  const unsigned short labels[3] = { 3, 7, 12 };
+  for (itk::ImageRegionIteratorWithIndex<LabelImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      double squaredDistance = 0.0;
+      for (unsigned int d = 0; d < Dimension; ++d)
+      {
+        squaredDistance += (it.GetIndex()[d] - centers[i][d]) * (it.GetIndex()[d] - centers[i][d]);
+      }
+      if (squaredDistance <= radii[i] * radii[i])
+      {
+        it.Set(labels[i]);
+      }
+    }
+  }
+  return image;
+}
+
+// Cubes of 4 pixels of side, labeled from 1, on a grid with 8 pixels of step.
+LabelImageType::Pointer
+CreateManyLabelImage(unsigned int numberOfLabels)
+{
+  const unsigned int             cubesPerRow = 6;
+  const unsigned int             numberOfRows = (numberOfLabels + cubesPerRow - 1) / cubesPerRow;
+  const auto                     image = LabelImageType::New();
+  const LabelImageType::SizeType size = { { 8 * cubesPerRow, 8 * numberOfRows, 8 } };
+  image->SetRegions(size);
+  image->Allocate(true);
+
+  for (unsigned int label = 1; label <= numberOfLabels; ++label)
+  {
+    LabelImageType::IndexType start;
+    start[0] = 8 * ((label - 1) % cubesPerRow) + 2;
+    start[1] = 8 * ((label - 1) / cubesPerRow) + 2;
+    start[2] = 2;
+    const LabelImageType::SizeType cubeSize = { { 4, 4, 4 } };
+    for (itk::ImageRegionIterator<LabelImageType> it(image, LabelImageType::RegionType(start, cubeSize)); !it.IsAtEnd();
+         ++it)
+    {
+      it.Set(static_cast<unsigned short>(label));
+    }
+  }
+  return image;
+}
+
+OutputImageType::Pointer
+AntiAliasBinary(const LabelImageType * image, unsigned short label, unsigned int numberOfWorkUnits)
+{
+  const auto binaryImage = BinaryImageType::New();
+  binaryImage->SetRegions(image->GetLargestPossibleRegion());
+  binaryImage->Allocate();
+  itk::ImageRegionConstIterator<LabelImageType> labelIt(image, image->GetLargestPossibleRegion());
+  itk::ImageRegionIterator<BinaryImageType>     binaryIt(binaryImage, image->GetLargestPossibleRegion());
+  for (; !labelIt.IsAtEnd(); ++labelIt, ++binaryIt)
+  {
+    binaryIt.Set(labelIt.Get() == label ? 1 : 0);
+  }
+
+  using FilterType = itk::AntiAliasBinaryImageFilter<BinaryImageType, OutputImageType>;
+  const auto filter = FilterType::New();
+  filter->SetInput(binaryImage);
+  filter->SetMaximumRMSError(0.02);
+  filter->SetNumberOfIterations(50);
+  filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+  filter->Update();
+  return filter->GetOutput();
+}
+} // namespace
+
+int
+itkAntiAliasLabelImageFilterTest(int, char *[])
+{
+  const LabelImageType::Pointer image = CreateLabelImage();
+
+  using FilterType = itk::AntiAliasLabelImageFilter<LabelImageType, OutputImageType>;
+  const auto filter = FilterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, AntiAliasLabelImageFilter, ImageToImageFilter);
+
+  ITK_TEST_SET_GET_VALUE(3u, filter->GetNumberOfLayers());
+  filter->SetMaximumRMSError(0.02);
+  ITK_TEST_SET_GET_VALUE(0.02, filter->GetMaximumRMSError());
+  filter->SetNumberOfIterations(50);
+  ITK_TEST_SET_GET_VALUE(50u, filter->GetNumberOfIterations());
+  filter->SetBackgroundValue(0);
+  ITK_TEST_SET_GET_VALUE(0, filter->GetBackgroundValue());
+
+  filter->SetInput(image);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  const FilterType::LabelVectorType & labels = filter->GetLabels();
+  ITK_TEST_EXPECT_EQUAL(labels.size(), 3u);
+  ITK_TRY_EXPECT_EXCEPTION(filter->GetLevelSet(1));
+
+  constexpr float tolerance = 1e-4f;
+  bool            success = true;
+
+  for (const unsigned short label : labels)
+  {
+    const OutputImageType *        levelSet = filter->GetLevelSet(label);
+    const OutputImageType::Pointer expected = AntiAliasBinary(image, label, 1);
+
+    // Inside the padded bounding box, the level set must be the one
+    // computed on the whole image.
+    itk::ImageRegionConstIterator<OutputImageType> levelSetIt(levelSet, levelSet->GetBufferedRegion());
+    itk::ImageRegionConstIterator<OutputImageType> expectedIt(expected, levelSet->GetBufferedRegion());
+    itk::ImageRegionConstIterator<OutputImageType> outputIt(filter->GetOutput(), levelSet->GetBufferedRegion());
+    itk::ImageRegionConstIterator<LabelImageType>  labelIt(image, levelSet->GetBufferedRegion());
+    for (; !levelSetIt.IsAtEnd(); ++levelSetIt, ++expectedIt, ++outputIt, ++labelIt)
+    {
+      if (std::abs(levelSetIt.Get() - expectedIt.Get()) > tolerance)
+      {
+        std::cerr << "Level set of label " << label << " differs: " << levelSetIt.Get() << " != " << expectedIt.Get()
+                  << std::endl;
+        success = false;
+        break;
+      }
+      // The combined output is positive inside the labels.
+      if (labelIt.Get() == label && outputIt.Get() < 0.0f)
+      {
+        std::cerr << "Output is negative inside label " << label << std::endl;
+        success = false;
+        break;
+      }
+    }
+  }
+
+  // Computing the updates of the active layer in parallel does not change
+  // the result.
+  const OutputImageType::Pointer serialOutput = AntiAliasBinary(image, labels[1], 1);
+  const OutputImageType::Pointer parallelOutput = AntiAliasBinary(image, labels[1], 4);
+  itk::ImageRegionConstIterator<OutputImageType> serialIt(serialOutput, serialOutput->GetBufferedRegion());
+  itk::ImageRegionConstIterator<OutputImageType> parallelIt(parallelOutput, serialOutput->GetBufferedRegion());
+  for (; !serialIt.IsAtEnd(); ++serialIt, ++parallelIt)
+  {
+    if (std::abs(serialIt.Get() - parallelIt.Get()) > tolerance)
+    {
+      std::cerr << "Parallel update differs: " << parallelIt.Get() << " != " << serialIt.Get() << std::endl;
+      success = false;
+      break;
+    }
+  }
+
+  // More labels than threads in the pool, each of them processed with all
+  // the work units of the filter.
+  const unsigned int            numberOfLabels = 2 * itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads() + 3;
+  const LabelImageType::Pointer manyLabelImage = CreateManyLabelImage(numberOfLabels);
+  const auto                    manyLabelFilter = FilterType::New();
+  manyLabelFilter->SetInput(manyLabelImage);
+  manyLabelFilter->SetMaximumRMSError(0.02);
+  manyLabelFilter->SetNumberOfIterations(10);
+  ITK_TRY_EXPECT_NO_EXCEPTION(manyLabelFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(manyLabelFilter->GetLabels().size(), numberOfLabels);
+  for (itk::ImageRegionIteratorWithIndex<LabelImageType> it(manyLabelImage, manyLabelImage->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    if (it.Get() != 0 && manyLabelFilter->GetLevelSet(it.Get())->GetPixel(it.GetIndex()) < 0.0f)
+    {
+      std::cerr << "Level set of label " << it.Get() << " is negative at " << it.GetIndex() << std::endl;
+      success = false;
+      break;
+    }
+  }
+
+  if (!success)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
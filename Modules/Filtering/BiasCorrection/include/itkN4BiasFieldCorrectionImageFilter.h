@@ -345,6 +345,29 @@ public:
    */
   itkGetConstMacro(ConvergenceThreshold, RealType);
 
+  /**
+   * Set/Get whether the B-spline approximation of the residual bias field is
+   * computed directly on the image grid.  The lattice is then accumulated from
+   * the residual image in parallel, without building the point set of the
+   * included voxels required by BSplineScatteredDataPointSetToImageFilter.
+   * Both approaches compute the same approximation up to rounding errors.
+   * The image must have at least 2 voxels along each dimension.
+   * Default = false.
+   */
+  itkSetMacro(UseGridFitting, bool);
+  itkGetConstMacro(UseGridFitting, bool);
+  itkBooleanMacro(UseGridFitting);
+
+  /**
+   * Set/Get the subsampling factor of the voxels used to fit the B-spline
+   * approximation of the residual bias field.  Only the voxels whose index,
+   * relative to the start of the image, is a multiple of the factor in every
+   * dimension are used.  The bias field is still reconstructed, and the
+   * histogram is still sharpened, on the whole image.  Default = 1.
+   */
+  itkSetClampMacro(FittingSubsamplingFactor, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(FittingSubsamplingFactor, unsigned int);
+
   /**
    * Typically, a reduced size image is used as input to the N4 filter using
    * something like itkShrinkImageFilter.  Since the output is a corrected
@@ -414,6 +437,15 @@ private:
   RealImagePointer
   UpdateBiasFieldEstimate(RealImageType *, std::size_t);
 
+  /**
+   * Compute the control point lattice approximating the given unsmoothed
+   * estimate of the bias field, with the scattered data approximation of
+   * BSplineScatteredDataPointSetToImageFilter evaluated directly on the
+   * image grid.
+   */
+  typename BiasFieldControlPointLatticeType::Pointer
+  FitBiasFieldOnImageGrid(const RealImageType *, const ArrayType & numberOfControlPoints) const;
+
   /**
    * Convergence is determined by the coefficient of variation of the difference
    * image between the current bias field estimate and the previous estimate.
@@ -445,6 +477,8 @@ private:
   unsigned int m_SplineOrder{ 3 };
   ArrayType    m_NumberOfControlPoints;
   ArrayType    m_NumberOfFittingLevels;
+  bool         m_UseGridFitting{ false };
+  unsigned int m_FittingSubsamplingFactor{ 1 };
 };
 
 } // end namespace itk
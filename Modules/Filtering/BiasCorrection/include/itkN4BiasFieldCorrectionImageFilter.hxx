@@ -22,12 +22,16 @@
 
 #include "itkAddImageFilter.h"
 #include "itkBSplineControlPointImageFilter.h"
+#include "itkBSplineKernelFunction.h"
+#include "itkCoxDeBoorBSplineKernelFunction.h"
 #include "itkDivideImageFilter.h"
 #include "itkExpImageFilter.h"
 #include "itkImageBufferRange.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkImageRegionIterator.h"
 #include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageRegionSplitterSlowDimension.h"
+#include "itkImageScanlineConstIterator.h"
 #include "itkImportImageFilter.h"
 #include "itkIterationReporter.h"
 #include "itkSubtractImageFilter.h"
@@ -270,57 +274,91 @@ CLANG_SUPPRESS_Wfloat_equal
     // in real space are denoted by a single uppercase letter whereas their
     // frequency counterparts are indicated by a trailing lowercase 'f'.
 
-    RealType binMaximum = NumericTraits<RealType>::NonpositiveMin();
-    RealType binMinimum = NumericTraits<RealType>::max();
-
     const auto        unsharpenedImageBufferRange = MakeImageBufferRange(unsharpenedImage);
     const std::size_t numberOfPixels = unsharpenedImageBufferRange.size();
 
-    for (std::size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
-    {
-      if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-           (!useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits<MaskPixelType>::ZeroValue())) &&
-          (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
-      {
-        RealType pixel = unsharpenedImageBufferRange[indexValue];
-        if (pixel > binMaximum)
-        {
-          binMaximum = pixel;
-        }
-        else if (pixel < binMinimum)
+    const auto isIncluded = [&](const std::size_t indexValue) -> bool {
+      return (maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
+              (!useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits<MaskPixelType>::ZeroValue())) &&
+             (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0);
+    };
+
+    // The pixels are processed in parallel, in blocks of fixed size so that
+    // the histogram does not depend on the number of work units.
+    constexpr std::size_t numberOfPixelsPerBlock = 65536;
+    const std::size_t     numberOfBlocks = (numberOfPixels + numberOfPixelsPerBlock - 1) / numberOfPixelsPerBlock;
+    MultiThreaderBase *   multiThreader = this->GetMultiThreader();
+
+    std::vector<RealType> blockMaxima(numberOfBlocks, NumericTraits<RealType>::NonpositiveMin());
+    std::vector<RealType> blockMinima(numberOfBlocks, NumericTraits<RealType>::max());
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfBlocks,
+      [&](SizeValueType block) {
+        const std::size_t blockEnd = std::min(numberOfPixels, (block + 1) * numberOfPixelsPerBlock);
+        for (std::size_t indexValue = block * numberOfPixelsPerBlock; indexValue < blockEnd; ++indexValue)
         {
-          binMinimum = pixel;
+          if (isIncluded(indexValue))
+          {
+            const RealType pixel = unsharpenedImageBufferRange[indexValue];
+            blockMaxima[block] = std::max(blockMaxima[block], pixel);
+            blockMinima[block] = std::min(blockMinima[block], pixel);
+          }
         }
-      }
+      },
+      nullptr);
+
+    RealType binMaximum = NumericTraits<RealType>::NonpositiveMin();
+    RealType binMinimum = NumericTraits<RealType>::max();
+    for (std::size_t block = 0; block < numberOfBlocks; ++block)
+    {
+      binMaximum = std::max(binMaximum, blockMaxima[block]);
+      binMinimum = std::min(binMinimum, blockMinima[block]);
     }
     RealType histogramSlope = (binMaximum - binMinimum) / static_cast<RealType>(this->m_NumberOfHistogramBins - 1);
 
     // Create the intensity profile (within the masked region, if applicable)
     // using a triangular parzen windowing scheme.
 
+    const unsigned int    numberOfHistogramBins = this->m_NumberOfHistogramBins;
+    std::vector<RealType> blockHistograms(numberOfBlocks * numberOfHistogramBins, 0.0);
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfBlocks,
+      [&](SizeValueType block) {
+        RealType *        blockHistogram = blockHistograms.data() + block * numberOfHistogramBins;
+        const std::size_t blockEnd = std::min(numberOfPixels, (block + 1) * numberOfPixelsPerBlock);
+        for (std::size_t indexValue = block * numberOfPixelsPerBlock; indexValue < blockEnd; ++indexValue)
+        {
+          if (isIncluded(indexValue))
+          {
+            RealType pixel = unsharpenedImageBufferRange[indexValue];
+
+            RealType     cidx = (static_cast<RealType>(pixel) - binMinimum) / histogramSlope;
+            unsigned int idx = itk::Math::floor(cidx);
+            RealType     offset = cidx - static_cast<RealType>(idx);
+
+            if (offset == 0.0)
+            {
+              blockHistogram[idx] += 1.0;
+            }
+            else if (idx < numberOfHistogramBins - 1)
+            {
+              blockHistogram[idx] += 1.0 - offset;
+              blockHistogram[idx + 1] += offset;
+            }
+          }
+        }
+      },
+      nullptr);
+
     vnl_vector<RealType> H(this->m_NumberOfHistogramBins, 0.0);
 
-    for (std::size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
+    for (std::size_t block = 0; block < numberOfBlocks; ++block)
     {
-      if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-           (!useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits<MaskPixelType>::ZeroValue())) &&
-          (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
+      for (unsigned int n = 0; n < numberOfHistogramBins; n++)
       {
-        RealType pixel = unsharpenedImageBufferRange[indexValue];
-
-        RealType     cidx = (static_cast<RealType>(pixel) - binMinimum) / histogramSlope;
-        unsigned int idx = itk::Math::floor(cidx);
-        RealType     offset = cidx - static_cast<RealType>(idx);
-
-        if (offset == 0.0)
-        {
-          H[idx] += 1.0;
-        }
-        else if (idx < this->m_NumberOfHistogramBins - 1)
-        {
-          H[idx] += 1.0 - offset;
-          H[idx + 1] += offset;
-        }
+        H[n] += blockHistograms[block * numberOfHistogramBins + n];
       }
     }
 
@@ -448,27 +486,32 @@ CLANG_SUPPRESS_Wfloat_equal
 
     const ImageBufferRange<RealImageType> sharpenedImageBufferRange{ *sharpenedImage };
 
-    for (std::size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
-    {
-      if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-           (!useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits<MaskPixelType>::ZeroValue())) &&
-          (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
-      {
-        RealType     cidx = (unsharpenedImageBufferRange[indexValue] - binMinimum) / histogramSlope;
-        unsigned int idx = itk::Math::floor(cidx);
-
-        RealType correctedPixel = 0;
-        if (idx < E.size() - 1)
-        {
-          correctedPixel = E[idx] + (E[idx + 1] - E[idx]) * (cidx - static_cast<RealType>(idx));
-        }
-        else
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfBlocks,
+      [&](SizeValueType block) {
+        const std::size_t blockEnd = std::min(numberOfPixels, (block + 1) * numberOfPixelsPerBlock);
+        for (std::size_t indexValue = block * numberOfPixelsPerBlock; indexValue < blockEnd; ++indexValue)
         {
-          correctedPixel = E[E.size() - 1];
+          if (isIncluded(indexValue))
+          {
+            RealType     cidx = (unsharpenedImageBufferRange[indexValue] - binMinimum) / histogramSlope;
+            unsigned int idx = itk::Math::floor(cidx);
+
+            RealType correctedPixel = 0;
+            if (idx < E.size() - 1)
+            {
+              correctedPixel = E[idx] + (E[idx + 1] - E[idx]) * (cidx - static_cast<RealType>(idx));
+            }
+            else
+            {
+              correctedPixel = E[E.size() - 1];
+            }
+            sharpenedImageBufferRange[indexValue] = correctedPixel;
+          }
         }
-        sharpenedImageBufferRange[indexValue] = correctedPixel;
-      }
-    }
+      },
+      nullptr);
   }
 
   template <typename TInputImage, typename TMaskImage, typename TOutputImage>
@@ -476,76 +519,7 @@ CLANG_SUPPRESS_Wfloat_equal
   N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::UpdateBiasFieldEstimate(
     RealImageType * fieldEstimate, const std::size_t numberOfIncludedPixels)
   {
-    // Temporarily set the direction cosine to identity since the B-spline
-    // approximation algorithm works in parametric space and not physical
-    // space.
-    typename ScalarImageType::DirectionType identity;
-    identity.SetIdentity();
-
-    const typename ScalarImageType::RegionType & bufferedRegion = fieldEstimate->GetBufferedRegion();
-    const SizeValueType                          numberOfPixels = bufferedRegion.GetNumberOfPixels();
-    const bool                                   filterHandlesMemory = false;
-
-    using ImporterType = ImportImageFilter<RealType, ImageDimension>;
-    typename ImporterType::Pointer importer = ImporterType::New();
-    importer->SetImportPointer(fieldEstimate->GetBufferPointer(), numberOfPixels, filterHandlesMemory);
-    importer->SetRegion(fieldEstimate->GetBufferedRegion());
-    importer->SetOrigin(fieldEstimate->GetOrigin());
-    importer->SetSpacing(fieldEstimate->GetSpacing());
-    importer->SetDirection(identity);
-    importer->Update();
-
-    const typename ImporterType::OutputImageType * parametricFieldEstimate = importer->GetOutput();
-
-    PointSetPointer fieldPoints = PointSetType::New();
-    fieldPoints->Initialize();
-    auto & pointSTLContainer = fieldPoints->GetPoints()->CastToSTLContainer();
-    pointSTLContainer.reserve(numberOfIncludedPixels);
-    auto & pointDataSTLContainer = fieldPoints->GetPointData()->CastToSTLContainer();
-    pointDataSTLContainer.reserve(numberOfIncludedPixels);
-
-    typename BSplineFilterType::WeightsContainerType::Pointer weights = BSplineFilterType::WeightsContainerType::New();
-    weights->Initialize();
-    auto & weightSTLContainer = weights->CastToSTLContainer();
-    weightSTLContainer.reserve(numberOfIncludedPixels);
-
-    const auto          maskImageBufferRange = MakeImageBufferRange(this->GetMaskImage());
-    const auto          confidenceImageBufferRange = MakeImageBufferRange(this->GetConfidenceImage());
-    const MaskPixelType maskLabel = this->GetMaskLabel();
-    const bool          useMaskLabel = this->GetUseMaskLabel();
-
-    ImageRegionConstIteratorWithIndex<RealImageType> It(parametricFieldEstimate,
-                                                        parametricFieldEstimate->GetRequestedRegion());
-
-    for (std::size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue, ++It)
-    {
-      if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-           (!useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits<MaskPixelType>::ZeroValue())) &&
-          (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
-      {
-        PointType point;
-        parametricFieldEstimate->TransformIndexToPhysicalPoint(It.GetIndex(), point);
-
-        ScalarType scalar;
-        scalar[0] = It.Get();
-
-        pointDataSTLContainer.push_back(scalar);
-        pointSTLContainer.push_back(point);
-
-        RealType confidenceWeight = 1.0;
-        if (!confidenceImageBufferRange.empty())
-        {
-          confidenceWeight = confidenceImageBufferRange[indexValue];
-        }
-        weightSTLContainer.push_back(confidenceWeight);
-      }
-    }
-
-    typename BSplineFilterType::Pointer bspliner = BSplineFilterType::New();
-
     typename BSplineFilterType::ArrayType numberOfControlPoints;
-    typename BSplineFilterType::ArrayType numberOfFittingLevels;
-    numberOfFittingLevels.Fill(1);
     for (unsigned int d = 0; d < ImageDimension; d++)
     {
       if (!this->m_LogBiasFieldControlPointLattice)
@@ -558,24 +532,114 @@ CLANG_SUPPRESS_Wfloat_equal
       }
     }
 
-    typename ScalarImageType::PointType parametricOrigin = fieldEstimate->GetOrigin();
-    for (unsigned int d = 0; d < ImageDimension; d++)
+    typename BiasFieldControlPointLatticeType::Pointer phiLattice;
+
+    if (this->m_UseGridFitting)
     {
-      parametricOrigin[d] += (fieldEstimate->GetSpacing()[d] * fieldEstimate->GetLargestPossibleRegion().GetIndex()[d]);
+      phiLattice = this->FitBiasFieldOnImageGrid(fieldEstimate, numberOfControlPoints);
     }
-    bspliner->SetOrigin(parametricOrigin);
-    bspliner->SetSpacing(fieldEstimate->GetSpacing());
-    bspliner->SetSize(fieldEstimate->GetLargestPossibleRegion().GetSize());
-    bspliner->SetDirection(fieldEstimate->GetDirection());
-    bspliner->SetGenerateOutputImage(false);
-    bspliner->SetNumberOfLevels(numberOfFittingLevels);
-    bspliner->SetSplineOrder(this->m_SplineOrder);
-    bspliner->SetNumberOfControlPoints(numberOfControlPoints);
-    bspliner->SetInput(fieldPoints);
-    bspliner->SetPointWeights(weights);
-    bspliner->Update();
+    else
+    {
+      // Temporarily set the direction cosine to identity since the B-spline
+      // approximation algorithm works in parametric space and not physical
+      // space.
+      typename ScalarImageType::DirectionType identity;
+      identity.SetIdentity();
+
+      const typename ScalarImageType::RegionType & bufferedRegion = fieldEstimate->GetBufferedRegion();
+      const SizeValueType                          numberOfPixels = bufferedRegion.GetNumberOfPixels();
+      const bool                                   filterHandlesMemory = false;
+
+      using ImporterType = ImportImageFilter<RealType, ImageDimension>;
+      typename ImporterType::Pointer importer = ImporterType::New();
+      importer->SetImportPointer(fieldEstimate->GetBufferPointer(), numberOfPixels, filterHandlesMemory);
+      importer->SetRegion(fieldEstimate->GetBufferedRegion());
+      importer->SetOrigin(fieldEstimate->GetOrigin());
+      importer->SetSpacing(fieldEstimate->GetSpacing());
+      importer->SetDirection(identity);
+      importer->Update();
+
+      const typename ImporterType::OutputImageType * parametricFieldEstimate = importer->GetOutput();
+
+      PointSetPointer fieldPoints = PointSetType::New();
+      fieldPoints->Initialize();
+      auto & pointSTLContainer = fieldPoints->GetPoints()->CastToSTLContainer();
+      pointSTLContainer.reserve(numberOfIncludedPixels);
+      auto & pointDataSTLContainer = fieldPoints->GetPointData()->CastToSTLContainer();
+      pointDataSTLContainer.reserve(numberOfIncludedPixels);
+
+      typename BSplineFilterType::WeightsContainerType::Pointer weights =
+        BSplineFilterType::WeightsContainerType::New();
+      weights->Initialize();
+      auto & weightSTLContainer = weights->CastToSTLContainer();
+      weightSTLContainer.reserve(numberOfIncludedPixels);
+
+      const auto          maskImageBufferRange = MakeImageBufferRange(this->GetMaskImage());
+      const auto          confidenceImageBufferRange = MakeImageBufferRange(this->GetConfidenceImage());
+      const MaskPixelType maskLabel = this->GetMaskLabel();
+      const bool          useMaskLabel = this->GetUseMaskLabel();
+
+      ImageRegionConstIteratorWithIndex<RealImageType> It(parametricFieldEstimate,
+                                                          parametricFieldEstimate->GetRequestedRegion());
+
+      for (std::size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue, ++It)
+      {
+        bool isSampled = true;
+        for (unsigned int d = 0; d < ImageDimension; d++)
+        {
+          if ((It.GetIndex()[d] - bufferedRegion.GetIndex()[d]) % this->m_FittingSubsamplingFactor != 0)
+          {
+            isSampled = false;
+          }
+        }
+        if (isSampled &&
+            (maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
+             (!useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits<MaskPixelType>::ZeroValue())) &&
+            (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
+        {
+          PointType point;
+          parametricFieldEstimate->TransformIndexToPhysicalPoint(It.GetIndex(), point);
+
+          ScalarType scalar;
+          scalar[0] = It.Get();
+
+          pointDataSTLContainer.push_back(scalar);
+          pointSTLContainer.push_back(point);
 
-    typename BiasFieldControlPointLatticeType::Pointer phiLattice = bspliner->GetPhiLattice();
+          RealType confidenceWeight = 1.0;
+          if (!confidenceImageBufferRange.empty())
+          {
+            confidenceWeight = confidenceImageBufferRange[indexValue];
+          }
+          weightSTLContainer.push_back(confidenceWeight);
+        }
+      }
+
+      typename BSplineFilterType::Pointer bspliner = BSplineFilterType::New();
+
+      typename BSplineFilterType::ArrayType numberOfFittingLevels;
+      numberOfFittingLevels.Fill(1);
+
+      typename ScalarImageType::PointType parametricOrigin = fieldEstimate->GetOrigin();
+      for (unsigned int d = 0; d < ImageDimension; d++)
+      {
+        parametricOrigin[d] +=
+          (fieldEstimate->GetSpacing()[d] * fieldEstimate->GetLargestPossibleRegion().GetIndex()[d]);
+      }
+      bspliner->SetOrigin(parametricOrigin);
+      bspliner->SetSpacing(fieldEstimate->GetSpacing());
+      bspliner->SetSize(fieldEstimate->GetLargestPossibleRegion().GetSize());
+      bspliner->SetDirection(fieldEstimate->GetDirection());
+      bspliner->SetGenerateOutputImage(false);
+      bspliner->SetNumberOfLevels(numberOfFittingLevels);
+      bspliner->SetSplineOrder(this->m_SplineOrder);
+      bspliner->SetNumberOfControlPoints(numberOfControlPoints);
+      bspliner->SetInput(fieldPoints);
+      bspliner->SetPointWeights(weights);
+      bspliner->Update();
+
+      phiLattice = bspliner->GetPhiLattice();
+    }
 
     // Add the bias field control points to the current estimate.
 
@@ -606,6 +670,281 @@ CLANG_SUPPRESS_Wfloat_equal
     return smoothField;
   }
 
+  template <typename TInputImage, typename TMaskImage, typename TOutputImage>
+  auto N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::FitBiasFieldOnImageGrid(
+    const RealImageType * fieldEstimate, const ArrayType & numberOfControlPoints) const ->
+    typename BiasFieldControlPointLatticeType::Pointer
+  {
+    using RegionType = typename RealImageType::RegionType;
+    using IndexType = typename RealImageType::IndexType;
+
+    const RegionType & bufferedRegion = fieldEstimate->GetBufferedRegion();
+    const RegionType & largestRegion = fieldEstimate->GetLargestPossibleRegion();
+    const unsigned int splineOrder = this->m_SplineOrder;
+    const unsigned int supportSize = splineOrder + 1;
+    const unsigned int subsamplingFactor = this->m_FittingSubsamplingFactor;
+    const RealType     bsplineEpsilon = static_cast<RealType>(1e-3);
+
+    // The parametric coordinates map the first and the last voxels of each
+    // dimension to the ends of the lattice.
+    for (unsigned int d = 0; d < ImageDimension; d++)
+    {
+      if (largestRegion.GetSize()[d] < 2)
+      {
+        itkExceptionMacro("Fitting the bias field on the image grid requires at least 2 voxels along each dimension, "
+                          "but the size of the image is "
+                          << largestRegion.GetSize() << ".");
+      }
+    }
+
+    KernelFunctionBase<double>::Pointer kernel;
+    switch (splineOrder)
+    {
+      case 0:
+        kernel = BSplineKernelFunction<0>::New().GetPointer();
+        break;
+      case 1:
+        kernel = BSplineKernelFunction<1>::New().GetPointer();
+        break;
+      case 2:
+        kernel = BSplineKernelFunction<2>::New().GetPointer();
+        break;
+      case 3:
+        kernel = BSplineKernelFunction<3>::New().GetPointer();
+        break;
+      default:
+      {
+        const auto coxDeBoorKernel = CoxDeBoorBSplineKernelFunction<3>::New();
+        coxDeBoorKernel->SetSplineOrder(splineOrder);
+        kernel = coxDeBoorKernel.GetPointer();
+        break;
+      }
+    }
+
+    // Each voxel is a point of the scattered data approximation.  Along each
+    // dimension, the parametric coordinate of a voxel, and therefore its span
+    // and its B-spline weights, only depend on its index: tabulate them once,
+    // with the same clamping of the coordinates as the scattered data filter.
+    // The sum of the squared weights of the support of a voxel is the product
+    // of the sums along each dimension.
+    std::vector<unsigned int> spans[ImageDimension];
+    std::vector<RealType>     weights[ImageDimension];
+    std::vector<RealType>     squaredWeightSums[ImageDimension];
+    OffsetValueType           latticeStrides[ImageDimension];
+    SizeValueType             numberOfLatticePoints = 1;
+    typename BiasFieldControlPointLatticeType::SizeType latticeSize;
+
+    for (unsigned int d = 0; d < ImageDimension; d++)
+    {
+      latticeSize[d] = numberOfControlPoints[d];
+      latticeStrides[d] = static_cast<OffsetValueType>(numberOfLatticePoints);
+      numberOfLatticePoints *= latticeSize[d];
+
+      const unsigned int totalNumberOfSpans = numberOfControlPoints[d] - splineOrder;
+      const RealType     r =
+        static_cast<RealType>(totalNumberOfSpans) / static_cast<RealType>(largestRegion.GetSize()[d] - 1);
+      const RealType      epsilon = r * bsplineEpsilon;
+      const SizeValueType size = bufferedRegion.GetSize()[d];
+
+      spans[d].resize(size);
+      weights[d].resize(size * supportSize);
+      squaredWeightSums[d].assign(size, 0.0);
+      for (SizeValueType j = 0; j < size; j++)
+      {
+        RealType p = r * static_cast<RealType>(bufferedRegion.GetIndex()[d] + static_cast<OffsetValueType>(j) -
+                                               largestRegion.GetIndex()[d]);
+        if (std::abs(p - static_cast<RealType>(totalNumberOfSpans)) <= epsilon)
+        {
+          p = static_cast<RealType>(totalNumberOfSpans) - epsilon;
+        }
+        if (p < NumericTraits<RealType>::ZeroValue() && std::abs(p) <= epsilon)
+        {
+          p = NumericTraits<RealType>::ZeroValue();
+        }
+        if (p < NumericTraits<RealType>::ZeroValue() || p >= static_cast<RealType>(totalNumberOfSpans))
+        {
+          itkExceptionMacro("The reparameterized point component "
+                            << p << " is outside the corresponding parametric domain of [0, " << totalNumberOfSpans
+                            << ").");
+        }
+
+        spans[d][j] = static_cast<unsigned int>(p);
+        for (unsigned int k = 0; k < supportSize; k++)
+        {
+          const RealType u = p - static_cast<RealType>(spans[d][j] + k) +
+                             static_cast<RealType>(0.5) * (static_cast<RealType>(splineOrder) - 1);
+          const auto     B = static_cast<RealType>(kernel->Evaluate(u));
+          weights[d][j * supportSize + k] = B;
+          squaredWeightSums[d][j] += B * B;
+        }
+      }
+    }
+
+    // The support of a voxel, with the first dimension varying fastest.
+    SizeValueType numberOfSupportPoints = 1;
+    for (unsigned int d = 0; d < ImageDimension; d++)
+    {
+      numberOfSupportPoints *= supportSize;
+    }
+    const SizeValueType          numberOfSupportLines = numberOfSupportPoints / supportSize;
+    std::vector<unsigned int>    supportIndices(numberOfSupportPoints * ImageDimension);
+    std::vector<OffsetValueType> supportOffsets(numberOfSupportPoints);
+    for (SizeValueType s = 0; s < numberOfSupportPoints; s++)
+    {
+      SizeValueType remainder = s;
+      supportOffsets[s] = 0;
+      for (unsigned int d = 0; d < ImageDimension; d++)
+      {
+        supportIndices[s * ImageDimension + d] = static_cast<unsigned int>(remainder % supportSize);
+        supportOffsets[s] += supportIndices[s * ImageDimension + d] * latticeStrides[d];
+        remainder /= supportSize;
+      }
+    }
+
+    const auto          maskImageBufferRange = MakeImageBufferRange(this->GetMaskImage());
+    const auto          confidenceImageBufferRange = MakeImageBufferRange(this->GetConfidenceImage());
+    const MaskPixelType maskLabel = this->GetMaskLabel();
+    const bool          useMaskLabel = this->GetUseMaskLabel();
+    const RealType *    fieldEstimateBuffer = fieldEstimate->GetBufferPointer();
+
+    // Accumulate the numerator (delta) and the denominator (omega) of the
+    // control point values over slabs of the image, each slab in its own
+    // lattices so that the result does not depend on the scheduling.
+    const auto         splitter = ImageRegionSplitterSlowDimension::New();
+    const unsigned int numberOfSlabs = splitter->GetNumberOfSplits(bufferedRegion, this->GetNumberOfWorkUnits());
+
+    std::vector<RealType> deltaLattices(numberOfSlabs * numberOfLatticePoints, 0.0);
+    std::vector<RealType> omegaLattices(numberOfSlabs * numberOfLatticePoints, 0.0);
+
+    const auto fitSlab = [&](SizeValueType slab) {
+      RegionType slabRegion = bufferedRegion;
+      splitter->GetSplit(static_cast<unsigned int>(slab), numberOfSlabs, slabRegion);
+
+      RealType * delta = deltaLattices.data() + slab * numberOfLatticePoints;
+      RealType * omega = omegaLattices.data() + slab * numberOfLatticePoints;
+
+      // Weights of the support lines, i.e. the product of the weights along
+      // all the dimensions but the first one, which are constant along an
+      // image line.
+      std::vector<RealType> lineWeights(numberOfSupportLines);
+
+      const SizeValueType lineLength = slabRegion.GetSize()[0];
+      for (ImageScanlineConstIterator<RealImageType> It(fieldEstimate, slabRegion); !It.IsAtEnd(); It.NextLine())
+      {
+        const IndexType lineIndex = It.GetIndex();
+
+        SizeValueType   j[ImageDimension];
+        OffsetValueType lineLatticeOffset = 0;
+        RealType        lineSquaredWeightSum = 1.0;
+        bool            isSampled = true;
+        for (unsigned int d = 0; d < ImageDimension; d++)
+        {
+          j[d] = static_cast<SizeValueType>(lineIndex[d] - bufferedRegion.GetIndex()[d]);
+          if (d > 0)
+          {
+            isSampled = isSampled && (j[d] % subsamplingFactor == 0);
+            lineLatticeOffset += spans[d][j[d]] * latticeStrides[d];
+            lineSquaredWeightSum *= squaredWeightSums[d][j[d]];
+          }
+        }
+        if (!isSampled)
+        {
+          continue;
+        }
+
+        for (SizeValueType l = 0; l < numberOfSupportLines; l++)
+        {
+          const unsigned int * k = &supportIndices[l * supportSize * ImageDimension];
+          RealType             B = 1.0;
+          for (unsigned int d = 1; d < ImageDimension; d++)
+          {
+            B *= weights[d][j[d] * supportSize + k[d]];
+          }
+          lineWeights[l] = B;
+        }
+
+        const auto          lineOffset = static_cast<std::size_t>(fieldEstimate->ComputeOffset(lineIndex));
+        const SizeValueType firstSample = (j[0] + subsamplingFactor - 1) / subsamplingFactor * subsamplingFactor;
+        for (SizeValueType j0 = firstSample; j0 < j[0] + lineLength; j0 += subsamplingFactor)
+        {
+          const std::size_t indexValue = lineOffset + (j0 - j[0]);
+          if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
+               (!useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits<MaskPixelType>::ZeroValue())) &&
+              (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
+          {
+            RealType confidenceWeight = 1.0;
+            if (!confidenceImageBufferRange.empty())
+            {
+              confidenceWeight = confidenceImageBufferRange[indexValue];
+            }
+            const RealType        w2Sum = lineSquaredWeightSum * squaredWeightSums[0][j0];
+            const RealType        scaledValue = fieldEstimateBuffer[indexValue] * confidenceWeight / w2Sum;
+            const RealType *      voxelWeights = &weights[0][j0 * supportSize];
+            const OffsetValueType voxelLatticeOffset = lineLatticeOffset + spans[0][j0];
+
+            for (SizeValueType s = 0; s < numberOfSupportPoints; s++)
+            {
+              const RealType        B = voxelWeights[supportIndices[s * ImageDimension]] * lineWeights[s / supportSize];
+              const OffsetValueType latticeOffset = voxelLatticeOffset + supportOffsets[s];
+              omega[latticeOffset] += confidenceWeight * B * B;
+              delta[latticeOffset] += scaledValue * B * B * B;
+            }
+          }
+        }
+      }
+    };
+    this->GetMultiThreader()->ParallelizeArray(0, numberOfSlabs, fitSlab, nullptr);
+
+    // Sum the lattices of the slabs, in order, and compute the control point
+    // values.
+    typename BiasFieldControlPointLatticeType::Pointer phiLattice = BiasFieldControlPointLatticeType::New();
+    phiLattice->SetRegions(latticeSize);
+    phiLattice->Allocate();
+
+    ScalarType * phi = phiLattice->GetBufferPointer();
+    for (SizeValueType n = 0; n < numberOfLatticePoints; n++)
+    {
+      RealType delta = deltaLattices[n];
+      RealType omega = omegaLattices[n];
+      for (unsigned int slab = 1; slab < numberOfSlabs; slab++)
+      {
+        delta += deltaLattices[slab * numberOfLatticePoints + n];
+        omega += omegaLattices[slab * numberOfLatticePoints + n];
+      }
+
+      phi[n].Fill(0.0);
+      if (Math::NotAlmostEquals(omega, NumericTraits<RealType>::ZeroValue()))
+      {
+        const RealType P = delta / omega;
+        if (!itk::Math::isnan(P) && !itk::Math::isinf(P))
+        {
+          phi[n][0] = P;
+        }
+      }
+    }
+
+    // Same parametric domain as the lattice of the scattered data filter.
+    typename BiasFieldControlPointLatticeType::PointType   origin;
+    typename BiasFieldControlPointLatticeType::SpacingType spacing;
+    for (unsigned int d = 0; d < ImageDimension; d++)
+    {
+      const RealType domain =
+        fieldEstimate->GetSpacing()[d] * static_cast<RealType>(largestRegion.GetSize()[d] - 1);
+      spacing[d] = domain / static_cast<RealType>(numberOfControlPoints[d] - splineOrder);
+      origin[d] = -0.5 * spacing[d] * (static_cast<RealType>(splineOrder) - 1);
+    }
+    origin = fieldEstimate->GetDirection() * origin;
+    for (unsigned int d = 0; d < ImageDimension; d++)
+    {
+      origin[d] += fieldEstimate->GetOrigin()[d] + fieldEstimate->GetSpacing()[d] * largestRegion.GetIndex()[d];
+    }
+    phiLattice->SetOrigin(origin);
+    phiLattice->SetSpacing(spacing);
+    phiLattice->SetDirection(fieldEstimate->GetDirection());
+
+    return phiLattice;
+  }
+
   template <typename TInputImage, typename TMaskImage, typename TOutputImage>
   typename N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::RealImagePointer
   N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::ReconstructBiasField(
@@ -702,6 +1041,8 @@ CLANG_SUPPRESS_Wfloat_equal
     os << indent << "Spline order: " << this->m_SplineOrder << std::endl;
     os << indent << "Number of fitting levels: " << this->m_NumberOfFittingLevels << std::endl;
     os << indent << "Number of control points: " << this->m_NumberOfControlPoints << std::endl;
+    os << indent << "Use grid fitting: " << this->m_UseGridFitting << std::endl;
+    os << indent << "Fitting subsampling factor: " << this->m_FittingSubsamplingFactor << std::endl;
     os << indent << "CurrentConvergenceMeasurement: " << this->m_CurrentConvergenceMeasurement << std::endl;
     os << indent << "CurrentLevel: " << this->m_CurrentLevel << std::endl;
     os << indent << "ElapsedIterations: " << this->m_ElapsedIterations << std::endl;
@@ -0,0 +1,223 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkN4BiasFieldCorrectionImageFilter.h"
+#include "itkTestingMacros.h"
+
+//
+// Corrects a synthetic image corrupted by a smooth bias field, and checks
+// that the B-spline fitting computed on the image grid gives the same control
+// point lattice as the fitting of the point set of the included voxels, with
+// and without subsampling of the voxels. Also checks that the grid fitting
+// rejects an image with a single voxel along a dimension.
+//
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using ImageType = itk::Image<float, Dimension>;
+using MaskImageType = itk::Image<unsigned char, Dimension>;
+using CorrecterType = itk::N4BiasFieldCorrectionImageFilter<ImageType, MaskImageType, ImageType>;
+using LatticeType = CorrecterType::BiasFieldControlPointLatticeType;
+
+void
+CreateImages(ImageType::Pointer & image, MaskImageType::Pointer & mask, CorrecterType::RealImagePointer & confidence)
+{
+  ImageType::RegionType region;
+  region.SetIndex({ { 3, -2, 5 } });
+  region.SetSize({ { 41, 36, 30 } });
+
+  ImageType::SpacingType spacing;
+  spacing[0] = 1.0;
+  spacing[1] = 1.5;
+  spacing[2] = 2.0;
+
+  ImageType::PointType origin;
+  origin[0] = -10.0;
+  origin[1] = 5.0;
+  origin[2] = 2.5;
+
+  ImageType::DirectionType direction;
+  direction.Fill(0.0);
+  direction[0][1] = 1.0;
+  direction[1][0] = -1.0;
+  direction[2][2] = 1.0;
+
+  image = ImageType::New();
+  mask = MaskImageType::New();
+  confidence = CorrecterType::RealImageType::New();
+  image->SetRegions(region);
+  image->SetSpacing(spacing);
+  image->SetOrigin(origin);
+  image->SetDirection(direction);
+  image->Allocate();
+  mask->CopyInformation(image);
+  mask->SetRegions(region);
+  mask->Allocate();
+  confidence->CopyInformation(image);
+  confidence->SetRegions(region);
+  confidence->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> It(image, region);
+  for (; !It.IsAtEnd(); ++It)
+  {
+    const ImageType::IndexType index = It.GetIndex();
+    double                     squaredRadius = 0.0;
+    double                     bias = 0.0;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      const double x = static_cast<double>(index[d] - region.GetIndex(d)) / (region.GetSize(d) - 1) - 0.5;
+      squaredRadius += 4.0 * x * x;
+      bias += 0.2 * (d + 1) * x * x - 0.15 * x;
+    }
+    const double tissue = (index[0] + index[1] + index[2]) % 7 < 3 ? 100.0 : 60.0;
+    It.Set(static_cast<float>(tissue * std::exp(bias)));
+    mask->SetPixel(index, squaredRadius < 0.8 ? 1 : 0);
+    confidence->SetPixel(index, static_cast<float>(0.5 + 0.5 * squaredRadius));
+  }
+}
+
+LatticeType::Pointer
+Correct(const ImageType *                    image,
+        const MaskImageType *                mask,
+        const CorrecterType::RealImageType * confidence,
+        bool                                 useGridFitting,
+        unsigned int                         subsamplingFactor)
+{
+  const auto correcter = CorrecterType::New();
+  correcter->SetInput(image);
+  correcter->SetMaskImage(mask);
+  correcter->SetConfidenceImage(confidence);
+  correcter->SetConvergenceThreshold(0.0);
+
+  CorrecterType::VariableSizeArrayType maximumNumberOfIterations(2);
+  maximumNumberOfIterations.Fill(5);
+  correcter->SetMaximumNumberOfIterations(maximumNumberOfIterations);
+
+  CorrecterType::ArrayType numberOfFittingLevels;
+  numberOfFittingLevels.Fill(2);
+  correcter->SetNumberOfFittingLevels(numberOfFittingLevels);
+
+  CorrecterType::ArrayType numberOfControlPoints;
+  numberOfControlPoints[0] = 4;
+  numberOfControlPoints[1] = 5;
+  numberOfControlPoints[2] = 6;
+  correcter->SetNumberOfControlPoints(numberOfControlPoints);
+
+  correcter->SetUseGridFitting(useGridFitting);
+  correcter->SetFittingSubsamplingFactor(subsamplingFactor);
+  correcter->Update();
+
+  LatticeType::Pointer lattice = const_cast<LatticeType *>(correcter->GetLogBiasFieldControlPointLattice());
+  return lattice;
+}
+
+bool
+CompareLattices(const LatticeType * lattice, const LatticeType * expected, double tolerance, const char * description)
+{
+  if (lattice->GetLargestPossibleRegion() != expected->GetLargestPossibleRegion())
+  {
+    std::cerr << description << ": the lattice regions differ." << std::endl;
+    return false;
+  }
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    if (itk::Math::abs(lattice->GetOrigin()[d] - expected->GetOrigin()[d]) > 1e-6 ||
+        itk::Math::abs(lattice->GetSpacing()[d] - expected->GetSpacing()[d]) > 1e-6)
+    {
+      std::cerr << description << ": the lattice geometries differ." << std::endl;
+      return false;
+    }
+  }
+
+  itk::ImageRegionConstIterator<LatticeType> It(lattice, lattice->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<LatticeType> ItE(expected, expected->GetLargestPossibleRegion());
+  for (; !It.IsAtEnd(); ++It, ++ItE)
+  {
+    if (itk::Math::abs(It.Get()[0] - ItE.Get()[0]) > tolerance)
+    {
+      std::cerr << description << ": control point " << It.GetIndex() << " is " << It.Get()[0] << " instead of "
+                << ItE.Get()[0] << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkN4BiasFieldCorrectionImageFilterGridFittingTest(int, char *[])
+{
+  ImageType::Pointer              image;
+  MaskImageType::Pointer          mask;
+  CorrecterType::RealImagePointer confidence;
+  CreateImages(image, mask, confidence);
+
+  const auto correcter = CorrecterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(correcter, N4BiasFieldCorrectionImageFilter, ImageToImageFilter);
+
+  ITK_TEST_EXPECT_TRUE(!correcter->GetUseGridFitting());
+  ITK_TEST_SET_GET_BOOLEAN(correcter, UseGridFitting, true);
+  ITK_TEST_SET_GET_VALUE(1u, correcter->GetFittingSubsamplingFactor());
+  correcter->SetFittingSubsamplingFactor(0);
+  ITK_TEST_SET_GET_VALUE(1u, correcter->GetFittingSubsamplingFactor());
+
+  constexpr double tolerance = 1e-4;
+  bool             success = true;
+
+  for (const unsigned int subsamplingFactor : { 1u, 2u })
+  {
+    const LatticeType::Pointer pointSetLattice = Correct(image, mask, confidence, false, subsamplingFactor);
+    const LatticeType::Pointer gridLattice = Correct(image, mask, confidence, true, subsamplingFactor);
+    if (!CompareLattices(gridLattice, pointSetLattice, tolerance, "Grid fitting"))
+    {
+      std::cerr << "  with a subsampling factor of " << subsamplingFactor << std::endl;
+      success = false;
+    }
+  }
+
+  // Subsampling the voxels only changes the bias field slightly.
+  const LatticeType::Pointer lattice = Correct(image, mask, confidence, true, 1);
+  const LatticeType::Pointer subsampledLattice = Correct(image, mask, confidence, true, 2);
+  if (!CompareLattices(subsampledLattice, lattice, 0.05, "Subsampled grid fitting"))
+  {
+    success = false;
+  }
+
+  // A single slice: the lattice can not be mapped onto the third dimension.
+  ImageType::RegionType sliceRegion = image->GetLargestPossibleRegion();
+  sliceRegion.SetSize(2, 1);
+  const auto slice = ImageType::New();
+  slice->CopyInformation(image);
+  slice->SetRegions(sliceRegion);
+  slice->Allocate();
+  slice->FillBuffer(100.0f);
+  const auto sliceCorrecter = CorrecterType::New();
+  sliceCorrecter->SetInput(slice);
+  sliceCorrecter->SetUseGridFitting(true);
+  ITK_TRY_EXPECT_EXCEPTION(sliceCorrecter->Update());
+
+  if (!success)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
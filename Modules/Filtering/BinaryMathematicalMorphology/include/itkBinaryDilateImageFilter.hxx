@@ -40,6 +40,13 @@ template <typename TInputImage, typename TOutputImage, typename TKernel>
 void
 BinaryDilateImageFilter<TInputImage, TOutputImage, TKernel>::GenerateData()
 {
+  // Decomposable kernels are processed line by line, or chord by chord.
+  if (this->CanUseKernelDecomposition(true))
+  {
+    this->GenerateDataUsingKernelDecomposition(true);
+    return;
+  }
+
   this->AllocateOutputs();
 
   unsigned int i, j;
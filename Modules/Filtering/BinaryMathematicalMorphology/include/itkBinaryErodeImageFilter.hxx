@@ -40,6 +40,13 @@ template <typename TInputImage, typename TOutputImage, typename TKernel>
 void
 BinaryErodeImageFilter<TInputImage, TOutputImage, TKernel>::GenerateData()
 {
+  // Decomposable kernels are processed line by line.
+  if (this->CanUseKernelDecomposition(false))
+  {
+    this->GenerateDataUsingKernelDecomposition(false);
+    return;
+  }
+
   this->AllocateOutputs();
 
   unsigned int i, j;
@@ -25,6 +25,7 @@
 #include "itkImageBoundaryCondition.h"
 #include "itkImageRegionIterator.h"
 #include "itkConceptChecking.h"
+#include "itkFlatStructuringElement.h"
 
 namespace itk
 {
@@ -96,6 +97,23 @@ namespace itk
  * portions of these two implementations were then placed in this
  * superclass.
  *
+ * When UseKernelDecomposition is on, which is the default, the subclasses
+ * do not use the algorithm above for the kernels that can be decomposed,
+ * and work on a binary mask with multithreaded one-dimensional operations:
+ * - a FlatStructuringElement decomposed into lines along the axes and the
+ *   diagonals (a box, or a polygon with 4 lines in 2D) is applied as a
+ *   sequence of line operations, one per line of the decomposition, using
+ *   the van Herk/Gil-Werman algorithm. Its cost per pixel does not depend on
+ *   the size of the kernel.
+ * - any other kernel that contains its center, such as a ball, is applied
+ *   through its chords, the runs of ON elements along the first axis.
+ *   Counting the foreground pixels of the mask along its lines tells in
+ *   constant time whether a chord hits the foreground (dilation) or lies in
+ *   it (erosion), so the cost per pixel is at most the number of chords
+ *   instead of the number of ON elements.
+ *
+ * Both give the same result as the algorithm above.
+ *
  * \sa ImageToImageFilter BinaryErodeImageFilter BinaryDilateImageFilter
  * \ingroup ITKBinaryMathematicalMorphology
  */
@@ -177,6 +195,13 @@ public:
   itkGetConstReferenceMacro(BoundaryToForeground, bool);
   itkBooleanMacro(BoundaryToForeground);
 
+  /** Get/Set whether the kernels that can be decomposed into lines or into
+   * chords are applied through their decomposition. The result is the same
+   * either way. Defaults to true. */
+  itkSetMacro(UseKernelDecomposition, bool);
+  itkGetConstMacro(UseKernelDecomposition, bool);
+  itkBooleanMacro(UseKernelDecomposition);
+
   /** Set kernel (structuring element). */
   void
   SetKernel(const KernelType & kernel) override;
@@ -192,6 +217,35 @@ protected:
   void
   AnalyzeKernel();
 
+  /** Flat structuring element type, whose decomposition into lines may be
+   * used to speed up the dilation and the erosion. */
+  using FlatKernelType = FlatStructuringElement<KernelDimension>;
+
+  /** Binary mask type of the decomposed operations. */
+  using MaskImageType = Image<unsigned char, InputImageDimension>;
+
+  /** Returns true if the kernel is a FlatStructuringElement that can be
+   * decomposed into lines along the axes and the diagonals. */
+  bool
+  IsKernelDecomposable() const;
+
+  /** Returns true if the kernel contains its center, so that it can be
+   * applied through its chords. */
+  bool
+  IsKernelChordDecomposable() const;
+
+  /** Returns true if the dilation (or the erosion, if dilate is false) can
+   * be performed by GenerateDataUsingKernelDecomposition(). */
+  bool
+  CanUseKernelDecomposition(bool dilate) const;
+
+  /** Performs the dilation (or the erosion, if dilate is false) of the
+   * foreground with multithreaded one-dimensional operations, along the
+   * lines or the chords of the kernel. Requires
+   * CanUseKernelDecomposition(dilate). Allocates the outputs. */
+  void
+  GenerateDataUsingKernelDecomposition(bool dilate);
+
   /** Type definition of container of neighbourhood index */
   using NeighborIndexContainer = std::vector<OffsetType>;
 
@@ -237,6 +291,13 @@ private:
   /** Pixel value for background */
   OutputPixelType m_BackgroundValue;
 
+  bool m_UseKernelDecomposition{ true };
+
+  /** Dilates (or erodes) the mask along the chords of the kernel. The mask
+   * must cover the output region padded by the kernel radius. */
+  typename MaskImageType::Pointer
+  ApplyKernelChords(const MaskImageType * mask, const OutputImageRegionType & outputRegion, bool dilate);
+
   /** Difference sets definition */
   NeighborIndexContainerContainer m_KernelDifferenceSets;
 
@@ -21,10 +21,15 @@
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkNeighborhoodInnerProduct.h"
 #include "itkImageRegionConstIterator.h"
+#include "itkImageScanlineIterator.h"
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkConstantBoundaryCondition.h"
 #include "itkOffset.h"
 #include "itkProgressReporter.h"
+#include "itkProgressAccumulator.h"
+#include "itkMath.h"
+#include "itkVanHerkGilWermanDilateImageFilter.h"
+#include "itkVanHerkGilWermanErodeImageFilter.h"
 #include "itkBinaryMorphologyImageFilter.h"
 
 namespace itk
@@ -320,6 +325,302 @@ BinaryMorphologyImageFilter<TInputImage, TOutputImage, TKernel>::AnalyzeKernel()
   }
 }
 
+template <typename TInputImage, typename TOutputImage, typename TKernel>
+bool
+BinaryMorphologyImageFilter<TInputImage, TOutputImage, TKernel>::IsKernelDecomposable() const
+{
+  const auto * flatKernel = dynamic_cast<const FlatKernelType *>(&this->GetKernel());
+
+  if (flatKernel == nullptr || !flatKernel->GetDecomposable())
+  {
+    return false;
+  }
+
+  // The line operations only reproduce the kernel exactly for lines along
+  // the axes and the diagonals, whose nonzero components all have the same
+  // magnitude. The other lines of a polygon are rasterized differently.
+  for (const auto & line : flatKernel->GetLines())
+  {
+    double maximum = 0.0;
+    for (unsigned int d = 0; d < KernelDimension; ++d)
+    {
+      maximum = std::max(maximum, static_cast<double>(itk::Math::abs(line[d])));
+    }
+    for (unsigned int d = 0; d < KernelDimension; ++d)
+    {
+      const double magnitude = itk::Math::abs(line[d]);
+      if (magnitude > 1e-6 * maximum && magnitude < (1.0 - 1e-6) * maximum)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename TInputImage, typename TOutputImage, typename TKernel>
+bool
+BinaryMorphologyImageFilter<TInputImage, TOutputImage, TKernel>::IsKernelChordDecomposable() const
+{
+  const KernelType & kernel = this->GetKernel();
+  return kernel[kernel.Size() / 2];
+}
+
+template <typename TInputImage, typename TOutputImage, typename TKernel>
+bool
+BinaryMorphologyImageFilter<TInputImage, TOutputImage, TKernel>::CanUseKernelDecomposition(bool dilate) const
+{
+  if (!m_UseKernelDecomposition)
+  {
+    return false;
+  }
+  // The line operations do not reproduce the pixels outside the image that
+  // the dilation considers as foreground when BoundaryToForeground is on.
+  return (this->IsKernelDecomposable() && !(dilate && m_BoundaryToForeground)) || this->IsKernelChordDecomposable();
+}
+
+template <typename TInputImage, typename TOutputImage, typename TKernel>
+void
+BinaryMorphologyImageFilter<TInputImage, TOutputImage, TKernel>::GenerateDataUsingKernelDecomposition(bool dilate)
+{
+  using DilateFilterType = VanHerkGilWermanDilateImageFilter<MaskImageType, FlatKernelType>;
+  using ErodeFilterType = VanHerkGilWermanErodeImageFilter<MaskImageType, FlatKernelType>;
+
+  this->AllocateOutputs();
+
+  const InputImageType * const input = this->GetInput();
+  OutputImageType * const      output = this->GetOutput();
+  const KernelType &           kernel = this->GetKernel();
+
+  const InputPixelType  foregroundValue = m_ForegroundValue;
+  const OutputPixelType backgroundValue = m_BackgroundValue;
+  const unsigned char   boundaryValue = this->m_BoundaryToForeground ? 1 : 0;
+
+  const OutputImageRegionType outputRegion = output->GetRequestedRegion();
+
+  // The mask covers the output region padded by the kernel radius, so that
+  // the intermediate results of the successive line operations are not
+  // clipped at the border of the image.
+  InputImageRegionType maskRegion = outputRegion;
+  maskRegion.PadByRadius(kernel.GetRadius());
+
+  typename MaskImageType::Pointer mask = MaskImageType::New();
+  mask->CopyInformation(input);
+  mask->SetRegions(maskRegion);
+  mask->Allocate();
+  mask->FillBuffer(boundaryValue);
+
+  InputImageRegionType maskInputRegion = maskRegion;
+  maskInputRegion.Crop(input->GetBufferedRegion());
+
+  ProgressAccumulator::Pointer progress = ProgressAccumulator::New();
+  progress->SetMiniPipelineFilter(this);
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  multiThreader->template ParallelizeImageRegion<InputImageDimension>(
+    maskInputRegion,
+    [input, &mask, foregroundValue](const InputImageRegionType & region) {
+      ImageRegionConstIterator<InputImageType> inIt(input, region);
+      ImageRegionIterator<MaskImageType>       maskIt(mask, region);
+      for (; !inIt.IsAtEnd(); ++inIt, ++maskIt)
+      {
+        maskIt.Set(Math::ExactlyEquals(inIt.Get(), foregroundValue) ? 1 : 0);
+      }
+    },
+    nullptr);
+
+  typename MaskImageType::Pointer result;
+  if (!(this->IsKernelDecomposable() && !(dilate && m_BoundaryToForeground)))
+  {
+    result = this->ApplyKernelChords(mask, outputRegion, dilate);
+  }
+  else if (dilate)
+  {
+    typename DilateFilterType::Pointer lineFilter = DilateFilterType::New();
+    lineFilter->SetInput(mask);
+    lineFilter->SetKernel(dynamic_cast<const FlatKernelType &>(kernel));
+    lineFilter->SetBoundary(boundaryValue);
+    lineFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    progress->RegisterInternalFilter(lineFilter, 1.0f);
+    lineFilter->GetOutput()->SetRequestedRegion(outputRegion);
+    lineFilter->Update();
+    result = lineFilter->GetOutput();
+  }
+  else
+  {
+    typename ErodeFilterType::Pointer lineFilter = ErodeFilterType::New();
+    lineFilter->SetInput(mask);
+    lineFilter->SetKernel(dynamic_cast<const FlatKernelType &>(kernel));
+    lineFilter->SetBoundary(boundaryValue);
+    lineFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    progress->RegisterInternalFilter(lineFilter, 1.0f);
+    lineFilter->GetOutput()->SetRequestedRegion(outputRegion);
+    lineFilter->Update();
+    result = lineFilter->GetOutput();
+  }
+
+  // Pixels of the result are set to the foreground value. The other
+  // foreground pixels of the input are set to the background value, and the
+  // other pixels keep their input value.
+  multiThreader->template ParallelizeImageRegion<OutputImageDimension>(
+    outputRegion,
+    [input, output, &result, foregroundValue, backgroundValue](const OutputImageRegionType & region) {
+      ImageRegionConstIterator<InputImageType> inIt(input, region);
+      ImageRegionConstIterator<MaskImageType>  resultIt(result, region);
+      ImageRegionIterator<OutputImageType>     outIt(output, region);
+      for (; !outIt.IsAtEnd(); ++inIt, ++resultIt, ++outIt)
+      {
+        const InputPixelType value = inIt.Get();
+        if (resultIt.Get())
+        {
+          outIt.Set(static_cast<OutputPixelType>(foregroundValue));
+        }
+        else if (Math::ExactlyEquals(value, foregroundValue))
+        {
+          outIt.Set(backgroundValue);
+        }
+        else
+        {
+          outIt.Set(static_cast<OutputPixelType>(value));
+        }
+      }
+    },
+    nullptr);
+}
+
+template <typename TInputImage, typename TOutputImage, typename TKernel>
+typename BinaryMorphologyImageFilter<TInputImage, TOutputImage, TKernel>::MaskImageType::Pointer
+BinaryMorphologyImageFilter<TInputImage, TOutputImage, TKernel>::ApplyKernelChords(
+  const MaskImageType *         mask,
+  const OutputImageRegionType & outputRegion,
+  bool                          dilate)
+{
+  const KernelType &                         kernel = this->GetKernel();
+  const typename MaskImageType::RegionType & maskRegion = mask->GetBufferedRegion();
+  const typename MaskImageType::IndexType    maskIndex = maskRegion.GetIndex();
+  const SizeValueType                        lineLength = maskRegion.GetSize(0);
+  const SizeValueType                        numberOfLines = maskRegion.GetNumberOfPixels() / lineLength;
+
+  // Number of lines between two neighbor rows of the mask in each dimension
+  OffsetValueType lineStrides[InputImageDimension];
+  OffsetValueType lineStride = 1;
+  lineStrides[0] = 0;
+  for (unsigned int d = 1; d < InputImageDimension; ++d)
+  {
+    lineStrides[d] = lineStride;
+    lineStride *= static_cast<OffsetValueType>(maskRegion.GetSize(d));
+  }
+
+  // A chord is a run of "on" kernel elements along the first dimension:
+  // elements [begin, end) of line "lineOffset" relative to the current one.
+  // The dilation uses the reflected kernel.
+  struct Chord
+  {
+    OffsetValueType lineOffset;
+    OffsetValueType begin;
+    OffsetValueType end;
+  };
+  const auto isOn = [&kernel, dilate](SizeValueType k) -> bool {
+    return dilate ? kernel[kernel.Size() - 1 - k] : kernel[k];
+  };
+  std::vector<Chord>  chords;
+  const SizeValueType kernelLineLength = kernel.GetSize(0);
+  for (SizeValueType k = 0; k < kernel.Size(); k += kernelLineLength)
+  {
+    const OffsetType rowOffset = kernel.GetOffset(k);
+    OffsetValueType  lineOffset = 0;
+    for (unsigned int d = 1; d < InputImageDimension; ++d)
+    {
+      lineOffset += rowOffset[d] * lineStrides[d];
+    }
+    for (SizeValueType i = 0; i < kernelLineLength; ++i)
+    {
+      if (!isOn(k + i))
+      {
+        continue;
+      }
+      const OffsetValueType position = rowOffset[0] + static_cast<OffsetValueType>(i);
+      if (i > 0 && isOn(k + i - 1))
+      {
+        chords.back().end = position + 1;
+      }
+      else
+      {
+        chords.push_back(Chord{ lineOffset, position, position + 1 });
+      }
+    }
+  }
+
+  // Exclusive prefix counts of the foreground pixels along each line of the
+  // mask, so that a chord is counted in constant time.
+  const SizeValueType       countLength = lineLength + 1;
+  std::vector<unsigned int> counts(numberOfLines * countLength);
+  const unsigned char *     maskBuffer = mask->GetBufferPointer();
+  unsigned int *            countBuffer = counts.data();
+  MultiThreaderBase *       multiThreader = this->GetMultiThreader();
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfLines,
+    [maskBuffer, countBuffer, lineLength, countLength](SizeValueType line) {
+      const unsigned char * maskLine = maskBuffer + line * lineLength;
+      unsigned int *        countLine = countBuffer + line * countLength;
+      countLine[0] = 0;
+      for (SizeValueType i = 0; i < lineLength; ++i)
+      {
+        countLine[i + 1] = countLine[i] + maskLine[i];
+      }
+    },
+    nullptr);
+
+  typename MaskImageType::Pointer result = MaskImageType::New();
+  result->CopyInformation(mask);
+  result->SetRegions(outputRegion);
+  result->Allocate();
+
+  multiThreader->template ParallelizeImageRegion<InputImageDimension>(
+    outputRegion,
+    [&](const OutputImageRegionType & region) {
+      ImageScanlineIterator<MaskImageType> it(result, region);
+      while (!it.IsAtEnd())
+      {
+        const typename MaskImageType::IndexType lineIndex = it.GetIndex();
+        OffsetValueType                         line = 0;
+        for (unsigned int d = 1; d < InputImageDimension; ++d)
+        {
+          line += (lineIndex[d] - maskIndex[d]) * lineStrides[d];
+        }
+        const unsigned int * countLine = countBuffer + line * countLength + (lineIndex[0] - maskIndex[0]);
+        while (!it.IsAtEndOfLine())
+        {
+          bool on = !dilate;
+          for (const Chord & chord : chords)
+          {
+            const unsigned int * chordCounts = countLine + chord.lineOffset * static_cast<OffsetValueType>(countLength);
+            const unsigned int   count = chordCounts[chord.end] - chordCounts[chord.begin];
+            if (dilate && count > 0)
+            {
+              on = true;
+              break;
+            }
+            if (!dilate && count != static_cast<unsigned int>(chord.end - chord.begin))
+            {
+              on = false;
+              break;
+            }
+          }
+          it.Set(on ? 1 : 0);
+          ++it;
+          ++countLine;
+        }
+        it.NextLine();
+      }
+    },
+    this);
+
+  return result;
+}
+
 /**
  * Standard "PrintSelf" method
  */
@@ -335,6 +636,7 @@ BinaryMorphologyImageFilter<TInputImage, TOutput, TKernel>::PrintSelf(std::ostre
      << "Background Value: " << static_cast<typename NumericTraits<OutputPixelType>::PrintType>(m_BackgroundValue)
      << std::endl;
   os << indent << "BoundaryToForeground: " << m_BoundaryToForeground << std::endl;
+  os << indent << "UseKernelDecomposition: " << m_UseKernelDecomposition << std::endl;
 }
 } // end namespace itk
 
@@ -0,0 +1,213 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBinaryDilateImageFilter.h"
+#include "itkBinaryErodeImageFilter.h"
+#include "itkFlatStructuringElement.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+// Checks that the dilation and the erosion with UseKernelDecomposition on
+// (processed line by line for box and polygon kernels, or chord by chord for
+// other kernels containing their center) give the same result as with
+// UseKernelDecomposition off.
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using PixelType = unsigned char;
+using ImageType = itk::Image<PixelType, Dimension>;
+using KernelType = itk::FlatStructuringElement<Dimension>;
+
+ImageType::Pointer
+CreateImage()
+{
+  const auto                image = ImageType::New();
+  const ImageType::SizeType size = { { 61, 47 } };
+  image->SetRegions(size);
+  image->Allocate(true);
+
+  // Pseudo-random blobs, some of them touching the border, and a few pixels
+  // of another label.
+  unsigned int seed = 17;
+  for (unsigned int blob = 0; blob < 12; ++blob)
+  {
+    seed = seed * 1103515245u + 12345u;
+    const itk::IndexValueType cx = (seed >> 8) % size[0];
+    seed = seed * 1103515245u + 12345u;
+    const itk::IndexValueType cy = (seed >> 8) % size[1];
+    seed = seed * 1103515245u + 12345u;
+    const itk::IndexValueType r = 1 + (seed >> 8) % 5;
+    for (itk::IndexValueType y = cy - r; y <= cy + r; ++y)
+    {
+      for (itk::IndexValueType x = cx - r; x <= cx + r; ++x)
+      {
+        const ImageType::IndexType index = { { x, y } };
+        if ((x - cx) * (x - cx) + (y - cy) * (y - cy) <= r * r && image->GetLargestPossibleRegion().IsInside(index))
+        {
+          image->SetPixel(index, (blob % 5 == 4) ? 100 : 255);
+        }
+      }
+    }
+  }
+  return image;
+}
+
+template <typename TFilter>
+class DecompositionTestFilter : public TFilter
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(DecompositionTestFilter);
+
+  using Self = DecompositionTestFilter;
+  using Pointer = itk::SmartPointer<Self>;
+  itkNewMacro(Self);
+
+  using TFilter::CanUseKernelDecomposition;
+
+protected:
+  DecompositionTestFilter() = default;
+  ~DecompositionTestFilter() override = default;
+};
+
+// Compares the output with and without kernel decomposition, and checks that
+// the decomposition is used when expected.
+template <typename TFilter>
+bool
+CompareDecomposition(const ImageType * image, const KernelType & kernel, bool boundaryToForeground, bool decomposed)
+{
+  using FilterType = DecompositionTestFilter<TFilter>;
+
+  auto decomposedFilter = FilterType::New();
+  decomposedFilter->SetInput(image);
+  decomposedFilter->SetKernel(kernel);
+  decomposedFilter->SetForegroundValue(255);
+  decomposedFilter->SetBackgroundValue(10);
+  decomposedFilter->SetBoundaryToForeground(boundaryToForeground);
+  decomposedFilter->Update();
+
+  auto referenceFilter = FilterType::New();
+  referenceFilter->SetInput(image);
+  referenceFilter->SetKernel(kernel);
+  referenceFilter->SetForegroundValue(255);
+  referenceFilter->SetBackgroundValue(10);
+  referenceFilter->SetBoundaryToForeground(boundaryToForeground);
+  referenceFilter->UseKernelDecompositionOff();
+  referenceFilter->Update();
+
+  const bool dilate = std::is_same<TFilter, itk::BinaryDilateImageFilter<ImageType, ImageType, KernelType>>::value;
+  if (decomposedFilter->CanUseKernelDecomposition(dilate) != decomposed ||
+      referenceFilter->CanUseKernelDecomposition(dilate))
+  {
+    std::cerr << decomposedFilter->GetNameOfClass() << " with kernel radius " << kernel.GetRadius()
+              << " and BoundaryToForeground " << boundaryToForeground << ": unexpected use of the decomposition"
+              << std::endl;
+    return false;
+  }
+
+  itk::ImageRegionConstIteratorWithIndex<ImageType> decomposedIt(decomposedFilter->GetOutput(),
+                                                                 image->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> referenceIt(referenceFilter->GetOutput(), image->GetLargestPossibleRegion());
+  for (; !decomposedIt.IsAtEnd(); ++decomposedIt, ++referenceIt)
+  {
+    if (decomposedIt.Get() != referenceIt.Get())
+    {
+      std::cerr << decomposedFilter->GetNameOfClass() << " with kernel radius " << kernel.GetRadius()
+                << " and BoundaryToForeground " << boundaryToForeground << " differs at " << decomposedIt.GetIndex()
+                << ": " << static_cast<int>(decomposedIt.Get()) << " != " << static_cast<int>(referenceIt.Get())
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkBinaryMorphologyKernelDecompositionTest(int, char *[])
+{
+  const ImageType::Pointer image = CreateImage();
+
+  using DilateFilterType = itk::BinaryDilateImageFilter<ImageType, ImageType, KernelType>;
+  using ErodeFilterType = itk::BinaryErodeImageFilter<ImageType, ImageType, KernelType>;
+
+  auto filter = DilateFilterType::New();
+  ITK_TEST_SET_GET_BOOLEAN(filter, UseKernelDecomposition, false);
+  ITK_TEST_SET_GET_BOOLEAN(filter, UseKernelDecomposition, true);
+
+  // Kernels processed line by line, except for the dilation with
+  // BoundaryToForeground on which is processed chord by chord.
+  KernelType::RadiusType radius;
+  radius[0] = 4;
+  radius[1] = 3;
+  std::vector<KernelType> lineKernels;
+  lineKernels.push_back(KernelType::Box(radius));
+  radius.Fill(5);
+  lineKernels.push_back(KernelType::Polygon(radius, 4));
+
+  // Kernels containing their center, processed chord by chord.
+  std::vector<KernelType> chordKernels;
+  chordKernels.push_back(KernelType::Polygon(radius, 7));
+  chordKernels.push_back(KernelType::Ball(radius));
+  radius[0] = 2;
+  radius[1] = 6;
+  chordKernels.push_back(KernelType::Ball(radius));
+  radius.Fill(4);
+  chordKernels.push_back(KernelType::Annulus(radius, 1, true));
+
+  KernelType asymmetricKernel = KernelType::Box(radius);
+  asymmetricKernel.SetDecomposable(false);
+  const auto center = static_cast<unsigned int>(asymmetricKernel.Size() / 2);
+  asymmetricKernel[center + 1] = false;
+  asymmetricKernel[center + 5] = false;
+  asymmetricKernel[center - 12] = false;
+  chordKernels.push_back(asymmetricKernel);
+
+  // Kernels which are not decomposed, because they do not contain their
+  // center.
+  std::vector<KernelType> otherKernels;
+  otherKernels.push_back(KernelType::Annulus(radius, 1, false));
+
+  bool success = true;
+  for (bool boundaryToForeground : { false, true })
+  {
+    for (const KernelType & kernel : lineKernels)
+    {
+      success &= CompareDecomposition<DilateFilterType>(image, kernel, boundaryToForeground, true);
+      success &= CompareDecomposition<ErodeFilterType>(image, kernel, boundaryToForeground, true);
+    }
+    for (const KernelType & kernel : chordKernels)
+    {
+      success &= CompareDecomposition<DilateFilterType>(image, kernel, boundaryToForeground, true);
+      success &= CompareDecomposition<ErodeFilterType>(image, kernel, boundaryToForeground, true);
+    }
+    for (const KernelType & kernel : otherKernels)
+    {
+      success &= CompareDecomposition<DilateFilterType>(image, kernel, boundaryToForeground, false);
+      success &= CompareDecomposition<ErodeFilterType>(image, kernel, boundaryToForeground, false);
+    }
+  }
+
+  if (!success)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,116 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageFilterToPlanarImageFilterWrapper_h
+#define itkImageFilterToPlanarImageFilterWrapper_h
+
+#include "itkImageToImageFilter.h"
+#include "itkPlanarImage.h"
+
+namespace itk
+{
+/**
+ *\class ImageFilterToPlanarImageFilterWrapper
+ * \brief Wrap an ImageToImageFilter as a filter that processes every channel
+ * of a PlanarImage
+ *
+ * The wrapped filter is run once per channel, on a view of the channel, and
+ * its output becomes the channel of the output: neither the input nor the
+ * output pixels are copied. A smoothing, gradient magnitude or any other
+ * scalar image filter thereby processes each component of a multi-component
+ * image, such as a displacement field converted by
+ * VectorImageToPlanarImageFilter, in contiguous memory, instead of gathering
+ * the components of the pixels of an interleaved image.
+ *
+ * \par Inputs and Usage
+   \code
+      using SmootherType = itk::SmoothingRecursiveGaussianImageFilter< ChannelImageType >;
+      auto smoother = SmootherType::New();
+      smoother->SetSigma( 2.0 );
+
+      using WrapperType = itk::ImageFilterToPlanarImageFilterWrapper< SmootherType >;
+      auto wrapper = WrapperType::New();
+      wrapper->SetImageFilter( smoother );
+      wrapper->SetInput( planarImage );
+      wrapper->Update();
+   \endcode
+ *
+ * The wrapped filter must produce an output with the geometry of its input.
+ * The wrapper processes the largest possible region of its input.
+ *
+ * \sa PlanarImage
+ * \sa ImageFilterToVideoFilterWrapper
+ * \ingroup ITKImageCompose
+ */
+template <typename TImageToImageFilter>
+class ITK_TEMPLATE_EXPORT ImageFilterToPlanarImageFilterWrapper
+  : public ImageToImageFilter<PlanarImage<typename TImageToImageFilter::InputImageType::PixelType,
+                                         TImageToImageFilter::InputImageType::ImageDimension>,
+                              PlanarImage<typename TImageToImageFilter::OutputImageType::PixelType,
+                                          TImageToImageFilter::OutputImageType::ImageDimension>>
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(ImageFilterToPlanarImageFilterWrapper);
+
+  /** Standard class type aliases */
+  using ImageFilterType = TImageToImageFilter;
+  using InputChannelImageType = typename ImageFilterType::InputImageType;
+  using OutputChannelImageType = typename ImageFilterType::OutputImageType;
+  using InputImageType =
+    PlanarImage<typename InputChannelImageType::PixelType, InputChannelImageType::ImageDimension>;
+  using OutputImageType =
+    PlanarImage<typename OutputChannelImageType::PixelType, OutputChannelImageType::ImageDimension>;
+
+  using Self = ImageFilterToPlanarImageFilterWrapper;
+  using Superclass = ImageToImageFilter<InputImageType, OutputImageType>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  itkNewMacro(Self);
+
+  itkTypeMacro(ImageFilterToPlanarImageFilterWrapper, ImageToImageFilter);
+
+  /** Set the filter to run on every channel */
+  itkSetObjectMacro(ImageFilter, ImageFilterType);
+  itkGetModifiableObjectMacro(ImageFilter, ImageFilterType);
+
+protected:
+  ImageFilterToPlanarImageFilterWrapper() = default;
+  ~ImageFilterToPlanarImageFilterWrapper() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** The wrapped filter processes whole channels. */
+  void
+  GenerateInputRequestedRegion() override;
+  void
+  EnlargeOutputRequestedRegion(DataObject * output) override;
+
+  void
+  GenerateData() override;
+
+private:
+  typename ImageFilterType::Pointer m_ImageFilter;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkImageFilterToPlanarImageFilterWrapper.hxx"
+#endif
+
+#endif
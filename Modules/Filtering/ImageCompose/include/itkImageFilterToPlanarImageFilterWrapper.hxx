@@ -0,0 +1,89 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageFilterToPlanarImageFilterWrapper_hxx
+#define itkImageFilterToPlanarImageFilterWrapper_hxx
+
+#include "itkImageFilterToPlanarImageFilterWrapper.h"
+
+namespace itk
+{
+//----------------------------------------------------------------------------
+template <typename TImageToImageFilter>
+void
+ImageFilterToPlanarImageFilterWrapper<TImageToImageFilter>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  auto * input = const_cast<InputImageType *>(this->GetInput());
+  if (input)
+  {
+    input->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+//----------------------------------------------------------------------------
+template <typename TImageToImageFilter>
+void
+ImageFilterToPlanarImageFilterWrapper<TImageToImageFilter>::EnlargeOutputRequestedRegion(DataObject * output)
+{
+  Superclass::EnlargeOutputRequestedRegion(output);
+  output->SetRequestedRegionToLargestPossibleRegion();
+}
+
+//----------------------------------------------------------------------------
+template <typename TImageToImageFilter>
+void
+ImageFilterToPlanarImageFilterWrapper<TImageToImageFilter>::GenerateData()
+{
+  if (m_ImageFilter.IsNull())
+  {
+    itkExceptionMacro("ImageFilter has not been set");
+  }
+
+  const InputImageType * input = this->GetInput();
+  OutputImageType *      output = this->GetOutput();
+  output->SetBufferedRegion(output->GetRequestedRegion());
+
+  const unsigned int numberOfChannels = input->GetNumberOfComponentsPerPixel();
+  for (unsigned int k = 0; k < numberOfChannels; ++k)
+  {
+    m_ImageFilter->SetInput(input->GetChannel(k));
+    m_ImageFilter->Update();
+
+    // Make the output of the filter a channel, and give the filter a new
+    // output, so that the channel is not overwritten by the next one.
+    const typename OutputChannelImageType::Pointer channelOutput = m_ImageFilter->GetOutput();
+    output->SetChannel(k, channelOutput);
+    channelOutput->DisconnectPipeline();
+
+    this->UpdateProgress(static_cast<float>(k + 1) / static_cast<float>(numberOfChannels));
+  }
+}
+
+//----------------------------------------------------------------------------
+template <typename TImageToImageFilter>
+void
+ImageFilterToPlanarImageFilterWrapper<TImageToImageFilter>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfObjectMacro(ImageFilter);
+}
+} // end namespace itk
+
+#endif
@@ -0,0 +1,80 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPlanarImageToVectorImageFilter_h
+#define itkPlanarImageToVectorImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkPlanarImage.h"
+#include "itkVectorImage.h"
+
+namespace itk
+{
+/**
+ *\class PlanarImageToVectorImageFilter
+ * \brief Converts a PlanarImage into an image of interleaved components
+ *
+ * The output is a VectorImage, or an Image of a multi-component pixel type
+ * (itk::Vector, itk::CovariantVector, ...), such as a displacement field.
+ * Channel k of the input becomes component k of every output pixel. The
+ * number of components of a fixed-length output pixel type must be the number
+ * of channels of the input.
+ *
+ * \sa PlanarImage
+ * \sa VectorImageToPlanarImageFilter
+ * \ingroup ITKImageCompose
+ */
+template <typename TInputImage,
+          typename TOutputImage = VectorImage<typename TInputImage::InternalPixelType, TInputImage::ImageDimension>>
+class ITK_TEMPLATE_EXPORT PlanarImageToVectorImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(PlanarImageToVectorImageFilter);
+
+  using Self = PlanarImageToVectorImageFilter;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+  using Superclass = ImageToImageFilter<TInputImage, TOutputImage>;
+
+  itkNewMacro(Self);
+
+  itkTypeMacro(PlanarImageToVectorImageFilter, ImageToImageFilter);
+
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using InputInternalPixelType = typename InputImageType::InternalPixelType;
+  using OutputPixelType = typename OutputImageType::PixelType;
+  using OutputPixelValueType = typename NumericTraits<OutputPixelType>::ValueType;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+
+protected:
+  PlanarImageToVectorImageFilter();
+  ~PlanarImageToVectorImageFilter() override = default;
+
+  void
+  GenerateOutputInformation() override;
+
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+};
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkPlanarImageToVectorImageFilter.hxx"
+#endif
+
+#endif
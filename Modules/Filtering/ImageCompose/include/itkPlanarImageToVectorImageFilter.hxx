@@ -0,0 +1,98 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPlanarImageToVectorImageFilter_hxx
+#define itkPlanarImageToVectorImageFilter_hxx
+
+#include "itkPlanarImageToVectorImageFilter.h"
+#include "itkImageScanlineIterator.h"
+#include "itkTotalProgressReporter.h"
+
+#include <vector>
+
+namespace itk
+{
+//----------------------------------------------------------------------------
+template <typename TInputImage, typename TOutputImage>
+PlanarImageToVectorImageFilter<TInputImage, TOutputImage>::PlanarImageToVectorImageFilter()
+{
+  this->DynamicMultiThreadingOn();
+  this->ThreaderUpdateProgressOff();
+}
+
+//----------------------------------------------------------------------------
+template <typename TInputImage, typename TOutputImage>
+void
+PlanarImageToVectorImageFilter<TInputImage, TOutputImage>::GenerateOutputInformation()
+{
+  this->Superclass::GenerateOutputInformation();
+
+  // Sets the vector length of a VectorImage; a fixed-length pixel type keeps
+  // its number of components, which must be the number of channels.
+  const unsigned int numberOfChannels = this->GetInput()->GetNumberOfComponentsPerPixel();
+  OutputImageType *  output = this->GetOutput();
+  output->SetNumberOfComponentsPerPixel(numberOfChannels);
+  if (output->GetNumberOfComponentsPerPixel() != numberOfChannels)
+  {
+    itkExceptionMacro(<< "The input has " << numberOfChannels << " channels, but the output pixel has "
+                      << output->GetNumberOfComponentsPerPixel() << " components");
+  }
+}
+
+//----------------------------------------------------------------------------
+template <typename TInputImage, typename TOutputImage>
+void
+PlanarImageToVectorImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  const InputImageType * inputImage = this->GetInput();
+  OutputImageType *      outputImage = this->GetOutput();
+  const unsigned int     numberOfComponents = inputImage->GetNumberOfComponentsPerPixel();
+
+  TotalProgressReporter progress(this, outputImage->GetRequestedRegion().GetNumberOfPixels());
+
+  ImageScanlineIterator<OutputImageType>      outputIt(outputImage, outputRegionForThread);
+  std::vector<const InputInternalPixelType *> channels(numberOfComponents);
+
+  OutputPixelType pixel;
+  NumericTraits<OutputPixelType>::SetLength(pixel, numberOfComponents);
+
+  while (!outputIt.IsAtEnd())
+  {
+    // The pixels of a line are contiguous in every channel.
+    const OffsetValueType offset = inputImage->ComputeOffset(outputIt.GetIndex());
+    for (unsigned int k = 0; k < numberOfComponents; ++k)
+    {
+      channels[k] = inputImage->GetChannelBufferPointer(k) + offset;
+    }
+
+    while (!outputIt.IsAtEndOfLine())
+    {
+      for (unsigned int k = 0; k < numberOfComponents; ++k)
+      {
+        pixel[k] = static_cast<OutputPixelValueType>(*channels[k]++);
+      }
+      outputIt.Set(pixel);
+      ++outputIt;
+    }
+    outputIt.NextLine();
+    progress.Completed(outputRegionForThread.GetSize(0));
+  }
+}
+} // end namespace itk
+
+#endif
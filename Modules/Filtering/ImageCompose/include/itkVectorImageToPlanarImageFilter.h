@@ -0,0 +1,88 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVectorImageToPlanarImageFilter_h
+#define itkVectorImageToPlanarImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkPlanarImage.h"
+
+namespace itk
+{
+/**
+ *\class VectorImageToPlanarImageFilter
+ * \brief Converts an image of interleaved components into a PlanarImage
+ *
+ * The input is a VectorImage, or an Image of a multi-component pixel type
+ * (itk::Vector, itk::CovariantVector, itk::RGBPixel, ...), such as a
+ * displacement field. Component k of every pixel is copied to channel k of the
+ * output, so that each component can then be processed in contiguous memory,
+ * e.g. by ImageFilterToPlanarImageFilterWrapper.
+ *
+ * \par Inputs and Usage
+   \code
+      using ConverterType = itk::VectorImageToPlanarImageFilter< DisplacementFieldType >;
+      auto converter = ConverterType::New();
+      converter->SetInput( displacementField );
+      converter->Update();
+      ConverterType::OutputImageType::ChannelImageType::Pointer x = converter->GetOutput()->GetChannel( 0 );
+   \endcode
+ *
+ * \sa PlanarImage
+ * \sa PlanarImageToVectorImageFilter
+ * \ingroup ITKImageCompose
+ */
+template <typename TInputImage,
+          typename TOutputImage =
+            PlanarImage<typename NumericTraits<typename TInputImage::PixelType>::ValueType, TInputImage::ImageDimension>>
+class ITK_TEMPLATE_EXPORT VectorImageToPlanarImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(VectorImageToPlanarImageFilter);
+
+  using Self = VectorImageToPlanarImageFilter;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+  using Superclass = ImageToImageFilter<TInputImage, TOutputImage>;
+
+  itkNewMacro(Self);
+
+  itkTypeMacro(VectorImageToPlanarImageFilter, ImageToImageFilter);
+
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using InputPixelType = typename InputImageType::PixelType;
+  using OutputInternalPixelType = typename OutputImageType::InternalPixelType;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+
+protected:
+  VectorImageToPlanarImageFilter();
+  ~VectorImageToPlanarImageFilter() override = default;
+
+  void
+  GenerateOutputInformation() override;
+
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+};
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkVectorImageToPlanarImageFilter.hxx"
+#endif
+
+#endif
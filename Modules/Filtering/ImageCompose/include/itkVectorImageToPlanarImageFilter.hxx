@@ -0,0 +1,86 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVectorImageToPlanarImageFilter_hxx
+#define itkVectorImageToPlanarImageFilter_hxx
+
+#include "itkVectorImageToPlanarImageFilter.h"
+#include "itkImageScanlineIterator.h"
+#include "itkTotalProgressReporter.h"
+
+#include <vector>
+
+namespace itk
+{
+//----------------------------------------------------------------------------
+template <typename TInputImage, typename TOutputImage>
+VectorImageToPlanarImageFilter<TInputImage, TOutputImage>::VectorImageToPlanarImageFilter()
+{
+  this->DynamicMultiThreadingOn();
+  this->ThreaderUpdateProgressOff();
+}
+
+//----------------------------------------------------------------------------
+template <typename TInputImage, typename TOutputImage>
+void
+VectorImageToPlanarImageFilter<TInputImage, TOutputImage>::GenerateOutputInformation()
+{
+  this->Superclass::GenerateOutputInformation();
+
+  this->GetOutput()->SetNumberOfComponentsPerPixel(this->GetInput()->GetNumberOfComponentsPerPixel());
+}
+
+//----------------------------------------------------------------------------
+template <typename TInputImage, typename TOutputImage>
+void
+VectorImageToPlanarImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  const InputImageType * inputImage = this->GetInput();
+  OutputImageType *      outputImage = this->GetOutput();
+  const unsigned int     numberOfComponents = outputImage->GetNumberOfComponentsPerPixel();
+
+  TotalProgressReporter progress(this, outputImage->GetRequestedRegion().GetNumberOfPixels());
+
+  ImageScanlineConstIterator<InputImageType> inputIt(inputImage, outputRegionForThread);
+  std::vector<OutputInternalPixelType *>     channels(numberOfComponents);
+
+  while (!inputIt.IsAtEnd())
+  {
+    // The pixels of a line are contiguous in every channel.
+    const OffsetValueType offset = outputImage->ComputeOffset(inputIt.GetIndex());
+    for (unsigned int k = 0; k < numberOfComponents; ++k)
+    {
+      channels[k] = outputImage->GetChannelBufferPointer(k) + offset;
+    }
+
+    while (!inputIt.IsAtEndOfLine())
+    {
+      const InputPixelType pixel = inputIt.Get();
+      for (unsigned int k = 0; k < numberOfComponents; ++k)
+      {
+        *channels[k]++ = static_cast<OutputInternalPixelType>(pixel[k]);
+      }
+      ++inputIt;
+    }
+    inputIt.NextLine();
+    progress.Completed(outputRegionForThread.GetSize(0));
+  }
+}
+} // end namespace itk
+
+#endif
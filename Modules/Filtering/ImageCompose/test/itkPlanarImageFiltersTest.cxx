@@ -0,0 +1,154 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFilterToPlanarImageFilterWrapper.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkPlanarImageToVectorImageFilter.h"
+#include "itkTestingMacros.h"
+#include "itkUnaryGeneratorImageFilter.h"
+#include "itkVectorImageToPlanarImageFilter.h"
+
+// Converts a displacement field into a PlanarImage, doubles every channel, and
+// converts the channels back into a displacement field and a VectorImage.
+int
+itkPlanarImageFiltersTest(int, char *[])
+{
+  constexpr unsigned int Dimension = 3;
+
+  using DisplacementFieldType = itk::Image<itk::Vector<float, Dimension>, Dimension>;
+  using PlanarImageType = itk::PlanarImage<float, Dimension>;
+  using ChannelImageType = PlanarImageType::ChannelImageType;
+  using VectorImageType = itk::VectorImage<float, Dimension>;
+
+  auto                                field = DisplacementFieldType::New();
+  const DisplacementFieldType::SizeType size = { { 13, 7, 5 } };
+  const DisplacementFieldType::IndexType start = { { -3, 2, 1 } };
+  field->SetRegions(DisplacementFieldType::RegionType(start, size));
+  DisplacementFieldType::PointType origin;
+  origin[0] = 1.0;
+  origin[1] = -2.0;
+  origin[2] = 0.5;
+  field->SetOrigin(origin);
+  field->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<DisplacementFieldType> it(field, field->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    const DisplacementFieldType::IndexType index = it.GetIndex();
+    DisplacementFieldType::PixelType       displacement;
+    displacement[0] = static_cast<float>(index[0]);
+    displacement[1] = index[1] * 0.5f;
+    displacement[2] = index[0] * 0.25f - index[2];
+    it.Set(displacement);
+  }
+
+  using ToPlanarFilterType = itk::VectorImageToPlanarImageFilter<DisplacementFieldType>;
+  auto toPlanarFilter = ToPlanarFilterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(toPlanarFilter, VectorImageToPlanarImageFilter, ImageToImageFilter);
+
+  toPlanarFilter->SetInput(field);
+  ITK_TRY_EXPECT_NO_EXCEPTION(toPlanarFilter->Update());
+
+  const PlanarImageType * planarImage = toPlanarFilter->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(planarImage->GetNumberOfComponentsPerPixel(), Dimension);
+  ITK_TEST_EXPECT_EQUAL(planarImage->GetOrigin(), field->GetOrigin());
+  for (unsigned int k = 0; k < Dimension; ++k)
+  {
+    const ChannelImageType::ConstPointer channel = planarImage->GetChannel(k);
+    ITK_TEST_EXPECT_EQUAL(channel->GetBufferedRegion(), field->GetBufferedRegion());
+    ITK_TEST_EXPECT_EQUAL(channel->GetBufferPointer(), planarImage->GetChannelBufferPointer(k));
+    for (itk::ImageRegionConstIteratorWithIndex<ChannelImageType> it(channel, channel->GetBufferedRegion());
+         !it.IsAtEnd();
+         ++it)
+    {
+      if (itk::Math::NotExactlyEquals(it.Get(), field->GetPixel(it.GetIndex())[k]))
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Error in channel " << k << " at index " << it.GetIndex() << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // Double every channel.
+  using DoublerType = itk::UnaryGeneratorImageFilter<ChannelImageType, ChannelImageType>;
+  auto doubler = DoublerType::New();
+  doubler->SetFunctor([](const float & value) { return 2.0f * value; });
+
+  using WrapperType = itk::ImageFilterToPlanarImageFilterWrapper<DoublerType>;
+  auto wrapper = WrapperType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(wrapper, ImageFilterToPlanarImageFilterWrapper, ImageToImageFilter);
+
+  ITK_TRY_EXPECT_EXCEPTION(wrapper->Update());
+
+  wrapper->SetImageFilter(doubler);
+  ITK_TEST_SET_GET_VALUE(doubler, wrapper->GetImageFilter());
+  wrapper->SetInput(planarImage);
+  ITK_TRY_EXPECT_NO_EXCEPTION(wrapper->Update());
+
+  // Convert the doubled channels back into interleaved components.
+  using ToFieldFilterType = itk::PlanarImageToVectorImageFilter<PlanarImageType, DisplacementFieldType>;
+  auto toFieldFilter = ToFieldFilterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(toFieldFilter, PlanarImageToVectorImageFilter, ImageToImageFilter);
+
+  toFieldFilter->SetInput(wrapper->GetOutput());
+  ITK_TRY_EXPECT_NO_EXCEPTION(toFieldFilter->Update());
+
+  using ToVectorImageFilterType = itk::PlanarImageToVectorImageFilter<PlanarImageType>;
+  auto toVectorImageFilter = ToVectorImageFilterType::New();
+  toVectorImageFilter->SetInput(wrapper->GetOutput());
+  ITK_TRY_EXPECT_NO_EXCEPTION(toVectorImageFilter->Update());
+
+  const DisplacementFieldType * doubledField = toFieldFilter->GetOutput();
+  const VectorImageType *       doubledVectorImage = toVectorImageFilter->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(doubledVectorImage->GetNumberOfComponentsPerPixel(), Dimension);
+  ITK_TEST_EXPECT_EQUAL(doubledField->GetOrigin(), field->GetOrigin());
+  for (itk::ImageRegionConstIteratorWithIndex<DisplacementFieldType> it(field, field->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const DisplacementFieldType::IndexType index = it.GetIndex();
+    for (unsigned int k = 0; k < Dimension; ++k)
+    {
+      if (itk::Math::NotExactlyEquals(doubledField->GetPixel(index)[k], 2.0f * it.Get()[k]) ||
+          itk::Math::NotExactlyEquals(doubledVectorImage->GetPixel(index)[k], 2.0f * it.Get()[k]))
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Error in component " << k << " at index " << index << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // The channels of the input are unchanged.
+  ITK_TEST_EXPECT_EQUAL(planarImage->GetPixel(start)[2], field->GetPixel(start)[2]);
+
+  // The number of components of a fixed-length pixel must be the number of
+  // channels.
+  using Field2DType = itk::Image<itk::Vector<float, 2>, Dimension>;
+  auto toField2DFilter = itk::PlanarImageToVectorImageFilter<PlanarImageType, Field2DType>::New();
+  toField2DFilter->SetInput(planarImage);
+  ITK_TRY_EXPECT_EXCEPTION(toField2DFilter->Update());
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
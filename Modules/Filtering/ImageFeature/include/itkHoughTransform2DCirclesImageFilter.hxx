@@ -19,6 +19,7 @@
 #define itkHoughTransform2DCirclesImageFilter_hxx
 
 #include "itkHoughTransform2DCirclesImageFilter.h"
+#include "itkHoughTransformAlgorithm.h"
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkDiscreteGaussianImageFilter.h"
 #include "itkGaussianDerivativeImageFunction.h"
@@ -106,76 +107,47 @@ HoughTransform2DCirclesImageFilter<TInputPixelType, TOutputPixelType, TRadiusPix
   m_RadiusImage->SetDirection(inputImage->GetDirection());
   m_RadiusImage->Allocate(true); // initialize buffer to zero
 
-  ImageRegionConstIteratorWithIndex<InputImageType> image_it(inputImage, inputImage->GetRequestedRegion());
-  image_it.GoToBegin();
+  // Each work unit votes for a piece of the input. The votes are summed
+  // afterwards, so the accumulator does not depend on the number of work units.
+  using SinkType = HoughTransformAlgorithm::VoteSink<OutputImageType, RadiusImageType>;
 
-  const ImageRegion<2> & region = outputImage->GetRequestedRegion();
-
-  while (!image_it.IsAtEnd())
+  // The rays sweep the angles around the gradient direction.
+  HoughTransformAlgorithm::RayMatrixContainerType<2> rayMatrices;
+  for (double angle = -m_SweepAngle; angle <= m_SweepAngle; angle += 0.05)
   {
-    if (image_it.Get() > m_Threshold)
-    {
-      const Index<2>                             inputIndex = image_it.GetIndex();
-      const typename DoGFunctionType::VectorType grad = DoGFunction->DoGFunctionType::EvaluateAtIndex(inputIndex);
-
-      double Vx = grad[0];
-      double Vy = grad[1];
-
-      const double norm = std::sqrt(Vx * Vx + Vy * Vy);
-
-      // if the gradient is not flat (using GradientNormThreshold to estimate flatness)
-      if (norm > m_GradientNormThreshold)
-      {
-        Vx /= norm;
-        Vy /= norm;
-
-        for (double angle = -m_SweepAngle; angle <= m_SweepAngle; angle += 0.05)
-        {
-          double i = m_MinimumRadius;
-          double distance;
-
-          do
-          {
-            const Index<2> outputIndex = {
-              { Math::Round<IndexValueType>(inputIndex[0] - i * (Vx * std::cos(angle) + Vy * std::sin(angle))),
-                Math::Round<IndexValueType>(inputIndex[1] - i * (Vx * std::sin(angle) + Vy * std::cos(angle))) }
-            };
-
-            if (region.IsInside(outputIndex))
-            {
-              distance =
-                std::sqrt(static_cast<double>((outputIndex[0] - inputIndex[0]) * (outputIndex[0] - inputIndex[0]) +
-                                              (outputIndex[1] - inputIndex[1]) * (outputIndex[1] - inputIndex[1])));
-
-              ++outputImage->GetPixel(outputIndex);
-              m_RadiusImage->GetPixel(outputIndex) += distance;
-            }
-            else
-            {
-              break;
-            }
-            ++i;
-          } while (distance < m_MaximumRadius);
-        }
-      }
-    }
-    ++image_it;
+    const double         cosAngle = std::cos(angle);
+    const double         sinAngle = std::sin(angle);
+    Matrix<double, 2, 2> rayMatrix;
+    rayMatrix[0][0] = cosAngle;
+    rayMatrix[0][1] = sinAngle;
+    rayMatrix[1][0] = sinAngle;
+    rayMatrix[1][1] = cosAngle;
+    rayMatrices.push_back(rayMatrix);
   }
 
+  const auto voter = [this, inputImage, &DoGFunction, &rayMatrices](const OutputImageRegionType & pieceRegion,
+                                                                    SinkType &                    sink) {
+    HoughTransformAlgorithm::VoteAlongGradients(inputImage.GetPointer(),
+                                                pieceRegion,
+                                                DoGFunction.GetPointer(),
+                                                m_Threshold,
+                                                m_GradientNormThreshold,
+                                                m_MinimumRadius,
+                                                m_MaximumRadius,
+                                                rayMatrices,
+                                                sink);
+  };
+
+  HoughTransformAlgorithm::ParallelVote(inputImage->GetRequestedRegion(),
+                                        outputImage.GetPointer(),
+                                        m_RadiusImage.GetPointer(),
+                                        this->GetMultiThreader(),
+                                        this->GetNumberOfWorkUnits(),
+                                        this,
+                                        voter);
+
   // Compute the average radius
-  ImageRegionConstIterator<OutputImageType> output_it(outputImage, outputImage->GetLargestPossibleRegion());
-  ImageRegionIterator<RadiusImageType>      radius_it(m_RadiusImage, m_RadiusImage->GetLargestPossibleRegion());
-  output_it.GoToBegin();
-  radius_it.GoToBegin();
-  while (!output_it.IsAtEnd())
-  {
-    if (output_it.Get() > 1)
-    {
-      radius_it.Value() /= output_it.Get();
-    }
-    ++output_it;
-    ++radius_it;
-  }
+  HoughTransformAlgorithm::ComputeAverageRadius(outputImage.GetPointer(), m_RadiusImage.GetPointer());
 }
 
 template <typename TInputPixelType, typename TOutputPixelType, typename TRadiusPixelType>
@@ -217,62 +189,52 @@ HoughTransform2DCirclesImageFilter<TInputPixelType, TOutputPixelType, TRadiusPix
     gaussianFilter->Update();
     const InternalImageType::Pointer postProcessImage = gaussianFilter->GetOutput();
 
-    const auto                             minMaxCalculator = MinimumMaximumImageCalculator<InternalImageType>::New();
-    ImageRegionIterator<InternalImageType> it_input(postProcessImage, postProcessImage->GetLargestPossibleRegion());
-
-    CirclesListSizeType circles = 0;
+    const RadiusImageType * const radiusImage = m_RadiusImage;
+    const double                  discRadiusRatio = m_DiscRadiusRatio;
 
-    // Find maxima
-    // Break out of "forever loop" as soon as the requested number of circles is found.
-    for (;;)
-    {
-      minMaxCalculator->SetImage(postProcessImage);
-      minMaxCalculator->ComputeMaximum();
+    // Each accepted circle center suppresses a disc of the accumulator, whose
+    // radius is proportional to the radius of the circle.
+    using MaskType = HoughTransformAlgorithm::SuppressionMask<InternalImageType>;
+    const auto suppressDisc = [radiusImage, discRadiusRatio](const Index<2> & center, MaskType & mask) {
+      const double discRadius = discRadiusRatio * static_cast<double>(radiusImage->GetPixel(center));
 
-      if (minMaxCalculator->GetMaximum() <= 0)
+      for (double angle = 0; angle <= 2 * itk::Math::pi; angle += itk::Math::pi / 1000)
       {
-        // When all pixel values in 'postProcessImage' are zero or less, no more circles
-        // should be found. Note that a zero in 'postProcessImage' might correspond to a
-        // zero in the accumulator image, or it might be that the pixel is within a
-        // removed disc around a previously found circle center.
-        break;
+        const double cosAngle = std::cos(angle);
+        const double sinAngle = std::sin(angle);
+
+        for (double length = 0; length < discRadius; length += 1)
+        {
+          const Index<2> index = { { Math::Round<IndexValueType>(center[0] + length * cosAngle),
+                                     Math::Round<IndexValueType>(center[1] + length * sinAngle) } };
+          mask.Suppress(index);
+        }
       }
+    };
 
-      const InternalImageType::IndexType indexOfMaximum = minMaxCalculator->GetIndexOfMaximum();
+    const std::vector<Index<2>> centers = HoughTransformAlgorithm::FindPeaks(postProcessImage.GetPointer(),
+                                                                             m_NumberOfCircles,
+                                                                             this->GetMultiThreader(),
+                                                                             this->GetNumberOfWorkUnits(),
+                                                                             suppressDisc);
 
+    CirclesListSizeType circles = 0;
+
+    for (const Index<2> & center : centers)
+    {
       // Create a Circle Spatial Object
       const auto Circle = CircleType::New();
       Circle->SetId(static_cast<int>(circles));
-      Circle->SetRadiusInObjectSpace(m_RadiusImage->GetPixel(indexOfMaximum));
+      Circle->SetRadiusInObjectSpace(m_RadiusImage->GetPixel(center));
 
-      CircleType::PointType center;
-      center[0] = indexOfMaximum[0];
-      center[1] = indexOfMaximum[1];
-      Circle->SetCenterInObjectSpace(center);
+      CircleType::PointType centerPoint;
+      centerPoint[0] = center[0];
+      centerPoint[1] = center[1];
+      Circle->SetCenterInObjectSpace(centerPoint);
       Circle->Update();
 
       m_CirclesList.push_back(Circle);
-
-      circles++;
-      if (circles >= m_NumberOfCircles)
-      {
-        break;
-      }
-
-      // Remove a black disc from the Hough space domain
-      for (double angle = 0; angle <= 2 * itk::Math::pi; angle += itk::Math::pi / 1000)
-      {
-        for (double length = 0; length < m_DiscRadiusRatio * Circle->GetRadiusInObjectSpace()[0]; length += 1)
-        {
-          const Index<2> index = { { Math::Round<IndexValueType>(indexOfMaximum[0] + length * std::cos(angle)),
-                                     Math::Round<IndexValueType>(indexOfMaximum[1] + length * std::sin(angle)) } };
-
-          if (postProcessImage->GetLargestPossibleRegion().IsInside(index))
-          {
-            postProcessImage->SetPixel(index, 0);
-          }
-        }
-      }
+      ++circles;
     }
   }
 
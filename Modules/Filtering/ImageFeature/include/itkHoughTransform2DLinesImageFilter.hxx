@@ -19,6 +19,7 @@
 #define itkHoughTransform2DLinesImageFilter_hxx
 
 #include "itkHoughTransform2DLinesImageFilter.h"
+#include "itkHoughTransformAlgorithm.h"
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkDiscreteGaussianImageFilter.h"
 #include "itkMinimumMaximumImageCalculator.h"
@@ -102,36 +103,50 @@ HoughTransform2DLinesImageFilter<TInputPixelType, TOutputPixelType>::GenerateDat
   this->AllocateOutputs();
   outputImage->FillBuffer(0);
 
-  const double nPI = 4.0 * std::atan(1.0);
+  const double         nPI = 4.0 * std::atan(1.0);
+  const double         angleResolution = m_AngleResolution;
+  const double         threshold = m_Threshold;
+  const IndexValueType maximumRadius = static_cast<IndexValueType>(outputImage->GetBufferedRegion().GetSize()[0]);
 
-  ImageRegionConstIteratorWithIndex<InputImageType> image_it(inputImage, inputImage->GetRequestedRegion());
-  image_it.GoToBegin();
+  // Each work unit votes for a piece of the input. The votes are summed
+  // afterwards, so the accumulator does not depend on the number of work units.
+  using SinkType = HoughTransformAlgorithm::VoteSink<OutputImageType, OutputImageType>;
 
-  Index<2> index;
+  const auto voter = [inputImage, nPI, angleResolution, threshold, maximumRadius](
+                       const OutputImageRegionType & pieceRegion, SinkType & sink) {
+    ImageRegionConstIteratorWithIndex<InputImageType> image_it(inputImage, pieceRegion);
 
-  while (!image_it.IsAtEnd())
-  {
-    if (image_it.Get() > m_Threshold)
+    Index<2> index;
+
+    for (image_it.GoToBegin(); !image_it.IsAtEnd(); ++image_it)
     {
-      for (double angle = -nPI; angle < nPI; angle += nPI / m_AngleResolution)
+      if (image_it.Get() > threshold)
       {
-        index[0] =
-          // m_R
-          (IndexValueType)(image_it.GetIndex()[0] * std::cos(angle) + image_it.GetIndex()[1] * std::sin(angle));
-        // m_Theta
-        index[1] = (IndexValueType)((m_AngleResolution / 2) + m_AngleResolution * angle / (2 * nPI));
-
-        if (index[0] > 0 && index[0] <= (IndexValueType)outputImage->GetBufferedRegion().GetSize()[0])
-        // The preceding "if" should be replaceable with "if (
-        // outputImage->GetBufferedRegion().IsInside(index) )" but
-        // the algorithm fails if it is
+        for (double angle = -nPI; angle < nPI; angle += nPI / angleResolution)
         {
-          outputImage->SetPixel(index, outputImage->GetPixel(index) + 1);
+          index[0] =
+            // m_R
+            (IndexValueType)(image_it.GetIndex()[0] * std::cos(angle) + image_it.GetIndex()[1] * std::sin(angle));
+          // m_Theta
+          index[1] = (IndexValueType)((angleResolution / 2) + angleResolution * angle / (2 * nPI));
+
+          // a radius equal to the size of the accumulator is past its end
+          if (index[0] > 0 && index[0] < maximumRadius)
+          {
+            sink.AddVote(index);
+          }
         }
       }
     }
-    ++image_it;
-  }
+  };
+
+  HoughTransformAlgorithm::ParallelVote(inputImage->GetRequestedRegion(),
+                                        outputImage.GetPointer(),
+                                        static_cast<OutputImageType *>(nullptr),
+                                        this->GetMultiThreader(),
+                                        this->GetNumberOfWorkUnits(),
+                                        this,
+                                        voter);
 }
 
 
@@ -257,103 +272,65 @@ HoughTransform2DLinesImageFilter<TInputPixelType, TOutputPixelType>::GetLines()
     gaussianFilter->Update();
     const InternalImageType::Pointer postProcessImage = gaussianFilter->GetOutput();
 
-    using MinMaxCalculatorType = MinimumMaximumImageCalculator<InternalImageType>;
-    typename MinMaxCalculatorType::Pointer      minMaxCalculator = MinMaxCalculatorType::New();
-    itk::ImageRegionIterator<InternalImageType> it_input(postProcessImage,
-                                                         postProcessImage->GetLargestPossibleRegion());
+    const double discRadius = m_DiscRadius;
 
+    // Each accepted line suppresses a disc of the Hough space domain.
+    using MaskType = HoughTransformAlgorithm::SuppressionMask<InternalImageType>;
+    const auto suppressDisc = [discRadius](const Index<2> & peak, MaskType & mask) {
+      itk::Index<2> index;
+      for (double angle = 0; angle <= 2 * Math::pi; angle += Math::pi / 1000)
+      {
+        for (double length = 0; length < discRadius; length += 1)
+        {
+          index[0] = (IndexValueType)(peak[0] + length * std::cos(angle));
+          index[1] = (IndexValueType)(peak[1] + length * std::sin(angle));
+          mask.Suppress(index);
+        }
+      }
+    };
 
-    itk::Index<2> index;
+    const std::vector<Index<2>> peaks = HoughTransformAlgorithm::FindPeaks(postProcessImage.GetPointer(),
+                                                                           m_NumberOfLines,
+                                                                           this->GetMultiThreader(),
+                                                                           this->GetNumberOfWorkUnits(),
+                                                                           suppressDisc);
 
     unsigned int lines = 0;
 
-    // Find maxima
-    do
+    for (const Index<2> & peak : peaks)
     {
-      minMaxCalculator->SetImage(postProcessImage);
-      minMaxCalculator->ComputeMaximum();
-      InternalImageType::PixelType max = minMaxCalculator->GetMaximum();
-
-      if (max <= 0)
+      // Create the line.
+      LineType::LinePointListType list; // Insert two points per line.
+
+      double radius = peak[0];
+      double teta = ((peak[1]) * 2 * Math::pi / this->GetAngleResolution()) - Math::pi;
+      double Vx = radius * std::cos(teta);
+      double Vy = radius * std::sin(teta);
+      double norm = std::sqrt(Vx * Vx + Vy * Vy);
+      double VxNorm = Vx / norm;
+      double VyNorm = Vy / norm;
+
+      if (teta >= Math::pi / 2)
       {
-        // When all pixel values in 'postProcessImage' are zero or less, no more lines
-        // should be found. Note that a zero in 'postProcessImage' might correspond to a
-        // zero in the accumulator image, or it might be that the pixel is within a
-        // removed disc.
-        break;
+        VyNorm = -VyNorm;
+        VxNorm = -VxNorm;
       }
 
-      for (it_input.GoToBegin(); !it_input.IsAtEnd(); ++it_input)
-      {
-        if (Math::ExactlyEquals(it_input.Get(), max))
-        {
-          // Create the line.
-          LineType::LinePointListType list; // Insert two points per line.
-
-          double radius = it_input.GetIndex()[0];
-          double teta = ((it_input.GetIndex()[1]) * 2 * Math::pi / this->GetAngleResolution()) - Math::pi;
-          double Vx = radius * std::cos(teta);
-          double Vy = radius * std::sin(teta);
-          double norm = std::sqrt(Vx * Vx + Vy * Vy);
-          double VxNorm = Vx / norm;
-          double VyNorm = Vy / norm;
-
-          if (teta <= 0 || teta >= Math::pi / 2)
-          {
-            if (teta >= Math::pi / 2)
-            {
-              VyNorm = -VyNorm;
-              VxNorm = -VxNorm;
-            }
-
-            LinePointType p;
-            p.SetPositionInObjectSpace(Vx, Vy);
-            list.push_back(p);
-            p.SetPositionInObjectSpace(Vx - VyNorm * 5, Vy + VxNorm * 5);
-            list.push_back(p);
-          }
-          else
-          {
-            LinePointType p;
-            p.SetPositionInObjectSpace(Vx, Vy);
-            list.push_back(p);
-            p.SetPositionInObjectSpace(Vx - VyNorm * 5, Vy + VxNorm * 5);
-            list.push_back(p);
-          }
+      LinePointType p;
+      p.SetPositionInObjectSpace(Vx, Vy);
+      list.push_back(p);
+      p.SetPositionInObjectSpace(Vx - VyNorm * 5, Vy + VxNorm * 5);
+      list.push_back(p);
 
-          // Create a Line Spatial Object.
-          LinePointer line = LineType::New();
-          line->SetId(lines);
-          line->SetPoints(list);
-          line->Update();
+      // Create a Line Spatial Object.
+      LinePointer line = LineType::New();
+      line->SetId(lines);
+      line->SetPoints(list);
+      line->Update();
 
-          m_LinesList.push_back(line);
-
-          // Remove a black disc from the hough space domain.
-          for (double angle = 0; angle <= 2 * Math::pi; angle += Math::pi / 1000)
-          {
-            for (double length = 0; length < m_DiscRadius; length += 1)
-            {
-              index[0] = (IndexValueType)(it_input.GetIndex()[0] + length * std::cos(angle));
-              index[1] = (IndexValueType)(it_input.GetIndex()[1] + length * std::sin(angle));
-              if (postProcessImage->GetBufferedRegion().IsInside(index))
-              {
-                postProcessImage->SetPixel(index, 0);
-              }
-            }
-          }
-          minMaxCalculator->SetImage(postProcessImage);
-          minMaxCalculator->ComputeMaximum();
-          max = minMaxCalculator->GetMaximum();
-
-          lines++;
-          if (lines == m_NumberOfLines)
-          {
-            break;
-          }
-        }
-      }
-    } while (lines < m_NumberOfLines);
+      m_LinesList.push_back(line);
+      ++lines;
+    }
   }
 
   m_OldModifiedTime = this->GetMTime();
@@ -0,0 +1,220 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHoughTransform3DSpheresImageFilter_h
+#define itkHoughTransform3DSpheresImageFilter_h
+
+
+#include "itkImageToImageFilter.h"
+#include "itkEllipseSpatialObject.h"
+
+namespace itk
+{
+/**
+ * \class HoughTransform3DSpheresImageFilter
+ * \brief Performs the Hough Transform to find spheres in a 3D image.
+ *
+ * This filter is the 3D counterpart of HoughTransform2DCirclesImageFilter,
+ * intended for the detection of beads, cells and other blob-like objects.
+ * All pixels above the threshold whose gradient norm is above the gradient
+ * norm threshold vote for the candidate centers located along the gradient
+ * direction, at a distance between the minimum and the maximum radius.
+ *
+ * This filter produces two outputs:
+ *   1) The accumulator array, which represents probability of centers.
+ *   2) The array of radii, which has the average radius at each coordinate point.
+ *
+ * The voting is multithreaded: each work unit votes for a piece of the input
+ * image, and the votes of all work units are summed afterwards, so that the
+ * accumulator does not depend on the number of work units.
+ *
+ * As for the circles, the filter finds balls whose intensity is higher than
+ * the intensity of their surrounding.
+ *
+ * \sa HoughTransform2DCirclesImageFilter
+ *
+ * \ingroup ImageFeatureExtraction
+ *
+ * \ingroup ITKImageFeature
+ */
+
+template <typename TInputPixelType, typename TOutputPixelType, typename TRadiusPixelType>
+class ITK_TEMPLATE_EXPORT HoughTransform3DSpheresImageFilter
+  : public ImageToImageFilter<Image<TInputPixelType, 3>, Image<TOutputPixelType, 3>>
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(HoughTransform3DSpheresImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = HoughTransform3DSpheresImageFilter;
+  using Superclass = ImageToImageFilter<Image<TInputPixelType, 3>, Image<TOutputPixelType, 3>>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Input Image type alias. */
+  using InputImageType = Image<TInputPixelType, 3>;
+  using InputImagePointer = typename InputImageType::Pointer;
+  using InputImageConstPointer = typename InputImageType::ConstPointer;
+
+  /** Output Image type alias. */
+  using OutputImageType = Image<TOutputPixelType, 3>;
+  using OutputImagePointer = typename OutputImageType::Pointer;
+
+  /** Radius Image type alias. */
+  using RadiusImageType = Image<TRadiusPixelType, 3>;
+  using RadiusImagePointer = typename RadiusImageType::Pointer;
+
+  /** Image index type alias. */
+  using IndexType = typename InputImageType::IndexType;
+
+  /** Image pixel value type alias. */
+  using PixelType = typename InputImageType::PixelType;
+
+  /** Typedef to describe the output image region type. */
+  using OutputImageRegionType = typename InputImageType::RegionType;
+
+  /** Sphere type alias. */
+  using SphereType = EllipseSpatialObject<3>;
+  using SpherePointer = typename SphereType::Pointer;
+  using SpheresListType = std::list<SpherePointer>;
+
+  using SpheresListSizeType = typename SpheresListType::size_type;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(HoughTransform3DSpheresImageFilter, ImageToImageFilter);
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Verifies the preconditions of this filter. */
+  void
+  VerifyPreconditions() ITKv5_CONST override;
+
+  /** Method for evaluating the implicit function over the image. */
+  void
+  GenerateData() override;
+
+  /** Set both Minimum and Maximum radius values. */
+  void
+  SetRadius(double radius);
+
+  /** Set the minimum radius value the filter should look for. */
+  itkSetMacro(MinimumRadius, double);
+  itkGetConstMacro(MinimumRadius, double);
+
+  /** Set the maximum radius value the filter should look for. */
+  itkSetMacro(MaximumRadius, double);
+  itkGetConstMacro(MaximumRadius, double);
+
+  /** Set the threshold above which the filter should consider
+   * the point as a valid point. */
+  itkSetMacro(Threshold, double);
+
+  /** Get the threshold value. */
+  itkGetConstMacro(Threshold, double);
+
+  /** Threshold for the norm of the gradient: Only pixels whose gradient norm is
+   * above this threshold are processed by the filter. The threshold must be >= 0. */
+  itkSetMacro(GradientNormThreshold, double);
+  itkGetConstMacro(GradientNormThreshold, double);
+
+  /** Get the radius image. */
+  itkGetModifiableObjectMacro(RadiusImage, RadiusImageType);
+
+  /** Set the scale of the derivative function (using DoG). */
+  itkSetMacro(SigmaGradient, double);
+
+  /** Get the scale value. */
+  itkGetConstMacro(SigmaGradient, double);
+
+  /** Get the list of spheres. This recomputes the spheres, if necessary.
+   * The pixel grid coordinates of the center of a sphere from the list can
+   * be retrieved by calling sphere->GetCenterInObjectSpace().
+   */
+  SpheresListType &
+  GetSpheres();
+
+  /** Set/Get the number of spheres to extract. */
+  itkSetMacro(NumberOfSpheres, SpheresListSizeType);
+  itkGetConstMacro(NumberOfSpheres, SpheresListSizeType);
+
+  /** Set/Get the radius of the ball to remove from the accumulator
+   * for each sphere found, relative to the radius of the sphere. */
+  itkSetMacro(BallRadiusRatio, double);
+  itkGetConstMacro(BallRadiusRatio, double);
+
+  /** Set/Get the variance of the Gaussian blurring for the accumulator. */
+  itkSetMacro(Variance, double);
+  itkGetConstMacro(Variance, double);
+
+  /** Specifies whether to use the spacing of the input image internally, when
+   * doing Gaussian Derivative calculation and Gaussian image filtering. */
+  itkSetMacro(UseImageSpacing, bool);
+  itkGetConstMacro(UseImageSpacing, bool);
+
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  // Begin concept checking
+  itkConceptMacro(IntConvertibleToOutputCheck, (Concept::Convertible<int, TOutputPixelType>));
+  itkConceptMacro(InputGreaterThanDoubleCheck, (Concept::GreaterThanComparable<PixelType, double>));
+  itkConceptMacro(OutputPlusIntCheck, (Concept::AdditiveOperators<TOutputPixelType, int>));
+  itkConceptMacro(OutputDividedByIntCheck, (Concept::DivisionOperators<TOutputPixelType, int>));
+  // End concept checking
+#endif
+
+protected:
+  HoughTransform3DSpheresImageFilter();
+  ~HoughTransform3DSpheresImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** HoughTransform3DSpheresImageFilter needs the entire input. Therefore
+   * it must provide an implementation GenerateInputRequestedRegion().
+   * \sa ProcessObject::GenerateInputRequestedRegion(). */
+  void
+  GenerateInputRequestedRegion() override;
+
+  /** HoughTransform3DSpheresImageFilter's produces all the output.
+   * Therefore, it must provide an implementation of
+   * EnlargeOutputRequestedRegion.
+   * \sa ProcessObject::EnlargeOutputRequestedRegion() */
+  void
+  EnlargeOutputRequestedRegion(DataObject * itkNotUsed(output)) override;
+
+private:
+  double m_MinimumRadius{ 0.0 };
+  double m_MaximumRadius{ 10.0 };
+  double m_Threshold{ 0.0 };
+  double m_GradientNormThreshold{ 1.0 };
+  double m_SigmaGradient{ 1.0 };
+
+  RadiusImagePointer  m_RadiusImage;
+  SpheresListType     m_SpheresList;
+  SpheresListSizeType m_NumberOfSpheres{ 1 };
+  double              m_BallRadiusRatio{ 1 };
+  double              m_Variance{ 10 };
+  bool                m_UseImageSpacing{ true };
+  ModifiedTimeType    m_OldModifiedTime{ 0 };
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkHoughTransform3DSpheresImageFilter.hxx"
+#endif
+
+#endif
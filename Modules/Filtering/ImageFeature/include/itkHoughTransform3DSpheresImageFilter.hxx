@@ -0,0 +1,274 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHoughTransform3DSpheresImageFilter_hxx
+#define itkHoughTransform3DSpheresImageFilter_hxx
+
+#include "itkHoughTransform3DSpheresImageFilter.h"
+#include "itkHoughTransformAlgorithm.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkDiscreteGaussianImageFilter.h"
+#include "itkGaussianDerivativeImageFunction.h"
+#include "itkMath.h"
+
+namespace itk
+{
+template <typename TInputPixelType, typename TOutputPixelType, typename TRadiusPixelType>
+HoughTransform3DSpheresImageFilter<TInputPixelType, TOutputPixelType, TRadiusPixelType>::
+  HoughTransform3DSpheresImageFilter()
+{
+  this->SetNumberOfRequiredInputs(1);
+}
+
+template <typename TInputPixelType, typename TOutputPixelType, typename TRadiusPixelType>
+void
+HoughTransform3DSpheresImageFilter<TInputPixelType, TOutputPixelType, TRadiusPixelType>::SetRadius(double radius)
+{
+  this->SetMinimumRadius(radius);
+  this->SetMaximumRadius(radius);
+}
+
+template <typename TInputPixelType, typename TOutputPixelType, typename TRadiusPixelType>
+void
+HoughTransform3DSpheresImageFilter<TInputPixelType, TOutputPixelType, TRadiusPixelType>::EnlargeOutputRequestedRegion(
+  DataObject * output)
+{
+  Superclass::EnlargeOutputRequestedRegion(output);
+  output->SetRequestedRegionToLargestPossibleRegion();
+}
+
+template <typename TInputPixelType, typename TOutputPixelType, typename TRadiusPixelType>
+void
+HoughTransform3DSpheresImageFilter<TInputPixelType, TOutputPixelType, TRadiusPixelType>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+  if (this->GetInput())
+  {
+    InputImagePointer image = const_cast<InputImageType *>(this->GetInput());
+    image->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+
+template <typename TInputPixelType, typename TOutputPixelType, typename TRadiusPixelType>
+void
+HoughTransform3DSpheresImageFilter<TInputPixelType, TOutputPixelType, TRadiusPixelType>::VerifyPreconditions()
+  ITKv5_CONST
+{
+  Superclass::VerifyPreconditions();
+
+  if (!(m_GradientNormThreshold >= 0.0))
+  {
+    itkExceptionMacro("Failed precondition: GradientNormThreshold >= 0.");
+  }
+}
+
+
+template <typename TInputPixelType, typename TOutputPixelType, typename TRadiusPixelType>
+void
+HoughTransform3DSpheresImageFilter<TInputPixelType, TOutputPixelType, TRadiusPixelType>::GenerateData()
+{
+  // Get the input and output pointers
+  const InputImageConstPointer inputImage = this->GetInput(0);
+  const OutputImagePointer     outputImage = this->GetOutput(0);
+
+  // Allocate the output
+  this->AllocateOutputs();
+  outputImage->FillBuffer(0);
+
+  using DoGFunctionType = GaussianDerivativeImageFunction<InputImageType>;
+  const auto DoGFunction = DoGFunctionType::New();
+  DoGFunction->SetSigma(m_SigmaGradient);
+  DoGFunction->SetUseImageSpacing(m_UseImageSpacing);
+  // Set input image _after_ setting the other GaussianDerivative properties,
+  // to avoid multiple kernel recomputation within GaussianDerivativeImageFunction.
+  DoGFunction->SetInputImage(inputImage);
+
+  m_RadiusImage = RadiusImageType::New();
+
+  m_RadiusImage->SetRegions(outputImage->GetLargestPossibleRegion());
+  m_RadiusImage->SetOrigin(inputImage->GetOrigin());
+  m_RadiusImage->SetSpacing(inputImage->GetSpacing());
+  m_RadiusImage->SetDirection(inputImage->GetDirection());
+  m_RadiusImage->Allocate(true); // initialize buffer to zero
+
+  using SinkType = HoughTransformAlgorithm::VoteSink<OutputImageType, RadiusImageType>;
+
+  // The rays point away from the gradient direction only.
+  Matrix<double, 3, 3> identity;
+  identity.SetIdentity();
+  const HoughTransformAlgorithm::RayMatrixContainerType<3> rayMatrices(1, identity);
+
+  const auto voter = [this, inputImage, &DoGFunction, &rayMatrices](const OutputImageRegionType & pieceRegion,
+                                                                    SinkType &                    sink) {
+    HoughTransformAlgorithm::VoteAlongGradients(inputImage.GetPointer(),
+                                                pieceRegion,
+                                                DoGFunction.GetPointer(),
+                                                m_Threshold,
+                                                m_GradientNormThreshold,
+                                                m_MinimumRadius,
+                                                m_MaximumRadius,
+                                                rayMatrices,
+                                                sink);
+  };
+
+  HoughTransformAlgorithm::ParallelVote(inputImage->GetRequestedRegion(),
+                                        outputImage.GetPointer(),
+                                        m_RadiusImage.GetPointer(),
+                                        this->GetMultiThreader(),
+                                        this->GetNumberOfWorkUnits(),
+                                        this,
+                                        voter);
+
+  // Compute the average radius
+  HoughTransformAlgorithm::ComputeAverageRadius(outputImage.GetPointer(), m_RadiusImage.GetPointer());
+}
+
+template <typename TInputPixelType, typename TOutputPixelType, typename TRadiusPixelType>
+typename HoughTransform3DSpheresImageFilter<TInputPixelType, TOutputPixelType, TRadiusPixelType>::SpheresListType &
+HoughTransform3DSpheresImageFilter<TInputPixelType, TOutputPixelType, TRadiusPixelType>::GetSpheres()
+{
+  // Make sure that all the required inputs exist and have a non-null value
+  this->VerifyPreconditions();
+
+  if (this->GetMTime() == m_OldModifiedTime)
+  {
+    // If the filter has not been updated
+    return m_SpheresList;
+  }
+
+  if (m_RadiusImage.IsNull())
+  {
+    itkExceptionMacro(<< "Update() must be called before GetSpheres().");
+  }
+
+  m_SpheresList.clear();
+
+  if (m_NumberOfSpheres > 0)
+  {
+    // Blur the accumulator in order to find the maximum
+    using InternalImageType = Image<float, 3>;
+
+    // The variable "outputImage" is only used as input to gaussianFilter.
+    // It should not be modified, because GetOutput(0) should not be changed.
+    const auto outputImage = OutputImageType::New();
+    outputImage->Graft(this->GetOutput(0));
+
+    const auto gaussianFilter = DiscreteGaussianImageFilter<OutputImageType, InternalImageType>::New();
+
+    gaussianFilter->SetInput(outputImage); // The output is the accumulator image
+    gaussianFilter->SetVariance(m_Variance);
+    gaussianFilter->SetUseImageSpacing(m_UseImageSpacing);
+
+    gaussianFilter->Update();
+    const InternalImageType::Pointer postProcessImage = gaussianFilter->GetOutput();
+
+    const RadiusImageType * const radiusImage = m_RadiusImage;
+    const double                  ballRadiusRatio = m_BallRadiusRatio;
+
+    // Each accepted sphere center suppresses a ball of the accumulator, whose
+    // radius is proportional to the radius of the sphere.
+    using MaskType = HoughTransformAlgorithm::SuppressionMask<InternalImageType>;
+    const auto suppressBall = [radiusImage, ballRadiusRatio](const IndexType & center, MaskType & mask) {
+      const double         ballRadius = ballRadiusRatio * static_cast<double>(radiusImage->GetPixel(center));
+      const IndexValueType extent = static_cast<IndexValueType>(std::ceil(ballRadius));
+
+      IndexType index;
+      for (IndexValueType z = -extent; z <= extent; ++z)
+      {
+        for (IndexValueType y = -extent; y <= extent; ++y)
+        {
+          for (IndexValueType x = -extent; x <= extent; ++x)
+          {
+            if (static_cast<double>(x * x + y * y + z * z) < ballRadius * ballRadius)
+            {
+              index[0] = center[0] + x;
+              index[1] = center[1] + y;
+              index[2] = center[2] + z;
+              mask.Suppress(index);
+            }
+          }
+        }
+      }
+    };
+
+    const std::vector<IndexType> centers = HoughTransformAlgorithm::FindPeaks(postProcessImage.GetPointer(),
+                                                                              m_NumberOfSpheres,
+                                                                              this->GetMultiThreader(),
+                                                                              this->GetNumberOfWorkUnits(),
+                                                                              suppressBall);
+
+    SpheresListSizeType spheres = 0;
+
+    for (const IndexType & center : centers)
+    {
+      // Create a Sphere Spatial Object
+      const auto Sphere = SphereType::New();
+      Sphere->SetId(static_cast<int>(spheres));
+      Sphere->SetRadiusInObjectSpace(m_RadiusImage->GetPixel(center));
+
+      SphereType::PointType centerPoint;
+      for (unsigned int d = 0; d < 3; ++d)
+      {
+        centerPoint[d] = center[d];
+      }
+      Sphere->SetCenterInObjectSpace(centerPoint);
+      Sphere->Update();
+
+      m_SpheresList.push_back(Sphere);
+      ++spheres;
+    }
+  }
+
+  m_OldModifiedTime = this->GetMTime();
+  return m_SpheresList;
+}
+
+template <typename TInputPixelType, typename TOutputPixelType, typename TRadiusPixelType>
+void
+HoughTransform3DSpheresImageFilter<TInputPixelType, TOutputPixelType, TRadiusPixelType>::PrintSelf(std::ostream & os,
+                                                                                                   Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Threshold: " << m_Threshold << std::endl;
+  os << indent << "Gradient Norm Threshold: " << m_GradientNormThreshold << std::endl;
+  os << indent << "Minimum Radius:  " << m_MinimumRadius << std::endl;
+  os << indent << "Maximum Radius: " << m_MaximumRadius << std::endl;
+  os << indent << "Derivative Scale : " << m_SigmaGradient << std::endl;
+  os << indent << "Number Of Spheres: " << m_NumberOfSpheres << std::endl;
+  os << indent << "Ball Radius Ratio: " << m_BallRadiusRatio << std::endl;
+  os << indent << "Accumulator blur variance: " << m_Variance << std::endl;
+  os << indent << "UseImageSpacing: " << m_UseImageSpacing << std::endl;
+
+  itkPrintSelfObjectMacro(RadiusImage);
+
+  os << indent << "SpheresList: " << std::endl;
+  unsigned int i = 0;
+  auto         it = m_SpheresList.begin();
+  while (it != m_SpheresList.end())
+  {
+    os << indent << "[" << i << "]: " << *it << std::endl;
+    ++it;
+    ++i;
+  }
+
+  os << indent << "OldModifiedTime: " << NumericTraits<ModifiedTimeType>::PrintType(m_OldModifiedTime) << std::endl;
+}
+} // namespace itk
+
+#endif
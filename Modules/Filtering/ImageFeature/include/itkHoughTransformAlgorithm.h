@@ -0,0 +1,446 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHoughTransformAlgorithm_h
+#define itkHoughTransformAlgorithm_h
+
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionSplitterSlowDimension.h"
+#include "itkMath.h"
+#include "itkMatrix.h"
+#include "itkMultiThreaderBase.h"
+#include "itkNumericTraits.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace itk
+{
+
+/** \class HoughTransformAlgorithm
+ * \brief A container of static functions shared by the Hough transform filters.
+ *
+ * ParallelVote() lets several work units cast votes into the same accumulator
+ * (and optional radius) image. The input domain is split into pieces; the
+ * first piece votes directly into the output buffers, and every other piece
+ * votes into private buffers which are summed into the output afterwards, in
+ * piece order. The result does therefore not depend on thread scheduling.
+ *
+ * VoteAlongGradients() is the voting kernel of the circle and sphere filters,
+ * and ComputeAverageRadius() turns their accumulated radii into averages.
+ *
+ * FindPeaks() performs a greedy non-maximum suppression on an accumulator:
+ * the positive pixels are gathered in parallel, sorted by decreasing value
+ * (ties are resolved in raster order), and accepted one by one unless they
+ * were suppressed by a previously accepted peak. This yields the same peaks
+ * as repeatedly searching for the maximum and erasing its neighborhood, in a
+ * single pass over the accumulator.
+ *
+ * \ingroup ITKImageFeature
+ */
+struct HoughTransformAlgorithm
+{
+  /** \class VoteSink
+   * \brief Receives the votes of one piece of the input domain.
+   *
+   * The sink writes into buffers laid out like the buffered region of the
+   * accumulator image. Callers must only vote at indices for which IsInside()
+   * returns true.
+   *
+   * \ingroup ITKImageFeature
+   */
+  template <typename TAccumulatorImage, typename TRadiusImage>
+  class VoteSink
+  {
+  public:
+    using IndexType = typename TAccumulatorImage::IndexType;
+    using RegionType = typename TAccumulatorImage::RegionType;
+    using AccumulatorPixelType = typename TAccumulatorImage::PixelType;
+    using RadiusPixelType = typename TRadiusImage::PixelType;
+
+    static constexpr unsigned int ImageDimension = TAccumulatorImage::ImageDimension;
+
+    VoteSink(const RegionType & region, AccumulatorPixelType * accumulator, RadiusPixelType * radius)
+      : m_Region(region)
+      , m_Accumulator(accumulator)
+      , m_Radius(radius)
+    {
+      OffsetValueType stride = 1;
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        m_Strides[d] = stride;
+        stride *= static_cast<OffsetValueType>(region.GetSize(d));
+      }
+    }
+
+    bool
+    IsInside(const IndexType & index) const
+    {
+      return m_Region.IsInside(index);
+    }
+
+    /** Adds one vote at the specified index. */
+    void
+    AddVote(const IndexType & index)
+    {
+      ++m_Accumulator[this->ComputeOffset(index)];
+    }
+
+    /** Adds one vote at the specified index, and accumulates the radius
+     * (distance) associated with the vote. Requires a radius buffer. */
+    void
+    AddVote(const IndexType & index, double radius)
+    {
+      const OffsetValueType offset = this->ComputeOffset(index);
+      ++m_Accumulator[offset];
+      m_Radius[offset] += radius;
+    }
+
+  private:
+    OffsetValueType
+    ComputeOffset(const IndexType & index) const
+    {
+      OffsetValueType offset = 0;
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        offset += (index[d] - m_Region.GetIndex(d)) * m_Strides[d];
+      }
+      return offset;
+    }
+
+    const RegionType       m_Region;
+    AccumulatorPixelType * m_Accumulator;
+    RadiusPixelType *      m_Radius;
+    OffsetValueType        m_Strides[ImageDimension];
+  };
+
+  /** Splits the input region into (at most) numberOfWorkUnits pieces and
+   * calls voter(pieceRegion, sink) for each piece, concurrently. The
+   * accumulator (and, if not null, the radius image) must be allocated and
+   * initialized before the call. Their buffered regions must be equal. The
+   * pieces are distributed over the work units of the multi-threader, whose
+   * settings are left unchanged. */
+  template <typename TInputRegion, typename TAccumulatorImage, typename TRadiusImage, typename TVoter>
+  static void
+  ParallelVote(const TInputRegion & inputRegion,
+               TAccumulatorImage *  accumulator,
+               TRadiusImage *       radiusImage,
+               MultiThreaderBase *  multiThreader,
+               ThreadIdType         numberOfWorkUnits,
+               ProcessObject *      filter,
+               const TVoter &       voter)
+  {
+    using SinkType = VoteSink<TAccumulatorImage, TRadiusImage>;
+    using AccumulatorPixelType = typename SinkType::AccumulatorPixelType;
+    using RadiusPixelType = typename SinkType::RadiusPixelType;
+
+    const typename TAccumulatorImage::RegionType & region = accumulator->GetBufferedRegion();
+    const SizeValueType                            numberOfPixels = region.GetNumberOfPixels();
+
+    const auto         splitter = ImageRegionSplitterSlowDimension::New();
+    const unsigned int numberOfPieces =
+      splitter->GetNumberOfSplits(inputRegion, std::max(numberOfWorkUnits, ThreadIdType{ 1 }));
+
+    std::vector<std::vector<AccumulatorPixelType>> localAccumulators(numberOfPieces - 1);
+    std::vector<std::vector<RadiusPixelType>>      localRadii(radiusImage ? numberOfPieces - 1 : 0);
+
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfPieces,
+      [&](SizeValueType piece) {
+        TInputRegion pieceRegion = inputRegion;
+        splitter->GetSplit(static_cast<unsigned int>(piece), numberOfPieces, pieceRegion);
+
+        AccumulatorPixelType * accumulatorBuffer = accumulator->GetBufferPointer();
+        RadiusPixelType *      radiusBuffer = radiusImage ? radiusImage->GetBufferPointer() : nullptr;
+        if (piece > 0)
+        {
+          localAccumulators[piece - 1].assign(numberOfPixels, NumericTraits<AccumulatorPixelType>::ZeroValue());
+          accumulatorBuffer = localAccumulators[piece - 1].data();
+          if (radiusImage)
+          {
+            localRadii[piece - 1].assign(numberOfPixels, NumericTraits<RadiusPixelType>::ZeroValue());
+            radiusBuffer = localRadii[piece - 1].data();
+          }
+        }
+        SinkType sink(region, accumulatorBuffer, radiusBuffer);
+        voter(pieceRegion, sink);
+      },
+      filter);
+
+    if (numberOfPieces < 2)
+    {
+      return;
+    }
+
+    // Reduce the private buffers into the output, block by block.
+    constexpr SizeValueType blockSize = 4096;
+    const SizeValueType     numberOfBlocks = (numberOfPixels + blockSize - 1) / blockSize;
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfBlocks,
+      [&](SizeValueType block) {
+        const SizeValueType    begin = block * blockSize;
+        const SizeValueType    end = std::min(begin + blockSize, numberOfPixels);
+        AccumulatorPixelType * accumulatorBuffer = accumulator->GetBufferPointer();
+        RadiusPixelType *      radiusBuffer = radiusImage ? radiusImage->GetBufferPointer() : nullptr;
+        for (unsigned int piece = 1; piece < numberOfPieces; ++piece)
+        {
+          const AccumulatorPixelType * const localAccumulator = localAccumulators[piece - 1].data();
+          for (SizeValueType i = begin; i < end; ++i)
+          {
+            accumulatorBuffer[i] += localAccumulator[i];
+          }
+          if (radiusImage)
+          {
+            const RadiusPixelType * const localRadius = localRadii[piece - 1].data();
+            for (SizeValueType i = begin; i < end; ++i)
+            {
+              radiusBuffer[i] += localRadius[i];
+            }
+          }
+        }
+      },
+      nullptr);
+  }
+
+  /** The matrices that map the unit gradient to the directions of the rays. */
+  template <unsigned int VDimension>
+  using RayMatrixContainerType = std::vector<Matrix<double, VDimension, VDimension>>;
+
+  /** Casts the votes of the pixels of pieceRegion for the centers of the
+   * circles (spheres) they may lie on. From each pixel above the threshold,
+   * whose gradient norm is above gradientNormThreshold, a ray is cast for
+   * each of the rayMatrices, in the direction opposite to the matrix times
+   * the unit gradient. Votes are cast along the ray from minimumRadius until
+   * the distance to the pixel reaches maximumRadius or the ray leaves the
+   * accumulator, and record that distance in the radius buffer. */
+  template <typename TInputImage, typename TGradientFunction, typename TSink>
+  static void
+  VoteAlongGradients(const TInputImage *                                        inputImage,
+                     const typename TInputImage::RegionType &                   pieceRegion,
+                     const TGradientFunction *                                  gradientFunction,
+                     double                                                     threshold,
+                     double                                                     gradientNormThreshold,
+                     double                                                     minimumRadius,
+                     double                                                     maximumRadius,
+                     const RayMatrixContainerType<TInputImage::ImageDimension> & rayMatrices,
+                     TSink &                                                    sink)
+  {
+    constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+    using IndexType = typename TInputImage::IndexType;
+
+    ImageRegionConstIteratorWithIndex<TInputImage> image_it(inputImage, pieceRegion);
+
+    for (image_it.GoToBegin(); !image_it.IsAtEnd(); ++image_it)
+    {
+      if (image_it.Get() > threshold)
+      {
+        const IndexType inputIndex = image_it.GetIndex();
+        const auto      grad = gradientFunction->TGradientFunction::EvaluateAtIndex(inputIndex);
+        const double    norm = grad.GetNorm();
+
+        // if the gradient is not flat (using GradientNormThreshold to estimate flatness)
+        if (norm > gradientNormThreshold)
+        {
+          double unitGradient[ImageDimension];
+          for (unsigned int d = 0; d < ImageDimension; ++d)
+          {
+            unitGradient[d] = grad[d] / norm;
+          }
+
+          for (const auto & rayMatrix : rayMatrices)
+          {
+            double direction[ImageDimension];
+            for (unsigned int d = 0; d < ImageDimension; ++d)
+            {
+              direction[d] = 0.0;
+              for (unsigned int j = 0; j < ImageDimension; ++j)
+              {
+                direction[d] += unitGradient[j] * rayMatrix[d][j];
+              }
+            }
+
+            double i = minimumRadius;
+            double distance;
+
+            do
+            {
+              IndexType outputIndex;
+              double    squaredDistance = 0.0;
+              for (unsigned int d = 0; d < ImageDimension; ++d)
+              {
+                outputIndex[d] = Math::Round<IndexValueType>(inputIndex[d] - i * direction[d]);
+                const double difference = static_cast<double>(outputIndex[d] - inputIndex[d]);
+                squaredDistance += difference * difference;
+              }
+
+              if (sink.IsInside(outputIndex))
+              {
+                distance = std::sqrt(squaredDistance);
+                sink.AddVote(outputIndex, distance);
+              }
+              else
+              {
+                break;
+              }
+              ++i;
+            } while (distance < maximumRadius);
+          }
+        }
+      }
+    }
+  }
+
+  /** Divides the accumulated radii by the number of votes, where there is
+   * more than one vote. */
+  template <typename TAccumulatorImage, typename TRadiusImage>
+  static void
+  ComputeAverageRadius(const TAccumulatorImage * accumulator, TRadiusImage * radiusImage)
+  {
+    ImageRegionConstIterator<TAccumulatorImage> output_it(accumulator, accumulator->GetLargestPossibleRegion());
+    ImageRegionIterator<TRadiusImage>           radius_it(radiusImage, radiusImage->GetLargestPossibleRegion());
+    output_it.GoToBegin();
+    radius_it.GoToBegin();
+    while (!output_it.IsAtEnd())
+    {
+      if (output_it.Get() > 1)
+      {
+        radius_it.Value() /= output_it.Get();
+      }
+      ++output_it;
+      ++radius_it;
+    }
+  }
+
+  /** \class SuppressionMask
+   * \brief Marks the accumulator pixels that can no longer become a peak.
+   *
+   * \ingroup ITKImageFeature
+   */
+  template <typename TImage>
+  class SuppressionMask
+  {
+  public:
+    using IndexType = typename TImage::IndexType;
+    using RegionType = typename TImage::RegionType;
+
+    explicit SuppressionMask(const TImage * image)
+      : m_Image(image)
+      , m_Region(image->GetBufferedRegion())
+      , m_Suppressed(m_Region.GetNumberOfPixels(), false)
+    {}
+
+    /** Suppresses the pixel at the specified index. Indices outside the
+     * accumulator are silently ignored. */
+    void
+    Suppress(const IndexType & index)
+    {
+      if (m_Region.IsInside(index))
+      {
+        m_Suppressed[m_Image->ComputeOffset(index)] = true;
+      }
+    }
+
+    bool
+    IsSuppressed(OffsetValueType offset) const
+    {
+      return m_Suppressed[offset];
+    }
+
+  private:
+    const TImage *    m_Image;
+    const RegionType  m_Region;
+    std::vector<bool> m_Suppressed;
+  };
+
+  /** Returns the indices of at most numberOfPeaks peaks of the image, in
+   * order of decreasing value. Only strictly positive pixels are considered.
+   * After each accepted peak (except the last one), suppress(peakIndex, mask)
+   * is called to let the caller suppress the neighborhood of the peak. */
+  template <typename TImage, typename TSuppressFunction>
+  static std::vector<typename TImage::IndexType>
+  FindPeaks(const TImage *      image,
+            SizeValueType       numberOfPeaks,
+            MultiThreaderBase * multiThreader,
+            ThreadIdType        numberOfWorkUnits,
+            TSuppressFunction   suppress)
+  {
+    using PixelType = typename TImage::PixelType;
+
+    std::vector<typename TImage::IndexType> peaks;
+    if (numberOfPeaks == 0)
+    {
+      return peaks;
+    }
+
+    const PixelType * const buffer = image->GetBufferPointer();
+    const SizeValueType     numberOfPixels = image->GetBufferedRegion().GetNumberOfPixels();
+    const SizeValueType     numberOfBlocks =
+      std::max<SizeValueType>(std::min<SizeValueType>(numberOfWorkUnits, numberOfPixels), 1);
+    const SizeValueType     blockSize = (numberOfPixels + numberOfBlocks - 1) / numberOfBlocks;
+
+    // Gather the candidates of each block in raster order.
+    std::vector<std::vector<OffsetValueType>> blockCandidates(numberOfBlocks);
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfBlocks,
+      [&](SizeValueType block) {
+        const SizeValueType begin = block * blockSize;
+        const SizeValueType end = std::min(begin + blockSize, numberOfPixels);
+        for (SizeValueType i = begin; i < end; ++i)
+        {
+          if (buffer[i] > NumericTraits<PixelType>::ZeroValue())
+          {
+            blockCandidates[block].push_back(static_cast<OffsetValueType>(i));
+          }
+        }
+      },
+      nullptr);
+
+    std::vector<OffsetValueType> candidates;
+    for (const auto & block : blockCandidates)
+    {
+      candidates.insert(candidates.end(), block.cbegin(), block.cend());
+    }
+    std::stable_sort(candidates.begin(), candidates.end(), [buffer](OffsetValueType a, OffsetValueType b) {
+      return buffer[a] > buffer[b];
+    });
+
+    SuppressionMask<TImage> mask(image);
+    for (const OffsetValueType candidate : candidates)
+    {
+      if (mask.IsSuppressed(candidate))
+      {
+        continue;
+      }
+      const typename TImage::IndexType peak = image->ComputeIndex(candidate);
+      peaks.push_back(peak);
+      if (peaks.size() >= numberOfPeaks)
+      {
+        break;
+      }
+      suppress(peak, mask);
+    }
+    return peaks;
+  }
+};
+
+} // end namespace itk
+
+#endif
@@ -20,6 +20,8 @@
 
 #include "itkImageToImageFilter.h"
 
+#include <array>
+
 namespace itk
 {
 /**
@@ -35,7 +37,10 @@ namespace itk
  *
  * \par
  * The Laplacian at each pixel location is computed by convolution with the
- * itk::LaplacianOperator.
+ * itk::LaplacianOperator. Only the 2N+1 nonzero coefficients of the operator
+ * are applied, and away from the image boundary the neighborhoods are
+ * visited with a FixedRadiusConstNeighborhoodIterator. The boundary uses the
+ * ZeroFluxNeumannBoundaryCondition.
  *
  * \par Inputs and Outputs
  * The input to this filter is a scalar-valued itk::Image of arbitrary
@@ -82,6 +87,7 @@ public:
   using InputImageType = TInputImage;
   using OutputImageType = TOutputImage;
   using InputImagePointer = typename InputImageType::Pointer;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
 
   /** Smart pointer type alias support   */
   using Pointer = SmartPointer<Self>;
@@ -122,22 +128,33 @@ public:
 #endif
 
 protected:
-  LaplacianImageFilter() { m_UseImageSpacing = true; }
+  LaplacianImageFilter();
 
   ~LaplacianImageFilter() override = default;
 
-  /** Standard pipeline method. While this class does not implement a
-   * ThreadedGenerateData(), its GenerateData() delegates all
-   * calculations to an NeighborhoodOperatorImageFilter.  Since the
-   * NeighborhoodOperatorImageFilter is multithreaded, this filter is
-   * multithreaded by default.   */
+  /** Computes the Laplacian of the pixels of the region of a work unit. */
   void
-  GenerateData() override;
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
   void
   PrintSelf(std::ostream &, Indent) const override;
 
 private:
+  // The number of nonzero coefficients of the Laplacian operator.
+  static constexpr unsigned int StencilSize = 2 * ImageDimension + 1;
+
+  // The neighbor indices and the values of the nonzero coefficients of the
+  // operator, in increasing order of neighbor index.
+  using StencilIndicesType = std::array<unsigned int, StencilSize>;
+  using StencilCoefficientsType = std::array<OutputPixelType, StencilSize>;
+
+  // Computes the inner product of the stencil with the neighborhood.
+  template <typename TNeighborhood>
+  static OutputPixelType
+  ComputeLaplacian(const TNeighborhood &           neighborhood,
+                   const StencilIndicesType &      indices,
+                   const StencilCoefficientsType & coefficients);
+
   bool m_UseImageSpacing;
 };
 } // end namespace itk
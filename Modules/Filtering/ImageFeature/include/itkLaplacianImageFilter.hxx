@@ -19,9 +19,14 @@
 #define itkLaplacianImageFilter_hxx
 #include "itkLaplacianImageFilter.h"
 
-#include "itkNeighborhoodOperatorImageFilter.h"
+#include "itkConstNeighborhoodIterator.h"
+#include "itkFixedNeighborhoodAllocator.h"
+#include "itkFixedRadiusConstNeighborhoodIterator.h"
+#include "itkImageRegionIterator.h"
 #include "itkLaplacianOperator.h"
-#include "itkProgressAccumulator.h"
+#include "itkNeighborhoodAlgorithm.h"
+#include "itkTotalProgressReporter.h"
+#include "itkZeroFluxNeumannBoundaryCondition.h"
 
 namespace itk
 {
@@ -85,63 +90,111 @@ LaplacianImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
 }
 
 template <typename TInputImage, typename TOutputImage>
-void
-LaplacianImageFilter<TInputImage, TOutputImage>::GenerateData()
+LaplacianImageFilter<TInputImage, TOutputImage>::LaplacianImageFilter()
 {
-  double s[ImageDimension];
+  m_UseImageSpacing = true;
+  this->DynamicMultiThreadingOn();
+  this->ThreaderUpdateProgressOff();
+}
 
-  typename TOutputImage::Pointer output = this->GetOutput();
-  output->SetBufferedRegion(output->GetRequestedRegion());
-  output->Allocate();
+template <typename TInputImage, typename TOutputImage>
+void
+LaplacianImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  using FixedRadiusIteratorType = FixedRadiusConstNeighborhoodIterator<InputImageType, 1>;
 
-  ZeroFluxNeumannBoundaryCondition<TInputImage> nbc;
+  OutputImageType *      output = this->GetOutput();
+  const InputImageType * input = this->GetInput();
 
-  // Create the Laplacian operator
-  LaplacianOperator<OutputPixelType, ImageDimension> oper;
+  double s[ImageDimension];
   for (unsigned i = 0; i < ImageDimension; i++)
   {
-    if (this->GetInput()->GetSpacing()[i] == 0.0)
+    if (input->GetSpacing()[i] == 0.0)
     {
       itkExceptionMacro(<< "Image spacing cannot be zero");
     }
     else
     {
-      s[i] = 1.0 / this->GetInput()->GetSpacing()[i];
+      s[i] = 1.0 / input->GetSpacing()[i];
     }
   }
+
+  // Create the Laplacian operator, on the stack.
+  LaplacianOperator<OutputPixelType,
+                    ImageDimension,
+                    FixedNeighborhoodAllocator<OutputPixelType, FixedRadiusIteratorType::NumberOfNeighbors>>
+    oper;
   oper.SetDerivativeScalings(s);
   oper.CreateOperator();
 
-  using NOIF = NeighborhoodOperatorImageFilter<InputImageType, OutputImageType>;
-  typename NOIF::Pointer filter = NOIF::New();
-
-  filter->OverrideBoundaryCondition(&nbc);
-
-  // Create a process accumulator for tracking the progress of this minipipeline
-  ProgressAccumulator::Pointer progress = ProgressAccumulator::New();
-  progress->SetMiniPipelineFilter(this);
+  // Only keep the center and its two neighbors along each dimension; the
+  // other coefficients of the operator are zero.
+  StencilIndicesType      indices;
+  StencilCoefficientsType coefficients;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    const unsigned int stride = FixedRadiusIteratorType::GetNeighborStride(i);
+    indices[ImageDimension - 1 - i] = FixedRadiusIteratorType::CenterNeighborIndex - stride;
+    indices[ImageDimension + 1 + i] = FixedRadiusIteratorType::CenterNeighborIndex + stride;
+  }
+  indices[ImageDimension] = FixedRadiusIteratorType::CenterNeighborIndex;
+  for (unsigned int k = 0; k < StencilSize; ++k)
+  {
+    coefficients[k] = oper[indices[k]];
+  }
 
-  // Register the filter with the with progress accumulator using
-  // equal weight proportion
-  progress->RegisterInternalFilter(filter, 1.0f);
+  const auto faces = NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>::Compute(
+    *input, outputRegionForThread, oper.GetRadius());
 
-  //
-  // set up the mini-pipline
-  //
-  filter->SetOperator(oper);
-  filter->SetInput(this->GetInput());
+  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
 
-  // graft this filter's output to the mini-pipeline.  this sets up
-  // the mini-pipeline to write to this filter's output and copies
-  // region ivars and meta-data
-  filter->GraftOutput(output);
+  // The non-boundary region needs no boundary condition.
+  const OutputImageRegionType          nonBoundaryRegion = faces.GetNonBoundaryRegion();
+  FixedRadiusIteratorType              fixedIt(input, nonBoundaryRegion);
+  ImageRegionIterator<OutputImageType> it(output, nonBoundaryRegion);
+  for (; !fixedIt.IsAtEnd(); ++fixedIt, ++it)
+  {
+    it.Set(ComputeLaplacian(fixedIt, indices, coefficients));
+    progress.CompletedPixel();
+  }
 
-  // execute the mini-pipeline
-  filter->Update();
+  // The boundary faces.
+  ZeroFluxNeumannBoundaryCondition<TInputImage> nbc;
+  for (const auto & face : faces.GetBoundaryFaces())
+  {
+    ConstNeighborhoodIterator<InputImageType> bit(oper.GetRadius(), input, face);
+    ImageRegionIterator<OutputImageType>      faceIt(output, face);
+    bit.OverrideBoundaryCondition(&nbc);
+    for (bit.GoToBegin(); !bit.IsAtEnd(); ++bit, ++faceIt)
+    {
+      faceIt.Set(ComputeLaplacian(bit, indices, coefficients));
+      progress.CompletedPixel();
+    }
+  }
+}
 
-  // graft the output of the mini-pipeline back onto the filter's output.
-  // this copies back the region ivars and meta-dataig
-  this->GraftOutput(filter->GetOutput());
+template <typename TInputImage, typename TOutputImage>
+template <typename TNeighborhood>
+auto
+LaplacianImageFilter<TInputImage, TOutputImage>::ComputeLaplacian(const TNeighborhood &           neighborhood,
+                                                                  const StencilIndicesType &      indices,
+                                                                  const StencilCoefficientsType & coefficients)
+  -> OutputPixelType
+{
+  // Same arithmetic as NeighborhoodOperatorImageFilter.
+  using ComputingPixelType = typename NumericTraits<OutputPixelType>::RealType;
+  using ComputingPixelValueType = typename NumericTraits<ComputingPixelType>::ValueType;
+  using InputPixelRealType = typename NumericTraits<InputPixelType>::RealType;
+  using AccumulateRealType = typename NumericTraits<InputPixelRealType>::AccumulateType;
+
+  AccumulateRealType sum = NumericTraits<AccumulateRealType>::ZeroValue();
+  for (unsigned int k = 0; k < StencilSize; ++k)
+  {
+    sum += static_cast<AccumulateRealType>(static_cast<ComputingPixelValueType>(coefficients[k]) *
+                                           static_cast<InputPixelRealType>(neighborhood.GetPixel(indices[k])));
+  }
+  return static_cast<OutputPixelType>(static_cast<ComputingPixelType>(sum));
 }
 } // end namespace itk
 
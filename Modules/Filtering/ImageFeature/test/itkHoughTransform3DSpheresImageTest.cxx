@@ -0,0 +1,163 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHoughTransform3DSpheresImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+
+namespace
+{
+using PixelType = unsigned char;
+using ImageType = itk::Image<PixelType, 3>;
+
+void
+CreateBall(ImageType * image, const double center[3], double radius)
+{
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    double squaredDistance = 0.0;
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      const double difference = it.GetIndex()[d] - center[d];
+      squaredDistance += difference * difference;
+    }
+    if (squaredDistance <= radius * radius)
+    {
+      it.Set(255);
+    }
+  }
+}
+} // namespace
+
+
+int
+itkHoughTransform3DSpheresImageTest(int, char *[])
+{
+  const auto                image = ImageType::New();
+  const ImageType::SizeType size = { { 48, 40, 32 } };
+  image->SetRegions(size);
+  image->Allocate(true);
+
+  const double centers[2][3] = { { 14, 12, 10 }, { 32, 26, 20 } };
+  const double radii[2] = { 6, 8 };
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    CreateBall(image, centers[i], radii[i]);
+  }
+
+  using FilterType = itk::HoughTransform3DSpheresImageFilter<PixelType, unsigned long, double>;
+  auto filter = FilterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, HoughTransform3DSpheresImageFilter, ImageToImageFilter);
+
+  filter->SetRadius(7.0);
+  ITK_TEST_SET_GET_VALUE(7.0, filter->GetMinimumRadius());
+  ITK_TEST_SET_GET_VALUE(7.0, filter->GetMaximumRadius());
+
+  filter->SetMinimumRadius(4.0);
+  filter->SetMaximumRadius(10.0);
+  filter->SetSigmaGradient(1.0);
+  filter->SetNumberOfSpheres(2);
+  ITK_TEST_SET_GET_VALUE(2, filter->GetNumberOfSpheres());
+  filter->SetBallRadiusRatio(1.0);
+  ITK_TEST_SET_GET_VALUE(1.0, filter->GetBallRadiusRatio());
+  filter->SetVariance(2.0);
+  ITK_TEST_SET_GET_VALUE(2.0, filter->GetVariance());
+
+  ITK_TRY_EXPECT_EXCEPTION(filter->GetSpheres());
+
+  filter->SetInput(image);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  bool success = true;
+
+  const FilterType::SpheresListType & spheres = filter->GetSpheres();
+  if (spheres.size() != 2)
+  {
+    std::cout << "Expected 2 spheres, found " << spheres.size() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  for (const FilterType::SpherePointer & sphere : spheres)
+  {
+    // Match the detected sphere with the closest actual ball.
+    const FilterType::SphereType::PointType center = sphere->GetCenterInObjectSpace();
+    unsigned int                            closest = 0;
+    double                                  closestDistance = itk::NumericTraits<double>::max();
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+      double squaredDistance = 0.0;
+      for (unsigned int d = 0; d < 3; ++d)
+      {
+        squaredDistance += (center[d] - centers[i][d]) * (center[d] - centers[i][d]);
+      }
+      if (squaredDistance < closestDistance)
+      {
+        closestDistance = squaredDistance;
+        closest = i;
+      }
+    }
+
+    const double radius = sphere->GetRadiusInObjectSpace()[0];
+    std::cout << "Sphere " << center << " -> radius: " << radius << std::endl;
+
+    if (std::sqrt(closestDistance) > 2.0 || std::abs(radius - radii[closest]) > 2.0)
+    {
+      std::cout << "Expected center " << centers[closest][0] << ", " << centers[closest][1] << ", "
+                << centers[closest][2] << " and radius " << radii[closest] << std::endl;
+      success = false;
+    }
+  }
+
+  // The accumulator must not depend on the number of work units.
+  auto serialFilter = FilterType::New();
+  serialFilter->SetInput(image);
+  serialFilter->SetMinimumRadius(4.0);
+  serialFilter->SetMaximumRadius(10.0);
+  serialFilter->SetNumberOfWorkUnits(1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(serialFilter->Update());
+
+  filter->SetNumberOfWorkUnits(5);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  itk::ImageRegionConstIterator<FilterType::OutputImageType> serialIt(serialFilter->GetOutput(),
+                                                                      serialFilter->GetOutput()->GetBufferedRegion());
+  itk::ImageRegionConstIterator<FilterType::OutputImageType> parallelIt(filter->GetOutput(),
+                                                                        filter->GetOutput()->GetBufferedRegion());
+  for (; !serialIt.IsAtEnd(); ++serialIt, ++parallelIt)
+  {
+    if (serialIt.Get() != parallelIt.Get())
+    {
+      std::cout << "Accumulator differs at " << serialIt.GetIndex() << ": " << serialIt.Get()
+                << " != " << parallelIt.Get() << std::endl;
+      success = false;
+      break;
+    }
+  }
+
+  if (success)
+  {
+    std::cout << "Test succeeded!" << std::endl;
+    return EXIT_SUCCESS;
+  }
+  std::cout << "Test FAILED!" << std::endl;
+  return EXIT_FAILURE;
+}
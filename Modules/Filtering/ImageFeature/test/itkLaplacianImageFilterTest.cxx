@@ -18,6 +18,10 @@
 
 #include <iostream>
 #include "itkLaplacianImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkLaplacianOperator.h"
+#include "itkNeighborhoodOperatorImageFilter.h"
 #include "itkNullImageToImageFilterDriver.hxx"
 #include "itkSimpleFilterWatcher.h"
 
@@ -50,6 +54,47 @@ itkLaplacianImageFilterTest(int, char *[])
     test1.SetFilter(filter);
     test1.Execute();
 
+    // The Laplacian must be the convolution with the LaplacianOperator,
+    // both inside the image and at its boundary.
+    const auto                image = ImageType::New();
+    const ImageType::SizeType imageSize = { { 23, 17 } };
+    image->SetRegions(imageSize);
+    ImageType::SpacingType spacing;
+    spacing[0] = 0.5;
+    spacing[1] = 2.0;
+    image->SetSpacing(spacing);
+    image->Allocate();
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      const ImageType::IndexType index = it.GetIndex();
+      it.Set(static_cast<float>((index[0] * 7 + index[1] * index[1] * 3) % 29) * 0.25f);
+    }
+    const auto laplacian = itk::LaplacianImageFilter<ImageType, ImageType>::New();
+    laplacian->SetInput(image);
+    laplacian->Update();
+
+    itk::LaplacianOperator<float, 2> oper;
+    const double                     scalings[2] = { 1.0 / spacing[0], 1.0 / spacing[1] };
+    oper.SetDerivativeScalings(scalings);
+    oper.CreateOperator();
+    using NOIFType = itk::NeighborhoodOperatorImageFilter<ImageType, ImageType>;
+    const auto convolution = NOIFType::New();
+    convolution->SetOperator(oper);
+    convolution->SetInput(image);
+    convolution->Update();
+
+    itk::ImageRegionConstIterator<ImageType> outputIt(laplacian->GetOutput(), image->GetBufferedRegion());
+    itk::ImageRegionConstIterator<ImageType> expectedIt(convolution->GetOutput(), image->GetBufferedRegion());
+    for (; !outputIt.IsAtEnd(); ++outputIt, ++expectedIt)
+    {
+      if (outputIt.Get() != expectedIt.Get())
+      {
+        std::cerr << "Laplacian at " << outputIt.GetIndex() << " is " << outputIt.Get() << " instead of "
+                  << expectedIt.Get() << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
     // verify the fix for Bug: 788
     // The following code should throw an exception and not crash.
     filter->SetInput(nullptr);
@@ -23,6 +23,7 @@
 
 
 #include <functional>
+#include <type_traits> // For integral_constant.
 
 namespace itk
 {
@@ -253,6 +254,24 @@ protected:
   GenerateOutputInformation() override;
 
 private:
+  /** Tells whether the input and output pixels can be accessed through raw
+   * pointers to the scanlines of the image buffers. */
+  using HasPixelScanlinesType = std::integral_constant<bool,
+                                                       MultiThreaderBase::HasPixelScanlines<TInputImage1>() &&
+                                                         MultiThreaderBase::HasPixelScanlines<TInputImage2>() &&
+                                                         MultiThreaderBase::HasPixelScanlines<TOutputImage>()>;
+
+  /** Applies the functor to the pixels of the region, either through raw
+   * pointers to the contiguous pixels of each scanline (std::true_type), so
+   * that the loop may be vectorized by the compiler, or through scanline
+   * iterators (std::false_type). */
+  template <typename TFunctor>
+  void
+  ThreadedApplyFunctor(const TFunctor &, const OutputImageRegionType & outputRegionForThread, std::true_type);
+  template <typename TFunctor>
+  void
+  ThreadedApplyFunctor(const TFunctor &, const OutputImageRegionType & outputRegionForThread, std::false_type);
+
   std::function<void(const OutputImageRegionType &)> m_DynamicThreadedGenerateDataFunction;
 };
 } // end namespace itk
@@ -175,6 +175,96 @@ void
 BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::DynamicThreadedGenerateDataWithFunctor(
   const TFunctor &              functor,
   const OutputImageRegionType & outputRegionForThread)
+{
+  this->ThreadedApplyFunctor(functor, outputRegionForThread, HasPixelScanlinesType());
+}
+
+
+template <typename TInputImage1, typename TInputImage2, typename TOutputImage>
+template <typename TFunctor>
+void
+BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::ThreadedApplyFunctor(
+  const TFunctor &              functor,
+  const OutputImageRegionType & outputRegionForThread,
+  std::true_type)
+{
+  // We use dynamic_cast since inputs are stored as DataObjects. The
+  // ImageToImageFilter::GetInput(int) always returns a pointer to a
+  // TInputImage1 so it cannot be used for the second input.
+  const auto *   inputPtr1 = dynamic_cast<const TInputImage1 *>(ProcessObject::GetInput(0));
+  const auto *   inputPtr2 = dynamic_cast<const TInputImage2 *>(ProcessObject::GetInput(1));
+  TOutputImage * outputPtr = this->GetOutput(0);
+
+  TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
+
+  if (inputPtr1 && inputPtr2)
+  {
+    MultiThreaderBase::ProcessImageScanlines(
+      outputRegionForThread,
+      [&functor, &progress](SizeValueType                numberOfPixels,
+                            OutputImagePixelType *       output,
+                            const Input1ImagePixelType * input1,
+                            const Input2ImagePixelType * input2) {
+        for (SizeValueType i = 0; i < numberOfPixels; ++i)
+        {
+          output[i] = functor(input1[i], input2[i]);
+        }
+        progress.Completed(numberOfPixels);
+      },
+      *outputPtr,
+      *inputPtr1,
+      *inputPtr2);
+  }
+  else if (inputPtr1)
+  {
+    // The constant is copied, so that the compiler knows that the output
+    // pixels do not alias it.
+    const Input2ImagePixelType input2Value = this->GetConstant2();
+
+    MultiThreaderBase::ProcessImageScanlines(
+      outputRegionForThread,
+      [&functor, &progress, input2Value](
+        SizeValueType numberOfPixels, OutputImagePixelType * output, const Input1ImagePixelType * input1) {
+        for (SizeValueType i = 0; i < numberOfPixels; ++i)
+        {
+          output[i] = functor(input1[i], input2Value);
+        }
+        progress.Completed(numberOfPixels);
+      },
+      *outputPtr,
+      *inputPtr1);
+  }
+  else if (inputPtr2)
+  {
+    const Input1ImagePixelType input1Value = this->GetConstant1();
+
+    MultiThreaderBase::ProcessImageScanlines(
+      outputRegionForThread,
+      [&functor, &progress, input1Value](
+        SizeValueType numberOfPixels, OutputImagePixelType * output, const Input2ImagePixelType * input2) {
+        for (SizeValueType i = 0; i < numberOfPixels; ++i)
+        {
+          output[i] = functor(input1Value, input2[i]);
+        }
+        progress.Completed(numberOfPixels);
+      },
+      *outputPtr,
+      *inputPtr2);
+  }
+  else
+  {
+    itkGenericExceptionMacro(<< "At most one of the inputs can be a constant.");
+  }
+}
+
+
+template <typename TInputImage1, typename TInputImage2, typename TOutputImage>
+template <typename TFunctor>
+void
+BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::ThreadedApplyFunctor(
+  const TFunctor &              functor,
+  const OutputImageRegionType & outputRegionForThread,
+  std::false_type)
 {
   // We use dynamic_cast since inputs are stored as DataObjects. The
   // ImageToImageFilter::GetInput(int) always returns a pointer to a
@@ -91,6 +91,9 @@ public:
  * If you need to perform a dimensionaly reduction, you may want
  * to use the ExtractImageFilter instead of the CastImageFilter.
  *
+ * Casts between Float16 and float images convert whole scanlines at once,
+ * with the F16C instructions when they are available.
+ *
  * \ingroup IntensityImageFilters  MultiThreaded
  * \sa UnaryFunctorImageFilter
  * \sa ExtractImageFilter
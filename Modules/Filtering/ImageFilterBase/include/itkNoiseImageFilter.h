@@ -21,6 +21,7 @@
 #include "itkBoxImageFilter.h"
 #include "itkImage.h"
 #include "itkNumericTraits.h"
+#include "itkTotalProgressReporter.h"
 
 namespace itk
 {
@@ -105,6 +106,19 @@ protected:
    *     BoxImageFilter::GenerateData() */
   void
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+private:
+  /** Computes the standard deviation of the neighborhood of each pixel of a
+   * subregion of the input, for MultiThreaderBase::ProcessNeighborhoodFaces. */
+  struct StandardDeviationKernel
+  {
+    OutputImageType *       m_Output;
+    TotalProgressReporter * m_Progress;
+
+    template <typename TNeighborhoodRange>
+    void
+    operator()(const InputImageRegionType & region, TNeighborhoodRange & neighborhoodRange) const;
+  };
 };
 } // end namespace itk
 
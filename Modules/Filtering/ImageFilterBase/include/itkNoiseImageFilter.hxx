@@ -19,12 +19,9 @@
 #define itkNoiseImageFilter_hxx
 #include "itkNoiseImageFilter.h"
 
-#include "itkConstNeighborhoodIterator.h"
-#include "itkNeighborhoodInnerProduct.h"
-#include "itkImageRegionIterator.h"
-#include "itkNeighborhoodAlgorithm.h"
-#include "itkOffset.h"
-#include "itkTotalProgressReporter.h"
+#include "itkImageNeighborhoodOffsets.h"
+#include "itkImageRegionRange.h"
+#include "itkIndexRange.h"
 
 namespace itk
 {
@@ -40,63 +37,46 @@ void
 NoiseImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
 {
-  unsigned int i;
-
-  ZeroFluxNeumannBoundaryCondition<InputImageType> nbc;
-
-  ConstNeighborhoodIterator<InputImageType> bit;
-  ImageRegionIterator<OutputImageType>      it;
-
-  // Allocate output
-  typename OutputImageType::Pointer     output = this->GetOutput();
-  typename InputImageType::ConstPointer input = this->GetInput();
-
-  // Find the data-set boundary "faces"
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>::FaceListType faceList;
-  NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>                        bC;
-  faceList = bC(input, outputRegionForThread, this->GetRadius());
-
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>::FaceListType::iterator fit;
+  OutputImageType *      output = this->GetOutput();
+  const InputImageType * input = this->GetInput();
 
   TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
 
-  InputRealType value;
-  InputRealType sum;
-  InputRealType sumOfSquares;
-  InputRealType var;
-  InputRealType num;
+  // Process the non-boundary subregion without boundary extrapolation, and
+  // each of the boundary faces with a zero-flux Neumann boundary condition.
+  const auto neighborhoodOffsets = GenerateRectangularImageNeighborhoodOffsets(this->GetRadius());
+  MultiThreaderBase::ProcessNeighborhoodFaces(
+    *input, outputRegionForThread, neighborhoodOffsets, StandardDeviationKernel{ output, &progress });
+}
 
-  // Process each of the boundary faces.  These are N-d regions which border
-  // the edge of the buffer.
-  for (fit = faceList.begin(); fit != faceList.end(); ++fit)
-  {
-    bit = ConstNeighborhoodIterator<InputImageType>(this->GetRadius(), input, *fit);
-    unsigned int neighborhoodSize = bit.Size();
-    num = static_cast<InputRealType>(bit.Size());
+template <typename TInputImage, typename TOutputImage>
+template <typename TNeighborhoodRange>
+void
+NoiseImageFilter<TInputImage, TOutputImage>::StandardDeviationKernel::operator()(
+  const InputImageRegionType & region,
+  TNeighborhoodRange &         neighborhoodRange) const
+{
+  const auto num = static_cast<InputRealType>(neighborhoodRange.size());
+  auto       outputIterator = ImageRegionRange<OutputImageType>(*m_Output, region).begin();
 
-    it = ImageRegionIterator<OutputImageType>(output, *fit);
-    bit.OverrideBoundaryCondition(&nbc);
-    bit.GoToBegin();
+  for (const auto & index : ImageRegionIndexRange<InputImageDimension>(region))
+  {
+    neighborhoodRange.SetLocation(index);
 
-    while (!bit.IsAtEnd())
+    InputRealType sum = NumericTraits<InputRealType>::ZeroValue();
+    InputRealType sumOfSquares = NumericTraits<InputRealType>::ZeroValue();
+    for (const InputPixelType pixel : neighborhoodRange)
     {
-      sum = NumericTraits<InputRealType>::ZeroValue();
-      sumOfSquares = NumericTraits<InputRealType>::ZeroValue();
-      for (i = 0; i < neighborhoodSize; ++i)
-      {
-        value = static_cast<InputRealType>(bit.GetPixel(i));
-        sum += value;
-        sumOfSquares += (value * value);
-      }
-
-      // calculate the standard deviation value
-      var = (sumOfSquares - (sum * sum / num)) / (num - 1.0);
-      it.Set(static_cast<OutputPixelType>(std::sqrt(var)));
-
-      ++bit;
-      ++it;
-      progress.CompletedPixel();
+      const auto value = static_cast<InputRealType>(pixel);
+      sum += value;
+      sumOfSquares += (value * value);
     }
+
+    // calculate the standard deviation value
+    const InputRealType var = (sumOfSquares - (sum * sum / num)) / (num - 1.0);
+    *outputIterator = static_cast<OutputPixelType>(std::sqrt(var));
+    ++outputIterator;
+    m_Progress->CompletedPixel();
   }
 }
 } // end namespace itk
@@ -45,6 +45,13 @@ namespace itk
  * Filters". J Math Imaging Vis 26, 293–299 (2006).
  * https://doi.org/10.1007/s10851-006-8464-z
  *
+ * The recursion along a line cannot be vectorized, so for images of scalar
+ * pixels, whose buffers are accessed directly, neighbouring lines are
+ * filtered together: a block of lines is transposed into a buffer in which
+ * the values of all the lines at one position are contiguous, and each step
+ * of the recursion is applied to all the lines of the block at once, in a
+ * loop the compiler vectorizes. Other images are filtered line by line.
+ *
  * \ingroup ImageFilters
  * \ingroup ITKImageFilterBase
  */
@@ -140,6 +147,17 @@ protected:
   void
   FilterDataArray(RealType * outs, const RealType * data, RealType * scratch, SizeValueType ln) const;
 
+  /** Number of lines filtered together by FilterDataBlock: the values of the
+   * lines at one position fill a cache line. */
+  static constexpr unsigned int NumberOfLinesPerBlock = (64 / sizeof(RealType) > 1) ? 64 / sizeof(RealType) : 1;
+
+  /** Apply the Recursive Filter to a block of NumberOfLinesPerBlock lines, as
+   * FilterDataArray does to a single line. The value of line k at position i
+   * is at index i * NumberOfLinesPerBlock + k of the arrays, which hold
+   * ln * NumberOfLinesPerBlock values. */
+  void
+  FilterDataBlock(RealType * outs, const RealType * data, RealType * scratch, SizeValueType ln) const;
+
 protected:
   /** Causal coefficients that multiply the input data. */
   ScalarRealType m_N0;
@@ -252,6 +270,21 @@ protected:
   }
 
 private:
+  /** Tells whether the lines of the region can be filtered by blocks, read
+   * and written through raw pointers to the pixels of the image buffers. */
+  using FiltersLinesByBlocksType = std::integral_constant<bool,
+                                                          std::is_arithmetic<RealType>::value &&
+                                                            MultiThreaderBase::HasPixelScanlines<TInputImage>() &&
+                                                            MultiThreaderBase::HasPixelScanlines<TOutputImage>()>;
+
+  /** Filters the lines of the region, either by blocks of neighbouring lines
+   * (std::true_type), or one at a time through line iterators
+   * (std::false_type). */
+  void
+  ThreadedFilterLines(const OutputImageRegionType & outputRegionForThread, std::true_type);
+  void
+  ThreadedFilterLines(const OutputImageRegionType & outputRegionForThread, std::false_type);
+
   /** Direction in which the filter is to be applied
    * this should be in the range [0,ImageDimension-1]. */
   unsigned int m_Direction{ 0 };
@@ -21,6 +21,7 @@
 #include "itkRecursiveSeparableImageFilter.h"
 #include "itkObjectFactory.h"
 #include "itkImageLinearIteratorWithIndex.h"
+#include "itkIndexRange.h"
 #include <memory> // For unique_ptr
 
 namespace itk
@@ -166,6 +167,98 @@ RecursiveSeparableImageFilter<TInputImage, TOutputImage>::FilterDataArray(RealTy
   }
 }
 
+/**
+ * Apply Recursive Filter to a block of lines
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+RecursiveSeparableImageFilter<TInputImage, TOutputImage>::FilterDataBlock(RealType * const       outs,
+                                                                          const RealType * const data,
+                                                                          RealType * const       scratch,
+                                                                          const SizeValueType    ln) const
+{
+  // Every step of the recursion of FilterDataArray is applied to all the
+  // lines of the block, whose values at one position are contiguous.
+  constexpr unsigned int K = NumberOfLinesPerBlock;
+
+  RealType * const scratch1 = outs;
+  RealType * const scratch2 = scratch;
+
+  /**
+   * Causal direction pass
+   */
+  for (unsigned int k = 0; k < K; ++k)
+  {
+    const RealType * const x = data + k;
+    RealType * const       y = scratch1 + k;
+
+    // this value is assumed to exist from the border to infinity.
+    const RealType outV1 = x[0];
+
+    MathEMAMAMAM(y[0], outV1, m_N0, outV1, m_N1, outV1, m_N2, outV1, m_N3);
+    MathEMAMAMAM(y[K], x[K], m_N0, outV1, m_N1, outV1, m_N2, outV1, m_N3);
+    MathEMAMAMAM(y[2 * K], x[2 * K], m_N0, x[K], m_N1, outV1, m_N2, outV1, m_N3);
+    MathEMAMAMAM(y[3 * K], x[3 * K], m_N0, x[2 * K], m_N1, x[K], m_N2, outV1, m_N3);
+
+    MathSMAMAMAM(y[0], outV1, m_BN1, outV1, m_BN2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(y[K], y[0], m_D1, outV1, m_BN2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(y[2 * K], y[K], m_D1, y[0], m_D2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(y[3 * K], y[2 * K], m_D1, y[K], m_D2, y[0], m_D3, outV1, m_BN4);
+  }
+
+  for (SizeValueType i = 4; i < ln; ++i)
+  {
+    const RealType * const x = data + (i - 4) * K;
+    RealType * const       y = scratch1 + (i - 4) * K;
+    for (unsigned int k = 0; k < K; ++k)
+    {
+      MathEMAMAMAM(y[k + 4 * K], x[k + 4 * K], m_N0, x[k + 3 * K], m_N1, x[k + 2 * K], m_N2, x[k + K], m_N3);
+      MathSMAMAMAM(y[k + 4 * K], y[k + 3 * K], m_D1, y[k + 2 * K], m_D2, y[k + K], m_D3, y[k], m_D4);
+    }
+  }
+
+  /**
+   * AntiCausal direction pass
+   */
+  for (unsigned int k = 0; k < K; ++k)
+  {
+    const RealType * const x = data + (ln - 1) * K + k;
+    RealType * const       y = scratch2 + (ln - 1) * K + k;
+
+    // this value is assumed to exist from the border to infinity.
+    const RealType outV2 = x[0];
+
+    MathEMAMAMAM(y[0], outV2, m_M1, outV2, m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM(*(y - K), x[0], m_M1, outV2, m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM(*(y - 2 * K), *(x - K), m_M1, x[0], m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM(*(y - 3 * K), *(x - 2 * K), m_M1, *(x - K), m_M2, x[0], m_M3, outV2, m_M4);
+
+    MathSMAMAMAM(y[0], outV2, m_BM1, outV2, m_BM2, outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM(*(y - K), y[0], m_D1, outV2, m_BM2, outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM(*(y - 2 * K), *(y - K), m_D1, y[0], m_D2, outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM(*(y - 3 * K), *(y - 2 * K), m_D1, *(y - K), m_D2, y[0], m_D3, outV2, m_BM4);
+  }
+
+  for (SizeValueType i = ln - 4; i > 0; --i)
+  {
+    const RealType * const x = data + i * K;
+    RealType * const       y = scratch2 + (i - 1) * K;
+    for (unsigned int k = 0; k < K; ++k)
+    {
+      MathEMAMAMAM(y[k], x[k], m_M1, x[k + K], m_M2, x[k + 2 * K], m_M3, x[k + 3 * K], m_M4);
+      MathSMAMAMAM(y[k], y[k + K], m_D1, y[k + 2 * K], m_D2, y[k + 3 * K], m_D3, y[k + 4 * K], m_D4);
+    }
+  }
+
+  /**
+   * Roll the antiCausal part into the output
+   */
+  for (SizeValueType i = 0; i < ln * K; ++i)
+  {
+    outs[i] += scratch2[i];
+  }
+}
+
 //
 // we need all of the image in just the "Direction" we are separated into
 //
@@ -261,6 +354,78 @@ template <typename TInputImage, typename TOutputImage>
 void
 RecursiveSeparableImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
+{
+  this->ThreadedFilterLines(outputRegionForThread, FiltersLinesByBlocksType());
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+RecursiveSeparableImageFilter<TInputImage, TOutputImage>::ThreadedFilterLines(
+  const OutputImageRegionType & outputRegionForThread,
+  std::true_type)
+{
+  using OutputPixelType = typename TOutputImage::PixelType;
+  constexpr unsigned int K = NumberOfLinesPerBlock;
+
+  const TInputImage * inputImage = this->GetInputImage();
+  TOutputImage *      outputImage = this->GetOutput();
+
+  const SizeValueType   ln = outputRegionForThread.GetSize(this->m_Direction);
+  const OffsetValueType inputStride = inputImage->GetOffsetTable()[this->m_Direction];
+  const OffsetValueType outputStride = outputImage->GetOffsetTable()[this->m_Direction];
+
+  // The first pixel of every line. Consecutive lines are neighbours along the
+  // fastest varying of the other dimensions, so that, when filtering along
+  // any direction but the first, the values of a block at one position are
+  // read from and written to contiguous pixels.
+  OutputImageRegionType lineStarts = outputRegionForThread;
+  lineStarts.SetSize(this->m_Direction, 1);
+
+  // Value-initialized, so that the unused lines of the last block hold
+  // finite values.
+  const std::unique_ptr<RealType[]> inps(new RealType[ln * K]());
+  const std::unique_ptr<RealType[]> outs(new RealType[ln * K]());
+  const std::unique_ptr<RealType[]> scratch(new RealType[ln * K]());
+
+  const typename TInputImage::PixelType * inputLines[K];
+  OutputPixelType *                       outputLines[K];
+  unsigned int                            numberOfLines = 0;
+
+  const ImageRegionIndexRange<TOutputImage::ImageDimension> lineStartRange(lineStarts);
+  for (auto it = lineStartRange.cbegin(); it != lineStartRange.cend();)
+  {
+    numberOfLines = 0;
+    for (; numberOfLines < K && it != lineStartRange.cend(); ++numberOfLines, ++it)
+    {
+      inputLines[numberOfLines] = inputImage->GetBufferPointer() + inputImage->ComputeOffset(*it);
+      outputLines[numberOfLines] = outputImage->GetBufferPointer() + outputImage->ComputeOffset(*it);
+    }
+
+    for (SizeValueType i = 0; i < ln; ++i)
+    {
+      for (unsigned int k = 0; k < numberOfLines; ++k)
+      {
+        inps[i * K + k] = static_cast<RealType>(inputLines[k][i * inputStride]);
+      }
+    }
+
+    this->FilterDataBlock(outs.get(), inps.get(), scratch.get(), ln);
+
+    for (SizeValueType i = 0; i < ln; ++i)
+    {
+      for (unsigned int k = 0; k < numberOfLines; ++k)
+      {
+        outputLines[k][i * outputStride] = static_cast<OutputPixelType>(outs[i * K + k]);
+      }
+    }
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+RecursiveSeparableImageFilter<TInputImage, TOutputImage>::ThreadedFilterLines(
+  const OutputImageRegionType & outputRegionForThread,
+  std::false_type)
 {
   using OutputPixelType = typename TOutputImage::PixelType;
 
@@ -321,6 +486,10 @@ RecursiveSeparableImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream
   os << indent << "Direction: " << m_Direction << std::endl;
 }
 
+// static constexpr definitions explicitly needed in C++11
+template <typename TInputImage, typename TOutputImage>
+constexpr unsigned int RecursiveSeparableImageFilter<TInputImage, TOutputImage>::NumberOfLinesPerBlock;
+
 } // end namespace itk
 
 #endif
@@ -121,6 +121,59 @@ template <typename TInputImage1,
 void
 TernaryFunctorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage, TFunction>::
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+{
+  this->ThreadedApplyFunctor(outputRegionForThread, HasPixelScanlinesType());
+}
+
+
+template <typename TInputImage1,
+          typename TInputImage2,
+          typename TInputImage3,
+          typename TOutputImage,
+          typename TFunction>
+void
+TernaryFunctorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage, TFunction>::
+  ThreadedApplyFunctor(const OutputImageRegionType & outputRegionForThread, std::true_type)
+{
+  // We use dynamic_cast since inputs are stored as DataObjects.  The
+  // ImageToImageFilter::GetInput(int) always returns a pointer to a
+  // TInputImage1 so it cannot be used for the second or third input.
+  const auto *   inputPtr1 = dynamic_cast<const TInputImage1 *>(ProcessObject::GetInput(0));
+  const auto *   inputPtr2 = dynamic_cast<const TInputImage2 *>(ProcessObject::GetInput(1));
+  const auto *   inputPtr3 = dynamic_cast<const TInputImage3 *>(ProcessObject::GetInput(2));
+  TOutputImage * outputPtr = this->GetOutput(0);
+
+  TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
+
+  const FunctorType & functor = m_Functor;
+  MultiThreaderBase::ProcessImageScanlines(
+    outputRegionForThread,
+    [&functor, &progress](SizeValueType                numberOfPixels,
+                          OutputImagePixelType *       output,
+                          const Input1ImagePixelType * input1,
+                          const Input2ImagePixelType * input2,
+                          const Input3ImagePixelType * input3) {
+      for (SizeValueType i = 0; i < numberOfPixels; ++i)
+      {
+        output[i] = functor(input1[i], input2[i], input3[i]);
+      }
+      progress.Completed(numberOfPixels);
+    },
+    *outputPtr,
+    *inputPtr1,
+    *inputPtr2,
+    *inputPtr3);
+}
+
+
+template <typename TInputImage1,
+          typename TInputImage2,
+          typename TInputImage3,
+          typename TOutputImage,
+          typename TFunction>
+void
+TernaryFunctorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage, TFunction>::
+  ThreadedApplyFunctor(const OutputImageRegionType & outputRegionForThread, std::false_type)
 {
   // We use dynamic_cast since inputs are stored as DataObjects.  The
   // ImageToImageFilter::GetInput(int) always returns a pointer to a
@@ -89,6 +89,55 @@ void
 UnaryGeneratorImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateDataWithFunctor(
   const TFunctor &              functor,
   const OutputImageRegionType & outputRegionForThread)
+{
+  this->ThreadedApplyFunctor(functor, outputRegionForThread, HasPixelScanlinesType());
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+template <typename TFunctor>
+void
+UnaryGeneratorImageFilter<TInputImage, TOutputImage>::ThreadedApplyFunctor(
+  const TFunctor &              functor,
+  const OutputImageRegionType & outputRegionForThread,
+  std::true_type)
+{
+  const TInputImage * inputPtr = this->GetInput();
+  TOutputImage *      outputPtr = this->GetOutput(0);
+
+  InputImageRegionType inputRegionForThread;
+  this->CallCopyOutputRegionToInputRegion(inputRegionForThread, outputRegionForThread);
+  if (inputRegionForThread != outputRegionForThread)
+  {
+    // The scanlines of the input and output regions do not match.
+    this->ThreadedApplyFunctor(functor, outputRegionForThread, std::false_type());
+    return;
+  }
+
+  TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
+
+  MultiThreaderBase::ProcessImageScanlines(
+    outputRegionForThread,
+    [&functor, &progress](
+      SizeValueType numberOfPixels, OutputImagePixelType * output, const InputImagePixelType * input) {
+      for (SizeValueType i = 0; i < numberOfPixels; ++i)
+      {
+        output[i] = functor(input[i]);
+      }
+      progress.Completed(numberOfPixels);
+    },
+    *outputPtr,
+    *inputPtr);
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+template <typename TFunctor>
+void
+UnaryGeneratorImageFilter<TInputImage, TOutputImage>::ThreadedApplyFunctor(
+  const TFunctor &              functor,
+  const OutputImageRegionType & outputRegionForThread,
+  std::false_type)
 {
   const typename OutputImageRegionType::SizeType & regionSize = outputRegionForThread.GetSize();
 
@@ -20,6 +20,7 @@
 #include "itkBinaryGeneratorImageFilter.h"
 #include "itkImage.h"
 #include "itkImageRegionIterator.h"
+#include "itkIndexRange.h"
 
 #include "itkGTest.h"
 
@@ -263,3 +264,55 @@ TEST(BinaryGeneratorImageFilter, SetFunctor)
 
   EXPECT_NEAR(2.0, outputImage->GetPixel(idx), 1e-8);
 }
+
+
+TEST(BinaryGeneratorImageFilter, SupportsConstantsAndRequestedRegions)
+{
+
+  using Utils = Utilities<3, float>;
+
+  auto image1 = Utils::CreateImage();
+  auto image2 = Utils::CreateImage();
+  for (const auto & index : itk::ImageRegionIndexRange<3>(image1->GetBufferedRegion()))
+  {
+    image1->SetPixel(index, static_cast<float>(index[0] + 5 * index[1] + 25 * index[2]));
+    image2->SetPixel(index, static_cast<float>(index[0] - index[2]));
+  }
+
+  using FilterType = itk::BinaryGeneratorImageFilter<Utils::ImageType, Utils::ImageType, Utils::ImageType>;
+
+  auto filter = FilterType::New();
+  filter->SetFunctor(Utils::MyBinaryFunction1);
+
+  const Utils::ImageType::RegionType requestedRegion({ { 1, 0, 2 } }, { { 3, 4, 2 } });
+
+  filter->SetInput1(image1);
+  filter->SetInput2(image2);
+  filter->GetOutput()->SetRequestedRegion(requestedRegion);
+  EXPECT_NO_THROW(filter->Update());
+  EXPECT_EQ(filter->GetOutput()->GetBufferedRegion(), requestedRegion);
+  for (const auto & index : itk::ImageRegionIndexRange<3>(requestedRegion))
+  {
+    EXPECT_EQ(filter->GetOutput()->GetPixel(index), image1->GetPixel(index) + 3 * image2->GetPixel(index));
+  }
+
+  filter = FilterType::New();
+  filter->SetFunctor(Utils::MyBinaryFunction1);
+  filter->SetInput1(image1);
+  filter->SetConstant2(2.0);
+  EXPECT_NO_THROW(filter->Update());
+  for (const auto & index : itk::ImageRegionIndexRange<3>(image1->GetBufferedRegion()))
+  {
+    EXPECT_EQ(filter->GetOutput()->GetPixel(index), image1->GetPixel(index) + 6);
+  }
+
+  filter = FilterType::New();
+  filter->SetFunctor(Utils::MyBinaryFunction1);
+  filter->SetConstant1(2.0);
+  filter->SetInput2(image2);
+  EXPECT_NO_THROW(filter->Update());
+  for (const auto & index : itk::ImageRegionIndexRange<3>(image2->GetBufferedRegion()))
+  {
+    EXPECT_EQ(filter->GetOutput()->GetPixel(index), 2 + 3 * image2->GetPixel(index));
+  }
+}
@@ -22,6 +22,8 @@
 #include "itkCovariantVector.h"
 #include "itkImageRegionIterator.h"
 
+#include <array>
+
 namespace itk
 {
 
@@ -211,6 +213,19 @@ private:
   }
 
 
+  // The three coefficients of the first order derivative operator.
+  using DerivativeCoefficientsType = std::array<OperatorValueType, 3>;
+
+  // Computes the derivative at the center of the neighborhood, as the inner
+  // product of the coefficients with the three pixels along the line of the
+  // specified neighbor stride.
+  template <typename TNeighborhood>
+  static OutputValueType
+  ComputeDerivative(const TNeighborhood &              neighborhood,
+                    const unsigned int                 center,
+                    const unsigned int                 stride,
+                    const DerivativeCoefficientsType & coefficients);
+
   bool m_UseImageSpacing;
 
   // flag to take or not the image direction into account
@@ -20,7 +20,8 @@
 #include "itkGradientImageFilter.h"
 
 #include "itkConstNeighborhoodIterator.h"
-#include "itkNeighborhoodInnerProduct.h"
+#include "itkFixedNeighborhoodAllocator.h"
+#include "itkFixedRadiusConstNeighborhoodIterator.h"
 #include "itkImageRegionIterator.h"
 #include "itkDerivativeOperator.h"
 #include "itkNeighborhoodAlgorithm.h"
@@ -114,22 +115,25 @@ GradientImageFilter<TInputImage, TOperatorValueType, TOutputValueType, TOutputIm
   const OutputImageRegionType & outputRegionForThread)
 {
 
-  NeighborhoodInnerProduct<InputImageType, OperatorValueType, OutputValueType> SIP;
-
   OutputImageType *      outputImage = this->GetOutput();
   const InputImageType * inputImage = this->GetInput();
 
-  // Set up operators
-  DerivativeOperator<OperatorValueType, InputImageDimension> op[InputImageDimension];
+  // Set up the coefficients of the operators. A first order derivative
+  // operator has three coefficients, which are kept on the stack.
+  using OperatorType =
+    DerivativeOperator<OperatorValueType, InputImageDimension, FixedNeighborhoodAllocator<OperatorValueType, 3>>;
+  DerivativeCoefficientsType coefficients[InputImageDimension];
 
   for (unsigned int i = 0; i < InputImageDimension; i++)
   {
+    OperatorType op;
+
     // The operator has default values for its direction (0) and its order (1).
-    op[i].CreateDirectional();
+    op.CreateDirectional();
 
     // Reverse order of coefficients for the convolution with the image to
     // follow.
-    op[i].FlipAxes();
+    op.FlipAxes();
 
     // Take into account the pixel spacing if necessary
     if (m_UseImageSpacing == true)
@@ -140,9 +144,10 @@ GradientImageFilter<TInputImage, TOperatorValueType, TOutputValueType, TOutputIm
       }
       else
       {
-        op[i].ScaleCoefficients(1.0 / this->GetInput()->GetSpacing()[i]);
+        op.ScaleCoefficients(1.0 / this->GetInput()->GetSpacing()[i]);
       }
     }
+    std::copy(op.Begin(), op.End(), coefficients[i].begin());
   }
 
   // Set the iterator radius to one, which is the value of the first
@@ -150,54 +155,84 @@ GradientImageFilter<TInputImage, TOperatorValueType, TOutputValueType, TOutputIm
   const auto radius = Size<InputImageDimension>::Filled(1);
 
   // Find the data-set boundary "faces"
-  NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>                        bC;
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>::FaceListType faceList =
-    bC(inputImage, outputRegionForThread, radius);
-
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>::FaceListType::iterator fit;
-  fit = faceList.begin();
+  using FaceCalculatorType = NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>;
+  const auto faces = FaceCalculatorType::Compute(*inputImage, outputRegionForThread, radius);
 
   TotalProgressReporter progress(this, this->GetOutput()->GetRequestedRegion().GetNumberOfPixels());
 
-  // Initialize the x_slice array
-  ConstNeighborhoodIterator<InputImageType> nit = ConstNeighborhoodIterator<InputImageType>(radius, inputImage, *fit);
+  CovariantVectorType gradient;
 
-  std::slice          x_slice[InputImageDimension];
-  const SizeValueType center = nit.Size() / 2;
-  for (unsigned int i = 0; i < InputImageDimension; ++i)
+  // Process the non-boundary region, where the neighborhoods need no
+  // boundary condition, with the iterator of fixed radius.
+  using FixedRadiusIteratorType = FixedRadiusConstNeighborhoodIterator<InputImageType, 1>;
+  const OutputImageRegionType          nonBoundaryRegion = faces.GetNonBoundaryRegion();
+  FixedRadiusIteratorType              fixedIt(inputImage, nonBoundaryRegion);
+  ImageRegionIterator<OutputImageType> it(outputImage, nonBoundaryRegion);
+  for (; !fixedIt.IsAtEnd(); ++fixedIt, ++it)
   {
-    x_slice[i] = std::slice(center - nit.GetStride(i), op[i].GetSize()[0], nit.GetStride(i));
+    for (unsigned int i = 0; i < InputImageDimension; ++i)
+    {
+      gradient[i] = ComputeDerivative(fixedIt,
+                                      FixedRadiusIteratorType::CenterNeighborIndex,
+                                      FixedRadiusIteratorType::GetNeighborStride(i),
+                                      coefficients[i]);
+    }
+
+    // This method optionally performs a tansform for Physical
+    // coordinates and potential conversion to a different output
+    // pixel type.
+    this->SetOutputPixel(it, gradient);
+    progress.CompletedPixel();
   }
 
-  CovariantVectorType gradient;
-  // Process non-boundary face and then each of the boundary faces.
-  // These are N-d regions which border the edge of the buffer.
-  for (fit = faceList.begin(); fit != faceList.end(); ++fit)
+  // Process each of the boundary faces. These are N-d regions which border
+  // the edge of the buffer.
+  for (const auto & face : faces.GetBoundaryFaces())
   {
-    nit = ConstNeighborhoodIterator<InputImageType>(radius, inputImage, *fit);
-    ImageRegionIterator<OutputImageType> it = ImageRegionIterator<OutputImageType>(outputImage, *fit);
+    ConstNeighborhoodIterator<InputImageType> nit(radius, inputImage, face);
+    ImageRegionIterator<OutputImageType>      faceIt(outputImage, face);
     nit.OverrideBoundaryCondition(m_BoundaryCondition);
     nit.GoToBegin();
 
+    const auto center = static_cast<unsigned int>(nit.Size() / 2);
     while (!nit.IsAtEnd())
     {
       for (unsigned int i = 0; i < InputImageDimension; ++i)
       {
-        gradient[i] = SIP(x_slice[i], nit, op[i]);
+        gradient[i] = ComputeDerivative(nit, center, static_cast<unsigned int>(nit.GetStride(i)), coefficients[i]);
       }
-
-      // This method optionally performs a tansform for Physical
-      // coordinates and potential conversion to a different output
-      // pixel type.
-      this->SetOutputPixel(it, gradient);
+      this->SetOutputPixel(faceIt, gradient);
 
       ++nit;
-      ++it;
+      ++faceIt;
       progress.CompletedPixel();
     }
   }
 }
 
+template <typename TInputImage, typename TOperatorValueType, typename TOutputValueType, typename TOutputImageType>
+template <typename TNeighborhood>
+TOutputValueType
+GradientImageFilter<TInputImage, TOperatorValueType, TOutputValueType, TOutputImageType>::ComputeDerivative(
+  const TNeighborhood &              neighborhood,
+  const unsigned int                 center,
+  const unsigned int                 stride,
+  const DerivativeCoefficientsType & coefficients)
+{
+  // Same arithmetic as NeighborhoodInnerProduct.
+  using InputPixelRealType = typename NumericTraits<InputPixelType>::RealType;
+  using AccumulateRealType = typename NumericTraits<InputPixelRealType>::AccumulateType;
+  using OutputPixelValueType = typename NumericTraits<OutputValueType>::ValueType;
+
+  AccumulateRealType sum = NumericTraits<AccumulateRealType>::ZeroValue();
+  for (unsigned int k = 0; k < 3; ++k)
+  {
+    const auto pixel = static_cast<InputPixelRealType>(neighborhood.GetPixel(center + k * stride - stride));
+    sum += static_cast<AccumulateRealType>(static_cast<OutputPixelValueType>(coefficients[k]) * pixel);
+  }
+  return static_cast<OutputValueType>(sum);
+}
+
 template <typename TInputImage, typename TOperatorValueType, typename TOutputValueType, typename TOutputImageType>
 void
 GradientImageFilter<TInputImage, TOperatorValueType, TOutputValueType, TOutputImageType>::GenerateOutputInformation()
@@ -19,7 +19,11 @@
 // The header file to be tested:
 #include "itkResampleImageFilter.h"
 
+#include "itkAffineTransform.h"
+#include "itkBrickedImage.h"
 #include "itkImage.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkLinearInterpolateImageFunction.h"
 
 // Google Test header file:
 #include <gtest/gtest.h>
@@ -172,3 +176,99 @@ TEST(ResampleImageFilter, Expect_ResampleImageFilter_thows_on_incomplete_configu
 {
   Expect_ResampleImageFilter_thows_on_incomplete_configuration(128.0);
 }
+
+
+// A BrickedImage is resampled like an Image holding the same pixels.
+TEST(ResampleImageFilter, ResamplesABrickedImageLikeAnImage)
+{
+  constexpr unsigned int Dimension = 3;
+  using ImageType = itk::Image<float, Dimension>;
+  using BrickedImageType = itk::BrickedImage<float, Dimension>;
+
+  const ImageType::RegionType region({ { 2, -3, 1 } }, { { 37, 41, 23 } });
+  ImageType::SpacingType      spacing;
+  spacing[0] = 0.8;
+  spacing[1] = 1.1;
+  spacing[2] = 2.0;
+  ImageType::PointType origin;
+  origin[0] = 4.0;
+  origin[1] = -2.5;
+  origin[2] = 1.0;
+
+  const auto image = ImageType::New();
+  image->SetRegions(region);
+  image->SetSpacing(spacing);
+  image->SetOrigin(origin);
+  image->Allocate(true);
+  const auto brickedImage = BrickedImageType::New();
+  brickedImage->SetRegions(region);
+  brickedImage->SetSpacing(spacing);
+  brickedImage->SetOrigin(origin);
+  brickedImage->Allocate(true);
+
+  // A ball of varying values, spanning several bricks, and background
+  // elsewhere.
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    const double               x = index[0] - 20.0;
+    const double               y = index[1] - 15.0;
+    const double               z = index[2] - 11.0;
+    if (x * x + y * y + 4.0 * z * z < 14.0 * 14.0)
+    {
+      const auto value = static_cast<float>(100.0 + 3.0 * x - 2.0 * y + z);
+      image->SetPixel(index, value);
+      brickedImage->SetPixel(index, value);
+    }
+  }
+  EXPECT_LT(brickedImage->GetNumberOfAllocatedBricks(), brickedImage->GetNumberOfBricks());
+
+  using TransformType = itk::AffineTransform<double, Dimension>;
+  const auto                      transform = TransformType::New();
+  TransformType::OutputVectorType axis;
+  axis[0] = 0.2;
+  axis[1] = 0.3;
+  axis[2] = 1.0;
+  transform->Rotate3D(axis, 0.3);
+  TransformType::OutputVectorType translation;
+  translation[0] = 1.5;
+  translation[1] = -0.7;
+  translation[2] = 2.2;
+  transform->Translate(translation);
+
+  const ImageType::SizeType outputSize = { { 30, 35, 25 } };
+  ImageType::SpacingType    outputSpacing;
+  outputSpacing.Fill(1.3);
+
+  const auto resampleImage = itk::ResampleImageFilter<ImageType, ImageType>::New();
+  resampleImage->SetInput(image);
+  resampleImage->SetTransform(transform);
+  resampleImage->SetInterpolator(itk::LinearInterpolateImageFunction<ImageType>::New());
+  resampleImage->SetSize(outputSize);
+  resampleImage->SetOutputSpacing(outputSpacing);
+  resampleImage->SetOutputOrigin(origin);
+  resampleImage->SetDefaultPixelValue(-1.0f);
+  resampleImage->Update();
+
+  const auto resampleBrickedImage = itk::ResampleImageFilter<BrickedImageType, ImageType>::New();
+  resampleBrickedImage->SetInput(brickedImage);
+  resampleBrickedImage->SetTransform(transform);
+  resampleBrickedImage->SetInterpolator(itk::LinearInterpolateImageFunction<BrickedImageType>::New());
+  resampleBrickedImage->SetSize(outputSize);
+  resampleBrickedImage->SetOutputSpacing(outputSpacing);
+  resampleBrickedImage->SetOutputOrigin(origin);
+  resampleBrickedImage->SetDefaultPixelValue(-1.0f);
+  resampleBrickedImage->Update();
+
+  const ImageType * const expected = resampleImage->GetOutput();
+  const ImageType * const output = resampleBrickedImage->GetOutput();
+  ASSERT_EQ(output->GetBufferedRegion(), expected->GetBufferedRegion());
+  itk::SizeValueType numberOfPixelsInBall = 0;
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(expected, expected->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    ASSERT_EQ(output->GetPixel(it.GetIndex()), it.Get()) << "at " << it.GetIndex();
+    numberOfPixelsInBall += (it.Get() > 50.0f);
+  }
+  EXPECT_GT(numberOfPixelsInBall, 1000u);
+}
@@ -21,7 +21,6 @@
 #include "itkAdditiveGaussianNoiseImageFilter.h"
 #include "itkImageScanlineIterator.h"
 #include "itkTotalProgressReporter.h"
-#include "itkNormalVariateGenerator.h"
 
 namespace itk
 {
@@ -30,32 +29,19 @@ template <class TInputImage, class TOutputImage>
 AdditiveGaussianNoiseImageFilter<TInputImage, TOutputImage>::AdditiveGaussianNoiseImageFilter()
 
 {
-  this->DynamicMultiThreadingOff();
   this->ThreaderUpdateProgressOff();
 }
 
 template <class TInputImage, class TOutputImage>
 void
-AdditiveGaussianNoiseImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
-  const OutputImageRegionType & outputRegionForThread,
-  ThreadIdType)
+AdditiveGaussianNoiseImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread)
 {
   const InputImageType * inputPtr = this->GetInput();
   OutputImageType *      outputPtr = this->GetOutput(0);
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
-  // Create a random generator per thread
-  IndexValueType indSeed = 0;
-  for (unsigned d = 0; d < TOutputImage::ImageDimension; d++)
-  {
-    indSeed += outputRegionForThread.GetIndex(d);
-  }
-  typename Statistics::NormalVariateGenerator::Pointer randn = Statistics::NormalVariateGenerator::New();
-  const uint32_t                                       seed = Self::Hash(this->GetSeed(), uint32_t(indSeed));
-  // Convert the seed bit for bit to int32
-  randn->Initialize(*reinterpret_cast<const int32_t *>(&seed));
-
   // Define the portion of the input to walk for this thread, using
   // the CallCopyOutputRegionToInputRegion method allows for the input
   // and output images to be different dimensions
@@ -69,11 +55,15 @@ AdditiveGaussianNoiseImageFilter<TInputImage, TOutputImage>::ThreadedGenerateDat
   inputIt.GoToBegin();
   outputIt.GoToBegin();
 
+  const uint32_t seed = this->GetSeed();
+
   while (!inputIt.IsAtEnd())
   {
+    uint64_t pixelNumber = this->ComputePixelNumber(outputIt.GetIndex());
     while (!inputIt.IsAtEndOfLine())
     {
-      const double out = inputIt.Get() + m_Mean + m_StandardDeviation * randn->GetVariate();
+      Statistics::PhiloxRandomVariateGenerator rand(seed, pixelNumber++);
+      const double out = inputIt.Get() + m_Mean + m_StandardDeviation * rand.GetNormalVariate();
       outputIt.Set(Self::ClampCast(out));
       ++inputIt;
       ++outputIt;
@@ -19,6 +19,7 @@
 #define itkNoiseBaseImageFilter_h
 
 #include "itkInPlaceImageFilter.h"
+#include "itkPhiloxRandomVariateGenerator.h"
 #include <ctime>
 
 namespace itk
@@ -32,6 +33,11 @@ namespace itk
  * This class add common methods for setting a seed for the random
  * generators used to generate the noise.
  *
+ * The noise of a pixel is drawn from a counter-based generator, whose stream
+ * is the position of the pixel in the largest possible region of the output.
+ * For a given seed, the output is therefore the same whatever the number of
+ * threads, and whether or not the output is streamed.
+ *
  * \sa InPlaceImageFilter
  * \ingroup ITKImageNoise
  */
@@ -48,6 +54,7 @@ public:
   using ConstPointer = SmartPointer<const Self>;
 
   using OutputImagePixelType = typename Superclass::OutputImagePixelType;
+  using OutputImageIndexType = typename TOutputImage::IndexType;
 
   /** Run-time type information (and related methods). */
   itkTypeMacro(NoiseBaseImageFilter, InPlaceImageFilter);
@@ -76,6 +83,12 @@ protected:
     return (a + b) * 2654435761u;
   }
 
+  /** Returns the position of the pixel in the largest possible region of the
+   * output, in the order of the pixels in memory. It is used as the stream of
+   * the random variates of the pixel. */
+  uint64_t
+  ComputePixelNumber(const OutputImageIndexType & index) const;
+
   // Clamp and round the input value to the output
   static OutputImagePixelType
   ClampCast(const double & value);
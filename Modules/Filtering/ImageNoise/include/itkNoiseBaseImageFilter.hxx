@@ -43,6 +43,21 @@ NoiseBaseImageFilter<TInputImage, TOutputImage>::SetSeed()
   this->SetSeed(Hash(t, clock()));
 }
 
+template <class TInputImage, class TOutputImage>
+uint64_t
+NoiseBaseImageFilter<TInputImage, TOutputImage>::ComputePixelNumber(const OutputImageIndexType & index) const
+{
+  const auto & largestRegion = this->GetOutput()->GetLargestPossibleRegion();
+
+  uint64_t pixelNumber = 0;
+  for (unsigned int d = TOutputImage::ImageDimension; d > 0; --d)
+  {
+    pixelNumber = pixelNumber * largestRegion.GetSize(d - 1) +
+                  static_cast<uint64_t>(index[d - 1] - largestRegion.GetIndex(d - 1));
+  }
+  return pixelNumber;
+}
+
 template <class TInputImage, class TOutputImage>
 typename NoiseBaseImageFilter<TInputImage, TOutputImage>::OutputImagePixelType
 NoiseBaseImageFilter<TInputImage, TOutputImage>::ClampCast(const double & value)
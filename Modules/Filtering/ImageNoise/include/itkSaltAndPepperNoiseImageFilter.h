@@ -126,7 +126,7 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
   void
-  ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread, ThreadIdType threadId) override;
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
 private:
   double               m_Probability{ 0.01 };
@@ -19,7 +19,6 @@
 #define itkSaltAndPepperNoiseImageFilter_hxx
 
 #include "itkSaltAndPepperNoiseImageFilter.h"
-#include "itkMersenneTwisterRandomVariateGenerator.h"
 #include "itkImageScanlineIterator.h"
 #include "itkTotalProgressReporter.h"
 
@@ -31,30 +30,17 @@ SaltAndPepperNoiseImageFilter<TInputImage, TOutputImage>::SaltAndPepperNoiseImag
   : m_SaltValue(NumericTraits<OutputImagePixelType>::max())
   , m_PepperValue(NumericTraits<OutputImagePixelType>::NonpositiveMin())
 {
-  this->DynamicMultiThreadingOff();
   this->ThreaderUpdateProgressOff();
 }
 
 template <class TInputImage, class TOutputImage>
 void
-SaltAndPepperNoiseImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
-  const OutputImageRegionType & outputRegionForThread,
-  ThreadIdType)
+SaltAndPepperNoiseImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread)
 {
   const InputImageType * inputPtr = this->GetInput();
   OutputImageType *      outputPtr = this->GetOutput(0);
 
-  // Create a random generator per thread
-  IndexValueType indSeed = 0;
-  for (unsigned d = 0; d < TOutputImage::ImageDimension; d++)
-  {
-    indSeed += outputRegionForThread.GetIndex(d);
-  }
-  typename Statistics::MersenneTwisterRandomVariateGenerator::Pointer rand =
-    Statistics::MersenneTwisterRandomVariateGenerator::New();
-  const uint32_t seed = Self::Hash(this->GetSeed(), uint32_t(indSeed));
-  rand->Initialize(seed);
-
   // Define the portion of the input to walk for this thread, using
   // the CallCopyOutputRegionToInputRegion method allows for the input
   // and output images to be different dimensions
@@ -70,13 +56,17 @@ SaltAndPepperNoiseImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
+  const uint32_t seed = this->GetSeed();
+
   while (!inputIt.IsAtEnd())
   {
+    uint64_t pixelNumber = this->ComputePixelNumber(outputIt.GetIndex());
     while (!inputIt.IsAtEndOfLine())
     {
-      if (rand->GetVariate() < m_Probability)
+      Statistics::PhiloxRandomVariateGenerator rand(seed, pixelNumber++);
+      if (rand.GetVariate() < m_Probability)
       {
-        if (rand->GetVariate() < 0.5)
+        if (rand.GetVariate() < 0.5)
         {
           // Salt
           outputIt.Set(m_SaltValue);
@@ -19,10 +19,8 @@
 #define itkShotNoiseImageFilter_hxx
 
 #include "itkShotNoiseImageFilter.h"
-#include "itkMersenneTwisterRandomVariateGenerator.h"
 #include "itkImageScanlineIterator.h"
 #include "itkTotalProgressReporter.h"
-#include "itkNormalVariateGenerator.h"
 
 namespace itk
 {
@@ -31,32 +29,17 @@ template <class TInputImage, class TOutputImage>
 ShotNoiseImageFilter<TInputImage, TOutputImage>::ShotNoiseImageFilter()
 
 {
-  this->DynamicMultiThreadingOff();
   this->ThreaderUpdateProgressOff();
 }
 
 template <class TInputImage, class TOutputImage>
 void
-ShotNoiseImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
-  const OutputImageRegionType & outputRegionForThread,
-  ThreadIdType)
+ShotNoiseImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread)
 {
   const InputImageType * inputPtr = this->GetInput();
   OutputImageType *      outputPtr = this->GetOutput(0);
 
-  // Create a random generator per thread
-  IndexValueType indSeed = 0;
-  for (unsigned d = 0; d < TOutputImage::ImageDimension; d++)
-  {
-    indSeed += outputRegionForThread.GetIndex(d);
-  }
-  typename Statistics::MersenneTwisterRandomVariateGenerator::Pointer rand =
-    Statistics::MersenneTwisterRandomVariateGenerator::New();
-  const uint32_t seed = Self::Hash(this->GetSeed(), uint32_t(indSeed));
-  rand->Initialize(seed);
-  typename Statistics::NormalVariateGenerator::Pointer randn = Statistics::NormalVariateGenerator::New();
-  randn->Initialize(*reinterpret_cast<const int32_t *>(&seed));
-
   // Define the portion of the input to walk for this thread, using
   // the CallCopyOutputRegionToInputRegion method allows for the input
   // and output images to be different dimensions
@@ -72,10 +55,14 @@ ShotNoiseImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
+  const uint32_t seed = this->GetSeed();
+
   while (!inputIt.IsAtEnd())
   {
+    uint64_t pixelNumber = this->ComputePixelNumber(outputIt.GetIndex());
     while (!inputIt.IsAtEndOfLine())
     {
+      Statistics::PhiloxRandomVariateGenerator rand(seed, pixelNumber++);
       const double in = m_Scale * inputIt.Get();
 
       // The value of >=50, is the lambda value in a Poisson
@@ -91,7 +78,7 @@ ShotNoiseImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
         do
         {
           k += 1;
-          p *= rand->GetVariate();
+          p *= rand.GetVariate();
         } while (p > L);
 
         // Clip the output to the actual supported range
@@ -99,7 +86,7 @@ ShotNoiseImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
       }
       else
       {
-        const double out = in + std::sqrt(in) * randn->GetVariate();
+        const double out = in + std::sqrt(in) * rand.GetNormalVariate();
         outputIt.Set(Self::ClampCast(out / m_Scale));
       }
       ++inputIt;
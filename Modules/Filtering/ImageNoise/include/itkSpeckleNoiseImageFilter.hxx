@@ -20,7 +20,6 @@
 #define itkSpeckleNoiseImageFilter_hxx
 
 #include "itkSpeckleNoiseImageFilter.h"
-#include "itkMersenneTwisterRandomVariateGenerator.h"
 #include "itkImageScanlineIterator.h"
 #include "itkTotalProgressReporter.h"
 
@@ -31,30 +30,17 @@ template <class TInputImage, class TOutputImage>
 SpeckleNoiseImageFilter<TInputImage, TOutputImage>::SpeckleNoiseImageFilter()
 
 {
-  this->DynamicMultiThreadingOff();
   this->ThreaderUpdateProgressOff();
 }
 
 template <class TInputImage, class TOutputImage>
 void
-SpeckleNoiseImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
-  const OutputImageRegionType & outputRegionForThread,
-  ThreadIdType)
+SpeckleNoiseImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread)
 {
   const InputImageType * inputPtr = this->GetInput();
   OutputImageType *      outputPtr = this->GetOutput(0);
 
-  // Create a random generator per thread
-  IndexValueType indSeed = 0;
-  for (unsigned d = 0; d < TOutputImage::ImageDimension; d++)
-  {
-    indSeed += outputRegionForThread.GetIndex(d);
-  }
-  typename Statistics::MersenneTwisterRandomVariateGenerator::Pointer rand =
-    Statistics::MersenneTwisterRandomVariateGenerator::New();
-  const uint32_t seed = Self::Hash(this->GetSeed(), uint32_t(indSeed));
-  rand->Initialize(seed);
-
   // Define the portion of the input to walk for this thread, using
   // the CallCopyOutputRegionToInputRegion method allows for the input
   // and output images to be different dimensions
@@ -79,19 +65,23 @@ SpeckleNoiseImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
   const double delta = k - floork;
   const double v0 = Math::e / (Math::e + delta);
 
+  const uint32_t seed = this->GetSeed();
+
   while (!inputIt.IsAtEnd())
   {
+    uint64_t pixelNumber = this->ComputePixelNumber(outputIt.GetIndex());
     while (!inputIt.IsAtEndOfLine())
     {
+      Statistics::PhiloxRandomVariateGenerator rand(seed, pixelNumber++);
       // First generate the gamma distributed random variable
       // ref http://en.wikipedia.org/wiki/Gamma_distribution#Generating_gamma-distributed_random_variables
       double xi;
       double nu;
       do
       {
-        const double v1 = 1.0 - rand->GetVariateWithOpenUpperRange(); // open *lower* range -- (0,1]
-        const double v2 = 1.0 - rand->GetVariateWithOpenUpperRange();
-        const double v3 = 1.0 - rand->GetVariateWithOpenUpperRange();
+        const double v1 = 1.0 - rand.GetVariateWithOpenUpperRange(); // open *lower* range -- (0,1]
+        const double v2 = 1.0 - rand.GetVariateWithOpenUpperRange();
+        const double v3 = 1.0 - rand.GetVariateWithOpenUpperRange();
         if (v1 <= v0)
         {
           xi = std::pow(v2, 1 / delta);
@@ -106,7 +96,7 @@ SpeckleNoiseImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
       double gamma = xi;
       for (int i = 0; i < floork; i++)
       {
-        gamma -= std::log(1.0 - rand->GetVariateWithOpenUpperRange());
+        gamma -= std::log(1.0 - rand.GetVariateWithOpenUpperRange());
       }
       gamma *= theta;
       // Apply multiplicative noise
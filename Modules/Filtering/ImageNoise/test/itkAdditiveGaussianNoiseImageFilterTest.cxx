@@ -21,6 +21,8 @@
 #include "itkSimpleFilterWatcher.h"
 
 #include "itkAdditiveGaussianNoiseImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkStreamingImageFilter.h"
 #include "itkTestingMacros.h"
 
 int
@@ -76,5 +78,35 @@ itkAdditiveGaussianNoiseImageFilterTest(int argc, char * argv[])
 
   ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
 
+  // The noise does not depend on the number of work units, nor on the
+  // streaming of the output
+  AdditiveGaussianNoiseFilterType::Pointer singleThreadedFilter = AdditiveGaussianNoiseFilterType::New();
+  singleThreadedFilter->SetInput(reader->GetOutput());
+  singleThreadedFilter->SetStandardDeviation(stdDev);
+  singleThreadedFilter->SetMean(mean);
+  singleThreadedFilter->SetSeed(additiveGaussianNoiseFilter->GetSeed());
+  singleThreadedFilter->SetNumberOfWorkUnits(1);
+
+  using StreamingFilterType = itk::StreamingImageFilter<ImageType, ImageType>;
+  StreamingFilterType::Pointer streamer = StreamingFilterType::New();
+  streamer->SetInput(singleThreadedFilter->GetOutput());
+  streamer->SetNumberOfStreamDivisions(5);
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+
+  const ImageType *                        output = additiveGaussianNoiseFilter->GetOutput();
+  itk::ImageRegionConstIterator<ImageType> outputIt(output, output->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> streamedIt(streamer->GetOutput(), output->GetLargestPossibleRegion());
+  for (; !outputIt.IsAtEnd(); ++outputIt, ++streamedIt)
+  {
+    if (outputIt.Get() != streamedIt.Get())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error in the streamed, single threaded output at index " << outputIt.GetIndex() << std::endl;
+      std::cerr << "Expected value " << static_cast<int>(outputIt.Get()) << ", but got "
+                << static_cast<int>(streamedIt.Get()) << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   return EXIT_SUCCESS;
 }
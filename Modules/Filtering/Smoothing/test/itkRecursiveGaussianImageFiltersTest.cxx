@@ -22,6 +22,7 @@
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkImageRegionConstIterator.h"
 #include "itkTestingMacros.h"
+#include "itkVectorImage.h"
 
 #include <algorithm>
 #include <numeric>
@@ -511,6 +512,71 @@ itkRecursiveGaussianImageFiltersTest(int, char *[])
     ITK_TRY_EXPECT_EXCEPTION(filter->Update())
   }
 
+  {
+    std::cout << "Test filtering blocks of lines against filtering one line at a time" << std::endl;
+
+    // The lines of an Image of scalars are filtered by blocks, those of a
+    // VectorImage one at a time.
+    constexpr unsigned int Dimension = 3;
+    using ImageType = itk::Image<float, Dimension>;
+    using VectorImageType = itk::VectorImage<float, Dimension>;
+
+    // Sizes that are not multiples of the number of lines per block.
+    const ImageType::RegionType region(ImageType::SizeType{ { 23, 19, 11 } });
+
+    ImageType::Pointer inputImage = ImageType::New();
+    inputImage->SetRegions(region);
+    inputImage->Allocate();
+    VectorImageType::Pointer vectorImage = VectorImageType::New();
+    vectorImage->SetRegions(region);
+    vectorImage->SetNumberOfComponentsPerPixel(1);
+    vectorImage->Allocate();
+
+    float * const pixels = inputImage->GetBufferPointer();
+    for (itk::SizeValueType i = 0; i < region.GetNumberOfPixels(); ++i)
+    {
+      pixels[i] = static_cast<float>((i * 7919) % 1031) - 500.0f;
+      vectorImage->GetBufferPointer()[i] = pixels[i];
+    }
+
+    using FilterType = itk::RecursiveGaussianImageFilter<ImageType>;
+    using VectorFilterType = itk::RecursiveGaussianImageFilter<VectorImageType>;
+    const itk::GaussianOrderEnum orders[] = { itk::GaussianOrderEnum::ZeroOrder,
+                                              itk::GaussianOrderEnum::FirstOrder,
+                                              itk::GaussianOrderEnum::SecondOrder };
+    for (unsigned int direction = 0; direction < Dimension; ++direction)
+    {
+      for (const auto order : orders)
+      {
+        FilterType::Pointer filter = FilterType::New();
+        filter->SetInput(inputImage);
+        filter->SetDirection(direction);
+        filter->SetOrder(order);
+        filter->SetSigma(2.5);
+        VectorFilterType::Pointer vectorFilter = VectorFilterType::New();
+        vectorFilter->SetInput(vectorImage);
+        vectorFilter->SetDirection(direction);
+        vectorFilter->SetOrder(order);
+        vectorFilter->SetSigma(2.5);
+        ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+        ITK_TRY_EXPECT_NO_EXCEPTION(vectorFilter->Update());
+
+        const float * const output = filter->GetOutput()->GetBufferPointer();
+        const float * const vectorOutput = vectorFilter->GetOutput()->GetBufferPointer();
+        for (itk::SizeValueType i = 0; i < region.GetNumberOfPixels(); ++i)
+        {
+          if (!itk::Math::FloatAlmostEqual(output[i], vectorOutput[i], 4, 1e-3f))
+          {
+            std::cerr << "Test failed!" << std::endl;
+            std::cerr << "Error in direction " << direction << ", order " << order << ", at pixel " << i
+                      << ": expected " << vectorOutput[i] << ", but got " << output[i] << std::endl;
+            return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+  }
+
   // Test streaming enumeration for RecursiveGaussianImageFilterEnums::GaussianOrder elements
   const std::set<itk::RecursiveGaussianImageFilterEnums::GaussianOrder> allGaussianOrder{
     itk::RecursiveGaussianImageFilterEnums::GaussianOrder::ZeroOrder,
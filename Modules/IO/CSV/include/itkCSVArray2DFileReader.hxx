@@ -20,7 +20,7 @@
 
 #include "itkCSVArray2DFileReader.h"
 
-#include "itksys/SystemTools.hxx"
+#include "itkMultiThreaderBase.h"
 #include <limits>
 
 namespace itk
@@ -44,82 +44,91 @@ template <typename TData>
 void
 CSVArray2DFileReader<TData>::Parse()
 {
-  SizeValueType rows = 0;
-  SizeValueType columns = 0;
+  SizeValueType            rows = 0;
+  SizeValueType            columns = 0;
+  std::vector<std::string> columnHeaders;
 
   this->PrepareForParsing();
 
-  this->m_InputStream.clear();
-  this->m_InputStream.open(this->m_FileName.c_str());
-  if (this->m_InputStream.fail())
-  {
-    itkExceptionMacro("The file " << this->m_FileName << " cannot be opened for reading!" << std::endl
-                                  << "Reason: " << itksys::SystemTools::GetLastSystemError());
-  }
-
-  // Get the data dimension and set the matrix size
-  this->GetDataDimension(rows, columns);
+  // Read the file, and get the data dimension and set the matrix size
+  this->ReadFileInChunks(columnHeaders, rows, columns);
 
   this->m_Array2DDataObject->SetMatrixSize(rows, columns);
 
-  /** initialize the matrix to NaN so that missing data will automatically be
-   *  set to this value. */
-  this->m_Array2DDataObject->FillMatrix(std::numeric_limits<TData>::quiet_NaN());
-
-  std::string entry;
-
   // Get the Column Headers if there are any.
   if (this->m_HasColumnHeaders)
   {
     this->m_Array2DDataObject->HasColumnHeadersOn();
 
     // push the entries into the column headers vector.
-    for (unsigned int i = 0; i < columns + 1; i++)
+    for (SizeValueType i = 0; i < columnHeaders.size() && i < columns + 1; i++)
     {
-      this->GetNextField(entry);
-      this->m_Array2DDataObject->ColumnHeadersPushBack(entry);
-      if (this->m_Line.empty())
-      {
-        break;
-      }
+      this->m_Array2DDataObject->ColumnHeadersPushBack(columnHeaders[i]);
     }
 
     /** if there are row headers, get rid of the first entry in the column
      *  headers as it will just be the name of the table. */
-    if (this->m_HasRowHeaders)
+    if (this->m_HasRowHeaders && !columnHeaders.empty())
     {
       this->m_Array2DDataObject->EraseFirstColumnHeader();
     }
   }
 
-  // Get the rest of the data
-  for (unsigned int i = 0; i < rows; i++)
-  {
-    // if there are row headers, push them into the vector for row headers
-    if (this->m_HasRowHeaders)
-    {
-      this->m_Array2DDataObject->HasRowHeadersOn();
-      this->GetNextField(entry);
-      this->m_Array2DDataObject->RowHeadersPushBack(entry);
-    }
+  // Get the rest of the data, parsing the chunks of lines in parallel.
+  const SizeValueType                   numberOfDataChunks = this->m_DataChunks.size();
+  std::vector<std::vector<std::string>> chunkRowHeaders(numberOfDataChunks);
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfDataChunks,
+    [&](SizeValueType chunk) {
+      SizeValueType row = this->m_DataChunks[chunk].m_FirstRow;
+      const char *  position = this->m_DataChunks[chunk].m_Begin;
+      const char *  lineBegin;
+      const char *  lineEnd;
+      const char *  fieldBegin;
+      const char *  fieldEnd;
+      while (this->GetNextLine(position, this->m_DataChunks[chunk].m_End, lineBegin, lineEnd))
+      {
+        // if there are row headers, keep them for the vector for row headers
+        if (this->m_HasRowHeaders)
+        {
+          this->GetNextHeader(lineBegin, lineEnd, fieldBegin, fieldEnd);
+          chunkRowHeaders[chunk].emplace_back(fieldBegin, fieldEnd);
+        }
+
+        // parse the numeric data into the Array2D object
+        SizeValueType column = 0;
+        for (; column < columns && this->GetNextDataField(lineBegin, lineEnd, fieldBegin, fieldEnd); ++column)
+        {
+          this->m_Array2DDataObject->SetMatrixData(
+            row, column, Superclass::template ConvertCharactersToValueType<TData>(fieldBegin, fieldEnd));
+        }
+
+        /** if the file contains missing data, the line contains less data
+         * fields, which are set to NaN. */
+        for (; column < columns; ++column)
+        {
+          this->m_Array2DDataObject->SetMatrixData(row, column, std::numeric_limits<TData>::quiet_NaN());
+        }
+        ++row;
+      }
+    },
+    nullptr);
 
-    // parse the numeric data into the Array2D object
-    for (unsigned int j = 0; j < columns; j++)
+  if (this->m_HasRowHeaders && rows > 0)
+  {
+    this->m_Array2DDataObject->HasRowHeadersOn();
+    for (auto & rowHeaders : chunkRowHeaders)
     {
-      this->GetNextField(entry);
-      this->m_Array2DDataObject->SetMatrixData(i, j, this->ConvertStringToValueType<TData>(entry));
-
-      /** if the file contains missing data, m_Line will contain less data
-       * fields. So we check if m_Line is empty and if it is, we break out of
-       * this loop and move to the next line. */
-      if (this->m_Line.empty())
+      for (auto & rowHeader : rowHeaders)
       {
-        break;
+        this->m_Array2DDataObject->RowHeadersPushBack(rowHeader);
       }
     }
   }
 
-  this->m_InputStream.close();
+  this->m_DataChunks.clear();
+  std::string().swap(this->m_Buffer);
 }
 
 /** Update method */
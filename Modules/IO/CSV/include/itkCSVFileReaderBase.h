@@ -24,6 +24,7 @@
 #include "itkMacro.h"
 #include "itkSize.h"
 #include <fstream>
+#include <vector>
 #include "ITKIOCSVExport.h"
 
 namespace itk
@@ -59,6 +60,12 @@ namespace itk
  * The PrepareForParsing() method does not need to be called explicitly as it
  * is called in the GetDataDimension() method.
  *
+ * Instead of getting the fields one at a time, derived classes can read the
+ * whole file at once with ReadFileInChunks(), which splits its data lines
+ * into chunks that can be parsed in parallel with GetNextLine(),
+ * GetNextHeader() and GetNextDataField(), and converted without copies with
+ * ConvertCharactersToValueType().
+ *
  * \ingroup ITKIOCSV
  */
 
@@ -141,9 +148,20 @@ public:
   template <typename TData>
   TData
   ConvertStringToValueType(const std::string str)
+  {
+    return ConvertCharactersToValueType<TData>(str.data(), str.data() + str.size());
+  }
+
+  /** Converting the characters from begin to end to other numeric value
+   *  types, as ConvertStringToValueType() does, without copying them. The
+   *  float and double conversions are specialized to use the
+   *  double-conversion library instead of a string stream. */
+  template <typename TData>
+  static TData
+  ConvertCharactersToValueType(const char * begin, const char * end)
   {
     TData              value;
-    std::istringstream isstream(str);
+    std::istringstream isstream(std::string(begin, end));
 
     if ((isstream >> value).fail() || !(isstream >> std::ws).eof())
     {
@@ -164,6 +182,15 @@ public:
   Parse() = 0;
 
 protected:
+  /** Whole data lines of the file, the first of which is in the given row
+   *  of the data. */
+  struct DataChunk
+  {
+    const char *  m_Begin;
+    const char *  m_End;
+    SizeValueType m_FirstRow;
+  };
+
   std::string   m_FileName;
   char          m_FieldDelimiterCharacter;
   char          m_StringDelimiterCharacter;
@@ -174,6 +201,10 @@ protected:
   int           m_EndOfColumnHeadersLine;
   std::string   m_Line;
 
+  /** The file read by ReadFileInChunks(), and the chunks of its data lines. */
+  std::string            m_Buffer;
+  std::vector<DataChunk> m_DataChunks;
+
   CSVFileReaderBase();
   ~CSVFileReaderBase() override = default;
   /** Print method */
@@ -183,8 +214,46 @@ protected:
   /** Check that all essential components are present and plugged in. */
   void
   PrepareForParsing();
+
+  /** Reads the whole file into m_Buffer, gets its column headers, if any,
+   *  the first of which is the name of the table when there are row
+   *  headers, counts the rows and columns of its data as GetDataDimension()
+   *  does, and splits its data lines into m_DataChunks. */
+  void
+  ReadFileInChunks(std::vector<std::string> & columnHeaders, SizeValueType & rows, SizeValueType & columns);
+
+  /** Gets the line at position, before end, without its end of line
+   *  character, and moves position to the next line. Returns false if there
+   *  is no line left. */
+  static bool
+  GetNextLine(const char *& position, const char * end, const char *& lineBegin, const char *& lineEnd);
+
+  /** Gets the next header of a line, a column header or the row header at
+   *  its beginning, and moves position past it and its field delimiter.
+   *  Returns false, and an empty header, if there is no header left. */
+  bool
+  GetNextHeader(const char *& position,
+                const char *  lineEnd,
+                const char *& headerBegin,
+                const char *& headerEnd) const;
+
+  /** Gets the next data field of a line, and moves position past it and its
+   *  field delimiter. Returns false if there is no field left. */
+  bool
+  GetNextDataField(const char *& position,
+                   const char *  lineEnd,
+                   const char *& fieldBegin,
+                   const char *& fieldEnd) const;
 };
 
+// declaration of specialization
+template <>
+double
+CSVFileReaderBase::ConvertCharactersToValueType<double>(const char * begin, const char * end);
+template <>
+float
+CSVFileReaderBase::ConvertCharactersToValueType<float>(const char * begin, const char * end);
+
 } // end namespace itk
 
 #endif
@@ -19,10 +19,10 @@
 #define itkCSVNumericObjectFileWriter_hxx
 
 #include "itkCSVNumericObjectFileWriter.h"
+#include "itkNumberToString.h"
 #include "itksys/SystemTools.hxx"
 
 #include <fstream>
-#include <iomanip>
 
 
 namespace itk
@@ -157,6 +157,9 @@ CSVNumericObjectFileWriter<TValue, NRows, NColumns>::Write()
       }
       outputStream << std::endl;
     }
+    NumberToString<TValue> convert;
+    const TValue *         value = this->m_InputObject;
+    std::string            row;
     for (unsigned int i = 0; i < this->m_Rows; i++)
     {
       if (!this->m_RowHeaders.empty())
@@ -167,16 +170,20 @@ CSVNumericObjectFileWriter<TValue, NRows, NColumns>::Write()
         }
       }
 
+      // the values are written by rows, the shortest representations that
+      // read back as the same values
       for (unsigned int j = 0; j < this->m_Columns; j++)
       {
-        outputStream << std::setprecision(std::numeric_limits<TValue>::digits10) << *(this->m_InputObject++);
+        row += convert(*(value++));
 
         if (j < this->m_Columns - 1)
         {
-          outputStream << this->m_FieldDelimiterCharacter;
+          row += this->m_FieldDelimiterCharacter;
         }
       }
-      outputStream << std::endl;
+      row += '\n';
+      outputStream << row;
+      row.clear();
     }
   }
   catch (const itk::ExceptionObject & exp)
@@ -2,6 +2,7 @@ itk_module(ITKIOCSV
   ENABLE_SHARED
   PRIVATE_DEPENDS
     ITKIOImageBase
+    ITKDoubleConversion
   TEST_DEPENDS
     ITKTestKernel
 )
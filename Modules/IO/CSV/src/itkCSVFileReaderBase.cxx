@@ -16,12 +16,55 @@
  *
  *=========================================================================*/
 #include "itkCSVFileReaderBase.h"
+#include "itkMultiThreaderBase.h"
+#include "itksys/SystemTools.hxx"
+#include "double-conversion/double-conversion.h"
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 
+namespace
+{
+// The data lines of a file are split into chunks of at least this size.
+constexpr size_t MinimumDataChunkSize = 64 * 1024;
+
+// Converts as a string stream does: surrounding white spaces are allowed, and
+// empty fields and any other characters are NaN.
+const double_conversion::StringToDoubleConverter &
+GetStringToDoubleConverter()
+{
+  static const double_conversion::StringToDoubleConverter converter(
+    double_conversion::StringToDoubleConverter::ALLOW_LEADING_SPACES |
+      double_conversion::StringToDoubleConverter::ALLOW_TRAILING_SPACES,
+    std::numeric_limits<double>::quiet_NaN(),
+    std::numeric_limits<double>::quiet_NaN(),
+    nullptr,
+    nullptr);
+  return converter;
+}
+} // namespace
+
 namespace itk
 {
 
+template <>
+double
+CSVFileReaderBase::ConvertCharactersToValueType<double>(const char * begin, const char * end)
+{
+  int processedCharactersCount = 0;
+  return GetStringToDoubleConverter().StringToDouble(
+    begin, static_cast<int>(end - begin), &processedCharactersCount);
+}
+
+template <>
+float
+CSVFileReaderBase::ConvertCharactersToValueType<float>(const char * begin, const char * end)
+{
+  int processedCharactersCount = 0;
+  return GetStringToDoubleConverter().StringToFloat(begin, static_cast<int>(end - begin), &processedCharactersCount);
+}
+
 CSVFileReaderBase::CSVFileReaderBase()
 {
   this->m_FileName = "";
@@ -188,6 +231,205 @@ CSVFileReaderBase ::GetDataDimension(SizeValueType & rows, SizeValueType & cols)
   this->m_InputStream.seekg(0);
 }
 
+void
+CSVFileReaderBase ::ReadFileInChunks(std::vector<std::string> & columnHeaders,
+                                     SizeValueType &            rows,
+                                     SizeValueType &            columns)
+{
+  std::ifstream inputStream(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
+  if (inputStream.fail())
+  {
+    itkExceptionMacro("The file " << this->m_FileName << " cannot be opened for reading!" << std::endl
+                                  << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+  inputStream.seekg(0, std::ios::end);
+  this->m_Buffer.resize(static_cast<size_t>(inputStream.tellg()));
+  inputStream.seekg(0);
+  if (!inputStream.read(&this->m_Buffer[0], this->m_Buffer.size()))
+  {
+    itkExceptionMacro("The file " << this->m_FileName << " cannot be read!" << std::endl
+                                  << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+  inputStream.close();
+
+  const char *       position = this->m_Buffer.data();
+  const char * const end = position + this->m_Buffer.size();
+  const char *       lineBegin;
+  const char *       lineEnd;
+  const char *       fieldBegin;
+  const char *       fieldEnd;
+
+  // If column headers exist, get them from the first line.
+  columnHeaders.clear();
+  SizeValueType numberOfColumnHeaders = 0;
+  if (this->m_HasColumnHeaders && GetNextLine(position, end, lineBegin, lineEnd))
+  {
+    while (this->GetNextHeader(lineBegin, lineEnd, fieldBegin, fieldEnd))
+    {
+      columnHeaders.emplace_back(fieldBegin, fieldEnd);
+    }
+    // without the first header, if there are row headers
+    numberOfColumnHeaders = columnHeaders.size();
+    if (this->m_HasRowHeaders && numberOfColumnHeaders > 0)
+    {
+      numberOfColumnHeaders -= 1;
+    }
+  }
+
+  // Split the data lines into chunks of whole lines.
+  const auto          multiThreader = MultiThreaderBase::New();
+  const char * const  dataBegin = position;
+  const size_t        dataSize = end - dataBegin;
+  const SizeValueType numberOfChunks = std::max<SizeValueType>(
+    1, std::min<SizeValueType>(multiThreader->GetNumberOfWorkUnits(), dataSize / MinimumDataChunkSize));
+  this->m_DataChunks.clear();
+  for (SizeValueType chunk = 0; chunk < numberOfChunks && position < end; ++chunk)
+  {
+    const char * chunkEnd = std::max(position, dataBegin + (chunk + 1) * dataSize / numberOfChunks);
+    if (chunkEnd < end)
+    {
+      const void * endOfLine = std::memchr(chunkEnd, '\n', end - chunkEnd);
+      chunkEnd = endOfLine != nullptr ? static_cast<const char *>(endOfLine) + 1 : end;
+    }
+    this->m_DataChunks.push_back(DataChunk{ position, chunkEnd, 0 });
+    position = chunkEnd;
+  }
+
+  // Count the number of entries in each of the lines of the chunks.
+  const SizeValueType        numberOfDataChunks = this->m_DataChunks.size();
+  std::vector<SizeValueType> chunkRows(numberOfDataChunks, 0);
+  std::vector<SizeValueType> chunkMinimumColumns(numberOfDataChunks, std::numeric_limits<SizeValueType>::max());
+  std::vector<SizeValueType> chunkMaximumColumns(numberOfDataChunks, 0);
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfDataChunks,
+    [&](SizeValueType chunk) {
+      const char * chunkPosition = this->m_DataChunks[chunk].m_Begin;
+      const char * chunkLineBegin;
+      const char * chunkLineEnd;
+      const char * chunkFieldBegin;
+      const char * chunkFieldEnd;
+      while (GetNextLine(chunkPosition, this->m_DataChunks[chunk].m_End, chunkLineBegin, chunkLineEnd))
+      {
+        // If row headers exist, move past (but do not count) the row header
+        // in each line.
+        if (this->m_HasRowHeaders)
+        {
+          this->GetNextHeader(chunkLineBegin, chunkLineEnd, chunkFieldBegin, chunkFieldEnd);
+        }
+        SizeValueType cols = 0;
+        while (this->GetNextDataField(chunkLineBegin, chunkLineEnd, chunkFieldBegin, chunkFieldEnd))
+        {
+          ++cols;
+        }
+        ++chunkRows[chunk];
+        chunkMinimumColumns[chunk] = std::min(chunkMinimumColumns[chunk], cols);
+        chunkMaximumColumns[chunk] = std::max(chunkMaximumColumns[chunk], cols);
+      }
+    },
+    nullptr);
+
+  // Determine the max #columns and #rows
+  rows = 0;
+  SizeValueType minimumColumns = numberOfColumnHeaders;
+  SizeValueType maximumColumns = numberOfColumnHeaders;
+  for (SizeValueType chunk = 0; chunk < numberOfDataChunks; ++chunk)
+  {
+    this->m_DataChunks[chunk].m_FirstRow = rows;
+    if (chunkRows[chunk] > 0)
+    {
+      if (rows == 0 && !this->m_HasColumnHeaders)
+      {
+        minimumColumns = chunkMinimumColumns[chunk];
+        maximumColumns = chunkMaximumColumns[chunk];
+      }
+      minimumColumns = std::min(minimumColumns, chunkMinimumColumns[chunk]);
+      maximumColumns = std::max(maximumColumns, chunkMaximumColumns[chunk]);
+    }
+    rows += chunkRows[chunk];
+  }
+  columns = maximumColumns;
+
+  // If the number of entries is not consistent across each row, display a
+  // warning to the user.
+  if (minimumColumns != maximumColumns)
+  {
+    itkWarningMacro(<< "Warning: Data appears to contain missing data! "
+                    << "These will be set to NaN.");
+  }
+}
+
+bool
+CSVFileReaderBase ::GetNextLine(const char *& position,
+                                const char *   end,
+                                const char *&  lineBegin,
+                                const char *&  lineEnd)
+{
+  if (position >= end)
+  {
+    return false;
+  }
+  lineBegin = position;
+  const void * endOfLine = std::memchr(position, '\n', end - position);
+  lineEnd = endOfLine != nullptr ? static_cast<const char *>(endOfLine) : end;
+  position = lineEnd < end ? lineEnd + 1 : end;
+  return true;
+}
+
+bool
+CSVFileReaderBase ::GetNextHeader(const char *& position,
+                                  const char *  lineEnd,
+                                  const char *& headerBegin,
+                                  const char *& headerEnd) const
+{
+  if (position >= lineEnd)
+  {
+    headerBegin = position;
+    headerEnd = position;
+    return false;
+  }
+  if (this->m_UseStringDelimiterCharacter)
+  {
+    // get the string within the string delimiters
+    headerBegin = std::find(position, lineEnd, this->m_StringDelimiterCharacter);
+    if (headerBegin < lineEnd)
+    {
+      ++headerBegin;
+    }
+    headerEnd = std::find(headerBegin, lineEnd, this->m_StringDelimiterCharacter);
+  }
+  else
+  {
+    headerBegin = position;
+    headerEnd = std::find(position, lineEnd, this->m_FieldDelimiterCharacter);
+  }
+
+  // move past the field delimiter
+  position = std::find(headerEnd, lineEnd, this->m_FieldDelimiterCharacter);
+  if (position < lineEnd)
+  {
+    ++position;
+  }
+  return true;
+}
+
+bool
+CSVFileReaderBase ::GetNextDataField(const char *& position,
+                                     const char *  lineEnd,
+                                     const char *& fieldBegin,
+                                     const char *& fieldEnd) const
+{
+  if (position >= lineEnd)
+  {
+    return false;
+  }
+  fieldBegin = position;
+  const void * delimiter = std::memchr(position, this->m_FieldDelimiterCharacter, lineEnd - position);
+  fieldEnd = delimiter != nullptr ? static_cast<const char *>(delimiter) : lineEnd;
+  position = fieldEnd < lineEnd ? fieldEnd + 1 : lineEnd;
+  return true;
+}
+
 /** Function to get the next entry from the file. */
 void
 CSVFileReaderBase ::GetNextField(std::string & str)
@@ -0,0 +1,145 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkCSVArray2DFileReader.h"
+#include "itkCSVNumericObjectFileWriter.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+#include <fstream>
+
+// Writes a table large enough to be read in several chunks, and checks that
+// the values read back are the values written, in the order they were
+// written, with their row and column headers, and that missing data, fields
+// with spaces and fields that are not numbers are read as NaN.
+namespace
+{
+constexpr unsigned int NumberOfRows = 20000;
+constexpr unsigned int NumberOfColumns = 5;
+
+double
+GetValue(unsigned int row, unsigned int column)
+{
+  return (row * NumberOfColumns + column) / 7.0 - 1000.0;
+}
+
+template <typename TData>
+bool
+CheckTable(const std::string & fileName)
+{
+  auto reader = itk::CSVArray2DFileReader<TData>::New();
+  reader->SetFileName(fileName);
+  reader->HasColumnHeadersOn();
+  reader->HasRowHeadersOn();
+  reader->Update();
+  const auto                       output = reader->GetOutput();
+  const itk::Array2D<TData>        matrix = output->GetMatrix();
+  const std::vector<std::string> & rowHeaders = output->GetRowHeaders();
+  const std::vector<std::string> & columnHeaders = output->GetColumnHeaders();
+
+  if (matrix.rows() != NumberOfRows + 1 || matrix.cols() != NumberOfColumns || rowHeaders.size() != NumberOfRows + 1 ||
+      columnHeaders.size() != NumberOfColumns || columnHeaders[NumberOfColumns - 1] != "Column4")
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Read a table of " << matrix.rows() << "x" << matrix.cols() << " with " << rowHeaders.size()
+              << " row headers and " << columnHeaders.size() << " column headers from " << fileName << std::endl;
+    return false;
+  }
+  for (unsigned int i = 0; i < NumberOfRows; ++i)
+  {
+    if (rowHeaders[i] != "Row" + std::to_string(i))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Wrong header " << rowHeaders[i] << " of row " << i << std::endl;
+      return false;
+    }
+    for (unsigned int j = 0; j < NumberOfColumns; ++j)
+    {
+      if (!itk::Math::FloatAlmostEqual(matrix[i][j], static_cast<TData>(GetValue(i, j)), 1))
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Error at row " << i << " and column " << j << ": expected "
+                  << static_cast<TData>(GetValue(i, j)) << ", but got " << matrix[i][j] << std::endl;
+        return false;
+      }
+    }
+  }
+
+  // the last row, " 2.5 ,,x,", has missing data
+  const TData lastRow[NumberOfColumns] = { 2.5, 0, 0, 0, 0 };
+  for (unsigned int j = 0; j < NumberOfColumns; ++j)
+  {
+    const TData value = matrix[NumberOfRows][j];
+    if ((j == 0 && itk::Math::NotExactlyEquals(value, lastRow[j])) || (j > 0 && !std::isnan(value)))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error at column " << j << " of the last row: got " << value << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkCSVArray2DFileReaderLargeFileTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " Filename" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string fileName = argv[1];
+
+  itk::Array2D<double>     matrix(NumberOfRows, NumberOfColumns);
+  std::vector<std::string> rowHeaders;
+  std::vector<std::string> columnHeaders{ "Table" };
+  for (unsigned int j = 0; j < NumberOfColumns; ++j)
+  {
+    columnHeaders.push_back("Column" + std::to_string(j));
+  }
+  for (unsigned int i = 0; i < NumberOfRows; ++i)
+  {
+    rowHeaders.push_back("Row" + std::to_string(i));
+    for (unsigned int j = 0; j < NumberOfColumns; ++j)
+    {
+      matrix[i][j] = GetValue(i, j);
+    }
+  }
+
+  auto writer = itk::CSVNumericObjectFileWriter<double, NumberOfRows, NumberOfColumns>::New();
+  writer->SetFileName(fileName);
+  writer->SetInput(&matrix);
+  writer->SetColumnHeaders(columnHeaders);
+  writer->SetRowHeaders(rowHeaders);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Write());
+  {
+    std::ofstream outputStream(fileName.c_str(), std::ios::app);
+    outputStream << "Last, 2.5 ,,x," << std::endl;
+  }
+
+  bool success = true;
+  ITK_TRY_EXPECT_NO_EXCEPTION(success = CheckTable<double>(fileName) && CheckTable<float>(fileName));
+  if (!success)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -134,10 +134,17 @@ public:
   void
   ReadImageInformation() override;
 
-  /** Reads the data from disk into the memory buffer provided. */
+  /** Reads the data from disk into the memory buffer provided. The frames of
+   * a multi-frame image are those of the IORegion, and the frames of an
+   * encapsulated (compressed) multi-frame image are decoded in parallel. */
   void
   Read(void * buffer) override;
 
+  /** The frames of a multi-frame image are read separately: the streamable
+   * region is the whole of the requested frames. */
+  ImageIORegion
+  GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const override;
+
   /** Set/Get the original component type of the image. This differs from
    * ComponentType which may change as a function of rescale slope and
    * intercept. */
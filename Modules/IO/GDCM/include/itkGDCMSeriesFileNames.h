@@ -32,6 +32,8 @@ class SerieHelper;
 
 namespace itk
 {
+class GDCMSeriesFileSets;
+
 /**
  *\class GDCMSeriesFileNames
  * \brief Generate a sequence of filenames from a DICOM series.
@@ -51,6 +53,12 @@ namespace itk
  *    DICOM objects, you may want to try calling SetUseSeriesDetails(true)
  *    prior to calling SetDirectory().
  *
+ *  The headers of the files of the directory are read in parallel, up to
+ *  their pixel data, and only the values needed to group and order the files
+ *  are kept. When an index file is set, the values are also saved in it, and
+ *  a later scan only reads the files that are not in the index, or whose
+ *  size or modification time changed.
+ *
  * \ingroup IOFilters
  *
  * \ingroup ITKIOGDCM
@@ -185,6 +193,15 @@ public:
   itkGetConstMacro(LoadPrivateTags, bool);
   itkBooleanMacro(LoadPrivateTags);
 
+  /** Set/Get the name of a file that caches the values read from the headers
+   * of the scanned files, keyed by the path, size and modification time of
+   * each file. The index is read and updated by SetInputDirectory(). The
+   * entries are only used with the series restrictions they were computed
+   * with. Defaults to an empty name, for which no index is used.
+   * Must be set before the call to SetInputDirectory(). */
+  itkSetStringMacro(IndexFileName);
+  itkGetStringMacro(IndexFileName);
+
 protected:
   GDCMSeriesFileNames();
   ~GDCMSeriesFileNames() override;
@@ -192,6 +209,11 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
 private:
+  /** Reads the headers of the files of the input directory that are not in
+   * the index, and groups all the files into series. */
+  void
+  ScanInputDirectory();
+
   /** Contains the input directory where the DICOM serie is found */
   std::string m_InputDirectory = "";
 
@@ -205,6 +227,16 @@ private:
   /** Internal structure to order serie from one directory */
   std::unique_ptr<gdcm::SerieHelper> m_SerieHelper;
 
+  /** Internal structure to keep the files of each series of the directory */
+  std::unique_ptr<GDCMSeriesFileSets> m_SeriesFileSets;
+
+  /** Name of the file that caches the values read from the headers */
+  std::string m_IndexFileName;
+
+  /** Describes the restrictions that define the series identifiers, to
+   * discard the entries of an index computed with other restrictions */
+  std::string m_SeriesRestrictions;
+
   /** Internal structure to keep the list of series UIDs */
   SeriesUIDContainerType m_SeriesUIDs;
 
@@ -31,6 +31,7 @@
 #include "itkIOCommon.h"
 #include "itkArray.h"
 #include "itkByteSwapper.h"
+#include "itkMultiThreaderBase.h"
 #include "vnl/vnl_cross.h"
 
 #include "itkMetaDataObject.h"
@@ -46,16 +47,23 @@
 #include "gdcmStringFilter.h"
 #include "gdcmImageApplyLookupTable.h"
 #include "gdcmImageChangePlanarConfiguration.h"
+#include "gdcmRAWCodec.h"
 #include "gdcmRescaler.h"
 #include "gdcmImageReader.h"
+#include "gdcmImageRegionReader.h"
+#include "gdcmBoxRegion.h"
 #include "gdcmImageWriter.h"
 #include "gdcmUIDGenerator.h"
 #include "gdcmAttribute.h"
 #include "gdcmGlobal.h"
 #include "gdcmMediaStorage.h"
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <memory>
 #include <sstream>
+#include <vector>
 
 namespace itk
 {
@@ -67,6 +75,11 @@ public:
   InternalHeader() = default;
   ~InternalHeader() { delete m_Header; }
   gdcm::File * m_Header{ nullptr };
+
+  /** The header parsed by the last ReadImageInformation, up to the Pixel
+   * Data, and the file it was parsed from, kept for the following Read. */
+  std::unique_ptr<gdcm::ImageRegionReader> m_HeaderReader;
+  std::string                              m_HeaderFileName;
 };
 
 GDCMImageIO::GDCMImageIO()
@@ -202,6 +215,135 @@ YCbCr_to_RGB(unsigned char * p, const size_t len)
   }
 }
 
+// Reads the frames [firstFrame, firstFrame + numberOfFrames) of the pixel
+// data that follow the header parsed by ImageRegionReader::ReadInformation,
+// when they are stored uncompressed, in little endian, and with interleaved
+// components, with a single read of the file. Returns false when the pixel
+// data must be read by a full parse.
+static bool
+ReadUncompressedPixelData(const gdcm::ImageRegionReader & reader,
+                          const std::string &             fileName,
+                          char * const                    buffer,
+                          const unsigned int              firstFrame,
+                          const unsigned int              numberOfFrames)
+{
+  const gdcm::Image &                     image = reader.GetImage();
+  const gdcm::TransferSyntax &            ts = reader.GetFile().GetHeader().GetDataSetTransferSyntax();
+  const gdcm::PixelFormat &               pixeltype = image.GetPixelFormat();
+  const gdcm::PhotometricInterpretation & pi = image.GetPhotometricInterpretation();
+
+  const unsigned short bitsAllocated = pixeltype.GetBitsAllocated();
+  if ((ts != gdcm::TransferSyntax::ImplicitVRLittleEndian && ts != gdcm::TransferSyntax::ExplicitVRLittleEndian) ||
+      image.GetPlanarConfiguration() != 0 || pi == gdcm::PhotometricInterpretation::PALETTE_COLOR ||
+      pi == gdcm::PhotometricInterpretation::MONOCHROME1 || pi == gdcm::PhotometricInterpretation::YBR_FULL_422 ||
+      (bitsAllocated != 8 && bitsAllocated != 16 && bitsAllocated != 32 && bitsAllocated != 64))
+  {
+    return false;
+  }
+  const unsigned int numberOfFramesInFile = image.GetNumberOfDimensions() == 3 ? image.GetDimension(2) : 1;
+  const size_t       frameLength = image.GetBufferLength() / numberOfFramesInFile;
+  const size_t       len = frameLength * numberOfFrames;
+
+  // The parsing of the header stopped at the value of the Pixel Data element.
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  file.seekg(static_cast<std::streamoff>(reader.GetStreamCurrentPosition()) +
+             static_cast<std::streamoff>(frameLength * firstFrame));
+
+  const bool needOverlayCleanup = image.AreOverlaysInPixelData() || image.UnusedBitsPresentInPixelData();
+  if (!needOverlayCleanup)
+  {
+    file.read(buffer, static_cast<std::streamsize>(len));
+    return static_cast<size_t>(file.gcount()) == len;
+  }
+
+  // Clear the bits that are not part of the stored values, as
+  // gdcm::Image::GetBuffer does.
+  std::vector<char> storedValues(len);
+  file.read(storedValues.data(), static_cast<std::streamsize>(len));
+  if (static_cast<size_t>(file.gcount()) != len)
+  {
+    return false;
+  }
+  std::vector<unsigned int> dimensions = { image.GetDimension(0), image.GetDimension(1), numberOfFrames };
+  gdcm::RAWCodec            codec;
+  codec.SetPlanarConfiguration(0);
+  codec.SetPhotometricInterpretation(pi);
+  codec.SetPixelFormat(pixeltype);
+  codec.SetNeedByteSwap(false);
+  codec.SetNeedOverlayCleanup(true);
+  codec.SetDimensions(dimensions);
+  return codec.DecodeBytes(storedValues.data(), len, buffer, len);
+}
+
+// Decodes the frames [firstFrame, firstFrame + numberOfFrames) of the
+// encapsulated pixel data of a multi-frame image, whose header was parsed by
+// ImageRegionReader::ReadInformation, on the threads of the multi-threader.
+// Each work unit decodes a contiguous range of frames, one fragment per frame,
+// straight into the buffer. Returns false when the pixel data must be read by
+// a full parse.
+static bool
+ReadEncapsulatedFrames(const gdcm::ImageRegionReader & reader,
+                       const std::string &             fileName,
+                       char * const                    buffer,
+                       const unsigned int              firstFrame,
+                       const unsigned int              numberOfFrames)
+{
+  const gdcm::Image &                     image = reader.GetImage();
+  const gdcm::TransferSyntax &            ts = reader.GetFile().GetHeader().GetDataSetTransferSyntax();
+  const gdcm::PixelFormat &               pixeltype = image.GetPixelFormat();
+  const gdcm::PhotometricInterpretation & pi = image.GetPhotometricInterpretation();
+
+  // A lossy JPEG may be decoded into another color space than the one of the
+  // header, which the full parse takes care of.
+  const unsigned short bitsAllocated = pixeltype.GetBitsAllocated();
+  if (!ts.IsEncapsulated() || image.GetNumberOfDimensions() != 3 || image.GetPlanarConfiguration() != 0 ||
+      !(pi == gdcm::PhotometricInterpretation::MONOCHROME2 ||
+        (pi == gdcm::PhotometricInterpretation::RGB && ts.IsLossless())) ||
+      (bitsAllocated != 8 && bitsAllocated != 16) || image.AreOverlaysInPixelData())
+  {
+    return false;
+  }
+
+  const size_t      frameLength = image.GetBufferLength() / image.GetDimension(2);
+  const auto        multiThreader = MultiThreaderBase::New();
+  const auto        numberOfChunks = std::min(numberOfFrames, multiThreader->GetNumberOfWorkUnits());
+  std::atomic<bool> decoded(true);
+
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [&](SizeValueType chunk) {
+      // The frames of a chunk are decoded from a header parsed by the chunk,
+      // as gdcm::ImageRegionReader reads from its own stream.
+      const unsigned int chunkFirstFrame = static_cast<unsigned int>(chunk * numberOfFrames / numberOfChunks);
+      const unsigned int chunkEndFrame = static_cast<unsigned int>((chunk + 1) * numberOfFrames / numberOfChunks);
+
+      gdcm::ImageRegionReader chunkReader;
+      chunkReader.SetFileName(fileName.c_str());
+      if (!decoded || !chunkReader.ReadInformation())
+      {
+        decoded = false;
+        return;
+      }
+      gdcm::BoxRegion frames;
+      frames.SetDomain(0,
+                       image.GetDimension(0) - 1,
+                       0,
+                       image.GetDimension(1) - 1,
+                       firstFrame + chunkFirstFrame,
+                       firstFrame + chunkEndFrame - 1);
+      chunkReader.SetRegion(frames);
+      if (!chunkReader.ReadIntoBuffer(buffer + frameLength * chunkFirstFrame,
+                                      frameLength * (chunkEndFrame - chunkFirstFrame)))
+      {
+        decoded = false;
+      }
+    },
+    nullptr);
+
+  return decoded;
+}
+
 // This method will only test if the header looks like a
 // GDCM image file.
 bool
@@ -281,86 +423,143 @@ GDCMImageIO::Read(void * pointer)
   inputFileStream.close();
 
   itkAssertInDebugAndIgnoreInReleaseMacro(gdcm::ImageHelper::GetForceRescaleInterceptSlope());
-  gdcm::ImageReader reader;
-  reader.SetFileName(m_FileName.c_str());
-  if (!reader.Read())
+
+  // The frames of a multi-frame image that are read are those of the
+  // IORegion, when it is set.
+  const auto   numberOfFrames = static_cast<unsigned int>(m_Dimensions[2]);
+  unsigned int firstFrame = 0;
+  unsigned int numberOfFramesRead = numberOfFrames;
+  if (numberOfFrames > 1 && m_IORegion.GetImageDimension() > 2)
   {
-    itkExceptionMacro(<< "Cannot read requested file");
+    const ImageIORegion::IndexValueType frameIndex = m_IORegion.GetIndex(2);
+    const ImageIORegion::SizeValueType  frameSize = m_IORegion.GetSize(2);
+    if (frameIndex < 0 || frameSize == 0 || frameIndex + frameSize > numberOfFrames)
+    {
+      itkExceptionMacro(<< "Frames " << frameIndex << " to " << frameIndex + frameSize - 1
+                        << " are not in the file, which has " << numberOfFrames << " frames");
+    }
+    firstFrame = static_cast<unsigned int>(frameIndex);
+    numberOfFramesRead = static_cast<unsigned int>(frameSize);
+  }
+
+  SizeValueType                   len = 0;
+  gdcm::PixelFormat               pixeltype;
+  gdcm::PhotometricInterpretation pi;
+  bool                            pixelDataRead = false;
+
+  // When the header of the file was parsed by ReadImageInformation, read the
+  // pixel data from where the parsing of the header stopped, instead of
+  // parsing the file again, if they are stored uncompressed. The frames of
+  // encapsulated pixel data are decoded in parallel.
+  const std::unique_ptr<gdcm::ImageRegionReader> headerReader = std::move(m_DICOMHeader->m_HeaderReader);
+  if (headerReader && m_DICOMHeader->m_HeaderFileName == m_FileName)
+  {
+    const gdcm::Image & headerImage = headerReader->GetImage();
+    pixeltype = headerImage.GetPixelFormat();
+    pi = headerImage.GetPhotometricInterpretation();
+    len = headerImage.GetBufferLength() / numberOfFrames * numberOfFramesRead;
+    auto * const buffer = static_cast<char *>(pointer);
+    pixelDataRead = ReadUncompressedPixelData(*headerReader, m_FileName, buffer, firstFrame, numberOfFramesRead) ||
+                    ReadEncapsulatedFrames(*headerReader, m_FileName, buffer, firstFrame, numberOfFramesRead);
   }
 
-  gdcm::Image & image = reader.GetImage();
+  if (!pixelDataRead)
+  {
+    gdcm::ImageReader reader;
+    reader.SetFileName(m_FileName.c_str());
+    if (!reader.Read())
+    {
+      itkExceptionMacro(<< "Cannot read requested file");
+    }
+
+    gdcm::Image & image = reader.GetImage();
 #ifndef NDEBUG
-  gdcm::PixelFormat pixeltype_debug = image.GetPixelFormat();
-  itkAssertInDebugAndIgnoreInReleaseMacro(image.GetNumberOfDimensions() == 2 || image.GetNumberOfDimensions() == 3);
+    gdcm::PixelFormat pixeltype_debug = image.GetPixelFormat();
+    itkAssertInDebugAndIgnoreInReleaseMacro(image.GetNumberOfDimensions() == 2 || image.GetNumberOfDimensions() == 3);
 #endif
-  SizeValueType len = image.GetBufferLength();
+    len = image.GetBufferLength();
 
-  // Decompress the Pixel Data buffer when needed. This is required here in the
-  // pipeline to make sure to decompress JPEGBaseline1 into YBR_FULL.
-  if (image.GetTransferSyntax().IsEncapsulated())
-  {
-    gdcm::ImageChangeTransferSyntax icts;
-    icts.SetInput(image);
-    icts.SetTransferSyntax(gdcm::TransferSyntax::ImplicitVRLittleEndian);
-    if (!icts.Change())
+    // Decompress the Pixel Data buffer when needed. This is required here in the
+    // pipeline to make sure to decompress JPEGBaseline1 into YBR_FULL.
+    if (image.GetTransferSyntax().IsEncapsulated())
     {
-      itkExceptionMacro(<< "Failed to change to Implicit Transfer Syntax");
+      gdcm::ImageChangeTransferSyntax icts;
+      icts.SetInput(image);
+      icts.SetTransferSyntax(gdcm::TransferSyntax::ImplicitVRLittleEndian);
+      if (!icts.Change())
+      {
+        itkExceptionMacro(<< "Failed to change to Implicit Transfer Syntax");
+      }
+      image = icts.GetOutput();
     }
-    image = icts.GetOutput();
-  }
 
-  // I think ITK only allow RGB image by pixel (and not by plane)
-  if (image.GetPlanarConfiguration() == 1)
-  {
-    gdcm::ImageChangePlanarConfiguration icpc;
-    icpc.SetInput(image);
-    icpc.SetPlanarConfiguration(0);
-    if (!icpc.Change())
+    // I think ITK only allow RGB image by pixel (and not by plane)
+    if (image.GetPlanarConfiguration() == 1)
     {
-      itkExceptionMacro(<< "Failed to change to Planar Configuration");
+      gdcm::ImageChangePlanarConfiguration icpc;
+      icpc.SetInput(image);
+      icpc.SetPlanarConfiguration(0);
+      if (!icpc.Change())
+      {
+        itkExceptionMacro(<< "Failed to change to Planar Configuration");
+      }
+      image = icpc.GetOutput();
     }
-    image = icpc.GetOutput();
-  }
 
-  gdcm::PhotometricInterpretation pi = image.GetPhotometricInterpretation();
-  if (pi == gdcm::PhotometricInterpretation::PALETTE_COLOR)
-  {
-    gdcm::ImageApplyLookupTable ialut;
-    ialut.SetInput(image);
-    ialut.Apply();
-    image = ialut.GetOutput();
-    len *= 3;
-  }
-  else if (pi == gdcm::PhotometricInterpretation::MONOCHROME1)
-  {
-    // ITK does not carry color space associated with an image. It is pretty
-    // much assumed that scalar image is expressed in MONOCHROME2 (aka min-is-black)
-    gdcm::ImageChangePhotometricInterpretation icpi;
-    icpi.SetInput(image);
-    icpi.SetPhotometricInterpretation(gdcm::PhotometricInterpretation::MONOCHROME2);
-    if (!icpi.Change())
+    pi = image.GetPhotometricInterpretation();
+    if (pi == gdcm::PhotometricInterpretation::PALETTE_COLOR)
     {
-      itkExceptionMacro(<< "Failed to change to Photometric Interpretation");
+      gdcm::ImageApplyLookupTable ialut;
+      ialut.SetInput(image);
+      ialut.Apply();
+      image = ialut.GetOutput();
+      len *= 3;
+    }
+    else if (pi == gdcm::PhotometricInterpretation::MONOCHROME1)
+    {
+      // ITK does not carry color space associated with an image. It is pretty
+      // much assumed that scalar image is expressed in MONOCHROME2 (aka min-is-black)
+      gdcm::ImageChangePhotometricInterpretation icpi;
+      icpi.SetInput(image);
+      icpi.SetPhotometricInterpretation(gdcm::PhotometricInterpretation::MONOCHROME2);
+      if (!icpi.Change())
+      {
+        itkExceptionMacro(<< "Failed to change to Photometric Interpretation");
+      }
+      itkWarningMacro(<< "Converting from MONOCHROME1 to MONOCHROME2 may impact the meaning of DICOM attributes "
+                         "related to pixel values.");
+      image = icpi.GetOutput();
     }
-    itkWarningMacro(<< "Converting from MONOCHROME1 to MONOCHROME2 may impact the meaning of DICOM attributes related "
-                       "to pixel values.");
-    image = icpi.GetOutput();
-  }
 
-  if (!image.GetBuffer((char *)pointer))
-  {
-    itkExceptionMacro(<< "Failed to get the buffer!");
-  }
+    if (numberOfFramesRead == numberOfFrames)
+    {
+      if (!image.GetBuffer((char *)pointer))
+      {
+        itkExceptionMacro(<< "Failed to get the buffer!");
+      }
+    }
+    else
+    {
+      // Only the frames of the IORegion are copied to the buffer.
+      std::vector<char> frames(len);
+      if (!image.GetBuffer(frames.data()))
+      {
+        itkExceptionMacro(<< "Failed to get the buffer!");
+      }
+      len = len / numberOfFrames * numberOfFramesRead;
+      memcpy(pointer, frames.data() + len / numberOfFramesRead * firstFrame, len);
+    }
 
-  const gdcm::PixelFormat & pixeltype = image.GetPixelFormat();
+    pixeltype = image.GetPixelFormat();
 #ifndef NDEBUG
-  // ImageApplyLookupTable is meant to change the pixel type for PALETTE_COLOR images
-  // (from single values to triple values per pixel)
-  if (pi != gdcm::PhotometricInterpretation::PALETTE_COLOR)
-  {
-    itkAssertInDebugAndIgnoreInReleaseMacro(pixeltype_debug == pixeltype);
-  }
+    // ImageApplyLookupTable is meant to change the pixel type for PALETTE_COLOR images
+    // (from single values to triple values per pixel)
+    if (pi != gdcm::PhotometricInterpretation::PALETTE_COLOR)
+    {
+      itkAssertInDebugAndIgnoreInReleaseMacro(pixeltype_debug == pixeltype);
+    }
 #endif
+  }
 
   if (m_RescaleSlope != 1.0 || m_RescaleIntercept != 0.0)
   {
@@ -396,11 +595,24 @@ GDCMImageIO::Read(void * pointer)
   // \postcondition
   // Now that len was updated (after unpacker 12bits -> 16bits, rescale...) ,
   // can now check compat:
-  const SizeValueType numberOfBytesToBeRead = static_cast<SizeValueType>(this->GetImageSizeInBytes());
+  const SizeValueType numberOfBytesToBeRead =
+    static_cast<SizeValueType>(this->GetImageSizeInBytes()) / numberOfFrames * numberOfFramesRead;
   itkAssertInDebugAndIgnoreInReleaseMacro(numberOfBytesToBeRead == len); // programmer error
 #endif
 }
 
+ImageIORegion
+GDCMImageIO::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const
+{
+  ImageIORegion streamableRegion = Superclass::GenerateStreamableReadRegionFromRequestedRegion(requested);
+  if (m_UseStreamedReading && m_NumberOfDimensions > 2 && requested.GetImageDimension() > 2 && m_Dimensions[2] > 1)
+  {
+    streamableRegion.SetIndex(2, requested.GetIndex(2));
+    streamableRegion.SetSize(2, requested.GetSize(2));
+  }
+  return streamableRegion;
+}
+
 
 void
 GDCMImageIO::InternalReadImageInformation()
@@ -414,16 +626,37 @@ GDCMImageIO::InternalReadImageInformation()
   // In general this should be relatively safe to assume
   gdcm::ImageHelper::SetForceRescaleInterceptSlope(true);
 
-  gdcm::ImageReader reader;
-  reader.SetFileName(m_FileName.c_str());
-  if (!reader.Read())
+  m_DICOMHeader->m_HeaderReader.reset();
+
+  // Parse the header only, up to the Pixel Data, and keep it for Read. The
+  // files the header parser does not handle (ACR-NEMA, missing Pixel Data) are
+  // parsed completely, as are those whose private tags are loaded, because
+  // private tags often follow the Pixel Data.
+  std::unique_ptr<gdcm::ImageRegionReader> headerReader;
+  std::unique_ptr<gdcm::ImageReader>       fullReader;
+  if (!m_LoadPrivateTags)
   {
-    itkExceptionMacro(<< "Cannot read requested file");
+    headerReader.reset(new gdcm::ImageRegionReader);
+    headerReader->SetFileName(m_FileName.c_str());
+    if (!headerReader->ReadInformation())
+    {
+      headerReader.reset();
+    }
   }
-  const gdcm::Image &   image = reader.GetImage();
-  const gdcm::File &    f = reader.GetFile();
-  const gdcm::DataSet & ds = f.GetDataSet();
-  const unsigned int *  dims = image.GetDimensions();
+  if (!headerReader)
+  {
+    fullReader.reset(new gdcm::ImageReader);
+    fullReader->SetFileName(m_FileName.c_str());
+    if (!fullReader->Read())
+    {
+      itkExceptionMacro(<< "Cannot read requested file");
+    }
+  }
+  const gdcm::ImageReader & reader = headerReader ? *headerReader : *fullReader;
+  const gdcm::Image &       image = reader.GetImage();
+  const gdcm::File &        f = reader.GetFile();
+  const gdcm::DataSet &     ds = f.GetDataSet();
+  const unsigned int *      dims = image.GetDimensions();
 
   const gdcm::PixelFormat & pixeltype = image.GetPixelFormat();
   switch (pixeltype)
@@ -745,6 +978,9 @@ GDCMImageIO::InternalReadImageInformation()
   this->GetModel(name, 512);
   this->GetScanOptions(name, 512);
 #endif
+
+  m_DICOMHeader->m_HeaderReader = std::move(headerReader);
+  m_DICOMHeader->m_HeaderFileName = m_FileName;
 }
 
 void
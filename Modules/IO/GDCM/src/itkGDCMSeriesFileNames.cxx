@@ -20,15 +20,285 @@
 
 #include "itkGDCMSeriesFileNames.h"
 #include "itksys/SystemTools.hxx"
+#include "itkMultiThreaderBase.h"
 #include "itkProgressReporter.h"
+#include "gdcmAttribute.h"
+#include "gdcmDirectory.h"
+#include "gdcmImageHelper.h"
+#include "gdcmImageRegionReader.h"
 #include "gdcmSerieHelper.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <locale>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+
 namespace itk
 {
 
+/** Files of each series of the scanned directory, in the order of the scan */
+class GDCMSeriesFileSets
+{
+public:
+  std::map<std::string, gdcm::FileList> m_FileSets;
+};
+
+namespace
+{
+const char * const IndexSignature = "ITK GDCMSeriesFileNames index 1";
+
+/** Values read from the header of a file to group and order the files of a
+ * directory */
+struct ScannedFile
+{
+  std::string   fileName;
+  unsigned long size = 0;
+  long int      modifiedTime = 0;
+  bool          isImage = false;
+  std::string   seriesIdentifier;
+  double        origin[3] = { 0.0, 0.0, 0.0 };
+  double        directionCosines[6] = { 1.0, 0.0, 0.0, 0.0, 1.0, 0.0 };
+  bool          hasInstanceNumber = false;
+  int           instanceNumber = 0;
+};
+
+// Reads the header of the file, but not its pixel data, and keeps the values
+// used by gdcm::SerieHelper to group and order the images.
+void
+ReadScannedFile(gdcm::SerieHelper & serieHelper, ScannedFile & scannedFile)
+{
+  scannedFile.isImage = false;
+  try
+  {
+    // Only accept DICOM file containing Image (Pixel Data element), as
+    // gdcm::SerieHelper does.
+    gdcm::ImageRegionReader reader;
+    reader.SetFileName(scannedFile.fileName.c_str());
+    if (!reader.ReadInformation())
+    {
+      return;
+    }
+    gdcm::File & file = reader.GetFile();
+
+    scannedFile.seriesIdentifier = serieHelper.CreateUniqueSeriesIdentifier(&file);
+
+    const std::vector<double> origin = gdcm::ImageHelper::GetOriginValue(file);
+    const std::vector<double> directionCosines = gdcm::ImageHelper::GetDirectionCosinesValue(file);
+    if (origin.size() != 3 || directionCosines.size() != 6)
+    {
+      return;
+    }
+    std::copy(origin.begin(), origin.end(), scannedFile.origin);
+    std::copy(directionCosines.begin(), directionCosines.end(), scannedFile.directionCosines);
+
+    const gdcm::DataSet & dataSet = file.GetDataSet();
+    const gdcm::Tag       instanceNumberTag(0x0020, 0x0013);
+    scannedFile.hasInstanceNumber =
+      dataSet.FindDataElement(instanceNumberTag) && !dataSet.GetDataElement(instanceNumberTag).IsEmpty();
+    if (scannedFile.hasInstanceNumber)
+    {
+      gdcm::Attribute<0x0020, 0x0013> instanceNumber;
+      instanceNumber.SetValue(-1);
+      instanceNumber.SetFromDataSet(dataSet);
+      scannedFile.instanceNumber = instanceNumber.GetValue();
+    }
+    scannedFile.isImage = true;
+  }
+  catch (std::exception &)
+  {
+    scannedFile.isImage = false;
+  }
+}
+
+std::string
+JoinValues(const double * values, const unsigned int numberOfValues, const char separator)
+{
+  std::ostringstream stream;
+  stream.imbue(std::locale::classic());
+  stream << std::setprecision(17);
+  for (unsigned int i = 0; i < numberOfValues; ++i)
+  {
+    if (i > 0)
+    {
+      stream << separator;
+    }
+    stream << values[i];
+  }
+  return stream.str();
+}
+
+bool
+SplitValues(const std::string & text, double * values, const unsigned int numberOfValues)
+{
+  std::istringstream stream(text);
+  stream.imbue(std::locale::classic());
+  for (unsigned int i = 0; i < numberOfValues; ++i)
+  {
+    if (!(stream >> values[i]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Builds the header that gdcm::SerieHelper orders the images with: it only
+// holds the origin, direction cosines and instance number of the image.
+gdcm::SmartPointer<gdcm::FileWithName>
+MakeOrderingHeader(const ScannedFile & scannedFile)
+{
+  gdcm::File      file;
+  gdcm::DataSet & dataSet = file.GetDataSet();
+
+  // A header without SOP Class UID is a secondary capture, whose origin and
+  // direction cosines are not read from the Image Position and Orientation
+  // (Patient).
+  std::string sopClassUID = gdcm::MediaStorage(gdcm::MediaStorage::CTImageStorage).GetString();
+  sopClassUID.resize(sopClassUID.size() + sopClassUID.size() % 2, '\0');
+  gdcm::DataElement sopClassUIDElement(gdcm::Tag(0x0008, 0x0016));
+  sopClassUIDElement.SetVR(gdcm::VR::UI);
+  sopClassUIDElement.SetByteValue(sopClassUID.c_str(), static_cast<uint32_t>(sopClassUID.size()));
+  dataSet.Insert(sopClassUIDElement);
+
+  // The values are stored with the precision of a double, rather than the 16
+  // characters of a DS, so that they are the values read from the file.
+  std::string origin = JoinValues(scannedFile.origin, 3, '\\');
+  std::string directionCosines = JoinValues(scannedFile.directionCosines, 6, '\\');
+  origin.resize(origin.size() + origin.size() % 2, ' ');
+  directionCosines.resize(directionCosines.size() + directionCosines.size() % 2, ' ');
+
+  gdcm::DataElement originElement(gdcm::Tag(0x0020, 0x0032));
+  originElement.SetVR(gdcm::VR::DS);
+  originElement.SetByteValue(origin.c_str(), static_cast<uint32_t>(origin.size()));
+  dataSet.Insert(originElement);
+
+  gdcm::DataElement directionCosinesElement(gdcm::Tag(0x0020, 0x0037));
+  directionCosinesElement.SetVR(gdcm::VR::DS);
+  directionCosinesElement.SetByteValue(directionCosines.c_str(), static_cast<uint32_t>(directionCosines.size()));
+  dataSet.Insert(directionCosinesElement);
+
+  if (scannedFile.hasInstanceNumber)
+  {
+    gdcm::Attribute<0x0020, 0x0013> instanceNumber;
+    instanceNumber.SetValue(scannedFile.instanceNumber);
+    dataSet.Insert(instanceNumber.GetAsDataElement());
+  }
+
+  gdcm::SmartPointer<gdcm::FileWithName> header = new gdcm::FileWithName(file);
+  header->filename = scannedFile.fileName;
+  return header;
+}
+
+// Reads the entries of an index written with the same series restrictions.
+// Malformed entries are ignored: their files are read again.
+std::unordered_map<std::string, ScannedFile>
+ReadIndex(const std::string & indexFileName, const std::string & seriesRestrictions)
+{
+  std::unordered_map<std::string, ScannedFile> index;
+
+  std::ifstream stream(indexFileName.c_str());
+  std::string   line;
+  if (!std::getline(stream, line) || line != IndexSignature || !std::getline(stream, line) ||
+      line != seriesRestrictions)
+  {
+    return index;
+  }
+
+  while (std::getline(stream, line))
+  {
+    std::istringstream lineStream(line);
+    std::string        fields[8];
+    unsigned int       numberOfFields = 0;
+    while (numberOfFields < 8 && std::getline(lineStream, fields[numberOfFields], '\t'))
+    {
+      ++numberOfFields;
+    }
+    // The instance number is empty when the file has none.
+    if (numberOfFields < 7)
+    {
+      continue;
+    }
+
+    ScannedFile        scannedFile;
+    std::istringstream fileStream(fields[1] + ' ' + fields[2] + ' ' + fields[3]);
+    fileStream.imbue(std::locale::classic());
+    if (fields[0].empty() || !(fileStream >> scannedFile.size >> scannedFile.modifiedTime >> scannedFile.isImage) ||
+        !SplitValues(fields[5], scannedFile.origin, 3) || !SplitValues(fields[6], scannedFile.directionCosines, 6))
+    {
+      continue;
+    }
+    scannedFile.fileName = fields[0];
+    scannedFile.seriesIdentifier = fields[4];
+    scannedFile.hasInstanceNumber = !fields[7].empty();
+    if (scannedFile.hasInstanceNumber)
+    {
+      std::istringstream instanceNumberStream(fields[7]);
+      if (!(instanceNumberStream >> scannedFile.instanceNumber))
+      {
+        continue;
+      }
+    }
+    index[scannedFile.fileName] = scannedFile;
+  }
+  return index;
+}
+
+// Writes the index into a temporary file first, so that an interrupted scan
+// does not leave a truncated index.
+bool
+WriteIndex(const std::string &              indexFileName,
+           const std::string &              seriesRestrictions,
+           const std::vector<ScannedFile> & scannedFiles)
+{
+  const std::string temporaryFileName = indexFileName + ".tmp";
+  {
+    std::ofstream stream(temporaryFileName.c_str());
+    stream.imbue(std::locale::classic());
+    stream << IndexSignature << '\n' << seriesRestrictions << '\n';
+    for (const auto & scannedFile : scannedFiles)
+    {
+      // Such a file is read again by each scan.
+      if (scannedFile.fileName.find_first_of("\t\n\r") != std::string::npos)
+      {
+        continue;
+      }
+      stream << scannedFile.fileName << '\t' << scannedFile.size << '\t' << scannedFile.modifiedTime << '\t'
+             << scannedFile.isImage << '\t' << scannedFile.seriesIdentifier << '\t'
+             << JoinValues(scannedFile.origin, 3, ' ') << '\t' << JoinValues(scannedFile.directionCosines, 6, ' ')
+             << '\t';
+      if (scannedFile.hasInstanceNumber)
+      {
+        stream << scannedFile.instanceNumber;
+      }
+      stream << '\n';
+    }
+    if (!stream)
+    {
+      return false;
+    }
+  }
+  if (std::rename(temporaryFileName.c_str(), indexFileName.c_str()) != 0)
+  {
+    // Some platforms do not replace an existing file.
+    itksys::SystemTools::RemoveFile(indexFileName);
+    if (std::rename(temporaryFileName.c_str(), indexFileName.c_str()) != 0)
+    {
+      itksys::SystemTools::RemoveFile(temporaryFileName);
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
 
 GDCMSeriesFileNames::GDCMSeriesFileNames()
   : m_SerieHelper{ new gdcm::SerieHelper() }
+  , m_SeriesFileSets{ new GDCMSeriesFileSets() }
 {}
 
 GDCMSeriesFileNames::~GDCMSeriesFileNames() = default;
@@ -49,6 +319,7 @@ void
 GDCMSeriesFileNames::AddSeriesRestriction(const std::string & tag)
 {
   m_SerieHelper->AddRestriction(tag);
+  m_SeriesRestrictions += tag + ';';
 }
 
 void
@@ -73,29 +344,85 @@ GDCMSeriesFileNames::SetInputDirectory(std::string const & name)
   m_SerieHelper->Clear();
   m_SerieHelper->SetUseSeriesDetails(m_UseSeriesDetails);
   m_SerieHelper->SetLoadMode((m_LoadSequences ? 0 : gdcm::LD_NOSEQ) | (m_LoadPrivateTags ? 0 : gdcm::LD_NOSHADOW));
-  m_SerieHelper->SetDirectory(name, m_Recursive);
+  this->ScanInputDirectory();
   // as a side effect it also execute
   this->Modified();
 }
 
+void
+GDCMSeriesFileNames::ScanInputDirectory()
+{
+  m_SeriesFileSets->m_FileSets.clear();
+
+  gdcm::Directory directory;
+  directory.Load(m_InputDirectory, m_Recursive);
+  const gdcm::Directory::FilenamesType & fileNames = directory.GetFilenames();
+
+  const std::string seriesRestrictions = (m_UseSeriesDetails ? "details;" : ";") + m_SeriesRestrictions;
+  std::unordered_map<std::string, ScannedFile> index;
+  if (!m_IndexFileName.empty())
+  {
+    index = ReadIndex(m_IndexFileName, seriesRestrictions);
+  }
+
+  std::vector<ScannedFile>   scannedFiles(fileNames.size());
+  std::vector<SizeValueType> filesToRead;
+  for (SizeValueType i = 0; i < fileNames.size(); ++i)
+  {
+    ScannedFile & scannedFile = scannedFiles[i];
+    scannedFile.fileName = fileNames[i];
+    scannedFile.size = itksys::SystemTools::FileLength(scannedFile.fileName);
+    scannedFile.modifiedTime = itksys::SystemTools::ModifiedTime(scannedFile.fileName);
+
+    const auto indexEntry = index.find(scannedFile.fileName);
+    if (indexEntry != index.end() && indexEntry->second.size == scannedFile.size &&
+        indexEntry->second.modifiedTime == scannedFile.modifiedTime)
+    {
+      scannedFile = indexEntry->second;
+    }
+    else
+    {
+      filesToRead.push_back(i);
+    }
+  }
+
+  // The headers are independent, and CreateUniqueSeriesIdentifier only reads
+  // the settings of the helper.
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    filesToRead.size(),
+    [this, &scannedFiles, &filesToRead](SizeValueType k) {
+      ReadScannedFile(*m_SerieHelper, scannedFiles[filesToRead[k]]);
+    },
+    this);
+
+  if (!m_IndexFileName.empty() && !filesToRead.empty() &&
+      !WriteIndex(m_IndexFileName, seriesRestrictions, scannedFiles))
+  {
+    itkWarningMacro(<< "Could not write the index file " << m_IndexFileName);
+  }
+
+  // The files of a series are in the order of the directory, as they are
+  // when gdcm::SerieHelper reads the directory.
+  for (const auto & scannedFile : scannedFiles)
+  {
+    if (scannedFile.isImage)
+    {
+      m_SeriesFileSets->m_FileSets[scannedFile.seriesIdentifier].push_back(MakeOrderingHeader(scannedFile));
+    }
+  }
+}
+
 const GDCMSeriesFileNames::SeriesUIDContainerType &
 GDCMSeriesFileNames::GetSeriesUIDs()
 {
   m_SeriesUIDs.clear();
-  // Accessing the first serie found (assume there is at least one)
-  gdcm::FileList * flist = m_SerieHelper->GetFirstSingleSerieUIDFileSet();
-  while (flist)
+  for (const auto & fileSet : m_SeriesFileSets->m_FileSets)
   {
-    if (!flist->empty()) // make sure we have at leat one serie
+    if (!fileSet.second.empty()) // make sure we have at leat one serie
     {
-      gdcm::File * file = (*flist)[0]; // for example take the first one
-
-      // Create its unique series ID
-      std::string id = m_SerieHelper->CreateUniqueSeriesIdentifier(file).c_str();
-
-      m_SeriesUIDs.push_back(id.c_str());
+      m_SeriesUIDs.push_back(fileSet.first);
     }
-    flist = m_SerieHelper->GetNextSingleSerieUIDFileSet();
   }
   if (m_SeriesUIDs.empty())
   {
@@ -109,36 +436,22 @@ GDCMSeriesFileNames::GetFileNames(const std::string serie)
 {
   m_InputFileNames.clear();
   // Accessing the first serie found (assume there is at least one)
-  gdcm::FileList * flist = m_SerieHelper->GetFirstSingleSerieUIDFileSet();
-  if (!flist)
+  auto fileSet = m_SeriesFileSets->m_FileSets.begin();
+  if (fileSet == m_SeriesFileSets->m_FileSets.end())
   {
     itkWarningMacro(<< "No Series can be found, make sure your restrictions are not too strong");
     return m_InputFileNames;
   }
   if (!serie.empty()) // user did not specify any sub selection based on UID
   {
-    bool found = false;
-    while (flist && !found)
-    {
-      if (!flist->empty()) // make sure we have at leat one serie
-      {
-        gdcm::File * file = (*flist)[0]; // for example take the first one
-        std::string  id = m_SerieHelper->CreateUniqueSeriesIdentifier(file).c_str();
-
-        if (id == serie)
-        {
-          found = true; // we found a match
-          break;
-        }
-      }
-      flist = m_SerieHelper->GetNextSingleSerieUIDFileSet();
-    }
-    if (!found)
+    fileSet = m_SeriesFileSets->m_FileSets.find(serie);
+    if (fileSet == m_SeriesFileSets->m_FileSets.end() || fileSet->second.empty())
     {
       itkWarningMacro(<< "No Series were found");
       return m_InputFileNames;
     }
   }
+  gdcm::FileList * flist = &fileSet->second;
   m_SerieHelper->OrderFileList(flist);
 
   gdcm::FileList::iterator it;
@@ -286,6 +599,8 @@ GDCMSeriesFileNames::PrintSelf(std::ostream & os, Indent indent) const
     os << indent << "InputFileNames[" << i << "]: " << m_InputFileNames[i] << std::endl;
   }
 
+  os << indent << "IndexFileName: " << m_IndexFileName << std::endl;
+
   os << indent << "OutputDirectory: " << m_OutputDirectory << std::endl;
   for (i = 0; i < m_OutputFileNames.size(); i++)
   {
@@ -299,6 +614,7 @@ GDCMSeriesFileNames::SetUseSeriesDetails(bool useSeriesDetails)
   m_UseSeriesDetails = useSeriesDetails;
   m_SerieHelper->SetUseSeriesDetails(m_UseSeriesDetails);
   m_SerieHelper->CreateDefaultUniqueSeriesIdentifier();
+  m_SeriesRestrictions += "default;";
 }
 } // namespace itk
 
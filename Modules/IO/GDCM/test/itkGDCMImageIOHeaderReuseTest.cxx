@@ -0,0 +1,137 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGDCMImageIO.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkMetaDataObject.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <vector>
+
+// Checks that the pixel data read after the header parsed by
+// ReadImageInformation are those read by a complete parse of the file, which
+// GDCMImageIO does when it loads the private tags.
+namespace
+{
+using ImageType = itk::Image<short, 2>;
+
+ImageType::Pointer
+ReadImage(const std::string & fileName, const bool loadPrivateTags, itk::MetaDataDictionary & dictionary)
+{
+  auto gdcmImageIO = itk::GDCMImageIO::New();
+  gdcmImageIO->SetLoadPrivateTags(loadPrivateTags);
+
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetImageIO(gdcmImageIO);
+  reader->SetFileName(fileName);
+  reader->Update();
+
+  dictionary = gdcmImageIO->GetMetaDataDictionary();
+  return reader->GetOutput();
+}
+} // namespace
+
+int
+itkGDCMImageIOHeaderReuseTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " OutputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 67, 45 } });
+  image->Allocate();
+  for (itk::SizeValueType i = 0; i < image->GetBufferedRegion().GetNumberOfPixels(); ++i)
+  {
+    image->GetBufferPointer()[i] = static_cast<short>((i * 37) % 4000 - 1000);
+  }
+
+  const std::string uncompressedFileName = outputDirectory + "/itkGDCMImageIOHeaderReuseTest.dcm";
+  const std::string compressedFileName = outputDirectory + "/itkGDCMImageIOHeaderReuseTestJPEG2000.dcm";
+
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetImageIO(itk::GDCMImageIO::New());
+  writer->SetInput(image);
+  writer->SetFileName(uncompressedFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  auto compressingImageIO = itk::GDCMImageIO::New();
+  compressingImageIO->SetCompressionType(itk::GDCMImageIO::CompressionEnum::JPEG2000);
+  writer->SetImageIO(compressingImageIO);
+  writer->UseCompressionOn();
+  writer->SetFileName(compressedFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  for (const auto & fileName : { uncompressedFileName, compressedFileName })
+  {
+    itk::MetaDataDictionary headerDictionary;
+    itk::MetaDataDictionary fullDictionary;
+    ImageType::Pointer      headerImage;
+    ImageType::Pointer      fullImage;
+    ITK_TRY_EXPECT_NO_EXCEPTION(headerImage = ReadImage(fileName, false, headerDictionary));
+    ITK_TRY_EXPECT_NO_EXCEPTION(fullImage = ReadImage(fileName, true, fullDictionary));
+
+    ITK_TEST_EXPECT_EQUAL(headerImage->GetBufferedRegion(), image->GetBufferedRegion());
+    for (itk::SizeValueType i = 0; i < image->GetBufferedRegion().GetNumberOfPixels(); ++i)
+    {
+      if (headerImage->GetBufferPointer()[i] != fullImage->GetBufferPointer()[i] ||
+          headerImage->GetBufferPointer()[i] != image->GetBufferPointer()[i])
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Error in pixel " << i << " of " << fileName << ": expected " << image->GetBufferPointer()[i]
+                  << ", but got " << headerImage->GetBufferPointer()[i] << " after reading the header, and "
+                  << fullImage->GetBufferPointer()[i] << " after a full parse" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    ITK_TEST_EXPECT_TRUE(headerDictionary.GetKeys() == fullDictionary.GetKeys());
+    for (const auto & key : headerDictionary.GetKeys())
+    {
+      std::string headerValue;
+      std::string fullValue;
+      itk::ExposeMetaData(headerDictionary, key, headerValue);
+      itk::ExposeMetaData(fullDictionary, key, fullValue);
+      if (headerValue != fullValue)
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Error in tag " << key << " of " << fileName << ": expected " << fullValue << ", but got "
+                  << headerValue << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // The header parsed for one file is not used to read another one.
+  auto gdcmImageIO = itk::GDCMImageIO::New();
+  gdcmImageIO->SetFileName(compressedFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(gdcmImageIO->ReadImageInformation());
+  gdcmImageIO->SetFileName(uncompressedFileName);
+  std::vector<short> buffer(image->GetBufferedRegion().GetNumberOfPixels());
+  ITK_TRY_EXPECT_NO_EXCEPTION(gdcmImageIO->Read(buffer.data()));
+  ITK_TEST_EXPECT_TRUE(std::equal(buffer.begin(), buffer.end(), image->GetBufferPointer()));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,174 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkDefaultConvertPixelTraits.h"
+#include "itkGDCMImageIO.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkRGBPixel.h"
+#include "itkTestingMacros.h"
+
+// Checks that the frames of compressed multi-frame images, which are decoded
+// in parallel, are those decoded by a full parse of the files, and that a
+// requested region reads only the requested frames.
+namespace
+{
+constexpr unsigned int Dimension = 3;
+
+template <typename TImage>
+typename TImage::Pointer
+ReadImage(const std::string &                       fileName,
+          const bool                                loadPrivateTags,
+          const typename TImage::RegionType * const requestedRegion = nullptr)
+{
+  auto gdcmImageIO = itk::GDCMImageIO::New();
+  // The private tags are loaded by a full parse of the file.
+  gdcmImageIO->SetLoadPrivateTags(loadPrivateTags);
+
+  auto reader = itk::ImageFileReader<TImage>::New();
+  reader->SetImageIO(gdcmImageIO);
+  reader->SetFileName(fileName);
+  if (requestedRegion)
+  {
+    reader->UpdateOutputInformation();
+    reader->GetOutput()->SetRequestedRegion(*requestedRegion);
+  }
+  reader->Update();
+  return reader->GetOutput();
+}
+
+// Compares the pixels of the buffered region of an image to those of the
+// written image.
+template <typename TImage>
+bool
+CheckPixels(const TImage * image, const TImage * expectedImage, const std::string & description)
+{
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != expectedImage->GetPixel(it.GetIndex()))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << description << ": error at index " << it.GetIndex() << std::endl;
+      std::cerr << "Expected " << expectedImage->GetPixel(it.GetIndex()) << ", but got " << it.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename TPixel>
+bool
+TestCompression(const std::string &                     directory,
+                const itk::GDCMImageIO::CompressionEnum compression,
+                const std::string &                     compressionName)
+{
+  using ImageType = itk::Image<TPixel, Dimension>;
+  using RegionType = typename ImageType::RegionType;
+  using PixelTraits = itk::DefaultConvertPixelTraits<TPixel>;
+  using ValueType = typename PixelTraits::ComponentType;
+
+  std::ostringstream fileName;
+  fileName << directory << "/itkGDCMImageIOMultiFrameDecodeTest" << compressionName << "_"
+           << PixelTraits::GetNumberOfComponents() << "_" << sizeof(ValueType) << ".dcm";
+
+  const RegionType largestRegion(typename ImageType::SizeType{ { 23, 17, 9 } });
+  auto             image = ImageType::New();
+  image->SetRegions(largestRegion);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, largestRegion); !it.IsAtEnd(); ++it)
+  {
+    const typename ImageType::IndexType index = it.GetIndex();
+    TPixel                              pixel;
+    for (unsigned int k = 0; k < PixelTraits::GetNumberOfComponents(); ++k)
+    {
+      const auto value = index[0] * 5 + index[1] * 3 + index[2] * 11 + 40 * k;
+      PixelTraits::SetNthComponent(k, pixel, static_cast<ValueType>(value));
+    }
+    it.Set(pixel);
+  }
+
+  auto gdcmImageIO = itk::GDCMImageIO::New();
+  gdcmImageIO->SetCompressionType(compression);
+
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetImageIO(gdcmImageIO);
+  writer->UseCompressionOn();
+  writer->SetInput(image);
+  writer->SetFileName(fileName.str());
+  writer->Update();
+
+  const std::string description = fileName.str();
+  const auto        decodedImage = ReadImage<ImageType>(fileName.str(), false);
+  const auto        parsedImage = ReadImage<ImageType>(fileName.str(), true);
+  if (decodedImage->GetBufferedRegion() != largestRegion || !CheckPixels<ImageType>(decodedImage, image, description) ||
+      !CheckPixels<ImageType>(parsedImage, image, description + " (full parse)"))
+  {
+    return false;
+  }
+
+  // Only the frames of the requested region are read.
+  RegionType requestedRegion = largestRegion;
+  requestedRegion.SetIndex(2, 3);
+  requestedRegion.SetSize(2, 4);
+  requestedRegion.SetSize(0, 10);
+  for (const bool loadPrivateTags : { false, true })
+  {
+    const auto framesImage = ReadImage<ImageType>(fileName.str(), loadPrivateTags, &requestedRegion);
+    const RegionType & bufferedRegion = framesImage->GetBufferedRegion();
+    if (bufferedRegion.GetIndex(2) != 3 || bufferedRegion.GetSize(2) != 4 ||
+        bufferedRegion.GetSize(0) != largestRegion.GetSize(0) ||
+        !CheckPixels<ImageType>(framesImage, image, description + " (frames 3 to 6)"))
+    {
+      std::cerr << "Buffered region: " << bufferedRegion << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkGDCMImageIOMultiFrameDecodeTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " OutputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string directory = argv[1];
+
+  using CompressionEnum = itk::GDCMImageIO::CompressionEnum;
+  // GDCMImageIO writes lossless JPEG and JPEG 2000.
+  const std::vector<std::pair<CompressionEnum, std::string>> compressions = { { CompressionEnum::JPEG, "JPEG" },
+                                                                              { CompressionEnum::JPEG2000, "JPEG2000" } };
+  for (const auto & compression : compressions)
+  {
+    if (!TestCompression<unsigned short>(directory, compression.first, compression.second) ||
+        !TestCompression<unsigned char>(directory, compression.first, compression.second) ||
+        !TestCompression<itk::RGBPixel<unsigned char>>(directory, compression.first, compression.second))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
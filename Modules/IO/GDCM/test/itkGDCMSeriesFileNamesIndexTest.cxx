@@ -0,0 +1,201 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGDCMImageIO.h"
+#include "itkGDCMSeriesFileNames.h"
+#include "itkImageFileWriter.h"
+#include "itkMetaDataObject.h"
+#include "itkTestingMacros.h"
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm>
+#include <fstream>
+
+// Checks that a scan of a directory that uses an index finds the series and
+// the order of the files found by a scan that reads every file, and that the
+// index does not hide the files changed after it was written.
+namespace
+{
+using ImageType = itk::Image<short, 3>;
+using SeriesFileNamesType = itk::GDCMSeriesFileNames;
+
+void
+WriteSlice(const std::string & fileName,
+           const std::string & seriesUID,
+           const double        position,
+           const std::string & seriesDescription = "")
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 8, 6, 1 } });
+  image->Allocate();
+  image->FillBuffer(static_cast<short>(position));
+
+  ImageType::PointType origin;
+  origin[0] = -2.5;
+  origin[1] = 4.0;
+  origin[2] = position;
+  image->SetOrigin(origin);
+
+  itk::MetaDataDictionary & dictionary = image->GetMetaDataDictionary();
+  itk::EncapsulateMetaData<std::string>(dictionary, "0020|000e", seriesUID);
+  // A secondary capture has no Image Position (Patient).
+  itk::EncapsulateMetaData<std::string>(dictionary, "0008|0060", "MR");
+  if (!seriesDescription.empty())
+  {
+    itk::EncapsulateMetaData<std::string>(dictionary, "0008|103e", seriesDescription);
+  }
+
+  auto gdcmImageIO = itk::GDCMImageIO::New();
+  gdcmImageIO->KeepOriginalUIDOn();
+
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetImageIO(gdcmImageIO);
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  writer->Update();
+}
+
+using SeriesType = std::vector<std::pair<std::string, SeriesFileNamesType::FileNamesContainerType>>;
+
+SeriesType
+ScanDirectory(const std::string & directory, const std::string & indexFileName)
+{
+  auto seriesFileNames = SeriesFileNamesType::New();
+  seriesFileNames->SetIndexFileName(indexFileName);
+  seriesFileNames->SetInputDirectory(directory);
+
+  SeriesType series;
+  for (const auto & seriesUID : seriesFileNames->GetSeriesUIDs())
+  {
+    series.emplace_back(seriesUID, seriesFileNames->GetFileNames(seriesUID));
+  }
+  return series;
+}
+
+bool
+CheckSeries(const SeriesType & series, const SeriesType & expectedSeries)
+{
+  if (series != expectedSeries)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Expected " << expectedSeries.size() << " series, but got " << series.size() << ":" << std::endl;
+    for (const auto & fileSet : series)
+    {
+      std::cerr << fileSet.first << ":";
+      for (const auto & fileName : fileSet.second)
+      {
+        std::cerr << " " << itksys::SystemTools::GetFilenameName(fileName);
+      }
+      std::cerr << std::endl;
+    }
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+int
+itkGDCMSeriesFileNamesIndexTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " OutputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string directory = std::string(argv[1]) + "/itkGDCMSeriesFileNamesIndexTest";
+  const std::string indexFileName = std::string(argv[1]) + "/itkGDCMSeriesFileNamesIndexTest.index";
+  itksys::SystemTools::RemoveADirectory(directory);
+  itksys::SystemTools::MakeDirectory(directory);
+  itksys::SystemTools::RemoveFile(indexFileName);
+
+  auto seriesFileNames = SeriesFileNamesType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(seriesFileNames, GDCMSeriesFileNames, ProcessObject);
+
+  ITK_TEST_EXPECT_EQUAL(seriesFileNames->GetIndexFileName(), std::string());
+  seriesFileNames->SetIndexFileName(indexFileName);
+  ITK_TEST_SET_GET_VALUE(indexFileName, seriesFileNames->GetIndexFileName());
+
+  // The names of the slices of the first series are in the reverse order of
+  // their positions.
+  const std::string firstSeriesUID = "1.2.826.0.1.3680043.2.1125.1.1";
+  const std::string secondSeriesUID = "1.2.826.0.1.3680043.2.1125.1.2";
+  const std::string otherSeriesUID = "1.2.826.0.1.3680043.2.1125.1.3";
+  SeriesFileNamesType::FileNamesContainerType firstSeries;
+  SeriesFileNamesType::FileNamesContainerType secondSeries;
+  for (int k = 0; k < 6; ++k)
+  {
+    firstSeries.push_back(directory + "/a" + std::to_string(5 - k) + ".dcm");
+    ITK_TRY_EXPECT_NO_EXCEPTION(WriteSlice(firstSeries.back(), firstSeriesUID, 1.25 * k));
+  }
+  for (int k = 0; k < 3; ++k)
+  {
+    secondSeries.push_back(directory + "/b" + std::to_string(k) + ".dcm");
+    ITK_TRY_EXPECT_NO_EXCEPTION(WriteSlice(secondSeries.back(), secondSeriesUID, -0.5 * k));
+  }
+  std::reverse(secondSeries.begin(), secondSeries.end());
+  std::ofstream(directory + "/notes.txt") << "Not a DICOM file" << std::endl;
+
+  const SeriesType expectedSeries = { { firstSeriesUID, firstSeries }, { secondSeriesUID, secondSeries } };
+  if (!CheckSeries(ScanDirectory(directory, ""), expectedSeries))
+  {
+    return EXIT_FAILURE;
+  }
+  ITK_TEST_EXPECT_TRUE(!itksys::SystemTools::FileExists(indexFileName));
+
+  // The first scan writes the index, the second one reads it.
+  if (!CheckSeries(ScanDirectory(directory, indexFileName), expectedSeries))
+  {
+    return EXIT_FAILURE;
+  }
+  ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileExists(indexFileName));
+  if (!CheckSeries(ScanDirectory(directory, indexFileName), expectedSeries))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // A file that changed after the index was written is read again.
+  const std::string movedFileName = firstSeries[2];
+  firstSeries.erase(firstSeries.begin() + 2);
+  ITK_TRY_EXPECT_NO_EXCEPTION(WriteSlice(movedFileName, otherSeriesUID, 3.0, "Moved to another series"));
+  const SeriesType changedSeries = { { firstSeriesUID, firstSeries },
+                                     { secondSeriesUID, secondSeries },
+                                     { otherSeriesUID, { movedFileName } } };
+  if (!CheckSeries(ScanDirectory(directory, indexFileName), changedSeries) ||
+      !CheckSeries(ScanDirectory(directory, ""), changedSeries))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // An index written with other series restrictions is not used.
+  auto detailedSeriesFileNames = SeriesFileNamesType::New();
+  detailedSeriesFileNames->SetUseSeriesDetails(true);
+  detailedSeriesFileNames->SetIndexFileName(indexFileName);
+  detailedSeriesFileNames->SetInputDirectory(directory);
+  const SeriesFileNamesType::SeriesUIDContainerType & detailedSeriesUIDs = detailedSeriesFileNames->GetSeriesUIDs();
+  ITK_TEST_EXPECT_EQUAL(detailedSeriesUIDs.size(), 3);
+  for (const auto & seriesUID : detailedSeriesUIDs)
+  {
+    // The series number, rows and columns are appended to the UID.
+    ITK_TEST_EXPECT_TRUE(seriesUID.size() > firstSeriesUID.size());
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
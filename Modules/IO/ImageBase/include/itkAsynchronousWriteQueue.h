@@ -0,0 +1,130 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkAsynchronousWriteQueue_h
+#define itkAsynchronousWriteQueue_h
+#include "ITKIOImageBaseExport.h"
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace itk
+{
+/** \class AsynchronousWriteQueue
+ * \brief Bounded queue of writes run on background threads.
+ *
+ * Writes are functions run in the order they are enqueued by a few
+ * dedicated threads, so that encoding, compressing and writing files
+ * overlaps with the computation of the calling thread, without taking
+ * threads from the pool that filters run on.
+ *
+ * The queue holds at most MaximumNumberOfPendingWrites writes, queued or
+ * running: Enqueue() waits while it is full, which bounds the memory held by
+ * the data waiting to be written. Each write gets a future, whose get()
+ * rethrows the exception the write threw, if any. Flush() waits until no
+ * write is pending, and rethrows the first exception thrown by a write since
+ * the previous Flush(). The destructor waits for the pending writes.
+ *
+ * \sa ImageFileWriter::WriteAsynchronously
+ * \ingroup IOFilters
+ * \ingroup ITKIOImageBase
+ */
+class ITKIOImageBase_EXPORT AsynchronousWriteQueue : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(AsynchronousWriteQueue);
+
+  /** Standard class type aliases. */
+  using Self = AsynchronousWriteQueue;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(AsynchronousWriteQueue, Object);
+
+  using WriteFunctionType = std::function<void()>;
+  using WriteFutureType = std::shared_future<void>;
+
+  /** The queue of the writers for which none is set. */
+  static Pointer
+  GetGlobalQueue();
+
+  /** The number of threads running the writes. They are started by
+   * Enqueue() as needed, up to this number; lowering it does not stop the
+   * threads already started. The default is 1, which writes the files one
+   * after the other. */
+  void
+  SetNumberOfThreads(unsigned int numberOfThreads);
+  unsigned int
+  GetNumberOfThreads() const;
+
+  /** The maximum number of writes queued or running, at least 1. The
+   * default is 2. */
+  void
+  SetMaximumNumberOfPendingWrites(unsigned int maximumNumberOfPendingWrites);
+  unsigned int
+  GetMaximumNumberOfPendingWrites() const;
+
+  /** The number of writes queued or running. */
+  unsigned int
+  GetNumberOfPendingWrites() const;
+
+  /** Adds a write to the queue, first waiting while the queue is full. The
+   * returned future becomes ready when the write is done. */
+  WriteFutureType
+  Enqueue(WriteFunctionType write);
+
+  /** Waits until no write is pending, then rethrows the first exception
+   * thrown by a write since the previous Flush(), if any. */
+  void
+  Flush();
+
+protected:
+  AsynchronousWriteQueue() = default;
+  ~AsynchronousWriteQueue() override;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  void
+  ThreadExecute();
+
+  mutable std::mutex                     m_Mutex;
+  std::condition_variable                m_WriteCondition;
+  std::condition_variable                m_DoneCondition;
+  std::deque<std::packaged_task<void()>> m_Writes;
+  std::vector<std::thread>               m_Threads;
+  unsigned int                           m_NumberOfThreads{ 1 };
+  unsigned int                           m_MaximumNumberOfPendingWrites{ 2 };
+  unsigned int                           m_NumberOfPendingWrites{ 0 };
+  std::exception_ptr                     m_FirstException;
+  bool                                   m_Stopping{ false };
+};
+} // end namespace itk
+
+#endif // itkAsynchronousWriteQueue_h
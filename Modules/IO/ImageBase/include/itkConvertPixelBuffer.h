@@ -20,8 +20,10 @@
 #include "ITKIOImageBaseExport.h"
 
 #include "itkObject.h"
+#include "itkDefaultConvertPixelTraits.h"
 #include "itkNumericTraits.h"
 #include "itkEnableIf.h"
+#include <type_traits> // For integral_constant.
 
 namespace itk
 {
@@ -173,6 +175,33 @@ protected:
   template <typename UComponentType>
   static typename EnableIfC<NumericTraits<UComponentType>::IsInteger, UComponentType>::Type
   DefaultAlphaValue();
+
+private:
+  /** Tells whether the conversion is between Float16 and float scalars, which
+   * are converted by the (vectorized) buffer conversions of Float16. */
+  using IsFloat16ConversionType = std::integral_constant<
+    bool,
+    std::is_same<OutputConvertTraits, DefaultConvertPixelTraits<OutputPixelType>>::value &&
+      ((std::is_same<InputPixelType, Float16>::value && std::is_same<OutputPixelType, float>::value) ||
+       (std::is_same<InputPixelType, float>::value && std::is_same<OutputPixelType, Float16>::value))>;
+
+  /** Converts the components one by one, or the whole buffer at once for
+   * Float16. */
+  static void
+  ConvertComponents(InputPixelType * inputData, OutputPixelType * outputData, size_t size, std::false_type);
+  static void
+  ConvertComponents(InputPixelType * inputData, OutputPixelType * outputData, size_t size, std::true_type);
+
+  static void
+  ConvertFloat16Buffer(const Float16 * inputData, float * outputData, size_t size)
+  {
+    Float16::ConvertToFloat(inputData, outputData, size);
+  }
+  static void
+  ConvertFloat16Buffer(const float * inputData, Float16 * outputData, size_t size)
+  {
+    Float16::ConvertFromFloat(inputData, outputData, size);
+  }
 };
 } // namespace itk
 
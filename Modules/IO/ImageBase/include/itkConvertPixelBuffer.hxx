@@ -161,13 +161,7 @@ ConvertPixelBuffer<InputPixelType, OutputPixelType, OutputConvertTraits>::Conver
   OutputPixelType * outputData,
   size_t            size)
 {
-  InputPixelType * endInput = inputData + size;
-
-  while (inputData != endInput)
-  {
-    OutputConvertTraits::SetNthComponent(0, *outputData++, static_cast<OutputComponentType>(*inputData));
-    inputData++;
-  }
+  ConvertComponents(inputData, outputData, size, IsFloat16ConversionType{});
 }
 
 template <typename InputPixelType, typename OutputPixelType, typename OutputConvertTraits>
@@ -591,13 +585,36 @@ ConvertPixelBuffer<InputPixelType, OutputPixelType, OutputConvertTraits>::Conver
 {
   size_t length = size * (size_t)inputNumberOfComponents;
 
-  for (size_t i = 0; i < length; i++)
+  ConvertComponents(inputData, outputData, length, IsFloat16ConversionType{});
+}
+
+template <typename InputPixelType, typename OutputPixelType, typename OutputConvertTraits>
+void
+ConvertPixelBuffer<InputPixelType, OutputPixelType, OutputConvertTraits>::ConvertComponents(
+  InputPixelType *  inputData,
+  OutputPixelType * outputData,
+  size_t            size,
+  std::false_type)
+{
+  InputPixelType * endInput = inputData + size;
+
+  while (inputData != endInput)
   {
-    OutputConvertTraits::SetNthComponent(0, *outputData, static_cast<OutputComponentType>(*inputData));
-    ++outputData;
-    ++inputData;
+    OutputConvertTraits::SetNthComponent(0, *outputData++, static_cast<OutputComponentType>(*inputData));
+    inputData++;
   }
 }
+
+template <typename InputPixelType, typename OutputPixelType, typename OutputConvertTraits>
+void
+ConvertPixelBuffer<InputPixelType, OutputPixelType, OutputConvertTraits>::ConvertComponents(
+  InputPixelType *  inputData,
+  OutputPixelType * outputData,
+  size_t            size,
+  std::true_type)
+{
+  ConvertFloat16Buffer(inputData, outputData, size);
+}
 } // end namespace itk
 
 #endif
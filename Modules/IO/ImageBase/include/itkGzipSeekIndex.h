@@ -0,0 +1,182 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkGzipSeekIndex_h
+#define itkGzipSeekIndex_h
+#include "ITKIOImageBaseExport.h"
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkImageIORegion.h"
+#include "itkIntTypes.h"
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+/** \class GzipSeekIndex
+ * \brief Random access into gzip-compressed data through inflate checkpoints.
+ *
+ * A gzip stream can only be decompressed from its beginning, so reading a
+ * slab near the end of a large .nii.gz file normally decompresses all the
+ * data before it. Build() decompresses the file once and records, about
+ * every CheckpointSpacing uncompressed bytes, the state needed to restart
+ * decompression there: the position in the compressed data and the last
+ * 32 KiB of uncompressed data. Read() then starts decompressing each
+ * requested range from the checkpoint just before it, and decompresses
+ * ranges following different checkpoints in parallel.
+ *
+ * The index can be kept in a sidecar file (IndexFileName) and in an
+ * in-memory cache shared by all instances (UseCache), so that it is built
+ * only once per file. Both are validated against the size, modification
+ * time and gzip trailer of the compressed file. Each checkpoint takes 32 KiB
+ * of memory.
+ *
+ * Concatenated gzip members are supported. The gzip data may start at a
+ * DataOffset within the file, for example after a plain text header.
+ *
+ * \sa NiftiImageIO NrrdImageIO
+ * \ingroup IOFilters
+ * \ingroup ITKIOImageBase
+ */
+class ITKIOImageBase_EXPORT GzipSeekIndex : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(GzipSeekIndex);
+
+  /** Standard class type aliases. */
+  using Self = GzipSeekIndex;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(GzipSeekIndex, Object);
+
+  /** A range of uncompressed data: its offset from the start of the
+   * uncompressed data, and its length, in bytes. */
+  using RangeType = std::pair<SizeValueType, SizeValueType>;
+  using RangeListType = std::vector<RangeType>;
+
+  /** The gzip-compressed file. */
+  itkSetStringMacro(FileName);
+  itkGetStringMacro(FileName);
+
+  /** The offset, in bytes, at which the gzip data starts in the file.
+   * The default is 0. */
+  itkSetMacro(DataOffset, SizeValueType);
+  itkGetConstMacro(DataOffset, SizeValueType);
+
+  /** The approximate distance, in uncompressed bytes, between two
+   * checkpoints of an index built by Build(). The default is 4 MiB. */
+  itkSetMacro(CheckpointSpacing, SizeValueType);
+  itkGetConstMacro(CheckpointSpacing, SizeValueType);
+
+  /** The sidecar file the index is read from and written to. When empty
+   * (the default), the index is not stored on disk. */
+  itkSetStringMacro(IndexFileName);
+  itkGetStringMacro(IndexFileName);
+
+  /** Whether indexes are shared through an in-memory cache, keyed by file
+   * name and data offset. The default is true. */
+  itkSetMacro(UseCache, bool);
+  itkGetConstMacro(UseCache, bool);
+  itkBooleanMacro(UseCache);
+
+  /** Gets a valid index from the cache or from the sidecar file, without
+   * decompressing the file. Returns false if neither has one. */
+  bool
+  Restore();
+
+  /** Gets a valid index like Restore(), or else builds it by decompressing
+   * the file once and stores it in the cache. The index is also written to
+   * the sidecar file, unless that file already exists and holds it. */
+  void
+  Build();
+
+  /** Size of the uncompressed data, in bytes. Zero until the index is
+   * restored or built. */
+  SizeValueType
+  GetUncompressedSize() const;
+
+  /** Number of checkpoints of the index. Zero until the index is restored
+   * or built. */
+  SizeValueType
+  GetNumberOfCheckpoints() const;
+
+  /** Decompresses the given ranges of uncompressed data one after the other
+   * into the buffer. The ranges must be sorted and must not overlap. The
+   * index is built first if needed. */
+  void
+  Read(void * buffer, const RangeListType & ranges);
+
+  /** Computes the ranges of data holding a region of an image, stored pixel
+   * after pixel with its first dimension varying fastest, from the given
+   * offset. Contiguous rows are merged into one range. The dimensions of
+   * the region beyond those of the image must have a size of 1. */
+  static RangeListType
+  ComputeRegionRanges(const ImageIORegion &              region,
+                      const std::vector<SizeValueType> & dimensions,
+                      SizeValueType                      pixelSize,
+                      SizeValueType                      offset = 0);
+
+  /** Removes all indexes from the in-memory cache. */
+  static void
+  ClearCache();
+
+protected:
+  GzipSeekIndex();
+  ~GzipSeekIndex() override;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  struct IndexData;
+  struct IndexCache;
+
+  static IndexCache &
+  GetIndexCache();
+
+  std::string
+  GetCacheKey() const;
+
+  bool
+  IsValid(const IndexData & index) const;
+
+  std::shared_ptr<const IndexData>
+  ScanFile() const;
+
+  std::shared_ptr<const IndexData>
+  ReadIndexFile() const;
+
+  void
+  WriteIndexFile(const IndexData & index) const;
+
+  std::string   m_FileName;
+  SizeValueType m_DataOffset{ 0 };
+  SizeValueType m_CheckpointSpacing{ SizeValueType{ 1 } << 22 };
+  std::string   m_IndexFileName;
+  bool          m_UseCache{ true };
+
+  std::shared_ptr<const IndexData> m_Index;
+};
+} // end namespace itk
+
+#endif // itkGzipSeekIndex_h
@@ -493,6 +493,7 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::DoConvertBuffer(void * inputD
   ITK_CONVERT_BUFFER_IF_BLOCK(IOComponentEnum::LONGLONG, long long)
   ITK_CONVERT_BUFFER_IF_BLOCK(IOComponentEnum::FLOAT, float)
   ITK_CONVERT_BUFFER_IF_BLOCK(IOComponentEnum::DOUBLE, double)
+  ITK_CONVERT_BUFFER_IF_BLOCK(IOComponentEnum::FLOAT16, Float16)
   else
   {
 #define TYPENAME(x) m_ImageIO->GetComponentTypeAsString(ImageIOBase::MapPixelType<x>::CType)
@@ -513,7 +514,8 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::DoConvertBuffer(void * inputD
         << "    " << TYPENAME(unsigned long long) << std::endl
         << "    " << TYPENAME(long long) << std::endl
         << "    " << TYPENAME(float) << std::endl
-        << "    " << TYPENAME(double) << std::endl;
+        << "    " << TYPENAME(double) << std::endl
+        << "    " << TYPENAME(Float16) << std::endl;
     e.SetDescription(msg.str().c_str());
     e.SetLocation(ITK_LOCATION);
     throw e;
@@ -20,6 +20,7 @@
 #include "ITKIOImageBaseExport.h"
 
 #include "itkProcessObject.h"
+#include "itkAsynchronousWriteQueue.h"
 #include "itkImageIOBase.h"
 #include "itkMacro.h"
 
@@ -72,6 +73,10 @@ public:
  * with a suitable suffix (".png", ".jpg", etc) and setting the input
  * to the writer is enough to get the writer to work properly.
  *
+ * WriteAsynchronously() writes the image in the background instead, so
+ * that the pipeline can go on, for example computing the next image, while
+ * the file is encoded and written.
+ *
  * \sa ImageSeriesReader
  * \sa ImageIOBase
  *
@@ -153,6 +158,31 @@ public:
   virtual void
   Write();
 
+  /** Writes the image in the background, on the WriteQueue, and returns a
+   * future that becomes ready when the file is written, and whose get()
+   * rethrows the exception writing it threw, if any. The input is updated
+   * first, at once, and its buffer is copied, or taken with TakeInputBuffer,
+   * so that the pipeline is free to run again when this returns. The file is
+   * written with the settings the writer has at the time of the call, but
+   * without its events and progress. A user-specified ImageIO cannot write
+   * two files at once, so with one, WriteAsynchronously() and Write() first
+   * wait for the previous asynchronous write of this writer. */
+  std::shared_future<void>
+  WriteAsynchronously();
+
+  /** Set/Get the queue that WriteAsynchronously() enqueues the writes on.
+   * When none is set (the default), the global queue is used. \sa
+   * AsynchronousWriteQueue::GetGlobalQueue */
+  itkSetObjectMacro(WriteQueue, AsynchronousWriteQueue);
+  itkGetModifiableObjectMacro(WriteQueue, AsynchronousWriteQueue);
+
+  /** When on, WriteAsynchronously() takes the buffer of the input instead
+   * of copying it, and releases the data of the input, so that the next
+   * update of the pipeline allocates a new buffer. Off by default. */
+  itkSetMacro(TakeInputBuffer, bool);
+  itkGetConstReferenceMacro(TakeInputBuffer, bool);
+  itkBooleanMacro(TakeInputBuffer);
+
   /** Specify the region to write. If left nullptr, then the whole image
    * is written. */
   void
@@ -234,6 +264,10 @@ private:
   bool m_UseCompression{ false };
   int  m_CompressionLevel{ -1 };
   bool m_UseInputMetaDataDictionary{ true };
+
+  AsynchronousWriteQueue::Pointer m_WriteQueue;
+  bool                            m_TakeInputBuffer{ false };
+  std::shared_future<void>        m_PendingWrite;
 };
 } // end namespace itk
 
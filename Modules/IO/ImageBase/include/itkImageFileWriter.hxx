@@ -32,6 +32,7 @@
 #include "itkDiffusionTensor3D.h"
 #include "itkMatrix.h"
 #include "itkImageAlgorithm.h"
+#include <algorithm>
 #include <complex>
 
 namespace itk
@@ -84,6 +85,12 @@ ImageFileWriter<TInputImage>::Write()
 
   itkDebugMacro(<< "Writing an image file");
 
+  // A user-specified ImageIO may still be writing in the background
+  if (m_PendingWrite.valid() && m_ImageIO.IsNotNull() && !m_FactorySpecifiedImageIO)
+  {
+    m_PendingWrite.wait();
+  }
+
   // Make sure input is available
   if (input == nullptr)
   {
@@ -330,6 +337,88 @@ ImageFileWriter<TInputImage>::Write()
   this->ReleaseInputs();
 }
 
+//---------------------------------------------------------
+template <typename TInputImage>
+std::shared_future<void>
+ImageFileWriter<TInputImage>::WriteAsynchronously()
+{
+  const InputImageType * input = this->GetInput();
+
+  itkDebugMacro(<< "Writing an image file asynchronously");
+
+  // Make sure input is available
+  if (input == nullptr)
+  {
+    itkExceptionMacro(<< "No input to writer!");
+  }
+
+  if (m_FileName.empty())
+  {
+    itkExceptionMacro(<< "No filename was specified");
+  }
+
+  // Update the whole input at once, or its region to paste. As in Write(),
+  // the information of an input without a source filter is kept when pasting.
+  auto * nonConstInput = const_cast<InputImageType *>(input);
+  if (!m_UserSpecifiedIORegion || nonConstInput->GetSource())
+  {
+    nonConstInput->UpdateOutputInformation();
+  }
+  InputImageRegionType requestedRegion = input->GetLargestPossibleRegion();
+  if (m_UserSpecifiedIORegion)
+  {
+    ImageIORegionAdaptor<TInputImage::ImageDimension>::Convert(
+      m_PasteIORegion, requestedRegion, input->GetLargestPossibleRegion().GetIndex());
+  }
+  nonConstInput->SetRequestedRegion(requestedRegion);
+  nonConstInput->PropagateRequestedRegion();
+  nonConstInput->UpdateOutputData();
+
+  // Snapshot the input, which the pipeline may overwrite once this returns
+  InputImagePointer snapshot = InputImageType::New();
+  snapshot->Graft(input);
+  snapshot->SetMetaDataDictionary(input->GetMetaDataDictionary());
+  if (m_TakeInputBuffer)
+  {
+    nonConstInput->ReleaseData();
+  }
+  else
+  {
+    using PixelContainerType = typename InputImageType::PixelContainer;
+    const PixelContainerType * pixels = input->GetPixelContainer();
+    auto                       pixelsCopy = PixelContainerType::New();
+    pixelsCopy->Reserve(pixels->Size());
+    std::copy_n(input->GetBufferPointer(), pixels->Size(), pixelsCopy->GetBufferPointer());
+    snapshot->SetPixelContainer(pixelsCopy);
+  }
+
+  // Write the snapshot with another writer, set up like this one
+  auto writer = Self::New();
+  writer->SetInput(snapshot);
+  writer->SetFileName(m_FileName);
+  if (m_ImageIO.IsNotNull() && !m_FactorySpecifiedImageIO)
+  {
+    if (m_PendingWrite.valid())
+    {
+      m_PendingWrite.wait();
+    }
+    writer->SetImageIO(m_ImageIO);
+  }
+  if (m_UserSpecifiedIORegion)
+  {
+    writer->SetIORegion(m_PasteIORegion);
+  }
+  writer->SetNumberOfStreamDivisions(m_NumberOfStreamDivisions);
+  writer->SetUseCompression(m_UseCompression);
+  writer->SetCompressionLevel(m_CompressionLevel);
+  writer->SetUseInputMetaDataDictionary(m_UseInputMetaDataDictionary);
+
+  AsynchronousWriteQueue * queue =
+    m_WriteQueue.IsNotNull() ? m_WriteQueue.GetPointer() : AsynchronousWriteQueue::GetGlobalQueue().GetPointer();
+  m_PendingWrite = queue->Enqueue([writer]() { writer->Write(); });
+  return m_PendingWrite;
+}
+
 //---------------------------------------------------------
 template <typename TInputImage>
 void
@@ -409,6 +498,17 @@ ImageFileWriter<TInputImage>::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "Number of Stream Divisions: " << m_NumberOfStreamDivisions << "\n";
   os << indent << "CompressionLevel: " << m_CompressionLevel << "\n";
 
+  os << indent << "Write Queue: ";
+  if (m_WriteQueue.IsNull())
+  {
+    os << "(none)\n";
+  }
+  else
+  {
+    os << m_WriteQueue << "\n";
+  }
+  os << indent << "TakeInputBuffer: " << (m_TakeInputBuffer ? "On" : "Off") << "\n";
+
   if (m_UseCompression)
   {
     os << indent << "Compression: On\n";
@@ -31,6 +31,7 @@
 #include "itkDiffusionTensor3D.h"
 #include "itkImageRegionSplitterBase.h"
 #include "itkCommonEnums.h"
+#include "itkFloat16.h"
 
 #include "vnl/vnl_vector.h"
 #include "vcl_compiler.h"
@@ -910,6 +911,7 @@ IMAGEIOBASE_TYPEMAP(long long, IOComponentEnum::LONGLONG);
 IMAGEIOBASE_TYPEMAP(unsigned long long, IOComponentEnum::ULONGLONG);
 IMAGEIOBASE_TYPEMAP(float, IOComponentEnum::FLOAT);
 IMAGEIOBASE_TYPEMAP(double, IOComponentEnum::DOUBLE);
+IMAGEIOBASE_TYPEMAP(Float16, IOComponentEnum::FLOAT16);
 #undef IMAGIOBASE_TYPEMAP
 
 } // end namespace itk
@@ -69,6 +69,14 @@ public:
  * the type of file is determined by either the file extension or an
  * ImageIO class if specified.
  *
+ * Unless an ImageIO is specified, each file is written by its own
+ * ImageFileWriter and ImageIO, and the files are encoded and written
+ * concurrently by NumberOfWorkUnits threads while the next slices are
+ * copied. At most NumberOfWorkUnits slices wait to be written at a time.
+ * A specified ImageIO, and the MetaDataDictionary set on it for each slice,
+ * are shared by all the files, which are then written one after the other,
+ * as they are when NumberOfWorkUnits is 1.
+ *
  * \sa ImageFileWriter
  * \sa ImageIOBase
  * \sa ImageSeriesReader
@@ -19,6 +19,7 @@
 #define itkImageSeriesWriter_hxx
 
 #include "itkImageSeriesWriter.h"
+#include "itkAsynchronousWriteQueue.h"
 #include "itkDataObject.h"
 #include "itkImageIOFactory.h"
 #include "itkIOCommon.h"
@@ -28,6 +29,7 @@
 #include "itkArray.h"
 #include "vnl/algo/vnl_determinant.h"
 #include <cstdio>
+#include <deque>
 
 namespace itk
 {
@@ -186,12 +188,6 @@ ImageSeriesWriter<TInputImage, TOutputImage>::WriteFiles()
     outRegion.SetSize(i, inputImage->GetRequestedRegion().GetSize()[i]);
   }
 
-  // Allocate an image for output and create an iterator for it
-  typename OutputImageType::Pointer outputImage = OutputImageType::New();
-  outputImage->SetRegions(outRegion);
-  outputImage->SetNumberOfComponentsPerPixel(inputImage->GetNumberOfComponentsPerPixel());
-  outputImage->Allocate();
-
   // Set the origin and spacing of the output
   double                               spacing[TOutputImage::ImageDimension];
   double                               origin[TOutputImage::ImageDimension];
@@ -219,14 +215,10 @@ ImageSeriesWriter<TInputImage, TOutputImage>::WriteFiles()
     direction.SetIdentity();
   }
 
-  outputImage->SetOrigin(origin);
-  outputImage->SetSpacing(spacing);
-  outputImage->SetDirection(direction);
-
   Index<TInputImage::ImageDimension> inIndex;
   Size<TInputImage::ImageDimension>  inSize;
 
-  SizeValueType pixelsPerFile = outputImage->GetRequestedRegion().GetNumberOfPixels();
+  SizeValueType pixelsPerFile = outRegion.GetNumberOfPixels();
 
   inSize.Fill(1);
   for (unsigned int ns = 0; ns < TOutputImage::ImageDimension; ns++)
@@ -251,6 +243,20 @@ ImageSeriesWriter<TInputImage, TOutputImage>::WriteFiles()
 
   ProgressReporter progress(this, 0, expectedNumberOfFiles, expectedNumberOfFiles);
 
+  // Without a user-specified ImageIO, each file gets its own writer and
+  // ImageIO, so the files are encoded and written by NumberOfWorkUnits
+  // threads, while this thread copies the next slices. The number of slices
+  // waiting to be written is bounded, and so is the memory they take.
+  const unsigned int              numberOfThreads = m_ImageIO.IsNotNull() ? 1 : this->GetNumberOfWorkUnits();
+  AsynchronousWriteQueue::Pointer queue;
+  if (numberOfThreads > 1 && expectedNumberOfFiles > 1)
+  {
+    queue = AsynchronousWriteQueue::New();
+    queue->SetNumberOfThreads(numberOfThreads);
+    queue->SetMaximumNumberOfPendingWrites(numberOfThreads);
+  }
+  std::deque<AsynchronousWriteQueue::WriteFutureType> futures;
+
   // For each "slice" in the input, copy the region to the output,
   // build a filename and write the file.
 
@@ -262,7 +268,14 @@ ImageSeriesWriter<TInputImage, TOutputImage>::WriteFiles()
     inRegion.SetIndex(inIndex);
     inRegion.SetSize(inSize);
 
-    // Copy the selected "slice" into the output image.
+    // Copy the selected "slice" into a new output image.
+    typename OutputImageType::Pointer outputImage = OutputImageType::New();
+    outputImage->SetRegions(outRegion);
+    outputImage->SetNumberOfComponentsPerPixel(inputImage->GetNumberOfComponentsPerPixel());
+    outputImage->Allocate();
+    outputImage->SetOrigin(origin);
+    outputImage->SetSpacing(spacing);
+    outputImage->SetDirection(direction);
     ImageAlgorithm::Copy(inputImage, outputImage.GetPointer(), inRegion, outRegion);
 
     typename WriterType::Pointer writer = WriterType::New();
@@ -340,11 +353,31 @@ ImageSeriesWriter<TInputImage, TOutputImage>::WriteFiles()
 
     writer->SetFileName(m_FileNames[slice].c_str());
     writer->SetUseCompression(m_UseCompression);
-    writer->Update();
+    if (queue.IsNotNull())
+    {
+      // the writer holds the slice until it is written
+      futures.push_back(queue->Enqueue([writer] { writer->Update(); }));
+      if (futures.size() > numberOfThreads)
+      {
+        futures.front().get();
+        futures.pop_front();
+        progress.CompletedPixel();
+      }
+    }
+    else
+    {
+      writer->Update();
+      progress.CompletedPixel();
+    }
 
-    progress.CompletedPixel();
     offset += pixelsPerFile;
   }
+
+  for (auto & future : futures)
+  {
+    future.get();
+    progress.CompletedPixel();
+  }
 }
 
 //---------------------------------------------------------
@@ -11,6 +11,8 @@ itk_module(ITKIOImageBase
   ENABLE_SHARED
   DEPENDS
     ITKCommon
+  PRIVATE_DEPENDS
+    ITKZLIB
   TEST_DEPENDS
     ITKTestKernel
     ITKIOGDCM
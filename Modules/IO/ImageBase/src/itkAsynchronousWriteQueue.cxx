@@ -0,0 +1,179 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAsynchronousWriteQueue.h"
+
+#include <algorithm>
+
+namespace itk
+{
+
+AsynchronousWriteQueue::~AsynchronousWriteQueue()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stopping = true;
+  }
+  m_WriteCondition.notify_all();
+  for (auto & thread : m_Threads)
+  {
+    thread.join();
+  }
+}
+
+AsynchronousWriteQueue::Pointer
+AsynchronousWriteQueue::GetGlobalQueue()
+{
+  static Pointer globalQueue = Self::New();
+  return globalQueue;
+}
+
+void
+AsynchronousWriteQueue::SetNumberOfThreads(unsigned int numberOfThreads)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_NumberOfThreads = std::max(numberOfThreads, 1u);
+  }
+  this->Modified();
+}
+
+unsigned int
+AsynchronousWriteQueue::GetNumberOfThreads() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfThreads;
+}
+
+void
+AsynchronousWriteQueue::SetMaximumNumberOfPendingWrites(unsigned int maximumNumberOfPendingWrites)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_MaximumNumberOfPendingWrites = std::max(maximumNumberOfPendingWrites, 1u);
+  }
+  // a larger maximum may let waiting writes in
+  m_DoneCondition.notify_all();
+  this->Modified();
+}
+
+unsigned int
+AsynchronousWriteQueue::GetMaximumNumberOfPendingWrites() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MaximumNumberOfPendingWrites;
+}
+
+unsigned int
+AsynchronousWriteQueue::GetNumberOfPendingWrites() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfPendingWrites;
+}
+
+AsynchronousWriteQueue::WriteFutureType
+AsynchronousWriteQueue::Enqueue(WriteFunctionType write)
+{
+  // the first exception is kept for Flush(), and all are kept in the futures
+  std::packaged_task<void()> task([this, write]() {
+    try
+    {
+      write();
+    }
+    catch (...)
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (!m_FirstException)
+        {
+          m_FirstException = std::current_exception();
+        }
+      }
+      throw;
+    }
+  });
+  WriteFutureType future = task.get_future().share();
+
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_DoneCondition.wait(lock, [this] { return m_NumberOfPendingWrites < m_MaximumNumberOfPendingWrites; });
+    m_Writes.push_back(std::move(task));
+    ++m_NumberOfPendingWrites;
+    if (m_Threads.size() < m_NumberOfThreads && m_Threads.size() < m_NumberOfPendingWrites)
+    {
+      m_Threads.emplace_back(&Self::ThreadExecute, this);
+    }
+  }
+  m_WriteCondition.notify_one();
+  return future;
+}
+
+void
+AsynchronousWriteQueue::Flush()
+{
+  std::exception_ptr exception;
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_DoneCondition.wait(lock, [this] { return m_NumberOfPendingWrites == 0; });
+    std::swap(exception, m_FirstException);
+  }
+  if (exception)
+  {
+    std::rethrow_exception(exception);
+  }
+}
+
+void
+AsynchronousWriteQueue::ThreadExecute()
+{
+  for (;;)
+  {
+    std::packaged_task<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_WriteCondition.wait(lock, [this] { return m_Stopping || !m_Writes.empty(); });
+      if (m_Writes.empty())
+      {
+        // stopping, and all the writes are done
+        return;
+      }
+      task = std::move(m_Writes.front());
+      m_Writes.pop_front();
+    }
+
+    // the exception of the write, if any, is stored in its future
+    task();
+
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      --m_NumberOfPendingWrites;
+    }
+    m_DoneCondition.notify_all();
+  }
+}
+
+void
+AsynchronousWriteQueue::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfThreads: " << this->GetNumberOfThreads() << std::endl;
+  os << indent << "MaximumNumberOfPendingWrites: " << this->GetMaximumNumberOfPendingWrites() << std::endl;
+  os << indent << "NumberOfPendingWrites: " << this->GetNumberOfPendingWrites() << std::endl;
+}
+
+} // end namespace itk
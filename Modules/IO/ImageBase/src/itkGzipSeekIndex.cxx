@@ -0,0 +1,693 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGzipSeekIndex.h"
+#include "itkByteSwapper.h"
+#include "itkMultiThreaderBase.h"
+#include "itk_zlib.h"
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+namespace itk
+{
+
+namespace
+{
+// Deflate back-references reach at most 32 KiB behind, so that much
+// uncompressed data is enough to restart decompression anywhere.
+constexpr unsigned int WindowSize = 32768;
+constexpr unsigned int InputBufferSize = 65536;
+
+// Largest number of bytes handed to a single inflate() call.
+constexpr SizeValueType MaximumChunkSize = SizeValueType{ 1 } << 30;
+
+const char         IndexFileMagic[8] = { 'I', 'T', 'K', 'G', 'Z', 'I', 'D', 'X' };
+constexpr uint64_t IndexFileVersion = 1;
+
+// Feeds a z_stream with the compressed data of a file, keeping track of
+// the file position of the next compressed byte.
+class CompressedInput
+{
+public:
+  bool
+  Open(const std::string & fileName, SizeValueType position)
+  {
+    m_File.open(fileName.c_str(), std::ios::in | std::ios::binary);
+    m_File.seekg(static_cast<std::streamoff>(position));
+    m_Position = position;
+    return m_File.good();
+  }
+
+  /** Makes at least count bytes available to the stream, unless the end of
+   * the file is reached first. */
+  bool
+  Fill(z_stream & stream, unsigned int count = 1)
+  {
+    if (stream.avail_in >= count)
+    {
+      return true;
+    }
+    if (stream.avail_in > 0)
+    {
+      std::memmove(m_Buffer.data(), stream.next_in, stream.avail_in);
+    }
+    stream.next_in = m_Buffer.data();
+    if (m_File)
+    {
+      m_File.read(reinterpret_cast<char *>(m_Buffer.data() + stream.avail_in), InputBufferSize - stream.avail_in);
+      const auto numberOfBytesRead = static_cast<unsigned int>(m_File.gcount());
+      stream.avail_in += numberOfBytesRead;
+      m_Position += numberOfBytesRead;
+    }
+    return stream.avail_in >= count;
+  }
+
+  SizeValueType
+  GetPosition(const z_stream & stream) const
+  {
+    return m_Position - stream.avail_in;
+  }
+
+private:
+  std::ifstream              m_File;
+  std::vector<unsigned char> m_Buffer = std::vector<unsigned char>(InputBufferSize);
+  SizeValueType              m_Position{ 0 };
+};
+
+// Calls inflateEnd on an initialized z_stream when going out of scope.
+class InflateStream
+{
+public:
+  InflateStream() { std::memset(&m_Stream, 0, sizeof(m_Stream)); }
+  ~InflateStream()
+  {
+    if (m_Initialized)
+    {
+      inflateEnd(&m_Stream);
+    }
+  }
+  ITK_DISALLOW_COPY_AND_ASSIGN(InflateStream);
+
+  bool
+  Initialize(int windowBits)
+  {
+    m_Initialized = (inflateInit2(&m_Stream, windowBits) == Z_OK);
+    return m_Initialized;
+  }
+
+  z_stream &
+  Get()
+  {
+    return m_Stream;
+  }
+
+private:
+  z_stream m_Stream;
+  bool     m_Initialized{ false };
+};
+
+// Called when inflate() reaches the end of a deflate stream: prepares the
+// stream for the next member of a multi-member gzip file. Returns false if
+// there is no next member. A raw inflate stream does not read the trailer
+// of the member, so it is skipped here.
+bool
+StartNextMember(z_stream & stream, CompressedInput & input, bool raw)
+{
+  if (raw)
+  {
+    if (!input.Fill(stream, 8))
+    {
+      return false;
+    }
+    stream.next_in += 8;
+    stream.avail_in -= 8;
+  }
+  if (!input.Fill(stream, 2) || stream.next_in[0] != 0x1f || stream.next_in[1] != 0x8b)
+  {
+    return false;
+  }
+  return inflateReset2(&stream, 15 + 16) == Z_OK;
+}
+
+// Decompresses exactly count bytes.
+bool
+Inflate(z_stream & stream, CompressedInput & input, bool & raw, unsigned char * buffer, SizeValueType count)
+{
+  while (count > 0)
+  {
+    const auto chunkSize = static_cast<uInt>(std::min(count, MaximumChunkSize));
+    stream.next_out = buffer;
+    stream.avail_out = chunkSize;
+    while (stream.avail_out > 0)
+    {
+      input.Fill(stream);
+      const int ret = inflate(&stream, Z_NO_FLUSH);
+      if (ret == Z_STREAM_END && stream.avail_out > 0)
+      {
+        if (!StartNextMember(stream, input, raw))
+        {
+          return false;
+        }
+        raw = false;
+      }
+      else if (ret != Z_OK && ret != Z_STREAM_END)
+      {
+        return false;
+      }
+    }
+    buffer += chunkSize;
+    count -= chunkSize;
+  }
+  return true;
+}
+
+// Reads the last 8 bytes of a gzip file, which hold the CRC-32 and size of
+// the uncompressed data of its last member.
+uint64_t
+ReadFileTail(const std::string & fileName, SizeValueType fileSize)
+{
+  uint64_t      tail = 0;
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (fileSize >= sizeof(tail) && file.seekg(static_cast<std::streamoff>(fileSize - sizeof(tail))))
+  {
+    file.read(reinterpret_cast<char *>(&tail), sizeof(tail));
+  }
+  return tail;
+}
+
+void
+WriteValue(std::ostream & stream, uint64_t value)
+{
+  ByteSwapper<uint64_t>::SwapFromSystemToLittleEndian(&value);
+  stream.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+uint64_t
+ReadValue(std::istream & stream)
+{
+  uint64_t value = 0;
+  stream.read(reinterpret_cast<char *>(&value), sizeof(value));
+  ByteSwapper<uint64_t>::SwapFromSystemToLittleEndian(&value);
+  return value;
+}
+} // namespace
+
+struct GzipSeekIndex::IndexData
+{
+  /** A point where decompression can restart: a deflate block boundary,
+   * which may fall within a byte of the compressed data. */
+  struct Checkpoint
+  {
+    /** File position of the first whole compressed byte after the boundary. */
+    SizeValueType CompressedOffset;
+    /** Number of bits of the byte before CompressedOffset that follow the
+     * boundary. */
+    int Bits;
+    /** Offset of the boundary in the uncompressed data. */
+    SizeValueType UncompressedOffset;
+    /** The WindowSize bytes of uncompressed data before the boundary. */
+    std::vector<unsigned char> Window;
+  };
+
+  SizeValueType           DataOffset{ 0 };
+  SizeValueType           FileSize{ 0 };
+  long                    ModifiedTime{ 0 };
+  uint64_t                FileTail{ 0 };
+  SizeValueType           UncompressedSize{ 0 };
+  std::vector<Checkpoint> Checkpoints;
+};
+
+
+struct GzipSeekIndex::IndexCache
+{
+  std::mutex                                              Mutex;
+  std::map<std::string, std::shared_ptr<const IndexData>> Indexes;
+};
+
+GzipSeekIndex::GzipSeekIndex() = default;
+
+GzipSeekIndex::~GzipSeekIndex() = default;
+
+GzipSeekIndex::IndexCache &
+GzipSeekIndex::GetIndexCache()
+{
+  static IndexCache cache;
+  return cache;
+}
+
+void
+GzipSeekIndex::ClearCache()
+{
+  IndexCache &                cache = GetIndexCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  cache.Indexes.clear();
+}
+
+GzipSeekIndex::RangeListType
+GzipSeekIndex::ComputeRegionRanges(const ImageIORegion &              region,
+                                   const std::vector<SizeValueType> & dimensions,
+                                   SizeValueType                      pixelSize,
+                                   SizeValueType                      offset)
+{
+  const size_t        dimension = std::min<size_t>(region.GetImageDimension(), dimensions.size());
+  const SizeValueType rowLength = ((dimension > 0) ? region.GetSize(0) : 1) * pixelSize;
+
+  RangeListType              ranges;
+  std::vector<SizeValueType> rowIndex(dimension, 0);
+  for (;;)
+  {
+    SizeValueType rowOffset = offset;
+    SizeValueType stride = pixelSize;
+    for (size_t d = 0; d < dimension; ++d)
+    {
+      rowOffset += (region.GetIndex(d) + rowIndex[d]) * stride;
+      stride *= dimensions[d];
+    }
+    if (!ranges.empty() && ranges.back().first + ranges.back().second == rowOffset)
+    {
+      ranges.back().second += rowLength;
+    }
+    else
+    {
+      ranges.emplace_back(rowOffset, rowLength);
+    }
+
+    size_t d = 1;
+    for (; d < dimension && ++rowIndex[d] == region.GetSize(d); ++d)
+    {
+      rowIndex[d] = 0;
+    }
+    if (d >= dimension)
+    {
+      return ranges;
+    }
+  }
+}
+
+std::string
+GzipSeekIndex::GetCacheKey() const
+{
+  std::ostringstream key;
+  key << m_FileName << '\n' << m_DataOffset;
+  return key.str();
+}
+
+bool
+GzipSeekIndex::IsValid(const IndexData & index) const
+{
+  // The modification time alone may not tell apart files written within
+  // the same second.
+  const SizeValueType fileSize = itksys::SystemTools::FileLength(m_FileName);
+  return index.DataOffset == m_DataOffset && index.FileSize == fileSize &&
+         index.ModifiedTime == itksys::SystemTools::ModifiedTime(m_FileName) &&
+         index.FileTail == ReadFileTail(m_FileName, fileSize);
+}
+
+bool
+GzipSeekIndex::Restore()
+{
+  if (m_FileName.empty())
+  {
+    itkExceptionMacro(<< "A FileName must be specified.");
+  }
+  if (m_Index && this->IsValid(*m_Index))
+  {
+    return true;
+  }
+  m_Index = nullptr;
+
+  if (m_UseCache)
+  {
+    IndexCache &                cache = GetIndexCache();
+    std::lock_guard<std::mutex> lock(cache.Mutex);
+    const auto                  it = cache.Indexes.find(this->GetCacheKey());
+    if (it != cache.Indexes.end())
+    {
+      if (this->IsValid(*it->second))
+      {
+        m_Index = it->second;
+        return true;
+      }
+      cache.Indexes.erase(it);
+    }
+  }
+
+  if (!m_IndexFileName.empty())
+  {
+    const auto index = this->ReadIndexFile();
+    if (index && this->IsValid(*index))
+    {
+      m_Index = index;
+      if (m_UseCache)
+      {
+        IndexCache &                cache = GetIndexCache();
+        std::lock_guard<std::mutex> lock(cache.Mutex);
+        cache.Indexes[this->GetCacheKey()] = m_Index;
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+GzipSeekIndex::Build()
+{
+  if (this->Restore())
+  {
+    // an index from the cache may not have been stored on disk yet
+    if (!m_IndexFileName.empty() && !itksys::SystemTools::FileExists(m_IndexFileName))
+    {
+      this->WriteIndexFile(*m_Index);
+    }
+    return;
+  }
+
+  m_Index = this->ScanFile();
+  if (m_UseCache)
+  {
+    IndexCache &                cache = GetIndexCache();
+    std::lock_guard<std::mutex> lock(cache.Mutex);
+    cache.Indexes[this->GetCacheKey()] = m_Index;
+  }
+  if (!m_IndexFileName.empty())
+  {
+    this->WriteIndexFile(*m_Index);
+  }
+}
+
+SizeValueType
+GzipSeekIndex::GetUncompressedSize() const
+{
+  return m_Index ? m_Index->UncompressedSize : 0;
+}
+
+SizeValueType
+GzipSeekIndex::GetNumberOfCheckpoints() const
+{
+  return m_Index ? m_Index->Checkpoints.size() : 0;
+}
+
+std::shared_ptr<const GzipSeekIndex::IndexData>
+GzipSeekIndex::ScanFile() const
+{
+  const auto index = std::make_shared<IndexData>();
+  index->DataOffset = m_DataOffset;
+  index->FileSize = itksys::SystemTools::FileLength(m_FileName);
+  index->ModifiedTime = itksys::SystemTools::ModifiedTime(m_FileName);
+  index->FileTail = ReadFileTail(m_FileName, index->FileSize);
+
+  CompressedInput input;
+  InflateStream   inflateStream;
+  z_stream &      stream = inflateStream.Get();
+  if (!input.Open(m_FileName, m_DataOffset) || !inflateStream.Initialize(15 + 16))
+  {
+    itkExceptionMacro(<< "Cannot open " << m_FileName << " for reading.");
+  }
+
+  // Decompress the whole file into a circular window, stopping at each block
+  // boundary to consider adding a checkpoint there. The first checkpoint is
+  // right after the gzip header. None is added after the last block.
+  std::vector<unsigned char> window(WindowSize);
+  SizeValueType              totalOut = 0;
+  SizeValueType              lastCheckpoint = 0;
+  stream.avail_out = 0;
+  for (;;)
+  {
+    input.Fill(stream);
+    if (stream.avail_out == 0)
+    {
+      stream.next_out = window.data();
+      stream.avail_out = WindowSize;
+    }
+    const uInt availableOut = stream.avail_out;
+    const int  ret = inflate(&stream, Z_BLOCK);
+    totalOut += availableOut - stream.avail_out;
+    if (ret == Z_STREAM_END)
+    {
+      if (!StartNextMember(stream, input, false))
+      {
+        break;
+      }
+      continue;
+    }
+    if (ret != Z_OK)
+    {
+      itkExceptionMacro(<< "Cannot decompress " << m_FileName << ": "
+                        << (ret == Z_BUF_ERROR ? "unexpected end of file" : "invalid gzip data"));
+    }
+    if ((stream.data_type & 128) && !(stream.data_type & 64) &&
+        (totalOut == 0 || totalOut - lastCheckpoint > m_CheckpointSpacing))
+    {
+      IndexData::Checkpoint checkpoint;
+      checkpoint.CompressedOffset = input.GetPosition(stream);
+      checkpoint.Bits = stream.data_type & 7;
+      checkpoint.UncompressedOffset = totalOut;
+      checkpoint.Window.resize(WindowSize);
+      const unsigned int oldest = stream.avail_out;
+      std::copy(window.begin() + (WindowSize - oldest), window.end(), checkpoint.Window.begin());
+      std::copy(window.begin(), window.begin() + (WindowSize - oldest), checkpoint.Window.begin() + oldest);
+      index->Checkpoints.push_back(std::move(checkpoint));
+      lastCheckpoint = totalOut;
+    }
+  }
+  index->UncompressedSize = totalOut;
+  return index;
+}
+
+std::shared_ptr<const GzipSeekIndex::IndexData>
+GzipSeekIndex::ReadIndexFile() const
+{
+  std::ifstream file(m_IndexFileName.c_str(), std::ios::in | std::ios::binary);
+  char          magic[sizeof(IndexFileMagic)];
+  if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, IndexFileMagic, sizeof(magic)) != 0 ||
+      ReadValue(file) != IndexFileVersion)
+  {
+    return nullptr;
+  }
+
+  const auto index = std::make_shared<IndexData>();
+  index->DataOffset = ReadValue(file);
+  index->FileSize = ReadValue(file);
+  index->ModifiedTime = static_cast<long>(ReadValue(file));
+  index->FileTail = ReadValue(file);
+  index->UncompressedSize = ReadValue(file);
+  const uint64_t numberOfCheckpoints = ReadValue(file);
+  if (!file || numberOfCheckpoints == 0)
+  {
+    return nullptr;
+  }
+  std::vector<unsigned char> compressedWindow;
+  for (uint64_t i = 0; i < numberOfCheckpoints; ++i)
+  {
+    IndexData::Checkpoint checkpoint;
+    checkpoint.CompressedOffset = ReadValue(file);
+    checkpoint.Bits = static_cast<int>(ReadValue(file));
+    checkpoint.UncompressedOffset = ReadValue(file);
+    const uint64_t compressedWindowSize = ReadValue(file);
+    if (!file || compressedWindowSize > compressBound(WindowSize))
+    {
+      return nullptr;
+    }
+    compressedWindow.resize(compressedWindowSize);
+    checkpoint.Window.resize(WindowSize);
+    uLongf windowSize = WindowSize;
+    if (!file.read(reinterpret_cast<char *>(compressedWindow.data()), compressedWindowSize) ||
+        uncompress(checkpoint.Window.data(), &windowSize, compressedWindow.data(), compressedWindowSize) != Z_OK ||
+        windowSize != WindowSize)
+    {
+      return nullptr;
+    }
+    index->Checkpoints.push_back(std::move(checkpoint));
+  }
+  return index;
+}
+
+void
+GzipSeekIndex::WriteIndexFile(const IndexData & index) const
+{
+  std::ofstream file(m_IndexFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file)
+  {
+    itkExceptionMacro(<< "Cannot open " << m_IndexFileName << " for writing.");
+  }
+
+  file.write(IndexFileMagic, sizeof(IndexFileMagic));
+  WriteValue(file, IndexFileVersion);
+  WriteValue(file, index.DataOffset);
+  WriteValue(file, index.FileSize);
+  WriteValue(file, static_cast<uint64_t>(index.ModifiedTime));
+  WriteValue(file, index.FileTail);
+  WriteValue(file, index.UncompressedSize);
+  WriteValue(file, index.Checkpoints.size());
+
+  // The windows are stored compressed, as they often are compressible.
+  std::vector<unsigned char> compressedWindow(compressBound(WindowSize));
+  for (const auto & checkpoint : index.Checkpoints)
+  {
+    uLongf compressedWindowSize = compressedWindow.size();
+    if (compress2(compressedWindow.data(), &compressedWindowSize, checkpoint.Window.data(), WindowSize, 1) != Z_OK)
+    {
+      itkExceptionMacro(<< "Cannot compress the index of " << m_FileName);
+    }
+    WriteValue(file, checkpoint.CompressedOffset);
+    WriteValue(file, static_cast<uint64_t>(checkpoint.Bits));
+    WriteValue(file, checkpoint.UncompressedOffset);
+    WriteValue(file, compressedWindowSize);
+    file.write(reinterpret_cast<const char *>(compressedWindow.data()), compressedWindowSize);
+  }
+  if (!file)
+  {
+    itkExceptionMacro(<< "Cannot write the index file " << m_IndexFileName);
+  }
+}
+
+void
+GzipSeekIndex::Read(void * buffer, const RangeListType & ranges)
+{
+  this->Build();
+  const auto & checkpoints = m_Index->Checkpoints;
+
+  // Split the ranges at checkpoints, and group the pieces by the checkpoint
+  // decompression restarts from.
+  struct Piece
+  {
+    SizeValueType Offset;
+    SizeValueType Length;
+    SizeValueType BufferOffset;
+  };
+  std::vector<std::pair<SizeValueType, std::vector<Piece>>> tasks;
+  SizeValueType                                             bufferOffset = 0;
+  SizeValueType                                             previousEnd = 0;
+  for (const auto & range : ranges)
+  {
+    if (range.first < previousEnd || range.first + range.second > m_Index->UncompressedSize)
+    {
+      itkExceptionMacro(<< "Invalid range [" << range.first << ", " << range.first + range.second << ") of "
+                        << m_FileName << ", which has " << m_Index->UncompressedSize << " uncompressed bytes.");
+    }
+    SizeValueType       offset = range.first;
+    const SizeValueType end = range.first + range.second;
+    while (offset < end)
+    {
+      const auto next = std::upper_bound(checkpoints.begin(),
+                                         checkpoints.end(),
+                                         offset,
+                                         [](SizeValueType value, const IndexData::Checkpoint & checkpoint) {
+                                           return value < checkpoint.UncompressedOffset;
+                                         });
+      const SizeValueType checkpoint = (next - checkpoints.begin()) - 1;
+      const SizeValueType pieceEnd = (next == checkpoints.end()) ? end : std::min(end, next->UncompressedOffset);
+      if (tasks.empty() || tasks.back().first != checkpoint)
+      {
+        tasks.emplace_back(checkpoint, std::vector<Piece>());
+      }
+      tasks.back().second.push_back(Piece{ offset, pieceEnd - offset, bufferOffset });
+      bufferOffset += pieceEnd - offset;
+      offset = pieceEnd;
+    }
+    previousEnd = end;
+  }
+
+  const auto        output = static_cast<unsigned char *>(buffer);
+  std::atomic<bool> decompressed(true);
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    tasks.size(),
+    [&](SizeValueType task) {
+      if (!decompressed)
+      {
+        return;
+      }
+      const IndexData::Checkpoint & checkpoint = checkpoints[tasks[task].first];
+
+      // Restart raw decompression at the block boundary, with the bits of
+      // the boundary byte that follow it and the window preceding it.
+      CompressedInput input;
+      InflateStream   inflateStream;
+      z_stream &      stream = inflateStream.Get();
+      bool            raw = true;
+      if (!input.Open(m_FileName, checkpoint.CompressedOffset - (checkpoint.Bits ? 1 : 0)) ||
+          !inflateStream.Initialize(-15))
+      {
+        decompressed = false;
+        return;
+      }
+      if (checkpoint.Bits)
+      {
+        if (!input.Fill(stream))
+        {
+          decompressed = false;
+          return;
+        }
+        const int boundaryByte = *stream.next_in++;
+        --stream.avail_in;
+        inflatePrime(&stream, checkpoint.Bits, boundaryByte >> (8 - checkpoint.Bits));
+      }
+      inflateSetDictionary(&stream, checkpoint.Window.data(), WindowSize);
+
+      std::vector<unsigned char> skipped(WindowSize);
+      SizeValueType              offset = checkpoint.UncompressedOffset;
+      for (const auto & piece : tasks[task].second)
+      {
+        while (offset < piece.Offset)
+        {
+          const SizeValueType length = std::min<SizeValueType>(piece.Offset - offset, WindowSize);
+          if (!Inflate(stream, input, raw, skipped.data(), length))
+          {
+            decompressed = false;
+            return;
+          }
+          offset += length;
+        }
+        if (!Inflate(stream, input, raw, output + piece.BufferOffset, piece.Length))
+        {
+          decompressed = false;
+          return;
+        }
+        offset += piece.Length;
+      }
+    },
+    nullptr);
+  if (!decompressed)
+  {
+    itkExceptionMacro(<< "Cannot decompress " << m_FileName);
+  }
+}
+
+void
+GzipSeekIndex::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "FileName: " << m_FileName << std::endl;
+  os << indent << "DataOffset: " << m_DataOffset << std::endl;
+  os << indent << "CheckpointSpacing: " << m_CheckpointSpacing << std::endl;
+  os << indent << "IndexFileName: " << m_IndexFileName << std::endl;
+  os << indent << "UseCache: " << m_UseCache << std::endl;
+  os << indent << "NumberOfCheckpoints: " << this->GetNumberOfCheckpoints() << std::endl;
+  os << indent << "UncompressedSize: " << this->GetUncompressedSize() << std::endl;
+}
+
+} // end namespace itk
@@ -199,6 +199,8 @@ ImageIOBase::GetComponentTypeInfo() const
       return typeid(float);
     case IOComponentEnum::DOUBLE:
       return typeid(double);
+    case IOComponentEnum::FLOAT16:
+      return typeid(Float16);
     case IOComponentEnum::UNKNOWNCOMPONENTTYPE:
     default:
       itkExceptionMacro("Unknown component type: " << m_ComponentType);
@@ -394,6 +396,8 @@ ImageIOBase::GetComponentSize() const
       return sizeof(float);
     case IOComponentEnum::DOUBLE:
       return sizeof(double);
+    case IOComponentEnum::FLOAT16:
+      return sizeof(Float16);
     case IOComponentEnum::UNKNOWNCOMPONENTTYPE:
     default:
       itkExceptionMacro("Unknown component type: " << m_ComponentType);
@@ -460,6 +464,8 @@ ImageIOBase::GetComponentTypeAsString(IOComponentEnum t)
       return std::string("float");
     case IOComponentEnum::DOUBLE:
       return std::string("double");
+    case IOComponentEnum::FLOAT16:
+      return std::string("float16");
     case IOComponentEnum::UNKNOWNCOMPONENTTYPE:
       return std::string("unknown");
     default:
@@ -518,6 +524,10 @@ ImageIOBase::GetComponentTypeFromString(const std::string & typeString)
   {
     return IOComponentEnum::DOUBLE;
   }
+  else if (typeString.compare("float16") == 0)
+  {
+    return IOComponentEnum::FLOAT16;
+  }
   else
   {
     return IOComponentEnum::UNKNOWNCOMPONENTTYPE;
@@ -821,6 +831,14 @@ ImageIOBase::WriteBufferAsASCII(std::ostream &        os,
     }
     break;
 
+    case IOComponentEnum::FLOAT16:
+    {
+      using Type = const Float16 *;
+      auto buf = static_cast<Type>(buffer);
+      WriteBuffer(os, buf, numComp);
+    }
+    break;
+
     default:
       break;
   }
@@ -930,6 +948,13 @@ ImageIOBase::ReadBufferAsASCII(std::istream & is, void * buffer, IOComponentEnum
     }
     break;
 
+    case IOComponentEnum::FLOAT16:
+    {
+      auto * buf = static_cast<Float16 *>(buffer);
+      ReadBuffer(is, buf, numComp);
+    }
+    break;
+
     default:
       break;
   }
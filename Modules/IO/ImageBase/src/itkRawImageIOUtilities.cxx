@@ -130,6 +130,11 @@ WriteRawBytesAfterSwapping(IOComponentEnum componentType,
   {
     _WriteRawBytesAfterSwappingUtility<double>(buffer, file, byteOrder, numberOfBytes, numberOfComponents);
   }
+  else if (componentType == IOComponentEnum::FLOAT16)
+  {
+    // The bytes of a Float16 are swapped like the ones of an unsigned short.
+    _WriteRawBytesAfterSwappingUtility<unsigned short>(buffer, file, byteOrder, numberOfBytes, numberOfComponents);
+  }
 }
 
 void
@@ -187,5 +192,9 @@ ReadRawBytesAfterSwapping(IOComponentEnum componentType,
   {
     _ReadRawBytesAfterSwappingUtility<double>(buffer, byteOrder, numberOfComponents);
   }
+  else if (componentType == IOComponentEnum::FLOAT16)
+  {
+    _ReadRawBytesAfterSwappingUtility<unsigned short>(buffer, byteOrder, numberOfComponents);
+  }
 }
 } // namespace itk
@@ -0,0 +1,170 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAsynchronousWriteQueue.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMetaImageIO.h"
+#include "itkTestingMacros.h"
+
+// Writes images in the background while the next ones are computed into the
+// same buffer, and checks the files, the release of the input buffer when it
+// is taken, and that errors reach the futures and Flush().
+namespace
+{
+using PixelType = short;
+using ImageType = itk::Image<PixelType, 3>;
+
+PixelType
+GetExpectedPixel(const ImageType::IndexType & index, int imageNumber)
+{
+  return static_cast<PixelType>(index[0] + 5 * index[1] + 11 * index[2] + 1000 * imageNumber);
+}
+
+void
+FillImage(ImageType * image, int imageNumber)
+{
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(GetExpectedPixel(it.GetIndex(), imageNumber));
+  }
+}
+
+bool
+CheckImage(const std::string & fileName, int imageNumber)
+{
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->Update();
+  const ImageType * image = reader->GetOutput();
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != GetExpectedPixel(it.GetIndex(), imageNumber))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error in " << fileName << " at index " << it.GetIndex() << ": expected "
+                << GetExpectedPixel(it.GetIndex(), imageNumber) << ", but got " << it.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkImageFileWriterAsynchronousTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " OutputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string fileNamePrefix = std::string(argv[1]) + "/itkImageFileWriterAsynchronousTest";
+
+  auto queue = itk::AsynchronousWriteQueue::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(queue, AsynchronousWriteQueue, Object);
+  ITK_TEST_EXPECT_EQUAL(queue->GetNumberOfThreads(), 1);
+  ITK_TEST_EXPECT_EQUAL(queue->GetMaximumNumberOfPendingWrites(), 2);
+  ITK_TEST_EXPECT_EQUAL(queue->GetNumberOfPendingWrites(), 0);
+  queue->SetNumberOfThreads(2);
+  ITK_TEST_EXPECT_EQUAL(queue->GetNumberOfThreads(), 2);
+  queue->SetMaximumNumberOfPendingWrites(0);
+  ITK_TEST_EXPECT_EQUAL(queue->GetMaximumNumberOfPendingWrites(), 1);
+  queue->SetMaximumNumberOfPendingWrites(3);
+  ITK_TEST_EXPECT_EQUAL(queue->GetMaximumNumberOfPendingWrites(), 3);
+
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 64, 48, 16 } });
+  image->Allocate();
+
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  ITK_TEST_EXPECT_TRUE(writer->GetWriteQueue() == nullptr);
+  ITK_TEST_SET_GET_BOOLEAN(writer, TakeInputBuffer, false);
+  writer->SetWriteQueue(queue);
+  ITK_TEST_SET_GET_VALUE(queue.GetPointer(), writer->GetWriteQueue());
+  writer->SetInput(image);
+  writer->UseCompressionOn();
+
+  // Each image is computed into the buffer the previous one was written from.
+  constexpr int                         numberOfImages = 6;
+  std::vector<std::shared_future<void>> futures;
+  for (int imageNumber = 0; imageNumber < numberOfImages; ++imageNumber)
+  {
+    FillImage(image, imageNumber);
+    image->Modified();
+    writer->SetFileName(fileNamePrefix + std::to_string(imageNumber) + ".mha");
+    ITK_TRY_EXPECT_NO_EXCEPTION(futures.push_back(writer->WriteAsynchronously()));
+    ITK_TEST_EXPECT_TRUE(queue->GetNumberOfPendingWrites() <= 3);
+  }
+  ITK_TRY_EXPECT_NO_EXCEPTION(queue->Flush());
+  ITK_TEST_EXPECT_EQUAL(queue->GetNumberOfPendingWrites(), 0);
+  for (int imageNumber = 0; imageNumber < numberOfImages; ++imageNumber)
+  {
+    ITK_TRY_EXPECT_NO_EXCEPTION(futures[imageNumber].get());
+    if (!CheckImage(fileNamePrefix + std::to_string(imageNumber) + ".mha", imageNumber))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // A user-specified ImageIO writes one file at a time.
+  writer->SetImageIO(itk::MetaImageIO::New());
+  for (int imageNumber = 0; imageNumber < 2; ++imageNumber)
+  {
+    FillImage(image, imageNumber + 10);
+    image->Modified();
+    writer->SetFileName(fileNamePrefix + "ImageIO" + std::to_string(imageNumber) + ".mha");
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->WriteAsynchronously());
+  }
+  ITK_TRY_EXPECT_NO_EXCEPTION(queue->Flush());
+  if (!CheckImage(fileNamePrefix + "ImageIO0.mha", 10) || !CheckImage(fileNamePrefix + "ImageIO1.mha", 11))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The buffer is taken from the input, and written by the global queue.
+  auto globalWriter = itk::ImageFileWriter<ImageType>::New();
+  globalWriter->SetInput(image);
+  globalWriter->SetFileName(fileNamePrefix + "Taken.mha");
+  globalWriter->TakeInputBufferOn();
+  std::shared_future<void> future;
+  ITK_TRY_EXPECT_NO_EXCEPTION(future = globalWriter->WriteAsynchronously());
+  ITK_TEST_EXPECT_EQUAL(image->GetBufferedRegion().GetNumberOfPixels(), 0);
+  ITK_TRY_EXPECT_NO_EXCEPTION(future.get());
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::AsynchronousWriteQueue::GetGlobalQueue()->Flush());
+  if (!CheckImage(fileNamePrefix + "Taken.mha", 11))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // An error is thrown by the future of the write, and once by Flush().
+  image->Allocate();
+  FillImage(image, 0);
+  writer->SetImageIO(nullptr);
+  writer->SetFileName(fileNamePrefix + ".unknownExtension");
+  ITK_TRY_EXPECT_NO_EXCEPTION(future = writer->WriteAsynchronously());
+  ITK_TRY_EXPECT_EXCEPTION(future.get());
+  ITK_TRY_EXPECT_EXCEPTION(queue->Flush());
+  ITK_TRY_EXPECT_NO_EXCEPTION(queue->Flush());
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,140 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageSeriesWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMetaImageIO.h"
+#include "itkNumericSeriesFileNames.h"
+#include "itkTestingMacros.h"
+
+#include <fstream>
+#include <iterator>
+
+// Writes the slices of a volume with several work units and with one work
+// unit, with and without a user-specified ImageIO, and checks that the files
+// are the same.
+namespace
+{
+using PixelType = short;
+using ImageType = itk::Image<PixelType, 3>;
+using SliceType = itk::Image<PixelType, 2>;
+using WriterType = itk::ImageSeriesWriter<ImageType, SliceType>;
+
+std::vector<std::string>
+GetFileNames(const std::string & fileNamePrefix, unsigned int numberOfFiles)
+{
+  auto fileNames = itk::NumericSeriesFileNames::New();
+  fileNames->SetStartIndex(0);
+  fileNames->SetEndIndex(numberOfFiles - 1);
+  fileNames->SetSeriesFormat(fileNamePrefix + "%03d.mha");
+  return fileNames->GetFileNames();
+}
+
+std::string
+ReadFile(const std::string & fileName)
+{
+  std::ifstream file(fileName.c_str(), std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+bool
+CheckFiles(const std::vector<std::string> & fileNames, const std::vector<std::string> & expectedFileNames)
+{
+  for (size_t i = 0; i < fileNames.size(); ++i)
+  {
+    const std::string expectedFile = ReadFile(expectedFileNames[i]);
+    if (expectedFile.empty() || ReadFile(fileNames[i]) != expectedFile)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << fileNames[i] << " differs from " << expectedFileNames[i] << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkImageSeriesWriterParallelTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " OutputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string fileNamePrefix = std::string(argv[1]) + "/itkImageSeriesWriterParallelTest";
+
+  constexpr unsigned int numberOfSlices = 25;
+  auto                   image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 64, 48, numberOfSlices } });
+  const double spacing[3] = { 0.5, 0.75, 2.0 };
+  image->SetSpacing(spacing);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set(static_cast<PixelType>(index[0] * index[1] / (index[2] + 1) + 100 * index[2]));
+  }
+
+  const std::vector<std::string> sequentialFileNames = GetFileNames(fileNamePrefix + "Sequential", numberOfSlices);
+  const std::vector<std::string> parallelFileNames = GetFileNames(fileNamePrefix + "Parallel", numberOfSlices);
+  const std::vector<std::string> sequentialImageIOFileNames =
+    GetFileNames(fileNamePrefix + "SequentialImageIO", numberOfSlices);
+  const std::vector<std::string> parallelImageIOFileNames =
+    GetFileNames(fileNamePrefix + "ParallelImageIO", numberOfSlices);
+
+  auto writer = WriterType::New();
+  writer->SetInput(image);
+  writer->UseCompressionOn();
+
+  writer->SetNumberOfWorkUnits(1);
+  writer->SetFileNames(sequentialFileNames);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  writer->SetNumberOfWorkUnits(4);
+  writer->SetFileNames(parallelFileNames);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  // A user-specified ImageIO writes the files one after the other, with the
+  // geometry of the volume in their dictionary.
+  writer->SetImageIO(itk::MetaImageIO::New());
+  writer->SetNumberOfWorkUnits(1);
+  writer->SetFileNames(sequentialImageIOFileNames);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  writer->SetImageIO(itk::MetaImageIO::New());
+  writer->SetNumberOfWorkUnits(4);
+  writer->SetFileNames(parallelImageIOFileNames);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  if (!CheckFiles(parallelFileNames, sequentialFileNames) ||
+      !CheckFiles(parallelImageIOFileNames, sequentialImageIOFileNames))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // An error in a file written in parallel is thrown by Update().
+  writer->SetImageIO(nullptr);
+  std::vector<std::string> wrongFileNames = parallelFileNames;
+  wrongFileNames[numberOfSlices / 2] = fileNamePrefix + ".unknownExtension";
+  writer->SetFileNames(wrongFileNames);
+  ITK_TRY_EXPECT_EXCEPTION(writer->Update());
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -795,6 +795,18 @@ MetaImageIO ::Write(const void * buffer)
         eType = MET_FLOAT;
       }
       break;
+    case IOComponentEnum::FLOAT16:
+      // MetaIO has no half precision type: the components are widened to float.
+      eType = MET_FLOAT;
+      break;
+  }
+
+  std::vector<float> widenedBuffer;
+  if (m_ComponentType == IOComponentEnum::FLOAT16)
+  {
+    widenedBuffer.resize(m_IORegion.GetNumberOfPixels() * nChannels);
+    Float16::ConvertToFloat(static_cast<const Float16 *>(buffer), widenedBuffer.data(), widenedBuffer.size());
+    buffer = widenedBuffer.data();
   }
 
   auto * dSize = new int[numberOfDimensions];
@@ -146,6 +146,22 @@ public:
   void
   Write(const void * buffer) override;
 
+  /** Images can be written in pieces, except to ASCII (.nia) files. */
+  bool
+  CanStreamWrite() override;
+
+  /** When an image is written in pieces, the header is written with the
+   * first piece. Uncompressed data is written in place, so regions can also
+   * be pasted into an existing file of the same size and pixel type.
+   * Compressed (.gz) data cannot be pasted into, and is written from its
+   * start to its end, each piece as a separate gzip member. Vector images,
+   * whose components are stored one volume after the other, are then
+   * written at once. */
+  unsigned int
+  GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                    const ImageIORegion & pasteRegion,
+                                    const ImageIORegion & largestPossibleRegion) override;
+
   /** Calculate the region of the image that can be efficiently read
    *  in response to a given requested region. */
   ImageIORegion
@@ -162,6 +178,23 @@ public:
   itkSetMacro(LegacyAnalyze75Mode, Analyze75Flavor);
   itkGetConstMacro(LegacyAnalyze75Mode, Analyze75Flavor);
 
+  /** Read regions of gzip-compressed images through a GzipSeekIndex, which
+   * restarts decompression at a checkpoint near each region, and decompresses
+   * the parts following different checkpoints in parallel, instead of
+   * decompressing the file from its start. The index of a file is built by
+   * its first region read and kept in memory for later reads; reading the
+   * whole image uses the index only when it is already available. Off by
+   * default. */
+  itkSetMacro(UseGzipSeekIndex, bool);
+  itkGetConstMacro(UseGzipSeekIndex, bool);
+  itkBooleanMacro(UseGzipSeekIndex);
+
+  /** File in which the index used with UseGzipSeekIndex is stored, so that
+   * other processes can reuse it. When empty (the default), the index is
+   * only kept in memory. */
+  itkSetStringMacro(GzipSeekIndexFileName);
+  itkGetStringMacro(GzipSeekIndexFileName);
+
 protected:
   NiftiImageIO();
   ~NiftiImageIO() override;
@@ -199,6 +232,23 @@ private:
   void
   SetImageIOMetadataFromNIfTI();
 
+  // Reads the region with the given origin and size, in the order of the
+  // nifti dimensions, through a GzipSeekIndex into newly allocated data.
+  // Returns false if UseGzipSeekIndex is off or the image data is not gzip
+  // compressed, or if the whole image is read and no index is available.
+  bool
+  ReadThroughGzipSeekIndex(const int * origin, const int * size, bool wholeImage, void *& data);
+
+  // Whether the components of the pixels are stored one volume after the
+  // other, as for vector images, rather than interleaved.
+  bool
+  HasComponentVolumes() const;
+
+  // Writes the IO region of an image written in pieces, and the header with
+  // the first piece.
+  void
+  WriteIORegion(const void * buffer);
+
   // This proxy class provides a nifti_image pointer interface to the internal implementation
   // of itk::NiftiImageIO, while hiding the niftilib interface from the external ITK interface.
   class NiftiImageProxy;
@@ -215,6 +265,16 @@ private:
   IOComponentEnum m_OnDiskComponentType{ IOComponentEnum::UNKNOWNCOMPONENTTYPE };
 
   Analyze75Flavor m_LegacyAnalyze75Mode;
+
+  bool        m_UseGzipSeekIndex{ false };
+  std::string m_GzipSeekIndexFileName;
+
+  // Image file of an image written in pieces and offset of the data in it,
+  // set when the header is written or when an existing file is pasted into,
+  // and the offset in the data of the next piece to append when compressed.
+  std::string   m_StreamedImageFileName;
+  SizeValueType m_StreamedDataOffset{ 0 };
+  SizeValueType m_StreamedNextOffset{ 0 };
 };
 
 
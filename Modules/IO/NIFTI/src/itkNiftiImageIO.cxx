@@ -16,11 +16,17 @@
  *
  *=========================================================================*/
 #include "itkNiftiImageIO.h"
+#include "itkGzipSeekIndex.h"
 #include "itkIOCommon.h"
 #include "itkMetaDataObject.h"
 #include "itkSpatialOrientationAdapter.h"
+#include "itksys/SystemTools.hxx"
 #include <nifti1_io.h>
 
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
 #include "itkNiftiImageIOConfigurePrivate.h"
 
 namespace itk
@@ -472,6 +478,8 @@ NiftiImageIO ::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "LegacyAnalyze75Mode: " << this->m_LegacyAnalyze75Mode << std::endl;
+  os << indent << "UseGzipSeekIndex: " << this->m_UseGzipSeekIndex << std::endl;
+  os << indent << "GzipSeekIndexFileName: " << this->m_GzipSeekIndexFileName << std::endl;
 }
 
 bool
@@ -515,6 +523,111 @@ CastCopy(float * to, const void * from, size_t pixelcount)
   }
 }
 
+bool
+NiftiImageIO::ReadThroughGzipSeekIndex(const int * origin, const int * size, bool wholeImage, void *& data)
+{
+  if (!this->m_UseGzipSeekIndex || this->m_NiftiImage->iname_offset < 0)
+  {
+    return false;
+  }
+  char * imageFileName = nifti_findimgname(this->m_NiftiImage->iname, this->m_NiftiImage->nifti_type);
+  if (imageFileName == nullptr)
+  {
+    return false;
+  }
+  const std::string fileName(imageFileName);
+  free(imageFileName);
+  if (!nifti_is_gzfile(fileName.c_str()))
+  {
+    return false;
+  }
+
+  auto seekIndex = GzipSeekIndex::New();
+  seekIndex->SetFileName(fileName);
+  seekIndex->SetIndexFileName(this->m_GzipSeekIndexFileName);
+  if (wholeImage)
+  {
+    if (!seekIndex->Restore())
+    {
+      return false;
+    }
+  }
+  else
+  {
+    seekIndex->Build();
+  }
+
+  // The rows of the region are read in the same order as
+  // nifti_read_subregion_image.
+  const auto                 bytesPerVoxel = static_cast<SizeValueType>(this->m_NiftiImage->nbyper);
+  ImageIORegion              region(7);
+  std::vector<SizeValueType> dimensions(7, 1);
+  for (unsigned int d = 0; d < 7; ++d)
+  {
+    region.SetIndex(d, origin[d]);
+    region.SetSize(d, static_cast<SizeValueType>(size[d]));
+    if (static_cast<int>(d) < this->m_NiftiImage->ndim)
+    {
+      dimensions[d] = static_cast<SizeValueType>(this->m_NiftiImage->dim[d + 1]);
+    }
+  }
+  const SizeValueType                numberOfBytes = region.GetNumberOfPixels() * bytesPerVoxel;
+  const GzipSeekIndex::RangeListType ranges = GzipSeekIndex::ComputeRegionRanges(
+    region, dimensions, bytesPerVoxel, static_cast<SizeValueType>(this->m_NiftiImage->iname_offset));
+
+  data = malloc(numberOfBytes);
+  if (data == nullptr)
+  {
+    itkExceptionMacro(<< "Cannot allocate " << numberOfBytes << " bytes for reading " << fileName);
+  }
+  try
+  {
+    seekIndex->Read(data, ranges);
+  }
+  catch (...)
+  {
+    free(data);
+    data = nullptr;
+    throw;
+  }
+
+  // Swap bytes and replace non-finite floating point values like
+  // nifti_read_buffer does.
+  const int swapSize = this->m_NiftiImage->swapsize;
+  if (swapSize > 1 && this->m_NiftiImage->byteorder != nifti_short_order())
+  {
+    const SizeValueType maximumSwapCount = std::numeric_limits<int>::max();
+    auto *              swapData = static_cast<char *>(data);
+    for (SizeValueType count = numberOfBytes / swapSize; count > 0;)
+    {
+      const SizeValueType swapCount = std::min(count, maximumSwapCount);
+      nifti_swap_Nbytes(static_cast<int>(swapCount), swapSize, swapData);
+      swapData += swapCount * swapSize;
+      count -= swapCount;
+    }
+  }
+  switch (this->m_NiftiImage->datatype)
+  {
+    case NIFTI_TYPE_FLOAT32:
+    case NIFTI_TYPE_COMPLEX64:
+      std::replace_if(static_cast<float *>(data),
+                      static_cast<float *>(data) + numberOfBytes / sizeof(float),
+                      [](float value) { return !std::isfinite(value); },
+                      0.0f);
+      break;
+    case NIFTI_TYPE_FLOAT64:
+    case NIFTI_TYPE_COMPLEX128:
+      std::replace_if(static_cast<double *>(data),
+                      static_cast<double *>(data) + numberOfBytes / sizeof(double),
+                      [](double value) { return !std::isfinite(value); },
+                      0.0);
+      break;
+    default:
+      break;
+  }
+  return true;
+}
+
 void
 NiftiImageIO::Read(void * buffer)
 {
@@ -576,7 +689,12 @@ NiftiImageIO::Read(void * buffer)
   }
   // if all dimensions match requested size, just read in
   // all data as a block
-  if (i == this->GetNumberOfDimensions())
+  const bool wholeImage = (i == this->GetNumberOfDimensions());
+  if (this->ReadThroughGzipSeekIndex(_origin, _size, wholeImage, data))
+  {
+    // the data was decompressed from checkpoints of the gzip stream
+  }
+  else if (wholeImage)
   {
     if (nifti_image_load(this->m_NiftiImage) == -1)
     {
@@ -644,6 +762,8 @@ NiftiImageIO::Read(void * buffer)
         itkExceptionMacro(<< "DOUBLE pixels do not need Casting to float");
       case IOComponentEnum::LDOUBLE:
         itkExceptionMacro(<< "LDOUBLE pixels do not need Casting to float");
+      case IOComponentEnum::FLOAT16:
+        itkExceptionMacro(<< "Bad OnDiskComponentType FLOAT16");
       case IOComponentEnum::UNKNOWNCOMPONENTTYPE:
         itkExceptionMacro(<< "Bad OnDiskComponentType UNKNOWNCOMPONENTTYPE");
     }
@@ -675,12 +795,14 @@ NiftiImageIO::Read(void * buffer)
   {
     // otherwise nifti is x y z t vec l m 0, itk is
     // vec x y z t l m o
+    // The data read holds the requested region only, so step through it
+    // with the region size rather than the image dimensions.
     const auto * niftibuf = (const char *)data;
     auto *       itkbuf = (char *)buffer;
-    const size_t rowdist = this->m_NiftiImage->dim[1];
-    const size_t slicedist = rowdist * this->m_NiftiImage->dim[2];
-    const size_t volumedist = slicedist * this->m_NiftiImage->dim[3];
-    const size_t seriesdist = volumedist * this->m_NiftiImage->dim[4];
+    const size_t rowdist = _size[0];
+    const size_t slicedist = rowdist * _size[1];
+    const size_t volumedist = slicedist * _size[2];
+    const size_t seriesdist = volumedist * _size[3];
     //
     // as per ITK bug 0007485
     // NIfTI is lower triangular, ITK is upper triangular.
@@ -699,13 +821,13 @@ NiftiImageIO::Read(void * buffer)
         vecOrder[i] = i;
       }
     }
-    for (int t = 0; t < this->m_NiftiImage->dim[4]; t++)
+    for (int t = 0; t < _size[3]; t++)
     {
-      for (int z = 0; z < this->m_NiftiImage->dim[3]; z++)
+      for (int z = 0; z < _size[2]; z++)
       {
-        for (int y = 0; y < this->m_NiftiImage->dim[2]; y++)
+        for (int y = 0; y < _size[1]; y++)
         {
-          for (int x = 0; x < this->m_NiftiImage->dim[1]; x++)
+          for (int x = 0; x < _size[0]; x++)
           {
             for (unsigned int c = 0; c < numComponents; c++)
             {
@@ -1633,6 +1755,11 @@ NiftiImageIO ::WriteImageInformation()
       this->m_NiftiImage->datatype = NIFTI_TYPE_FLOAT64;
       this->m_NiftiImage->nbyper = 8;
       break;
+    case IOComponentEnum::FLOAT16:
+      // NIfTI has no half precision type: Write widens the components to float.
+      this->m_NiftiImage->datatype = NIFTI_TYPE_FLOAT32;
+      this->m_NiftiImage->nbyper = 4;
+      break;
     case IOComponentEnum::UNKNOWNCOMPONENTTYPE:
     default:
     {
@@ -1658,6 +1785,7 @@ NiftiImageIO ::WriteImageInformation()
       switch (this->GetComponentType())
       {
         case IOComponentEnum::FLOAT:
+        case IOComponentEnum::FLOAT16:
           this->m_NiftiImage->datatype = NIFTI_TYPE_COMPLEX64;
           break;
         case IOComponentEnum::DOUBLE:
@@ -2002,9 +2130,31 @@ NiftiImageIO::SetNIfTIOrientationFromImageIO(unsigned short int origdims, unsign
 void
 NiftiImageIO ::Write(const void * buffer)
 {
+  if (this->GetUseStreamedWriting())
+  {
+    const ImageIORegion & ioRegion = this->GetIORegion();
+    for (unsigned int d = 0; d < this->GetNumberOfDimensions(); ++d)
+    {
+      if ((d < ioRegion.GetImageDimension() ? ioRegion.GetIndex(d) : 0) != 0 ||
+          (d < ioRegion.GetImageDimension() ? ioRegion.GetSize(d) : 1) != this->GetDimensions(d))
+      {
+        this->WriteIORegion(buffer);
+        return;
+      }
+    }
+  }
+
   // Write the image Information before writing data
   this->WriteImageInformation();
   const unsigned int numComponents = this->GetNumberOfComponents();
+
+  std::vector<float> widenedBuffer;
+  if (this->m_ComponentType == IOComponentEnum::FLOAT16)
+  {
+    widenedBuffer.resize(this->GetImageSizeInComponents());
+    Float16::ConvertToFloat(static_cast<const Float16 *>(buffer), widenedBuffer.data(), widenedBuffer.size());
+    buffer = widenedBuffer.data();
+  }
   if (numComponents == 1 || (numComponents == 2 && this->GetPixelType() == IOPixelEnum::COMPLEX) ||
       (numComponents == 3 && this->GetPixelType() == IOPixelEnum::RGB) ||
       (numComponents == 4 && this->GetPixelType() == IOPixelEnum::RGBA))
@@ -2098,6 +2248,280 @@ NiftiImageIO ::Write(const void * buffer)
   }
 }
 
+bool
+NiftiImageIO::HasComponentVolumes() const
+{
+  const unsigned int numComponents = this->GetNumberOfComponents();
+  return !(numComponents == 1 || (numComponents == 2 && this->GetPixelType() == IOPixelEnum::COMPLEX) ||
+           (numComponents == 3 && this->GetPixelType() == IOPixelEnum::RGB) ||
+           (numComponents == 4 && this->GetPixelType() == IOPixelEnum::RGBA));
+}
+
+bool
+NiftiImageIO::CanStreamWrite()
+{
+  const char * extension = nifti_find_file_extension(this->GetFileName());
+  return extension != nullptr && strcmp(extension, ".nia") != 0;
+}
+
+unsigned int
+NiftiImageIO::GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                                const ImageIORegion & pasteRegion,
+                                                const ImageIORegion & largestPossibleRegion)
+{
+  this->m_StreamedImageFileName.clear();
+  if (!this->CanStreamWrite())
+  {
+    return Superclass::GetActualNumberOfSplitsForWriting(numberOfRequestedSplits, pasteRegion, largestPossibleRegion);
+  }
+
+  // fill in the header, to get the names of the files to write
+  this->WriteImageInformation();
+  const std::string headerFileName(this->m_NiftiImage->fname);
+  const std::string imageFileName(this->m_NiftiImage->iname);
+
+  if (nifti_is_gzfile(imageFileName.c_str()))
+  {
+    // compressed data can only be written from its start to its end
+    if (pasteRegion != largestPossibleRegion)
+    {
+      itkExceptionMacro("Pasting and compression is not supported! Can't write:" << this->GetFileName());
+    }
+    if (this->HasComponentVolumes())
+    {
+      if (numberOfRequestedSplits != 1)
+      {
+        itkDebugMacro("Requested streaming of compressed vector image");
+        itkDebugMacro("Nifti IO is not streaming now!");
+      }
+      return 1;
+    }
+  }
+  else if (pasteRegion != largestPossibleRegion && itksys::SystemTools::FileExists(headerFileName))
+  {
+    // we are going to paste into the existing file, which must hold an
+    // image of the same size and pixel type, with the same geometry
+    std::string errorMessage;
+    Pointer     headerImageIOReader = Self::New();
+    headerImageIOReader->SetLegacyAnalyze75Mode(this->GetLegacyAnalyze75Mode());
+    try
+    {
+      headerImageIOReader->SetFileName(this->GetFileName());
+      headerImageIOReader->ReadImageInformation();
+    }
+    catch (...)
+    {
+      errorMessage = "Unable to read information from file: " + headerFileName;
+    }
+
+    // values stored in single precision are compared up to that precision
+    const auto notClose = [](double a, double b) {
+      return std::abs(a - b) > 1e-5 * std::max(1.0, std::max(std::abs(a), std::abs(b)));
+    };
+    const IOComponentEnum componentType =
+      (this->GetComponentType() == IOComponentEnum::FLOAT16) ? IOComponentEnum::FLOAT : this->GetComponentType();
+    if (!errorMessage.empty())
+    {
+      // Can't read file
+    }
+    else if (headerImageIOReader->GetNumberOfComponents() != this->GetNumberOfComponents() ||
+             headerImageIOReader->GetComponentType() != componentType)
+    {
+      errorMessage = "Component type does not match in file: " + headerFileName;
+    }
+    else if (headerImageIOReader->GetNumberOfDimensions() != this->GetNumberOfDimensions())
+    {
+      errorMessage = "Dimensions does not match in file: " + headerFileName;
+    }
+    else
+    {
+      for (unsigned int i = 0; i < this->GetNumberOfDimensions() && errorMessage.empty(); ++i)
+      {
+        if (headerImageIOReader->GetDimensions(i) != this->GetDimensions(i) ||
+            notClose(headerImageIOReader->GetSpacing(i), this->GetSpacing(i)) ||
+            notClose(headerImageIOReader->GetOrigin(i), this->GetOrigin(i)))
+        {
+          errorMessage = "Size, spacing or origin does not match in file: " + headerFileName;
+        }
+        for (unsigned int j = 0; j < this->GetNumberOfDimensions() && errorMessage.empty(); ++j)
+        {
+          if (notClose(headerImageIOReader->GetDirection(i)[j], this->GetDirection(i)[j]))
+          {
+            errorMessage = "Direction cosines does not match in file: " + headerFileName;
+          }
+        }
+      }
+    }
+
+    // the data is pasted into the image file at the offset its header gives
+    nifti_image * existingImage = nullptr;
+    if (errorMessage.empty())
+    {
+      existingImage = nifti_image_read(headerFileName.c_str(), false);
+      if (existingImage == nullptr || existingImage->iname_offset < 0 || nifti_is_gzfile(existingImage->iname))
+      {
+        errorMessage = "File is compressed: " + headerFileName;
+      }
+    }
+    if (!errorMessage.empty())
+    {
+      nifti_image_free(existingImage);
+      itkExceptionMacro("Unable to paste because pasting file exists and is different. " << errorMessage);
+    }
+    this->m_StreamedImageFileName = existingImage->iname;
+    this->m_StreamedDataOffset = static_cast<SizeValueType>(existingImage->iname_offset);
+    nifti_image_free(existingImage);
+  }
+
+  return GetActualNumberOfSplitsForWritingCanStreamWrite(numberOfRequestedSplits, pasteRegion);
+}
+
+void
+NiftiImageIO::WriteIORegion(const void * buffer)
+{
+  const ImageIORegion & region = this->GetIORegion();
+  const unsigned int    regionDimension = region.GetImageDimension();
+  const SizeValueType   numberOfPixels = region.GetNumberOfPixels();
+  const unsigned int    numComponents = this->GetNumberOfComponents();
+  const bool            componentVolumes = this->HasComponentVolumes();
+
+  bool allocate = false;
+  if (this->m_StreamedImageFileName.empty())
+  {
+    // the first piece: write the header, and create the image file that the
+    // pieces are written into
+    this->WriteImageInformation();
+    if (componentVolumes)
+    {
+      for (unsigned int i = 1; i < 8; i++)
+      {
+        if (this->m_NiftiImage->dim[i] == 0)
+        {
+          this->m_NiftiImage->dim[i] = 1;
+        }
+      }
+    }
+    znzFile file = nifti_image_write_hdr_img2(this->m_NiftiImage, 2, "wb", nullptr, nullptr);
+    if (znz_isnull(file))
+    {
+      itkExceptionMacro(<< "Unable to write header for file: " << this->GetFileName());
+    }
+    znzclose(file);
+    this->m_StreamedImageFileName = this->m_NiftiImage->iname;
+    this->m_StreamedDataOffset = static_cast<SizeValueType>(this->m_NiftiImage->iname_offset);
+    this->m_StreamedNextOffset = 0;
+    allocate = !nifti_is_gzfile(this->m_StreamedImageFileName.c_str());
+  }
+
+  // The size of a voxel in the file covers all the components of the pixel,
+  // except for vector images, stored one component volume after the other.
+  const auto          pixelSize = static_cast<SizeValueType>(this->m_NiftiImage->nbyper);
+  const unsigned int  numberOfVolumes = componentVolumes ? numComponents : 1;
+  const SizeValueType volumeSize = this->GetImageSizeInPixels() * pixelSize;
+  if (allocate)
+  {
+    // write the last byte of the data, so that the pieces can be written
+    // anywhere in it
+    std::ofstream file;
+    this->OpenFileForWriting(file, this->m_StreamedImageFileName, false);
+    file.seekp(static_cast<std::streamoff>(this->m_StreamedDataOffset + numberOfVolumes * volumeSize - 1));
+    file.write("\0", 1);
+  }
+
+  std::vector<float> widenedBuffer;
+  if (this->m_ComponentType == IOComponentEnum::FLOAT16)
+  {
+    widenedBuffer.resize(numberOfPixels * numComponents);
+    Float16::ConvertToFloat(static_cast<const Float16 *>(buffer), widenedBuffer.data(), widenedBuffer.size());
+    buffer = widenedBuffer.data();
+  }
+
+  // rearrange the components of vector images as in Write()
+  std::vector<char> volumesBuffer;
+  if (componentVolumes)
+  {
+    int * vecOrder;
+    if (this->GetPixelType() == IOPixelEnum::DIFFUSIONTENSOR3D ||
+        this->GetPixelType() == IOPixelEnum::SYMMETRICSECONDRANKTENSOR)
+    {
+      vecOrder = UpperToLowerOrder(SymMatDim(numComponents));
+    }
+    else
+    {
+      vecOrder = new int[numComponents];
+      for (unsigned i = 0; i < numComponents; i++)
+      {
+        vecOrder[i] = i;
+      }
+    }
+    volumesBuffer.resize(numberOfPixels * numComponents * pixelSize);
+    const auto * const itkbuf = static_cast<const char *>(buffer);
+    for (SizeValueType p = 0; p < numberOfPixels; ++p)
+    {
+      for (unsigned int c = 0; c < numComponents; ++c)
+      {
+        std::copy_n(itkbuf + (p * numComponents + vecOrder[c]) * pixelSize,
+                    pixelSize,
+                    volumesBuffer.data() + (c * numberOfPixels + p) * pixelSize);
+      }
+    }
+    delete[] vecOrder;
+    buffer = volumesBuffer.data();
+  }
+
+  // The component volumes follow one another, like an additional dimension
+  // of the image.
+  ImageIORegion              volumesRegion(this->GetNumberOfDimensions() + 1);
+  std::vector<SizeValueType> dimensions(this->m_Dimensions);
+  for (unsigned int d = 0; d < this->GetNumberOfDimensions(); ++d)
+  {
+    volumesRegion.SetIndex(d, (d < regionDimension) ? region.GetIndex(d) : 0);
+    volumesRegion.SetSize(d, (d < regionDimension) ? region.GetSize(d) : 1);
+  }
+  volumesRegion.SetSize(this->GetNumberOfDimensions(), numberOfVolumes);
+  dimensions.push_back(numberOfVolumes);
+  const GzipSeekIndex::RangeListType ranges =
+    GzipSeekIndex::ComputeRegionRanges(volumesRegion, dimensions, pixelSize);
+
+  const auto * data = static_cast<const char *>(buffer);
+  if (nifti_is_gzfile(this->m_StreamedImageFileName.c_str()))
+  {
+    // compressed data is appended piece by piece, each as a gzip member
+    if (ranges.size() != 1 || ranges.front().first != this->m_StreamedNextOffset)
+    {
+      itkExceptionMacro(<< "Pieces of compressed data must be written in order, from start to end, to file: "
+                        << this->m_StreamedImageFileName);
+    }
+    znzFile file = znzopen(this->m_StreamedImageFileName.c_str(), "ab", 1);
+    if (znz_isnull(file))
+    {
+      itkExceptionMacro(<< "Unable to open file for appending: " << this->m_StreamedImageFileName);
+    }
+    const size_t written = znzwrite(data, 1, ranges.front().second, file);
+    znzclose(file);
+    if (written != ranges.front().second)
+    {
+      itkExceptionMacro(<< "Error writing to file: " << this->m_StreamedImageFileName);
+    }
+    this->m_StreamedNextOffset += ranges.front().second;
+  }
+  else
+  {
+    std::ofstream file;
+    this->OpenFileForWriting(file, this->m_StreamedImageFileName, false);
+    for (const auto & range : ranges)
+    {
+      file.seekp(static_cast<std::streamoff>(this->m_StreamedDataOffset + range.first));
+      file.write(data, static_cast<std::streamsize>(range.second));
+      data += range.second;
+    }
+    if (file.fail())
+    {
+      itkExceptionMacro(<< "Error writing to file: " << this->m_StreamedImageFileName);
+    }
+  }
+}
+
 /** Define how to print enumerations */
 std::ostream &
 operator<<(std::ostream & out, const Analyze75Flavor value)
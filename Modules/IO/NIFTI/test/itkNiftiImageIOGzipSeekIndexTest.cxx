@@ -0,0 +1,214 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGzipSeekIndex.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkNiftiImageIO.h"
+#include "itkTestingMacros.h"
+#include "itksys/SystemTools.hxx"
+#include <znzlib.h>
+
+#include <algorithm>
+#include <cstring>
+
+// Writes a .nii.gz image, and checks that a GzipSeekIndex of it reads ranges
+// of the uncompressed data like a sequential decompression does, that the
+// index is stored in and restored from a sidecar file, and that regions read
+// by NiftiImageIO through the index are correct.
+namespace
+{
+using PixelType = short;
+using ImageType = itk::Image<PixelType, 3>;
+
+PixelType
+GetExpectedPixel(const ImageType::IndexType & index)
+{
+  return static_cast<PixelType>((index[0] * 37 + index[1] * 101 + index[2] * 211 + index[0] * index[1]) % 3001);
+}
+
+bool
+CheckRegion(const std::string & fileName, const ImageType::RegionType & region, const std::string & indexFileName)
+{
+  auto niftiImageIO = itk::NiftiImageIO::New();
+  niftiImageIO->UseGzipSeekIndexOn();
+  niftiImageIO->SetGzipSeekIndexFileName(indexFileName);
+
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetImageIO(niftiImageIO);
+  reader->SetFileName(fileName);
+  reader->UpdateOutputInformation();
+  reader->GetOutput()->SetRequestedRegion(region);
+  reader->Update();
+
+  const ImageType * image = reader->GetOutput();
+  if (image->GetBufferedRegion() != region)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Expected buffered region " << region << ", but got " << image->GetBufferedRegion() << std::endl;
+    return false;
+  }
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != GetExpectedPixel(it.GetIndex()))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error at index " << it.GetIndex() << ": expected " << GetExpectedPixel(it.GetIndex())
+                << ", but got " << it.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkNiftiImageIOGzipSeekIndexTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " OutputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string fileName = std::string(argv[1]) + "/itkNiftiImageIOGzipSeekIndexTest.nii.gz";
+  const std::string indexFileName = std::string(argv[1]) + "/itkNiftiImageIOGzipSeekIndexTest.nii.gz.idx";
+  itksys::SystemTools::RemoveFile(indexFileName);
+
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 96, 80, 40 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(GetExpectedPixel(it.GetIndex()));
+  }
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  // Build an index with many checkpoints, and compare ranges read through it
+  // with the data decompressed sequentially.
+  auto seekIndex = itk::GzipSeekIndex::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(seekIndex, GzipSeekIndex, Object);
+
+  ITK_TEST_EXPECT_EQUAL(seekIndex->GetCheckpointSpacing(), 1 << 22);
+  ITK_TEST_EXPECT_TRUE(seekIndex->GetUseCache());
+  seekIndex->SetFileName(fileName);
+  seekIndex->SetCheckpointSpacing(1 << 14);
+  seekIndex->UseCacheOff();
+  seekIndex->SetIndexFileName(indexFileName);
+  ITK_TEST_EXPECT_TRUE(!seekIndex->Restore());
+  ITK_TRY_EXPECT_NO_EXCEPTION(seekIndex->Build());
+
+  const itk::SizeValueType dataSize = image->GetBufferedRegion().GetNumberOfPixels() * sizeof(PixelType);
+  ITK_TEST_EXPECT_TRUE(seekIndex->GetUncompressedSize() > dataSize);
+  ITK_TEST_EXPECT_TRUE(seekIndex->GetNumberOfCheckpoints() > 10);
+  ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileExists(indexFileName));
+
+  const itk::SizeValueType uncompressedSize = seekIndex->GetUncompressedSize();
+  std::vector<char>        expected(uncompressedSize + 1);
+  znzFile                  file = znzopen(fileName.c_str(), "rb", 1);
+  ITK_TEST_EXPECT_TRUE(!znz_isnull(file));
+  const size_t expectedSize = znzread(expected.data(), 1, expected.size(), file);
+  znzclose(file);
+  ITK_TEST_EXPECT_EQUAL(expectedSize, uncompressedSize);
+
+  const itk::GzipSeekIndex::RangeListType ranges{ { 0, 1 },
+                                                  { 100, 5000 },
+                                                  { 20000, 1 },
+                                                  { 20001, 70000 },
+                                                  { uncompressedSize / 2, 3 },
+                                                  { uncompressedSize - 10, 10 } };
+  itk::SizeValueType rangesSize = 0;
+  for (const auto & range : ranges)
+  {
+    rangesSize += range.second;
+  }
+
+  // A new index restores the one stored in the sidecar file.
+  auto restoredIndex = itk::GzipSeekIndex::New();
+  restoredIndex->SetFileName(fileName);
+  restoredIndex->SetIndexFileName(indexFileName);
+  restoredIndex->UseCacheOff();
+  ITK_TEST_EXPECT_TRUE(restoredIndex->Restore());
+  ITK_TEST_EXPECT_EQUAL(restoredIndex->GetNumberOfCheckpoints(), seekIndex->GetNumberOfCheckpoints());
+  ITK_TEST_EXPECT_EQUAL(restoredIndex->GetUncompressedSize(), uncompressedSize);
+
+  std::vector<char> wholeData(uncompressedSize);
+  ITK_TRY_EXPECT_NO_EXCEPTION(
+    seekIndex->Read(wholeData.data(), itk::GzipSeekIndex::RangeListType{ { 0, uncompressedSize } }));
+  ITK_TEST_EXPECT_TRUE(std::equal(wholeData.begin(), wholeData.end(), expected.begin()));
+
+  for (auto index : { seekIndex, restoredIndex })
+  {
+    std::vector<char> buffer(rangesSize);
+    ITK_TRY_EXPECT_NO_EXCEPTION(index->Read(buffer.data(), ranges));
+    itk::SizeValueType bufferOffset = 0;
+    for (const auto & range : ranges)
+    {
+      if (std::memcmp(buffer.data() + bufferOffset, expected.data() + range.first, range.second) != 0)
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Wrong data read in range [" << range.first << ", " << range.first + range.second << ")"
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+      bufferOffset += range.second;
+    }
+  }
+
+  // Ranges must be sorted and within the data.
+  std::vector<char> buffer(20);
+  ITK_TRY_EXPECT_EXCEPTION(
+    seekIndex->Read(buffer.data(), itk::GzipSeekIndex::RangeListType{ { 100, 10 }, { 50, 10 } }));
+  ITK_TRY_EXPECT_EXCEPTION(
+    seekIndex->Read(buffer.data(), itk::GzipSeekIndex::RangeListType{ { uncompressedSize - 10, 20 } }));
+
+  // Read regions through NiftiImageIO, with the index in memory only, then
+  // with the sidecar file.
+  auto niftiImageIO = itk::NiftiImageIO::New();
+  ITK_TEST_EXPECT_TRUE(!niftiImageIO->GetUseGzipSeekIndex());
+  ITK_TEST_SET_GET_BOOLEAN(niftiImageIO, UseGzipSeekIndex, true);
+  niftiImageIO->SetGzipSeekIndexFileName(indexFileName);
+  ITK_TEST_EXPECT_EQUAL(niftiImageIO->GetGzipSeekIndexFileName(), indexFileName);
+
+  const ImageType::RegionType regions[] = {
+    ImageType::RegionType(ImageType::IndexType{ { 5, 7, 11 } }, ImageType::SizeType{ { 30, 20, 17 } }),
+    ImageType::RegionType(ImageType::IndexType{ { 0, 0, 39 } }, ImageType::SizeType{ { 96, 80, 1 } }),
+    ImageType::RegionType(ImageType::IndexType{ { 95, 3, 2 } }, ImageType::SizeType{ { 1, 1, 35 } }),
+    image->GetBufferedRegion()
+  };
+  bool success = true;
+  for (const auto & region : regions)
+  {
+    ITK_TRY_EXPECT_NO_EXCEPTION(success =
+                                  CheckRegion(fileName, region, "") && CheckRegion(fileName, region, indexFileName));
+    if (!success)
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  itk::GzipSeekIndex::ClearCache();
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
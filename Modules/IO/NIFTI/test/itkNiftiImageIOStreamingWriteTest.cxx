@@ -0,0 +1,220 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkNiftiImageIO.h"
+#include "itkPipelineMonitorImageFilter.h"
+#include "itkTestingMacros.h"
+#include "itkVector.h"
+
+// Writes scalar and vector images in pieces to uncompressed and compressed
+// nifti files, pastes a region into an existing file, and checks the images
+// read back.
+namespace
+{
+void
+SetPixelValue(short & pixel, int value)
+{
+  pixel = static_cast<short>(value);
+}
+
+void
+SetPixelValue(itk::Vector<float, 3> & pixel, int value)
+{
+  for (unsigned int c = 0; c < 3; ++c)
+  {
+    pixel[c] = static_cast<float>(value + 1000 * c);
+  }
+}
+
+template <typename TImage>
+typename TImage::PixelType
+GetExpectedPixel(const typename TImage::IndexType & index, int sign)
+{
+  typename TImage::PixelType pixel;
+  SetPixelValue(pixel, sign * static_cast<int>(index[0] + 7 * index[1] + 13 * index[2]));
+  return pixel;
+}
+
+// Writes at once an image to read the images to write in pieces from.
+template <typename TImage>
+void
+WriteSourceImage(const std::string & fileName, int sign)
+{
+  auto image = TImage::New();
+  image->SetRegions(typename TImage::SizeType{ { 32, 24, 20 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(GetExpectedPixel<TImage>(it.GetIndex(), sign));
+  }
+  auto writer = itk::ImageFileWriter<TImage>::New();
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  writer->Update();
+}
+
+// Writes the image of the source file, which is read in the pieces the
+// writer asks for.
+template <typename TImage>
+bool
+WriteImage(const std::string &                 sourceFileName,
+           const std::string &                 fileName,
+           unsigned int                        numberOfStreamDivisions,
+           unsigned int                        expectedNumberOfUpdates,
+           const typename TImage::RegionType * pasteRegion)
+{
+  auto reader = itk::ImageFileReader<TImage>::New();
+  reader->SetFileName(sourceFileName);
+  reader->UpdateOutputInformation();
+
+  auto monitor = itk::PipelineMonitorImageFilter<TImage>::New();
+  monitor->SetInput(reader->GetOutput());
+
+  auto writer = itk::ImageFileWriter<TImage>::New();
+  writer->SetInput(monitor->GetOutput());
+  writer->SetImageIO(itk::NiftiImageIO::New());
+  writer->SetFileName(fileName);
+  writer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+  if (pasteRegion != nullptr)
+  {
+    itk::ImageIORegion ioRegion(TImage::ImageDimension);
+    itk::ImageIORegionAdaptor<TImage::ImageDimension>::Convert(
+      *pasteRegion, ioRegion, reader->GetOutput()->GetLargestPossibleRegion().GetIndex());
+    writer->SetIORegion(ioRegion);
+  }
+  writer->Update();
+
+  if (monitor->GetNumberOfUpdates() != expectedNumberOfUpdates ||
+      (expectedNumberOfUpdates > 1 && !monitor->VerifyAllInputCanStream(expectedNumberOfUpdates)))
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Expected " << fileName << " to be written in " << expectedNumberOfUpdates << " pieces, but got "
+              << monitor->GetNumberOfUpdates() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Reads the image back, and checks its pixels, which are those of the first
+// image, or of the second one in the pasted region.
+template <typename TImage>
+bool
+CheckImage(const std::string & fileName, const typename TImage::RegionType & pastedRegion)
+{
+  auto reader = itk::ImageFileReader<TImage>::New();
+  reader->SetFileName(fileName);
+  reader->Update();
+  const TImage * image = reader->GetOutput();
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto expected = GetExpectedPixel<TImage>(it.GetIndex(), pastedRegion.IsInside(it.GetIndex()) ? -1 : 1);
+    if (it.Get() != expected)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error in " << fileName << " at index " << it.GetIndex() << ": expected " << expected
+                << ", but got " << it.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename TImage>
+bool
+TestImage(const std::string & fileNamePrefix, bool isVector)
+{
+  const std::string sourceFileName = fileNamePrefix + "Source.nii";
+  const std::string otherSourceFileName = fileNamePrefix + "OtherSource.nii";
+  WriteSourceImage<TImage>(sourceFileName, 1);
+  WriteSourceImage<TImage>(otherSourceFileName, -1);
+
+  const typename TImage::RegionType noRegion;
+  const typename TImage::RegionType pasteRegion(typename TImage::IndexType{ { 3, 5, 7 } },
+                                                typename TImage::SizeType{ { 20, 10, 9 } });
+
+  // streaming, then pasting into the uncompressed files
+  for (const std::string extension : { ".nii", ".hdr" })
+  {
+    const std::string fileName = fileNamePrefix + extension;
+    if (!WriteImage<TImage>(sourceFileName, fileName, 4, 4, nullptr) || !CheckImage<TImage>(fileName, noRegion) ||
+        !WriteImage<TImage>(otherSourceFileName, fileName, 3, 3, &pasteRegion) ||
+        !CheckImage<TImage>(fileName, pasteRegion))
+    {
+      return false;
+    }
+  }
+
+  // streaming, except for vector images, into compressed files, which
+  // cannot be pasted into
+  const std::string fileName = fileNamePrefix + "Compressed.nii.gz";
+  if (!WriteImage<TImage>(sourceFileName, fileName, 4, isVector ? 1 : 4, nullptr) ||
+      !CheckImage<TImage>(fileName, noRegion))
+  {
+    return false;
+  }
+  try
+  {
+    WriteImage<TImage>(otherSourceFileName, fileName, 1, 1, &pasteRegion);
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Pasting into " << fileName << " should have failed" << std::endl;
+    return false;
+  }
+  catch (const itk::ExceptionObject & exception)
+  {
+    std::cout << "Expected exception caught: " << exception.GetDescription() << std::endl;
+  }
+  return CheckImage<TImage>(fileName, noRegion);
+}
+} // namespace
+
+int
+itkNiftiImageIOStreamingWriteTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " OutputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string directory = argv[1];
+
+  auto niftiImageIO = itk::NiftiImageIO::New();
+  niftiImageIO->SetFileName(directory + "/image.nii.gz");
+  ITK_TEST_EXPECT_TRUE(niftiImageIO->CanStreamWrite());
+  niftiImageIO->SetFileName(directory + "/image.nia");
+  ITK_TEST_EXPECT_TRUE(!niftiImageIO->CanStreamWrite());
+
+  using ScalarImageType = itk::Image<short, 3>;
+  using VectorImageType = itk::Image<itk::Vector<float, 3>, 3>;
+
+  bool success = true;
+  ITK_TRY_EXPECT_NO_EXCEPTION(
+    success = TestImage<ScalarImageType>(directory + "/itkNiftiImageIOStreamingWriteTestScalar", false) &&
+              TestImage<VectorImageType>(directory + "/itkNiftiImageIOStreamingWriteTestVector", true));
+  if (!success)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
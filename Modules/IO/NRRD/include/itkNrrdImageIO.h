@@ -78,6 +78,34 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Regions can be read from gzip-encoded files through a GzipSeekIndex,
+   * see UseGzipSeekIndex. */
+  bool
+  CanStreamRead() override;
+
+  /** Returns the requested region when it can be read through a
+   * GzipSeekIndex, and the largest possible region otherwise. */
+  ImageIORegion
+  GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requestedRegion) const override;
+
+  /** Read regions of gzip-encoded images through a GzipSeekIndex, which
+   * restarts decompression at a checkpoint near each region, and decompresses
+   * the parts following different checkpoints in parallel, instead of
+   * decompressing all the data. The index of a file is built by its first
+   * region read and kept in memory for later reads; reading the whole image
+   * uses the index only when it is already available. This applies to data
+   * in a single file, attached or detached, that does not need its axes
+   * permuted and has no negative byte skip. Off by default. */
+  itkSetMacro(UseGzipSeekIndex, bool);
+  itkGetConstMacro(UseGzipSeekIndex, bool);
+  itkBooleanMacro(UseGzipSeekIndex);
+
+  /** File in which the index used with UseGzipSeekIndex is stored, so that
+   * other processes can reuse it. When empty (the default), the index is
+   * only kept in memory. */
+  itkSetStringMacro(GzipSeekIndexFileName);
+  itkGetStringMacro(GzipSeekIndexFileName);
+
   /** Determine the file type. Returns true if this ImageIO can write the
    * file specified. */
   bool
@@ -92,6 +120,20 @@ public:
   void
   Write(const void * buffer) override;
 
+  /** Images can be written in pieces, except with the ASCII and bzip2
+   * encodings. */
+  bool
+  CanStreamWrite() override;
+
+  /** The header is written with the first piece. Raw data is written in
+   * place, so it can be pasted into an existing file of the same size and
+   * pixel type. Gzip-encoded data is written from start to end, each piece
+   * as a gzip member, and cannot be pasted into. */
+  unsigned int
+  GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                    const ImageIORegion & pasteRegion,
+                                    const ImageIORegion & largestPossibleRegion) override;
+
 protected:
   NrrdImageIO();
   ~NrrdImageIO() override;
@@ -110,6 +152,45 @@ protected:
   NrrdToITKComponentType(const int) const;
 
   const NrrdEncoding_t * m_NrrdCompressionEncoding{ nullptr };
+
+private:
+  /** Reads the IO region through a GzipSeekIndex. Returns false if the data
+   * cannot be read that way, or if the whole image is read and no index is
+   * available. */
+  bool
+  ReadThroughGzipSeekIndex(void * buffer);
+
+  bool        m_UseGzipSeekIndex{ false };
+  std::string m_GzipSeekIndexFileName;
+
+  /** The encoding the data is written with. */
+  const NrrdEncoding_t *
+  GetWriteEncoding() const;
+
+  /** Writes the IO region of the image into the data file, whose header has
+   * been written already. */
+  void
+  WriteIORegion(const void * buffer, SizeValueType pixelSize);
+
+  /** Whether the IO region can be read through a GzipSeekIndex. */
+  bool
+  CanReadThroughGzipSeekIndex() const;
+
+  /** Where the raw or gzip-encoded data of a single data file is, set by
+   * ReadImageInformation() when it is laid out like the ITK buffer. The file
+   * name is empty otherwise. */
+  std::string            m_DataFileName;
+  const NrrdEncoding_t * m_DataEncoding{ nullptr };
+  SizeValueType          m_DataOffset{ 0 };
+  SizeValueType          m_DataByteSkip{ 0 };
+  bool                   m_DataSwapBytes{ false };
+
+  /** Where the data of an image written in pieces goes. The file name is
+   * empty until the header is written with the first piece. */
+  std::string   m_StreamedDataFileName;
+  SizeValueType m_StreamedDataOffset{ 0 };
+  SizeValueType m_StreamedNextOffset{ 0 };
+  bool          m_StreamedSwapBytes{ false };
 };
 } // end namespace itk
 
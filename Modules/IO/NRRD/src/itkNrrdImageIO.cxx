@@ -22,6 +22,11 @@
 #include "itkMetaDataObject.h"
 #include "itkIOCommon.h"
 #include "itkFloatingPointExceptions.h"
+#include "itkGzipSeekIndex.h"
+#include "itkMath.h"
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm>
 
 namespace itk
 {
@@ -63,6 +68,8 @@ void
 NrrdImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "UseGzipSeekIndex: " << this->m_UseGzipSeekIndex << std::endl;
+  os << indent << "GzipSeekIndexFileName: " << this->m_GzipSeekIndexFileName << std::endl;
 }
 
 void
@@ -193,6 +200,8 @@ NrrdImageIO::ITKToNrrdComponentType(const IOComponentEnum itkComponentType) cons
       return nrrdTypeDouble;
     case IOComponentEnum::LDOUBLE:
       return nrrdTypeUnknown; // Long double not supported by nrrd
+    case IOComponentEnum::FLOAT16:
+      return nrrdTypeFloat; // Half precision is not supported by nrrd, Write widens it to float
   }
   // Strictly to avoid compiler warning regarding "control may reach end of
   // non-void function":
@@ -265,6 +274,8 @@ NrrdImageIO::ReadImageInformation()
   Nrrd *        nrrd = nrrdNew();
   NrrdIoState * nio = nrrdIoStateNew();
 
+  this->m_DataFileName.clear();
+
   try
   {
     // nrrd causes exceptions on purpose, so mask them
@@ -278,6 +289,9 @@ NrrdImageIO::ReadImageInformation()
     // this is the mechanism by which we tell nrrdLoad to read
     // just the header, and none of the data
     nrrdIoStateSet(nio, nrrdIoStateSkipData, 1);
+    // the data file is opened anyway; keep it open, positioned at the start
+    // of the data
+    nrrdIoStateSet(nio, nrrdIoStateKeepNrrdDataFileOpen, 1);
     if (nrrdLoad(nrrd, this->GetFileName(), nio) != 0)
     {
       char * err = biffGetDone(NRRD);
@@ -298,6 +312,13 @@ NrrdImageIO::ReadImageInformation()
       FloatingPointExceptions::SetEnabled(saveFPEState);
     }
 
+    long dataOffset = -1;
+    if (nio->dataFile != nullptr)
+    {
+      dataOffset = ftell(nio->dataFile);
+      nio->dataFile = airFclose(nio->dataFile);
+    }
+
 
     if (nrrdTypeBlock == nrrd->type)
     {
@@ -695,12 +716,42 @@ NrrdImageIO::ReadImageInformation()
       EncapsulateMetaData<std::vector<std::vector<double>>>(thisDic, std::string(key), msrFrame);
     }
 
+    // raw or gzip-encoded data in a single file, laid out like the ITK
+    // buffer as long as its axes need not be permuted in Read(); the byte
+    // skip of raw data is already past
+    if (dataOffset >= 0 && nio->dataFNFormat == nullptr && nio->dataFNArr->len <= 1 &&
+        (nio->encoding == nrrdEncodingRaw || (nio->encoding == nrrdEncodingGzip && nio->byteSkip >= 0)) &&
+        (0 == rangeAxisNum || (0 == rangeAxisIdx[0] && nrrdKind3DMaskedSymMatrix != nrrd->axis[0].kind)))
+    {
+      if (0 == nio->dataFNArr->len)
+      {
+        this->m_DataFileName = this->GetFileName();
+      }
+      else
+      {
+        this->m_DataFileName = nio->dataFN[0];
+        if (!itksys::SystemTools::FileIsFullPath(this->m_DataFileName) && airStrlen(nio->path))
+        {
+          this->m_DataFileName = std::string(nio->path) + "/" + this->m_DataFileName;
+        }
+      }
+      this->m_DataEncoding = nio->encoding;
+      this->m_DataOffset = static_cast<SizeValueType>(dataOffset);
+      this->m_DataByteSkip = nio->encoding->isCompression ? static_cast<SizeValueType>(nio->byteSkip) : 0;
+      this->m_DataSwapBytes =
+        airEndianUnknown != nio->endian && 1 < nrrdElementSize(nrrd) && nio->endian != airMyEndian();
+    }
+
     nrrd = nrrdNix(nrrd);
     nio = nrrdIoStateNix(nio);
   }
   catch (...)
   {
     // clean up from an exception
+    if (nio->dataFile != nullptr)
+    {
+      nio->dataFile = airFclose(nio->dataFile);
+    }
     nrrd = nrrdNix(nrrd);
     nio = nrrdIoStateNix(nio);
 
@@ -709,9 +760,97 @@ NrrdImageIO::ReadImageInformation()
   }
 }
 
+bool
+NrrdImageIO::CanStreamRead()
+{
+  return this->CanReadThroughGzipSeekIndex();
+}
+
+bool
+NrrdImageIO::CanReadThroughGzipSeekIndex() const
+{
+  return this->m_UseGzipSeekIndex && !this->m_DataFileName.empty() && this->m_DataEncoding == nrrdEncodingGzip;
+}
+
+ImageIORegion
+NrrdImageIO::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requestedRegion) const
+{
+  if (!this->CanReadThroughGzipSeekIndex())
+  {
+    return Superclass::GenerateStreamableReadRegionFromRequestedRegion(requestedRegion);
+  }
+  return requestedRegion;
+}
+
+bool
+NrrdImageIO::ReadThroughGzipSeekIndex(void * buffer)
+{
+  if (!this->CanReadThroughGzipSeekIndex())
+  {
+    return false;
+  }
+
+  const ImageIORegion & region = this->GetIORegion();
+  const unsigned int    regionDimension = region.GetImageDimension();
+  bool                  wholeImage = true;
+  for (unsigned int d = 0; d < this->GetNumberOfDimensions(); ++d)
+  {
+    const SizeValueType index = (d < regionDimension) ? region.GetIndex(d) : 0;
+    const SizeValueType size = (d < regionDimension) ? region.GetSize(d) : 1;
+    wholeImage = wholeImage && index == 0 && size == this->GetDimensions(d);
+  }
+
+  auto seekIndex = GzipSeekIndex::New();
+  seekIndex->SetFileName(this->m_DataFileName);
+  seekIndex->SetDataOffset(this->m_DataOffset);
+  seekIndex->SetIndexFileName(this->m_GzipSeekIndexFileName);
+  if (wholeImage)
+  {
+    if (!seekIndex->Restore())
+    {
+      return false;
+    }
+  }
+  else
+  {
+    seekIndex->Build();
+  }
+
+  // The data is laid out like the ITK buffer, as its axes need no
+  // permutation.
+  const SizeValueType                pixelSize = this->GetPixelSize();
+  const SizeValueType                numberOfBytes = region.GetNumberOfPixels() * pixelSize;
+  const GzipSeekIndex::RangeListType ranges =
+    GzipSeekIndex::ComputeRegionRanges(region, this->m_Dimensions, pixelSize, this->m_DataByteSkip);
+  seekIndex->Read(buffer, ranges);
+
+  if (this->m_DataSwapBytes)
+  {
+    Nrrd * nrrd = nrrdNew();
+    if (nrrdWrap_va(nrrd,
+                    buffer,
+                    this->ITKToNrrdComponentType(this->m_ComponentType),
+                    1,
+                    static_cast<size_t>(numberOfBytes / this->GetComponentSize())))
+    {
+      nrrdNix(nrrd);
+      char * err = biffGetDone(NRRD); // would be nice to free(err)
+      itkExceptionMacro("Read: Error wrapping data for swapping bytes:\n" << err);
+    }
+    nrrdSwapEndian(nrrd);
+    nrrdNix(nrrd);
+  }
+  return true;
+}
+
 void
 NrrdImageIO::Read(void * buffer)
 {
+  if (this->ReadThroughGzipSeekIndex(buffer))
+  {
+    return;
+  }
+
   Nrrd * nrrd = nrrdNew();
   bool   nrrdAllocated;
 
@@ -877,6 +1016,22 @@ NrrdImageIO::Write(const void * buffer)
   double        spaceDir[NRRD_DIM_MAX][NRRD_SPACE_DIM_MAX];
   double        origin[NRRD_DIM_MAX];
 
+  // a piece of an image written in pieces
+  const ImageIORegion & ioRegion = this->GetIORegion();
+  bool                  streamed = false;
+  if (this->GetUseStreamedWriting())
+  {
+    for (unsigned int d = 0; d < this->GetNumberOfDimensions(); ++d)
+    {
+      const bool inRegion = d < ioRegion.GetImageDimension();
+      if ((inRegion ? ioRegion.GetIndex(d) : 0) != 0 ||
+          (inRegion ? ioRegion.GetSize(d) : 1) != this->GetDimensions(d))
+      {
+        streamed = true;
+      }
+    }
+  }
+
   spaceDim = this->GetNumberOfDimensions();
   if (this->GetNumberOfComponents() > 1)
   {
@@ -935,6 +1090,14 @@ NrrdImageIO::Write(const void * buffer)
       spaceDir[axi + baseDim][saxi] = spacing * spaceDirStd[saxi];
     }
   }
+  std::vector<float> widenedBuffer;
+  if (m_ComponentType == IOComponentEnum::FLOAT16)
+  {
+    widenedBuffer.resize(streamed ? ioRegion.GetNumberOfPixels() * this->GetNumberOfComponents()
+                                  : this->GetImageSizeInComponents());
+    Float16::ConvertToFloat(static_cast<const Float16 *>(buffer), widenedBuffer.data(), widenedBuffer.size());
+    buffer = widenedBuffer.data();
+  }
   if (nrrdWrap_nva(nrrd, const_cast<void *>(buffer), this->ITKToNrrdComponentType(m_ComponentType), nrrdDim, size) ||
       (3 == spaceDim
          // special case: ITK is LPS in 3-D
@@ -1070,28 +1233,12 @@ NrrdImageIO::Write(const void * buffer)
   }
 
   // set encoding for data: compressed (raw), (uncompressed) raw, or ascii
-  if (this->GetUseCompression() == true && this->m_NrrdCompressionEncoding != nullptr &&
-      this->m_NrrdCompressionEncoding->available())
+  nio->encoding = this->GetWriteEncoding();
+  if (nio->encoding->isCompression)
   {
-    nio->encoding = this->m_NrrdCompressionEncoding;
     nio->zlibLevel = this->GetCompressionLevel();
     // nio->zlibStrategy = default
   }
-  else
-  {
-    Superclass::IOFileEnum fileType = this->GetFileType();
-    switch (fileType)
-    {
-      default:
-      case IOFileEnum::TypeNotApplicable:
-      case IOFileEnum::Binary:
-        nio->encoding = nrrdEncodingRaw;
-        break;
-      case IOFileEnum::ASCII:
-        nio->encoding = nrrdEncodingAscii;
-        break;
-    }
-  }
 
   // set desired endianness of output
   Superclass::IOByteOrderEnum byteOrder = this->GetByteOrder();
@@ -1109,6 +1256,89 @@ NrrdImageIO::Write(const void * buffer)
       break;
   }
 
+  if (streamed)
+  {
+    const SizeValueType pixelSize = nrrdElementSize(nrrd) * this->GetNumberOfComponents();
+    const int           nrrdType = nrrd->type;
+    if (this->m_StreamedDataFileName.empty())
+    {
+      // the first piece: write the header only, and find the data file that
+      // the pieces are written into
+      this->m_StreamedSwapBytes =
+        airEndianUnknown != nio->endian && 1 < nrrdElementSize(nrrd) && nio->endian != airMyEndian();
+      nrrdIoStateSet(nio, nrrdIoStateSkipData, 1);
+      const int   error = nrrdSave(this->GetFileName(), nrrd, nio);
+      std::string dataFileName = this->GetFileName();
+      if (!error && nio->dataFNArr->len > 0)
+      {
+        dataFileName = nio->dataFN[0];
+        if (!itksys::SystemTools::FileIsFullPath(dataFileName) && airStrlen(nio->path))
+        {
+          dataFileName = std::string(nio->path) + "/" + dataFileName;
+        }
+      }
+      nrrdNix(nrrd);
+      nrrdIoStateNix(nio);
+      if (error)
+      {
+        char * err = biffGetDone(NRRD); // would be nice to free(err)
+        itkExceptionMacro("Write: Error writing " << this->GetFileName() << ":\n" << err);
+      }
+
+      this->m_StreamedDataFileName = dataFileName;
+      this->m_StreamedDataOffset = 0;
+      this->m_StreamedNextOffset = 0;
+      std::ofstream file;
+      if (dataFileName == this->GetFileName())
+      {
+        // attached header: the data follows it
+        this->m_StreamedDataOffset = itksys::SystemTools::FileLength(dataFileName);
+        this->OpenFileForWriting(file, dataFileName, false);
+      }
+      else
+      {
+        this->OpenFileForWriting(file, dataFileName, true);
+      }
+      if (!this->GetWriteEncoding()->isCompression)
+      {
+        // write the last byte of the data, so that the pieces can be written
+        // anywhere in it
+        file.seekp(static_cast<std::streamoff>(this->m_StreamedDataOffset + this->GetImageSizeInPixels() * pixelSize -
+                                               1));
+        file.write("\0", 1);
+      }
+    }
+    else
+    {
+      nrrdNix(nrrd);
+      nrrdIoStateNix(nio);
+    }
+
+    // the pieces are saved in the byte order declared by the header
+    std::vector<char> swappedBuffer;
+    if (this->m_StreamedSwapBytes)
+    {
+      const SizeValueType numberOfBytes = ioRegion.GetNumberOfPixels() * pixelSize;
+      swappedBuffer.assign(static_cast<const char *>(buffer), static_cast<const char *>(buffer) + numberOfBytes);
+      Nrrd * piece = nrrdNew();
+      if (nrrdWrap_va(piece,
+                      swappedBuffer.data(),
+                      nrrdType,
+                      1,
+                      static_cast<size_t>(ioRegion.GetNumberOfPixels() * this->GetNumberOfComponents())))
+      {
+        nrrdNix(piece);
+        char * err = biffGetDone(NRRD); // would be nice to free(err)
+        itkExceptionMacro("Write: Error wrapping data for swapping bytes:\n" << err);
+      }
+      nrrdSwapEndian(piece);
+      nrrdNix(piece);
+      buffer = swappedBuffer.data();
+    }
+    this->WriteIORegion(buffer, pixelSize);
+    return;
+  }
+
   // Write the nrrd to file.
   if (nrrdSave(this->GetFileName(), nrrd, nio))
   {
@@ -1121,4 +1351,172 @@ NrrdImageIO::Write(const void * buffer)
   nrrdIoStateNix(nio);
 }
 
+const NrrdEncoding_t *
+NrrdImageIO::GetWriteEncoding() const
+{
+  if (this->GetUseCompression() == true && this->m_NrrdCompressionEncoding != nullptr &&
+      this->m_NrrdCompressionEncoding->available())
+  {
+    return this->m_NrrdCompressionEncoding;
+  }
+  switch (this->GetFileType())
+  {
+    default:
+    case IOFileEnum::TypeNotApplicable:
+    case IOFileEnum::Binary:
+      return nrrdEncodingRaw;
+    case IOFileEnum::ASCII:
+      return nrrdEncodingAscii;
+  }
+}
+
+bool
+NrrdImageIO::CanStreamWrite()
+{
+  const NrrdEncoding_t * encoding = this->GetWriteEncoding();
+  return encoding == nrrdEncodingRaw || encoding == nrrdEncodingGzip;
+}
+
+unsigned int
+NrrdImageIO::GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                               const ImageIORegion & pasteRegion,
+                                               const ImageIORegion & largestPossibleRegion)
+{
+  this->m_StreamedDataFileName.clear();
+  this->m_StreamedSwapBytes = false;
+  if (!this->CanStreamWrite())
+  {
+    return Superclass::GetActualNumberOfSplitsForWriting(numberOfRequestedSplits, pasteRegion, largestPossibleRegion);
+  }
+
+  if (this->GetWriteEncoding()->isCompression)
+  {
+    // compressed data can only be written from its start to its end
+    if (pasteRegion != largestPossibleRegion)
+    {
+      itkExceptionMacro("Pasting and compression is not supported! Can't write:" << this->GetFileName());
+    }
+  }
+  else if (pasteRegion != largestPossibleRegion && itksys::SystemTools::FileExists(this->GetFileName()))
+  {
+    // we are going to paste into the existing file, which must hold raw data
+    // of the same size and pixel type, with the same geometry
+    std::string errorMessage;
+    Pointer     headerImageIOReader = Self::New();
+    try
+    {
+      headerImageIOReader->SetFileName(this->GetFileName());
+      headerImageIOReader->ReadImageInformation();
+    }
+    catch (...)
+    {
+      errorMessage = "Unable to read information from file: " + std::string(this->GetFileName());
+    }
+
+    const IOComponentEnum componentType =
+      (this->GetComponentType() == IOComponentEnum::FLOAT16) ? IOComponentEnum::FLOAT : this->GetComponentType();
+    if (!errorMessage.empty())
+    {
+      // Can't read file
+    }
+    else if (headerImageIOReader->m_DataFileName.empty() || headerImageIOReader->m_DataEncoding != nrrdEncodingRaw ||
+             headerImageIOReader->m_DataSwapBytes)
+    {
+      errorMessage = "File is not raw data in native byte order: " + std::string(this->GetFileName());
+    }
+    else if (headerImageIOReader->GetNumberOfComponents() != this->GetNumberOfComponents() ||
+             headerImageIOReader->GetComponentType() != componentType)
+    {
+      errorMessage = "Component type does not match in file: " + std::string(this->GetFileName());
+    }
+    else if (headerImageIOReader->GetNumberOfDimensions() != this->GetNumberOfDimensions())
+    {
+      errorMessage = "Dimensions does not match in file: " + std::string(this->GetFileName());
+    }
+    else
+    {
+      for (unsigned int i = 0; i < this->GetNumberOfDimensions() && errorMessage.empty(); ++i)
+      {
+        if (headerImageIOReader->GetDimensions(i) != this->GetDimensions(i) ||
+            Math::NotAlmostEquals(headerImageIOReader->GetSpacing(i), this->GetSpacing(i)) ||
+            Math::NotAlmostEquals(headerImageIOReader->GetOrigin(i), this->GetOrigin(i)))
+        {
+          errorMessage = "Size, spacing or origin does not match in file: " + std::string(this->GetFileName());
+        }
+        for (unsigned int j = 0; j < this->GetNumberOfDimensions() && errorMessage.empty(); ++j)
+        {
+          if (Math::NotAlmostEquals(headerImageIOReader->GetDirection(i)[j], this->GetDirection(i)[j]))
+          {
+            errorMessage = "Direction cosines does not match in file: " + std::string(this->GetFileName());
+          }
+        }
+      }
+    }
+    if (!errorMessage.empty())
+    {
+      itkExceptionMacro("Unable to paste because pasting file exists and is different. " << errorMessage);
+    }
+
+    // the data is pasted into the data file of the existing header
+    this->m_StreamedDataFileName = headerImageIOReader->m_DataFileName;
+    this->m_StreamedDataOffset = headerImageIOReader->m_DataOffset;
+  }
+
+  return GetActualNumberOfSplitsForWritingCanStreamWrite(numberOfRequestedSplits, pasteRegion);
+}
+
+void
+NrrdImageIO::WriteIORegion(const void * buffer, SizeValueType pixelSize)
+{
+  // The data is laid out like the ITK buffer.
+  const GzipSeekIndex::RangeListType ranges =
+    GzipSeekIndex::ComputeRegionRanges(this->GetIORegion(), this->m_Dimensions, pixelSize);
+
+  const auto * data = static_cast<const char *>(buffer);
+  if (this->GetWriteEncoding()->isCompression)
+  {
+    // compressed data is appended piece by piece, each as a gzip member
+    if (ranges.size() != 1 || ranges.front().first != this->m_StreamedNextOffset)
+    {
+      itkExceptionMacro("Pieces of compressed data must be written in order, from start to end, to file: "
+                        << this->m_StreamedDataFileName);
+    }
+    FILE * file = fopen(this->m_StreamedDataFileName.c_str(), "ab");
+    if (file == nullptr)
+    {
+      itkExceptionMacro("Unable to open file for appending: " << this->m_StreamedDataFileName);
+    }
+    Nrrd *        nrrd = nrrdNew();
+    NrrdIoState * nio = nrrdIoStateNew();
+    nio->encoding = this->GetWriteEncoding();
+    nio->zlibLevel = this->GetCompressionLevel();
+    const size_t numberOfBytes = ranges.front().second;
+    const int    error = nrrdWrap_va(nrrd, const_cast<char *>(data), nrrdTypeUChar, 1, numberOfBytes) ||
+                      nio->encoding->write(file, data, numberOfBytes, nrrd, nio);
+    nrrdNix(nrrd);
+    nrrdIoStateNix(nio);
+    if (fclose(file) != 0 || error)
+    {
+      char * err = biffGetDone(NRRD); // would be nice to free(err)
+      itkExceptionMacro("Write: Error writing " << this->m_StreamedDataFileName << ":\n" << err);
+    }
+    this->m_StreamedNextOffset += numberOfBytes;
+  }
+  else
+  {
+    std::ofstream file;
+    this->OpenFileForWriting(file, this->m_StreamedDataFileName, false);
+    for (const auto & range : ranges)
+    {
+      file.seekp(static_cast<std::streamoff>(this->m_StreamedDataOffset + range.first));
+      file.write(data, static_cast<std::streamsize>(range.second));
+      data += range.second;
+    }
+    if (file.fail())
+    {
+      itkExceptionMacro("Error writing to file: " << this->m_StreamedDataFileName);
+    }
+  }
+}
+
 } // end namespace itk
@@ -0,0 +1,208 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkNrrdImageIO.h"
+#include "itkPipelineMonitorImageFilter.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+#include "itkVector.h"
+#include "itksys/SystemTools.hxx"
+
+// Writes gzip-encoded nrrd files with attached and detached headers, and
+// checks that regions read through a GzipSeekIndex are correct, and that
+// the images can be read in pieces.
+namespace
+{
+using PixelType = itk::Vector<float, 2>;
+using ImageType = itk::Image<PixelType, 3>;
+
+PixelType
+GetExpectedPixel(const ImageType::IndexType & index)
+{
+  PixelType pixel;
+  pixel[0] = static_cast<float>(index[0] * 3 + index[1] * 7 + index[2] * 11);
+  pixel[1] = static_cast<float>((index[0] * index[1] + index[2]) % 97);
+  return pixel;
+}
+
+bool
+CheckPixels(const ImageType * image, const ImageType::RegionType & region)
+{
+  if (image->GetBufferedRegion() != region)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Expected buffered region " << region << ", but got " << image->GetBufferedRegion() << std::endl;
+    return false;
+  }
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != GetExpectedPixel(it.GetIndex()))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error at index " << it.GetIndex() << ": expected " << GetExpectedPixel(it.GetIndex())
+                << ", but got " << it.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+CheckFile(const std::string & fileName, const std::string & indexFileName)
+{
+  const ImageType::RegionType regions[] = {
+    ImageType::RegionType(ImageType::IndexType{ { 5, 7, 11 } }, ImageType::SizeType{ { 30, 20, 17 } }),
+    ImageType::RegionType(ImageType::IndexType{ { 0, 0, 29 } }, ImageType::SizeType{ { 64, 48, 1 } }),
+    ImageType::RegionType(ImageType::IndexType{ { 63, 3, 2 } }, ImageType::SizeType{ { 1, 1, 25 } })
+  };
+  for (const auto & region : regions)
+  {
+    auto nrrdImageIO = itk::NrrdImageIO::New();
+    nrrdImageIO->UseGzipSeekIndexOn();
+    nrrdImageIO->SetGzipSeekIndexFileName(indexFileName);
+
+    auto reader = itk::ImageFileReader<ImageType>::New();
+    reader->SetImageIO(nrrdImageIO);
+    reader->SetFileName(fileName);
+    reader->UpdateOutputInformation();
+    if (!nrrdImageIO->CanStreamRead())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << fileName << " cannot be read through a GzipSeekIndex" << std::endl;
+      return false;
+    }
+    reader->GetOutput()->SetRequestedRegion(region);
+    reader->Update();
+    if (!CheckPixels(reader->GetOutput(), region))
+    {
+      return false;
+    }
+  }
+
+  // Read the whole image in pieces.
+  auto nrrdImageIO = itk::NrrdImageIO::New();
+  nrrdImageIO->UseGzipSeekIndexOn();
+  nrrdImageIO->SetGzipSeekIndexFileName(indexFileName);
+
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetImageIO(nrrdImageIO);
+  reader->SetFileName(fileName);
+
+  auto monitor = itk::PipelineMonitorImageFilter<ImageType>::New();
+  monitor->SetInput(reader->GetOutput());
+
+  constexpr unsigned int numberOfStreamDivisions = 4;
+  auto                   streamer = itk::StreamingImageFilter<ImageType, ImageType>::New();
+  streamer->SetInput(monitor->GetOutput());
+  streamer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+  streamer->Update();
+  return monitor->VerifyAllInputCanStream(numberOfStreamDivisions) &&
+         CheckPixels(streamer->GetOutput(), streamer->GetOutput()->GetLargestPossibleRegion());
+}
+} // namespace
+
+int
+itkNrrdImageIOGzipSeekIndexTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " OutputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string directory = argv[1];
+
+  auto nrrdImageIO = itk::NrrdImageIO::New();
+  ITK_TEST_EXPECT_TRUE(!nrrdImageIO->GetUseGzipSeekIndex());
+  ITK_TEST_SET_GET_BOOLEAN(nrrdImageIO, UseGzipSeekIndex, true);
+  nrrdImageIO->SetGzipSeekIndexFileName("index.idx");
+  ITK_TEST_EXPECT_EQUAL(nrrdImageIO->GetGzipSeekIndexFileName(), std::string("index.idx"));
+
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 64, 48, 30 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(GetExpectedPixel(it.GetIndex()));
+  }
+
+  bool success = true;
+  for (const std::string extension : { ".nrrd", ".nhdr" })
+  {
+    const std::string fileName = directory + "/itkNrrdImageIOGzipSeekIndexTest" + extension;
+    const std::string indexFileName = fileName + ".idx";
+    itksys::SystemTools::RemoveFile(indexFileName);
+
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetInput(image);
+    writer->SetFileName(fileName);
+    writer->UseCompressionOn();
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+    ITK_TRY_EXPECT_NO_EXCEPTION(success = CheckFile(fileName, "") && CheckFile(fileName, indexFileName));
+    if (!success)
+    {
+      return EXIT_FAILURE;
+    }
+    ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileExists(indexFileName));
+  }
+
+  // A region of a 2D file is read into a 3D image.
+  using SliceType = itk::Image<PixelType, 2>;
+  auto slice = SliceType::New();
+  slice->SetRegions(SliceType::SizeType{ { 64, 48 } });
+  slice->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<SliceType> it(slice, slice->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(GetExpectedPixel(ImageType::IndexType{ { it.GetIndex()[0], it.GetIndex()[1], 0 } }));
+  }
+  const std::string sliceFileName = directory + "/itkNrrdImageIOGzipSeekIndexTestSlice.nrrd";
+  auto              sliceWriter = itk::ImageFileWriter<SliceType>::New();
+  sliceWriter->SetInput(slice);
+  sliceWriter->SetFileName(sliceFileName);
+  sliceWriter->UseCompressionOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(sliceWriter->Update());
+
+  auto sliceImageIO = itk::NrrdImageIO::New();
+  sliceImageIO->UseGzipSeekIndexOn();
+  auto sliceReader = itk::ImageFileReader<ImageType>::New();
+  sliceReader->SetImageIO(sliceImageIO);
+  sliceReader->SetFileName(sliceFileName);
+  const ImageType::RegionType sliceRegion(ImageType::IndexType{ { 5, 7, 0 } }, ImageType::SizeType{ { 30, 20, 1 } });
+  ITK_TRY_EXPECT_NO_EXCEPTION(sliceReader->UpdateOutputInformation());
+  sliceReader->GetOutput()->SetRequestedRegion(sliceRegion);
+  ITK_TRY_EXPECT_NO_EXCEPTION(sliceReader->Update());
+  if (!CheckPixels(sliceReader->GetOutput(), sliceRegion))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Without the option, images are read at once.
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetImageIO(itk::NrrdImageIO::New());
+  reader->SetFileName(directory + "/itkNrrdImageIOGzipSeekIndexTest.nrrd");
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->UpdateOutputInformation());
+  ITK_TEST_EXPECT_TRUE(!reader->GetImageIO()->CanStreamRead());
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
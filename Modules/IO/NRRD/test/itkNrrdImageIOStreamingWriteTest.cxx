@@ -0,0 +1,260 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkByteSwapper.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkNrrdImageIO.h"
+#include "itkPipelineMonitorImageFilter.h"
+#include "itkTestingMacros.h"
+#include "itkVector.h"
+
+// Writes scalar and vector images in pieces to raw and gzip-encoded nrrd
+// files with attached and detached headers, in the native and the other
+// byte order, pastes a region into an existing file, and checks the images
+// read back.
+namespace
+{
+void
+SetPixelValue(short & pixel, int value)
+{
+  pixel = static_cast<short>(value);
+}
+
+void
+SetPixelValue(itk::Vector<float, 3> & pixel, int value)
+{
+  for (unsigned int c = 0; c < 3; ++c)
+  {
+    pixel[c] = static_cast<float>(value + 1000 * c);
+  }
+}
+
+template <typename TImage>
+typename TImage::PixelType
+GetExpectedPixel(const typename TImage::IndexType & index, int sign)
+{
+  typename TImage::PixelType pixel;
+  SetPixelValue(pixel, sign * static_cast<int>(index[0] + 7 * index[1] + 13 * index[2]));
+  return pixel;
+}
+
+// Writes at once a gzip-encoded image to read the images to write in pieces
+// from, through a GzipSeekIndex.
+template <typename TImage>
+void
+WriteSourceImage(const std::string & fileName, int sign)
+{
+  auto image = TImage::New();
+  image->SetRegions(typename TImage::SizeType{ { 32, 24, 20 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(GetExpectedPixel<TImage>(it.GetIndex(), sign));
+  }
+  auto writer = itk::ImageFileWriter<TImage>::New();
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  writer->UseCompressionOn();
+  writer->Update();
+}
+
+// Writes the image of the source file, which is read in the pieces the
+// writer asks for.
+template <typename TImage>
+bool
+WriteImage(const std::string &                 sourceFileName,
+           const std::string &                 fileName,
+           bool                                useCompression,
+           unsigned int                        numberOfStreamDivisions,
+           const typename TImage::RegionType * pasteRegion,
+           itk::IOByteOrderEnum                byteOrder = itk::IOByteOrderEnum::OrderNotApplicable)
+{
+  auto sourceImageIO = itk::NrrdImageIO::New();
+  sourceImageIO->UseGzipSeekIndexOn();
+
+  auto reader = itk::ImageFileReader<TImage>::New();
+  reader->SetImageIO(sourceImageIO);
+  reader->SetFileName(sourceFileName);
+  reader->UpdateOutputInformation();
+
+  auto monitor = itk::PipelineMonitorImageFilter<TImage>::New();
+  monitor->SetInput(reader->GetOutput());
+
+  auto nrrdImageIO = itk::NrrdImageIO::New();
+  nrrdImageIO->SetByteOrder(byteOrder);
+
+  auto writer = itk::ImageFileWriter<TImage>::New();
+  writer->SetInput(monitor->GetOutput());
+  writer->SetImageIO(nrrdImageIO);
+  writer->SetFileName(fileName);
+  writer->SetUseCompression(useCompression);
+  writer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+  if (pasteRegion != nullptr)
+  {
+    itk::ImageIORegion ioRegion(TImage::ImageDimension);
+    itk::ImageIORegionAdaptor<TImage::ImageDimension>::Convert(
+      *pasteRegion, ioRegion, reader->GetOutput()->GetLargestPossibleRegion().GetIndex());
+    writer->SetIORegion(ioRegion);
+  }
+  writer->Update();
+
+  if (monitor->GetNumberOfUpdates() != numberOfStreamDivisions ||
+      (numberOfStreamDivisions > 1 && !monitor->VerifyAllInputCanStream(numberOfStreamDivisions)))
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Expected " << fileName << " to be written in " << numberOfStreamDivisions << " pieces, but got "
+              << monitor->GetNumberOfUpdates() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Reads the image back, and checks its pixels, which are those of the first
+// image, or of the second one in the pasted region.
+template <typename TImage>
+bool
+CheckImage(const std::string &                 fileName,
+           const typename TImage::RegionType & pastedRegion,
+           itk::IOByteOrderEnum                byteOrder = itk::IOByteOrderEnum::OrderNotApplicable)
+{
+  auto reader = itk::ImageFileReader<TImage>::New();
+  reader->SetFileName(fileName);
+  reader->Update();
+  if (byteOrder != itk::IOByteOrderEnum::OrderNotApplicable && reader->GetImageIO()->GetByteOrder() != byteOrder)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Expected " << fileName << " in byte order " << byteOrder << ", but got "
+              << reader->GetImageIO()->GetByteOrder() << std::endl;
+    return false;
+  }
+  const TImage * image = reader->GetOutput();
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto expected = GetExpectedPixel<TImage>(it.GetIndex(), pastedRegion.IsInside(it.GetIndex()) ? -1 : 1);
+    if (it.Get() != expected)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error in " << fileName << " at index " << it.GetIndex() << ": expected " << expected
+                << ", but got " << it.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename TImage>
+bool
+TestImage(const std::string & fileNamePrefix)
+{
+  const std::string sourceFileName = fileNamePrefix + "Source.nrrd";
+  const std::string otherSourceFileName = fileNamePrefix + "OtherSource.nrrd";
+  WriteSourceImage<TImage>(sourceFileName, 1);
+  WriteSourceImage<TImage>(otherSourceFileName, -1);
+
+  const typename TImage::RegionType noRegion;
+  const itk::IOByteOrderEnum        otherByteOrder = itk::ByteSwapper<short>::SystemIsBigEndian()
+                                                       ? itk::IOByteOrderEnum::LittleEndian
+                                                       : itk::IOByteOrderEnum::BigEndian;
+  const typename TImage::RegionType pasteRegion(typename TImage::IndexType{ { 3, 5, 7 } },
+                                                typename TImage::SizeType{ { 20, 10, 9 } });
+
+  for (const std::string extension : { ".nrrd", ".nhdr" })
+  {
+    // streaming, then pasting into the raw files
+    std::string fileName = fileNamePrefix + extension;
+    if (!WriteImage<TImage>(sourceFileName, fileName, false, 4, nullptr) || !CheckImage<TImage>(fileName, noRegion) ||
+        !WriteImage<TImage>(otherSourceFileName, fileName, false, 3, &pasteRegion) ||
+        !CheckImage<TImage>(fileName, pasteRegion))
+    {
+      return false;
+    }
+
+    // streaming into the gzip-encoded files, which cannot be pasted into
+    fileName = fileNamePrefix + "Compressed" + extension;
+    if (!WriteImage<TImage>(sourceFileName, fileName, true, 4, nullptr) || !CheckImage<TImage>(fileName, noRegion))
+    {
+      return false;
+    }
+    try
+    {
+      WriteImage<TImage>(otherSourceFileName, fileName, true, 1, &pasteRegion);
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Pasting into " << fileName << " should have failed" << std::endl;
+      return false;
+    }
+    catch (const itk::ExceptionObject & exception)
+    {
+      std::cout << "Expected exception caught: " << exception.GetDescription() << std::endl;
+    }
+    if (!CheckImage<TImage>(fileName, noRegion))
+    {
+      return false;
+    }
+
+    // streaming in the other byte order, which the pieces are swapped to
+    for (const bool useCompression : { false, true })
+    {
+      fileName = fileNamePrefix + (useCompression ? "SwappedCompressed" : "Swapped") + extension;
+      if (!WriteImage<TImage>(sourceFileName, fileName, useCompression, 4, nullptr, otherByteOrder) ||
+          !CheckImage<TImage>(fileName, noRegion, otherByteOrder))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkNrrdImageIOStreamingWriteTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " OutputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string directory = argv[1];
+
+  auto nrrdImageIO = itk::NrrdImageIO::New();
+  ITK_TEST_EXPECT_TRUE(nrrdImageIO->CanStreamWrite());
+  nrrdImageIO->UseCompressionOn();
+  ITK_TEST_EXPECT_TRUE(nrrdImageIO->CanStreamWrite());
+  nrrdImageIO->UseCompressionOff();
+  nrrdImageIO->SetFileTypeToASCII();
+  ITK_TEST_EXPECT_TRUE(!nrrdImageIO->CanStreamWrite());
+
+  using ScalarImageType = itk::Image<short, 3>;
+  using VectorImageType = itk::Image<itk::Vector<float, 3>, 3>;
+
+  bool success = true;
+  ITK_TRY_EXPECT_NO_EXCEPTION(
+    success = TestImage<ScalarImageType>(directory + "/itkNrrdImageIOStreamingWriteTestScalar") &&
+              TestImage<VectorImageType>(directory + "/itkNrrdImageIOStreamingWriteTestVector"));
+  if (!success)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
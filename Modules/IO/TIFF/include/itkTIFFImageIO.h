@@ -38,6 +38,16 @@ class TIFFReaderInternal;
  * supports the compression level for JPEG quality parameter in the
  * range 0-100.
  *
+ * Float16 components are read and written as 16-bit IEEE floating point
+ * samples.
+ *
+ * Striped and tiled images, including multi-page and BigTIFF files, are read
+ * natively: the strips or tiles are decoded on the threads of the
+ * multi-threader, and a streamed read decodes only those that intersect the
+ * requested region. Images are written in strips, or in tiles when a TileSize
+ * is set, which are compressed in parallel, and a streamed write of a
+ * multi-page image writes it a range of pages at a time.
+ *
  * \ingroup IOFilters
  * \ingroup ITKIOTIFF
  *
@@ -83,6 +93,19 @@ public:
   virtual void
   ReadVolume(void * buffer);
 
+  /** Returns true when the file, whose information has been read, is read
+   * natively, in which case any region of it can be read. */
+  bool
+  CanStreamRead() override
+  {
+    return m_CanStreamRead;
+  }
+
+  /** The streamable region is the requested region when the file can be
+   * streamed, and the largest possible region otherwise. */
+  ImageIORegion
+  GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const override;
+
   /*-------- This part of the interfaces deals with writing data. ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -100,6 +123,32 @@ public:
   void
   Write(const void * buffer) override;
 
+  /** Multi-page images are written a range of pages at a time: the pages of
+   * the IORegion are appended to those already written. */
+  bool
+  CanStreamWrite() override
+  {
+    return true;
+  }
+
+  /** A multi-page image is split into ranges of pages. Pasting is not
+   * supported. */
+  unsigned int
+  GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                    const ImageIORegion & pasteRegion,
+                                    const ImageIORegion & largestPossibleRegion) override;
+
+  ImageIORegion
+  GetSplitRegionForWriting(unsigned int          ithPiece,
+                           unsigned int          numberOfActualSplits,
+                           const ImageIORegion & pasteRegion,
+                           const ImageIORegion & largestPossibleRegion) override;
+
+  /** Set/Get the width and height of the tiles of the written images, which
+   * must be a multiple of 16. The default, 0, writes the images in strips. */
+  itkSetMacro(TileSize, unsigned int);
+  itkGetConstMacro(TileSize, unsigned int);
+
   enum
   {
     NOFORMAT,
@@ -259,6 +308,16 @@ private:
   void
   ReadGenericImage(void * out, unsigned int width, unsigned int height);
 
+  // Reads the region, in the first two dimensions, of the pages whose
+  // directories are at the offsets, decoding their strips or tiles in
+  // parallel.
+  void
+  ReadPages(void * out, const std::vector<uint64_t> & pageOffsets, const ImageIORegion & region);
+
+  template <typename TComponent>
+  void
+  ReadPages(void * out, const std::vector<uint64_t> & pageOffsets, const ImageIORegion & region);
+
   template <typename TComponent>
   void
   RGBAImageToBuffer(void * out, const uint32_t * tempImage);
@@ -309,6 +368,8 @@ private:
   uint16_t *   m_ColorBlue;
   uint64_t     m_TotalColors{ 0 };
   unsigned int m_ImageFormat{ TIFFImageIO::NOFORMAT };
+  bool         m_CanStreamRead{ false };
+  unsigned int m_TileSize{ 0 };
 };
 } // end namespace itk
 
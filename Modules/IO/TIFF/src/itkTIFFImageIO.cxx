@@ -20,12 +20,293 @@
 #include "itkTIFFReaderInternal.h"
 #include "itksys/SystemTools.hxx"
 #include "itkMetaDataObject.h"
+#include "itkMultiThreaderBase.h"
 
 #include "itk_tiff.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
 namespace itk
 {
 
+namespace
+{
+// An in-memory file, into which the strips or tiles of a page are compressed
+// on the threads of the multi-threader, before being written raw to the file.
+struct TIFFMemoryFile
+{
+  std::vector<char> m_Data;
+  toff_t            m_Position{ 0 };
+};
+
+tmsize_t
+TIFFMemoryFileRead(thandle_t, void *, tmsize_t)
+{
+  return 0;
+}
+
+tmsize_t
+TIFFMemoryFileWrite(thandle_t handle, void * data, tmsize_t size)
+{
+  auto * const file = static_cast<TIFFMemoryFile *>(handle);
+  if (file->m_Position + size > file->m_Data.size())
+  {
+    file->m_Data.resize(static_cast<size_t>(file->m_Position + size));
+  }
+  std::memcpy(file->m_Data.data() + file->m_Position, data, static_cast<size_t>(size));
+  file->m_Position += size;
+  return size;
+}
+
+toff_t
+TIFFMemoryFileSeek(thandle_t handle, toff_t offset, int whence)
+{
+  auto * const file = static_cast<TIFFMemoryFile *>(handle);
+  switch (whence)
+  {
+    case SEEK_CUR:
+      file->m_Position += offset;
+      break;
+    case SEEK_END:
+      file->m_Position = file->m_Data.size() + offset;
+      break;
+    default:
+      file->m_Position = offset;
+  }
+  return file->m_Position;
+}
+
+int
+TIFFMemoryFileClose(thandle_t)
+{
+  return 0;
+}
+
+toff_t
+TIFFMemoryFileSize(thandle_t handle)
+{
+  return static_cast<TIFFMemoryFile *>(handle)->m_Data.size();
+}
+
+int
+TIFFMemoryFileMap(thandle_t, void **, toff_t *)
+{
+  return 0;
+}
+
+void
+TIFFMemoryFileUnmap(thandle_t, void *, toff_t)
+{}
+
+// Copies the fields the compression of the strips or tiles of a page depends
+// on. The JPEG tables are written in every strip or tile, as the JPEGTables
+// field is not written by the raw writing of the strips or tiles.
+void
+CopyEncodingFields(TIFF * const from, TIFF * const to)
+{
+  uint32 width = 0;
+  uint32 height = 0;
+  TIFFGetField(from, TIFFTAG_IMAGEWIDTH, &width);
+  TIFFGetField(from, TIFFTAG_IMAGELENGTH, &height);
+  TIFFSetField(to, TIFFTAG_IMAGEWIDTH, width);
+  TIFFSetField(to, TIFFTAG_IMAGELENGTH, height);
+  for (const ttag_t tag : { TIFFTAG_BITSPERSAMPLE,
+                            TIFFTAG_SAMPLESPERPIXEL,
+                            TIFFTAG_SAMPLEFORMAT,
+                            TIFFTAG_PLANARCONFIG,
+                            TIFFTAG_PHOTOMETRIC,
+                            TIFFTAG_COMPRESSION })
+  {
+    uint16 value = 0;
+    if (TIFFGetField(from, tag, &value))
+    {
+      TIFFSetField(to, tag, value);
+    }
+  }
+
+  uint16   extraSamplesCount = 0;
+  uint16 * extraSamples = nullptr;
+  if (TIFFGetField(from, TIFFTAG_EXTRASAMPLES, &extraSamplesCount, &extraSamples))
+  {
+    TIFFSetField(to, TIFFTAG_EXTRASAMPLES, extraSamplesCount, extraSamples);
+  }
+
+  if (TIFFIsTiled(from))
+  {
+    uint32 tileWidth = 0;
+    uint32 tileHeight = 0;
+    TIFFGetField(from, TIFFTAG_TILEWIDTH, &tileWidth);
+    TIFFGetField(from, TIFFTAG_TILELENGTH, &tileHeight);
+    TIFFSetField(to, TIFFTAG_TILEWIDTH, tileWidth);
+    TIFFSetField(to, TIFFTAG_TILELENGTH, tileHeight);
+  }
+  else
+  {
+    uint32 rowsPerStrip = 0;
+    TIFFGetFieldDefaulted(from, TIFFTAG_ROWSPERSTRIP, &rowsPerStrip);
+    TIFFSetField(to, TIFFTAG_ROWSPERSTRIP, rowsPerStrip);
+  }
+
+  uint16 compression = COMPRESSION_NONE;
+  TIFFGetFieldDefaulted(from, TIFFTAG_COMPRESSION, &compression);
+  if (compression == COMPRESSION_JPEG)
+  {
+    int jpegQuality = 0;
+    int jpegColorMode = 0;
+    TIFFGetField(from, TIFFTAG_JPEGQUALITY, &jpegQuality);
+    TIFFGetField(from, TIFFTAG_JPEGCOLORMODE, &jpegColorMode);
+    TIFFSetField(to, TIFFTAG_JPEGQUALITY, jpegQuality);
+    TIFFSetField(to, TIFFTAG_JPEGCOLORMODE, jpegColorMode);
+    TIFFSetField(to, TIFFTAG_JPEGTABLESMODE, 0);
+  }
+  else if (compression == COMPRESSION_DEFLATE)
+  {
+    uint16 predictor = PREDICTOR_NONE;
+    TIFFGetField(from, TIFFTAG_PREDICTOR, &predictor);
+    TIFFSetField(to, TIFFTAG_PREDICTOR, predictor);
+  }
+}
+
+// Writes the strips or tiles of the current page of the file from the pixels
+// of the page. The strips or tiles are compressed in parallel, in batches of
+// a few per work unit, and written in order.
+bool
+WritePageBlocks(TIFF * const tif, const char * const buffer, MultiThreaderBase * const multiThreader)
+{
+  uint32 width = 0;
+  uint32 height = 0;
+  TIFFGetField(tif, TIFFTAG_IMAGEWIDTH, &width);
+  TIFFGetField(tif, TIFFTAG_IMAGELENGTH, &height);
+  const bool tiled = TIFFIsTiled(tif) != 0;
+  uint32     blockWidth = width;
+  uint32     blockHeight = height;
+  if (tiled)
+  {
+    TIFFGetField(tif, TIFFTAG_TILEWIDTH, &blockWidth);
+    TIFFGetField(tif, TIFFTAG_TILELENGTH, &blockHeight);
+  }
+  else
+  {
+    TIFFGetFieldDefaulted(tif, TIFFTAG_ROWSPERSTRIP, &blockHeight);
+    blockHeight = std::min(blockHeight, height);
+  }
+  const size_t   rowSize = static_cast<size_t>(TIFFScanlineSize(tif));
+  const size_t   pixelSize = rowSize / width;
+  const tmsize_t blockSize = tiled ? TIFFTileSize(tif) : TIFFStripSize(tif);
+  const uint32   blocksAcross = (width + blockWidth - 1) / blockWidth;
+  const uint32   numberOfBlocks = tiled ? TIFFNumberOfTiles(tif) : TIFFNumberOfStrips(tif);
+
+  // Copies the pixels of a block, and returns its size. The tiles across the
+  // right and bottom edges of the page are padded with zeros.
+  const auto copyBlock = [=](const uint32 block, char * const blockBuffer) -> tmsize_t {
+    const uint32 x = (block % blocksAcross) * blockWidth;
+    const uint32 y = (block / blocksAcross) * blockHeight;
+    const uint32 rows = std::min(blockHeight, height - y);
+    if (!tiled)
+    {
+      std::memcpy(blockBuffer, buffer + y * rowSize, rows * rowSize);
+      return static_cast<tmsize_t>(rows * rowSize);
+    }
+    const size_t columnsSize = std::min(blockWidth, width - x) * pixelSize;
+    std::fill_n(blockBuffer, blockSize, 0);
+    for (uint32 row = 0; row < rows; ++row)
+    {
+      std::memcpy(
+        blockBuffer + row * blockWidth * pixelSize, buffer + (y + row) * rowSize + x * pixelSize, columnsSize);
+    }
+    return blockSize;
+  };
+  const auto writeRawBlock = [=](const uint32 block, char * const data, const tmsize_t size) {
+    return (tiled ? TIFFWriteRawTile(tif, block, data, size) : TIFFWriteRawStrip(tif, block, data, size)) == size;
+  };
+
+  uint16 compression = COMPRESSION_NONE;
+  TIFFGetFieldDefaulted(tif, TIFFTAG_COMPRESSION, &compression);
+  if (compression == COMPRESSION_NONE)
+  {
+    std::vector<char> blockBuffer(static_cast<size_t>(blockSize));
+    for (uint32 block = 0; block < numberOfBlocks; ++block)
+    {
+      if (!writeRawBlock(block, blockBuffer.data(), copyBlock(block, blockBuffer.data())))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  const uint32                   batchSize = 4 * multiThreader->GetNumberOfWorkUnits();
+  std::vector<std::vector<char>> compressedBlocks(batchSize);
+  for (uint32 firstBlock = 0; firstBlock < numberOfBlocks; firstBlock += batchSize)
+  {
+    const uint32      numberOfBatchBlocks = std::min(batchSize, numberOfBlocks - firstBlock);
+    const uint32      numberOfChunks = std::min(numberOfBatchBlocks, multiThreader->GetNumberOfWorkUnits());
+    std::atomic<bool> compressed(true);
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfChunks,
+      [&](SizeValueType chunk) {
+        TIFFMemoryFile memoryFile;
+        TIFF * const   memoryTIFF = TIFFClientOpen("memory",
+                                                 "w",
+                                                 &memoryFile,
+                                                 TIFFMemoryFileRead,
+                                                 TIFFMemoryFileWrite,
+                                                 TIFFMemoryFileSeek,
+                                                 TIFFMemoryFileClose,
+                                                 TIFFMemoryFileSize,
+                                                 TIFFMemoryFileMap,
+                                                 TIFFMemoryFileUnmap);
+        if (!memoryTIFF)
+        {
+          compressed = false;
+          return;
+        }
+        CopyEncodingFields(tif, memoryTIFF);
+
+        std::vector<char> blockBuffer(static_cast<size_t>(blockSize));
+        const auto        chunkFirstBlock = static_cast<uint32>(chunk * numberOfBatchBlocks / numberOfChunks);
+        const auto        chunkEndBlock = static_cast<uint32>((chunk + 1) * numberOfBatchBlocks / numberOfChunks);
+        for (uint32 i = chunkFirstBlock; i < chunkEndBlock && compressed; ++i)
+        {
+          const uint32   block = firstBlock + i;
+          const tmsize_t size = copyBlock(block, blockBuffer.data());
+          if ((tiled ? TIFFWriteEncodedTile(memoryTIFF, block, blockBuffer.data(), size)
+                     : TIFFWriteEncodedStrip(memoryTIFF, block, blockBuffer.data(), size)) < 0)
+          {
+            compressed = false;
+            break;
+          }
+          uint64 * offsets = nullptr;
+          uint64 * byteCounts = nullptr;
+          TIFFGetField(memoryTIFF, tiled ? TIFFTAG_TILEOFFSETS : TIFFTAG_STRIPOFFSETS, &offsets);
+          TIFFGetField(memoryTIFF, tiled ? TIFFTAG_TILEBYTECOUNTS : TIFFTAG_STRIPBYTECOUNTS, &byteCounts);
+          const auto begin = memoryFile.m_Data.cbegin() + static_cast<std::ptrdiff_t>(offsets[block]);
+          compressedBlocks[i].assign(begin, begin + static_cast<std::ptrdiff_t>(byteCounts[block]));
+        }
+        TIFFClose(memoryTIFF);
+      },
+      nullptr);
+
+    if (!compressed)
+    {
+      return false;
+    }
+    for (uint32 i = 0; i < numberOfBatchBlocks; ++i)
+    {
+      if (!writeRawBlock(
+            firstBlock + i, compressedBlocks[i].data(), static_cast<tmsize_t>(compressedBlocks[i].size())))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace
+
 bool
 TIFFImageIO::CanReadFile(const char * file)
 {
@@ -75,6 +356,10 @@ TIFFImageIO::ReadGenericImage(void * out, unsigned int width, unsigned int heigh
   {
     this->ReadGenericImage<float>(out, width, height);
   }
+  else if (m_ComponentType == IOComponentEnum::FLOAT16)
+  {
+    this->ReadGenericImage<Float16>(out, width, height);
+  }
 }
 
 void
@@ -189,20 +474,87 @@ TIFFImageIO::Read(void * buffer)
     }
   }
 
-  // The IO region should be of dimensions 3 otherwise we read only the first
-  // page
-  if (m_InternalImage->m_NumberOfPages > 0 && this->GetIORegion().GetImageDimension() > 2)
+  if (!m_InternalImage->CanRead())
+  {
+    // The IO region should be of dimensions 3 otherwise we read only the first
+    // page
+    if (m_InternalImage->m_NumberOfPages > 0 && this->GetIORegion().GetImageDimension() > 2)
+    {
+      this->ReadVolume(buffer);
+    }
+    else
+    {
+      this->ReadCurrentPage(buffer, 0);
+    }
+
+    m_InternalImage->Clean();
+    return;
+  }
+
+  // Read the IO region of the pages, which are the directories that are not
+  // reduced images or masks. The IO region should be of dimensions 3
+  // otherwise we read only the first page.
+  const ImageIORegion & ioRegion = this->GetIORegion();
+  ImageIORegion         pageRegion(2);
+  for (unsigned int i = 0; i < 2; ++i)
   {
-    this->ReadVolume(buffer);
+    pageRegion.SetIndex(i, i < ioRegion.GetImageDimension() ? ioRegion.GetIndex(i) : 0);
+    pageRegion.SetSize(i, i < ioRegion.GetImageDimension() ? ioRegion.GetSize(i) : m_Dimensions[i]);
   }
-  else
+  SizeValueType firstPage = 0;
+  SizeValueType numberOfPages = 1;
+  if (this->GetNumberOfDimensions() > 2 && ioRegion.GetImageDimension() > 2)
+  {
+    firstPage = ioRegion.GetIndex(2);
+    numberOfPages = ioRegion.GetSize(2);
+  }
+
+  TIFF * const          tif = m_InternalImage->m_Image;
+  std::vector<uint64_t> pageOffsets;
+  SizeValueType         page = 0;
+  for (int directory = TIFFSetDirectory(tif, 0); directory && pageOffsets.size() < numberOfPages;
+       directory = TIFFReadDirectory(tif))
+  {
+    int32 subfiletype = 0;
+    if (m_InternalImage->m_IgnoredSubFiles > 0 && TIFFGetField(tif, TIFFTAG_SUBFILETYPE, &subfiletype) &&
+        (subfiletype & FILETYPE_REDUCEDIMAGE || subfiletype & FILETYPE_MASK))
+    {
+      continue;
+    }
+    if (page++ >= firstPage)
+    {
+      pageOffsets.push_back(TIFFCurrentDirOffset(tif));
+    }
+  }
+  if (pageOffsets.size() < numberOfPages)
   {
-    this->ReadCurrentPage(buffer, 0);
+    itkExceptionMacro(<< "Cannot read page " << firstPage + pageOffsets.size() << " of file " << m_FileName);
   }
 
+  // The palette is that of the first page.
+  TIFFSetSubDirectory(tif, pageOffsets.front());
+  this->InitializeColors();
+  this->ReadPages(buffer, pageOffsets, pageRegion);
+
   m_InternalImage->Clean();
 }
 
+ImageIORegion
+TIFFImageIO::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const
+{
+  ImageIORegion streamableRegion = Superclass::GenerateStreamableReadRegionFromRequestedRegion(requested);
+  if (m_UseStreamedReading && m_CanStreamRead)
+  {
+    const unsigned int dimensions = std::min(requested.GetImageDimension(), this->GetNumberOfDimensions());
+    for (unsigned int i = 0; i < dimensions; ++i)
+    {
+      streamableRegion.SetIndex(i, requested.GetIndex(i));
+      streamableRegion.SetSize(i, requested.GetSize(i));
+    }
+  }
+  return streamableRegion;
+}
+
 TIFFImageIO::TIFFImageIO()
   : m_ColorPalette(0)
 
@@ -248,6 +600,7 @@ TIFFImageIO::PrintSelf(std::ostream & os, Indent indent) const
 
   os << indent << "Compression: " << m_Compression << std::endl;
   os << indent << "JPEGQuality: " << this->GetJPEGQuality() << std::endl;
+  os << indent << "TileSize: " << m_TileSize << std::endl;
   if (!m_ColorPalette.empty())
   {
     os << indent << "Image RGB palette:"
@@ -407,6 +760,10 @@ TIFFImageIO::ReadImageInformation()
       m_ComponentType = IOComponentEnum::FLOAT;
     }
   }
+  else if (m_InternalImage->m_BitsPerSample == 16 && m_InternalImage->m_SampleFormat == 3)
+  {
+    m_ComponentType = IOComponentEnum::FLOAT16;
+  }
   else
   {
     if (m_InternalImage->m_SampleFormat == 2)
@@ -520,6 +877,8 @@ TIFFImageIO::ReadImageInformation()
     // make sure the palette is empty
     m_ColorPalette.resize(0);
   }
+
+  m_CanStreamRead = m_InternalImage->CanRead();
 }
 
 bool
@@ -552,6 +911,37 @@ TIFFImageIO::Write(const void * buffer)
   }
 }
 
+unsigned int
+TIFFImageIO::GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                               const ImageIORegion & pasteRegion,
+                                               const ImageIORegion & largestPossibleRegion)
+{
+  if (pasteRegion != largestPossibleRegion)
+  {
+    itkExceptionMacro("Pasting is not supported! Can't write:" << this->GetFileName());
+  }
+  // Only the pages of a multi-page image are written separately.
+  if (m_NumberOfDimensions < 3 || largestPossibleRegion.GetImageDimension() < 3 ||
+      largestPossibleRegion.GetSize(2) < 2)
+  {
+    return 1;
+  }
+  return GetActualNumberOfSplitsForWritingCanStreamWrite(numberOfRequestedSplits, pasteRegion);
+}
+
+ImageIORegion
+TIFFImageIO::GetSplitRegionForWriting(unsigned int          ithPiece,
+                                      unsigned int          numberOfActualSplits,
+                                      const ImageIORegion & pasteRegion,
+                                      const ImageIORegion & itkNotUsed(largestPossibleRegion))
+{
+  if (numberOfActualSplits == 1)
+  {
+    return pasteRegion;
+  }
+  return GetSplitRegionForWritingCanStreamWrite(ithPiece, numberOfActualSplits, pasteRegion);
+}
+
 void
 TIFFImageIO::InternalWrite(const void * buffer)
 {
@@ -559,11 +949,32 @@ TIFFImageIO::InternalWrite(const void * buffer)
 
   uint16 page, pages = 1;
 
+  // A streamed write of a multi-page image writes the pages of the IO region,
+  // which are appended to those already written.
+  uint16 firstPage = 0;
+  uint16 endPage = 1;
+
   const SizeValueType width = m_Dimensions[0];
   const SizeValueType height = m_Dimensions[1];
   if (m_NumberOfDimensions == 3)
   {
     pages = static_cast<uint16>(m_Dimensions[2]);
+    // Write() may be called directly, without an IO region: the whole image
+    // is then written.
+    if (m_IORegion.GetImageDimension() >= 3 && m_IORegion.GetNumberOfPixels() > 0)
+    {
+      firstPage = static_cast<uint16>(m_IORegion.GetIndex(2));
+      endPage = static_cast<uint16>(firstPage + m_IORegion.GetSize(2));
+    }
+    else
+    {
+      endPage = pages;
+    }
+  }
+
+  if (m_TileSize % 16 != 0)
+  {
+    itkExceptionMacro(<< "The tile size, " << m_TileSize << ", is not a multiple of 16");
   }
 
   auto   scomponents = static_cast<uint16>(this->GetNumberOfComponents());
@@ -591,13 +1002,16 @@ TIFFImageIO::InternalWrite(const void * buffer)
     case IOComponentEnum::FLOAT:
       bps = 32;
       break;
+    case IOComponentEnum::FLOAT16:
+      bps = 16;
+      break;
     default:
-      itkExceptionMacro(<< "TIFF supports unsigned/signed char, unsigned/signed short, and float");
+      itkExceptionMacro(<< "TIFF supports unsigned/signed char, unsigned/signed short, float16 and float");
   }
 
   uint16_t predictor;
 
-  const char * mode = "w";
+  const char * mode = firstPage > 0 ? "a" : "w";
 
   // If the size of the image is greater than 2 GiB then use big tiff
   constexpr SizeType oneKibiByte = 1024;
@@ -609,7 +1023,7 @@ TIFFImageIO::InternalWrite(const void * buffer)
   {
 #ifdef TIFF_INT64_T // detect if libtiff4
     // Adding the "8" option enables the use of big tiff
-    mode = "w8";
+    mode = firstPage > 0 ? "a" : "w8";
 #else
     itkExceptionMacro(<< "Size of image exceeds the limit of libtiff.");
 #endif
@@ -627,7 +1041,8 @@ TIFFImageIO::InternalWrite(const void * buffer)
   {
     TIFFSetField(tif, TIFFTAG_SAMPLEFORMAT, SAMPLEFORMAT_INT);
   }
-  else if (this->GetComponentType() == IOComponentEnum::FLOAT)
+  else if (this->GetComponentType() == IOComponentEnum::FLOAT ||
+           this->GetComponentType() == IOComponentEnum::FLOAT16)
   {
     TIFFSetField(tif, TIFFTAG_SAMPLEFORMAT, SAMPLEFORMAT_IEEEFP);
   }
@@ -635,13 +1050,17 @@ TIFFImageIO::InternalWrite(const void * buffer)
   auto w = static_cast<uint32>(width);
   auto h = static_cast<uint32>(height);
 
-  if (m_NumberOfDimensions == 3)
+  if (m_NumberOfDimensions == 3 && firstPage == 0)
   {
     TIFFCreateDirectory(tif);
   }
-  for (page = 0; page < pages; page++)
+  const auto multiThreader = MultiThreaderBase::New();
+  for (page = firstPage; page < endPage; page++)
   {
-    TIFFSetDirectory(tif, page);
+    if (firstPage == 0)
+    {
+      TIFFSetDirectory(tif, page);
+    }
     TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, w);
     TIFFSetField(tif, TIFFTAG_IMAGELENGTH, h);
     TIFFSetField(tif, TIFFTAG_ORIENTATION, ORIENTATION_TOPLEFT);
@@ -652,7 +1071,8 @@ TIFFImageIO::InternalWrite(const void * buffer)
     {
       TIFFSetField(tif, TIFFTAG_SAMPLEFORMAT, SAMPLEFORMAT_INT);
     }
-    else if (this->GetComponentType() == IOComponentEnum::FLOAT)
+    else if (this->GetComponentType() == IOComponentEnum::FLOAT ||
+             this->GetComponentType() == IOComponentEnum::FLOAT16)
     {
       TIFFSetField(tif, TIFFTAG_SAMPLEFORMAT, SAMPLEFORMAT_IEEEFP);
     }
@@ -769,7 +1189,15 @@ TIFFImageIO::InternalWrite(const void * buffer)
       rowsperstrip = 1;
     }
 
-    TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, TIFFDefaultStripSize(tif, rowsperstrip));
+    if (m_TileSize > 0)
+    {
+      TIFFSetField(tif, TIFFTAG_TILEWIDTH, m_TileSize);
+      TIFFSetField(tif, TIFFTAG_TILELENGTH, m_TileSize);
+    }
+    else
+    {
+      TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, TIFFDefaultStripSize(tif, rowsperstrip));
+    }
 
     if (resolution_x > 0 && resolution_y > 0)
     {
@@ -804,23 +1232,21 @@ TIFFImageIO::InternalWrite(const void * buffer)
       case IOComponentEnum::FLOAT:
         rowLength = sizeof(float);
         break;
+      case IOComponentEnum::FLOAT16:
+        rowLength = sizeof(Float16);
+        break;
       default:
-        itkExceptionMacro(<< "TIFF supports unsigned/signed char, unsigned/signed short, and float");
+        itkExceptionMacro(<< "TIFF supports unsigned/signed char, unsigned/signed short, float16 and float");
     }
 
     rowLength *= this->GetNumberOfComponents();
     rowLength *= width;
 
-    uint32 row = 0;
-    for (unsigned int idx2 = 0; idx2 < height; idx2++)
+    if (!WritePageBlocks(tif, outPtr, multiThreader))
     {
-      if (TIFFWriteScanline(tif, const_cast<char *>(outPtr), row, 0) < 0)
-      {
-        itkExceptionMacro(<< "TIFFImageIO: error out of disk space");
-      }
-      outPtr += rowLength;
-      ++row;
+      itkExceptionMacro(<< "TIFFImageIO: error out of disk space");
     }
+    outPtr += rowLength * height;
 
     if (m_NumberOfDimensions == 3)
     {
@@ -1328,6 +1754,12 @@ TIFFImageIO::ReadCurrentPage(void * buffer, size_t pixelOffset)
       volume += pixelOffset;
       this->ReadGenericImage(volume, width, height);
     }
+    else if (m_ComponentType == IOComponentEnum::FLOAT16)
+    {
+      auto * volume = static_cast<Float16 *>(buffer);
+      volume += pixelOffset;
+      this->ReadGenericImage(volume, width, height);
+    }
     else
     {
       auto * volume = static_cast<unsigned char *>(buffer);
@@ -1339,22 +1771,51 @@ TIFFImageIO::ReadCurrentPage(void * buffer, size_t pixelOffset)
 
 template <typename TComponent>
 void
-TIFFImageIO::ReadGenericImage(void * _out, unsigned int width, unsigned int height)
+TIFFImageIO::ReadGenericImage(void * out, unsigned int width, unsigned int height)
 {
-  using ComponentType = TComponent;
+  ImageIORegion region(2);
+  region.SetSize(0, width);
+  region.SetSize(1, height);
+  this->ReadPages<TComponent>(out, { TIFFCurrentDirOffset(m_InternalImage->m_Image) }, region);
+}
 
-#ifdef TIFF_INT64_T // detect if libtiff4
-  uint64_t isize = TIFFScanlineSize64(m_InternalImage->m_Image);
-#else
-  tsize_t isize = TIFFScanlineSize(m_InternalImage->m_Image);
-#endif
+void
+TIFFImageIO::ReadPages(void * out, const std::vector<uint64_t> & pageOffsets, const ImageIORegion & region)
+{
+  if (m_ComponentType == IOComponentEnum::USHORT)
+  {
+    this->ReadPages<unsigned short>(out, pageOffsets, region);
+  }
+  else if (m_ComponentType == IOComponentEnum::SHORT)
+  {
+    this->ReadPages<short>(out, pageOffsets, region);
+  }
+  else if (m_ComponentType == IOComponentEnum::CHAR)
+  {
+    this->ReadPages<char>(out, pageOffsets, region);
+  }
+  else if (m_ComponentType == IOComponentEnum::FLOAT)
+  {
+    this->ReadPages<float>(out, pageOffsets, region);
+  }
+  else if (m_ComponentType == IOComponentEnum::FLOAT16)
+  {
+    this->ReadPages<Float16>(out, pageOffsets, region);
+  }
+  else
+  {
+    this->ReadPages<unsigned char>(out, pageOffsets, region);
+  }
+}
 
-  size_t  inc;
-  tdata_t buf = _TIFFmalloc(static_cast<tmsize_t>(isize));
-  isize /= sizeof(ComponentType);
+template <typename TComponent>
+void
+TIFFImageIO::ReadPages(void * _out, const std::vector<uint64_t> & pageOffsets, const ImageIORegion & region)
+{
+  using ComponentType = TComponent;
 
-  auto *          out = static_cast<ComponentType *>(_out);
-  ComponentType * image;
+  size_t inc;
+  auto * out = static_cast<ComponentType *>(_out);
 
   if (m_InternalImage->m_PlanarConfig != PLANARCONFIG_CONTIG && m_InternalImage->m_SamplesPerPixel != 1)
   {
@@ -1366,8 +1827,8 @@ TIFFImageIO::ReadGenericImage(void * _out, unsigned int width, unsigned int heig
     itkExceptionMacro(<< "This reader can only do ORIENTATION_TOPLEFT and  ORIENTATION_BOTLEFT.");
   }
 
-
-  switch (this->GetFormat())
+  const unsigned int format = this->GetFormat();
+  switch (format)
   {
     case TIFFImageIO::GRAYSCALE:
     case TIFFImageIO::PALETTE_GRAYSCALE:
@@ -1389,91 +1850,173 @@ TIFFImageIO::ReadGenericImage(void * _out, unsigned int width, unsigned int heig
       break;
     }
     default:
-      inc = 1;
-      break;
+      itkExceptionMacro("Logic Error: Unexpected format!");
   }
 
-  for (uint32 row = 0; row < height; ++row)
+  const uint16 bitsPerSample = m_InternalImage->m_BitsPerSample;
+  if ((format == TIFFImageIO::PALETTE_GRAYSCALE || format == TIFFImageIO::PALETTE_RGB) && bitsPerSample != 8 &&
+      bitsPerSample != 16)
   {
-    if (TIFFReadScanline(m_InternalImage->m_Image, buf, row, 0) <= 0)
-    {
-      itkExceptionMacro(<< "Problem reading the row: " << row);
-    }
+    itkExceptionMacro(<< "Sorry, can not handle image with " << bitsPerSample << "-bit samples with palette.");
+  }
 
-    if (m_InternalImage->m_Orientation == ORIENTATION_TOPLEFT)
-    {
-      image = out + inc * row * width;
-    }
-    else // bottom left
+  // The strips or tiles of the pages that intersect the region, whose rows
+  // are flipped in a bottom left image.
+  TIFF * const tif = m_InternalImage->m_Image;
+  const uint32 width = m_InternalImage->m_Width;
+  const uint32 height = m_InternalImage->m_Height;
+  const bool   tiled = TIFFIsTiled(tif) != 0;
+  const bool   bottomLeft = m_InternalImage->m_Orientation == ORIENTATION_BOTLEFT;
+  uint32       blockWidth = width;
+  uint32       blockHeight = height;
+  const size_t pixelSize = m_InternalImage->m_SamplesPerPixel * bitsPerSample / 8;
+  const auto   regionX = static_cast<uint32>(region.GetIndex(0));
+  const auto   regionY = static_cast<uint32>(region.GetIndex(1));
+  const auto   regionWidth = static_cast<uint32>(region.GetSize(0));
+  const auto   regionHeight = static_cast<uint32>(region.GetSize(1));
+  const uint32 fileRegionY = bottomLeft ? height - regionY - regionHeight : regionY;
+  if (tiled)
+  {
+    blockWidth = m_InternalImage->m_TileWidth;
+    blockHeight = m_InternalImage->m_TileHeight;
+  }
+  else
+  {
+    TIFFGetFieldDefaulted(tif, TIFFTAG_ROWSPERSTRIP, &blockHeight);
+    blockHeight = std::min(blockHeight, height);
+  }
+  const tmsize_t blockSize = tiled ? TIFFTileSize(tif) : TIFFStripSize(tif);
+
+  struct Block
+  {
+    size_t m_Page;
+    uint32 m_X;
+    uint32 m_Y;
+  };
+  std::vector<Block> blocks;
+  for (size_t page = 0; page < pageOffsets.size(); ++page)
+  {
+    for (uint32 y = fileRegionY / blockHeight * blockHeight; y < fileRegionY + regionHeight; y += blockHeight)
     {
-      image = out + inc * width * (height - (row + 1));
+      for (uint32 x = regionX / blockWidth * blockWidth; x < regionX + regionWidth; x += blockWidth)
+      {
+        blocks.push_back({ page, x, y });
+      }
     }
+  }
 
-    switch (this->GetFormat())
+  // Copies the rows of a decoded strip or tile that are in the region.
+  const auto copyBlock = [&](const Block & block, char * const blockBuffer) {
+    const uint32 firstX = std::max(block.m_X, regionX);
+    const uint32 xsize = std::min(block.m_X + blockWidth, regionX + regionWidth) - firstX;
+    const uint32 endY = std::min(block.m_Y + blockHeight, fileRegionY + regionHeight);
+    for (uint32 y = std::max(block.m_Y, fileRegionY); y < endY; ++y)
     {
-      case TIFFImageIO::GRAYSCALE:
-        // check inverted
-        PutGrayscale<ComponentType>(image, static_cast<ComponentType *>(buf), width, 1, 0, 0);
-        break;
-      case TIFFImageIO::RGB_:
-        PutRGB_<ComponentType>(image, static_cast<ComponentType *>(buf), width, 1, 0, 0);
-        break;
+      const uint32    row = (bottomLeft ? height - (y + 1) : y) - regionY;
+      ComponentType * image = out + inc * ((block.m_Page * regionHeight + row) * regionWidth + firstX - regionX);
+      void * const    buf =
+        blockBuffer + ((y - block.m_Y) * static_cast<size_t>(blockWidth) + firstX - block.m_X) * pixelSize;
 
-      case TIFFImageIO::PALETTE_GRAYSCALE:
-        switch (m_InternalImage->m_BitsPerSample)
-        {
-          case 8:
-            PutPaletteGrayscale<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
-            break;
-          case 16:
+      switch (format)
+      {
+        case TIFFImageIO::GRAYSCALE:
+          PutGrayscale<ComponentType>(image, static_cast<ComponentType *>(buf), xsize, 1, 0, 0);
+          break;
+        case TIFFImageIO::RGB_:
+          PutRGB_<ComponentType>(image, static_cast<ComponentType *>(buf), xsize, 1, 0, 0);
+          break;
+        case TIFFImageIO::PALETTE_GRAYSCALE:
+          if (bitsPerSample == 8)
+          {
+            PutPaletteGrayscale<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), xsize, 1, 0, 0);
+          }
+          else
+          {
             PutPaletteGrayscale<ComponentType, unsigned short>(
-              image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
-            break;
-          default:
-            itkExceptionMacro(<< "Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
-                              << "-bit samples with palette.");
-        }
-        break;
-      case TIFFImageIO::PALETTE_RGB:
-        if (!this->GetIsReadAsScalarPlusPalette())
-        {
-          switch (m_InternalImage->m_BitsPerSample)
+              image, static_cast<unsigned short *>(buf), xsize, 1, 0, 0);
+          }
+          break;
+        default:
+          if (!this->GetIsReadAsScalarPlusPalette())
           {
-            case 8:
-              PutPaletteRGB<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
-              break;
-            case 16:
-              PutPaletteRGB<ComponentType, unsigned short>(image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
-              break;
-            default:
-              itkExceptionMacro(<< "Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
-                                << "-bit samples with palette.");
+            if (bitsPerSample == 8)
+            {
+              PutPaletteRGB<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), xsize, 1, 0, 0);
+            }
+            else
+            {
+              PutPaletteRGB<ComponentType, unsigned short>(image, static_cast<unsigned short *>(buf), xsize, 1, 0, 0);
+            }
           }
-        }
-        else
-        {
-          switch (m_InternalImage->m_BitsPerSample)
+          else
           {
-            case 8:
-              PutPaletteScalar<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
-              break;
-            case 16:
+            if (bitsPerSample == 8)
+            {
+              PutPaletteScalar<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), xsize, 1, 0, 0);
+            }
+            else
+            {
               PutPaletteScalar<ComponentType, unsigned short>(
-                image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
-              break;
-            default:
-              itkExceptionMacro(<< "Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
-                                << "-bit samples with palette.");
+                image, static_cast<unsigned short *>(buf), xsize, 1, 0, 0);
+            }
+          }
+      }
+    }
+  };
+
+  // The blocks are decoded in parallel, each range of blocks from its own
+  // handle on the file, unless there is a single range.
+  const auto        multiThreader = MultiThreaderBase::New();
+  const auto        numberOfChunks = std::min<SizeValueType>(blocks.size(), multiThreader->GetNumberOfWorkUnits());
+  std::atomic<bool> decoded(true);
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [&](SizeValueType chunk) {
+      TIFF * const chunkTIFF = numberOfChunks > 1 ? TIFFOpen(m_FileName.c_str(), "r") : tif;
+      if (!chunkTIFF)
+      {
+        decoded = false;
+        return;
+      }
+      uint64_t          directoryOffset = numberOfChunks > 1 ? 0 : TIFFCurrentDirOffset(tif);
+      std::vector<char> blockBuffer(static_cast<size_t>(blockSize));
+      const size_t      endBlock = (chunk + 1) * blocks.size() / numberOfChunks;
+      for (size_t i = chunk * blocks.size() / numberOfChunks; i < endBlock && decoded; ++i)
+      {
+        const Block & block = blocks[i];
+        if (directoryOffset != pageOffsets[block.m_Page])
+        {
+          directoryOffset = pageOffsets[block.m_Page];
+          if (!TIFFSetSubDirectory(chunkTIFF, directoryOffset))
+          {
+            decoded = false;
+            break;
           }
         }
-        break;
+        const tmsize_t size =
+          tiled ? TIFFReadEncodedTile(
+                    chunkTIFF, TIFFComputeTile(chunkTIFF, block.m_X, block.m_Y, 0, 0), blockBuffer.data(), blockSize)
+                : TIFFReadEncodedStrip(
+                    chunkTIFF, TIFFComputeStrip(chunkTIFF, block.m_Y, 0), blockBuffer.data(), blockSize);
+        if (size < 0)
+        {
+          decoded = false;
+          break;
+        }
+        copyBlock(block, blockBuffer.data());
+      }
+      if (chunkTIFF != tif)
+      {
+        TIFFClose(chunkTIFF);
+      }
+    },
+    nullptr);
 
-      default:
-        itkExceptionMacro("Logic Error: Unexpected format!");
-    }
+  if (!decoded)
+  {
+    itkExceptionMacro(<< "Problem reading the " << (tiled ? "tiles" : "strips") << " of file " << m_FileName);
   }
-
-  _TIFFfree(buf);
 }
 
 // iso component scalar
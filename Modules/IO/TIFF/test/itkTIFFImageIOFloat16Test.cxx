@@ -0,0 +1,88 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+#include "itkTIFFImageIO.h"
+
+//
+// Writes a Float16 image as a TIFF file with 16-bit floating point samples,
+// and checks that it is read back unchanged, both as Float16 and as float.
+//
+int
+itkTIFFImageIOFloat16Test(int argc, char * argv[])
+{
+  if (argc != 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " output" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension = 2;
+  using HalfImageType = itk::Image<itk::Float16, Dimension>;
+  using FloatImageType = itk::Image<float, Dimension>;
+
+  const auto image = HalfImageType::New();
+  image->SetRegions(HalfImageType::SizeType{ { 37, 19 } });
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex<HalfImageType> it(image, image->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const HalfImageType::IndexType index = it.GetIndex();
+    it.Set(std::ldexp(static_cast<float>(index[0] - 18) + 0.1f * index[1], static_cast<int>(index[1]) - 16));
+  }
+
+  const auto tiffImageIO = itk::TIFFImageIO::New();
+  const auto writer = itk::ImageFileWriter<HalfImageType>::New();
+  writer->SetFileName(argv[1]);
+  writer->SetInput(image);
+  writer->SetImageIO(tiffImageIO);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  const auto halfReader = itk::ImageFileReader<HalfImageType>::New();
+  halfReader->SetFileName(argv[1]);
+  halfReader->SetImageIO(tiffImageIO);
+  ITK_TRY_EXPECT_NO_EXCEPTION(halfReader->Update());
+  ITK_TEST_EXPECT_EQUAL(tiffImageIO->GetComponentType(), itk::IOComponentEnum::FLOAT16);
+
+  const auto floatReader = itk::ImageFileReader<FloatImageType>::New();
+  floatReader->SetFileName(argv[1]);
+  ITK_TRY_EXPECT_NO_EXCEPTION(floatReader->Update());
+
+  const HalfImageType *  halfImage = halfReader->GetOutput();
+  const FloatImageType * floatImage = floatReader->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(halfImage->GetBufferedRegion(), image->GetBufferedRegion());
+  ITK_TEST_EXPECT_EQUAL(floatImage->GetBufferedRegion(), image->GetBufferedRegion());
+
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const HalfImageType::IndexType index = it.GetIndex();
+    if (halfImage->GetPixel(index).GetBits() != it.Get().GetBits() ||
+        floatImage->GetPixel(index) != static_cast<float>(it.Get()))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Wrong value at " << index << ": expected " << it.Get() << ", read " << halfImage->GetPixel(index)
+                << " and " << floatImage->GetPixel(index) << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
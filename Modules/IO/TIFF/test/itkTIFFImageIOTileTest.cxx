@@ -0,0 +1,309 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkDefaultConvertPixelTraits.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkPipelineMonitorImageFilter.h"
+#include "itkRGBPixel.h"
+#include "itkTestingMacros.h"
+#include "itkTIFFImageIO.h"
+
+// Writes multi-page images in strips and in tiles, compressed or not, at once
+// and a range of pages at a time, and checks that they are read back
+// unchanged, and that a requested region reads only that region. Also checks
+// the JPEG compressed strips and tiles, which are read back approximately,
+// and a direct call to TIFFImageIO::Write() without an IO region.
+namespace
+{
+constexpr unsigned int Dimension = 3;
+
+template <typename TPixel>
+TPixel
+GetExpectedPixel(const itk::Index<Dimension> & index)
+{
+  using PixelTraits = itk::DefaultConvertPixelTraits<TPixel>;
+  using ValueType = typename PixelTraits::ComponentType;
+
+  TPixel pixel;
+  for (unsigned int k = 0; k < PixelTraits::GetNumberOfComponents(); ++k)
+  {
+    const auto value = index[0] * 3 + index[1] * 7 + index[2] * 13 + 50 * k;
+    PixelTraits::SetNthComponent(k, pixel, static_cast<ValueType>(value));
+  }
+  return pixel;
+}
+
+template <typename TImage>
+bool
+CheckPixels(const TImage * image, const std::string & description)
+{
+  using PixelType = typename TImage::PixelType;
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const PixelType expectedPixel = GetExpectedPixel<PixelType>(it.GetIndex());
+    if (it.Get() != expectedPixel)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << description << ": error at index " << it.GetIndex() << std::endl;
+      std::cerr << "Expected " << expectedPixel << ", but got " << it.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename TImage>
+bool
+CheckFile(const std::string & fileName)
+{
+  using RegionType = typename TImage::RegionType;
+
+  const RegionType largestRegion(typename TImage::SizeType{ { 70, 45, 5 } });
+  auto             reader = itk::ImageFileReader<TImage>::New();
+  reader->SetImageIO(itk::TIFFImageIO::New());
+  reader->SetFileName(fileName);
+  reader->Update();
+  if (reader->GetOutput()->GetBufferedRegion() != largestRegion || !CheckPixels<TImage>(reader->GetOutput(), fileName))
+  {
+    return false;
+  }
+
+  // Only the requested region is read.
+  const RegionType requestedRegion(typename TImage::IndexType{ { 19, 7, 1 } },
+                                   typename TImage::SizeType{ { 37, 30, 3 } });
+  auto             regionReader = itk::ImageFileReader<TImage>::New();
+  regionReader->SetImageIO(itk::TIFFImageIO::New());
+  regionReader->SetFileName(fileName);
+  regionReader->UpdateOutputInformation();
+  regionReader->GetOutput()->SetRequestedRegion(requestedRegion);
+  regionReader->Update();
+  if (regionReader->GetOutput()->GetBufferedRegion() != requestedRegion ||
+      !CheckPixels<TImage>(regionReader->GetOutput(), fileName + " (requested region)"))
+  {
+    std::cerr << "Buffered region: " << regionReader->GetOutput()->GetBufferedRegion() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+template <typename TPixel>
+bool
+TestWriteRead(const std::string & directory)
+{
+  using ImageType = itk::Image<TPixel, Dimension>;
+  using PixelTraits = itk::DefaultConvertPixelTraits<TPixel>;
+  using ValueType = typename PixelTraits::ComponentType;
+
+  auto image = ImageType::New();
+  image->SetRegions(typename ImageType::SizeType{ { 70, 45, 5 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(GetExpectedPixel<TPixel>(it.GetIndex()));
+  }
+
+  for (const std::string compressor : { "", "PackBits", "Deflate" })
+  {
+    for (const unsigned int tileSize : { 0, 16, 32 })
+    {
+      std::ostringstream fileName;
+      fileName << directory << "/itkTIFFImageIOTileTest" << PixelTraits::GetNumberOfComponents() << "_"
+               << sizeof(ValueType) << compressor << "_" << tileSize;
+
+      auto tiffImageIO = itk::TIFFImageIO::New();
+      tiffImageIO->SetCompressor(compressor);
+      tiffImageIO->SetTileSize(tileSize);
+
+      auto writer = itk::ImageFileWriter<ImageType>::New();
+      writer->SetImageIO(tiffImageIO);
+      writer->SetUseCompression(!compressor.empty());
+      writer->SetInput(image);
+      writer->SetFileName(fileName.str() + ".tif");
+      writer->Update();
+      if (!CheckFile<ImageType>(fileName.str() + ".tif"))
+      {
+        return false;
+      }
+
+      // Copy the file a range of pages at a time, which are read and written
+      // separately.
+      auto reader = itk::ImageFileReader<ImageType>::New();
+      reader->SetImageIO(itk::TIFFImageIO::New());
+      reader->SetFileName(fileName.str() + ".tif");
+
+      auto monitor = itk::PipelineMonitorImageFilter<ImageType>::New();
+      monitor->SetInput(reader->GetOutput());
+
+      constexpr unsigned int numberOfStreamDivisions = 3;
+      writer->SetInput(monitor->GetOutput());
+      writer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+      writer->SetFileName(fileName.str() + "_streamed.tif");
+      writer->Update();
+      if (!monitor->VerifyAllInputCanStream(numberOfStreamDivisions) ||
+          !CheckFile<ImageType>(fileName.str() + "_streamed.tif"))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// JPEG is lossy: a smooth RGB image is read back within a tolerance.
+bool
+TestJPEG(const std::string & directory)
+{
+  using PixelType = itk::RGBPixel<unsigned char>;
+  using ImageType = itk::Image<PixelType, Dimension>;
+
+  auto image = ImageType::New();
+  image->SetRegions(typename ImageType::SizeType{ { 70, 45, 3 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    PixelType pixel;
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      pixel[k] = static_cast<unsigned char>(60 + it.GetIndex()[0] + it.GetIndex()[1] + 20 * it.GetIndex()[2] + 30 * k);
+    }
+    it.Set(pixel);
+  }
+
+  for (const unsigned int tileSize : { 0, 16, 32 })
+  {
+    const std::string fileName = directory + "/itkTIFFImageIOTileTestJPEG_" + std::to_string(tileSize) + ".tif";
+
+    auto tiffImageIO = itk::TIFFImageIO::New();
+    tiffImageIO->SetCompressor("JPEG");
+    tiffImageIO->SetJPEGQuality(95);
+    tiffImageIO->SetTileSize(tileSize);
+
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetImageIO(tiffImageIO);
+    writer->SetUseCompression(true);
+    writer->SetInput(image);
+    writer->SetFileName(fileName);
+    writer->Update();
+
+    auto reader = itk::ImageFileReader<ImageType>::New();
+    reader->SetImageIO(itk::TIFFImageIO::New());
+    reader->SetFileName(fileName);
+    reader->Update();
+    if (reader->GetOutput()->GetBufferedRegion() != image->GetBufferedRegion())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << fileName << ": region " << reader->GetOutput()->GetBufferedRegion() << std::endl;
+      return false;
+    }
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      const PixelType pixel = reader->GetOutput()->GetPixel(it.GetIndex());
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        if (std::abs(static_cast<int>(pixel[k]) - static_cast<int>(it.Get()[k])) > 8)
+        {
+          std::cerr << "Test failed!" << std::endl;
+          std::cerr << fileName << ": error at index " << it.GetIndex() << std::endl;
+          std::cerr << "Expected " << it.Get() << ", but got " << pixel << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Write() called directly, without setting the IO region, writes all the
+// pages.
+bool
+TestDirectWrite(const std::string & directory)
+{
+  using ImageType = itk::Image<unsigned short, Dimension>;
+
+  auto image = ImageType::New();
+  image->SetRegions(typename ImageType::SizeType{ { 70, 45, 5 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(GetExpectedPixel<unsigned short>(it.GetIndex()));
+  }
+
+  const std::string fileName = directory + "/itkTIFFImageIOTileTestDirectWrite.tif";
+  auto              tiffImageIO = itk::TIFFImageIO::New();
+  tiffImageIO->SetNumberOfDimensions(Dimension);
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    tiffImageIO->SetDimensions(d, image->GetBufferedRegion().GetSize(d));
+    tiffImageIO->SetSpacing(d, 1.0);
+    tiffImageIO->SetOrigin(d, 0.0);
+  }
+  tiffImageIO->SetPixelType(itk::IOPixelEnum::SCALAR);
+  tiffImageIO->SetComponentType(itk::IOComponentEnum::USHORT);
+  tiffImageIO->SetNumberOfComponents(1);
+  tiffImageIO->SetTileSize(16);
+  tiffImageIO->SetFileName(fileName);
+  tiffImageIO->Write(image->GetBufferPointer());
+
+  return CheckFile<ImageType>(fileName);
+}
+} // namespace
+
+int
+itkTIFFImageIOTileTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " OutputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string directory = argv[1];
+
+  auto tiffImageIO = itk::TIFFImageIO::New();
+
+  ITK_TEST_EXPECT_EQUAL(tiffImageIO->GetTileSize(), 0);
+  tiffImageIO->SetTileSize(64);
+  ITK_TEST_SET_GET_VALUE(64, tiffImageIO->GetTileSize());
+
+  // The tile size must be a multiple of 16.
+  using ImageType = itk::Image<unsigned char, 2>;
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 40, 40 } });
+  image->Allocate(true);
+  tiffImageIO->SetTileSize(20);
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetImageIO(tiffImageIO);
+  writer->SetInput(image);
+  writer->SetFileName(directory + "/itkTIFFImageIOTileTest.tif");
+  ITK_TRY_EXPECT_EXCEPTION(writer->Update());
+
+  bool success = true;
+  ITK_TRY_EXPECT_NO_EXCEPTION(success = TestWriteRead<unsigned short>(directory) &&
+                                        TestWriteRead<itk::RGBPixel<unsigned char>>(directory) &&
+                                        TestJPEG(directory) && TestDirectWrite(directory));
+  if (!success)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
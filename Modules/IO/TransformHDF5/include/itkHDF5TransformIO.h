@@ -21,8 +21,10 @@
 #include "ITKIOTransformHDF5Export.h"
 
 #include "itkTransformIOBase.h"
+#include "itkImageIORegion.h"
 #include <memory>
 #include <string>
+#include <vector>
 
 // Avoids KWStyle error from forward declaration below.
 namespace itk
@@ -80,6 +82,17 @@ struct ITKIOTransformHDF5_EXPORT HDF5CommonPathNames
  *  format, but it is very general and can store pretty much
  *  any sort of data.
  *
+ *  When compression is used, the parameters of displacement field and
+ *  BSpline transforms are stored as datasets with the layout of their
+ *  images, the components of a displacement varying fastest, and split
+ *  into compressed blocks of about 1M values. Otherwise, and for the
+ *  other transforms, the parameters are stored as a 1D dataset, like the
+ *  files written by earlier versions, which are still read.
+ *
+ *  The parameters of displacement field transforms are read directly into
+ *  the buffer of their field. A DisplacementFieldRegion can be set to
+ *  read only a region of the fields.
+ *
  * \ingroup ITKIOTransformHDF5
  */
 template <typename TParametersValueType>
@@ -125,9 +138,20 @@ public:
   void
   Write() override;
 
+  /** Set/Get the region of the displacement fields to read, in the index
+   * space of the fields, which starts at zero. When its dimension is not
+   * zero, only this region of the fields of the displacement field
+   * transforms of the same dimension is read, and becomes their field, out
+   * of which the displacement is zero. The default is a region of
+   * dimension zero, which reads the whole fields. */
+  itkSetMacro(DisplacementFieldRegion, ImageIORegion);
+  itkGetConstReferenceMacro(DisplacementFieldRegion, ImageIORegion);
+
 protected:
   HDF5TransformIOTemplate();
   ~HDF5TransformIOTemplate() override;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
 
 private:
   /** Read a parameter array from the file location name */
@@ -136,9 +160,29 @@ private:
   FixedParametersType
   ReadFixedParameters(const std::string & DataSetName) const;
 
-  /** Write a parameter array to the file location name */
+  /** Set the fixed parameters of a displacement field transform, restricted
+   * to the DisplacementFieldRegion if set, and read its parameters from
+   * the file location name into the buffer of its field. Returns false,
+   * without reading the parameters, if the transform is not parametrized
+   * by a field of its dimension, like the time varying velocity field
+   * transforms. */
+  bool
+  ReadDisplacementField(const std::string & DataSetName,
+                        TransformType *     transform,
+                        FixedParametersType fixedParameters) const;
+
+  /** The dimensions of the dataset storing the parameters of a transform
+   * with the layout of its images, slowest varying first, or an empty
+   * vector for the transforms whose parameters are not images. */
+  std::vector<SizeValueType>
+  GetParametersImageDimensions(const TransformType * transform) const;
+
+  /** Write a parameter array to the file location name, as a dataset of the
+   * given dimensions, or as a 1D dataset if there are none */
   void
-  WriteParameters(const std::string & name, const ParametersType & parameters);
+  WriteParameters(const std::string &                name,
+                  const ParametersType &             parameters,
+                  const std::vector<SizeValueType> & dimensions = std::vector<SizeValueType>());
   void
   WriteFixedParameters(const std::string & name, const FixedParametersType & parameters);
 
@@ -158,6 +202,8 @@ private:
    */
   H5::PredType
   GetH5TypeFromString() const;
+
+  ImageIORegion m_DisplacementFieldRegion{ 0 };
 };
 
 const std::string ITKIOTransformHDF5_EXPORT
@@ -24,6 +24,7 @@
 #include "itkCompositeTransform.h"
 #include "itkCompositeTransformIOHelper.h"
 #include "itkVersion.h"
+#include <algorithm>
 #include <sstream>
 
 namespace itk
@@ -34,6 +35,14 @@ HDF5TransformIOTemplate<TParametersValueType>::HDF5TransformIOTemplate() = defau
 template <typename TParametersValueType>
 HDF5TransformIOTemplate<TParametersValueType>::~HDF5TransformIOTemplate() = default;
 
+template <typename TParametersValueType>
+void
+HDF5TransformIOTemplate<TParametersValueType>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "DisplacementFieldRegion: " << m_DisplacementFieldRegion << std::endl;
+}
+
 template <typename TParametersValueType>
 bool
 HDF5TransformIOTemplate<TParametersValueType>::CanReadFile(const char * fileName)
@@ -110,14 +119,58 @@ HDF5TransformIOTemplate<TParametersValueType>::GetH5TypeFromString() const
   itkExceptionMacro(<< "Wrong data precision type " << NameParametersValueTypeString << "for writing in HDF5 File");
 }
 
+template <typename TParametersValueType>
+std::vector<SizeValueType>
+HDF5TransformIOTemplate<TParametersValueType>::GetParametersImageDimensions(const TransformType * transform) const
+{
+  // Displacement field and BSpline transforms have the same fixed
+  // parameters: the size, origin, spacing and direction of their images.
+  const auto         category = transform->GetTransformCategory();
+  const unsigned int dimension = transform->GetInputSpaceDimension();
+  if ((category != TransformType::TransformCategoryEnum::DisplacementField &&
+       category != TransformType::TransformCategoryEnum::BSpline) ||
+      transform->GetFixedParameters().Size() != dimension * (dimension + 3))
+  {
+    return std::vector<SizeValueType>();
+  }
+
+  std::vector<SizeValueType> dimensions;
+  SizeValueType              numberOfParameters = dimension;
+  for (unsigned int d = dimension; d > 0; --d)
+  {
+    dimensions.push_back(static_cast<SizeValueType>(transform->GetFixedParameters()[d - 1]));
+    numberOfParameters *= dimensions.back();
+  }
+  if (category == TransformType::TransformCategoryEnum::DisplacementField)
+  {
+    // the field is an image of vectors
+    dimensions.push_back(dimension);
+  }
+  else
+  {
+    // the coefficients are one image per dimension
+    dimensions.insert(dimensions.begin(), dimension);
+  }
+  if (numberOfParameters == 0 || numberOfParameters != transform->GetNumberOfParameters())
+  {
+    return std::vector<SizeValueType>();
+  }
+  return dimensions;
+}
+
 /** Write a Parameter array to the location specified by name */
 template <typename TParametersValueType>
 void
-HDF5TransformIOTemplate<TParametersValueType>::WriteParameters(const std::string &    name,
-                                                               const ParametersType & parameters)
+HDF5TransformIOTemplate<TParametersValueType>::WriteParameters(const std::string &                name,
+                                                               const ParametersType &             parameters,
+                                                               const std::vector<SizeValueType> & dimensions)
 {
-  const hsize_t dim(parameters.Size());
-  H5::DataSpace paramSpace(1, &dim);
+  std::vector<hsize_t> dims(dimensions.begin(), dimensions.end());
+  if (dims.empty())
+  {
+    dims.push_back(parameters.Size());
+  }
+  H5::DataSpace paramSpace(static_cast<int>(dims.size()), dims.data());
 
   H5::DataSet paramSet;
 
@@ -127,13 +180,25 @@ HDF5TransformIOTemplate<TParametersValueType>::WriteParameters(const std::string
   {
     // Set compression information
     // set up properties for chunked, compressed writes.
-    // in this case, set the chunk size to be the N-1 dimension
-    // region
+    // The chunks hold at most 1M values: the whole dataset if it is small,
+    // else blocks of it, whose largest dimension is halved until they do.
     H5::DSetCreatPropList plist;
     plist.setDeflate(5); // Set intermediate compression level
-    constexpr hsize_t oneMegabyte = 1024 * 1024;
-    const hsize_t     chunksize = (dim > oneMegabyte) ? oneMegabyte : dim; // Use chunks of 1 MB if large, else use dim
-    plist.setChunk(1, &chunksize);
+    constexpr hsize_t    oneMegabyte = 1024 * 1024;
+    std::vector<hsize_t> chunkDims(dims);
+    hsize_t              chunkSize = parameters.Size();
+    while (chunkSize > oneMegabyte)
+    {
+      if (chunkDims.size() == 1)
+      {
+        chunkDims[0] = oneMegabyte;
+        break;
+      }
+      auto & largest = *std::max_element(chunkDims.begin(), chunkDims.end());
+      chunkSize = chunkSize / largest * ((largest + 1) / 2);
+      largest = (largest + 1) / 2;
+    }
+    plist.setChunk(static_cast<int>(chunkDims.size()), chunkDims.data());
 
     paramSet = this->m_H5File->createDataSet(name, h5StorageIdentifier, paramSpace, plist);
   }
@@ -169,38 +234,141 @@ HDF5TransformIOTemplate<TParametersValueType>::ReadParameters(const std::string
   {
     itkExceptionMacro(<< "Wrong data type for " << DataSetName << "in HDF5 File");
   }
+  // The parameters are stored as a 1D dataset, or with the layout of the
+  // images of the transform, and read in the order they are stored in,
+  // converted by HDF5 to the parameters value type.
   const H5::DataSpace Space = paramSet.getSpace();
-  if (Space.getSimpleExtentNdims() != 1)
+  ParametersType      ParameterArray;
+  ParameterArray.SetSize(Space.getSimpleExtentNpoints());
+  paramSet.read(ParameterArray.data_block(), GetH5TypeFromString());
+  paramSet.close();
+  return ParameterArray;
+}
+
+template <typename TParametersValueType>
+bool
+HDF5TransformIOTemplate<TParametersValueType>::ReadDisplacementField(const std::string & DataSetName,
+                                                                     TransformType *     transform,
+                                                                     FixedParametersType fixedParameters) const
+{
+  // The fixed parameters of the time varying velocity field transforms
+  // describe a field of one more dimension.
+  const unsigned int dimension = transform->GetInputSpaceDimension();
+  if (fixedParameters.Size() != dimension * (dimension + 3))
   {
-    itkExceptionMacro(<< "Wrong # of dims for TransformType "
-                      << "in HDF5 File");
+    return false;
   }
-  hsize_t dim;
-  Space.getSimpleExtentDims(&dim, nullptr);
-  ParametersType ParameterArray;
-  ParameterArray.SetSize(dim);
-  H5::FloatType ParamType = paramSet.getFloatType();
 
-  if (ParamType.getSize() == sizeof(double))
+  // The fixed parameters are the size, origin, spacing and direction of the
+  // field.
+  ImageIORegion fieldRegion(dimension);
+  for (unsigned int d = 0; d < dimension; ++d)
   {
-    const std::unique_ptr<double[]> buf(new double[dim]);
-    paramSet.read(buf.get(), H5::PredType::NATIVE_DOUBLE);
-    for (unsigned i = 0; i < dim; i++)
+    fieldRegion.SetSize(d, static_cast<SizeValueType>(fixedParameters[d]));
+  }
+  ImageIORegion region = fieldRegion;
+  if (m_DisplacementFieldRegion.GetImageDimension() == dimension && fieldRegion.GetNumberOfPixels() > 0)
+  {
+    if (!fieldRegion.IsInside(m_DisplacementFieldRegion) || m_DisplacementFieldRegion.GetNumberOfPixels() == 0)
+    {
+      itkExceptionMacro(<< "The DisplacementFieldRegion is not inside the displacement field of " << DataSetName);
+    }
+    region = m_DisplacementFieldRegion;
+
+    // the field starts at the first pixel of the region
+    for (unsigned int i = 0; i < dimension; ++i)
     {
-      ParameterArray.SetElement(i, static_cast<ParametersValueType>(buf[i]));
+      fixedParameters[i] = region.GetSize(i);
+      for (unsigned int j = 0; j < dimension; ++j)
+      {
+        fixedParameters[dimension + i] += fixedParameters[3 * dimension + i * dimension + j] *
+                                          fixedParameters[2 * dimension + j] * region.GetIndex(j);
+      }
     }
   }
-  else
+
+  // Allocates the field, which the parameters of the transform point to.
+  transform->SetFixedParameters(fixedParameters);
+  const SizeValueType numberOfParameters = region.GetNumberOfPixels() * dimension;
+  if (transform->GetParameters().Size() != numberOfParameters)
   {
-    const std::unique_ptr<float[]> buf(new float[dim]);
-    paramSet.read(buf.get(), H5::PredType::NATIVE_FLOAT);
-    for (unsigned i = 0; i < dim; i++)
+    return false;
+  }
+  if (numberOfParameters == 0)
+  {
+    return true;
+  }
+
+  H5::DataSet paramSet = this->m_H5File->openDataSet(DataSetName);
+  if (paramSet.getTypeClass() != H5T_FLOAT)
+  {
+    itkExceptionMacro(<< "Wrong data type for " << DataSetName << "in HDF5 File");
+  }
+  H5::DataSpace fileSpace = paramSet.getSpace();
+  if (static_cast<SizeValueType>(fileSpace.getSimpleExtentNpoints()) !=
+      fieldRegion.GetNumberOfPixels() * dimension)
+  {
+    itkExceptionMacro(<< "Wrong number of parameters for " << DataSetName << " in HDF5 File");
+  }
+
+  // Select the region in the file, in a dataset with the layout of the
+  // field, or, in the 1D datasets of earlier versions, as the rows along
+  // the second dimension of each of its slices.
+  const int rank = fileSpace.getSimpleExtentNdims();
+  if (rank == static_cast<int>(dimension) + 1)
+  {
+    std::vector<hsize_t> start(rank, 0);
+    std::vector<hsize_t> count(rank, dimension);
+    for (unsigned int d = 0; d < dimension; ++d)
+    {
+      start[dimension - 1 - d] = region.GetIndex(d);
+      count[dimension - 1 - d] = region.GetSize(d);
+    }
+    fileSpace.selectHyperslab(H5S_SELECT_SET, count.data(), start.data());
+  }
+  else if (rank == 1)
+  {
+    if (region != fieldRegion)
     {
-      ParameterArray.SetElement(i, static_cast<ParametersValueType>(buf[i]));
+      fileSpace.selectNone();
+      const hsize_t rowLength = fieldRegion.GetSize(0) * dimension;
+      const hsize_t count = dimension > 1 ? region.GetSize(1) : 1;
+      const hsize_t block = region.GetSize(0) * dimension;
+      const hsize_t numberOfSlices = region.GetNumberOfPixels() / (region.GetSize(0) * count);
+      for (hsize_t slice = 0; slice < numberOfSlices; ++slice)
+      {
+        hsize_t offset = 0;
+        hsize_t remainder = slice;
+        for (unsigned int d = dimension - 1; d > 1; --d)
+        {
+          offset = offset * fieldRegion.GetSize(d) + region.GetIndex(d) + remainder % region.GetSize(d);
+          remainder /= region.GetSize(d);
+        }
+        if (dimension > 1)
+        {
+          offset = offset * fieldRegion.GetSize(1) + region.GetIndex(1);
+        }
+        const hsize_t start = offset * rowLength + region.GetIndex(0) * dimension;
+        fileSpace.selectHyperslab(H5S_SELECT_OR, &count, &start, &rowLength, &block);
+      }
     }
   }
+  else
+  {
+    itkExceptionMacro(<< "Wrong # of dims for " << DataSetName << " in HDF5 File");
+  }
+
+  // The parameters of a displacement field transform are the buffer of its
+  // field, which the selected values are read into.
+  const hsize_t       memDim = numberOfParameters;
+  const H5::DataSpace memSpace(1, &memDim);
+  paramSet.read(const_cast<ParametersValueType *>(transform->GetParameters().data_block()),
+                GetH5TypeFromString(),
+                memSpace,
+                fileSpace);
   paramSet.close();
-  return ParameterArray;
+  transform->Modified();
+  return true;
 }
 
 /** read a parameter array from the location specified by name */
@@ -336,7 +504,6 @@ HDF5TransformIOTemplate<TParametersValueType>::Read()
           fixedParamsName = transformName + transformFixedNameMisspelled;
         }
         FixedParametersType fixedparams(this->ReadFixedParameters(fixedParamsName));
-        transform->SetFixedParameters(fixedparams);
 
         std::string paramsName(transformName + transformParamsName);
 #if (H5_VERS_MAJOR == 1) && (H5_VERS_MINOR < 10)
@@ -349,8 +516,13 @@ HDF5TransformIOTemplate<TParametersValueType>::Read()
 #endif
           paramsName = transformName + transformParamsNameMisspelled;
         }
-        ParametersType params = this->ReadParameters(paramsName);
-        transform->SetParametersByValue(params);
+        if (transform->GetTransformCategory() != TransformType::TransformCategoryEnum::DisplacementField ||
+            !this->ReadDisplacementField(paramsName, transform, fixedparams))
+        {
+          transform->SetFixedParameters(fixedparams);
+          ParametersType params = this->ReadParameters(paramsName);
+          transform->SetParametersByValue(params);
+        }
       }
       currentTransformGroup.close();
     }
@@ -395,10 +567,18 @@ HDF5TransformIOTemplate<TParametersValueType>::WriteOneTransform(const int
     FixedParametersType FixedtmpArray = curTransform->GetFixedParameters();
     const std::string   fixedParamsName(transformName + transformFixedName);
     this->WriteFixedParameters(fixedParamsName, FixedtmpArray);
-    // parameters
-    ParametersType    tmpArray = curTransform->GetParameters();
-    const std::string paramsName(transformName + transformParamsName);
-    this->WriteParameters(paramsName, tmpArray);
+    // parameters, with the layout of the images of the transform if they
+    // are compressed
+    const ParametersType & parameters = curTransform->GetParameters();
+    const std::string      paramsName(transformName + transformParamsName);
+    if (this->GetUseCompression())
+    {
+      this->WriteParameters(paramsName, parameters, this->GetParametersImageDimensions(curTransform));
+    }
+    else
+    {
+      this->WriteParameters(paramsName, parameters);
+    }
   }
 }
 
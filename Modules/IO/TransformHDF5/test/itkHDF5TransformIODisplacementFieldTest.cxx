@@ -0,0 +1,316 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBSplineTransform.h"
+#include "itkDisplacementFieldTransform.h"
+#include "itkGaussianSmoothingOnUpdateTimeVaryingVelocityFieldTransform.h"
+#include "itkHDF5TransformIO.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+#include "itkTransformFileReader.h"
+#include "itkTransformFileWriter.h"
+
+// Writes displacement field, time varying velocity field and BSpline
+// transforms to uncompressed and compressed files, and checks the transforms
+// read back, in double and float precision, and the regions of the
+// displacement fields read alone.
+namespace
+{
+constexpr unsigned int Dimension = 3;
+
+using FieldType = itk::DisplacementFieldTransform<double, Dimension>::DisplacementFieldType;
+
+FieldType::PixelType
+GetExpectedDisplacement(const FieldType::IndexType & index)
+{
+  FieldType::PixelType displacement;
+  for (unsigned int c = 0; c < Dimension; ++c)
+  {
+    displacement[c] = static_cast<double>(index[0] + 7 * index[1] + 13 * index[2]) / 8.0 + c;
+  }
+  return displacement;
+}
+
+template <typename TParametersValueType>
+typename itk::DisplacementFieldTransform<TParametersValueType, Dimension>::Pointer
+ReadDisplacementFieldTransform(const std::string & fileName, const itk::ImageIORegion & region)
+{
+  auto transformIO = itk::HDF5TransformIOTemplate<TParametersValueType>::New();
+  transformIO->SetDisplacementFieldRegion(region);
+  auto reader = itk::TransformFileReaderTemplate<TParametersValueType>::New();
+  reader->SetFileName(fileName);
+  reader->SetTransformIO(transformIO);
+  reader->Update();
+  using TransformType = itk::DisplacementFieldTransform<TParametersValueType, Dimension>;
+  return dynamic_cast<TransformType *>(reader->GetTransformList()->front().GetPointer());
+}
+
+// Checks the field read back, which is the given region of the written field.
+template <typename TParametersValueType>
+bool
+CheckDisplacementField(const std::string &           fileName,
+                       const FieldType *             writtenField,
+                       const FieldType::RegionType & region,
+                       const itk::ImageIORegion &    ioRegion)
+{
+  auto transform = ReadDisplacementFieldTransform<TParametersValueType>(fileName, ioRegion);
+  if (transform == nullptr)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "No displacement field transform read from " << fileName << std::endl;
+    return false;
+  }
+  const auto * field = transform->GetDisplacementField();
+  FieldType::PointType origin;
+  writtenField->TransformIndexToPhysicalPoint(region.GetIndex(), origin);
+  if (field->GetLargestPossibleRegion().GetSize() != region.GetSize() ||
+      field->GetOrigin().EuclideanDistanceTo(origin) > 1e-5 || field->GetSpacing() != writtenField->GetSpacing() ||
+      field->GetDirection() != writtenField->GetDirection())
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Wrong geometry of the field read from " << fileName << " in region " << ioRegion << std::endl;
+    field->Print(std::cerr);
+    return false;
+  }
+  using ReadTransformType = itk::DisplacementFieldTransform<TParametersValueType, Dimension>;
+  using ReadFieldType = typename ReadTransformType::DisplacementFieldType;
+  for (itk::ImageRegionConstIteratorWithIndex<ReadFieldType> it(field, field->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    const auto index = it.GetIndex();
+    const auto expected = GetExpectedDisplacement(index + (region.GetIndex() - FieldType::IndexType()));
+    for (unsigned int c = 0; c < Dimension; ++c)
+    {
+      if (itk::Math::NotAlmostEquals(it.Get()[c], static_cast<TParametersValueType>(expected[c])))
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Error in " << fileName << " at index " << index << " of region " << ioRegion << ": expected "
+                  << expected << ", but got " << it.Get() << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool
+TestDisplacementField(const std::string & fileNamePrefix)
+{
+  using TransformType = itk::DisplacementFieldTransform<double, Dimension>;
+
+  auto field = FieldType::New();
+  field->SetRegions(FieldType::SizeType{ { 30, 20, 12 } });
+  const double origin[Dimension] = { -10.0, 5.0, 2.5 };
+  field->SetOrigin(origin);
+  const double spacing[Dimension] = { 1.5, 2.0, 0.5 };
+  field->SetSpacing(spacing);
+  FieldType::DirectionType direction;
+  direction.SetIdentity();
+  direction[0][0] = 0.0;
+  direction[0][1] = -1.0;
+  direction[1][0] = 1.0;
+  direction[1][1] = 0.0;
+  field->SetDirection(direction);
+  field->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<FieldType> it(field, field->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(GetExpectedDisplacement(it.GetIndex()));
+  }
+  auto transform = TransformType::New();
+  transform->SetDisplacementField(field);
+
+  const FieldType::RegionType largestRegion = field->GetLargestPossibleRegion();
+  const FieldType::RegionType region(FieldType::IndexType{ { 3, 5, 7 } }, FieldType::SizeType{ { 20, 10, 4 } });
+  itk::ImageIORegion          ioRegion(Dimension);
+  itk::ImageIORegionAdaptor<Dimension>::Convert(region, ioRegion, largestRegion.GetIndex());
+  const itk::ImageIORegion noIORegion(0);
+
+  for (const bool useCompression : { false, true })
+  {
+    const std::string fileName = fileNamePrefix + (useCompression ? "Compressed.h5" : ".h5");
+    auto              writer = itk::TransformFileWriterTemplate<double>::New();
+    writer->SetFileName(fileName);
+    writer->SetInput(transform);
+    writer->SetUseCompression(useCompression);
+    writer->Update();
+
+    if (!CheckDisplacementField<double>(fileName, field.GetPointer(), largestRegion, noIORegion) ||
+        !CheckDisplacementField<float>(fileName, field.GetPointer(), largestRegion, noIORegion) ||
+        !CheckDisplacementField<double>(fileName, field.GetPointer(), region, ioRegion) ||
+        !CheckDisplacementField<float>(fileName, field.GetPointer(), region, ioRegion))
+    {
+      return false;
+    }
+
+    // a region out of the field
+    itk::ImageIORegion outsideIORegion(ioRegion);
+    outsideIORegion.SetSize(2, 6);
+    try
+    {
+      ReadDisplacementFieldTransform<double>(fileName, outsideIORegion);
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Reading the region " << outsideIORegion << " of " << fileName << " should have failed"
+                << std::endl;
+      return false;
+    }
+    catch (const itk::ExceptionObject & exception)
+    {
+      std::cout << "Expected exception caught: " << exception.GetDescription() << std::endl;
+    }
+  }
+  return true;
+}
+
+// The velocity field of these transforms has one more dimension than the
+// transform, which the fixed parameters describe.
+template <typename TTransform>
+bool
+TestTimeVaryingVelocityField(const std::string & fileNamePrefix)
+{
+  using VelocityFieldType = typename TTransform::VelocityFieldType;
+
+  auto velocityField = VelocityFieldType::New();
+  velocityField->SetRegions(typename VelocityFieldType::SizeType{ { 6, 5, 4, 3 } });
+  const double spacing[Dimension + 1] = { 1.5, 2.0, 0.5, 1.0 };
+  velocityField->SetSpacing(spacing);
+  velocityField->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<VelocityFieldType> it(velocityField, velocityField->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const auto                            index = it.GetIndex();
+    typename VelocityFieldType::PixelType velocity;
+    for (unsigned int c = 0; c < Dimension; ++c)
+    {
+      velocity[c] = static_cast<double>(index[0] + 7 * index[1] + 13 * index[2] + 31 * index[3]) / 16.0 + c;
+    }
+    it.Set(velocity);
+  }
+  auto transform = TTransform::New();
+  transform->SetVelocityField(velocityField);
+
+  for (const bool useCompression : { false, true })
+  {
+    const std::string fileName = fileNamePrefix + (useCompression ? "Compressed.h5" : ".h5");
+    auto              writer = itk::TransformFileWriterTemplate<double>::New();
+    writer->SetFileName(fileName);
+    writer->SetInput(transform);
+    writer->SetUseCompression(useCompression);
+    writer->Update();
+
+    auto reader = itk::TransformFileReaderTemplate<double>::New();
+    reader->SetFileName(fileName);
+    reader->Update();
+    const auto * readTransform = reader->GetTransformList()->front().GetPointer();
+    if (readTransform->GetTransformTypeAsString() != transform->GetTransformTypeAsString() ||
+        readTransform->GetFixedParameters() != transform->GetFixedParameters() ||
+        readTransform->GetParameters() != transform->GetParameters())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Wrong " << transform->GetTransformTypeAsString() << " read from " << fileName << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+TestBSpline(const std::string & fileNamePrefix)
+{
+  using TransformType = itk::BSplineTransform<double, Dimension, 3>;
+
+  auto                                  transform = TransformType::New();
+  TransformType::MeshSizeType           meshSize;
+  TransformType::PhysicalDimensionsType physicalDimensions;
+  meshSize[0] = 7;
+  meshSize[1] = 5;
+  meshSize[2] = 4;
+  physicalDimensions.Fill(100.0);
+  transform->SetTransformDomainMeshSize(meshSize);
+  transform->SetTransformDomainPhysicalDimensions(physicalDimensions);
+  TransformType::ParametersType parameters(transform->GetNumberOfParameters());
+  for (unsigned int i = 0; i < parameters.Size(); ++i)
+  {
+    parameters[i] = 0.25 * i;
+  }
+  transform->SetParametersByValue(parameters);
+
+  for (const bool useCompression : { false, true })
+  {
+    const std::string fileName = fileNamePrefix + (useCompression ? "Compressed.h5" : ".h5");
+    auto              writer = itk::TransformFileWriterTemplate<double>::New();
+    writer->SetFileName(fileName);
+    writer->SetInput(transform);
+    writer->SetUseCompression(useCompression);
+    writer->Update();
+
+    auto reader = itk::TransformFileReaderTemplate<double>::New();
+    reader->SetFileName(fileName);
+    reader->Update();
+    const auto * readTransform = reader->GetTransformList()->front().GetPointer();
+    if (readTransform->GetFixedParameters() != transform->GetFixedParameters() ||
+        readTransform->GetParameters() != transform->GetParameters())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Wrong parameters read from " << fileName << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkHDF5TransformIODisplacementFieldTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " OutputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string directory = argv[1];
+
+  auto transformIO = itk::HDF5TransformIO::New();
+  ITK_TEST_EXPECT_EQUAL(transformIO->GetDisplacementFieldRegion().GetImageDimension(), 0);
+  itk::ImageIORegion ioRegion(Dimension);
+  ioRegion.SetSize(0, 2);
+  transformIO->SetDisplacementFieldRegion(ioRegion);
+  ITK_TEST_SET_GET_VALUE(ioRegion, transformIO->GetDisplacementFieldRegion());
+
+  using TimeVaryingTransformType = itk::TimeVaryingVelocityFieldTransform<double, Dimension>;
+  using SmoothingTimeVaryingTransformType =
+    itk::GaussianSmoothingOnUpdateTimeVaryingVelocityFieldTransform<double, Dimension>;
+
+  bool success = true;
+  ITK_TRY_EXPECT_NO_EXCEPTION(
+    success = TestDisplacementField(directory + "/itkHDF5TransformIODisplacementFieldTest") &&
+              TestTimeVaryingVelocityField<TimeVaryingTransformType>(
+                directory + "/itkHDF5TransformIODisplacementFieldTestTimeVarying") &&
+              TestTimeVaryingVelocityField<SmoothingTimeVaryingTransformType>(
+                directory + "/itkHDF5TransformIODisplacementFieldTestSmoothingTimeVarying") &&
+              TestBSpline(directory + "/itkHDF5TransformIODisplacementFieldTestBSpline"));
+  if (!success)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
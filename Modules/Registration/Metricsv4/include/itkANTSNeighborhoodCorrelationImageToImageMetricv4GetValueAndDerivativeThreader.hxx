@@ -100,7 +100,7 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<TDo
   }
 
   /* Store metric value result for this thread. */
-  this->m_GetValueAndDerivativePerThreadVariables[threadId].Measure = metricValueSum;
+  this->m_GetValueAndDerivativePerThreadVariables[threadId].Measure += metricValueSum;
 }
 
 template <typename TDomainPartitioner, typename TImageToImageMetric, typename TNeighborhoodCorrelationMetric>
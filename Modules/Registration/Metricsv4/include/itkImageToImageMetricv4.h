@@ -485,6 +485,17 @@ public:
   virtual ThreadIdType
   GetMaximumNumberOfWorkUnits() const;
 
+  /** Set/Get the grain size of the threaders that compute the value and the
+   * derivative: the approximate number of virtual points processed at once by
+   * a work unit. The default value, zero, gives every work unit an equal part
+   * of the virtual domain. When a fixed image mask or a sampled point set makes
+   * the parts unequally costly, a grain size lets the work units that finish
+   * early take over the rest of the work. \sa DomainThreader::SetGrainSize */
+  virtual void
+  SetGrainSize(const SizeValueType grainSize);
+  virtual SizeValueType
+  GetGrainSize() const;
+
 #if !defined(ITK_LEGACY_REMOVE)
   /** Get number of threads to used in the the most recent
    * evaluation.  Only valid after GetValueAndDerivative() or
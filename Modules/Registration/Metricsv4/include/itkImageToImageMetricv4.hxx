@@ -562,6 +562,35 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
   return this->m_DenseGetValueAndDerivativeThreader->GetMaximumNumberOfThreads();
 }
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+void
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  SetGrainSize(const SizeValueType grainSize)
+{
+  if (grainSize != this->GetGrainSize())
+  {
+    this->m_SparseGetValueAndDerivativeThreader->SetGrainSize(grainSize);
+    this->m_DenseGetValueAndDerivativeThreader->SetGrainSize(grainSize);
+    this->Modified();
+  }
+}
+
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+SizeValueType
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  GetGrainSize() const
+{
+  return this->m_DenseGetValueAndDerivativeThreader->GetGrainSize();
+}
+
 template <typename TFixedImage,
           typename TMovingImage,
           typename TVirtualImage,
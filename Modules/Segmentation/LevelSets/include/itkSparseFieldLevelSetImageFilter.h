@@ -332,6 +332,16 @@ public:
     this->SetInterpolateSurfaceLocation(false);
   }
 
+  /** Get/Set whether the updates of the active layer are computed by several
+   *  work units.  The active layer is then split in pieces, each one with its
+   *  own global data, and the time steps of the pieces are resolved as in
+   *  DenseFiniteDifferenceImageFilter.  This requires a difference function
+   *  whose ComputeUpdate() is thread safe, which is the case of the functions
+   *  used with the dense solvers.  Turned off by default. */
+  itkSetMacro(ComputeUpdatesInParallel, bool);
+  itkGetConstMacro(ComputeUpdatesInParallel, bool);
+  itkBooleanMacro(ComputeUpdatesInParallel);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro(OutputEqualityComparableCheck, (Concept::EqualityComparable<typename TOutputImage::PixelType>));
@@ -525,6 +535,9 @@ protected:
       (speed), advection, or curvature terms should turn this flag off. */
   bool m_InterpolateSurfaceLocation{ true };
 
+  /** Whether the active layer updates are computed by several work units. */
+  bool m_ComputeUpdatesInParallel{ false };
+
   const InputImageType * m_InputImage;
   OutputImageType *      m_OutputImage;
 
@@ -848,110 +848,141 @@ template <typename TInputImage, typename TOutputImage>
 typename SparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::TimeStepType
 SparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::CalculateChange()
 {
-  const typename Superclass::FiniteDifferenceFunctionType::Pointer   df = this->GetDifferenceFunction();
-  typename Superclass::FiniteDifferenceFunctionType::FloatOffsetType offset;
-  ValueType norm_grad_phi_squared, dx_forward, dx_backward, forwardValue, backwardValue, centerValue;
-  unsigned  i;
-  ValueType MIN_NORM = 1.0e-6;
+  const typename Superclass::FiniteDifferenceFunctionType::Pointer df = this->GetDifferenceFunction();
+  ValueType                                                        MIN_NORM = 1.0e-6;
   if (this->GetUseImageSpacing())
   {
     SpacePrecisionType minSpacing = NumericTraits<SpacePrecisionType>::max();
-    for (i = 0; i < ImageDimension; i++)
+    for (unsigned int i = 0; i < ImageDimension; i++)
     {
       minSpacing = std::min(minSpacing, this->GetInput()->GetSpacing()[i]);
     }
     MIN_NORM *= minSpacing;
   }
 
-  void * globalData = df->GetGlobalDataPointer();
-
-  typename LayerType::ConstIterator     layerIt;
-  NeighborhoodIterator<OutputImageType> outputIt(
-    df->GetRadius(), this->m_OutputImage, this->m_OutputImage->GetRequestedRegion());
-  TimeStepType timeStep;
-
-  if (m_BoundsCheckingActive == false)
+  // Gather the active layer nodes, so that they can be distributed among the
+  // work units.
+  std::vector<const LayerNodeType *> activeNodes;
+  activeNodes.reserve(m_Layers[0]->Size());
+  for (typename LayerType::ConstIterator layerIt = m_Layers[0]->Begin(); layerIt != m_Layers[0]->End(); ++layerIt)
   {
-    outputIt.NeedToUseBoundaryConditionOff();
+    activeNodes.push_back(layerIt.GetPointer());
   }
+  const auto numberOfNodes = static_cast<SizeValueType>(activeNodes.size());
 
   m_UpdateBuffer.clear();
-  m_UpdateBuffer.reserve(m_Layers[0]->Size());
+  m_UpdateBuffer.resize(numberOfNodes);
 
-  // Calculates the update values for the active layer indices in this
-  // iteration.  Iterates through the active layer index list, applying
-  // the level set function to the output image (level set image) at each
-  // index.  Update values are stored in the update buffer.
-  for (layerIt = m_Layers[0]->Begin(); layerIt != m_Layers[0]->End(); ++layerIt)
+  // Each piece uses its own global data and computes its own time step. The
+  // time steps are resolved afterwards, as in DenseFiniteDifferenceImageFilter.
+  constexpr SizeValueType minimumNodesPerPiece = 256;
+  ThreadIdType            numberOfPieces = 1;
+  if (m_ComputeUpdatesInParallel)
   {
-    outputIt.SetLocation(layerIt->m_Value);
+    numberOfPieces = static_cast<ThreadIdType>(std::max<SizeValueType>(
+      std::min<SizeValueType>(this->GetNumberOfWorkUnits(), numberOfNodes / minimumNodesPerPiece), 1));
+  }
+  const SizeValueType       nodesPerPiece = (numberOfNodes + numberOfPieces - 1) / numberOfPieces;
+  std::vector<TimeStepType> timeStepList(numberOfPieces, NumericTraits<TimeStepType>::ZeroValue());
+
+  const auto calculatePieceChange = [&](SizeValueType piece) {
+    typename Superclass::FiniteDifferenceFunctionType::FloatOffsetType offset;
+    ValueType norm_grad_phi_squared, dx_forward, dx_backward, forwardValue, backwardValue, centerValue;
+
+    void * globalData = df->GetGlobalDataPointer();
 
-    // Calculate the offset to the surface from the center of this
-    // neighborhood.  This is used by some level set functions in sampling a
-    // speed, advection, or curvature term.
-    if (this->GetInterpolateSurfaceLocation() && (centerValue = outputIt.GetCenterPixel()) != 0.0)
+    NeighborhoodIterator<OutputImageType> outputIt(
+      df->GetRadius(), this->m_OutputImage, this->m_OutputImage->GetRequestedRegion());
+    if (m_BoundsCheckingActive == false)
     {
-      // Surface is at the zero crossing, so distance to surface is:
-      // phi(x) / norm(grad(phi)), where phi(x) is the center of the
-      // neighborhood.  The location is therefore
-      // (i,j,k) - ( phi(x) * grad(phi(x)) ) / norm(grad(phi))^2
-      norm_grad_phi_squared = 0.0;
-      for (i = 0; i < ImageDimension; ++i)
+      outputIt.NeedToUseBoundaryConditionOff();
+    }
+
+    // Calculates the update values for the active layer indices in this
+    // iteration.  Iterates through the active layer index list, applying
+    // the level set function to the output image (level set image) at each
+    // index.  Update values are stored in the update buffer.
+    const SizeValueType end = std::min(numberOfNodes, (piece + 1) * nodesPerPiece);
+    for (SizeValueType n = piece * nodesPerPiece; n < end; ++n)
+    {
+      outputIt.SetLocation(activeNodes[n]->m_Value);
+
+      // Calculate the offset to the surface from the center of this
+      // neighborhood.  This is used by some level set functions in sampling a
+      // speed, advection, or curvature term.
+      if (this->GetInterpolateSurfaceLocation() && (centerValue = outputIt.GetCenterPixel()) != 0.0)
       {
-        forwardValue = outputIt.GetNext(i);
-        backwardValue = outputIt.GetPrevious(i);
+        // Surface is at the zero crossing, so distance to surface is:
+        // phi(x) / norm(grad(phi)), where phi(x) is the center of the
+        // neighborhood.  The location is therefore
+        // (i,j,k) - ( phi(x) * grad(phi(x)) ) / norm(grad(phi))^2
+        norm_grad_phi_squared = 0.0;
+        for (unsigned int i = 0; i < ImageDimension; ++i)
+        {
+          forwardValue = outputIt.GetNext(i);
+          backwardValue = outputIt.GetPrevious(i);
 
-        if (forwardValue * backwardValue >= 0)
-        { //  Neighbors are same sign OR at least one neighbor is zero.
-          dx_forward = forwardValue - centerValue;
-          dx_backward = centerValue - backwardValue;
+          if (forwardValue * backwardValue >= 0)
+          { //  Neighbors are same sign OR at least one neighbor is zero.
+            dx_forward = forwardValue - centerValue;
+            dx_backward = centerValue - backwardValue;
 
-          // Pick the larger magnitude derivative.
-          if (::itk::Math::abs(dx_forward) > ::itk::Math::abs(dx_backward))
-          {
-            offset[i] = dx_forward;
+            // Pick the larger magnitude derivative.
+            if (::itk::Math::abs(dx_forward) > ::itk::Math::abs(dx_backward))
+            {
+              offset[i] = dx_forward;
+            }
+            else
+            {
+              offset[i] = dx_backward;
+            }
           }
-          else
+          else // Neighbors are opposite sign, pick the direction of the 0 surface.
           {
-            offset[i] = dx_backward;
+            if (forwardValue * centerValue < 0)
+            {
+              offset[i] = forwardValue - centerValue;
+            }
+            else
+            {
+              offset[i] = centerValue - backwardValue;
+            }
           }
+
+          norm_grad_phi_squared += offset[i] * offset[i];
         }
-        else // Neighbors are opposite sign, pick the direction of the 0 surface.
+
+        for (unsigned int i = 0; i < ImageDimension; ++i)
         {
-          if (forwardValue * centerValue < 0)
-          {
-            offset[i] = forwardValue - centerValue;
-          }
-          else
-          {
-            offset[i] = centerValue - backwardValue;
-          }
+          offset[i] = (offset[i] * centerValue) / (norm_grad_phi_squared + MIN_NORM);
         }
 
-        norm_grad_phi_squared += offset[i] * offset[i];
+        m_UpdateBuffer[n] = df->ComputeUpdate(outputIt, globalData, offset);
       }
-
-      for (i = 0; i < ImageDimension; ++i)
+      else // Don't do interpolation
       {
-        offset[i] = (offset[i] * centerValue) / (norm_grad_phi_squared + MIN_NORM);
+        m_UpdateBuffer[n] = df->ComputeUpdate(outputIt, globalData);
       }
-
-      m_UpdateBuffer.push_back(df->ComputeUpdate(outputIt, globalData, offset));
-    }
-    else // Don't do interpolation
-    {
-      m_UpdateBuffer.push_back(df->ComputeUpdate(outputIt, globalData));
     }
-  }
 
-  // Ask the finite difference function to compute the time step for
-  // this iteration.  We give it the global data pointer to use, then
-  // ask it to free the global data memory.
-  timeStep = df->ComputeGlobalTimeStep(globalData);
+    // Ask the finite difference function to compute the time step for
+    // this piece.  We give it the global data pointer to use, then
+    // ask it to free the global data memory.
+    timeStepList[piece] = df->ComputeGlobalTimeStep(globalData);
+
+    df->ReleaseGlobalDataPointer(globalData);
+  };
+
+  if (numberOfPieces == 1)
+  {
+    calculatePieceChange(0);
+    return timeStepList[0];
+  }
 
-  df->ReleaseGlobalDataPointer(globalData);
+  this->GetMultiThreader()->SetNumberOfWorkUnits(numberOfPieces);
+  this->GetMultiThreader()->ParallelizeArray(0, numberOfPieces, calculatePieceChange, nullptr);
 
-  return timeStep;
+  return this->ResolveTimeStep(timeStepList, std::vector<bool>(numberOfPieces, true));
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -1139,6 +1170,7 @@ SparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostrea
   os << indent << "m_IsoSurfaceValue: " << m_IsoSurfaceValue << std::endl;
   itkPrintSelfObjectMacro(LayerNodeStore);
   os << indent << "m_BoundsCheckingActive: " << m_BoundsCheckingActive;
+  os << indent << "m_ComputeUpdatesInParallel: " << m_ComputeUpdatesInParallel << std::endl;
   for (i = 0; i < m_Layers.size(); i++)
   {
     os << indent << "m_Layers[" << i << "]: size=" << m_Layers[i]->Size() << std::endl;